@@ -19,6 +19,27 @@
 *
 *   Both modes may be active on the same buffer simultaneously.
 *
+*   ROPE mode (opt-in, see d_text_buffer_enable_rope):
+*     Inserts, removes and range replacements are applied to a rope (see
+*     text_rope.h) in O(log n) instead of moving the tail of `data`. The
+*     rope is flattened back into `data`/`count` only when the contiguous
+*     text is needed (get_string, to_cstring, searches and so on), so a
+*     run of edits costs one copy rather than one per edit. Functions that
+*     rewrite `data` wholesale still work; the rope is rebuilt from `data`
+*     before the next rope edit. The rope covers only the primary store:
+*     overflow chunks are left in place, exactly as in the other modes.
+*
+*   GAP mode (opt-in, see d_text_buffer_enable_gap):
+*     `data` keeps a movable gap at the last edit position, so inserts and
+*     removes near one cursor cost O(edit size) instead of moving the whole
+*     tail. The gap is closed, like the rope is flattened, only when the
+*     contiguous text is needed. Rope and gap mode are mutually exclusive.
+*
+*   Readers that need the contiguous text (get_string, searches, compares,
+*   conversions, hash and so on) flatten a rope- or gap-mode buffer first,
+*   so they take a non-const buffer. In those modes even reads write to the
+*   buffer: concurrent readers of one lazy-mode buffer must be serialized.
+*
 *
 * path:      \inc\container\buffer\text_buffer.h
 * link(s):   TBA
@@ -38,18 +59,40 @@
 #include "..\..\functional\filter.h"
 #include "..\container.h"
 #include ".\buffer_common.h"
+#include ".\text_hash.h"
+#include ".\text_matcher.h"
+#include ".\text_rope.h"
+#include ".\text_search.h"
 
 
 // d_text_buffer
 //   struct: a capacity-aware text buffer optimized for string operations
 // with automatic null-termination management. Optionally supports
 // overflow chunks via a d_buffer_chunk_list for append-mode writes.
+//   In rope mode `rope` is non-NULL and at most one of the two copies is
+// out of date: `flat_stale` means the rope holds the text and `data` will be
+// refreshed on demand (`count` stays exact and `capacity` stays above it);
+// `rope_stale` means `data` was written directly and the rope is rebuilt
+// before the next rope edit.
+//   In gap mode `flat_stale` means the gap is open: the text is
+// `data[0, gap_start)` followed by the `count - gap_start` bytes at
+// `data + gap_end`.
+//   With incremental hashing `hash` has seen the first `hash->total` bytes
+// of the text, which appends leave unchanged; other edits reset it.
 struct d_text_buffer
 {
-    size_t                     count;    // byte length (excl. null)
-    size_t                     capacity; // allocated bytes (incl. null)
-    char*                      data;     // primary contiguous store
-    struct d_buffer_chunk_list chunks;   // overflow chunks (append mode)
+    size_t                     count;      // byte length (excl. null)
+    size_t                     capacity;   // allocated bytes (incl. null)
+    char*                      data;       // primary contiguous store
+    struct d_buffer_chunk_list chunks;     // overflow chunks (append mode)
+    struct d_text_rope*        rope;       // non-NULL in rope mode
+    bool                       flat_stale; // `data` lags the rope / has a gap
+    bool                       rope_stale; // the rope lags `data`
+    bool                       gap_mode;   // edits go through the gap
+    size_t                     gap_start;  // first byte of the gap
+    size_t                     gap_end;    // first byte after the gap
+    struct d_text_hash*        hash;       // non-NULL with incremental hashing
+    size_t                     hash_count; // `count` when `hash` last caught up
 };
 
 
@@ -60,8 +103,8 @@ struct d_text_buffer* d_text_buffer_new_from_string(const char* _string);
 struct d_text_buffer* d_text_buffer_new_from_string_n(const char* _string, size_t _length);
 struct d_text_buffer* d_text_buffer_new_from_strings(size_t _count, ...);
 struct d_text_buffer* d_text_buffer_new_from_buffer(const char* _buffer, size_t _length);
-struct d_text_buffer* d_text_buffer_new_copy(const struct d_text_buffer* _other);
-struct d_text_buffer* d_text_buffer_new_copy_range(const struct d_text_buffer* _other, d_index _start, d_index _end);
+struct d_text_buffer* d_text_buffer_new_copy(struct d_text_buffer* _other);
+struct d_text_buffer* d_text_buffer_new_copy_range(struct d_text_buffer* _other, d_index _start, d_index _end);
 struct d_text_buffer* d_text_buffer_new_fill(size_t _length, char _fill_char);
 struct d_text_buffer* d_text_buffer_new_formatted(const char* _format, ...);
 
@@ -77,7 +120,7 @@ bool d_text_buffer_append_buffer(struct d_text_buffer* _buffer, const char* _dat
 bool d_text_buffer_append_char(struct d_text_buffer* _buffer, char _character);
 bool d_text_buffer_append_chars(struct d_text_buffer* _buffer, char _character, size_t _count);
 bool d_text_buffer_append_formatted(struct d_text_buffer* _buffer, const char* _format, ...);
-bool d_text_buffer_append_buffer_obj(struct d_text_buffer* _destination, const struct d_text_buffer* _source);
+bool d_text_buffer_append_buffer_obj(struct d_text_buffer* _destination, struct d_text_buffer* _source);
 bool d_text_buffer_prepend_string(struct d_text_buffer* _buffer, const char* _string);
 bool d_text_buffer_prepend_buffer(struct d_text_buffer* _buffer, const char* _data, size_t _length);
 bool d_text_buffer_prepend_char(struct d_text_buffer* _buffer, char _character);
@@ -100,6 +143,7 @@ bool d_text_buffer_set_buffer(struct d_text_buffer* _buffer, const char* _data,
 bool d_text_buffer_set_formatted(struct d_text_buffer* _buffer, const char* _format, ...);
 bool d_text_buffer_replace_char(struct d_text_buffer* _buffer, char _old_char, char _new_char);
 bool d_text_buffer_replace_string(struct d_text_buffer* _buffer, const char* _old_string, const char* _new_string);
+bool d_text_buffer_replace_many(struct d_text_buffer* _buffer, const struct d_text_matcher* _matcher, const char* const* _replacements);
 bool d_text_buffer_replace_range(struct d_text_buffer* _buffer, d_index _start, d_index _end, const char* _replacement);
 bool d_text_buffer_remove_char(struct d_text_buffer* _buffer, d_index _index);
 bool d_text_buffer_remove_range(struct d_text_buffer* _buffer, d_index _start, d_index _end);
@@ -109,29 +153,31 @@ bool d_text_buffer_consume_back(struct d_text_buffer* _buffer, size_t _amount);
 // VI.   access operations
 char  d_text_buffer_get_char(const struct d_text_buffer* _buffer, d_index _index);
 bool  d_text_buffer_set_char(struct d_text_buffer* _buffer, d_index _index, char _character);
-char* d_text_buffer_get_string(const struct d_text_buffer* _buffer);
-char* d_text_buffer_get_range_string(const struct d_text_buffer* _buffer, d_index _start, d_index _end);
+char* d_text_buffer_get_string(struct d_text_buffer* _buffer);
+char* d_text_buffer_get_range_string(struct d_text_buffer* _buffer, d_index _start, d_index _end);
 
 // VII.  search operations
-ssize_t d_text_buffer_find_char(const struct d_text_buffer* _buffer, char _character);
-ssize_t d_text_buffer_find_char_from(const struct d_text_buffer* _buffer, char _character, d_index _start);
-ssize_t d_text_buffer_find_string(const struct d_text_buffer* _buffer, const char* _string);
-ssize_t d_text_buffer_find_string_from(const struct d_text_buffer* _buffer, const char* _string, d_index _start);
-ssize_t d_text_buffer_find_last_char(const struct d_text_buffer* _buffer, char _character);
-ssize_t d_text_buffer_find_last_string(const struct d_text_buffer* _buffer, const char* _string);
-bool    d_text_buffer_contains_char(const struct d_text_buffer* _buffer, char _character);
-bool    d_text_buffer_contains_string(const struct d_text_buffer* _buffer, const char* _string);
-bool    d_text_buffer_starts_with(const struct d_text_buffer* _buffer, const char* _prefix);
-bool    d_text_buffer_ends_with(const struct d_text_buffer* _buffer, const char* _suffix);
-size_t  d_text_buffer_count_char(const struct d_text_buffer* _buffer, char _character);
-size_t  d_text_buffer_count_string(const struct d_text_buffer* _buffer, const char* _string);
+ssize_t d_text_buffer_find_char(struct d_text_buffer* _buffer, char _character);
+ssize_t d_text_buffer_find_char_from(struct d_text_buffer* _buffer, char _character, d_index _start);
+ssize_t d_text_buffer_find_string(struct d_text_buffer* _buffer, const char* _string);
+ssize_t d_text_buffer_find_string_from(struct d_text_buffer* _buffer, const char* _string, d_index _start);
+ssize_t d_text_buffer_find_last_char(struct d_text_buffer* _buffer, char _character);
+ssize_t d_text_buffer_find_last_string(struct d_text_buffer* _buffer, const char* _string);
+bool    d_text_buffer_contains_char(struct d_text_buffer* _buffer, char _character);
+bool    d_text_buffer_contains_string(struct d_text_buffer* _buffer, const char* _string);
+bool    d_text_buffer_starts_with(struct d_text_buffer* _buffer, const char* _prefix);
+bool    d_text_buffer_ends_with(struct d_text_buffer* _buffer, const char* _suffix);
+size_t  d_text_buffer_count_char(struct d_text_buffer* _buffer, char _character);
+size_t  d_text_buffer_count_string(struct d_text_buffer* _buffer, const char* _string);
+ssize_t d_text_buffer_find_any(struct d_text_buffer* _buffer, const struct d_text_matcher* _matcher, size_t* _out_pattern);
+size_t  d_text_buffer_count_each(struct d_text_buffer* _buffer, const struct d_text_matcher* _matcher, size_t* _out_counts);
 
 // VIII. comparison operations
-int  d_text_buffer_compare(const struct d_text_buffer* _buffer1, const struct d_text_buffer* _buffer2);
-int  d_text_buffer_compare_string(const struct d_text_buffer* _buffer, const char* _string);
-int  d_text_buffer_compare_n(const struct d_text_buffer* _buffer1, const struct d_text_buffer* _buffer2, size_t _n);
-bool d_text_buffer_equals(const struct d_text_buffer* _buffer1, const struct d_text_buffer* _buffer2);
-bool d_text_buffer_equals_string(const struct d_text_buffer* _buffer, const char* _string);
+int  d_text_buffer_compare(struct d_text_buffer* _buffer1, struct d_text_buffer* _buffer2);
+int  d_text_buffer_compare_string(struct d_text_buffer* _buffer, const char* _string);
+int  d_text_buffer_compare_n(struct d_text_buffer* _buffer1, struct d_text_buffer* _buffer2, size_t _n);
+bool d_text_buffer_equals(struct d_text_buffer* _buffer1, struct d_text_buffer* _buffer2);
+bool d_text_buffer_equals_string(struct d_text_buffer* _buffer, const char* _string);
 
 // IX.   text processing
 bool d_text_buffer_trim_whitespace(struct d_text_buffer* _buffer);
@@ -145,11 +191,11 @@ bool d_text_buffer_pad_left(struct d_text_buffer* _buffer, size_t _width, char _
 bool d_text_buffer_pad_right(struct d_text_buffer* _buffer, size_t _width, char _pad_char);
 
 // X.    filter
-struct d_text_buffer* d_text_buffer_filter(const struct d_text_buffer* _buffer, const struct d_filter_expr* _expression);
+struct d_text_buffer* d_text_buffer_filter(struct d_text_buffer* _buffer, const struct d_filter_expr* _expression);
 bool                  d_text_buffer_filter_in_place(struct d_text_buffer* _buffer, const struct d_filter_expr* _expression);
-bool                  d_text_buffer_filter_indices(const struct d_text_buffer* _buffer, const struct d_filter_expr* _expression, d_index** _out_indices, size_t* _out_count);
-size_t                d_text_buffer_count_matching(const struct d_text_buffer* _buffer, const struct d_filter_expr* _expression);
-struct d_text_buffer* d_text_buffer_filter_chunked(const struct d_text_buffer* _buffer, const struct d_filter_expr* _expression);
+bool                  d_text_buffer_filter_indices(struct d_text_buffer* _buffer, const struct d_filter_expr* _expression, d_index** _out_indices, size_t* _out_count);
+size_t                d_text_buffer_count_matching(struct d_text_buffer* _buffer, const struct d_filter_expr* _expression);
+struct d_text_buffer* d_text_buffer_filter_chunked(struct d_text_buffer* _buffer, const struct d_filter_expr* _expression);
 
 // XI.   utility
 void   d_text_buffer_clear(struct d_text_buffer* _buffer);
@@ -157,15 +203,25 @@ bool   d_text_buffer_is_empty(const struct d_text_buffer* _buffer);
 size_t d_text_buffer_length(const struct d_text_buffer* _buffer);
 size_t d_text_buffer_capacity(const struct d_text_buffer* _buffer);
 double d_text_buffer_utilization(const struct d_text_buffer* _buffer);
-size_t d_text_buffer_hash(const struct d_text_buffer* _buffer);
+size_t d_text_buffer_hash(struct d_text_buffer* _buffer);
+bool   d_text_buffer_enable_incremental_hash(struct d_text_buffer* _buffer);
+bool   d_text_buffer_disable_incremental_hash(struct d_text_buffer* _buffer);
 
 // XII.  conversion
-char*            d_text_buffer_to_cstring(const struct d_text_buffer* _buffer);
-bool             d_text_buffer_copy_to_buffer(const struct d_text_buffer* _source, char* _destination, size_t _destination_size);
-size_t           d_text_buffer_copy_to_buffer_n(const struct d_text_buffer* _source, char* _destination, size_t _destination_size, size_t _max_chars);
-struct d_string* d_text_buffer_to_d_string(const struct d_text_buffer* _buffer);
-
-// XIII. memory management
+char*            d_text_buffer_to_cstring(struct d_text_buffer* _buffer);
+bool             d_text_buffer_copy_to_buffer(struct d_text_buffer* _source, char* _destination, size_t _destination_size);
+size_t           d_text_buffer_copy_to_buffer_n(struct d_text_buffer* _source, char* _destination, size_t _destination_size, size_t _max_chars);
+struct d_string* d_text_buffer_to_d_string(struct d_text_buffer* _buffer);
+
+// XIII. rope and gap modes
+bool d_text_buffer_enable_rope(struct d_text_buffer* _buffer);
+bool d_text_buffer_disable_rope(struct d_text_buffer* _buffer);
+bool d_text_buffer_is_rope(const struct d_text_buffer* _buffer);
+bool d_text_buffer_enable_gap(struct d_text_buffer* _buffer);
+bool d_text_buffer_disable_gap(struct d_text_buffer* _buffer);
+bool d_text_buffer_is_gap(const struct d_text_buffer* _buffer);
+
+// XIV.  memory management
 void d_text_buffer_free(struct d_text_buffer* _buffer);
 
 
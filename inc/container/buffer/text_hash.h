@@ -0,0 +1,56 @@
+/******************************************************************************
+* djinterp [container]                                             text_hash.h
+*
+*   Streaming 64-bit text hash used by d_text_buffer_hash. The algorithm is
+* XXH64: four independent 64-bit lanes each consume 8 bytes per step (32
+* bytes per stripe), so the multiply chains overlap and throughput is
+* several times that of byte-at-a-time FNV-1a.
+*   The hash is streaming: feeding the same bytes in any number of
+* d_text_hash_update calls gives the same digest as one call, which lets a
+* buffer hash its overflow chunks in place and carry the state forward
+* across appends. Words are read in native byte order, so digests match
+* the reference XXH64 on little-endian targets only.
+*
+*
+* path:      \inc\container\buffer\text_hash.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_BUFFER_TEXT_HASH_
+#define DJINTERP_C_CONTAINER_BUFFER_TEXT_HASH_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "..\..\djinterp.h"
+
+
+// D_TEXT_HASH_STRIPE
+//   constant: bytes consumed per step by the four lanes together.
+#define D_TEXT_HASH_STRIPE 32
+
+
+// d_text_hash
+//   struct: an in-progress hash. `pending` holds the tail of the input that
+// does not yet fill a stripe.
+struct d_text_hash
+{
+    uint64_t      lanes[4];
+    uint64_t      seed;
+    uint64_t      total;            // bytes fed so far
+    size_t        pending_length;
+    unsigned char pending[D_TEXT_HASH_STRIPE];
+};
+
+
+// streaming
+void     d_text_hash_init(struct d_text_hash* _state, uint64_t _seed);
+void     d_text_hash_update(struct d_text_hash* _state, const void* _data, size_t _length);
+uint64_t d_text_hash_digest(const struct d_text_hash* _state);
+
+// one-shot
+uint64_t d_text_hash_bytes(const void* _data, size_t _length, uint64_t _seed);
+
+
+#endif  // DJINTERP_C_CONTAINER_BUFFER_TEXT_HASH_
@@ -0,0 +1,81 @@
+/******************************************************************************
+* djinterp [container]                                          text_matcher.h
+*
+*   Compiled multi-pattern matcher (Aho-Corasick) used by d_text_buffer's
+* find_any / count_each / replace_many. A set of patterns is compiled once
+* into a byte-class-compressed DFA; the text is then scanned a single time
+* regardless of how many patterns there are.
+*   Matching is leftmost-longest and non-overlapping: of the matches that
+* start earliest, the longest wins, and scanning resumes after it. This is
+* the order in which a sequence of replacements would be applied if no
+* replacement could create a new match.
+*   A matcher owns copies of its patterns and is never modified after
+* d_text_matcher_new returns, so it can be reused across buffers and shared
+* read-only between threads without locking.
+*
+*
+* path:      \inc\container\buffer\text_matcher.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_BUFFER_TEXT_MATCHER_
+#define DJINTERP_C_CONTAINER_BUFFER_TEXT_MATCHER_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\djinterp.h"
+#include ".\text_search.h"
+
+
+// D_TEXT_MATCHER_NONE
+//   constant: "no pattern" marker in a matcher's per-state output table.
+#define D_TEXT_MATCHER_NONE UINT32_MAX
+
+
+// d_text_matcher
+//   struct: a compiled, immutable set of patterns. `next` is a full DFA
+// over byte classes: bytes that appear in no pattern share class 0, so the
+// table is `state_count * class_count` entries rather than 256 per state.
+// `starts` lets a scan sitting in the root state skip bytes that cannot
+// begin a match without walking the DFA.
+struct d_text_matcher
+{
+    size_t    pattern_count;
+    char**    patterns;          // owned copies, each NUL-terminated
+    size_t*   lengths;
+    size_t    state_count;
+    size_t    class_count;
+    uint16_t  byte_class[256];
+    uint8_t   starts[256];       // nonzero if some pattern begins with the byte
+    uint32_t* next;              // [state * class_count + class]
+    uint32_t* output;            // longest pattern ending at a state, or NONE
+    uint32_t* depth;             // length of the prefix a state represents
+};
+
+// fn_text_matcher_match
+//   function pointer: called for each match found by a matcher scan with
+// the match's position in the whole text and the index of the pattern that
+// matched; returns false to stop the scan.
+typedef bool (*fn_text_matcher_match)(size_t _position, size_t _pattern, void* _context);
+
+
+// construction
+struct d_text_matcher* d_text_matcher_new(const char* const* _patterns, size_t _count);
+struct d_text_matcher* d_text_matcher_new_n(const char* const* _patterns, const size_t* _lengths, size_t _count);
+
+// access
+size_t d_text_matcher_pattern_count(const struct d_text_matcher* _matcher);
+size_t d_text_matcher_pattern_length(const struct d_text_matcher* _matcher, size_t _pattern);
+
+// scanning
+ssize_t d_text_matcher_find(const struct d_text_matcher* _matcher, const char* _text, size_t _text_length, size_t* _out_pattern);
+bool    d_text_matcher_scan_segments(const struct d_text_matcher* _matcher, const struct d_text_segment* _segments, size_t _segment_count, fn_text_matcher_match _on_match, void* _context);
+
+// memory management
+void d_text_matcher_free(struct d_text_matcher* _matcher);
+
+
+#endif  // DJINTERP_C_CONTAINER_BUFFER_TEXT_MATCHER_
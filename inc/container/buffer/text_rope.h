@@ -0,0 +1,80 @@
+/******************************************************************************
+* djinterp [container]                                             text_rope.h
+*
+*   Rope of text used by d_text_buffer's rope mode. The text is held in
+* fixed-size leaves arranged as an implicit treap: in-order traversal gives
+* the text, each node caches the byte length of its subtree, and random
+* heap priorities keep the expected depth logarithmic.
+*   Insert, remove, split, concat and indexing are O(log n) expected; edits
+* that fit inside a single leaf are done in place without reshaping the
+* tree, so typing-style workloads rarely allocate.
+*
+* CONFIGURATION:
+*   D_TEXT_ROPE_LEAF  bytes of text stored per node; default 512.
+*
+*
+* path:      \inc\container\buffer\text_rope.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_BUFFER_TEXT_ROPE_
+#define DJINTERP_C_CONTAINER_BUFFER_TEXT_ROPE_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\djinterp.h"
+
+
+// D_TEXT_ROPE_LEAF
+//   constant: capacity, in bytes, of one rope node's text.
+#ifndef D_TEXT_ROPE_LEAF
+    #define D_TEXT_ROPE_LEAF 512
+#endif  // D_TEXT_ROPE_LEAF
+
+
+// d_text_rope_node
+//   struct: one treap node; its own text sits between the texts of its left
+// and right subtrees.
+struct d_text_rope_node
+{
+    struct d_text_rope_node* left;
+    struct d_text_rope_node* right;
+    size_t                   weight;    // bytes in this subtree
+    size_t                   length;    // bytes used in `data`
+    uint32_t                 priority;  // max-heap key
+    char                     data[D_TEXT_ROPE_LEAF];
+};
+
+// d_text_rope
+//   struct: a rope; an empty rope has a NULL root.
+struct d_text_rope
+{
+    struct d_text_rope_node* root;
+    uint32_t                 seed;      // priority generator state
+};
+
+
+// construction
+void d_text_rope_init(struct d_text_rope* _rope);
+bool d_text_rope_assign(struct d_text_rope* _rope, const char* _text, size_t _length);
+
+// access
+size_t d_text_rope_length(const struct d_text_rope* _rope);
+char   d_text_rope_get(const struct d_text_rope* _rope, size_t _index);
+bool   d_text_rope_set(struct d_text_rope* _rope, size_t _index, char _character);
+size_t d_text_rope_copy(const struct d_text_rope* _rope, size_t _start, size_t _length, char* _destination);
+
+// editing
+bool d_text_rope_insert(struct d_text_rope* _rope, size_t _index, const char* _text, size_t _length);
+bool d_text_rope_remove(struct d_text_rope* _rope, size_t _start, size_t _length);
+bool d_text_rope_split(struct d_text_rope* _rope, size_t _index, struct d_text_rope* _right);
+void d_text_rope_concat(struct d_text_rope* _rope, struct d_text_rope* _right);
+
+// memory management
+void d_text_rope_clear(struct d_text_rope* _rope);
+
+
+#endif  // DJINTERP_C_CONTAINER_BUFFER_TEXT_ROPE_
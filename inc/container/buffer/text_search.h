@@ -0,0 +1,92 @@
+/******************************************************************************
+* djinterp [container]                                           text_search.h
+*
+*   Length-aware substring search used by every d_text_buffer search. Unlike
+* `strstr`, the text is bounded by an explicit length, so embedded NULs are
+* searched like any other byte.
+*   A needle is prepared once into a `d_text_searcher`, which picks a
+* strategy by needle length:
+*   - 1 byte:    a `memchr`-style scan (forward and backward).
+*   - short:     a SIMD filter (SSE2 / NEON, scalar elsewhere) that tests
+*                the needle's first and last bytes at 32 positions per step
+*                and only runs `memcmp` where both agree.
+*   - long:      Horspool, skipping by the bad-character shift of the
+*                window's last (forward) or first (reverse) byte.
+*   Reverse searches scan backward from the end of the text instead of
+* rescanning forward from every hit.
+*   Segmented text (a text buffer's primary store followed by its overflow
+* chunks) is searched as if it were contiguous; matches that straddle
+* segment boundaries are found by searching a small stitched window of at
+* most 2 * (needle length - 1) bytes around each boundary.
+*
+* CONFIGURATION:
+*   D_TEXT_SEARCH_SHORT_MAX  longest needle that uses the SIMD filter; longer
+*                            needles use Horspool; default 32.
+*
+*
+* path:      \inc\container\buffer\text_search.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_BUFFER_TEXT_SEARCH_
+#define DJINTERP_C_CONTAINER_BUFFER_TEXT_SEARCH_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\djinterp.h"
+
+
+// D_TEXT_SEARCH_SHORT_MAX
+//   constant: longest needle searched with the first/last-byte filter.
+#ifndef D_TEXT_SEARCH_SHORT_MAX
+    #define D_TEXT_SEARCH_SHORT_MAX 32
+#endif  // D_TEXT_SEARCH_SHORT_MAX
+
+
+// d_text_searcher
+//   struct: a needle prepared for repeated searches. The shift tables are
+// only filled for needles longer than D_TEXT_SEARCH_SHORT_MAX; shifts are
+// capped at UINT8_MAX, which only shortens (never breaks) a skip. The
+// needle is borrowed, not copied.
+struct d_text_searcher
+{
+    const char* needle;
+    size_t      length;
+    uint8_t     skip[256];          // forward shift, keyed on a window's last byte
+    uint8_t     skip_reverse[256];  // reverse shift, keyed on a window's first byte
+};
+
+// d_text_segment
+//   struct: one contiguous piece of a segmented text.
+struct d_text_segment
+{
+    const char* data;
+    size_t      length;
+};
+
+// fn_text_search_match
+//   function pointer: called for each match found by a segmented scan with
+// the match's position in the whole text; returns false to stop the scan.
+typedef bool (*fn_text_search_match)(size_t _position, void* _context);
+
+
+// searcher functions
+void    d_text_searcher_init(struct d_text_searcher* _searcher, const char* _needle, size_t _length);
+ssize_t d_text_searcher_find(const struct d_text_searcher* _searcher, const char* _text, size_t _text_length, size_t _start);
+ssize_t d_text_searcher_find_last(const struct d_text_searcher* _searcher, const char* _text, size_t _text_length);
+size_t  d_text_searcher_count(const struct d_text_searcher* _searcher, const char* _text, size_t _text_length);
+
+// segmented text functions
+bool    d_text_searcher_scan_segments(const struct d_text_searcher* _searcher, const struct d_text_segment* _segments, size_t _segment_count, size_t _start, fn_text_search_match _on_match, void* _context);
+ssize_t d_text_searcher_find_last_segments(const struct d_text_searcher* _searcher, const struct d_text_segment* _segments, size_t _segment_count);
+
+// one-shot functions
+ssize_t d_text_search_find(const char* _text, size_t _text_length, const char* _needle, size_t _needle_length);
+ssize_t d_text_search_find_last(const char* _text, size_t _text_length, const char* _needle, size_t _needle_length);
+size_t  d_text_search_count(const char* _text, size_t _text_length, const char* _needle, size_t _needle_length);
+
+
+#endif  // DJINTERP_C_CONTAINER_BUFFER_TEXT_SEARCH_
@@ -1,9 +1,28 @@
 /******************************************************************************
 * djinterp [container]                                                   map.h
 *
+*   A general-purpose hash map from arbitrary keys to pointer values. Keys
+* are hashed and compared through user-supplied function pointers, with
+* built-in fast paths (no indirect calls) for `int`, `uint64_t` and string
+* keys.
+*   The table is an open-addressing Robin Hood table with a parallel array
+* of one-byte control words (empty, or 7 bits of the key's hash). Lookups
+* compare 16 control bytes at once (SSE2 / NEON, scalar elsewhere) and only
+* touch the slots whose hash bits match. Removal shifts the following run
+* back, so the live table never holds tombstones. Growing is incremental:
+* a larger table is allocated and every later put or remove migrates a few
+* slots of the old one, so no single call pays for rehashing the whole map.
 *
+* NOTES:
+*   - The map does not own keys or values; see d_map_free_deep.
+*   - Key pointers passed to the generic functions point at the key: an
+*     `int*` for D_MAP_KEY_INT, a `uint64_t*` for D_MAP_KEY_UINT64, the
+*     string itself (`const char*`) for D_MAP_KEY_STRING, and any pointer
+*     the hash/comparator understand for D_MAP_KEY_CUSTOM. String and custom
+*     keys are stored as given and must outlive their entry.
 *
-* file:      \inc\container\map\map.h
+*
+* path:      \inc\container\map\map.h
 * link:      TBA
 * author(s): Sam 'teer' Neal-Blim                             date: 2025.09.27
 ******************************************************************************/
@@ -11,8 +30,142 @@
 #ifndef DJINTERP_C_CONTAINER_MAP_
 #define	DJINTERP_C_CONTAINER_MAP_ 1
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\djinterp.h"
+#include "..\container.h"
+
+
+// D_MAP_DEFAULT_CAPACITY
+//   constant: default slot count of a new map (power of two, >= 16).
+#ifndef D_MAP_DEFAULT_CAPACITY
+    #define D_MAP_DEFAULT_CAPACITY 16
+#endif
+
+// D_MAP_MAX_LOAD_PERCENT
+//   constant: the table grows once more than this percentage of slots are
+// occupied.
+#ifndef D_MAP_MAX_LOAD_PERCENT
+    #define D_MAP_MAX_LOAD_PERCENT 80
+#endif
+
+// D_MAP_MIGRATE_STEP
+//   constant: old-table slots migrated by each put or remove while the map
+// is growing. Must be at least 2 for a migration to finish before the new
+// table fills up.
+#ifndef D_MAP_MIGRATE_STEP
+    #define D_MAP_MIGRATE_STEP 8
+#endif
+
+// D_MAP_GROUP_WIDTH
+//   constant: control bytes compared per probe step.
+#define D_MAP_GROUP_WIDTH 16
+
+// D_MAP_CTRL_EMPTY / D_MAP_CTRL_MOVED
+//   constants: control byte of a free slot, and of an old-table slot that
+// was migrated or removed during a migration. Occupied slots hold 0x80 |
+// the top 7 bits of the key's hash.
+#define D_MAP_CTRL_EMPTY 0x00u
+#define D_MAP_CTRL_MOVED 0x01u
+
+
+// fn_map_hash
+//   typedef: hashes the key `_key` points at. Equal keys (as decided by the
+// map's fn_comparator) must hash equally; the map mixes the result, so
+// identity hashes are fine.
+typedef size_t (*fn_map_hash)(const void* _key);
+
+// DMapKeyType
+//   enum: how a map hashes and compares its keys.
+enum DMapKeyType
+{
+    D_MAP_KEY_CUSTOM = 0,  // user fn_map_hash + fn_comparator
+    D_MAP_KEY_INT,         // int, stored by value
+    D_MAP_KEY_UINT64,      // uint64_t, stored by value
+    D_MAP_KEY_STRING       // NUL-terminated string, stored by pointer
+};
+
+// d_map_key
+//   union: a stored key; integer keys are held by value.
+union d_map_key
+{
+    const void* ptr;
+    uint64_t    u64;
+};
+
+// d_map_slot
+//   struct: one table slot; only meaningful when its control byte is
+// occupied.
+struct d_map_slot
+{
+    union d_map_key key;
+    void*           value;
+    size_t          hash;   // mixed hash (position and control bits)
+};
+
+// d_map_table
+//   struct: one open-addressing table. `ctrl` has capacity +
+// D_MAP_GROUP_WIDTH - 1 bytes: the first group is mirrored past the end so
+// a group load never wraps.
+struct d_map_table
+{
+    struct d_map_slot* slots;
+    uint8_t*           ctrl;
+    size_t             capacity;  // power of two, or 0 if unallocated
+    size_t             count;
+};
+
+// d_map
+//   struct: a hash map. While `old` has a capacity the map is growing:
+// new keys go to `table`, and old slots below `migrate_at` have moved.
+struct d_map
+{
+    struct d_map_table table;       // live table
+    struct d_map_table old;         // table being migrated from
+    size_t             migrate_at;  // next old slot to migrate
+    enum DMapKeyType   key_type;
+    fn_map_hash        hash_fn;     // D_MAP_KEY_CUSTOM only
+    fn_comparator      compare_fn;  // D_MAP_KEY_CUSTOM only; 0 means equal
+};
+
+
+// creation functions
+struct d_map* d_map_new(fn_map_hash _hash_fn, fn_comparator _compare_fn);
+struct d_map* d_map_new_with_capacity(enum DMapKeyType _key_type, fn_map_hash _hash_fn, fn_comparator _compare_fn, size_t _capacity);
+struct d_map* d_map_new_int(void);
+struct d_map* d_map_new_uint64(void);
+struct d_map* d_map_new_string(void);
+
+// manipulation functions
+void   d_map_clear(struct d_map* _map);
+bool   d_map_contains(const struct d_map* _map, const void* _key);
+size_t d_map_count(const struct d_map* _map);
+void*  d_map_get(const struct d_map* _map, const void* _key);
+bool   d_map_merge(struct d_map* _destination, const struct d_map* _source, enum DMergeConflictFlag _conflict);
+bool   d_map_put(struct d_map* _map, const void* _key, void* _value);
+bool   d_map_remove(struct d_map* _map, const void* _key, void** _out_value);
+bool   d_map_reserve(struct d_map* _map, size_t _count);
+
+// integer key fast paths
+bool   d_map_contains_int(const struct d_map* _map, int _key);
+void*  d_map_get_int(const struct d_map* _map, int _key);
+bool   d_map_put_int(struct d_map* _map, int _key, void* _value);
+bool   d_map_remove_int(struct d_map* _map, int _key, void** _out_value);
+bool   d_map_contains_uint64(const struct d_map* _map, uint64_t _key);
+void*  d_map_get_uint64(const struct d_map* _map, uint64_t _key);
+bool   d_map_put_uint64(struct d_map* _map, uint64_t _key, void* _value);
+bool   d_map_remove_uint64(struct d_map* _map, uint64_t _key, void** _out_value);
+
+// iteration and state functions
+bool   d_map_next(const struct d_map* _map, size_t* _cursor, union d_map_key* _key, void** _value);
+bool   d_map_is_growing(const struct d_map* _map);
 
-/** This module is left intentionally blank (for the time being). **/
+// destruction functions
+void   d_map_free(struct d_map* _map);
+void   d_map_free_deep(struct d_map* _map, fn_free _key_free, fn_free _value_free);
 
 
-#endif	// DJINTERP_C_CONTAINER_MAP_
\ No newline at end of file
+#endif	// DJINTERP_C_CONTAINER_MAP_
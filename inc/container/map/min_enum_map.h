@@ -4,8 +4,13 @@
 *   A min-enum-map (minimal enum map) is a lightweight associative container
 * optimized to consume minimal space and code complexity.
 *   This module only supports basic operations: put, get, remove, contains,
-* and clear. The map is always maintained in sorted order by key, enabling
-* O(log n) lookups via binary search.
+* and clear. By default the map is maintained in sorted order by key,
+* enabling O(log n) lookups via binary search.
+*   Since enum keys are usually small and dense, a map can instead store its
+* values in a direct array indexed by `key - min_key` with a presence bitmap
+* (the dense layout), making get, put and remove O(1). A dense map falls back
+* to the sorted layout once its key span becomes too sparse; see
+* DMinEnumMapMode.
 *
 *
 * path:      \inc\container\map\min_enum_map.h 
@@ -16,7 +21,9 @@
 #ifndef DJINTERP_C_CONTAINER_MIN_ENUM_MAP_
 #define	DJINTERP_C_CONTAINER_MIN_ENUM_MAP_ 1
 
+#include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "..\..\djinterp.h"
@@ -30,18 +37,64 @@
     #define D_MIN_ENUM_MAP_DEFAULT_CAPACITY 8
 #endif
 
+// D_MIN_ENUM_MAP_DENSE_MIN_SPAN
+//   constant: a dense window of up to this many slots is never considered
+// too sparse.
+#ifndef D_MIN_ENUM_MAP_DENSE_MIN_SPAN
+    #define D_MIN_ENUM_MAP_DENSE_MIN_SPAN 64
+#endif
+
+// D_MIN_ENUM_MAP_DENSE_MAX_RATIO
+//   constant: beyond D_MIN_ENUM_MAP_DENSE_MIN_SPAN, a dense window may hold
+// at most this many slots per entry before the map falls back to the sorted
+// layout (a slot is half the size of a sorted entry).
+#ifndef D_MIN_ENUM_MAP_DENSE_MAX_RATIO
+    #define D_MIN_ENUM_MAP_DENSE_MAX_RATIO 4
+#endif
+
+// DMinEnumMapMode
+//   enum: how a map chooses its layout.
+enum DMinEnumMapMode
+{
+    // always sorted entries (the default)
+    D_MIN_ENUM_MAP_MODE_SORTED = 0,
+
+    // dense from the first put; falls back to sorted, for good, once sparse
+    D_MIN_ENUM_MAP_MODE_DENSE,
+
+    // switches to dense whenever the keys are dense enough, and back
+    D_MIN_ENUM_MAP_MODE_AUTO
+};
+
 // d_min_enum_map
 //   struct: a bare-bones associative container mapping integer keys
 // to pointer values, optimized to consume minimal space.
+//   In the dense layout `entries` is unused; `values[key - min_key]` holds
+// the value of every key whose bit is set in `present`, and `span` is the
+// number of slots in the window starting at `min_key`.
 struct d_min_enum_map
 {
     struct d_enum_map_entry* entries;
     size_t                   count;
     size_t                   capacity;
+    void**                   values;   // dense layout only
+    uint64_t*                present;  // dense layout only; shares `values`' block
+    int                      min_key;  // dense layout only
+    size_t                   span;     // dense layout only
+    enum DMinEnumMapMode     mode;
+    bool                     dense;
 };
 
-// creation function
+// D_MIN_ENUM_MAP_IS_DENSE
+//   macro: true if the map currently uses the dense layout.
+#define D_MIN_ENUM_MAP_IS_DENSE(_map) ((_map)->dense)
+
+// creation functions
 struct d_min_enum_map* d_min_enum_map_new(void);
+struct d_min_enum_map* d_min_enum_map_new_mode(enum DMinEnumMapMode _mode);
+struct d_min_enum_map* d_min_enum_map_new_dense(int _min_key, int _max_key);
+struct d_min_enum_map* d_min_enum_map_new_from_entries(const struct d_enum_map_entry* _entries, size_t _count, enum DMergeConflictFlag _conflict);
+struct d_min_enum_map* d_min_enum_map_new_from_sentinel(const struct d_enum_map_entry* _entries, enum DMergeConflictFlag _conflict);
 
 // manipulation functions
 void   d_min_enum_map_clear(struct d_min_enum_map* _map);
@@ -49,8 +102,10 @@ bool   d_min_enum_map_contains(const struct d_min_enum_map* _map, int _key);
 size_t d_min_enum_map_count(const struct d_min_enum_map* _map);
 void*  d_min_enum_map_get(const struct d_min_enum_map* _map, int _key);
 bool   d_min_enum_map_merge(struct d_min_enum_map* _dst, const struct d_min_enum_map* _src, bool _overwrite); 
+bool   d_min_enum_map_merge_in_place(struct d_min_enum_map* _dst, const struct d_min_enum_map* _src, enum DMergeConflictFlag _conflict);
 bool   d_min_enum_map_put(struct d_min_enum_map* _map, int _key, void* _value);
 bool   d_min_enum_map_remove(struct d_min_enum_map* _map, int _key);
+bool   d_min_enum_map_is_dense(const struct d_min_enum_map* _map);
 
 // destruction functions
 void   d_min_enum_map_free(struct d_min_enum_map* _map);
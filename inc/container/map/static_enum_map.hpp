@@ -0,0 +1,396 @@
+/******************************************************************************
+* djinterp [container]                                     static_enum_map.hpp
+*
+*   Compile-time lookup structures for static `d_enum_map_entry` tables. A
+* table declared with D_ENUM_ENTRY / D_ENUM_ENTRY_STR (optionally terminated
+* by D_ENUM_ENTRY_SENTINEL) is sorted, checked for duplicate keys and, when
+* its keys are dense enough, laid out as a direct-indexed window, all by
+* constexpr functions. Lookups need no runtime construction and no heap; a
+* dense table's get() is one bounds check and one array load.
+*   The result can also expose a plain `struct d_min_enum_map` for C code,
+* which then uses d_min_enum_map_get on it unchanged.
+*
+* USAGE:
+*   static constexpr d_enum_map_entry color_names[] = {
+*       D_ENUM_ENTRY_STR(COLOR_BLUE, "blue"),
+*       D_ENUM_ENTRY_STR(COLOR_RED,  "red"),
+*       D_ENUM_ENTRY_SENTINEL
+*   };
+*
+*   static constexpr auto color_map = D_STATIC_ENUM_MAP(color_names);
+*   static_assert(color_map.dense(), "");
+*
+*   const char* name = static_cast<const char*>(color_map.get(COLOR_RED));
+*
+*   // C view
+*   static constexpr d_min_enum_map color_min_map = color_map.min_enum_map();
+*
+* NOTES:
+*   - The table must be a constant expression, so its values must be
+*     pointers (D_ENUM_ENTRY, D_ENUM_ENTRY_STR, D_ENUM_ENTRY_NULL);
+*     D_ENUM_ENTRY_INT and D_ENUM_ENTRY_SELF cast integers to pointers, which
+*     constant evaluation does not allow.
+*   - Duplicate keys are compile-time errors.
+*   - The density rule is d_min_enum_map's (D_MIN_ENUM_MAP_DENSE_MIN_SPAN,
+*     D_MIN_ENUM_MAP_DENSE_MAX_RATIO); sparser tables are binary-searched.
+*   - The C view must be treated as read-only: never pass it to put, remove,
+*     merge, clear or free.
+*
+* path:      \inc\container\map\static_enum_map.hpp
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_STATIC_ENUM_MAP_
+#define DJINTERP_STATIC_ENUM_MAP_ 1
+
+#include <cstddef>
+#include <cstdint>
+#include "..\..\env.h"
+#include "..\..\cpp_features.h"
+#include "..\..\djinterp.h"
+
+extern "C"
+{
+#include ".\min_enum_map.h"
+}
+
+#if D_ENV_LANG_IS_CPP14_OR_HIGHER
+
+
+// D_STATIC_ENUM_MAP
+//   macro: builds a static_enum_map from a constexpr entry table, choosing
+// the dense layout whenever the table's keys allow it.
+#define D_STATIC_ENUM_MAP(_table)                                             \
+    ::djinterp::container::make_static_enum_map<                              \
+        ::djinterp::container::static_enum_map_span(_table)>(_table)
+
+
+NS_DJINTERP
+NS_CONTAINER
+
+
+NS_INTERNAL
+
+    // enum_map_ct_error
+    //   function: deliberately non-constexpr; reaching it during constant
+    // evaluation turns a malformed table into a compile-time error.
+    inline void
+    enum_map_ct_error
+    (
+        const char* _reason
+    )
+    {
+        (void)_reason;
+    }
+
+    // enum_map_ct_count
+    //   function: number of entries before the sentinel (or all of them).
+    template<std::size_t _N>
+    constexpr std::size_t
+    enum_map_ct_count
+    (
+        const struct d_enum_map_entry (&_table)[_N]
+    )
+    {
+        std::size_t count = 0;
+
+        while ( (count < _N) &&
+                (!D_ENUM_ENTRY_IS_SENTINEL(_table[count])) )
+        {
+            ++count;
+        }
+
+        return count;
+    }
+
+    // enum_map_ct_sort
+    //   function: constexpr heapsort of the first `_count` entries by key.
+    template<std::size_t _N>
+    constexpr void
+    enum_map_ct_sort
+    (
+        struct d_enum_map_entry (&_entries)[_N],
+        std::size_t               _count
+    )
+    {
+        std::size_t start = _count / 2;
+        std::size_t end   = _count;
+
+        while (end > 1)
+        {
+            std::size_t root = 0;
+
+            if (start > 0)
+            {
+                --start;
+            }
+            else
+            {
+                --end;
+
+                const struct d_enum_map_entry tmp = _entries[end];
+                _entries[end] = _entries[0];
+                _entries[0]   = tmp;
+            }
+
+            root = start;
+
+            while ((2 * root) + 1 < end)
+            {
+                std::size_t child = (2 * root) + 1;
+
+                if ( (child + 1 < end) &&
+                     (_entries[child].key < _entries[child + 1].key) )
+                {
+                    ++child;
+                }
+
+                if (_entries[root].key >= _entries[child].key)
+                {
+                    break;
+                }
+
+                const struct d_enum_map_entry tmp = _entries[root];
+                _entries[root]  = _entries[child];
+                _entries[child] = tmp;
+                root            = child;
+            }
+        }
+    }
+
+NS_END  // internal
+
+
+// static_enum_map_span
+//   function: slot count of the dense window for `_table`, or 0 if its keys
+// are too sparse (by d_min_enum_map's rule) and it should stay sorted.
+template<std::size_t _N>
+constexpr std::size_t
+static_enum_map_span
+(
+    const struct d_enum_map_entry (&_table)[_N]
+)
+{
+    const std::size_t count = internal::enum_map_ct_count(_table);
+    std::int64_t      lo    = 0;
+    std::int64_t      hi    = 0;
+    std::uint64_t     span  = 0;
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    lo = _table[0].key;
+    hi = _table[0].key;
+
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        lo = (_table[i].key < lo) ? _table[i].key : lo;
+        hi = (_table[i].key > hi) ? _table[i].key : hi;
+    }
+
+    span = static_cast<std::uint64_t>(hi - lo + 1);
+
+    return ( (span <= D_MIN_ENUM_MAP_DENSE_MIN_SPAN) ||
+             (span <= static_cast<std::uint64_t>(count) * D_MIN_ENUM_MAP_DENSE_MAX_RATIO) )
+               ? static_cast<std::size_t>(span)
+               : 0;
+}
+
+
+// static_enum_map
+//   struct: compile-time enum map storage. `entries` holds the table's
+// `count` entries sorted by key; if `_Span` is non-zero, `values` is also a
+// direct-indexed window of `_Span` slots starting at `min_key` (NULL where
+// no key exists) with a presence bitmap for contains().
+template<std::size_t _N,
+         std::size_t _Span>
+struct static_enum_map
+{
+    static constexpr std::size_t span  = _Span;
+    static constexpr std::size_t words = (_Span + 63) / 64;
+
+    struct d_enum_map_entry entries[_N];
+    void*                   values[(_Span > 0) ? _Span : 1];
+    std::uint64_t           present[(words > 0) ? words : 1];
+    std::size_t             count;
+    int                     min_key;
+
+    // dense
+    //   function: true if lookups index the window directly.
+    constexpr bool
+    dense
+    (
+    ) const
+    {
+        return (_Span > 0);
+    }
+
+    // get
+    //   function: the value for `_key`, or NULL if the key is absent.
+    constexpr void*
+    get
+    (
+        int _key
+    ) const
+    {
+        if (_Span > 0)
+        {
+            const std::size_t offset = static_cast<std::size_t>(
+                static_cast<unsigned int>(_key) - static_cast<unsigned int>(min_key));
+
+            return (offset < _Span) ? values[offset] : nullptr;
+        }
+
+        const struct d_enum_map_entry* entry = find(_key);
+
+        return (entry) ? entry->value : nullptr;
+    }
+
+    // contains
+    //   function: true if the table has an entry for `_key` (its value may
+    // be NULL).
+    constexpr bool
+    contains
+    (
+        int _key
+    ) const
+    {
+        if (_Span > 0)
+        {
+            const std::size_t offset = static_cast<std::size_t>(
+                static_cast<unsigned int>(_key) - static_cast<unsigned int>(min_key));
+
+            return (offset < _Span) &&
+                   (((present[offset / 64] >> (offset % 64)) & 1u) != 0);
+        }
+
+        return (find(_key) != nullptr);
+    }
+
+    // find
+    //   function: binary search of the sorted entries.
+    constexpr const struct d_enum_map_entry*
+    find
+    (
+        int _key
+    ) const
+    {
+        std::size_t low  = 0;
+        std::size_t high = count;
+
+        while (low < high)
+        {
+            const std::size_t mid = low + ((high - low) / 2);
+
+            if (entries[mid].key == _key)
+            {
+                return &entries[mid];
+            }
+
+            if (entries[mid].key < _key)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // min_enum_map
+    //   function: emits the C view of this table (dense if the table is).
+    // Only meaningful on an object with static storage duration.
+    constexpr struct d_min_enum_map
+    min_enum_map
+    (
+    ) const
+    {
+        struct d_min_enum_map map {};
+
+        map.entries  = (_Span > 0) ? nullptr
+                                   : const_cast<struct d_enum_map_entry*>(entries);
+        map.count    = count;
+        map.capacity = (_Span > 0) ? 0 : count;
+        map.values   = (_Span > 0) ? const_cast<void**>(values) : nullptr;
+        map.present  = (_Span > 0) ? const_cast<std::uint64_t*>(present) : nullptr;
+        map.min_key  = (_Span > 0) ? min_key : 0;
+        map.span     = _Span;
+        map.mode     = (_Span > 0) ? D_MIN_ENUM_MAP_MODE_DENSE
+                                   : D_MIN_ENUM_MAP_MODE_SORTED;
+        map.dense    = (_Span > 0);
+
+        return map;
+    }
+};
+
+
+// make_static_enum_map
+//   function: builds a static_enum_map from a constexpr entry table, which
+// may end with D_ENUM_ENTRY_SENTINEL. `_Span` is the dense window size, as
+// computed by static_enum_map_span (D_STATIC_ENUM_MAP does this), or 0 to
+// force the sorted layout. Duplicate keys are compile-time errors.
+template<std::size_t _Span, std::size_t _N>
+constexpr static_enum_map<_N, _Span>
+make_static_enum_map
+(
+    const struct d_enum_map_entry (&_table)[_N]
+)
+{
+    static_enum_map<_N, _Span> out {};
+
+    out.count = internal::enum_map_ct_count(_table);
+
+    for (std::size_t i = 0; i < out.count; ++i)
+    {
+        out.entries[i] = _table[i];
+    }
+
+    internal::enum_map_ct_sort(out.entries, out.count);
+
+    for (std::size_t i = 1; i < out.count; ++i)
+    {
+        if (out.entries[i - 1].key == out.entries[i].key)
+        {
+            internal::enum_map_ct_error("duplicate enum map key");
+        }
+    }
+
+    if ( (_Span > 0) &&
+         (out.count > 0) )
+    {
+        out.min_key = out.entries[0].key;
+
+        if (static_cast<std::int64_t>(out.entries[out.count - 1].key) -
+            static_cast<std::int64_t>(out.min_key) >= static_cast<std::int64_t>(_Span))
+        {
+            internal::enum_map_ct_error("dense window too small for the table");
+        }
+
+        for (std::size_t i = 0; i < out.count; ++i)
+        {
+            const std::size_t offset = static_cast<std::size_t>(
+                static_cast<std::int64_t>(out.entries[i].key) - out.min_key);
+
+            out.values[offset]        = out.entries[i].value;
+            out.present[offset / 64] |= (static_cast<std::uint64_t>(1) << (offset % 64));
+        }
+    }
+
+    return out;
+}
+
+
+NS_END  // container
+NS_END  // djinterp
+
+
+#endif  // D_ENV_LANG_IS_CPP14_OR_HIGHER
+
+
+#endif  // DJINTERP_STATIC_ENUM_MAP_
@@ -39,6 +39,7 @@ struct d_linked_node
 struct d_linked_node* d_linked_node_new(void*, struct d_linked_node*);
 
 void d_linked_node_free(struct d_linked_node*);
+void d_linked_node_free_chain(struct d_linked_node*);
 
 
 #endif	// DJINTERP_C_CONTAINER_LINKED_NODE_
\ No newline at end of file
@@ -0,0 +1,118 @@
+/******************************************************************************
+* djinterp [container]                                      linked_node_pool.h
+*
+*   Slab allocator for `d_linked_node`. Nodes are carved out of slabs of
+* D_LINKED_NODE_POOL_SLAB_BYTES bytes and recycled through a per-slab
+* intrusive free list (threaded through each free node's `next`), so
+* allocating or freeing a node is a pointer swap instead of a malloc/free
+* round trip. A whole chain of nodes is returned under one lock.
+*   This is the allocator behind d_linked_node_new / d_linked_node_free, and
+* therefore behind every linked-node container (d_stack, d_min_stack and the
+* d_stack_common helpers). Slabs are aligned to their size, so a released
+* node finds its slab with a mask; a slab whose nodes are all free again is
+* returned to the system once the pool holds more than one slab's worth of
+* free nodes (or more than d_linked_node_pool_reserve asked for).
+*
+* CONFIGURATION:
+*   D_LINKED_NODE_POOL_ENABLED       0 sends d_linked_node_new/_free straight
+*                                    to malloc/free (e.g. to let a memory
+*                                    checker see every node); default 1.
+*   D_LINKED_NODE_POOL_SLAB_BYTES    bytes per slab, a power of two; default
+*                                    4096. The first
+*                                    D_LINKED_NODE_POOL_SLAB_HEADER bytes hold
+*                                    the slab's bookkeeping.
+*   D_LINKED_NODE_POOL_THREAD_SAFE   guard the shared pool with a spinlock;
+*                                    default 1 when C11 atomics exist.
+*   D_LINKED_NODE_POOL_THREAD_CACHE  give each thread a private cache of up
+*                                    to D_LINKED_NODE_POOL_CACHE_NODES nodes,
+*                                    refilled and drained in batches; default
+*                                    0. Requires D_LINKED_NODE_POOL_THREAD_SAFE
+*                                    and C11 <threads.h>, whose thread-exit
+*                                    hook returns a finished thread's cache.
+*
+*
+* path:      \inc\container\node\linked_node_pool.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_LINKED_NODE_POOL_
+#define DJINTERP_C_CONTAINER_LINKED_NODE_POOL_ 1
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "..\..\djinterp.h"
+#include ".\linked_node.h"
+
+
+// D_LINKED_NODE_POOL_ENABLED
+//   constant: whether d_linked_node_new/_free use the pool.
+#ifndef D_LINKED_NODE_POOL_ENABLED
+    #define D_LINKED_NODE_POOL_ENABLED 1
+#endif
+
+// D_LINKED_NODE_POOL_SLAB_BYTES
+//   constant: size and alignment of one slab; must be a power of two.
+#ifndef D_LINKED_NODE_POOL_SLAB_BYTES
+    #define D_LINKED_NODE_POOL_SLAB_BYTES 4096
+#endif
+
+// D_LINKED_NODE_POOL_SLAB_HEADER
+//   constant: bytes at the start of each slab reserved for its bookkeeping.
+#define D_LINKED_NODE_POOL_SLAB_HEADER 64
+
+// D_LINKED_NODE_POOL_SLAB_NODES
+//   constant: number of nodes allocated together in one slab.
+#define D_LINKED_NODE_POOL_SLAB_NODES                                       \
+    ( (D_LINKED_NODE_POOL_SLAB_BYTES - D_LINKED_NODE_POOL_SLAB_HEADER) /    \
+      sizeof(struct d_linked_node) )
+
+// D_LINKED_NODE_POOL_THREAD_SAFE
+//   constant: whether the shared pool is guarded by a spinlock.
+#ifndef D_LINKED_NODE_POOL_THREAD_SAFE
+    #if defined(__STDC_NO_ATOMICS__)
+        #define D_LINKED_NODE_POOL_THREAD_SAFE 0
+    #else
+        #define D_LINKED_NODE_POOL_THREAD_SAFE 1
+    #endif
+#endif
+
+// D_LINKED_NODE_POOL_THREAD_CACHE
+//   constant: whether each thread keeps a private node cache.
+#ifndef D_LINKED_NODE_POOL_THREAD_CACHE
+    #define D_LINKED_NODE_POOL_THREAD_CACHE 0
+#endif
+
+// D_LINKED_NODE_POOL_CACHE_NODES
+//   constant: most nodes a thread cache holds; it moves half of this to or
+// from the shared pool at a time.
+#ifndef D_LINKED_NODE_POOL_CACHE_NODES
+    #define D_LINKED_NODE_POOL_CACHE_NODES 64
+#endif
+
+
+// d_linked_node_pool_stats
+//   struct: a snapshot of the pool's bookkeeping.
+struct d_linked_node_pool_stats
+{
+    size_t slabs;       // slabs currently allocated
+    size_t capacity;    // nodes across all slabs
+    size_t available;   // free nodes in the slabs
+    size_t cached;      // nodes parked in thread caches
+    size_t in_use;      // nodes held by callers
+};
+
+
+// node allocation functions
+struct d_linked_node* d_linked_node_pool_acquire(void);
+void                  d_linked_node_pool_release(struct d_linked_node* _node);
+void                  d_linked_node_pool_release_chain(struct d_linked_node* _top);
+
+// pool management functions
+bool d_linked_node_pool_reserve(size_t _nodes);
+bool d_linked_node_pool_trim(void);
+void d_linked_node_pool_thread_flush(void);
+void d_linked_node_pool_get_stats(struct d_linked_node_pool_stats* _stats);
+
+
+#endif  // DJINTERP_C_CONTAINER_LINKED_NODE_POOL_
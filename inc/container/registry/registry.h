@@ -43,6 +43,46 @@
     #define D_REGISTRY_GROWTH_FACTOR 2
 #endif  // D_REGISTRY_GROWTH_FACTOR
 
+#ifndef D_REGISTRY_HASH_MIN_CAPACITY
+    // D_REGISTRY_HASH_MIN_CAPACITY
+    //   constant: smallest slot count of a hash index (power of two).
+    #define D_REGISTRY_HASH_MIN_CAPACITY 16
+#endif  // D_REGISTRY_HASH_MIN_CAPACITY
+
+#ifndef D_REGISTRY_PERFECT_HASH_MAX_TRIES
+    // D_REGISTRY_PERFECT_HASH_MAX_TRIES
+    //   constant: displacement values tried per bucket before building a
+    // perfect hash is abandoned (lookups then fall back to other indexes).
+    #define D_REGISTRY_PERFECT_HASH_MAX_TRIES (1u << 20)
+#endif  // D_REGISTRY_PERFECT_HASH_MAX_TRIES
+
+#ifndef D_REGISTRY_TOMBSTONE_COMPACT_PERCENT
+    // D_REGISTRY_TOMBSTONE_COMPACT_PERCENT
+    //   constant: with D_REGISTRY_FLAG_TOMBSTONES, removals compact the rows
+    // once at least this percentage of row slots are dead.
+    #define D_REGISTRY_TOMBSTONE_COMPACT_PERCENT 25
+#endif  // D_REGISTRY_TOMBSTONE_COMPACT_PERCENT
+
+#ifndef D_REGISTRY_ARENA_BLOCK_MIN
+    // D_REGISTRY_ARENA_BLOCK_MIN
+    //   constant: size in bytes of the first interned key arena block.
+    #define D_REGISTRY_ARENA_BLOCK_MIN 4096
+#endif  // D_REGISTRY_ARENA_BLOCK_MIN
+
+#ifndef D_REGISTRY_ARENA_BLOCK_MAX
+    // D_REGISTRY_ARENA_BLOCK_MAX
+    //   constant: arena blocks double in size up to this many bytes (larger
+    // keys still get a block of their own).
+    #define D_REGISTRY_ARENA_BLOCK_MAX (1u << 18)
+#endif  // D_REGISTRY_ARENA_BLOCK_MAX
+
+#ifndef D_REGISTRY_FOLD_PROBE_MAX
+    // D_REGISTRY_FOLD_PROBE_MAX
+    //   constant: longest probe key folded on the stack by a folded-key
+    // lookup; longer probes fall back to per-character comparison.
+    #define D_REGISTRY_FOLD_PROBE_MAX 256
+#endif  // D_REGISTRY_FOLD_PROBE_MAX
+
 
 /******************************************************************************
  * KEY EXTRACTION
@@ -54,6 +94,23 @@
 #define D_REGISTRY_ROW_KEY(row_ptr) \
     (*((const char* const*)(row_ptr)))
 
+// D_REGISTRY_ROW_IS_DEAD
+//   macro: true for a tombstoned row slot (its key is cleared on removal).
+#define D_REGISTRY_ROW_IS_DEAD(row_ptr) \
+    (D_REGISTRY_ROW_KEY(row_ptr) == NULL)
+
+// D_REGISTRY_INTERNED
+//   macro: header of an interned key (see d_registry_is_interned); only
+// valid for keys returned by d_registry_intern or stored by the `_intern`
+// functions.
+#define D_REGISTRY_INTERNED(key_ptr) \
+    ((const struct d_registry_interned*)(const void*)(key_ptr) - 1)
+
+// D_REGISTRY_INTERNED_LENGTH
+//   macro: precomputed strlen of an interned key.
+#define D_REGISTRY_INTERNED_LENGTH(key_ptr) \
+    ((size_t)D_REGISTRY_INTERNED(key_ptr)->length)
+
 
 /******************************************************************************
  * FLAG DEFINITIONS
@@ -68,7 +125,10 @@ enum DRegistryFlag
     D_REGISTRY_FLAG_OWNS_ROWS        = 0x02,  // registry frees row memory
     D_REGISTRY_FLAG_STATIC_ROWS      = 0x04,  // rows are static, never free
     D_REGISTRY_FLAG_SORTED           = 0x08,  // rows maintained in key order
-    D_REGISTRY_FLAG_FROZEN           = 0x10   // no modifications allowed
+    D_REGISTRY_FLAG_FROZEN           = 0x10,  // no modifications allowed
+    D_REGISTRY_FLAG_HASH_INDEX       = 0x20,  // keep a hash index for get
+    D_REGISTRY_FLAG_KEY_PREFIX       = 0x40,  // lookup caches key prefixes
+    D_REGISTRY_FLAG_TOMBSTONES       = 0x80   // removal leaves dead slots
 };
 
 // D_REGISTRY_FLAG_DEFAULT
@@ -115,6 +175,27 @@ enum DRegistryFlag
 #define D_REGISTRY_OWNS_ROWS(registry) \
     D_REGISTRY_HAS_FLAG(registry, D_REGISTRY_FLAG_OWNS_ROWS)
 
+// D_REGISTRY_HAS_HASH_INDEX
+//   macro: checks if the registry maintains a hash index alongside lookup.
+#define D_REGISTRY_HAS_HASH_INDEX(registry) \
+    D_REGISTRY_HAS_FLAG(registry, D_REGISTRY_FLAG_HASH_INDEX)
+
+// D_REGISTRY_HAS_KEY_PREFIX
+//   macro: checks if lookup entries carry valid inline key prefixes.
+#define D_REGISTRY_HAS_KEY_PREFIX(registry) \
+    D_REGISTRY_HAS_FLAG(registry, D_REGISTRY_FLAG_KEY_PREFIX)
+
+// D_REGISTRY_HAS_FOLDED_KEYS
+//   macro: checks if the lookup caches case-folded key copies.
+#define D_REGISTRY_HAS_FOLDED_KEYS(registry) \
+    ((registry)->fold_keys)
+
+// D_REGISTRY_HAS_EXTERNAL_INDEX
+//   macro: checks if the hash index and perfect hash live in storage the
+// registry does not own (and must never free or rebuild).
+#define D_REGISTRY_HAS_EXTERNAL_INDEX(registry) \
+    ((registry)->external_index)
+
 
 /******************************************************************************
  * FUNCTION POINTER TYPES
@@ -141,11 +222,50 @@ typedef bool (*fn_registry_row_predicate)(const void* _row, const void* _context
 
 // d_registry_lookup_entry
 //   struct: internal entry in the lookup array mapping a key or alias string
-// to a row index.
+// to a row index. With D_REGISTRY_FLAG_KEY_PREFIX, `prefix` holds the first
+// 8 bytes of the key (case-folded for case-insensitive registries) packed
+// big-endian, so binary search settles most comparisons without reading
+// the key; otherwise it is 0 and ignored. In case-insensitive registries
+// with folded keys enabled, `folded` points at an ASCII-lowercased copy of
+// the key (preceded by its length as a size_t); otherwise it is NULL.
 struct d_registry_lookup_entry
 {
     const char* key;        // key or alias string
     size_t      row_index;  // index into the rows array
+    uint64_t    prefix;     // inline key prefix (KEY_PREFIX registries)
+    const char* folded;     // case-folded key copy (or NULL)
+};
+
+// d_registry_hash_slot
+//   struct: internal slot of the optional open-addressing hash index. A NULL
+// key marks an empty slot.
+struct d_registry_hash_slot
+{
+    const char* key;        // key or alias string (NULL if empty)
+    size_t      row_index;  // index into the rows array
+    size_t      hash;       // cached hash of key
+};
+
+// d_registry_interned
+//   struct: header stored in front of every interned key. `hash` is the
+// registry's key hash at intern time, case-folded if `nocase` is set; it is
+// reused by the hash index while the registry's case mode still matches.
+struct d_registry_interned
+{
+    size_t   hash;           // key hash (see `nocase`)
+    uint32_t length;         // strlen of the key
+    uint32_t nocase;         // hash was computed case-folded
+};
+
+// d_registry_arena_block
+//   struct: one block of a registry's interned key arena, chained newest
+// first. Interned keys (header, characters, NUL) are packed after the block
+// header, each rounded up to a multiple of sizeof(size_t).
+struct d_registry_arena_block
+{
+    struct d_registry_arena_block* next;   // older block
+    size_t                         used;   // bytes handed out
+    size_t                         size;   // bytes available after header
 };
 
 // d_registry
@@ -155,23 +275,50 @@ struct d_registry
 {
     void*                           rows;           // array of user row structs
     size_t                          row_size;       // sizeof(user row struct)
-    size_t                          count;          // number of rows
+    size_t                          count;          // row slots (incl. dead)
     size_t                          capacity;       // allocated row capacity
     struct d_registry_lookup_entry* lookup;         // sorted key/alias array
     size_t                          lookup_count;   // entries in lookup
     size_t                          lookup_capacity;// allocated lookup capacity
     uint8_t                         flags;          // registry-wide flags
     fn_registry_row_free            row_free;       // optional row destructor
+    size_t                          batch_depth;    // nesting of open batches
+    size_t                          lookup_sorted;  // sorted lookup prefix (batch)
+    struct d_registry_hash_slot*    hash_slots;     // optional hash index
+    size_t                          hash_count;     // occupied hash slots
+    size_t                          hash_capacity;  // hash slots (power of 2)
+    uint32_t*                       perfect_hash;   // frozen-only: disp + map
+    size_t                          perfect_buckets;// displacement entries
+    size_t                          perfect_slots;  // map entries (lookup_count)
+    size_t                          dead_count;     // tombstoned row slots
+    struct d_registry_arena_block*  arena;          // interned keys (or NULL)
+    struct d_registry_arena_block*  fold_arena;     // folded key copies
+    bool                            fold_keys;      // lookup caches folded keys
+    bool                            external_index; // indexes are not owned
+};
+
+// d_registry_slice
+//   struct: zero-copy `[first, last)` view into a registry's sorted lookup,
+// as returned by d_registry_find_prefix and d_registry_range. Entries are
+// keys and aliases in key order, so a row may appear more than once. The
+// view is invalidated by any modification of the registry.
+struct d_registry_slice
+{
+    const struct d_registry_lookup_entry* first;  // first entry in range
+    const struct d_registry_lookup_entry* last;   // one past the last entry
 };
 
 // d_registry_iterator
 //   struct: iterator for traversing registry entries with optional filtering.
+// When `slice` is non-empty the iterator walks the slice's rows in key order
+// instead of the rows array.
 struct d_registry_iterator
 {
     struct d_registry*        registry;     // registry being iterated
-    size_t                    current;      // current row index
+    size_t                    current;      // current row (or slice) index
     fn_registry_row_predicate filter;       // optional filter predicate
     const void*               filter_ctx;   // filter context
+    struct d_registry_slice   slice;        // optional lookup slice
 };
 
 
@@ -310,7 +457,9 @@ struct d_registry_iterator
 //       D_REGISTRY_ROW("apple", 3, 4),
 //       D_REGISTRY_ROW("mango", 5, 6)
 //   );
-//   // Then call: d_registry_rebuild_lookup(&my_registry);
+//   // Then call: D_REGISTRY_INIT(&my_registry);
+// D_REGISTRY_INIT leaves the registry frozen. Its rows are static, so it stays
+// read-only: d_registry_thaw only drops the perfect hash.
 #define D_REGISTRY_DEFINE(name, row_type, ...)                              \
     static row_type D_CONCAT(name, _rows)[] = { __VA_ARGS__ };              \
     static struct d_registry_lookup_entry D_CONCAT(name, _lookup)[          \
@@ -348,10 +497,13 @@ struct d_registry_iterator
 
 // D_REGISTRY_INIT
 //   macro: runtime initialization call for a D_REGISTRY_DEFINE'd registry.
-// Populates and sorts the lookup table.
+// Populates and sorts the lookup table, then freezes the registry, which
+// builds its perfect hash. The registry is frozen afterwards; thawing it only
+// drops that index, as rows and aliases cannot be added to static rows.
 // Usage: D_REGISTRY_INIT(&my_registry);
-#define D_REGISTRY_INIT(registry_ptr) \
-    d_registry_rebuild_lookup(registry_ptr)
+#define D_REGISTRY_INIT(registry_ptr)                                       \
+    (d_registry_rebuild_lookup(registry_ptr),                               \
+     (void)d_registry_freeze(registry_ptr))
 
 
 /******************************************************************************
@@ -394,8 +546,13 @@ struct d_registry_iterator
         ? D_REGISTRY_GET(registry, key_str, row_type)->field                \
         : (row_type){0}.field)
 
+// D_REGISTRY_SLICE_COUNT
+//   macro: number of lookup entries in a d_registry_slice.
+#define D_REGISTRY_SLICE_COUNT(slice)                                       \
+    ((size_t)((slice).last - (slice).first))
+
 // D_REGISTRY_FOREACH
-//   macro: iterates over all rows in the registry.
+//   macro: iterates over all rows in the registry, skipping tombstoned slots.
 // Usage:
 //   D_REGISTRY_FOREACH(&reg, struct my_row, row) {
 //       printf("%s\n", row->key);
@@ -407,7 +564,7 @@ struct d_registry_iterator
         for (row_type* var_name = D_REGISTRY_ROW_AT(registry,               \
                                                     D_CONCAT(var_name, _idx),\
                                                     row_type);              \
-             var_name != NULL;                                              \
+             (var_name != NULL) && !D_REGISTRY_ROW_IS_DEAD(var_name);       \
              var_name = NULL)
 
 
@@ -417,8 +574,11 @@ struct d_registry_iterator
 
 struct d_registry* d_registry_new(size_t _row_size);
 struct d_registry* d_registry_new_with_capacity(size_t _row_size, size_t _capacity);
+// note: a copy of a registry with an open batch does not inherit the batch;
+// it starts out with the staged entries committed (see d_registry_end_batch).
 struct d_registry* d_registry_new_copy(const struct d_registry* _other);
 struct d_registry* d_registry_new_from_array(const void* _rows, size_t _row_size, size_t _count);
+struct d_registry* d_registry_new_from_array_flags(const void* _rows, size_t _row_size, size_t _count, uint8_t _flags);
 
 
 /******************************************************************************
@@ -428,6 +588,8 @@ struct d_registry* d_registry_new_from_array(const void* _rows, size_t _row_size
 // d_registry_get
 //   function: binary searches the lookup array for the key and returns the
 // matching row, or NULL if not found. This is the primary access method.
+// Registries with D_REGISTRY_FLAG_HASH_INDEX probe the hash index instead;
+// frozen registries use their perfect hash (one hash, one probe, one compare).
 void* d_registry_get(const struct d_registry* _registry, const char* _key);
 
 
@@ -436,15 +598,25 @@ void* d_registry_get(const struct d_registry* _registry, const char* _key);
  *****************************************************************************/
 
 // adding rows
+// note: d_registry_add_rows stages every row in a single batch (see
+// d_registry_begin_batch), so N rows cost one sort rather than N.
 bool   d_registry_add(struct d_registry* _registry, const void* _row);
 bool   d_registry_add_rows(struct d_registry* _registry, const void* _rows, size_t _count);
 bool   d_registry_set(struct d_registry* _registry, const char* _key, const void* _row);
 
 // removing rows
+// note: with D_REGISTRY_FLAG_TOMBSTONES, removal clears the row's key in
+// place and drops only its lookup entries; row indices stay stable until the
+// rows are compacted (automatically past D_REGISTRY_TOMBSTONE_COMPACT_PERCENT
+// dead slots, or via d_registry_compact).
 bool   d_registry_remove(struct d_registry* _registry, const char* _key);
 bool   d_registry_remove_at(struct d_registry* _registry, size_t _index);
 void   d_registry_clear(struct d_registry* _registry);
 
+// d_registry_compact
+//   function: removes tombstoned row slots, remapping lookup row indices.
+bool   d_registry_compact(struct d_registry* _registry);
+
 
 /******************************************************************************
  * ALIAS FUNCTIONS
@@ -457,10 +629,39 @@ void   d_registry_clear_aliases(struct d_registry* _registry);
 size_t d_registry_alias_count(const struct d_registry* _registry);
 
 
+/******************************************************************************
+ * INTERNED KEY FUNCTIONS
+ *****************************************************************************/
+
+// note: interned keys are copied into the registry's arena, stored with
+// their length and hash, and released all at once by d_registry_clear and
+// d_registry_free (removing a row does not reclaim its key). A row_free
+// destructor must not free an interned key.
+
+// d_registry_intern
+//   function: returns the registry's copy of `_str`, interning it if no
+// entry already holds an interned key with the same bytes. Returns NULL on
+// allocation failure or for keys of 4 GiB or more.
+const char* d_registry_intern(struct d_registry* _registry, const char* _str);
+
+// d_registry_is_interned
+//   function: returns true if `_key` points into the registry's arena.
+bool        d_registry_is_interned(const struct d_registry* _registry, const char* _key);
+
+// `_intern` variants: as the functions above, but the row key or alias is
+// interned first, so callers may pass temporary strings. Nothing is kept in
+// the arena when the operation fails.
+bool        d_registry_add_intern(struct d_registry* _registry, const void* _row);
+bool        d_registry_add_rows_intern(struct d_registry* _registry, const void* _rows, size_t _count);
+bool        d_registry_add_alias_intern(struct d_registry* _registry, const char* _key, const char* _alias);
+
+
 /******************************************************************************
  * QUERY FUNCTIONS
  *****************************************************************************/
 
+// note: d_registry_count reports live rows; `count` in the struct is the
+// number of row slots, and d_registry_at returns NULL for a dead slot.
 bool    d_registry_contains(const struct d_registry* _registry, const char* _key);
 ssize_t d_registry_index_of(const struct d_registry* _registry, const char* _key);
 void*   d_registry_at(const struct d_registry* _registry, size_t _index);
@@ -480,9 +681,100 @@ void d_registry_rebuild_lookup(struct d_registry* _registry);
 
 // d_registry_sort_lookup
 //   function: sorts the lookup table for binary search. Called automatically
-// by rebuild_lookup and after add operations.
+// by rebuild_lookup and after add operations (deferred while a batch is open).
 void d_registry_sort_lookup(struct d_registry* _registry);
 
+// d_registry_build_hash_index
+//   function: sets D_REGISTRY_FLAG_HASH_INDEX and (re)builds the hash index
+// from the current lookup, keys and aliases alike. The index is then kept in
+// sync by add/remove/alias operations and rebuilt by rebuild_lookup; while a
+// batch is open it is left alone and rebuilt on commit.
+bool d_registry_build_hash_index(struct d_registry* _registry);
+
+// d_registry_drop_hash_index
+//   function: frees the hash index and clears D_REGISTRY_FLAG_HASH_INDEX.
+// No-op for registries with an external index.
+void d_registry_drop_hash_index(struct d_registry* _registry);
+
+// d_registry_build_perfect_hash
+//   function: builds a minimal perfect hash (hash-and-displace, CHD style)
+// over every key and alias in the lookup. The side table holds one 32-bit
+// displacement per bucket (two keys per bucket) and one 32-bit lookup index
+// per key; rows and lookup are not touched, so static registries qualify.
+// Called by d_registry_freeze. Any later change to the lookup drops it.
+// Fails for registries with an external index.
+bool d_registry_build_perfect_hash(struct d_registry* _registry);
+
+// d_registry_drop_perfect_hash
+//   function: frees the perfect hash side table; called by d_registry_thaw.
+// No-op for registries with an external index.
+void d_registry_drop_perfect_hash(struct d_registry* _registry);
+
+// d_registry_enable_key_prefix
+//   function: fills every lookup entry's inline prefix and sets
+// D_REGISTRY_FLAG_KEY_PREFIX; entries added later are filled on insert, and
+// sort_lookup refreshes them (e.g. after toggling case sensitivity).
+bool d_registry_enable_key_prefix(struct d_registry* _registry);
+
+// d_registry_disable_key_prefix
+//   function: clears D_REGISTRY_FLAG_KEY_PREFIX; comparisons read full keys.
+void d_registry_disable_key_prefix(struct d_registry* _registry);
+
+// d_registry_enable_folded_keys
+//   function: makes the lookup of a case-insensitive registry keep a
+// case-folded copy of every key and alias, so searches fold the probe once
+// and compare with memcmp instead of calling tolower per character. Copies
+// live in a registry-owned arena; those of removed keys are only released
+// by rebuild_lookup, clear or disable. Folding is ASCII-only, matching
+// tolower in the "C" locale. Fails for frozen registries.
+bool d_registry_enable_folded_keys(struct d_registry* _registry);
+
+// d_registry_disable_folded_keys
+//   function: frees the folded copies; comparisons fold per character again.
+void d_registry_disable_folded_keys(struct d_registry* _registry);
+
+
+/******************************************************************************
+ * BATCH FUNCTIONS
+ *****************************************************************************/
+
+// d_registry_begin_batch
+//   function: opens a (nestable) batch. While a batch is open, add and alias
+// operations append to the rows and lookup arrays without re-sorting; keys
+// staged in the batch are only checked against the pre-batch lookup, and
+// lookups of staged keys fall back to a linear scan of the staged tail.
+bool d_registry_begin_batch(struct d_registry* _registry);
+
+// d_registry_end_batch
+//   function: closes a batch. Closing the outermost batch sorts the lookup
+// once, resolves keys that collided within the batch (canonical keys win over
+// aliases, then the lowest row index wins; rows losing their canonical key
+// are discarded along with their aliases) and fixes up row indices in a single
+// pass. `D_REGISTRY_FLAG_SORTED` registries are reordered at this point.
+// Returns false if any staged entry was discarded or on allocation failure.
+bool d_registry_end_batch(struct d_registry* _registry);
+
+// d_registry_in_batch
+//   function: returns true if the registry has an open batch.
+bool d_registry_in_batch(const struct d_registry* _registry);
+
+
+/******************************************************************************
+ * RANGE QUERY FUNCTIONS
+ *****************************************************************************/
+
+// d_registry_find_prefix
+//   function: returns the slice of lookup entries whose key (or alias) starts
+// with `_prefix`, in O(log N), honoring D_REGISTRY_FLAG_CASE_INSENSITIVE. An
+// empty prefix selects every entry. Inside a batch, staged entries are not
+// included. Returns an empty slice on error.
+struct d_registry_slice d_registry_find_prefix(const struct d_registry* _registry, const char* _prefix);
+
+// d_registry_range
+//   function: returns the slice of lookup entries with `_low <= key < _high`
+// in O(log N). A NULL bound is unbounded on that side.
+struct d_registry_slice d_registry_range(const struct d_registry* _registry, const char* _low, const char* _high);
+
 
 /******************************************************************************
  * ITERATOR FUNCTIONS
@@ -491,6 +783,14 @@ void d_registry_sort_lookup(struct d_registry* _registry);
 struct d_registry_iterator d_registry_iterator_new(struct d_registry* _registry);
 struct d_registry_iterator d_registry_iterator_filtered(struct d_registry* _registry, fn_registry_row_predicate _filter, const void* _context);
 
+// d_registry_iterator_slice
+//   function: iterates the rows referenced by a slice, in key order.
+struct d_registry_iterator d_registry_iterator_slice(struct d_registry* _registry, struct d_registry_slice _slice);
+
+// d_registry_iterator_prefix
+//   function: shorthand for iterating d_registry_find_prefix(_prefix).
+struct d_registry_iterator d_registry_iterator_prefix(struct d_registry* _registry, const char* _prefix);
+
 bool  d_registry_iterator_has_next(const struct d_registry_iterator* _iter);
 void* d_registry_iterator_next(struct d_registry_iterator* _iter);
 void  d_registry_iterator_reset(struct d_registry_iterator* _iter);
@@ -507,6 +807,9 @@ void d_registry_foreach_if(struct d_registry* _registry, fn_registry_row_predica
 bool   d_registry_reserve(struct d_registry* _registry, size_t _capacity);
 bool   d_registry_reserve_lookup(struct d_registry* _registry, size_t _capacity);
 bool   d_registry_shrink_to_fit(struct d_registry* _registry);
+// freeze also builds the perfect hash (a no-op if the registry is already
+// frozen with one); thaw drops it. Registries with an external index are
+// permanently frozen: freeze leaves them untouched and thaw fails.
 bool   d_registry_freeze(struct d_registry* _registry);
 bool   d_registry_thaw(struct d_registry* _registry);
 
@@ -527,5 +830,13 @@ void d_registry_free(struct d_registry* _registry);
 int d_registry_lookup_compare(const void* _a, const void* _b);
 int d_registry_lookup_compare_nocase(const void* _a, const void* _b);
 
+// prefix-first variants; valid only when both entries carry prefixes
+int d_registry_lookup_compare_prefix(const void* _a, const void* _b);
+int d_registry_lookup_compare_prefix_nocase(const void* _a, const void* _b);
+
+// folded-key variants; entries without a folded copy fall back to nocase
+int d_registry_lookup_compare_folded(const void* _a, const void* _b);
+int d_registry_lookup_compare_prefix_folded(const void* _a, const void* _b);
+
 
 #endif  // DJINTERP_C_CONTAINER_REGISTRY_
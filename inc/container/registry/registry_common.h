@@ -69,6 +69,18 @@ struct d_registry_value
     void*          value;          // current value (pointer or boxed bytes)
     fn_free        free_fn;        // optional destructor for owned values
     uint32_t       flags;
+    size_t         size;           // bytes boxed by d_cvar_registry_set_copy
+};
+
+// d_cvar_lookup_slot
+//   type: open-addressing slot of the name lookup built from the schema.
+//   notes:
+//     - `name` is NULL for an empty slot; names are not copied.
+struct d_cvar_lookup_slot
+{
+    const char* name;              // schema key or abbreviation
+    uint32_t    hash;              // hash of name (folded if case-insensitive)
+    uint16_t    enum_key;          // value slot
 };
 
 // d_cvar_registry
@@ -85,6 +97,9 @@ struct d_cvar_registry
     size_t                              values_count;  // typically max_enum + 1
 
     uint32_t                            flags;
+
+    struct d_cvar_lookup_slot*          lookup;        // name hash (or NULL)
+    size_t                              lookup_capacity; // slots (power of 2)
 };
 
 
@@ -112,4 +127,64 @@ int      d_registry_strcmp(const char* _a, const char* _b, bool _case_sensitive)
 uint16_t d_registry_schema_max_enum_key(const struct d_registry_schema_row* _schema, size_t _schema_count);
 
 
+//==============================================================================
+// Name lookup
+//
+// - Built once from the schema: keys and abbreviations hash straight to an
+//   enum_key, honoring D_CVAR_REGISTRY_FLAG_CASE_SENSITIVE (ASCII folding
+//   otherwise).  Without a lookup, name resolution scans the schema.
+// - The schema strings must outlive the lookup.
+//==============================================================================
+
+bool     d_cvar_registry_build_lookup(struct d_cvar_registry* _registry);
+void     d_cvar_registry_drop_lookup(struct d_cvar_registry* _registry);
+
+// d_cvar_registry_find
+//   function: resolves a key or abbreviation to its enum_key.
+//   return:
+//     true and *_out_enum_key set if found; false otherwise.
+bool     d_cvar_registry_find(const struct d_cvar_registry* _registry, const char* _name, uint16_t* _out_enum_key);
+
+// d_cvar_registry_value_by_name
+//   function: resolves a name directly to its values[enum_key] slot, or NULL.
+struct d_registry_value* d_cvar_registry_value_by_name(const struct d_cvar_registry* _registry, const char* _name);
+
+
+//==============================================================================
+// Typed access by enum_key (no string work)
+//==============================================================================
+
+// d_cvar_registry_get
+//   function: current value of the slot, or its default when unset; NULL if
+//   enum_key is out of range.
+const void* d_cvar_registry_get(const struct d_cvar_registry* _registry, uint16_t _enum_key);
+
+// d_cvar_registry_set
+//   function: points the slot at `_value` (not owned), releasing any value
+//   the slot owned.
+bool     d_cvar_registry_set(struct d_cvar_registry* _registry, uint16_t _enum_key, void* _value);
+
+// d_cvar_registry_set_copy
+//   function: boxes `_size` bytes from `_src` into registry-owned memory.
+//   Setting the same size again reuses the box without allocating.
+bool     d_cvar_registry_set_copy(struct d_cvar_registry* _registry, uint16_t _enum_key, const void* _src, size_t _size);
+
+// d_cvar_registry_reset
+//   function: releases the current value; the slot reads its default again.
+bool     d_cvar_registry_reset(struct d_cvar_registry* _registry, uint16_t _enum_key);
+
+// D_CVAR_REGISTRY_GET_AS
+//   macro: reads a scalar cvar by enum_key (value or default must be set).
+#define D_CVAR_REGISTRY_GET_AS(_registry, _enum_key, _type) \
+    (*(const _type*)d_cvar_registry_get((_registry), (uint16_t)(_enum_key)))
+
+// D_CVAR_REGISTRY_SET_AS
+//   macro: boxes a scalar cvar by enum_key.
+#define D_CVAR_REGISTRY_SET_AS(_registry, _enum_key, _type, _val)          \
+    d_cvar_registry_set_copy((_registry),                                  \
+                             (uint16_t)(_enum_key),                        \
+                             &(_type){ (_val) },                           \
+                             sizeof(_type))
+
+
 #endif // DJINTERP_C_CONTAINER_REGISTRY_COMMON_
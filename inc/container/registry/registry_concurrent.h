@@ -0,0 +1,176 @@
+/******************************************************************************
+* djinterp [container]                                   registry_concurrent.h
+*
+*   Lock-free concurrent reads for `d_registry`. Readers resolve keys against
+* an immutable, frozen snapshot reached through one atomic pointer; a single
+* writer thread builds a private draft copy, applies any number of changes to
+* it with the regular registry API, and publishes it with an atomic swap.
+*   Superseded snapshots are reclaimed with epoch-based reclamation: each
+* registered reader advertises the global epoch it entered under, and a
+* snapshot retired at epoch E is freed once every active reader has entered
+* at an epoch after E. Readers never block, allocate or take locks.
+*
+* USAGE:
+*   // setup
+*   struct d_registry_concurrent* c = d_registry_concurrent_new(reg);
+*
+*   // reader thread
+*   int id = d_registry_concurrent_reader_register(c);
+*   const struct d_registry* snap = d_registry_concurrent_read_begin(c, id);
+*   struct my_row* row = D_REGISTRY_GET(snap, "key", struct my_row);
+*   ...
+*   d_registry_concurrent_read_end(c, id);   // `row` is invalid after this
+*
+*   // writer thread
+*   struct d_registry* draft = d_registry_concurrent_write_begin(c);
+*   d_registry_add(draft, &new_row);
+*   d_registry_concurrent_publish(c);
+*
+* NOTES:
+*   - Exactly one thread may call the write functions at a time.
+*   - Registries with D_REGISTRY_FLAG_OWNS_ROWS are rejected: a row dropped
+*     by a writer may still be read through an older snapshot.
+*   - Requires C11 atomics.
+*
+* path:      \inc\container\registry\registry_concurrent.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_REGISTRY_CONCURRENT_
+#define DJINTERP_C_CONTAINER_REGISTRY_CONCURRENT_ 1
+
+#if defined(__STDC_NO_ATOMICS__)
+    #error "registry_concurrent.h requires C11 atomics"
+#endif
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "..\..\djinterp.h"
+#include ".\registry.h"
+
+
+// D_REGISTRY_CONCURRENT_MAX_READERS
+//   constant: number of reader slots; each reading thread holds one.
+#ifndef D_REGISTRY_CONCURRENT_MAX_READERS
+    #define D_REGISTRY_CONCURRENT_MAX_READERS 64
+#endif
+
+// D_REGISTRY_CONCURRENT_CACHE_LINE
+//   constant: size each reader slot is padded to, so that two readers never
+// write to the same cache line.
+#ifndef D_REGISTRY_CONCURRENT_CACHE_LINE
+    #define D_REGISTRY_CONCURRENT_CACHE_LINE 64
+#endif
+
+
+/******************************************************************************
+ * CORE STRUCTURES
+ *****************************************************************************/
+
+// d_registry_reader_slot
+//   struct: per-reader state. `epoch` is 0 while the reader is outside a
+// read section.
+struct d_registry_reader_slot
+{
+    _Atomic uint64_t epoch;      // epoch entered under, or 0
+    atomic_bool      in_use;     // slot claimed by a reader
+    char             pad[D_REGISTRY_CONCURRENT_CACHE_LINE -
+                         sizeof(uint64_t) - sizeof(atomic_bool)];
+};
+
+// d_registry_retired
+//   struct: writer-private list node for a superseded snapshot.
+struct d_registry_retired
+{
+    struct d_registry*         snapshot;  // superseded snapshot
+    uint64_t                   epoch;     // epoch at which it was unlinked
+    struct d_registry_retired* next;
+};
+
+// d_registry_concurrent
+//   struct: a published snapshot plus the reclamation state around it.
+struct d_registry_concurrent
+{
+    struct d_registry_reader_slot readers[D_REGISTRY_CONCURRENT_MAX_READERS];
+    _Atomic(struct d_registry*)   current;        // published snapshot
+    _Atomic uint64_t              epoch;          // global epoch (>= 1)
+    struct d_registry*            draft;          // writer: open draft
+    struct d_registry_retired*    retired;        // writer: pending frees
+    size_t                        retired_count;  // writer: list length
+};
+
+
+/******************************************************************************
+ * CONSTRUCTOR / DESTRUCTOR FUNCTIONS
+ *****************************************************************************/
+
+// d_registry_concurrent_new
+//   function: takes ownership of `_registry` and publishes it (frozen) as the
+// first snapshot. Returns NULL for NULL, static, batching or OWNS_ROWS
+// registries, or on allocation failure (the registry is not freed then).
+struct d_registry_concurrent* d_registry_concurrent_new(struct d_registry* _registry);
+
+// d_registry_concurrent_free
+//   function: frees every snapshot and any open draft. No reader may be
+// inside a read section.
+void d_registry_concurrent_free(struct d_registry_concurrent* _concurrent);
+
+
+/******************************************************************************
+ * READER FUNCTIONS
+ *****************************************************************************/
+
+// d_registry_concurrent_reader_register
+//   function: claims a reader slot; returns its id, or -1 if all slots are
+// taken.
+int  d_registry_concurrent_reader_register(struct d_registry_concurrent* _concurrent);
+
+// d_registry_concurrent_reader_unregister
+//   function: releases a reader slot (ending any open read section).
+void d_registry_concurrent_reader_unregister(struct d_registry_concurrent* _concurrent, int _reader);
+
+// d_registry_concurrent_read_begin
+//   function: enters a read section and returns the current snapshot. The
+// snapshot and any row obtained from it stay valid until read_end. Read
+// sections do not nest.
+const struct d_registry* d_registry_concurrent_read_begin(struct d_registry_concurrent* _concurrent, int _reader);
+
+// d_registry_concurrent_read_end
+//   function: leaves the read section.
+void d_registry_concurrent_read_end(struct d_registry_concurrent* _concurrent, int _reader);
+
+
+/******************************************************************************
+ * WRITER FUNCTIONS
+ *****************************************************************************/
+
+// d_registry_concurrent_write_begin
+//   function: returns the writer's draft, a thawed private copy of the
+// current snapshot, creating it if none is open. Modify it with the regular
+// registry API; readers do not see changes until publish.
+struct d_registry* d_registry_concurrent_write_begin(struct d_registry_concurrent* _concurrent);
+
+// d_registry_concurrent_publish
+//   function: freezes the draft, swaps it in as the current snapshot, retires
+// the previous one and reclaims what it can.
+bool d_registry_concurrent_publish(struct d_registry_concurrent* _concurrent);
+
+// d_registry_concurrent_write_abort
+//   function: discards the open draft, if any.
+void d_registry_concurrent_write_abort(struct d_registry_concurrent* _concurrent);
+
+// d_registry_concurrent_reclaim
+//   function: frees retired snapshots no reader can still reach; returns the
+// number still pending.
+size_t d_registry_concurrent_reclaim(struct d_registry_concurrent* _concurrent);
+
+// single-change helpers: apply to the open draft if there is one (so they
+// publish together), otherwise copy, apply and publish immediately
+bool d_registry_concurrent_add(struct d_registry_concurrent* _concurrent, const void* _row);
+bool d_registry_concurrent_add_alias(struct d_registry_concurrent* _concurrent, const char* _key, const char* _alias);
+bool d_registry_concurrent_remove(struct d_registry_concurrent* _concurrent, const char* _key);
+
+
+#endif  // DJINTERP_C_CONTAINER_REGISTRY_CONCURRENT_
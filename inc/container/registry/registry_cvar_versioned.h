@@ -0,0 +1,182 @@
+/******************************************************************************
+* djinterp [container]                               registry_cvar_versioned.h
+*
+*   Versioned, lock-free snapshots of a `d_cvar_registry`'s values. A single
+* writer (e.g. the console thread) stages changes against the registry and
+* publishes them as an immutable snapshot with an atomic swap; readers (e.g.
+* tick threads) take one snapshot per tick and read every cvar from it, so
+* all values seen within a tick belong to the same version.
+*   Each snapshot carries its version, the version at which every enum_key
+* last changed and a bitset of the enum_keys changed by that version, so
+* "has anything changed since V" is one atomic load and subscribers can
+* react to individual cvars. Superseded snapshots are reclaimed with the
+* same epoch scheme as `registry_concurrent.h`.
+*
+* USAGE:
+*   // writer
+*   d_cvar_versioned_set_copy(v, CVAR_GRAVITY, &gravity, sizeof(gravity));
+*   d_cvar_versioned_publish(v);
+*
+*   // reader, once per tick
+*   if (d_cvar_versioned_changed_since(v, seen))
+*   {
+*       const struct d_cvar_snapshot* s = d_cvar_versioned_read_begin(v, id);
+*       int g = D_CVAR_SNAPSHOT_GET_AS(s, CVAR_GRAVITY, int);
+*       seen  = s->version;
+*       d_cvar_versioned_read_end(v, id);
+*   }
+*
+* NOTES:
+*   - Values boxed by d_cvar_registry_set_copy are copied into the snapshot;
+*     pointers stored with d_cvar_registry_set are shared as-is, so the
+*     memory they point to must not change while published.
+*   - Exactly one thread may call the writer functions at a time, and only
+*     that thread may touch the registry after d_cvar_versioned_new. The
+*     registry's values array must not be resized.
+*   - Requires C11 atomics.
+*
+* path:      \inc\container\registry\registry_cvar_versioned.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_REGISTRY_CVAR_VERSIONED_
+#define DJINTERP_C_CONTAINER_REGISTRY_CVAR_VERSIONED_ 1
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "..\..\djinterp.h"
+#include ".\registry_common.h"
+#include ".\registry_concurrent.h"
+
+
+// D_CVAR_SNAPSHOT_ALIGN
+//   constant: alignment of each boxed value copied into a snapshot.
+#define D_CVAR_SNAPSHOT_ALIGN 16u
+
+// D_CVAR_SNAPSHOT_GET_AS
+//   macro: reads a scalar cvar from a snapshot (value or default must exist).
+#define D_CVAR_SNAPSHOT_GET_AS(snapshot, enum_key, type) \
+    (*(const type*)((snapshot)->values[(enum_key)]))
+
+// D_CVAR_SNAPSHOT_IS_DIRTY
+//   macro: true if `enum_key` changed in the snapshot's own version.
+#define D_CVAR_SNAPSHOT_IS_DIRTY(snapshot, enum_key)                        \
+    ((((snapshot)->dirty[(size_t)(enum_key) / 64u]) >>                      \
+      ((size_t)(enum_key) % 64u)) & 1u)
+
+// D_CVAR_SNAPSHOT_CHANGED_SINCE
+//   macro: true if `enum_key` changed after version `since`.
+#define D_CVAR_SNAPSHOT_CHANGED_SINCE(snapshot, enum_key, since) \
+    ((snapshot)->changed_at[(enum_key)] > (uint64_t)(since))
+
+
+/******************************************************************************
+ * CORE STRUCTURES
+ *****************************************************************************/
+
+// d_cvar_snapshot
+//   struct: one immutable published version of every cvar value. All arrays
+// live in the same allocation as the struct.
+struct d_cvar_snapshot
+{
+    uint64_t     version;     // publish counter (first snapshot is 1)
+    size_t       count;       // values_count of the registry
+    const void** values;      // per enum_key: value, default, or NULL
+    uint64_t*    changed_at;  // per enum_key: version of the last change
+    uint64_t*    dirty;       // bitset: enum_keys changed by `version`
+    size_t       dirty_words; // 64-bit words in `dirty`
+};
+
+// d_cvar_snapshot_retired
+//   struct: writer-private list node for a superseded snapshot.
+struct d_cvar_snapshot_retired
+{
+    struct d_cvar_snapshot*         snapshot;  // superseded snapshot
+    uint64_t                        epoch;     // epoch at which it was unlinked
+    struct d_cvar_snapshot_retired* next;
+};
+
+// d_cvar_versioned
+//   struct: a published snapshot, the writer's staged changes and the
+// reclamation state.
+struct d_cvar_versioned
+{
+    struct d_registry_reader_slot   readers[D_REGISTRY_CONCURRENT_MAX_READERS];
+    _Atomic(struct d_cvar_snapshot*) current;      // published snapshot
+    _Atomic uint64_t                epoch;         // global epoch (>= 1)
+    _Atomic uint64_t                version;       // current->version
+    struct d_cvar_registry*         registry;      // writer: staging area
+    size_t                          value_count;   // registry values_count
+    uint64_t*                       staged;        // writer: changed bitset
+    bool                            has_staged;    // writer: any bit set
+    struct d_cvar_snapshot_retired* retired;       // writer: pending frees
+    size_t                          retired_count; // writer: list length
+};
+
+
+/******************************************************************************
+ * CONSTRUCTOR / DESTRUCTOR FUNCTIONS
+ *****************************************************************************/
+
+// d_cvar_versioned_new
+//   function: publishes the registry's current values as version 1 (every
+// enum_key dirty). The registry is borrowed, not freed, and from now on is
+// only modified through the writer functions or followed by _mark.
+struct d_cvar_versioned* d_cvar_versioned_new(struct d_cvar_registry* _registry);
+
+// d_cvar_versioned_free
+//   function: frees every snapshot. No reader may be inside a read section.
+void d_cvar_versioned_free(struct d_cvar_versioned* _versioned);
+
+
+/******************************************************************************
+ * READER FUNCTIONS
+ *****************************************************************************/
+
+int  d_cvar_versioned_reader_register(struct d_cvar_versioned* _versioned);
+void d_cvar_versioned_reader_unregister(struct d_cvar_versioned* _versioned, int _reader);
+
+// d_cvar_versioned_read_begin
+//   function: enters a read section and returns the current snapshot, valid
+// (with every value it points to) until read_end.
+const struct d_cvar_snapshot* d_cvar_versioned_read_begin(struct d_cvar_versioned* _versioned, int _reader);
+void d_cvar_versioned_read_end(struct d_cvar_versioned* _versioned, int _reader);
+
+// d_cvar_versioned_version
+//   function: version of the current snapshot; needs no read section.
+uint64_t d_cvar_versioned_version(const struct d_cvar_versioned* _versioned);
+
+// d_cvar_versioned_changed_since
+//   function: true if a version newer than `_version` has been published.
+bool d_cvar_versioned_changed_since(const struct d_cvar_versioned* _versioned, uint64_t _version);
+
+
+/******************************************************************************
+ * WRITER FUNCTIONS
+ *****************************************************************************/
+
+// staged changes: apply to the registry at once, become visible to readers
+// with the next publish
+bool d_cvar_versioned_set(struct d_cvar_versioned* _versioned, uint16_t _enum_key, void* _value);
+bool d_cvar_versioned_set_copy(struct d_cvar_versioned* _versioned, uint16_t _enum_key, const void* _src, size_t _size);
+bool d_cvar_versioned_reset(struct d_cvar_versioned* _versioned, uint16_t _enum_key);
+
+// d_cvar_versioned_mark
+//   function: stages an enum_key changed directly through the registry.
+bool d_cvar_versioned_mark(struct d_cvar_versioned* _versioned, uint16_t _enum_key);
+
+// d_cvar_versioned_publish
+//   function: publishes staged changes as the next version, retires the
+// previous snapshot and reclaims what it can. With nothing staged it
+// publishes nothing and returns true.
+bool d_cvar_versioned_publish(struct d_cvar_versioned* _versioned);
+
+// d_cvar_versioned_reclaim
+//   function: frees retired snapshots no reader can still reach; returns the
+// number still pending.
+size_t d_cvar_versioned_reclaim(struct d_cvar_versioned* _versioned);
+
+
+#endif  // DJINTERP_C_CONTAINER_REGISTRY_CVAR_VERSIONED_
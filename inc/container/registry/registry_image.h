@@ -0,0 +1,126 @@
+/******************************************************************************
+* djinterp [container]                                        registry_image.h
+*
+*   Memory-mappable binary images of a `d_registry`. An image holds the rows
+* (keys relocated into a string table), the sorted lookup, the perfect hash
+* and, if the source had one, the hash index. Mapping an image is a single
+* mmap (MapViewOfFileEx on Windows) and yields a registry flagged
+* `D_REGISTRY_FLAG_STATIC_ROWS | D_REGISTRY_FLAG_FROZEN` whose indexes are
+* marked external (see D_REGISTRY_HAS_EXTERNAL_INDEX).
+*   Every key pointer in the image is stored pre-relocated against a
+* preferred base address chosen at save time. When the mapping lands on that
+* address the file is used as-is, read-only and shared between processes,
+* so start-up cost does not depend on the registry size. Otherwise the image
+* is mapped copy-on-write and its key pointers are rebased in one O(N) pass.
+*
+* IMAGE LAYOUT (all sections 16-byte aligned):
+*   header | rows | lookup | perfect hash | hash index | string table
+*
+* NOTES:
+*   - Rows are copied byte-for-byte apart from the leading key; any other
+*     pointer members are meaningless once mapped.
+*   - Images are only portable between builds with the same pointer size,
+*     byte order and `d_registry` entry layouts (checked on load).
+*   - A mapped registry must be released with d_registry_unmap_image, never
+*     d_registry_free. Its indexes live in the mapping, so freeze is a no-op
+*     and thaw, clear and the index rebuild functions refuse it.
+*
+* path:      \inc\container\registry\registry_image.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_REGISTRY_IMAGE_
+#define DJINTERP_C_CONTAINER_REGISTRY_IMAGE_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include "..\..\djinterp.h"
+#include ".\registry.h"
+
+
+// D_REGISTRY_IMAGE_MAGIC
+//   constant: first 8 bytes of every image file.
+#define D_REGISTRY_IMAGE_MAGIC   "DREGIMG"
+
+// D_REGISTRY_IMAGE_VERSION
+//   constant: bumped whenever the layout changes.
+#define D_REGISTRY_IMAGE_VERSION 1u
+
+// D_REGISTRY_IMAGE_ALIGN
+//   constant: alignment of every section within an image.
+#define D_REGISTRY_IMAGE_ALIGN   16u
+
+#ifndef D_REGISTRY_IMAGE_BASE_MIN
+    // D_REGISTRY_IMAGE_BASE_MIN / D_REGISTRY_IMAGE_BASE_SLOTS
+    //   constants: preferred base addresses are picked from
+    // BASE_MIN + k * 256 MiB, k < BASE_SLOTS, by a hash of the image. They
+    // are only used on 64-bit targets; 32-bit images always rebase.
+    #define D_REGISTRY_IMAGE_BASE_MIN   0x200000000000ULL
+#endif  // D_REGISTRY_IMAGE_BASE_MIN
+
+#ifndef D_REGISTRY_IMAGE_BASE_SLOTS
+    #define D_REGISTRY_IMAGE_BASE_SLOTS 0x10000ULL
+#endif  // D_REGISTRY_IMAGE_BASE_SLOTS
+
+
+/******************************************************************************
+ * CORE STRUCTURES
+ *****************************************************************************/
+
+// d_registry_image_header
+//   struct: on-disk header. Offsets are from the start of the file; `base` is
+// the address every stored key pointer was relocated against.
+struct d_registry_image_header
+{
+    char     magic[8];          // D_REGISTRY_IMAGE_MAGIC
+    uint32_t version;           // D_REGISTRY_IMAGE_VERSION
+    uint32_t byte_order;        // 0x01020304 as written
+    uint32_t pointer_size;      // sizeof(void*)
+    uint32_t entry_size;        // sizeof(struct d_registry_lookup_entry)
+    uint32_t slot_size;         // sizeof(struct d_registry_hash_slot)
+    uint32_t flags;             // source registry flags
+    uint64_t base;              // preferred mapping address
+    uint64_t total_size;        // bytes in the image
+    uint64_t row_size;
+    uint64_t row_count;
+    uint64_t rows_offset;
+    uint64_t lookup_count;
+    uint64_t lookup_offset;
+    uint64_t perfect_buckets;   // 0 when no perfect hash was stored
+    uint64_t perfect_slots;
+    uint64_t perfect_offset;
+    uint64_t hash_capacity;     // 0 when no hash index was stored
+    uint64_t hash_count;
+    uint64_t hash_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+};
+
+
+/******************************************************************************
+ * IMAGE FUNCTIONS
+ *****************************************************************************/
+
+// d_registry_save_image
+//   function: writes `_registry` to `_path`. Fails for registries with an
+// open batch or tombstoned rows (compact first), and on I/O errors.
+bool d_registry_save_image(const struct d_registry* _registry, const char* _path);
+
+// d_registry_map_image
+//   function: maps an image written by d_registry_save_image. Returns NULL if
+// the file is missing, truncated or built for an incompatible layout.
+struct d_registry* d_registry_map_image(const char* _path);
+
+// d_registry_unmap_image
+//   function: releases a registry returned by d_registry_map_image. Rows and
+// keys obtained from it become invalid.
+void d_registry_unmap_image(struct d_registry* _registry);
+
+// d_registry_image_is_relocated
+//   function: true if the image could not be mapped at its preferred base and
+// was rebased (private copy-on-write pages, O(N) start-up).
+bool d_registry_image_is_relocated(const struct d_registry* _registry);
+
+
+#endif  // DJINTERP_C_CONTAINER_REGISTRY_IMAGE_
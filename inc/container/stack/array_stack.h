@@ -0,0 +1,126 @@
+/******************************************************************************
+* djinterp [container]                                         array_stack.h
+*
+*   LIFO (last-in, first-out) stack stored in one contiguous array of value
+* pointers. It mirrors the public API of `d_stack` (stack.h), but push, pop
+* and peek are amortized O(1) with no per-element allocation, and get/set by
+* index are O(1). Values are stored bottom-first, so the top of the stack is
+* the last occupied slot.
+*   Functions of `d_stack` that expose a `d_linked_node` are replaced by ones
+* that return a pointer to the value's slot, which stays valid until the
+* stack is next modified.
+*
+*
+* path:      \inc\container\stack\array_stack.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_C_CONTAINER_ARRAY_STACK_
+#define DJINTERP_C_CONTAINER_ARRAY_STACK_ 1
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include "..\..\djinterp.h"
+#include "..\..\dmemory.h"
+#include "..\container.h"
+#include "..\vector\vector_common.h"
+
+
+// D_ARRAY_STACK_FOREACH
+//   macro: iterate over every slot in an array stack (top to bottom); `_slot`
+// is a `void**`, so `*_slot` reads or replaces the value.
+#define D_ARRAY_STACK_FOREACH(_slot, _stack_ptr)                            \
+    for (void** (_slot) = d_array_stack_iter_begin(_stack_ptr);             \
+         (_slot) != NULL;                                                   \
+         (_slot) = d_array_stack_iter_next((_stack_ptr), (_slot)))
+
+// D_ARRAY_STACK_FOREACH_VALUE
+//   macro: iterate over every value pointer in an array stack (top to
+// bottom).
+#define D_ARRAY_STACK_FOREACH_VALUE(_value, _slot, _stack_ptr)              \
+    for (void** (_slot) = d_array_stack_iter_begin(_stack_ptr);             \
+         (_slot) != NULL && (((_value) = *(_slot)), true);                  \
+         (_slot) = d_array_stack_iter_next((_stack_ptr), (_slot)))
+
+
+// d_array_stack
+//   struct: a stack backed by a growable array; `values[count - 1]` is the
+// top.
+struct d_array_stack
+{
+    size_t count;
+    size_t capacity;
+    void** values;
+};
+
+
+// `d_array_stack` creation functions
+struct d_array_stack* d_array_stack_new(void);
+struct d_array_stack* d_array_stack_new_with_capacity(size_t _capacity);
+struct d_array_stack* d_array_stack_new_from_arr(const void* const* _values, size_t _value_count);
+struct d_array_stack* d_array_stack_new_from_args(size_t _arg_count, ...);
+struct d_array_stack* d_array_stack_new_copy(const struct d_array_stack* _other);
+struct d_array_stack* d_array_stack_new_copy_range(const struct d_array_stack* _other, d_index _start, d_index _end);
+struct d_array_stack* d_array_stack_new_slice(const struct d_array_stack* _other, d_index _start);
+struct d_array_stack* d_array_stack_new_slice_range(const struct d_array_stack* _other, d_index _start, d_index _end);
+struct d_array_stack* d_array_stack_new_fill(size_t _count, void* _value);
+struct d_array_stack* d_array_stack_new_merge(size_t _stack_count, ...);
+
+
+// `d_array_stack` manipulation functions
+bool  d_array_stack_push(struct d_array_stack* _stack, void* _value);
+bool  d_array_stack_push_values(struct d_array_stack* _stack, const void* const* _values, size_t _value_count);
+bool  d_array_stack_push_args(struct d_array_stack* _stack, size_t _arg_count, ...);
+bool  d_array_stack_push_stack(struct d_array_stack* _destination, const struct d_array_stack* _source);
+bool  d_array_stack_push_stack_range(struct d_array_stack* _destination, const struct d_array_stack* _source, d_index _start, d_index _end);
+
+bool  d_array_stack_insert(struct d_array_stack* _stack, void* _value, d_index _index);
+bool  d_array_stack_insert_values(struct d_array_stack* _stack, const void* const* _values, size_t _value_count, d_index _index);
+bool  d_array_stack_insert_stack(struct d_array_stack* _destination, const struct d_array_stack* _source, d_index _index);
+bool  d_array_stack_insert_stack_range(struct d_array_stack* _destination, const struct d_array_stack* _source, d_index _start, d_index _end, d_index _index);
+
+bool  d_array_stack_append(struct d_array_stack* _stack, void* _value);
+bool  d_array_stack_append_values(struct d_array_stack* _stack, const void* const* _values, size_t _value_count);
+bool  d_array_stack_append_stack(struct d_array_stack* _destination, const struct d_array_stack* _source);
+bool  d_array_stack_append_stack_range(struct d_array_stack* _destination, const struct d_array_stack* _source, d_index _start, d_index _end);
+
+void* d_array_stack_peek(const struct d_array_stack* _stack);
+void* d_array_stack_peek_if_nonnull(const struct d_array_stack* _stack);
+void* d_array_stack_pop(struct d_array_stack* _stack);
+
+void* d_array_stack_get(const struct d_array_stack* _stack, d_index _index);
+bool  d_array_stack_set(struct d_array_stack* _stack, d_index _index, void* _value);
+
+void** d_array_stack_get_slot(const struct d_array_stack* _stack, d_index _index);
+
+void* d_array_stack_remove_at(struct d_array_stack* _stack, d_index _index);
+bool  d_array_stack_remove_first_match(struct d_array_stack* _stack, const void* _value, fn_comparator _comparator, void** _removed_value);
+
+bool  d_array_stack_is_empty(const struct d_array_stack* _stack);
+
+bool    d_array_stack_contains(const struct d_array_stack* _stack, const void* _value, fn_comparator _comparator);
+ssize_t d_array_stack_find(const struct d_array_stack* _stack, const void* _value, fn_comparator _comparator);
+void**  d_array_stack_find_slot(const struct d_array_stack* _stack, const void* _value, fn_comparator _comparator);
+
+bool  d_array_stack_reverse(struct d_array_stack* _stack);
+void  d_array_stack_sort(struct d_array_stack* _stack, fn_comparator _comparator);
+
+bool  d_array_stack_reserve(struct d_array_stack* _stack, size_t _capacity);
+bool  d_array_stack_shrink_to_fit(struct d_array_stack* _stack);
+
+bool  d_array_stack_clear(struct d_array_stack* _stack);
+bool  d_array_stack_clear_deep(struct d_array_stack* _stack, fn_free _free_fn);
+
+
+// iteration (used by D_ARRAY_STACK_FOREACH)
+void** d_array_stack_iter_begin(const struct d_array_stack* _stack);
+void** d_array_stack_iter_next(const struct d_array_stack* _stack, void** _slot);
+
+
+// memory management
+void d_array_stack_free(struct d_array_stack* _stack);
+void d_array_stack_free_deep(struct d_array_stack* _stack, fn_free _free_fn);
+
+
+#endif // DJINTERP_C_CONTAINER_ARRAY_STACK_
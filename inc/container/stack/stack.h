@@ -17,7 +17,7 @@
 #include "..\..\djinterp.h"
 #include "..\..\dmemory.h"
 #include "..\container.h"
-#include "..\linked_node.h"
+#include "..\node\linked_node.h"
 #include ".\stack_common.h"
 
 
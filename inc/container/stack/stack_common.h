@@ -17,7 +17,7 @@
 #include "..\..\djinterp.h"
 #include "..\..\dmemory.h"
 #include "..\container.h"
-#include "..\linked_node.h"
+#include "..\node\linked_node.h"
 
 
 bool d_stack_common_init_empty(struct d_linked_node** _top, size_t* _count);
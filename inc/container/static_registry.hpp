@@ -0,0 +1,581 @@
+/******************************************************************************
+* djinterp [container]                                       static_registry.hpp
+*
+*   Compile-time builder for `d_registry` tables. Rows, the sorted lookup and
+* (optionally) the minimal perfect hash are all computed by constexpr
+* functions, so a registry defined this way needs no D_REGISTRY_INIT call and
+* can be placed in read-only storage. The result exposes a plain
+* `struct d_registry` that C callers use unchanged.
+*
+* USAGE:
+*   struct my_row { const char* key; int value; };
+*
+*   static constexpr my_row my_rows[] = {
+*       { "zebra", 1 }, { "apple", 2 }, { "mango", 3 }
+*   };
+*   static constexpr registry_alias my_aliases[] = { { "z", "zebra" } };
+*
+*   static constexpr auto my_table =
+*       djinterp::container::make_static_registry(my_rows, my_aliases);
+*   static constexpr d_registry my_registry = my_table.registry();
+*
+*   // C code: d_registry_get(&my_registry, "z");
+*
+* NOTES:
+*   - The emitted registry is flagged STATIC_ROWS | FROZEN and its perfect
+*     hash is marked external, so freeze is a no-op and thaw, clear and the
+*     sort/rebuild functions refuse it. It is still not heap-allocated: never
+*     pass it to d_registry_free.
+*   - The perfect hash mirrors the layout and hash functions used by
+*     d_registry_build_perfect_hash in registry.c; the two must stay in sync.
+*   - Case folding is ASCII-only, matching the runtime "C" locale.
+*   - Lookup entries carry inline key prefixes (D_REGISTRY_FLAG_KEY_PREFIX).
+*   - Row types must name their leading `const char*` key member `key`.
+*
+* path:      \inc\container\static_registry.hpp
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_STATIC_REGISTRY_
+#define DJINTERP_STATIC_REGISTRY_ 1
+
+#include <cstddef>
+#include <cstdint>
+#include "..\env.h"
+#include "..\cpp_features.h"
+#include "..\djinterp.h"
+
+extern "C"
+{
+#include ".\registry\registry.h"
+}
+
+#if D_ENV_LANG_IS_CPP14_OR_HIGHER
+
+
+NS_DJINTERP
+NS_CONTAINER
+
+
+// registry_alias
+//   struct: an alias declaration for make_static_registry; `alias` resolves
+// to the row whose key is `key`.
+struct registry_alias
+{
+    const char* alias;
+    const char* key;
+};
+
+
+NS_INTERNAL
+
+    // registry_ct_error
+    //   function: deliberately non-constexpr; reaching it during constant
+    // evaluation turns a malformed table into a compile-time error.
+    inline void
+    registry_ct_error
+    (
+        const char* _reason
+    )
+    {
+        (void)_reason;
+    }
+
+    constexpr unsigned char
+    registry_ct_fold
+    (
+        unsigned char _c,
+        bool          _nocase
+    )
+    {
+        return (_nocase && (_c >= 'A') && (_c <= 'Z'))
+                   ? static_cast<unsigned char>(_c + ('a' - 'A'))
+                   : _c;
+    }
+
+    // registry_ct_keycmp
+    //   function: constexpr mirror of the runtime key comparators.
+    constexpr int
+    registry_ct_keycmp
+    (
+        const char* _a,
+        const char* _b,
+        bool        _nocase
+    )
+    {
+        std::size_t i = 0;
+
+        if (_a == _b) return 0;
+        if (!_a)      return -1;
+        if (!_b)      return 1;
+
+        while (_a[i] && _b[i])
+        {
+            const unsigned char ca = registry_ct_fold(static_cast<unsigned char>(_a[i]), _nocase);
+            const unsigned char cb = registry_ct_fold(static_cast<unsigned char>(_b[i]), _nocase);
+
+            if (ca != cb)
+            {
+                return (ca < cb) ? -1 : 1;
+            }
+
+            ++i;
+        }
+
+        if (_a[i] == _b[i]) return 0;
+        return _a[i] ? 1 : -1;
+    }
+
+    // registry_ct_key_prefix
+    //   function: constexpr mirror of d_registry_key_prefix.
+    constexpr std::uint64_t
+    registry_ct_key_prefix
+    (
+        const char* _key,
+        bool        _nocase
+    )
+    {
+        std::uint64_t prefix = 0;
+
+        if (!_key)
+        {
+            return 0;
+        }
+
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            if (!_key[i])
+            {
+                return (i == 0) ? 0 : (prefix << (8 * (8 - i)));
+            }
+
+            prefix = (prefix << 8) |
+                     registry_ct_fold(static_cast<unsigned char>(_key[i]), _nocase);
+        }
+
+        return prefix;
+    }
+
+    // registry_ct_hash_key
+    //   function: constexpr mirror of d_registry_hash_key (FNV-1a).
+    constexpr std::uint64_t
+    registry_ct_hash_key
+    (
+        const char* _key,
+        bool        _nocase
+    )
+    {
+        std::uint64_t h = 14695981039346656037ULL;
+        std::size_t   i = 0;
+
+        if (!_key)
+        {
+            return 0;
+        }
+
+        while (_key[i])
+        {
+            h ^= static_cast<std::uint64_t>(
+                     registry_ct_fold(static_cast<unsigned char>(_key[i]), _nocase));
+            h *= 1099511628211ULL;
+            ++i;
+        }
+
+        return static_cast<std::uint64_t>(static_cast<std::size_t>(h ^ (h >> 32)));
+    }
+
+    // registry_ct_mix
+    //   function: constexpr mirror of d_registry_mix (splitmix64 finalizer).
+    constexpr std::uint64_t
+    registry_ct_mix
+    (
+        std::uint64_t _x
+    )
+    {
+        _x ^= _x >> 30;
+        _x *= 0xBF58476D1CE4E5B9ULL;
+        _x ^= _x >> 27;
+        _x *= 0x94D049BB133111EBULL;
+        _x ^= _x >> 31;
+
+        return _x;
+    }
+
+    constexpr std::size_t
+    registry_ct_perfect_slot
+    (
+        std::uint64_t _hash,
+        std::uint32_t _displacement,
+        std::size_t   _slots
+    )
+    {
+        return static_cast<std::size_t>(
+            registry_ct_mix(_hash ^ (static_cast<std::uint64_t>(_displacement + 1u) *
+                                     0x9E3779B97F4A7C15ULL)) % _slots);
+    }
+
+NS_END  // internal
+
+
+// static_registry
+//   struct: compile-time registry storage. The `entries` (= _N + _A) lookup
+// entries hold the row keys and aliases in sorted order; the perfect hash
+// side table holds `buckets` displacements followed by `entries` lookup
+// indices.
+template<typename    _Row,
+         std::size_t _N,
+         std::size_t _A = 0>
+struct static_registry
+{
+    static constexpr std::size_t entries = _N + _A;
+    static constexpr std::size_t buckets = (entries / 2) + 1;
+
+    _Row                           rows[_N];
+    struct d_registry_lookup_entry lookup[entries];
+    std::uint32_t                  perfect[buckets + entries];
+    bool                           has_perfect;
+    std::uint8_t                   flags;
+
+    // registry
+    //   function: emits the C view of this table. Only meaningful on an
+    // object with static storage duration.
+    constexpr struct d_registry
+    registry
+    (
+    ) const
+    {
+        struct d_registry reg {};
+
+        reg.rows            = static_cast<void*>(const_cast<_Row*>(rows));
+        reg.row_size        = sizeof(_Row);
+        reg.count           = _N;
+        reg.capacity        = _N;
+        reg.lookup          = const_cast<struct d_registry_lookup_entry*>(lookup);
+        reg.lookup_count    = entries;
+        reg.lookup_capacity = entries;
+        reg.flags           = static_cast<std::uint8_t>(flags                       |
+                                                        D_REGISTRY_FLAG_STATIC_ROWS |
+                                                        D_REGISTRY_FLAG_FROZEN);
+        reg.row_free        = nullptr;
+        reg.lookup_sorted   = entries;
+        reg.perfect_hash    = has_perfect ? const_cast<std::uint32_t*>(perfect)
+                                          : nullptr;
+        reg.perfect_buckets = has_perfect ? buckets : 0;
+        reg.perfect_slots   = has_perfect ? entries : 0;
+        reg.external_index  = true;
+
+        return reg;
+    }
+};
+
+
+NS_INTERNAL
+
+    // registry_ct_sort
+    //   function: constexpr heapsort of the lookup by key.
+    template<std::size_t _M>
+    constexpr void
+    registry_ct_sort
+    (
+        struct d_registry_lookup_entry (&_lookup)[_M],
+        bool                             _nocase
+    )
+    {
+        std::size_t start = _M / 2;
+        std::size_t end   = _M;
+
+        while (end > 1)
+        {
+            std::size_t root = 0;
+
+            if (start > 0)
+            {
+                --start;
+            }
+            else
+            {
+                --end;
+
+                const struct d_registry_lookup_entry tmp = _lookup[end];
+                _lookup[end] = _lookup[0];
+                _lookup[0]   = tmp;
+            }
+
+            root = start;
+
+            while ((2 * root) + 1 < end)
+            {
+                std::size_t child = (2 * root) + 1;
+
+                if ( (child + 1 < end) &&
+                     (registry_ct_keycmp(_lookup[child].key,
+                                         _lookup[child + 1].key,
+                                         _nocase) < 0) )
+                {
+                    ++child;
+                }
+
+                if (registry_ct_keycmp(_lookup[root].key,
+                                       _lookup[child].key,
+                                       _nocase) >= 0)
+                {
+                    break;
+                }
+
+                const struct d_registry_lookup_entry tmp = _lookup[root];
+                _lookup[root]  = _lookup[child];
+                _lookup[child] = tmp;
+                root           = child;
+            }
+        }
+    }
+
+    // registry_ct_build_perfect
+    //   function: constexpr hash-and-displace placement; same algorithm and
+    // table layout as d_registry_build_perfect_hash.
+    template<typename _Row, std::size_t _N, std::size_t _A>
+    constexpr bool
+    registry_ct_build_perfect
+    (
+        static_registry<_Row, _N, _A>& _out,
+        bool                           _nocase
+    )
+    {
+        constexpr std::size_t n = static_registry<_Row, _N, _A>::entries;
+        constexpr std::size_t r = static_registry<_Row, _N, _A>::buckets;
+
+        std::uint64_t hashes[n]    = {};
+        std::size_t   bucket_of[n] = {};
+        std::size_t   size[r]      = {};
+        std::size_t   order[r]     = {};
+        std::size_t   tried[n]     = {};
+        bool          taken[n]     = {};
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            hashes[i]    = registry_ct_hash_key(_out.lookup[i].key, _nocase);
+            bucket_of[i] = static_cast<std::size_t>(registry_ct_mix(hashes[i]) % r);
+            size[bucket_of[i]] += 1;
+        }
+
+        for (std::size_t i = 0; i < r; ++i)
+        {
+            order[i]          = i;
+            _out.perfect[i]   = 0;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            _out.perfect[r + i] = UINT32_MAX;
+        }
+
+        // largest buckets first (insertion sort; r is small at compile time)
+        for (std::size_t i = 1; i < r; ++i)
+        {
+            const std::size_t b = order[i];
+            std::size_t       j = i;
+
+            while ( (j > 0) && (size[order[j - 1]] < size[b]) )
+            {
+                order[j] = order[j - 1];
+                --j;
+            }
+
+            order[j] = b;
+        }
+
+        for (std::size_t i = 0; i < r && size[order[i]] > 0; ++i)
+        {
+            const std::size_t b      = order[i];
+            bool              placed = false;
+
+            for (std::uint32_t d = 0;
+                 !placed && d < D_REGISTRY_PERFECT_HASH_MAX_TRIES;
+                 ++d)
+            {
+                std::size_t m = 0;
+
+                placed = true;
+
+                for (std::size_t k = 0; placed && k < n; ++k)
+                {
+                    if (bucket_of[k] != b)
+                    {
+                        continue;
+                    }
+
+                    const std::size_t slot = registry_ct_perfect_slot(hashes[k], d, n);
+
+                    for (std::size_t j = 0; j < m; ++j)
+                    {
+                        if (tried[j] == slot)
+                        {
+                            placed = false;
+                        }
+                    }
+
+                    if (taken[slot])
+                    {
+                        placed = false;
+                    }
+
+                    tried[m++] = slot;
+                }
+
+                if (placed)
+                {
+                    std::size_t j = 0;
+
+                    _out.perfect[b] = d;
+
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                        if (bucket_of[k] == b)
+                        {
+                            taken[tried[j]]            = true;
+                            _out.perfect[r + tried[j]] = static_cast<std::uint32_t>(k);
+                            ++j;
+                        }
+                    }
+                }
+            }
+
+            if (!placed)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+NS_END  // internal
+
+
+// make_static_registry
+//   function: builds a static_registry from a constexpr row array and an
+// alias array. Duplicate keys/aliases and aliases of unknown keys are
+// compile-time errors. `_flags` may add D_REGISTRY_FLAG_CASE_INSENSITIVE.
+template<typename _Row, std::size_t _N, std::size_t _A>
+constexpr static_registry<_Row, _N, _A>
+make_static_registry
+(
+    const _Row            (&_rows)[_N],
+    const registry_alias  (&_aliases)[_A],
+    std::uint8_t           _flags        = D_REGISTRY_FLAG_NONE,
+    bool                   _perfect_hash = true
+)
+{
+    static_registry<_Row, _N, _A> out {};
+    const bool nocase = ((_flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) != 0);
+
+    out.flags = static_cast<std::uint8_t>(_flags | D_REGISTRY_FLAG_KEY_PREFIX);
+
+    for (std::size_t i = 0; i < _N; ++i)
+    {
+        out.rows[i]             = _rows[i];
+        out.lookup[i].key       = _rows[i].key;
+        out.lookup[i].row_index = i;
+    }
+
+    for (std::size_t i = 0; i < _A; ++i)
+    {
+        std::size_t row = _N;
+
+        for (std::size_t j = 0; j < _N; ++j)
+        {
+            if (internal::registry_ct_keycmp(_rows[j].key, _aliases[i].key, nocase) == 0)
+            {
+                row = j;
+                break;
+            }
+        }
+
+        if (row == _N)
+        {
+            internal::registry_ct_error("alias refers to an unknown key");
+        }
+
+        out.lookup[_N + i].key       = _aliases[i].alias;
+        out.lookup[_N + i].row_index = row;
+    }
+
+    internal::registry_ct_sort(out.lookup, nocase);
+
+    for (std::size_t i = 0; i < out.entries; ++i)
+    {
+        out.lookup[i].prefix = internal::registry_ct_key_prefix(out.lookup[i].key, nocase);
+    }
+
+    for (std::size_t i = 1; i < out.entries; ++i)
+    {
+        if (internal::registry_ct_keycmp(out.lookup[i - 1].key,
+                                         out.lookup[i].key,
+                                         nocase) == 0)
+        {
+            internal::registry_ct_error("duplicate registry key or alias");
+        }
+    }
+
+    out.has_perfect = _perfect_hash &&
+                      internal::registry_ct_build_perfect(out, nocase);
+
+    return out;
+}
+
+// make_static_registry
+//   function: overload for tables without aliases.
+template<typename _Row, std::size_t _N>
+constexpr static_registry<_Row, _N, 0>
+make_static_registry
+(
+    const _Row   (&_rows)[_N],
+    std::uint8_t _flags        = D_REGISTRY_FLAG_NONE,
+    bool         _perfect_hash = true
+)
+{
+    static_registry<_Row, _N, 0> out {};
+    const bool nocase = ((_flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) != 0);
+
+    out.flags = static_cast<std::uint8_t>(_flags | D_REGISTRY_FLAG_KEY_PREFIX);
+
+    for (std::size_t i = 0; i < _N; ++i)
+    {
+        out.rows[i]             = _rows[i];
+        out.lookup[i].key       = _rows[i].key;
+        out.lookup[i].row_index = i;
+    }
+
+    internal::registry_ct_sort(out.lookup, nocase);
+
+    for (std::size_t i = 0; i < out.entries; ++i)
+    {
+        out.lookup[i].prefix = internal::registry_ct_key_prefix(out.lookup[i].key, nocase);
+    }
+
+    for (std::size_t i = 1; i < out.entries; ++i)
+    {
+        if (internal::registry_ct_keycmp(out.lookup[i - 1].key,
+                                         out.lookup[i].key,
+                                         nocase) == 0)
+        {
+            internal::registry_ct_error("duplicate registry key");
+        }
+    }
+
+    out.has_perfect = _perfect_hash &&
+                      internal::registry_ct_build_perfect(out, nocase);
+
+    return out;
+}
+
+
+NS_END  // container
+NS_END  // djinterp
+
+
+#endif  // D_ENV_LANG_IS_CPP14_OR_HIGHER
+
+
+#endif  // DJINTERP_STATIC_REGISTRY_
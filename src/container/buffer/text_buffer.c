@@ -1,5 +1,453 @@
 #include "../../../inc/container/buffer/text_buffer.h"
 
+// ----------------------------------------------------------------------------
+// Internal helpers
+// ----------------------------------------------------------------------------
+
+// D_INTERNAL_TEXT_BUFFER_LAZY
+//   macro: true if a buffer's edits go through its rope or its gap rather
+// than straight into contiguous `data`.
+#define D_INTERNAL_TEXT_BUFFER_LAZY(buffer)  \
+    ( ((buffer)->rope != NULL) || ((buffer)->gap_mode) )
+
+/*
+d_internal_text_buffer_segments
+  Describes a buffer's text (the primary store, then any overflow chunks)
+as segments for the d_text_searcher segment functions.
+
+Parameter(s):
+  _buffer: the text buffer; must not be NULL.
+  _local:  storage for the single segment of a buffer without chunks.
+  _count:  receives the number of segments.
+Return:
+  `_local` if the buffer has no chunks, otherwise a heap array the caller
+frees; NULL if that allocation failed.
+*/
+static struct d_text_segment*
+d_internal_text_buffer_segments
+(
+    const struct d_text_buffer* _buffer,
+    struct d_text_segment*      _local,
+    size_t*                     _count
+)
+{
+    struct d_text_segment* segments;
+    struct d_buffer_chunk* cur;
+    size_t                 i;
+
+    _local->data   = _buffer->data;
+    _local->length = _buffer->count;
+    *_count        = 1;
+
+    if (_buffer->chunks.chunk_count == 0)
+    {
+        return _local;
+    }
+
+    segments = malloc((_buffer->chunks.chunk_count + 1) * sizeof(*segments));
+
+    if (!segments)
+    {
+        return NULL;
+    }
+
+    segments[0] = *_local;
+    i           = 1;
+
+    for (cur = _buffer->chunks.head; cur; cur = cur->next)
+    {
+        segments[i].data   = (const char*)cur->elements;
+        segments[i].length = cur->count;
+        ++i;
+    }
+
+    *_count = i;
+
+    return segments;
+}
+
+// d_internal_text_buffer_each_match
+//   fn_text_matcher_match that tallies matches per pattern; the context is
+// an array of one counter per pattern.
+static bool
+d_internal_text_buffer_each_match
+(
+    size_t _position,
+    size_t _pattern,
+    void*  _context
+)
+{
+    size_t* counts = (size_t*)_context;
+
+    (void)_position;
+
+    ++counts[_pattern];
+
+    return true;
+}
+
+/*
+d_internal_text_buffer_flatten
+  Brings `data` up to date with a rope- or gap-mode buffer edited since the
+last flatten: the rope is copied out, or the gap is closed by moving the
+text after it down. Every reader that needs the contiguous text calls
+this, which is why those readers take a non-const buffer. Rope and gap
+edits keep `capacity` above `count`, so flattening never allocates and
+cannot fail.
+
+Parameter(s):
+  _buffer: the text buffer; may be NULL.
+Return:
+  none.
+*/
+static void
+d_internal_text_buffer_flatten
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if ( (!_buffer) ||
+         (!_buffer->flat_stale) )
+    {
+        return;
+    }
+
+    if (_buffer->rope)
+    {
+        d_text_rope_copy(_buffer->rope, 0, _buffer->count, _buffer->data);
+    }
+    else
+    {
+        memmove(_buffer->data + _buffer->gap_start,
+                _buffer->data + _buffer->gap_end,
+                _buffer->count - _buffer->gap_start);
+
+        _buffer->gap_start = _buffer->count;
+        _buffer->gap_end   = _buffer->count;
+    }
+
+    _buffer->data[_buffer->count] = '\0';
+    _buffer->flat_stale           = false;
+
+    return;
+}
+
+/*
+d_internal_text_buffer_unhash
+  Drops the incremental hash state of a buffer whose text is about to
+change other than at the end, so that the next d_text_buffer_hash starts
+over from the first byte.
+
+Parameter(s):
+  _buffer: the text buffer; may be NULL.
+Return:
+  none.
+*/
+static void
+d_internal_text_buffer_unhash
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if ( (!_buffer) ||
+         (!_buffer->hash) )
+    {
+        return;
+    }
+
+    d_text_hash_init(_buffer->hash, 0);
+
+    _buffer->hash_count = 0;
+
+    return;
+}
+
+/*
+d_internal_text_buffer_detach_tail
+  Prepares a buffer for a mutation that writes `data` directly but leaves
+the existing text in place (appends, consolidate): the buffer is
+flattened and, in rope mode, the rope is marked for a rebuild before the
+next rope edit. The incremental hash, if any, stays valid.
+
+Parameter(s):
+  _buffer: the text buffer; may be NULL.
+Return:
+  none.
+*/
+static void
+d_internal_text_buffer_detach_tail
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if (!_buffer)
+    {
+        return;
+    }
+
+    d_internal_text_buffer_flatten(_buffer);
+
+    if (_buffer->rope)
+    {
+        _buffer->rope_stale = true;
+    }
+
+    return;
+}
+
+/*
+d_internal_text_buffer_detach
+  Prepares a buffer for a mutation that rewrites `data` directly: as
+d_internal_text_buffer_detach_tail, and the incremental hash is dropped.
+
+Parameter(s):
+  _buffer: the text buffer; may be NULL.
+Return:
+  none.
+*/
+static void
+d_internal_text_buffer_detach
+(
+    struct d_text_buffer* _buffer
+)
+{
+    d_internal_text_buffer_detach_tail(_buffer);
+    d_internal_text_buffer_unhash(_buffer);
+
+    return;
+}
+
+/*
+d_internal_text_buffer_rope_ready
+  Makes a rope-mode buffer's rope current, rebuilding it from `data` if
+`data` was changed outside the rope. The rope mirrors only the primary
+store; overflow chunks stay where they are, as in resize and gap mode.
+
+Parameter(s):
+  _buffer: a rope-mode text buffer.
+Return:
+  A boolean value indicating success.
+*/
+static bool
+d_internal_text_buffer_rope_ready
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if (!_buffer->rope_stale)
+    {
+        return D_SUCCESS;
+    }
+
+    if (!d_text_rope_assign(_buffer->rope, _buffer->data, _buffer->count))
+    {
+        return D_FAILURE;
+    }
+
+    _buffer->rope_stale = false;
+
+    return D_SUCCESS;
+}
+
+/*
+d_internal_text_buffer_gap_index
+  Maps a text position of a gap-mode buffer with an open gap to its offset
+in `data`.
+
+Parameter(s):
+  _buffer:   a gap-mode text buffer whose gap is open.
+  _position: a position in the text.
+Return:
+  The offset of that byte in `data`.
+*/
+D_INLINE size_t
+d_internal_text_buffer_gap_index
+(
+    const struct d_text_buffer* _buffer,
+    size_t                      _position
+)
+{
+    return (_position < _buffer->gap_start)
+        ? _position
+        : (_position + _buffer->gap_end - _buffer->gap_start);
+}
+
+/*
+d_internal_text_buffer_gap_move
+  Moves a gap-mode buffer's gap to `_position`, first widening it to at
+least `_length` bytes. Only the bytes between the old and new gap position
+are moved. Widening grows `data` by the buffer's doubling policy and then
+moves the text after the gap to the end, so it is amortized over the
+inserts the new space absorbs.
+
+Parameter(s):
+  _buffer:   a gap-mode text buffer.
+  _position: where the gap should start; at most the buffer's length.
+  _length:   minimum gap size required.
+Return:
+  A boolean value indicating success; the text is unchanged on failure.
+*/
+static bool
+d_internal_text_buffer_gap_move
+(
+    struct d_text_buffer* _buffer,
+    size_t                _position,
+    size_t                _length
+)
+{
+    size_t tail;
+    size_t shift;
+
+    // a closed gap sits, empty, at the end of the text
+    if (!_buffer->flat_stale)
+    {
+        _buffer->gap_start = _buffer->count;
+        _buffer->gap_end   = _buffer->count;
+    }
+
+    if (_buffer->gap_end - _buffer->gap_start < _length)
+    {
+        if (!d_text_buffer_ensure_capacity(_buffer,
+                                           _buffer->count + _length + 1))
+        {
+            return D_FAILURE;
+        }
+
+        // all free space except the terminator's byte becomes gap
+        tail = _buffer->count - _buffer->gap_start;
+
+        memmove(_buffer->data + _buffer->capacity - 1 - tail,
+                _buffer->data + _buffer->gap_end,
+                tail);
+
+        _buffer->gap_end = _buffer->capacity - 1 - tail;
+    }
+
+    if (_position < _buffer->gap_start)
+    {
+        shift = _buffer->gap_start - _position;
+
+        memmove(_buffer->data + _buffer->gap_end - shift,
+                _buffer->data + _position,
+                shift);
+
+        _buffer->gap_start -= shift;
+        _buffer->gap_end   -= shift;
+    }
+    else if (_position > _buffer->gap_start)
+    {
+        shift = _position - _buffer->gap_start;
+
+        memmove(_buffer->data + _buffer->gap_start,
+                _buffer->data + _buffer->gap_end,
+                shift);
+
+        _buffer->gap_start += shift;
+        _buffer->gap_end   += shift;
+    }
+
+    _buffer->flat_stale = true;
+
+    return D_SUCCESS;
+}
+
+/*
+d_internal_text_buffer_lazy_insert
+  Inserts text into a rope- or gap-mode buffer. In rope mode `data` is
+grown alongside the rope so that a later flatten has room, but is not
+written; in gap mode the text is copied into the gap.
+
+Parameter(s):
+  _buffer:   a rope- or gap-mode text buffer.
+  _position: insertion point; at most the buffer's length.
+  _text:     the bytes to insert.
+  _length:   number of bytes.
+Return:
+  A boolean value indicating success.
+*/
+static bool
+d_internal_text_buffer_lazy_insert
+(
+    struct d_text_buffer* _buffer,
+    size_t                _position,
+    const char*           _text,
+    size_t                _length
+)
+{
+    if (!_buffer->rope)
+    {
+        if (!d_internal_text_buffer_gap_move(_buffer, _position, _length))
+        {
+            return D_FAILURE;
+        }
+
+        d_memcpy(_buffer->data + _buffer->gap_start, _text, _length);
+
+        _buffer->gap_start += _length;
+        _buffer->count     += _length;
+
+        return D_SUCCESS;
+    }
+
+    if ( (!d_internal_text_buffer_rope_ready(_buffer)) ||
+         (!d_text_buffer_ensure_capacity(_buffer,
+                                         _buffer->count + _length + 1)) ||
+         (!d_text_rope_insert(_buffer->rope, _position, _text, _length)) )
+    {
+        return D_FAILURE;
+    }
+
+    _buffer->count     += _length;
+    _buffer->flat_stale = true;
+
+    return D_SUCCESS;
+}
+
+/*
+d_internal_text_buffer_lazy_remove
+  Removes a range from a rope- or gap-mode buffer. In gap mode the gap is
+moved to the range, which it then absorbs.
+
+Parameter(s):
+  _buffer: a rope- or gap-mode text buffer.
+  _start:  first byte to remove.
+  _length: bytes to remove; the range must lie within the buffer.
+Return:
+  A boolean value indicating success.
+*/
+static bool
+d_internal_text_buffer_lazy_remove
+(
+    struct d_text_buffer* _buffer,
+    size_t                _start,
+    size_t                _length
+)
+{
+    if (!_buffer->rope)
+    {
+        if (!d_internal_text_buffer_gap_move(_buffer, _start, 0))
+        {
+            return D_FAILURE;
+        }
+
+        _buffer->gap_end += _length;
+        _buffer->count   -= _length;
+
+        return D_SUCCESS;
+    }
+
+    if ( (!d_internal_text_buffer_rope_ready(_buffer)) ||
+         (!d_text_rope_remove(_buffer->rope, _start, _length)) )
+    {
+        return D_FAILURE;
+    }
+
+    _buffer->count     -= _length;
+    _buffer->flat_stale = true;
+
+    return D_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 // Creation
 // ----------------------------------------------------------------------------
@@ -28,8 +476,16 @@ d_text_buffer_new
         return NULL;
     }
 
-    buffer->count    = 0;
-    buffer->capacity = _initial_capacity;
+    buffer->count      = 0;
+    buffer->capacity   = _initial_capacity;
+    buffer->rope       = NULL;
+    buffer->flat_stale = false;
+    buffer->rope_stale = false;
+    buffer->gap_mode   = false;
+    buffer->gap_start  = 0;
+    buffer->gap_end    = 0;
+    buffer->hash       = NULL;
+    buffer->hash_count = 0;
 
     d_buffer_common_chunk_list_init(&buffer->chunks);
 
@@ -116,7 +572,7 @@ Return:
 struct d_text_buffer*
 d_text_buffer_new_from_string_n
 (
-    const char* _string
+    const char* _string,
     size_t      _length
 )
 {
@@ -142,7 +598,7 @@ Return:
 struct d_text_buffer*
 d_text_buffer_new_from_strings
 (
-    size_t _count
+    size_t _count,
     ...
 )
 {
@@ -209,7 +665,7 @@ Return:
 struct d_text_buffer*
 d_text_buffer_new_from_buffer
 (
-    const char* _buffer
+    const char* _buffer,
     size_t      _length
 )
 {
@@ -245,11 +701,13 @@ Return:
 struct d_text_buffer*
 d_text_buffer_new_copy
 (
-    const struct d_text_buffer* _other
+    struct d_text_buffer* _other
 )
 {
     struct d_text_buffer* buffer;
 
+    d_internal_text_buffer_flatten(_other);
+
     if (!_other)
     {
         return NULL;
@@ -286,9 +744,9 @@ Return:
 struct d_text_buffer*
 d_text_buffer_new_copy_range
 (
-    const struct d_text_buffer* _other
-    d_index                     _start
-    d_index                     _end
+    struct d_text_buffer* _other,
+    d_index               _start,
+    d_index               _end
 )
 {
     struct d_text_buffer* buffer;
@@ -296,6 +754,8 @@ d_text_buffer_new_copy_range
     size_t                end_pos;
     size_t                range_length;
 
+    d_internal_text_buffer_flatten(_other);
+
     if ( (!_other) ||
          (!_other->data) )
     {
@@ -335,7 +795,7 @@ Return:
 struct d_text_buffer*
 d_text_buffer_new_fill
 (
-    size_t _length
+    size_t _length,
     char   _fill_char
 )
 {
@@ -371,7 +831,7 @@ Return:
 struct d_text_buffer*
 d_text_buffer_new_formatted
 (
-    const char* _format
+    const char* _format,
     ...
 )
 {
@@ -426,8 +886,8 @@ Return:
 bool
 d_text_buffer_ensure_capacity
 (
-    struct d_text _buffer* _buffer
-    size_t        _required_capacity
+    struct d_text_buffer* _buffer,
+    size_t                _required_capacity
 )
 {
     char*  new_data;
@@ -478,12 +938,14 @@ Return:
 bool
 d_text_buffer_resize_to_fit
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     char*  new_data;
     size_t new_capacity;
 
+    d_internal_text_buffer_flatten(_buffer);
+
     if (!_buffer)
     {
         return D_FAILURE;
@@ -530,8 +992,8 @@ Return:
 bool
 d_text_buffer_reserve
 (
-    struct d_text _buffer* _buffer
-    size_t        _additional_capacity
+    struct d_text_buffer* _buffer,
+    size_t                _additional_capacity
 )
 {
     if (!_buffer)
@@ -565,8 +1027,8 @@ Return:
 bool
 d_text_buffer_append_string
 (
-    struct d_text _buffer* _buffer
-    const char*   _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
     size_t len;
@@ -583,6 +1045,14 @@ d_text_buffer_append_string
         return D_SUCCESS;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  _buffer->count,
+                                                  _string,
+                                                  len);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + len + 1))
     {
         return D_FAILURE;
@@ -608,9 +1078,9 @@ Return:
 bool
 d_text_buffer_append_string_n
 (
-    struct d_text _buffer* _buffer
-    const char*   _string
-    size_t        _length
+    struct d_text_buffer* _buffer,
+    const char*           _string,
+    size_t                _length
 )
 {
     if ( (!_buffer) ||
@@ -620,6 +1090,14 @@ d_text_buffer_append_string_n
         return D_FAILURE;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  _buffer->count,
+                                                  _string,
+                                                  _length);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + _length + 1))
     {
         return D_FAILURE;
@@ -645,9 +1123,9 @@ Return:
 bool
 d_text_buffer_append_buffer
 (
-    struct d_text _buffer* _buffer
-    const char*   _data
-    size_t        _length
+    struct d_text_buffer* _buffer,
+    const char*           _data,
+    size_t                _length
 )
 {
     if ( (!_buffer) ||
@@ -657,6 +1135,14 @@ d_text_buffer_append_buffer
         return D_FAILURE;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  _buffer->count,
+                                                  _data,
+                                                  _length);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + _length + 1))
     {
         return D_FAILURE;
@@ -681,8 +1167,8 @@ Return:
 bool
 d_text_buffer_append_char
 (
-    struct d_text _buffer* _buffer
-    char          _character
+    struct d_text_buffer* _buffer,
+    char                  _character
 )
 {
     if (!_buffer)
@@ -690,6 +1176,14 @@ d_text_buffer_append_char
         return D_FAILURE;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  _buffer->count,
+                                                  &_character,
+                                                  1);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + 2))
     {
         return D_FAILURE;
@@ -714,23 +1208,47 @@ Return:
 bool
 d_text_buffer_append_chars
 (
-    struct d_text _buffer* _buffer
-    char          _character
-    size_t        _count
+    struct d_text_buffer* _buffer,
+    char                  _character,
+    size_t                _count
 )
 {
+    char   fill[64];
+    size_t piece;
+
     if ( (!_buffer) ||
          (_count == 0) )
     {
         return D_FAILURE;
     }
 
-    if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + _count + 1))
+    // rope / gap mode: insert the run a block at a time
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
     {
-        return D_FAILURE;
-    }
+        d_memset(fill, _character, sizeof(fill));
 
-    d_memset(_buffer->data + _buffer->count, _character, _count);
+        for (; _count > 0; _count -= piece)
+        {
+            piece = (_count < sizeof(fill)) ? _count : sizeof(fill);
+
+            if (!d_internal_text_buffer_lazy_insert(_buffer,
+                                                    _buffer->count,
+                                                    fill,
+                                                    piece))
+            {
+                return D_FAILURE;
+            }
+        }
+
+        return D_SUCCESS;
+    }
+
+    if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + _count + 1))
+    {
+        return D_FAILURE;
+    }
+
+    d_memset(_buffer->data + _buffer->count, _character, _count);
     _buffer->count += _count;
     _buffer->data[_buffer->count] = '\0';
     return D_SUCCESS;
@@ -750,8 +1268,8 @@ Return:
 bool
 d_text_buffer_append_formatted
 (
-    struct d_text _buffer* _buffer
-    const char*   _format
+    struct d_text_buffer* _buffer,
+    const char*           _format,
     ...
 )
 {
@@ -759,6 +1277,8 @@ d_text_buffer_append_formatted
     va_list args_copy;
     int     required_size;
 
+    d_internal_text_buffer_detach_tail(_buffer);
+
     if ( (!_buffer) ||
          (!_format) )
     {
@@ -804,10 +1324,12 @@ Return:
 bool
 d_text_buffer_append_buffer_obj
 (
-    struct d_text_buffer*       _destination
-    const struct d_text_buffer* _source
+    struct d_text_buffer* _destination,
+    struct d_text_buffer* _source
 )
 {
+    d_internal_text_buffer_flatten(_source);
+
     if ( (!_destination) ||
          (!_source) ||
          (!_source->data) )
@@ -833,12 +1355,14 @@ Return:
 bool
 d_text_buffer_prepend_string
 (
-    struct d_text _buffer* _buffer
-    const char*   _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
     size_t len;
 
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_string) )
     {
@@ -851,6 +1375,14 @@ d_text_buffer_prepend_string
         return D_SUCCESS;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  0,
+                                                  _string,
+                                                  len);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + len + 1))
     {
         return D_FAILURE;
@@ -881,11 +1413,13 @@ Return:
 bool
 d_text_buffer_prepend_buffer
 (
-    struct d_text _buffer* _buffer
-    const char*   _data
-    size_t        _length
+    struct d_text_buffer* _buffer,
+    const char*           _data,
+    size_t                _length
 )
 {
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_data) ||
          (_length == 0) )
@@ -893,6 +1427,14 @@ d_text_buffer_prepend_buffer
         return D_FAILURE;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  0,
+                                                  _data,
+                                                  _length);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + _length + 1))
     {
         return D_FAILURE;
@@ -922,15 +1464,25 @@ Return:
 bool
 d_text_buffer_prepend_char
 (
-    struct d_text _buffer* _buffer
-    char          _character
+    struct d_text_buffer* _buffer,
+    char                  _character
 )
 {
+    d_internal_text_buffer_unhash(_buffer);
+
     if (!_buffer)
     {
         return D_FAILURE;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  0,
+                                                  &_character,
+                                                  1);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + 2))
     {
         return D_FAILURE;
@@ -961,14 +1513,16 @@ Return:
 bool
 d_text_buffer_insert_string
 (
-    struct d_text _buffer* _buffer
-    d             _index _index
-    const char*   _string
+    struct d_text_buffer* _buffer,
+    d_index               _index,
+    const char*           _string
 )
 {
     size_t insert_pos;
     size_t len;
 
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_string) )
     {
@@ -987,6 +1541,14 @@ d_text_buffer_insert_string
         return D_SUCCESS;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  insert_pos,
+                                                  _string,
+                                                  len);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + len + 1))
     {
         return D_FAILURE;
@@ -1020,14 +1582,16 @@ Return:
 bool
 d_text_buffer_insert_buffer
 (
-    struct d_text _buffer* _buffer
-    d             _index _index
-    const char*   _data
-    size_t        _length
+    struct d_text_buffer* _buffer,
+    d_index               _index,
+    const char*           _data,
+    size_t                _length
 )
 {
     size_t insert_pos;
 
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_data) ||
          (_length == 0) )
@@ -1041,6 +1605,14 @@ d_text_buffer_insert_buffer
         return D_FAILURE;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  insert_pos,
+                                                  _data,
+                                                  _length);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + _length + 1))
     {
         return D_FAILURE;
@@ -1073,13 +1645,15 @@ Return:
 bool
 d_text_buffer_insert_char
 (
-    struct d_text _buffer* _buffer
-    d             _index _index
-    char          _character
+    struct d_text_buffer* _buffer,
+    d_index               _index,
+    char                  _character
 )
 {
     size_t insert_pos;
 
+    d_internal_text_buffer_unhash(_buffer);
+
     if (!_buffer)
     {
         return D_FAILURE;
@@ -1091,6 +1665,14 @@ d_text_buffer_insert_char
         return D_FAILURE;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_insert(_buffer,
+                                                  insert_pos,
+                                                  &_character,
+                                                  1);
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, _buffer->count + 2))
     {
         return D_FAILURE;
@@ -1127,13 +1709,15 @@ Return:
 bool
 d_text_buffer_append_string_chunked
 (
-    struct d_text _buffer* _buffer
-    const char*   _string
-    size_t        _chunk_capacity
+    struct d_text_buffer* _buffer,
+    const char*           _string,
+    size_t                _chunk_capacity
 )
 {
     size_t len;
 
+    d_internal_text_buffer_detach_tail(_buffer);
+
     if ( (!_buffer) ||
          (!_string) )
     {
@@ -1168,12 +1752,14 @@ Return:
 bool
 d_text_buffer_append_buffer_chunked
 (
-    struct d_text _buffer* _buffer
-    const char*   _data
-    size_t        _length
-    size_t        _chunk_capacity
+    struct d_text_buffer* _buffer,
+    const char*           _data,
+    size_t                _length,
+    size_t                _chunk_capacity
 )
 {
+    d_internal_text_buffer_detach_tail(_buffer);
+
     if ( (!_buffer) ||
          (!_data) ||
          (_length == 0) )
@@ -1202,11 +1788,13 @@ Return:
 bool
 d_text_buffer_append_char_chunked
 (
-    struct d_text _buffer* _buffer
-    char          _character
-    size_t        _chunk_capacity
+    struct d_text_buffer* _buffer,
+    char                  _character,
+    size_t                _chunk_capacity
 )
 {
+    d_internal_text_buffer_detach_tail(_buffer);
+
     if (!_buffer)
     {
         return D_FAILURE;
@@ -1233,9 +1821,9 @@ Return:
 bool
 d_text_buffer_append_formatted_chunked
 (
-    struct d_text _buffer* _buffer
-    size_t        _chunk_capacity
-    const char*   _format
+    struct d_text_buffer* _buffer,
+    size_t                _chunk_capacity,
+    const char*           _format,
     ...
 )
 {
@@ -1245,6 +1833,8 @@ d_text_buffer_append_formatted_chunked
     char*   tmp;
     bool    result;
 
+    d_internal_text_buffer_detach_tail(_buffer);
+
     if ( (!_buffer) ||
          (!_format) )
     {
@@ -1293,7 +1883,7 @@ Return:
 bool
 d_text_buffer_consolidate
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     size_t total;
@@ -1304,6 +1894,8 @@ d_text_buffer_consolidate
         return D_FAILURE;
     }
 
+    d_internal_text_buffer_detach_tail(_buffer);
+
     if (_buffer->chunks.chunk_count == 0)
     {
         return D_SUCCESS;
@@ -1349,7 +1941,7 @@ Return:
 size_t
 d_text_buffer_total_length
 (
-    const struct d_text _buffer* _buffer
+    const struct d_text_buffer* _buffer
 )
 {
     if (!_buffer)
@@ -1371,7 +1963,7 @@ Return:
 bool
 d_text_buffer_has_chunks
 (
-    const struct d_text _buffer* _buffer
+    const struct d_text_buffer* _buffer
 )
 {
     if (!_buffer)
@@ -1398,12 +1990,14 @@ Return:
 bool
 d_text_buffer_set_string
 (
-    struct d_text _buffer* _buffer
-    const char*   _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
     size_t len;
 
+    d_internal_text_buffer_detach(_buffer);
+
     if ( (!_buffer) ||
          (!_string) )
     {
@@ -1436,11 +2030,13 @@ Return:
 bool
 d_text_buffer_set_buffer
 (
-    struct d_text _buffer* _buffer
-    const char*   _data
-    size_t        _length
+    struct d_text_buffer* _buffer,
+    const char*           _data,
+    size_t                _length
 )
 {
+    d_internal_text_buffer_detach(_buffer);
+
     if ( (!_buffer) ||
          (!_data) ||
          (_length == 0) )
@@ -1473,8 +2069,8 @@ Return:
 bool
 d_text_buffer_set_formatted
 (
-    struct d_text _buffer* _buffer
-    const char*   _format
+    struct d_text_buffer* _buffer,
+    const char*           _format,
     ...
 )
 {
@@ -1482,6 +2078,8 @@ d_text_buffer_set_formatted
     va_list args_copy;
     int     required_size;
 
+    d_internal_text_buffer_detach(_buffer);
+
     if ( (!_buffer) ||
          (!_format) )
     {
@@ -1525,9 +2123,9 @@ Return:
 bool
 d_text_buffer_replace_char
 (
-    struct d_text _buffer* _buffer
-    char          _old_char
-    char          _new_char
+    struct d_text_buffer* _buffer,
+    char                  _old_char,
+    char                  _new_char
 )
 {
     char*       p;
@@ -1537,6 +2135,8 @@ d_text_buffer_replace_char
         return D_FAILURE;
     }
 
+    d_internal_text_buffer_detach(_buffer);
+
     // tight loop: single branch per byte
     p = _buffer->data;
     const char* end = p + _buffer->count;
@@ -1554,33 +2154,35 @@ d_text_buffer_replace_char
 
 /*
 d_text_buffer_replace_string
-  Replaces characters or substrings in a text buffer.
+  Replaces every non-overlapping occurrence of `_old_string`. Overflow
+chunks are consolidated first so matches spanning them are replaced too;
+the buffer may contain embedded NULs.
 
 Parameter(s):
   _buffer:      the text buffer to operate on; must not be NULL.
-  _old_string:  parameter.
-  _new_string:  parameter.
+  _old_string:  the substring to replace.
+  _new_string:  the replacement text.
 Return:
   A boolean value indicating success.
 */
 bool
 d_text_buffer_replace_string
 (
-    struct d_text _buffer* _buffer
-    const char*   _old_string
-    const char*   _new_string
+    struct d_text_buffer* _buffer,
+    const char*           _old_string,
+    const char*           _new_string
 )
 {
-    char*  temp;
-    char*  rp;
-    char*  wp;
-    char*  fp;
-    size_t old_len;
-    size_t new_len;
-    size_t occurrences;
-    size_t new_size;
-
-    size_t tail;
+    struct d_text_searcher searcher;
+    char*                  temp;
+    char*                  wp;
+    ssize_t                found;
+    size_t                 rp;
+    size_t                 old_len;
+    size_t                 new_len;
+    size_t                 occurrences;
+    size_t                 new_size;
+    size_t                 span;
     if ( (!_buffer) ||
          (!_old_string) ||
          (!_new_string) ||
@@ -1589,22 +2191,27 @@ d_text_buffer_replace_string
         return D_FAILURE;
     }
 
+    d_internal_text_buffer_detach(_buffer);
+
     old_len = strlen(_old_string);
     if (old_len == 0)
     {
         return D_SUCCESS;
     }
 
+    if (!d_text_buffer_consolidate(_buffer))
+    {
+        return D_FAILURE;
+    }
+
     new_len = strlen(_new_string);
 
     // count occurrences
-    occurrences = 0;
-    rp = _buffer->data;
-    while ((fp = strstr(rp, _old_string)) != NULL)
-    {
-        ++occurrences;
-        rp = fp + old_len;
-    }
+    d_text_searcher_init(&searcher, _old_string, old_len);
+
+    occurrences = d_text_searcher_count(&searcher,
+                                        _buffer->data,
+                                        _buffer->count);
 
     if (occurrences == 0)
     {
@@ -1620,21 +2227,24 @@ d_text_buffer_replace_string
         return D_FAILURE;
     }
 
-    rp = _buffer->data;
+    rp = 0;
     wp = temp;
-    while ((fp = strstr(rp, _old_string)) != NULL)
+    while ((found = d_text_searcher_find(&searcher,
+                                         _buffer->data,
+                                         _buffer->count,
+                                         rp)) >= 0)
     {
-        size_t span = (size_t)(fp - rp);
-        d_memcpy(wp, rp, span);
+        span = (size_t)found - rp;
+        d_memcpy(wp, _buffer->data + rp, span);
         wp += span;
         d_memcpy(wp, _new_string, new_len);
         wp += new_len;
-        rp = fp + old_len;
+        rp = (size_t)found + old_len;
     }
-    // copy tail (including null)
-    tail = (size_t)((_buffer->data + _buffer->count) - rp);
-    d_memcpy(wp, rp, tail);
-    wp[tail] = '\0';
+    // copy tail
+    span = _buffer->count - rp;
+    d_memcpy(wp, _buffer->data + rp, span);
+    wp[span] = '\0';
 
     if (!d_text_buffer_ensure_capacity(_buffer, new_size + 1))
     {
@@ -1648,6 +2258,339 @@ d_text_buffer_replace_string
     return D_SUCCESS;
 }
 
+// D_INTERNAL_TEXT_BUFFER_MATCH_LOG
+//   constant: matches d_text_buffer_replace_many records on the stack before
+// its match log moves to the heap.
+#define D_INTERNAL_TEXT_BUFFER_MATCH_LOG 64
+
+// d_internal_text_buffer_match
+//   struct: one match recorded by d_text_buffer_replace_many's scan.
+struct d_internal_text_buffer_match
+{
+    size_t position;
+    size_t pattern;
+};
+
+// d_internal_text_buffer_match_log
+//   struct: growable match list; starts in `local`, moves to the heap if the
+// text has more matches than that.
+struct d_internal_text_buffer_match_log
+{
+    struct d_internal_text_buffer_match  local[D_INTERNAL_TEXT_BUFFER_MATCH_LOG];
+    struct d_internal_text_buffer_match* entries;
+    size_t                               count;
+    size_t                               capacity;
+    bool                                 failed;
+};
+
+// d_internal_text_buffer_log_match
+//   fn_text_matcher_match that appends to a d_internal_text_buffer_match_log;
+// stops the scan if the log cannot grow.
+static bool
+d_internal_text_buffer_log_match
+(
+    size_t _position,
+    size_t _pattern,
+    void*  _context
+)
+{
+    struct d_internal_text_buffer_match_log* log;
+    struct d_internal_text_buffer_match*     grown;
+
+    log = (struct d_internal_text_buffer_match_log*)_context;
+
+    if (log->count == log->capacity)
+    {
+        grown = malloc(log->capacity * 2 * sizeof(*grown));
+
+        if (!grown)
+        {
+            log->failed = true;
+
+            return false;
+        }
+
+        d_memcpy(grown, log->entries, log->count * sizeof(*grown));
+
+        if (log->entries != log->local)
+        {
+            free(log->entries);
+        }
+
+        log->entries   = grown;
+        log->capacity *= 2;
+    }
+
+    log->entries[log->count].position = _position;
+    log->entries[log->count].pattern  = _pattern;
+    ++log->count;
+
+    return true;
+}
+
+/*
+d_internal_text_buffer_copy_segments
+  Copies `_length` bytes of segmented text starting at text position
+`_from`. The segment cursor only moves forward, so a sequence of ascending
+copies walks the segments once.
+
+Parameter(s):
+  _segments:    the text's segments.
+  _segment:     in/out: index of the segment holding the cursor.
+  _base:        in/out: text position of that segment's first byte.
+  _from:        text position of the first byte to copy; not before `_base`.
+  _length:      number of bytes to copy.
+  _destination: where to copy to.
+Return:
+  none.
+*/
+static void
+d_internal_text_buffer_copy_segments
+(
+    const struct d_text_segment* _segments,
+    size_t*                      _segment,
+    size_t*                      _base,
+    size_t                       _from,
+    size_t                       _length,
+    char*                        _destination
+)
+{
+    const struct d_text_segment* seg;
+    size_t                       offset;
+    size_t                       span;
+
+    while (_length > 0)
+    {
+        seg    = &_segments[*_segment];
+        offset = _from - *_base;
+
+        if (offset >= seg->length)
+        {
+            *_base += seg->length;
+            ++*_segment;
+
+            continue;
+        }
+
+        span = seg->length - offset;
+
+        if (span > _length)
+        {
+            span = _length;
+        }
+
+        d_memcpy(_destination, seg->data + offset, span);
+        _destination += span;
+        _from        += span;
+        _length      -= span;
+    }
+
+    return;
+}
+
+/*
+d_internal_text_buffer_splice_matches
+  Builds a buffer's replaced text from a match log in a single allocation
+and swaps it in, folding any overflow chunks into the primary store.
+
+Parameter(s):
+  _buffer:       the text buffer; must have data.
+  _matcher:      the matcher that produced the log.
+  _replacements: one replacement per pattern; NULL entries remove.
+  _segments:     the buffer's text as segments.
+  _log:          the matches, in ascending, non-overlapping order; not empty.
+Return:
+  A boolean value indicating success.
+*/
+static bool
+d_internal_text_buffer_splice_matches
+(
+    struct d_text_buffer*                          _buffer,
+    const struct d_text_matcher*                   _matcher,
+    const char* const*                             _replacements,
+    const struct d_text_segment*                   _segments,
+    const struct d_internal_text_buffer_match_log* _log
+)
+{
+    size_t* lengths;
+    char*   result;
+    char*   wp;
+    size_t  segment;
+    size_t  base;
+    size_t  rp;
+    size_t  total;
+    size_t  new_size;
+    size_t  i;
+    size_t  k;
+
+    lengths = malloc(_matcher->pattern_count * sizeof(*lengths));
+
+    if (!lengths)
+    {
+        return D_FAILURE;
+    }
+
+    for (k = 0; k < _matcher->pattern_count; ++k)
+    {
+        lengths[k] = (_replacements[k]) ? strlen(_replacements[k]) : 0;
+    }
+
+    // size the output exactly
+    total    = d_text_buffer_total_length(_buffer);
+    new_size = total;
+
+    for (i = 0; i < _log->count; ++i)
+    {
+        k         = _log->entries[i].pattern;
+        new_size += lengths[k];
+        new_size -= _matcher->lengths[k];
+    }
+
+    result = malloc(new_size + 1);
+
+    if (!result)
+    {
+        free(lengths);
+
+        return D_FAILURE;
+    }
+
+    // copy straight from the primary store and chunks
+    segment = 0;
+    base    = 0;
+    rp      = 0;
+    wp      = result;
+
+    for (i = 0; i < _log->count; ++i)
+    {
+        k = _log->entries[i].pattern;
+
+        d_internal_text_buffer_copy_segments(_segments,
+                                             &segment,
+                                             &base,
+                                             rp,
+                                             _log->entries[i].position - rp,
+                                             wp);
+        wp += _log->entries[i].position - rp;
+
+        if (lengths[k] != 0)
+        {
+            d_memcpy(wp, _replacements[k], lengths[k]);
+            wp += lengths[k];
+        }
+
+        rp = _log->entries[i].position + _matcher->lengths[k];
+    }
+
+    d_internal_text_buffer_copy_segments(_segments,
+                                         &segment,
+                                         &base,
+                                         rp,
+                                         total - rp,
+                                         wp);
+    result[new_size] = '\0';
+
+    free(lengths);
+
+    d_buffer_common_chunk_list_free(&_buffer->chunks);
+    free(_buffer->data);
+
+    _buffer->data     = result;
+    _buffer->count    = new_size;
+    _buffer->capacity = new_size + 1;
+
+    return D_SUCCESS;
+}
+
+/*
+d_text_buffer_replace_many
+  Replaces every occurrence of each of a matcher's patterns with that
+pattern's replacement, in one scan and one output allocation, overflow
+chunks included. Matches are leftmost-longest and non-overlapping, and
+replacement text is never rescanned. The buffer may contain embedded NULs.
+
+Parameter(s):
+  _buffer:       the text buffer to operate on; must not be NULL.
+  _matcher:      the compiled patterns; may be shared with other threads.
+  _replacements: one null-terminated replacement per pattern, indexed like
+                 the patterns; a NULL entry removes that pattern's matches.
+Return:
+  A boolean value indicating success.
+*/
+bool
+d_text_buffer_replace_many
+(
+    struct d_text_buffer*        _buffer,
+    const struct d_text_matcher* _matcher,
+    const char* const*           _replacements
+)
+{
+    struct d_internal_text_buffer_match_log log;
+    struct d_text_segment                   local;
+    struct d_text_segment*                  segments;
+    size_t                                  segment_count;
+    bool                                    success;
+
+    d_internal_text_buffer_detach(_buffer);
+
+    if ( (!_buffer) ||
+         (!_buffer->data) ||
+         (!_matcher) ||
+         (!_replacements) )
+    {
+        return D_FAILURE;
+    }
+
+    segments = d_internal_text_buffer_segments(_buffer,
+                                               &local,
+                                               &segment_count);
+
+    if (!segments)
+    {
+        return D_FAILURE;
+    }
+
+    log.entries  = log.local;
+    log.count    = 0;
+    log.capacity = D_INTERNAL_TEXT_BUFFER_MATCH_LOG;
+    log.failed   = false;
+
+    d_text_matcher_scan_segments(_matcher,
+                                 segments,
+                                 segment_count,
+                                 d_internal_text_buffer_log_match,
+                                 &log);
+
+    if (log.failed)
+    {
+        success = D_FAILURE;
+    }
+    else if (log.count == 0)
+    {
+        success = D_SUCCESS;
+    }
+    else
+    {
+        success = d_internal_text_buffer_splice_matches(_buffer,
+                                                        _matcher,
+                                                        _replacements,
+                                                        segments,
+                                                        &log);
+    }
+
+    if (log.entries != log.local)
+    {
+        free(log.entries);
+    }
+
+    if (segments != &local)
+    {
+        free(segments);
+    }
+
+    return success;
+}
+
 /*
 d_text_buffer_replace_range
   Replaces characters or substrings in a text buffer.
@@ -1663,10 +2606,10 @@ Return:
 bool
 d_text_buffer_replace_range
 (
-    struct d_text _buffer* _buffer
-    d_index       _start
-    d_index       _end
-    const char*   _replacement
+    struct d_text_buffer* _buffer,
+    d_index               _start,
+    d_index               _end,
+    const char*           _replacement
 )
 {
     size_t start_pos;
@@ -1675,6 +2618,8 @@ d_text_buffer_replace_range
     size_t rep_len;
     size_t new_size;
 
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_replacement) )
     {
@@ -1692,6 +2637,30 @@ d_text_buffer_replace_range
     rep_len  = strlen(_replacement);
     new_size = _buffer->count - range_length + rep_len;
 
+    // rope / gap mode: insert the replacement after the range, then drop
+    // the range; if the second step fails the insertion is undone
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        if (!d_internal_text_buffer_lazy_insert(_buffer,
+                                                end_pos,
+                                                _replacement,
+                                                rep_len))
+        {
+            return D_FAILURE;
+        }
+
+        if (!d_internal_text_buffer_lazy_remove(_buffer,
+                                                start_pos,
+                                                range_length))
+        {
+            d_internal_text_buffer_lazy_remove(_buffer, end_pos, rep_len);
+
+            return D_FAILURE;
+        }
+
+        return D_SUCCESS;
+    }
+
     if (!d_text_buffer_ensure_capacity(_buffer, new_size + 1))
     {
         return D_FAILURE;
@@ -1723,12 +2692,14 @@ Return:
 bool
 d_text_buffer_remove_char
 (
-    struct d_text _buffer* _buffer
-    d             _index _index
+    struct d_text_buffer* _buffer,
+    d_index               _index
 )
 {
     size_t pos;
 
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (_buffer->count == 0) )
@@ -1742,6 +2713,11 @@ d_text_buffer_remove_char
         return D_FAILURE;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_remove(_buffer, pos, 1);
+    }
+
     if (pos < _buffer->count - 1)
     {
         memmove(_buffer->data + pos,
@@ -1768,15 +2744,17 @@ Return:
 bool
 d_text_buffer_remove_range
 (
-    struct d_text _buffer* _buffer
-    d_index       _start
-    d_index       _end
+    struct d_text_buffer* _buffer,
+    d_index               _start,
+    d_index               _end
 )
 {
     size_t start_pos;
     size_t end_pos;
     size_t range_length;
 
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -1792,6 +2770,13 @@ d_text_buffer_remove_range
 
     range_length = end_pos - start_pos;
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        return d_internal_text_buffer_lazy_remove(_buffer,
+                                                  start_pos,
+                                                  range_length);
+    }
+
     if (end_pos < _buffer->count)
     {
         memmove(_buffer->data + start_pos,
@@ -1817,10 +2802,12 @@ Return:
 bool
 d_text_buffer_consume_front
 (
-    struct d_text _buffer* _buffer
-    size_t        _amount
+    struct d_text_buffer* _buffer,
+    size_t                _amount
 )
 {
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -1831,6 +2818,18 @@ d_text_buffer_consume_front
         return D_SUCCESS;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        if (_amount > _buffer->count)
+        {
+            _amount = _buffer->count;
+        }
+
+        return d_internal_text_buffer_lazy_remove(_buffer,
+                                                  0,
+                                                  _amount);
+    }
+
     if (_amount >= _buffer->count)
     {
         _buffer->count   = 0;
@@ -1859,10 +2858,12 @@ Return:
 bool
 d_text_buffer_consume_back
 (
-    struct d_text _buffer* _buffer
-    size_t        _amount
+    struct d_text_buffer* _buffer,
+    size_t                _amount
 )
 {
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -1873,6 +2874,18 @@ d_text_buffer_consume_back
         return D_SUCCESS;
     }
 
+    if (D_INTERNAL_TEXT_BUFFER_LAZY(_buffer))
+    {
+        if (_amount > _buffer->count)
+        {
+            _amount = _buffer->count;
+        }
+
+        return d_internal_text_buffer_lazy_remove(_buffer,
+                                                  _buffer->count - _amount,
+                                                  _amount);
+    }
+
     if (_amount >= _buffer->count)
     {
         _buffer->count   = 0;
@@ -1902,8 +2915,8 @@ Return:
 char
 d_text_buffer_get_char
 (
-    const struct d_text _buffer* _buffer
-    d                   _index _index
+    const struct d_text_buffer* _buffer,
+    d_index                     _index
 )
 {
     size_t pos;
@@ -1921,6 +2934,13 @@ d_text_buffer_get_char
         return '\0';
     }
 
+    if (_buffer->flat_stale)
+    {
+        return (_buffer->rope)
+            ? d_text_rope_get(_buffer->rope, pos)
+            : _buffer->data[d_internal_text_buffer_gap_index(_buffer, pos)];
+    }
+
     return _buffer->data[pos];
 }
 
@@ -1938,13 +2958,15 @@ Return:
 bool
 d_text_buffer_set_char
 (
-    struct d_text _buffer* _buffer
-    d             _index _index
-    char          _character
+    struct d_text_buffer* _buffer,
+    d_index               _index,
+    char                  _character
 )
 {
     size_t pos;
 
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (_buffer->count == 0) )
@@ -1958,7 +2980,22 @@ d_text_buffer_set_char
         return D_FAILURE;
     }
 
-    _buffer->data[pos] = _character;
+    // write whichever copies are current
+    if ( (_buffer->rope) &&
+         (!_buffer->rope_stale) )
+    {
+        d_text_rope_set(_buffer->rope, pos, _character);
+    }
+
+    if (!_buffer->flat_stale)
+    {
+        _buffer->data[pos] = _character;
+    }
+    else if (_buffer->gap_mode)
+    {
+        _buffer->data[d_internal_text_buffer_gap_index(_buffer, pos)] = _character;
+    }
+
     return D_SUCCESS;
 }
 
@@ -1974,9 +3011,11 @@ Return:
 char*
 d_text_buffer_get_string
 (
-    const struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -2000,9 +3039,9 @@ Return:
 char*
 d_text_buffer_get_range_string
 (
-    const struct d_text _buffer* _buffer
-    d_index             _start
-    d_index             _end
+    struct d_text_buffer* _buffer,
+    d_index               _start,
+    d_index               _end
 )
 {
     size_t start_pos;
@@ -2010,6 +3049,8 @@ d_text_buffer_get_range_string
     size_t range_length;
     char*  result;
 
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -2039,9 +3080,227 @@ d_text_buffer_get_range_string
 // Search operations
 // ----------------------------------------------------------------------------
 
+// d_internal_text_buffer_first_match
+//   fn_text_search_match that records the first match and stops the scan.
+static bool
+d_internal_text_buffer_first_match
+(
+    size_t _position,
+    void*  _context
+)
+{
+    *(ssize_t*)_context = (ssize_t)_position;
+
+    return false;
+}
+
+// d_internal_text_buffer_count_match
+//   fn_text_search_match that counts every match.
+static bool
+d_internal_text_buffer_count_match
+(
+    size_t _position,
+    void*  _context
+)
+{
+    (void)_position;
+
+    ++*(size_t*)_context;
+
+    return true;
+}
+
+/*
+d_internal_text_buffer_find
+  Finds the first occurrence of `_needle` at or after `_start`, across the
+primary store and any overflow chunks. All forward searches go through here.
+
+Parameter(s):
+  _buffer: the text buffer; must not be NULL and must have data.
+  _needle: the bytes to search for.
+  _length: the needle's length.
+  _start:  first position to consider.
+Return:
+  The zero-based index of the match, or -1 if not found.
+*/
+static ssize_t
+d_internal_text_buffer_find
+(
+    const struct d_text_buffer* _buffer,
+    const char*                 _needle,
+    size_t                      _length,
+    size_t                      _start
+)
+{
+    struct d_text_searcher searcher;
+    struct d_text_segment  local;
+    struct d_text_segment* segments;
+    size_t                 segment_count;
+    ssize_t                result;
+
+    d_text_searcher_init(&searcher, _needle, _length);
+
+    if (_buffer->chunks.chunk_count == 0)
+    {
+        return d_text_searcher_find(&searcher,
+                                    _buffer->data,
+                                    _buffer->count,
+                                    _start);
+    }
+
+    segments = d_internal_text_buffer_segments(_buffer,
+                                               &local,
+                                               &segment_count);
+
+    if (!segments)
+    {
+        return -1;
+    }
+
+    result = -1;
+
+    if (_length == 0)
+    {
+        result = (ssize_t)_start;
+    }
+    else
+    {
+        d_text_searcher_scan_segments(&searcher,
+                                      segments,
+                                      segment_count,
+                                      _start,
+                                      d_internal_text_buffer_first_match,
+                                      &result);
+    }
+
+    if (segments != &local)
+    {
+        free(segments);
+    }
+
+    return result;
+}
+
+/*
+d_internal_text_buffer_find_last
+  Finds the last occurrence of `_needle`, scanning backward from the end of
+the text (overflow chunks included).
+
+Parameter(s):
+  _buffer: the text buffer; must not be NULL and must have data.
+  _needle: the bytes to search for.
+  _length: the needle's length.
+Return:
+  The zero-based index of the match, or -1 if not found.
+*/
+static ssize_t
+d_internal_text_buffer_find_last
+(
+    const struct d_text_buffer* _buffer,
+    const char*                 _needle,
+    size_t                      _length
+)
+{
+    struct d_text_searcher searcher;
+    struct d_text_segment  local;
+    struct d_text_segment* segments;
+    size_t                 segment_count;
+    ssize_t                result;
+
+    d_text_searcher_init(&searcher, _needle, _length);
+
+    if (_buffer->chunks.chunk_count == 0)
+    {
+        return d_text_searcher_find_last(&searcher,
+                                         _buffer->data,
+                                         _buffer->count);
+    }
+
+    segments = d_internal_text_buffer_segments(_buffer,
+                                               &local,
+                                               &segment_count);
+
+    if (!segments)
+    {
+        return -1;
+    }
+
+    result = d_text_searcher_find_last_segments(&searcher,
+                                                segments,
+                                                segment_count);
+
+    if (segments != &local)
+    {
+        free(segments);
+    }
+
+    return result;
+}
+
+/*
+d_internal_text_buffer_count
+  Counts non-overlapping occurrences of `_needle` across the primary store
+and any overflow chunks.
+
+Parameter(s):
+  _buffer: the text buffer; must not be NULL and must have data.
+  _needle: the bytes to search for.
+  _length: the needle's length.
+Return:
+  The number of matches; 0 for an empty needle.
+*/
+static size_t
+d_internal_text_buffer_count
+(
+    const struct d_text_buffer* _buffer,
+    const char*                 _needle,
+    size_t                      _length
+)
+{
+    struct d_text_searcher searcher;
+    struct d_text_segment  local;
+    struct d_text_segment* segments;
+    size_t                 segment_count;
+    size_t                 count;
+
+    d_text_searcher_init(&searcher, _needle, _length);
+
+    if (_buffer->chunks.chunk_count == 0)
+    {
+        return d_text_searcher_count(&searcher,
+                                     _buffer->data,
+                                     _buffer->count);
+    }
+
+    segments = d_internal_text_buffer_segments(_buffer,
+                                               &local,
+                                               &segment_count);
+
+    if (!segments)
+    {
+        return 0;
+    }
+
+    count = 0;
+
+    d_text_searcher_scan_segments(&searcher,
+                                  segments,
+                                  segment_count,
+                                  0,
+                                  d_internal_text_buffer_count_match,
+                                  &count);
+
+    if (segments != &local)
+    {
+        free(segments);
+    }
+
+    return count;
+}
+
 /*
 d_text_buffer_find_char
-  Finds a character or substring in a text buffer.
+  Finds a character in a text buffer, overflow chunks included.
 
 Parameter(s):
   _buffer:     the text buffer to operate on; must not be NULL.
@@ -2052,31 +3311,24 @@ Return:
 ssize_t
 d_text_buffer_find_char
 (
-    const struct d_text _buffer* _buffer
-    char                _character
+    struct d_text_buffer* _buffer,
+    char                  _character
 )
 {
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
         return -1;
     }
 
-    // use memchr for speed
-    const char* p = (const char*)memchr(
-        _buffer->data,
-        (unsigned char)_character,
-        _buffer->count);
-    if (!p)
-    {
-        return -1;
-    }
-    return (ssize_t)(p - _buffer->data);
+    return d_internal_text_buffer_find(_buffer, &_character, 1, 0);
 }
 
 /*
 d_text_buffer_find_char_from
-  Finds a character or substring in a text buffer.
+  Finds a character in a text buffer, starting at `_start`.
 
 Parameter(s):
   _buffer:     the text buffer to operate on; must not be NULL.
@@ -2088,38 +3340,37 @@ Return:
 ssize_t
 d_text_buffer_find_char_from
 (
-    const struct d_text _buffer* _buffer
-    char                _character
-    d_index             _start
+    struct d_text_buffer* _buffer,
+    char                  _character,
+    d_index               _start
 )
 {
+    size_t total;
     size_t start_pos;
 
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
         return -1;
     }
 
-    start_pos = D_NEG_IDX(_start, _buffer->count);
-    if (start_pos >= _buffer->count)
-    {
-        return -1;
-    }
+    total     = d_text_buffer_total_length(_buffer);
+    start_pos = D_NEG_IDX(_start, total);
 
-    const char* p = (const char*)memchr(_buffer->data + start_pos,
-                                        (unsigned char)_character,
-                                        _buffer->count - start_pos);
-    if (!p)
+    if (start_pos >= total)
     {
         return -1;
     }
-    return (ssize_t)(p - _buffer->data);
+
+    return d_internal_text_buffer_find(_buffer, &_character, 1, start_pos);
 }
 
 /*
 d_text_buffer_find_string
-  Finds a character or substring in a text buffer.
+  Finds a substring in a text buffer. The buffer may contain embedded NULs;
+matches may span overflow chunks.
 
 Parameter(s):
   _buffer:  the text buffer to operate on; must not be NULL.
@@ -2130,11 +3381,11 @@ Return:
 ssize_t
 d_text_buffer_find_string
 (
-    const struct d_text _buffer* _buffer
-    const char*         _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
-    char* fp;
+    d_internal_text_buffer_flatten(_buffer);
 
     if ( (!_buffer) ||
          (!_buffer->data) ||
@@ -2143,17 +3394,12 @@ d_text_buffer_find_string
         return -1;
     }
 
-    fp = strstr(_buffer->data, _string);
-    if (!fp)
-    {
-        return -1;
-    }
-    return (ssize_t)(fp - _buffer->data);
+    return d_internal_text_buffer_find(_buffer, _string, strlen(_string), 0);
 }
 
 /*
 d_text_buffer_find_string_from
-  Finds a character or substring in a text buffer.
+  Finds a substring in a text buffer, starting at `_start`.
 
 Parameter(s):
   _buffer:  the text buffer to operate on; must not be NULL.
@@ -2165,13 +3411,15 @@ Return:
 ssize_t
 d_text_buffer_find_string_from
 (
-    const struct d_text _buffer* _buffer
-    const char*         _string
-    d_index             _start
+    struct d_text_buffer* _buffer,
+    const char*           _string,
+    d_index               _start
 )
 {
+    size_t total;
     size_t start_pos;
-    char*  fp;
+
+    d_internal_text_buffer_flatten(_buffer);
 
     if ( (!_buffer) ||
          (!_buffer->data) ||
@@ -2180,23 +3428,23 @@ d_text_buffer_find_string_from
         return -1;
     }
 
-    start_pos = D_NEG_IDX(_start, _buffer->count);
-    if (start_pos >= _buffer->count)
-    {
-        return -1;
-    }
+    total     = d_text_buffer_total_length(_buffer);
+    start_pos = D_NEG_IDX(_start, total);
 
-    fp = strstr(_buffer->data + start_pos, _string);
-    if (!fp)
+    if (start_pos >= total)
     {
         return -1;
     }
-    return (ssize_t)(fp - _buffer->data);
+
+    return d_internal_text_buffer_find(_buffer,
+                                       _string,
+                                       strlen(_string),
+                                       start_pos);
 }
 
 /*
 d_text_buffer_find_last_char
-  Finds a character or substring in a text buffer.
+  Finds the last occurrence of a character in a text buffer.
 
 Parameter(s):
   _buffer:     the text buffer to operate on; must not be NULL.
@@ -2207,32 +3455,25 @@ Return:
 ssize_t
 d_text_buffer_find_last_char
 (
-    const struct d_text _buffer* _buffer
-    char                _character
+    struct d_text_buffer* _buffer,
+    char                  _character
 )
 {
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
-         (!_buffer->data) ||
-         (_buffer->count == 0) )
+         (!_buffer->data) )
     {
         return -1;
     }
 
-    // scan backwards
-    const char* p = _buffer->data + _buffer->count;
-    while (p-- > _buffer->data)
-    {
-        if (*p == _character)
-        {
-            return (ssize_t)(p - _buffer->data);
-        }
-    }
-    return -1;
+    return d_internal_text_buffer_find_last(_buffer, &_character, 1);
 }
 
 /*
 d_text_buffer_find_last_string
-  Finds a character or substring in a text buffer.
+  Finds the last occurrence of a substring, searching backward from the
+end of the text.
 
 Parameter(s):
   _buffer:  the text buffer to operate on; must not be NULL.
@@ -2243,13 +3484,11 @@ Return:
 ssize_t
 d_text_buffer_find_last_string
 (
-    const struct d_text _buffer* _buffer
-    const char*         _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
-    char*  fp;
-    char*  last_found;
-    size_t slen;
+    d_internal_text_buffer_flatten(_buffer);
 
     if ( (!_buffer) ||
          (!_buffer->data) ||
@@ -2258,25 +3497,9 @@ d_text_buffer_find_last_string
         return -1;
     }
 
-    slen = strlen(_string);
-    if (slen > _buffer->count)
-    {
-        return -1;
-    }
-
-    last_found = NULL;
-    fp = _buffer->data;
-    while ((fp = strstr(fp, _string)) != NULL)
-    {
-        last_found = fp;
-        ++fp;
-    }
-
-    if (!last_found)
-    {
-        return -1;
-    }
-    return (ssize_t)(last_found - _buffer->data);
+    return d_internal_text_buffer_find_last(_buffer,
+                                            _string,
+                                            strlen(_string));
 }
 
 /*
@@ -2292,8 +3515,8 @@ Return:
 bool
 d_text_buffer_contains_char
 (
-    const struct d_text _buffer* _buffer
-    char                _character
+    struct d_text_buffer* _buffer,
+    char                  _character
 )
 {
     return d_text_buffer_find_char(_buffer, _character) != -1;
@@ -2312,8 +3535,8 @@ Return:
 bool
 d_text_buffer_contains_string
 (
-    const struct d_text _buffer* _buffer
-    const char*         _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
     return d_text_buffer_find_string(_buffer, _string) != -1;
@@ -2332,12 +3555,14 @@ Return:
 bool
 d_text_buffer_starts_with
 (
-    const struct d_text _buffer* _buffer
-    const char*         _prefix
+    struct d_text_buffer* _buffer,
+    const char*           _prefix
 )
 {
     size_t plen;
 
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (!_prefix) )
@@ -2367,12 +3592,14 @@ Return:
 bool
 d_text_buffer_ends_with
 (
-    const struct d_text _buffer* _buffer
-    const char*         _suffix
+    struct d_text_buffer* _buffer,
+    const char*           _suffix
 )
 {
     size_t slen;
 
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (!_suffix) )
@@ -2391,7 +3618,8 @@ d_text_buffer_ends_with
 
 /*
 d_text_buffer_count_char
-  Counts occurrences of a character or substring in a text buffer.
+  Counts occurrences of a character in a text buffer, overflow chunks
+included.
 
 Parameter(s):
   _buffer:     the text buffer to operate on; may be NULL.
@@ -2402,55 +3630,41 @@ Return:
 size_t
 d_text_buffer_count_char
 (
-    const struct d_text _buffer* _buffer
-    char                _character
+    struct d_text_buffer* _buffer,
+    char                  _character
 )
 {
-    size_t      count;
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
         return 0;
     }
 
-    count = 0;
-    const char* p     = _buffer->data;
-    const char* end   = p + _buffer->count;
-
-    while (p < end)
-    {
-        p = (const char*)memchr(p, (unsigned char)_character,
-                                (size_t)(end - p));
-        if (!p)
-        {
-            break;
-        }
-        ++count;
-        ++p;
-    }
-    return count;
+    return d_internal_text_buffer_count(_buffer, &_character, 1);
 }
 
 /*
 d_text_buffer_count_string
-  Counts occurrences of a character or substring in a text buffer.
+  Counts non-overlapping occurrences of a substring in a text buffer,
+overflow chunks included.
 
 Parameter(s):
   _buffer:  the text buffer to operate on; may be NULL.
   _string:  the null-terminated string to use.
 Return:
-  A size value result.
+  A size value result; 0 for an empty string.
 */
 size_t
 d_text_buffer_count_string
 (
-    const struct d_text _buffer* _buffer
-    const char*         _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
-    size_t slen;
-    size_t count;
-    char*  p;
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (!_string) )
@@ -2458,21 +3672,180 @@ d_text_buffer_count_string
         return 0;
     }
 
-    slen = strlen(_string);
-    if ( (slen == 0) ||
-         (slen > _buffer->count) )
+    return d_internal_text_buffer_count(_buffer, _string, strlen(_string));
+}
+
+// d_internal_text_buffer_any_match
+//   fn_text_matcher_match that records the first match and stops the scan.
+static bool
+d_internal_text_buffer_any_match
+(
+    size_t _position,
+    size_t _pattern,
+    void*  _context
+)
+{
+    size_t* out = (size_t*)_context;
+
+    out[0] = _position;
+    out[1] = _pattern;
+
+    return false;
+}
+
+/*
+d_text_buffer_find_any
+  Finds the first occurrence of any of a matcher's patterns in a single
+pass, overflow chunks included. When several patterns match at the same
+position, the longest one is reported.
+
+Parameter(s):
+  _buffer:      the text buffer to operate on; may be NULL.
+  _matcher:     the compiled patterns; may be shared with other threads.
+  _out_pattern: if not NULL, receives the index of the matching pattern.
+Return:
+  The zero-based index of the match, or -1 if not found.
+*/
+ssize_t
+d_text_buffer_find_any
+(
+    struct d_text_buffer*        _buffer,
+    const struct d_text_matcher* _matcher,
+    size_t*                      _out_pattern
+)
+{
+    struct d_text_segment  local;
+    struct d_text_segment* segments;
+    size_t                 segment_count;
+    size_t                 found[2];
+
+    d_internal_text_buffer_flatten(_buffer);
+
+    if ( (!_buffer) ||
+         (!_buffer->data) ||
+         (!_matcher) )
+    {
+        return -1;
+    }
+
+    segments = d_internal_text_buffer_segments(_buffer,
+                                               &local,
+                                               &segment_count);
+
+    if (!segments)
+    {
+        return -1;
+    }
+
+    found[1] = D_TEXT_MATCHER_NONE;
+
+    d_text_matcher_scan_segments(_matcher,
+                                 segments,
+                                 segment_count,
+                                 d_internal_text_buffer_any_match,
+                                 found);
+
+    if (segments != &local)
+    {
+        free(segments);
+    }
+
+    if (found[1] == D_TEXT_MATCHER_NONE)
+    {
+        return -1;
+    }
+
+    if (_out_pattern)
+    {
+        *_out_pattern = found[1];
+    }
+
+    return (ssize_t)found[0];
+}
+
+/*
+d_text_buffer_count_each
+  Counts, in a single pass, how often each of a matcher's patterns occurs,
+overflow chunks included. Matches are leftmost-longest and non-overlapping,
+so the counts are exactly the replacements d_text_buffer_replace_many would
+make.
+
+Parameter(s):
+  _buffer:     the text buffer to operate on; may be NULL.
+  _matcher:    the compiled patterns; may be shared with other threads.
+  _out_counts: if not NULL, an array of d_text_matcher_pattern_count
+               entries that receives the per-pattern counts.
+Return:
+  The total number of matches.
+*/
+size_t
+d_text_buffer_count_each
+(
+    struct d_text_buffer*        _buffer,
+    const struct d_text_matcher* _matcher,
+    size_t*                      _out_counts
+)
+{
+    struct d_text_segment  local;
+    struct d_text_segment* segments;
+    size_t*                counts;
+    size_t                 segment_count;
+    size_t                 total;
+    size_t                 k;
+
+    d_internal_text_buffer_flatten(_buffer);
+
+    if ( (!_buffer) ||
+         (!_buffer->data) ||
+         (!_matcher) )
+    {
+        return 0;
+    }
+
+    counts = calloc(_matcher->pattern_count, sizeof(*counts));
+
+    if (!counts)
     {
         return 0;
     }
 
-    count = 0;
-    p = _buffer->data;
-    while ((p = strstr(p, _string)) != NULL)
+    segments = d_internal_text_buffer_segments(_buffer,
+                                               &local,
+                                               &segment_count);
+
+    if (!segments)
     {
-        ++count;
-        p += slen;
+        free(counts);
+
+        return 0;
     }
-    return count;
+
+    d_text_matcher_scan_segments(_matcher,
+                                 segments,
+                                 segment_count,
+                                 d_internal_text_buffer_each_match,
+                                 counts);
+
+    if (segments != &local)
+    {
+        free(segments);
+    }
+
+    total = 0;
+
+    for (k = 0; k < _matcher->pattern_count; ++k)
+    {
+        total += counts[k];
+    }
+
+    if (_out_counts)
+    {
+        d_memcpy(_out_counts, counts, _matcher->pattern_count * sizeof(*counts));
+    }
+
+    free(counts);
+
+    return total;
 }
 
 // ----------------------------------------------------------------------------
@@ -2492,10 +3865,13 @@ Return:
 int
 d_text_buffer_compare
 (
-    const struct d_text_buffer* _buffer1
-    const struct d_text_buffer* _buffer2
+    struct d_text_buffer* _buffer1,
+    struct d_text_buffer* _buffer2
 )
 {
+    d_internal_text_buffer_flatten(_buffer1);
+    d_internal_text_buffer_flatten(_buffer2);
+
     if ( (!_buffer1) &&
          (!_buffer2) )
     {
@@ -2539,10 +3915,12 @@ Return:
 int
 d_text_buffer_compare_string
 (
-    const struct d_text _buffer* _buffer
-    const char*         _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) &&
          (!_string) )
     {
@@ -2578,11 +3956,14 @@ Return:
 int
 d_text_buffer_compare_n
 (
-    const struct d_text_buffer* _buffer1
-    const struct d_text_buffer* _buffer2
-    size_t                      _n
+    struct d_text_buffer* _buffer1,
+    struct d_text_buffer* _buffer2,
+    size_t                _n
 )
 {
+    d_internal_text_buffer_flatten(_buffer1);
+    d_internal_text_buffer_flatten(_buffer2);
+
     if ( (!_buffer1) &&
          (!_buffer2) )
     {
@@ -2626,8 +4007,8 @@ Return:
 bool
 d_text_buffer_equals
 (
-    const struct d_text_buffer* _buffer1
-    const struct d_text_buffer* _buffer2
+    struct d_text_buffer* _buffer1,
+    struct d_text_buffer* _buffer2
 )
 {
     // fast path: length mismatch
@@ -2653,8 +4034,8 @@ Return:
 bool
 d_text_buffer_equals_string
 (
-    const struct d_text _buffer* _buffer
-    const char*         _string
+    struct d_text_buffer* _buffer,
+    const char*           _string
 )
 {
     return d_text_buffer_compare_string(_buffer, _string) == 0;
@@ -2676,13 +4057,15 @@ Return:
 bool
 d_text_buffer_trim_whitespace
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     size_t start;
     size_t end;
     size_t new_length;
 
+    d_internal_text_buffer_detach(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -2735,11 +4118,13 @@ Return:
 bool
 d_text_buffer_trim_front
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     size_t start;
 
+    d_internal_text_buffer_detach(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -2785,7 +4170,7 @@ Return:
 bool
 d_text_buffer_trim_back
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     size_t end;
@@ -2799,6 +4184,8 @@ d_text_buffer_trim_back
         return D_SUCCESS;
     }
 
+    d_internal_text_buffer_detach(_buffer);
+
     end = _buffer->count;
     while ( (end > 0) &&
             (isspace((unsigned char)_buffer->data[end - 1])) )
@@ -2824,14 +4211,16 @@ Return:
 bool
 d_text_buffer_trim_chars
 (
-    struct d_text _buffer* _buffer
-    const char*   _chars
+    struct d_text_buffer* _buffer,
+    const char*           _chars
 )
 {
     size_t start;
     size_t end;
     size_t new_length;
 
+    d_internal_text_buffer_detach(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (!_chars) )
@@ -2885,7 +4274,7 @@ Return:
 bool
 d_text_buffer_to_upper
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     char*       p;
@@ -2895,6 +4284,8 @@ d_text_buffer_to_upper
         return D_FAILURE;
     }
 
+    d_internal_text_buffer_detach(_buffer);
+
     p = _buffer->data;
     const char* end = p + _buffer->count;
     while (p < end)
@@ -2917,7 +4308,7 @@ Return:
 bool
 d_text_buffer_to_lower
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     char*       p;
@@ -2927,6 +4318,8 @@ d_text_buffer_to_lower
         return D_FAILURE;
     }
 
+    d_internal_text_buffer_detach(_buffer);
+
     p = _buffer->data;
     const char* end = p + _buffer->count;
     while (p < end)
@@ -2949,7 +4342,7 @@ Return:
 bool
 d_text_buffer_reverse
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     char* lo;
@@ -2964,6 +4357,8 @@ d_text_buffer_reverse
         return D_SUCCESS;
     }
 
+    d_internal_text_buffer_detach(_buffer);
+
     lo = _buffer->data;
     hi = _buffer->data + _buffer->count - 1;
     while (lo < hi)
@@ -2989,9 +4384,9 @@ Return:
 bool
 d_text_buffer_pad_left
 (
-    struct d_text _buffer* _buffer
-    size_t        _width
-    char          _pad_char
+    struct d_text_buffer* _buffer,
+    size_t                _width,
+    char                  _pad_char
 )
 {
     size_t pad;
@@ -3004,6 +4399,8 @@ d_text_buffer_pad_left
         return D_SUCCESS;
     }
 
+    d_internal_text_buffer_detach(_buffer);
+
     pad = _width - _buffer->count;
     if (!d_text_buffer_ensure_capacity(_buffer, _width + 1))
     {
@@ -3031,9 +4428,9 @@ Return:
 bool
 d_text_buffer_pad_right
 (
-    struct d_text _buffer* _buffer
-    size_t        _width
-    char          _pad_char
+    struct d_text_buffer* _buffer,
+    size_t                _width,
+    char                  _pad_char
 )
 {
     size_t pad;
@@ -3046,6 +4443,8 @@ d_text_buffer_pad_right
         return D_SUCCESS;
     }
 
+    d_internal_text_buffer_detach(_buffer);
+
     pad = _width - _buffer->count;
     if (!d_text_buffer_ensure_capacity(_buffer, _width + 1))
     {
@@ -3075,14 +4474,16 @@ Return:
 struct d_text_buffer*
 d_text_buffer_filter
 (
-    const struct d_text         _buffer* _buffer
+    struct d_text_buffer*       _buffer,
     const struct d_filter_expr* _expression
 )
 {
     void*  out_data  = NULL;
     size_t out_count = 0;
-
     struct d_text_buffer* result;
+
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (!_expression) )
@@ -3131,10 +4532,12 @@ Return:
 bool
 d_text_buffer_filter_in_place
 (
-    struct d_text               _buffer* _buffer
+    struct d_text_buffer*       _buffer,
     const struct d_filter_expr* _expression
 )
 {
+    d_internal_text_buffer_detach(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (!_expression) )
@@ -3168,12 +4571,14 @@ Return:
 bool
 d_text_buffer_filter_indices
 (
-    const struct d_text         _buffer* _buffer
-    const struct d_filter_expr* _expression
-    d_index**                   _out_indices
+    struct d_text_buffer*       _buffer,
+    const struct d_filter_expr* _expression,
+    d_index**                   _out_indices,
     size_t*                     _out_count
 )
 {
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (!_expression) )
@@ -3202,10 +4607,12 @@ Return:
 size_t
 d_text_buffer_count_matching
 (
-    const struct d_text         _buffer* _buffer
+    struct d_text_buffer*       _buffer,
     const struct d_filter_expr* _expression
 )
 {
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) ||
          (!_expression) )
@@ -3232,14 +4639,16 @@ Return:
 struct d_text_buffer*
 d_text_buffer_filter_chunked
 (
-    const struct d_text         _buffer* _buffer
+    struct d_text_buffer*       _buffer,
     const struct d_filter_expr* _expression
 )
 {
     void*  out_data  = NULL;
     size_t out_count = 0;
-
     struct d_text_buffer* result;
+
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_expression) )
     {
@@ -3290,9 +4699,26 @@ Return:
 void
 d_text_buffer_clear
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
+    if ( (_buffer) &&
+         (_buffer->rope) )
+    {
+        // any overflow chunks survive a clear, so rebuild on the next edit
+        d_text_rope_clear(_buffer->rope);
+
+        _buffer->rope_stale = true;
+    }
+
+    // an open gap or pending rope edits are discarded with the text
+    if (_buffer)
+    {
+        _buffer->flat_stale = false;
+    }
+
+    d_internal_text_buffer_unhash(_buffer);
+
     if ( (_buffer) &&
          (_buffer->data) )
     {
@@ -3315,7 +4741,7 @@ Return:
 bool
 d_text_buffer_is_empty
 (
-    const struct d_text _buffer* _buffer
+    const struct d_text_buffer* _buffer
 )
 {
     if ( (!_buffer) ||
@@ -3339,7 +4765,7 @@ Return:
 size_t
 d_text_buffer_length
 (
-    const struct d_text _buffer* _buffer
+    const struct d_text_buffer* _buffer
 )
 {
     return _buffer ? _buffer->count : 0;
@@ -3357,7 +4783,7 @@ Return:
 size_t
 d_text_buffer_capacity
 (
-    const struct d_text _buffer* _buffer
+    const struct d_text_buffer* _buffer
 )
 {
     return _buffer ? _buffer->capacity : 0;
@@ -3375,7 +4801,7 @@ Return:
 double
 d_text_buffer_utilization
 (
-    const struct d_text _buffer* _buffer
+    const struct d_text_buffer* _buffer
 )
 {
     if ( (!_buffer) ||
@@ -3386,38 +4812,186 @@ d_text_buffer_utilization
     return (double)_buffer->count / (double)_buffer->capacity;
 }
 
+/*
+d_internal_text_buffer_hash_feed
+  Feeds a buffer's text (the primary store, then any overflow chunks) into
+a hash state, skipping the `_state->total` bytes it has already seen.
+
+Parameter(s):
+  _buffer: the text buffer; must not be NULL.
+  _state:  the hash state; must not be NULL.
+Return:
+  none.
+*/
+static void
+d_internal_text_buffer_hash_feed
+(
+    const struct d_text_buffer* _buffer,
+    struct d_text_hash*         _state
+)
+{
+    struct d_buffer_chunk* cur;
+    uint64_t               skip;
+
+    skip = _state->total;
+
+    if (skip < _buffer->count)
+    {
+        d_text_hash_update(_state,
+                           _buffer->data + skip,
+                           _buffer->count - (size_t)skip);
+
+        skip = 0;
+    }
+    else
+    {
+        skip -= _buffer->count;
+    }
+
+    for (cur = _buffer->chunks.head; cur; cur = cur->next)
+    {
+        if (skip < cur->count)
+        {
+            d_text_hash_update(_state,
+                               (const char*)cur->elements + skip,
+                               cur->count - (size_t)skip);
+
+            skip = 0;
+        }
+        else
+        {
+            skip -= cur->count;
+        }
+    }
+
+    return;
+}
+
 /*
 d_text_buffer_hash
-  Computes a hash of a text buffer.
+  Computes a hash of a text buffer's text, including any overflow chunks,
+which are hashed in place rather than consolidated. The hash is XXH64 (see
+text_hash.h), which consumes 32 bytes per step.
+  With incremental hashing enabled only the text added since the previous
+call is hashed, so hashing after a run of appends costs O(appended bytes).
+The persistent state is advanced here, so the buffer is not const and
+concurrent hashes of one incremental buffer must be serialized.
 
 Parameter(s):
   _buffer:  the text buffer to operate on; may be NULL.
 Return:
-  A hash value for the buffer contents.
+  A hash value for the buffer contents, or 0 for NULL.
 */
 size_t
 d_text_buffer_hash
 (
-    const struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
-    size_t hash;
-    if ( (!_buffer) ||
-         (!_buffer->data) )
+    struct d_text_hash state;
+
+    if (!_buffer)
     {
         return 0;
     }
 
-    // FNV-1a
-    hash = 14695981039346656037ULL;
-    const unsigned char* p   = (const unsigned char*)_buffer->data;
-    const unsigned char* end = p + _buffer->count;
-    while (p < end)
+    d_internal_text_buffer_flatten(_buffer);
+
+    if (!_buffer->hash)
+    {
+        d_text_hash_init(&state, 0);
+        d_internal_text_buffer_hash_feed(_buffer, &state);
+
+        return (size_t)d_text_hash_digest(&state);
+    }
+
+    // text appended to `data` while chunks follow it lands in the middle of
+    // the text; if the state has already seen chunk bytes, start over
+    if ( (_buffer->hash->total > _buffer->hash_count) &&
+         (_buffer->count != _buffer->hash_count) )
+    {
+        d_internal_text_buffer_unhash(_buffer);
+    }
+
+    d_internal_text_buffer_hash_feed(_buffer, _buffer->hash);
+
+    _buffer->hash_count = _buffer->count;
+
+    return (size_t)d_text_hash_digest(_buffer->hash);
+}
+
+/*
+d_text_buffer_enable_incremental_hash
+  Gives a text buffer a persistent hash state so that d_text_buffer_hash
+only hashes text appended since its previous call. Appends of any kind
+(including chunked and formatted appends) keep the state; any other edit
+drops it, and the next d_text_buffer_hash rehashes the whole text. Writes
+through the pointer returned by d_text_buffer_get_string are not seen and
+must be followed by a disable/enable pair. Enabling an already incremental
+buffer does nothing.
+
+Parameter(s):
+  _buffer:  the text buffer to operate on; must not be NULL.
+Return:
+  A boolean value indicating success.
+*/
+bool
+d_text_buffer_enable_incremental_hash
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if (!_buffer)
+    {
+        return D_FAILURE;
+    }
+
+    if (_buffer->hash)
+    {
+        return D_SUCCESS;
+    }
+
+    _buffer->hash = malloc(sizeof(struct d_text_hash));
+
+    if (!_buffer->hash)
+    {
+        return D_FAILURE;
+    }
+
+    d_text_hash_init(_buffer->hash, 0);
+
+    _buffer->hash_count = 0;
+
+    return D_SUCCESS;
+}
+
+/*
+d_text_buffer_disable_incremental_hash
+  Drops a text buffer's persistent hash state; d_text_buffer_hash hashes
+the whole text on every call again.
+
+Parameter(s):
+  _buffer:  the text buffer to operate on; must not be NULL.
+Return:
+  A boolean value indicating success.
+*/
+bool
+d_text_buffer_disable_incremental_hash
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if (!_buffer)
     {
-        hash ^= (size_t)*p++;
-        hash *= 1099511628211ULL;
+        return D_FAILURE;
     }
-    return hash;
+
+    free(_buffer->hash);
+
+    _buffer->hash       = NULL;
+    _buffer->hash_count = 0;
+
+    return D_SUCCESS;
 }
 
 // ----------------------------------------------------------------------------
@@ -3436,11 +5010,13 @@ Return:
 char*
 d_text_buffer_to_cstring
 (
-    const struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     char* result;
 
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -3472,11 +5048,13 @@ Return:
 bool
 d_text_buffer_copy_to_buffer
 (
-    const struct d_text_buffer* _source
-    char*                       _destination
-    size_t                      _destination_size
+    struct d_text_buffer* _source,
+    char*                 _destination,
+    size_t                _destination_size
 )
 {
+    d_internal_text_buffer_flatten(_source);
+
     if ( (!_source) ||
          (!_source->data) ||
          (!_destination) ||
@@ -3510,14 +5088,16 @@ Return:
 size_t
 d_text_buffer_copy_to_buffer_n
 (
-    const struct d_text_buffer* _source
-    char*                       _destination
-    size_t                      _destination_size
-    size_t                      _max_chars
+    struct d_text_buffer* _source,
+    char*                 _destination,
+    size_t                _destination_size,
+    size_t                _max_chars
 )
 {
     size_t copy_count;
 
+    d_internal_text_buffer_flatten(_source);
+
     if ( (!_source) ||
          (!_source->data) ||
          (!_destination) ||
@@ -3553,9 +5133,11 @@ Return:
 struct d_string*
 d_text_buffer_to_d_string
 (
-    const struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
+    d_internal_text_buffer_flatten(_buffer);
+
     if ( (!_buffer) ||
          (!_buffer->data) )
     {
@@ -3565,6 +5147,193 @@ d_text_buffer_to_d_string
     return d_string_new_from_buffer(_buffer->data, _buffer->count);
 }
 
+// ----------------------------------------------------------------------------
+// Rope and gap modes
+// ----------------------------------------------------------------------------
+
+/*
+d_text_buffer_enable_rope
+  Switches a text buffer to rope mode, in which inserts, removes and range
+replacements take O(log n) and `data` is refreshed only when the text is
+read contiguously. The rope is built from the current text on the first
+rope edit, so enabling is O(1). Like gap mode, rope mode covers only the
+primary store: overflow chunks are left in place and every edit sees the
+same text it would in resize mode. A gap-mode buffer leaves gap mode
+first; enabling an already rope-mode buffer does nothing.
+
+Parameter(s):
+  _buffer:  the text buffer to operate on; must not be NULL.
+Return:
+  A boolean value indicating success.
+*/
+bool
+d_text_buffer_enable_rope
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if (!_buffer)
+    {
+        return D_FAILURE;
+    }
+
+    if (_buffer->rope)
+    {
+        return D_SUCCESS;
+    }
+
+    d_text_buffer_disable_gap(_buffer);
+
+    _buffer->rope = malloc(sizeof(struct d_text_rope));
+
+    if (!_buffer->rope)
+    {
+        return D_FAILURE;
+    }
+
+    d_text_rope_init(_buffer->rope);
+
+    _buffer->flat_stale = false;
+    _buffer->rope_stale = true;
+
+    return D_SUCCESS;
+}
+
+/*
+d_text_buffer_disable_rope
+  Leaves rope mode: the text is flattened into `data` and the rope freed.
+Disabling a buffer that is not in rope mode does nothing.
+
+Parameter(s):
+  _buffer:  the text buffer to operate on; must not be NULL.
+Return:
+  A boolean value indicating success.
+*/
+bool
+d_text_buffer_disable_rope
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if (!_buffer)
+    {
+        return D_FAILURE;
+    }
+
+    if (!_buffer->rope)
+    {
+        return D_SUCCESS;
+    }
+
+    d_internal_text_buffer_flatten(_buffer);
+    d_text_rope_clear(_buffer->rope);
+    free(_buffer->rope);
+
+    _buffer->rope       = NULL;
+    _buffer->flat_stale = false;
+    _buffer->rope_stale = false;
+
+    return D_SUCCESS;
+}
+
+/*
+d_text_buffer_is_rope
+  Returns whether a text buffer is in rope mode.
+
+Parameter(s):
+  _buffer:  the text buffer to operate on; may be NULL.
+Return:
+  true if the buffer is in rope mode, otherwise false.
+*/
+bool
+d_text_buffer_is_rope
+(
+    const struct d_text_buffer* _buffer
+)
+{
+    return (_buffer) && (_buffer->rope != NULL);
+}
+
+/*
+d_text_buffer_enable_gap
+  Switches a text buffer to gap mode, in which `data` keeps a movable gap
+at the last edit position. Inserts and removes cost O(edit size) plus the
+distance the gap moves, so runs of edits near one cursor are cheap; the
+gap is closed only when the text is read contiguously (get_string,
+to_cstring, searches and so on). A rope-mode buffer leaves rope mode
+first; enabling an already gap-mode buffer does nothing.
+
+Parameter(s):
+  _buffer:  the text buffer to operate on; must not be NULL.
+Return:
+  A boolean value indicating success.
+*/
+bool
+d_text_buffer_enable_gap
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if ( (!_buffer) ||
+         (!d_text_buffer_disable_rope(_buffer)) )
+    {
+        return D_FAILURE;
+    }
+
+    _buffer->gap_mode = true;
+
+    return D_SUCCESS;
+}
+
+/*
+d_text_buffer_disable_gap
+  Leaves gap mode, closing the gap. Disabling a buffer that is not in gap
+mode does nothing.
+
+Parameter(s):
+  _buffer:  the text buffer to operate on; must not be NULL.
+Return:
+  A boolean value indicating success.
+*/
+bool
+d_text_buffer_disable_gap
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if (!_buffer)
+    {
+        return D_FAILURE;
+    }
+
+    if (_buffer->gap_mode)
+    {
+        d_internal_text_buffer_flatten(_buffer);
+
+        _buffer->gap_mode = false;
+    }
+
+    return D_SUCCESS;
+}
+
+/*
+d_text_buffer_is_gap
+  Returns whether a text buffer is in gap mode.
+
+Parameter(s):
+  _buffer:  the text buffer to operate on; may be NULL.
+Return:
+  true if the buffer is in gap mode, otherwise false.
+*/
+bool
+d_text_buffer_is_gap
+(
+    const struct d_text_buffer* _buffer
+)
+{
+    return (_buffer) && (_buffer->gap_mode);
+}
+
 // ----------------------------------------------------------------------------
 // Memory management
 // ----------------------------------------------------------------------------
@@ -3581,7 +5350,7 @@ Return:
 void
 d_text_buffer_free
 (
-    struct d_text _buffer* _buffer
+    struct d_text_buffer* _buffer
 )
 {
     if (!_buffer)
@@ -3592,6 +5361,17 @@ d_text_buffer_free
     // free overflow chunks first
     d_buffer_common_chunk_list_free(&_buffer->chunks);
 
+    if (_buffer->rope)
+    {
+        d_text_rope_clear(_buffer->rope);
+        free(_buffer->rope);
+    }
+
+    if (_buffer->hash)
+    {
+        free(_buffer->hash);
+    }
+
     if (_buffer->data)
     {
         free(_buffer->data);
@@ -0,0 +1,363 @@
+/******************************************************************************
+* djinterp [container]                                             text_hash.c
+*
+*   XXH64 streaming hash: 32-byte stripes over four lanes, then a tail of
+* 8-, 4- and 1-byte steps and a final avalanche.
+*
+*
+* path:      \src\container\buffer\text_hash.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include "..\..\..\inc\container\buffer\text_hash.h"
+
+
+// D_INTERNAL_TEXT_HASH_P1 .. P5
+//   constant: the XXH64 primes.
+#define D_INTERNAL_TEXT_HASH_P1 0x9E3779B185EBCA87ULL
+#define D_INTERNAL_TEXT_HASH_P2 0xC2B2AE3D27D4EB4FULL
+#define D_INTERNAL_TEXT_HASH_P3 0x165667B19E3779F9ULL
+#define D_INTERNAL_TEXT_HASH_P4 0x85EBCA77C2B2AE63ULL
+#define D_INTERNAL_TEXT_HASH_P5 0x27D4EB2F165667C5ULL
+
+
+// =============================================================================
+// internal helper functions
+// =============================================================================
+
+// d_internal_text_hash_rotl
+//   rotates a 64-bit value left.
+D_INLINE uint64_t
+d_internal_text_hash_rotl
+(
+    uint64_t _value,
+    unsigned _bits
+)
+{
+    return (_value << _bits) | (_value >> (64 - _bits));
+}
+
+// d_internal_text_hash_read64
+//   unaligned native-order 64-bit load.
+D_INLINE uint64_t
+d_internal_text_hash_read64
+(
+    const unsigned char* _bytes
+)
+{
+    uint64_t value;
+
+    memcpy(&value, _bytes, sizeof(value));
+
+    return value;
+}
+
+// d_internal_text_hash_read32
+//   unaligned native-order 32-bit load.
+D_INLINE uint32_t
+d_internal_text_hash_read32
+(
+    const unsigned char* _bytes
+)
+{
+    uint32_t value;
+
+    memcpy(&value, _bytes, sizeof(value));
+
+    return value;
+}
+
+// d_internal_text_hash_round
+//   folds one 8-byte word into a lane.
+D_INLINE uint64_t
+d_internal_text_hash_round
+(
+    uint64_t _lane,
+    uint64_t _word
+)
+{
+    _lane += _word * D_INTERNAL_TEXT_HASH_P2;
+    _lane  = d_internal_text_hash_rotl(_lane, 31);
+
+    return _lane * D_INTERNAL_TEXT_HASH_P1;
+}
+
+// d_internal_text_hash_merge
+//   folds a finished lane into the combined hash.
+D_INLINE uint64_t
+d_internal_text_hash_merge
+(
+    uint64_t _hash,
+    uint64_t _lane
+)
+{
+    _hash ^= d_internal_text_hash_round(0, _lane);
+
+    return _hash * D_INTERNAL_TEXT_HASH_P1 + D_INTERNAL_TEXT_HASH_P4;
+}
+
+/*
+d_internal_text_hash_stripes
+  Consumes whole 32-byte stripes into the four lanes.
+
+Parameter(s):
+  _lanes:   the lane accumulators.
+  _bytes:   the input; at least `_count * D_TEXT_HASH_STRIPE` bytes.
+  _count:   number of stripes.
+Return:
+  none.
+*/
+static void
+d_internal_text_hash_stripes
+(
+    uint64_t*            _lanes,
+    const unsigned char* _bytes,
+    size_t               _count
+)
+{
+    uint64_t v1;
+    uint64_t v2;
+    uint64_t v3;
+    uint64_t v4;
+
+    // locals keep the four dependency chains in registers
+    v1 = _lanes[0];
+    v2 = _lanes[1];
+    v3 = _lanes[2];
+    v4 = _lanes[3];
+
+    for (; _count > 0; --_count, _bytes += D_TEXT_HASH_STRIPE)
+    {
+        v1 = d_internal_text_hash_round(v1, d_internal_text_hash_read64(_bytes));
+        v2 = d_internal_text_hash_round(v2, d_internal_text_hash_read64(_bytes + 8));
+        v3 = d_internal_text_hash_round(v3, d_internal_text_hash_read64(_bytes + 16));
+        v4 = d_internal_text_hash_round(v4, d_internal_text_hash_read64(_bytes + 24));
+    }
+
+    _lanes[0] = v1;
+    _lanes[1] = v2;
+    _lanes[2] = v3;
+    _lanes[3] = v4;
+
+    return;
+}
+
+
+// =============================================================================
+// streaming
+// =============================================================================
+
+/*
+d_text_hash_init
+  Starts a new hash.
+
+Parameter(s):
+  _state: the hash state; must not be NULL.
+  _seed:  seed value; different seeds give unrelated hashes.
+Return:
+  none.
+*/
+void
+d_text_hash_init
+(
+    struct d_text_hash* _state,
+    uint64_t            _seed
+)
+{
+    if (!_state)
+    {
+        return;
+    }
+
+    _state->lanes[0]       = _seed + D_INTERNAL_TEXT_HASH_P1 + D_INTERNAL_TEXT_HASH_P2;
+    _state->lanes[1]       = _seed + D_INTERNAL_TEXT_HASH_P2;
+    _state->lanes[2]       = _seed;
+    _state->lanes[3]       = _seed - D_INTERNAL_TEXT_HASH_P1;
+    _state->seed           = _seed;
+    _state->total          = 0;
+    _state->pending_length = 0;
+
+    return;
+}
+
+/*
+d_text_hash_update
+  Feeds bytes into a hash. Input is consumed a stripe at a time straight
+from `_data`; only a partial stripe at either end is staged in `pending`.
+
+Parameter(s):
+  _state:  the hash state; must not be NULL.
+  _data:   the bytes; may be NULL when `_length` is 0.
+  _length: number of bytes.
+Return:
+  none.
+*/
+void
+d_text_hash_update
+(
+    struct d_text_hash* _state,
+    const void*         _data,
+    size_t              _length
+)
+{
+    const unsigned char* bytes;
+    size_t               fill;
+
+    if ( (!_state) ||
+         (!_data) ||
+         (_length == 0) )
+    {
+        return;
+    }
+
+    bytes          = (const unsigned char*)_data;
+    _state->total += _length;
+
+    // top up a partial stripe left by the previous update
+    if (_state->pending_length > 0)
+    {
+        fill = D_TEXT_HASH_STRIPE - _state->pending_length;
+
+        if (_length < fill)
+        {
+            memcpy(_state->pending + _state->pending_length, bytes, _length);
+            _state->pending_length += _length;
+
+            return;
+        }
+
+        memcpy(_state->pending + _state->pending_length, bytes, fill);
+        d_internal_text_hash_stripes(_state->lanes, _state->pending, 1);
+
+        bytes                  += fill;
+        _length                -= fill;
+        _state->pending_length  = 0;
+    }
+
+    d_internal_text_hash_stripes(_state->lanes,
+                                 bytes,
+                                 _length / D_TEXT_HASH_STRIPE);
+
+    bytes   += _length - (_length % D_TEXT_HASH_STRIPE);
+    _length %= D_TEXT_HASH_STRIPE;
+
+    if (_length > 0)
+    {
+        memcpy(_state->pending, bytes, _length);
+        _state->pending_length = _length;
+    }
+
+    return;
+}
+
+/*
+d_text_hash_digest
+  Returns the hash of everything fed so far. The state is not changed, so
+more bytes can be fed afterwards.
+
+Parameter(s):
+  _state: the hash state; may be NULL.
+Return:
+  The 64-bit hash; 0 for NULL.
+*/
+uint64_t
+d_text_hash_digest
+(
+    const struct d_text_hash* _state
+)
+{
+    const unsigned char* tail;
+    size_t               left;
+    uint64_t             hash;
+
+    if (!_state)
+    {
+        return 0;
+    }
+
+    if (_state->total >= D_TEXT_HASH_STRIPE)
+    {
+        hash = d_internal_text_hash_rotl(_state->lanes[0], 1)  +
+               d_internal_text_hash_rotl(_state->lanes[1], 7)  +
+               d_internal_text_hash_rotl(_state->lanes[2], 12) +
+               d_internal_text_hash_rotl(_state->lanes[3], 18);
+
+        hash = d_internal_text_hash_merge(hash, _state->lanes[0]);
+        hash = d_internal_text_hash_merge(hash, _state->lanes[1]);
+        hash = d_internal_text_hash_merge(hash, _state->lanes[2]);
+        hash = d_internal_text_hash_merge(hash, _state->lanes[3]);
+    }
+    else
+    {
+        hash = _state->seed + D_INTERNAL_TEXT_HASH_P5;
+    }
+
+    hash += _state->total;
+    tail  = _state->pending;
+    left  = _state->pending_length;
+
+    for (; left >= 8; left -= 8, tail += 8)
+    {
+        hash ^= d_internal_text_hash_round(0, d_internal_text_hash_read64(tail));
+        hash  = d_internal_text_hash_rotl(hash, 27) * D_INTERNAL_TEXT_HASH_P1 +
+                D_INTERNAL_TEXT_HASH_P4;
+    }
+
+    if (left >= 4)
+    {
+        hash ^= (uint64_t)d_internal_text_hash_read32(tail) * D_INTERNAL_TEXT_HASH_P1;
+        hash  = d_internal_text_hash_rotl(hash, 23) * D_INTERNAL_TEXT_HASH_P2 +
+                D_INTERNAL_TEXT_HASH_P3;
+
+        left -= 4;
+        tail += 4;
+    }
+
+    for (; left > 0; --left, ++tail)
+    {
+        hash ^= (uint64_t)(*tail) * D_INTERNAL_TEXT_HASH_P5;
+        hash  = d_internal_text_hash_rotl(hash, 11) * D_INTERNAL_TEXT_HASH_P1;
+    }
+
+    // avalanche
+    hash ^= hash >> 33;
+    hash *= D_INTERNAL_TEXT_HASH_P2;
+    hash ^= hash >> 29;
+    hash *= D_INTERNAL_TEXT_HASH_P3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+
+// =============================================================================
+// one-shot
+// =============================================================================
+
+/*
+d_text_hash_bytes
+  Hashes a contiguous block of bytes.
+
+Parameter(s):
+  _data:   the bytes; may be NULL when `_length` is 0.
+  _length: number of bytes.
+  _seed:   seed value.
+Return:
+  The 64-bit hash; the same as feeding the bytes to a fresh state.
+*/
+uint64_t
+d_text_hash_bytes
+(
+    const void* _data,
+    size_t      _length,
+    uint64_t    _seed
+)
+{
+    struct d_text_hash state;
+
+    d_text_hash_init(&state, _seed);
+    d_text_hash_update(&state, _data, _length);
+
+    return d_text_hash_digest(&state);
+}
@@ -0,0 +1,671 @@
+/******************************************************************************
+* djinterp [container]                                          text_matcher.c
+*
+*   Aho-Corasick multi-pattern matcher: trie construction, failure links
+* folded into a full byte-class DFA, and a leftmost-longest scan over
+* contiguous or segmented text.
+*
+*
+* path:      \src\container\buffer\text_matcher.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include "..\..\..\inc\container\buffer\text_matcher.h"
+
+
+// =============================================================================
+// internal helper functions
+// =============================================================================
+
+// d_internal_text_matcher_first_match
+//   fn_text_matcher_match that records the first match and stops the scan.
+static bool
+d_internal_text_matcher_first_match
+(
+    size_t _position,
+    size_t _pattern,
+    void*  _context
+)
+{
+    size_t* out = (size_t*)_context;
+
+    out[0] = _position;
+    out[1] = _pattern;
+
+    return false;
+}
+
+/*
+d_internal_text_matcher_link
+  Breadth-first pass over the trie that computes failure links and folds
+them into the transition table, so every (state, class) pair has a direct
+successor and a scan never follows a failure link at match time. Each
+state's output is also widened to the longest pattern that is a suffix of
+the state's prefix.
+
+Parameter(s):
+  _matcher: a matcher whose trie (next, output, depth) has been built.
+Return:
+  A boolean value indicating success; false if scratch memory could not be
+allocated.
+*/
+static bool
+d_internal_text_matcher_link
+(
+    struct d_text_matcher* _matcher
+)
+{
+    uint32_t* fail;
+    uint32_t* queue;
+    uint32_t* row;
+    uint32_t* fail_row;
+    size_t    classes;
+    size_t    head;
+    size_t    tail;
+    size_t    c;
+    uint32_t  s;
+    uint32_t  t;
+
+    classes = _matcher->class_count;
+    fail    = malloc(_matcher->state_count * sizeof(*fail));
+    queue   = malloc(_matcher->state_count * sizeof(*queue));
+
+    if ( (!fail) ||
+         (!queue) )
+    {
+        free(fail);
+        free(queue);
+
+        return false;
+    }
+
+    head = 0;
+    tail = 0;
+
+    // depth-1 states fail to the root; the root's missing transitions
+    // already point at the root (state 0)
+    for (c = 0; c < classes; ++c)
+    {
+        t = _matcher->next[c];
+
+        if (t)
+        {
+            fail[t]       = 0;
+            queue[tail++] = t;
+        }
+    }
+
+    while (head < tail)
+    {
+        s        = queue[head++];
+        row      = _matcher->next + ((size_t)s * classes);
+        fail_row = _matcher->next + ((size_t)fail[s] * classes);
+
+        // fail[s] is shallower, so its output is already final
+        if (_matcher->output[s] == D_TEXT_MATCHER_NONE)
+        {
+            _matcher->output[s] = _matcher->output[fail[s]];
+        }
+
+        for (c = 0; c < classes; ++c)
+        {
+            t = row[c];
+
+            if (t)
+            {
+                fail[t]       = fail_row[c];
+                queue[tail++] = t;
+            }
+            else
+            {
+                row[c] = fail_row[c];
+            }
+        }
+    }
+
+    free(fail);
+    free(queue);
+
+    return true;
+}
+
+
+// =============================================================================
+// construction
+// =============================================================================
+
+/*
+d_text_matcher_new
+  Compiles a set of NUL-terminated patterns.
+
+Parameter(s):
+  _patterns: array of `_count` non-empty C strings; copied.
+  _count:    number of patterns; must be at least 1.
+Return:
+  A new matcher, or NULL on invalid input or allocation failure.
+*/
+struct d_text_matcher*
+d_text_matcher_new
+(
+    const char* const* _patterns,
+    size_t             _count
+)
+{
+    return d_text_matcher_new_n(_patterns, NULL, _count);
+}
+
+/*
+d_text_matcher_new_n
+  Compiles a set of length-delimited patterns, which may contain NULs.
+When the same bytes are given more than once, the lowest index reports the
+match.
+
+Parameter(s):
+  _patterns: array of `_count` patterns; copied.
+  _lengths:  each pattern's length (at least 1), or NULL to use strlen.
+  _count:    number of patterns; must be at least 1.
+Return:
+  A new matcher, or NULL on invalid input or allocation failure.
+*/
+struct d_text_matcher*
+d_text_matcher_new_n
+(
+    const char* const* _patterns,
+    const size_t*      _lengths,
+    size_t             _count
+)
+{
+    struct d_text_matcher* matcher;
+    uint32_t*              shrunk;
+    size_t                 total;
+    size_t                 max_states;
+    size_t                 length;
+    size_t                 k;
+    size_t                 j;
+    uint32_t               s;
+    uint32_t               t;
+    uint16_t               c;
+
+    if ( (!_patterns) ||
+         (_count == 0) ||
+         (_count >= D_TEXT_MATCHER_NONE) )
+    {
+        return NULL;
+    }
+
+    matcher = calloc(1, sizeof(*matcher));
+
+    if (!matcher)
+    {
+        return NULL;
+    }
+
+    matcher->patterns = calloc(_count, sizeof(*matcher->patterns));
+    matcher->lengths  = malloc(_count * sizeof(*matcher->lengths));
+
+    if ( (!matcher->patterns) ||
+         (!matcher->lengths) )
+    {
+        d_text_matcher_free(matcher);
+
+        return NULL;
+    }
+
+    matcher->pattern_count = _count;
+    matcher->class_count   = 1;
+    total                  = 0;
+
+    // copy patterns and assign a byte class to every byte they use; class 0
+    // is shared by all bytes that appear in no pattern
+    for (k = 0; k < _count; ++k)
+    {
+        if (!_patterns[k])
+        {
+            d_text_matcher_free(matcher);
+
+            return NULL;
+        }
+
+        length = (_lengths) ? _lengths[k] : strlen(_patterns[k]);
+
+        if ( (length == 0) ||
+             (length >= (size_t)D_TEXT_MATCHER_NONE - total) )
+        {
+            d_text_matcher_free(matcher);
+
+            return NULL;
+        }
+
+        matcher->patterns[k] = malloc(length + 1);
+
+        if (!matcher->patterns[k])
+        {
+            d_text_matcher_free(matcher);
+
+            return NULL;
+        }
+
+        memcpy(matcher->patterns[k], _patterns[k], length);
+        matcher->patterns[k][length] = '\0';
+        matcher->lengths[k]          = length;
+        total                       += length;
+
+        matcher->starts[(unsigned char)_patterns[k][0]] = 1;
+
+        for (j = 0; j < length; ++j)
+        {
+            if (matcher->byte_class[(unsigned char)_patterns[k][j]] == 0)
+            {
+                matcher->byte_class[(unsigned char)_patterns[k][j]] =
+                    (uint16_t)matcher->class_count++;
+            }
+        }
+    }
+
+    max_states = total + 1;
+
+    if (max_states > SIZE_MAX / sizeof(uint32_t) / matcher->class_count)
+    {
+        d_text_matcher_free(matcher);
+
+        return NULL;
+    }
+
+    matcher->next   = calloc(max_states * matcher->class_count,
+                             sizeof(*matcher->next));
+    matcher->output = malloc(max_states * sizeof(*matcher->output));
+    matcher->depth  = calloc(max_states, sizeof(*matcher->depth));
+
+    if ( (!matcher->next) ||
+         (!matcher->output) ||
+         (!matcher->depth) )
+    {
+        d_text_matcher_free(matcher);
+
+        return NULL;
+    }
+
+    for (j = 0; j < max_states; ++j)
+    {
+        matcher->output[j] = D_TEXT_MATCHER_NONE;
+    }
+
+    // trie; a zero transition means "no child" since no edge leads back to
+    // the root
+    matcher->state_count = 1;
+
+    for (k = 0; k < _count; ++k)
+    {
+        s = 0;
+
+        for (j = 0; j < matcher->lengths[k]; ++j)
+        {
+            c = matcher->byte_class[(unsigned char)matcher->patterns[k][j]];
+            t = matcher->next[((size_t)s * matcher->class_count) + c];
+
+            if (!t)
+            {
+                t = (uint32_t)matcher->state_count++;
+
+                matcher->next[((size_t)s * matcher->class_count) + c] = t;
+                matcher->depth[t] = matcher->depth[s] + 1;
+            }
+
+            s = t;
+        }
+
+        if (matcher->output[s] == D_TEXT_MATCHER_NONE)
+        {
+            matcher->output[s] = (uint32_t)k;
+        }
+    }
+
+    if (!d_internal_text_matcher_link(matcher))
+    {
+        d_text_matcher_free(matcher);
+
+        return NULL;
+    }
+
+    // shared prefixes leave the tables over-allocated; give the slack back
+    // (a failed shrink is harmless)
+    shrunk = realloc(matcher->next,
+                     matcher->state_count * matcher->class_count *
+                     sizeof(*matcher->next));
+
+    if (shrunk)
+    {
+        matcher->next = shrunk;
+    }
+
+    return matcher;
+}
+
+
+// =============================================================================
+// access
+// =============================================================================
+
+/*
+d_text_matcher_pattern_count
+  Returns the number of patterns a matcher was compiled from.
+
+Parameter(s):
+  _matcher: the matcher.
+Return:
+  The pattern count, or 0 if `_matcher` is NULL.
+*/
+size_t
+d_text_matcher_pattern_count
+(
+    const struct d_text_matcher* _matcher
+)
+{
+    return (_matcher) ? _matcher->pattern_count : 0;
+}
+
+/*
+d_text_matcher_pattern_length
+  Returns the length of one pattern.
+
+Parameter(s):
+  _matcher: the matcher.
+  _pattern: the pattern's index.
+Return:
+  The pattern's length, or 0 if either argument is invalid.
+*/
+size_t
+d_text_matcher_pattern_length
+(
+    const struct d_text_matcher* _matcher,
+    size_t                       _pattern
+)
+{
+    if ( (!_matcher) ||
+         (_pattern >= _matcher->pattern_count) )
+    {
+        return 0;
+    }
+
+    return _matcher->lengths[_pattern];
+}
+
+
+// =============================================================================
+// scanning
+// =============================================================================
+
+/*
+d_text_matcher_find
+  Finds the leftmost-longest match of any pattern in contiguous text.
+
+Parameter(s):
+  _matcher:     the matcher.
+  _text:        the text to search; may contain NULs.
+  _text_length: the text's length.
+  _out_pattern: if not NULL, receives the index of the matching pattern.
+Return:
+  The match position, or -1 if there is none.
+*/
+ssize_t
+d_text_matcher_find
+(
+    const struct d_text_matcher* _matcher,
+    const char*                  _text,
+    size_t                       _text_length,
+    size_t*                      _out_pattern
+)
+{
+    struct d_text_segment segment;
+    size_t                found[2];
+
+    if ( (!_matcher) ||
+         ( (!_text) && (_text_length != 0) ) )
+    {
+        return -1;
+    }
+
+    segment.data   = _text;
+    segment.length = _text_length;
+    found[1]       = D_TEXT_MATCHER_NONE;
+
+    d_text_matcher_scan_segments(_matcher,
+                                 &segment,
+                                 1,
+                                 d_internal_text_matcher_first_match,
+                                 found);
+
+    if (found[1] == D_TEXT_MATCHER_NONE)
+    {
+        return -1;
+    }
+
+    if (_out_pattern)
+    {
+        *_out_pattern = found[1];
+    }
+
+    return (ssize_t)found[0];
+}
+
+/*
+d_text_matcher_scan_segments
+  Reports every leftmost-longest, non-overlapping match across segments
+treated as one contiguous text, in order. A candidate is held until the DFA
+state can no longer reach back to its start (state depth shorter than the
+distance to it), which proves no earlier-starting or longer match remains;
+the scan then resumes right after the reported match, rescanning at most
+one pattern length.
+
+Parameter(s):
+  _matcher:       the matcher.
+  _segments:      the text's segments, in order; empty segments are allowed.
+  _segment_count: number of segments.
+  _on_match:      called with each match's position and pattern index.
+  _context:       passed through to `_on_match`.
+Return:
+  true if the scan reached the end of the text, false if `_on_match` stopped
+it or an argument was invalid.
+*/
+bool
+d_text_matcher_scan_segments
+(
+    const struct d_text_matcher* _matcher,
+    const struct d_text_segment* _segments,
+    size_t                       _segment_count,
+    fn_text_matcher_match        _on_match,
+    void*                        _context
+)
+{
+    const unsigned char* data;
+    const uint32_t*      next;
+    const uint32_t*      output;
+    const uint32_t*      depth;
+    const uint16_t*      byte_class;
+    const uint8_t*       starts;
+    size_t               classes;
+    size_t               seg;
+    size_t               base;
+    size_t               pos;
+    size_t               length;
+    size_t               i;
+    size_t               start;
+    size_t               best_start;
+    uint32_t             best;
+    uint32_t             state;
+    uint32_t             p;
+    bool                 emit;
+
+    if ( (!_matcher) ||
+         ( (!_segments) && (_segment_count != 0) ) ||
+         (!_on_match) )
+    {
+        return false;
+    }
+
+    next       = _matcher->next;
+    output     = _matcher->output;
+    depth      = _matcher->depth;
+    byte_class = _matcher->byte_class;
+    starts     = _matcher->starts;
+    classes    = _matcher->class_count;
+
+    seg        = 0;
+    base       = 0;
+    pos        = 0;
+    state      = 0;
+    best       = D_TEXT_MATCHER_NONE;
+    best_start = 0;
+
+    for (;;)
+    {
+        emit = false;
+
+        // move to the segment holding `pos`
+        while ( (seg < _segment_count) &&
+                (pos - base >= _segments[seg].length) )
+        {
+            base += _segments[seg].length;
+            ++seg;
+        }
+
+        if (seg == _segment_count)
+        {
+            if (best == D_TEXT_MATCHER_NONE)
+            {
+                return true;
+            }
+
+            emit = true;
+        }
+        else
+        {
+            data   = (const unsigned char*)_segments[seg].data;
+            length = _segments[seg].length;
+
+            for (i = pos - base; i < length; ++i)
+            {
+                // idle at the root: skip bytes that cannot start a match,
+                // four table lookups at a time with no DFA dependency
+                if ( (state == 0) &&
+                     (best == D_TEXT_MATCHER_NONE) )
+                {
+                    while ( (i + 4 <= length) &&
+                            (!starts[data[i]]) &&
+                            (!starts[data[i + 1]]) &&
+                            (!starts[data[i + 2]]) &&
+                            (!starts[data[i + 3]]) )
+                    {
+                        i += 4;
+                    }
+
+                    while ( (i < length) &&
+                            (!starts[data[i]]) )
+                    {
+                        ++i;
+                    }
+
+                    if (i == length)
+                    {
+                        break;
+                    }
+                }
+
+                state = next[((size_t)state * classes) + byte_class[data[i]]];
+
+                if ( (best != D_TEXT_MATCHER_NONE) &&
+                     (depth[state] < base + i + 1 - best_start) )
+                {
+                    emit = true;
+
+                    break;
+                }
+
+                p = output[state];
+
+                if (p != D_TEXT_MATCHER_NONE)
+                {
+                    start = base + i + 1 - _matcher->lengths[p];
+
+                    if ( (best == D_TEXT_MATCHER_NONE) ||
+                         (start < best_start) ||
+                         ( (start == best_start) &&
+                           (_matcher->lengths[p] > _matcher->lengths[best]) ) )
+                    {
+                        best       = p;
+                        best_start = start;
+                    }
+                }
+            }
+
+            if (!emit)
+            {
+                pos = base + length;
+
+                continue;
+            }
+        }
+
+        if (!_on_match(best_start, best, _context))
+        {
+            return false;
+        }
+
+        // restart from the root right after the match
+        pos   = best_start + _matcher->lengths[best];
+        state = 0;
+        best  = D_TEXT_MATCHER_NONE;
+
+        while (pos < base)
+        {
+            --seg;
+            base -= _segments[seg].length;
+        }
+    }
+}
+
+
+// =============================================================================
+// memory management
+// =============================================================================
+
+/*
+d_text_matcher_free
+  Frees a matcher and its pattern copies.
+
+Parameter(s):
+  _matcher: the matcher; may be NULL.
+Return:
+  none.
+*/
+void
+d_text_matcher_free
+(
+    struct d_text_matcher* _matcher
+)
+{
+    size_t k;
+
+    if (!_matcher)
+    {
+        return;
+    }
+
+    if (_matcher->patterns)
+    {
+        for (k = 0; k < _matcher->pattern_count; ++k)
+        {
+            free(_matcher->patterns[k]);
+        }
+    }
+
+    free(_matcher->patterns);
+    free(_matcher->lengths);
+    free(_matcher->next);
+    free(_matcher->output);
+    free(_matcher->depth);
+    free(_matcher);
+
+    return;
+}
@@ -0,0 +1,1024 @@
+/******************************************************************************
+* djinterp [container]                                             text_rope.c
+*
+*   Implicit-treap rope: split/merge by byte position, with in-place fast
+* paths for edits that stay inside one leaf.
+*
+*
+* path:      \src\container\buffer\text_rope.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include "..\..\..\inc\container\buffer\text_rope.h"
+
+
+// =============================================================================
+// internal helper functions
+// =============================================================================
+
+// d_internal_text_rope_weight
+//   bytes in a (possibly empty) subtree.
+D_INLINE size_t
+d_internal_text_rope_weight
+(
+    const struct d_text_rope_node* _node
+)
+{
+    return (_node) ? _node->weight : 0;
+}
+
+// d_internal_text_rope_update
+//   recomputes a node's subtree weight from its children.
+D_INLINE void
+d_internal_text_rope_update
+(
+    struct d_text_rope_node* _node
+)
+{
+    _node->weight = d_internal_text_rope_weight(_node->left) +
+                    _node->length +
+                    d_internal_text_rope_weight(_node->right);
+
+    return;
+}
+
+// d_internal_text_rope_priority
+//   next pseudo-random heap priority (xorshift32).
+static uint32_t
+d_internal_text_rope_priority
+(
+    struct d_text_rope* _rope
+)
+{
+    uint32_t x = _rope->seed;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    _rope->seed = x;
+
+    return x;
+}
+
+/*
+d_internal_text_rope_node_new
+  Allocates a leaf holding up to D_TEXT_ROPE_LEAF bytes.
+
+Parameter(s):
+  _rope:   the rope the node will belong to (for its priority).
+  _text:   the node's text; may be NULL when `_length` is 0.
+  _length: bytes of text; at most D_TEXT_ROPE_LEAF.
+Return:
+  The new node, or NULL if allocation failed.
+*/
+static struct d_text_rope_node*
+d_internal_text_rope_node_new
+(
+    struct d_text_rope* _rope,
+    const char*         _text,
+    size_t              _length
+)
+{
+    struct d_text_rope_node* node;
+
+    node = malloc(sizeof(*node));
+
+    if (!node)
+    {
+        return NULL;
+    }
+
+    node->left     = NULL;
+    node->right    = NULL;
+    node->weight   = _length;
+    node->length   = _length;
+    node->priority = d_internal_text_rope_priority(_rope);
+
+    if (_length > 0)
+    {
+        memcpy(node->data, _text, _length);
+    }
+
+    return node;
+}
+
+// d_internal_text_rope_free_tree
+//   frees a subtree.
+static void
+d_internal_text_rope_free_tree
+(
+    struct d_text_rope_node* _node
+)
+{
+    struct d_text_rope_node* right;
+
+    // recurse left, loop right, so a right-leaning chain needs no stack
+    while (_node)
+    {
+        d_internal_text_rope_free_tree(_node->left);
+
+        right = _node->right;
+        free(_node);
+        _node = right;
+    }
+
+    return;
+}
+
+/*
+d_internal_text_rope_merge
+  Joins two treaps; every byte of `_a` precedes every byte of `_b`.
+
+Parameter(s):
+  _a: the left treap; may be NULL.
+  _b: the right treap; may be NULL.
+Return:
+  The root of the joined treap.
+*/
+static struct d_text_rope_node*
+d_internal_text_rope_merge
+(
+    struct d_text_rope_node* _a,
+    struct d_text_rope_node* _b
+)
+{
+    if (!_a)
+    {
+        return _b;
+    }
+
+    if (!_b)
+    {
+        return _a;
+    }
+
+    if (_a->priority >= _b->priority)
+    {
+        _a->right = d_internal_text_rope_merge(_a->right, _b);
+        d_internal_text_rope_update(_a);
+
+        return _a;
+    }
+
+    _b->left = d_internal_text_rope_merge(_a, _b->left);
+    d_internal_text_rope_update(_b);
+
+    return _b;
+}
+
+/*
+d_internal_text_rope_split
+  Splits a treap into the bytes before `_index` and the rest. At most one
+leaf is cut in two; its second half goes into `*_spare`, which is then set
+to NULL, so the split itself cannot fail.
+
+Parameter(s):
+  _node:  the treap; may be NULL.
+  _index: bytes to keep on the left; at most the treap's weight.
+  _spare: in/out: a preallocated node, consumed if a leaf has to be cut.
+  _left:  receives the left treap.
+  _right: receives the right treap.
+Return:
+  none.
+*/
+static void
+d_internal_text_rope_split
+(
+    struct d_text_rope_node*  _node,
+    size_t                    _index,
+    struct d_text_rope_node** _spare,
+    struct d_text_rope_node** _left,
+    struct d_text_rope_node** _right
+)
+{
+    struct d_text_rope_node* tail;
+    size_t                   left_weight;
+    size_t                   cut;
+
+    if (!_node)
+    {
+        *_left  = NULL;
+        *_right = NULL;
+
+        return;
+    }
+
+    left_weight = d_internal_text_rope_weight(_node->left);
+
+    if (_index <= left_weight)
+    {
+        d_internal_text_rope_split(_node->left,
+                                   _index,
+                                   _spare,
+                                   _left,
+                                   &_node->left);
+        d_internal_text_rope_update(_node);
+        *_right = _node;
+
+        return;
+    }
+
+    if (_index >= left_weight + _node->length)
+    {
+        d_internal_text_rope_split(_node->right,
+                                   _index - left_weight - _node->length,
+                                   _spare,
+                                   &_node->right,
+                                   _right);
+        d_internal_text_rope_update(_node);
+        *_left = _node;
+
+        return;
+    }
+
+    // the split point is inside this leaf: its tail moves into the spare,
+    // which inherits the right subtree and (to keep the heap order) the
+    // leaf's priority
+    cut  = _index - left_weight;
+    tail = *_spare;
+    *_spare = NULL;
+
+    tail->length   = _node->length - cut;
+    tail->priority = _node->priority;
+    tail->left     = NULL;
+    tail->right    = _node->right;
+    memcpy(tail->data, _node->data + cut, tail->length);
+
+    _node->length = cut;
+    _node->right  = NULL;
+
+    d_internal_text_rope_update(_node);
+    d_internal_text_rope_update(tail);
+
+    *_left  = _node;
+    *_right = tail;
+
+    return;
+}
+
+/*
+d_internal_text_rope_build
+  Builds a treap from contiguous text, D_TEXT_ROPE_LEAF bytes per leaf.
+
+Parameter(s):
+  _rope:   the rope the nodes will belong to.
+  _text:   the text.
+  _length: the text's length.
+  _out:    receives the root; NULL for empty text.
+Return:
+  A boolean value indicating success; nothing is allocated on failure.
+*/
+static bool
+d_internal_text_rope_build
+(
+    struct d_text_rope*       _rope,
+    const char*               _text,
+    size_t                    _length,
+    struct d_text_rope_node** _out
+)
+{
+    struct d_text_rope_node* root;
+    struct d_text_rope_node* node;
+    size_t                   offset;
+    size_t                   piece;
+
+    root = NULL;
+
+    for (offset = 0; offset < _length; offset += piece)
+    {
+        piece = _length - offset;
+
+        if (piece > D_TEXT_ROPE_LEAF)
+        {
+            piece = D_TEXT_ROPE_LEAF;
+        }
+
+        node = d_internal_text_rope_node_new(_rope, _text + offset, piece);
+
+        if (!node)
+        {
+            d_internal_text_rope_free_tree(root);
+
+            return false;
+        }
+
+        root = d_internal_text_rope_merge(root, node);
+    }
+
+    *_out = root;
+
+    return true;
+}
+
+/*
+d_internal_text_rope_insert_in_place
+  Inserts into the leaf holding `_index` if the text fits there, fixing
+subtree weights on the way back up. An index on a leaf boundary prefers
+the later leaf's start, then the earlier leaf's end.
+
+Parameter(s):
+  _node:   the subtree; may be NULL.
+  _index:  insertion point within the subtree.
+  _text:   the bytes to insert.
+  _length: number of bytes.
+Return:
+  true if the text was inserted, false if the target leaf is full (nothing
+changed).
+*/
+static bool
+d_internal_text_rope_insert_in_place
+(
+    struct d_text_rope_node* _node,
+    size_t                   _index,
+    const char*              _text,
+    size_t                   _length
+)
+{
+    size_t left_weight;
+    size_t offset;
+    bool   done;
+
+    if (!_node)
+    {
+        return false;
+    }
+
+    left_weight = d_internal_text_rope_weight(_node->left);
+
+    if (_index < left_weight)
+    {
+        done = d_internal_text_rope_insert_in_place(_node->left,
+                                                    _index,
+                                                    _text,
+                                                    _length);
+    }
+    else if (_index > left_weight + _node->length)
+    {
+        done = d_internal_text_rope_insert_in_place(_node->right,
+                                                    _index - left_weight -
+                                                    _node->length,
+                                                    _text,
+                                                    _length);
+    }
+    else if (_node->length + _length <= D_TEXT_ROPE_LEAF)
+    {
+        offset = _index - left_weight;
+
+        memmove(_node->data + offset + _length,
+                _node->data + offset,
+                _node->length - offset);
+        memcpy(_node->data + offset, _text, _length);
+
+        _node->length += _length;
+        done           = true;
+    }
+    else if ( (_index == left_weight) &&
+              (_node->left) )
+    {
+        // full leaf: try the end of the left neighbour instead
+        done = d_internal_text_rope_insert_in_place(_node->left,
+                                                    _index,
+                                                    _text,
+                                                    _length);
+    }
+    else
+    {
+        done = false;
+    }
+
+    if (done)
+    {
+        _node->weight += _length;
+    }
+
+    return done;
+}
+
+/*
+d_internal_text_rope_remove_in_place
+  Removes a range that lies entirely inside one leaf, fixing subtree
+weights on the way back up; a leaf left empty is unlinked and freed.
+
+Parameter(s):
+  _link:   in/out: the pointer to the subtree's root.
+  _start:  first byte to remove, within the subtree.
+  _length: bytes to remove; at least 1.
+Return:
+  true if the range was removed, false if it spans several leaves (nothing
+changed).
+*/
+static bool
+d_internal_text_rope_remove_in_place
+(
+    struct d_text_rope_node** _link,
+    size_t                    _start,
+    size_t                    _length
+)
+{
+    struct d_text_rope_node* node;
+    size_t                   left_weight;
+    size_t                   offset;
+    bool                     done;
+
+    node = *_link;
+
+    if (!node)
+    {
+        return false;
+    }
+
+    left_weight = d_internal_text_rope_weight(node->left);
+
+    if (_start < left_weight)
+    {
+        done = d_internal_text_rope_remove_in_place(&node->left,
+                                                    _start,
+                                                    _length);
+    }
+    else if (_start >= left_weight + node->length)
+    {
+        done = d_internal_text_rope_remove_in_place(&node->right,
+                                                    _start - left_weight -
+                                                    node->length,
+                                                    _length);
+    }
+    else if (_start + _length <= left_weight + node->length)
+    {
+        offset = _start - left_weight;
+
+        memmove(node->data + offset,
+                node->data + offset + _length,
+                node->length - offset - _length);
+
+        node->length -= _length;
+
+        if (node->length == 0)
+        {
+            *_link = d_internal_text_rope_merge(node->left, node->right);
+            free(node);
+
+            return true;
+        }
+
+        done = true;
+    }
+    else
+    {
+        done = false;
+    }
+
+    if (done)
+    {
+        node->weight -= _length;
+    }
+
+    return done;
+}
+
+// d_internal_text_rope_copy_range
+//   copies the part of [_start, _start + _length) that lies in a subtree.
+static void
+d_internal_text_rope_copy_range
+(
+    const struct d_text_rope_node* _node,
+    size_t                         _start,
+    size_t                         _length,
+    char*                          _destination
+)
+{
+    size_t left_weight;
+    size_t begin;
+    size_t end;
+
+    while ( (_node) &&
+            (_length > 0) )
+    {
+        left_weight = d_internal_text_rope_weight(_node->left);
+
+        if (_start < left_weight)
+        {
+            end = (_start + _length < left_weight) ? (_start + _length)
+                                                   : left_weight;
+
+            d_internal_text_rope_copy_range(_node->left,
+                                            _start,
+                                            end - _start,
+                                            _destination);
+
+            _destination += end - _start;
+            _length      -= end - _start;
+            _start        = end;
+        }
+
+        // this node's own bytes
+        begin = _start - left_weight;
+
+        if ( (_length > 0) &&
+             (begin < _node->length) )
+        {
+            end = (begin + _length < _node->length) ? (begin + _length)
+                                                    : _node->length;
+
+            memcpy(_destination, _node->data + begin, end - begin);
+
+            _destination += end - begin;
+            _length      -= end - begin;
+            _start       += end - begin;
+        }
+
+        // continue in the right subtree without recursing
+        _start -= left_weight + _node->length;
+        _node   = _node->right;
+    }
+
+    return;
+}
+
+
+// =============================================================================
+// construction
+// =============================================================================
+
+/*
+d_text_rope_init
+  Initializes an empty rope.
+
+Parameter(s):
+  _rope: the rope; must not be NULL.
+Return:
+  none.
+*/
+void
+d_text_rope_init
+(
+    struct d_text_rope* _rope
+)
+{
+    if (!_rope)
+    {
+        return;
+    }
+
+    _rope->root = NULL;
+    _rope->seed = 0x9E3779B9u;
+
+    return;
+}
+
+/*
+d_text_rope_assign
+  Replaces a rope's contents with a copy of contiguous text.
+
+Parameter(s):
+  _rope:   the rope; must not be NULL.
+  _text:   the text; may be NULL when `_length` is 0.
+  _length: the text's length.
+Return:
+  A boolean value indicating success; the rope is unchanged on failure.
+*/
+bool
+d_text_rope_assign
+(
+    struct d_text_rope* _rope,
+    const char*         _text,
+    size_t              _length
+)
+{
+    struct d_text_rope_node* root;
+
+    if ( (!_rope) ||
+         ( (!_text) && (_length != 0) ) )
+    {
+        return false;
+    }
+
+    if (!d_internal_text_rope_build(_rope, _text, _length, &root))
+    {
+        return false;
+    }
+
+    d_internal_text_rope_free_tree(_rope->root);
+    _rope->root = root;
+
+    return true;
+}
+
+
+// =============================================================================
+// access
+// =============================================================================
+
+/*
+d_text_rope_length
+  Returns the number of bytes in a rope.
+
+Parameter(s):
+  _rope: the rope; may be NULL.
+Return:
+  The rope's length; 0 for NULL.
+*/
+size_t
+d_text_rope_length
+(
+    const struct d_text_rope* _rope
+)
+{
+    return (_rope) ? d_internal_text_rope_weight(_rope->root) : 0;
+}
+
+/*
+d_text_rope_get
+  Returns the byte at `_index`.
+
+Parameter(s):
+  _rope:  the rope; may be NULL.
+  _index: a position in the rope.
+Return:
+  The byte, or '\0' if `_index` is out of range.
+*/
+char
+d_text_rope_get
+(
+    const struct d_text_rope* _rope,
+    size_t                    _index
+)
+{
+    const struct d_text_rope_node* node;
+    size_t                         left_weight;
+
+    node = (_rope) ? _rope->root : NULL;
+
+    while (node)
+    {
+        left_weight = d_internal_text_rope_weight(node->left);
+
+        if (_index < left_weight)
+        {
+            node = node->left;
+        }
+        else if (_index < left_weight + node->length)
+        {
+            return node->data[_index - left_weight];
+        }
+        else
+        {
+            _index -= left_weight + node->length;
+            node    = node->right;
+        }
+    }
+
+    return '\0';
+}
+
+/*
+d_text_rope_set
+  Overwrites the byte at `_index`.
+
+Parameter(s):
+  _rope:      the rope; must not be NULL.
+  _index:     a position in the rope.
+  _character: the new byte.
+Return:
+  A boolean value indicating success; false if `_index` is out of range.
+*/
+bool
+d_text_rope_set
+(
+    struct d_text_rope* _rope,
+    size_t              _index,
+    char                _character
+)
+{
+    struct d_text_rope_node* node;
+    size_t                   left_weight;
+
+    node = (_rope) ? _rope->root : NULL;
+
+    while (node)
+    {
+        left_weight = d_internal_text_rope_weight(node->left);
+
+        if (_index < left_weight)
+        {
+            node = node->left;
+        }
+        else if (_index < left_weight + node->length)
+        {
+            node->data[_index - left_weight] = _character;
+
+            return true;
+        }
+        else
+        {
+            _index -= left_weight + node->length;
+            node    = node->right;
+        }
+    }
+
+    return false;
+}
+
+/*
+d_text_rope_copy
+  Copies a range of a rope into contiguous memory (not NUL-terminated).
+
+Parameter(s):
+  _rope:        the rope; may be NULL.
+  _start:       first byte to copy.
+  _length:      bytes to copy; clamped to the end of the rope.
+  _destination: where to copy to; must hold the clamped length.
+Return:
+  The number of bytes copied.
+*/
+size_t
+d_text_rope_copy
+(
+    const struct d_text_rope* _rope,
+    size_t                    _start,
+    size_t                    _length,
+    char*                     _destination
+)
+{
+    size_t total;
+
+    total = d_text_rope_length(_rope);
+
+    if ( (!_destination) ||
+         (_start >= total) )
+    {
+        return 0;
+    }
+
+    if (_length > total - _start)
+    {
+        _length = total - _start;
+    }
+
+    d_internal_text_rope_copy_range(_rope->root, _start, _length, _destination);
+
+    return _length;
+}
+
+
+// =============================================================================
+// editing
+// =============================================================================
+
+/*
+d_text_rope_insert
+  Inserts bytes at `_index`. Short insertions go into the target leaf in
+place when it has room; otherwise the rope is split at `_index` and the
+new leaves are merged in between.
+
+Parameter(s):
+  _rope:   the rope; must not be NULL.
+  _index:  insertion point; at most the rope's length.
+  _text:   the bytes to insert; may contain NULs.
+  _length: number of bytes.
+Return:
+  A boolean value indicating success; the rope is unchanged on failure.
+*/
+bool
+d_text_rope_insert
+(
+    struct d_text_rope* _rope,
+    size_t              _index,
+    const char*         _text,
+    size_t              _length
+)
+{
+    struct d_text_rope_node* middle;
+    struct d_text_rope_node* spare;
+    struct d_text_rope_node* left;
+    struct d_text_rope_node* right;
+
+    if ( (!_rope) ||
+         ( (!_text) && (_length != 0) ) ||
+         (_index > d_text_rope_length(_rope)) )
+    {
+        return false;
+    }
+
+    if (_length == 0)
+    {
+        return true;
+    }
+
+    if ( (_length <= D_TEXT_ROPE_LEAF) &&
+         (d_internal_text_rope_insert_in_place(_rope->root,
+                                               _index,
+                                               _text,
+                                               _length)) )
+    {
+        return true;
+    }
+
+    spare = d_internal_text_rope_node_new(_rope, NULL, 0);
+
+    if (!spare)
+    {
+        return false;
+    }
+
+    if (!d_internal_text_rope_build(_rope, _text, _length, &middle))
+    {
+        free(spare);
+
+        return false;
+    }
+
+    d_internal_text_rope_split(_rope->root, _index, &spare, &left, &right);
+
+    _rope->root = d_internal_text_rope_merge(
+                      d_internal_text_rope_merge(left, middle),
+                      right);
+
+    free(spare);
+
+    return true;
+}
+
+/*
+d_text_rope_remove
+  Removes `_length` bytes starting at `_start`. A range inside one leaf is
+removed in place; otherwise the rope is split around the range and the
+two outer parts merged.
+
+Parameter(s):
+  _rope:   the rope; must not be NULL.
+  _start:  first byte to remove.
+  _length: bytes to remove; the range must lie within the rope.
+Return:
+  A boolean value indicating success; the rope is unchanged on failure.
+*/
+bool
+d_text_rope_remove
+(
+    struct d_text_rope* _rope,
+    size_t              _start,
+    size_t              _length
+)
+{
+    struct d_text_rope_node* spares[2];
+    struct d_text_rope_node* left;
+    struct d_text_rope_node* rest;
+    struct d_text_rope_node* middle;
+    struct d_text_rope_node* right;
+    size_t                   total;
+
+    total = d_text_rope_length(_rope);
+
+    if ( (!_rope) ||
+         (_start > total) ||
+         (_length > total - _start) )
+    {
+        return false;
+    }
+
+    if (_length == 0)
+    {
+        return true;
+    }
+
+    if (d_internal_text_rope_remove_in_place(&_rope->root, _start, _length))
+    {
+        return true;
+    }
+
+    spares[0] = d_internal_text_rope_node_new(_rope, NULL, 0);
+    spares[1] = d_internal_text_rope_node_new(_rope, NULL, 0);
+
+    if ( (!spares[0]) ||
+         (!spares[1]) )
+    {
+        free(spares[0]);
+        free(spares[1]);
+
+        return false;
+    }
+
+    d_internal_text_rope_split(_rope->root, _start, &spares[0], &left, &rest);
+    d_internal_text_rope_split(rest, _length, &spares[1], &middle, &right);
+
+    d_internal_text_rope_free_tree(middle);
+    _rope->root = d_internal_text_rope_merge(left, right);
+
+    free(spares[0]);
+    free(spares[1]);
+
+    return true;
+}
+
+/*
+d_text_rope_split
+  Moves the bytes from `_index` onward into another rope.
+
+Parameter(s):
+  _rope:  the rope to split; keeps the bytes before `_index`.
+  _index: split point; at most the rope's length.
+  _right: an initialized rope that receives the tail; its previous contents
+          are freed.
+Return:
+  A boolean value indicating success; both ropes are unchanged on failure.
+*/
+bool
+d_text_rope_split
+(
+    struct d_text_rope* _rope,
+    size_t              _index,
+    struct d_text_rope* _right
+)
+{
+    struct d_text_rope_node* spare;
+    struct d_text_rope_node* left;
+    struct d_text_rope_node* right;
+
+    if ( (!_rope) ||
+         (!_right) ||
+         (_rope == _right) ||
+         (_index > d_text_rope_length(_rope)) )
+    {
+        return false;
+    }
+
+    spare = d_internal_text_rope_node_new(_rope, NULL, 0);
+
+    if (!spare)
+    {
+        return false;
+    }
+
+    d_internal_text_rope_split(_rope->root, _index, &spare, &left, &right);
+    free(spare);
+
+    d_internal_text_rope_free_tree(_right->root);
+
+    _rope->root  = left;
+    _right->root = right;
+
+    return true;
+}
+
+/*
+d_text_rope_concat
+  Appends another rope's contents, leaving that rope empty. No text is
+copied.
+
+Parameter(s):
+  _rope:  the rope to append to; must not be NULL.
+  _right: the rope to append; must not be `_rope`.
+Return:
+  none.
+*/
+void
+d_text_rope_concat
+(
+    struct d_text_rope* _rope,
+    struct d_text_rope* _right
+)
+{
+    if ( (!_rope) ||
+         (!_right) ||
+         (_rope == _right) )
+    {
+        return;
+    }
+
+    _rope->root  = d_internal_text_rope_merge(_rope->root, _right->root);
+    _right->root = NULL;
+
+    return;
+}
+
+
+// =============================================================================
+// memory management
+// =============================================================================
+
+/*
+d_text_rope_clear
+  Frees a rope's nodes, leaving it empty and reusable.
+
+Parameter(s):
+  _rope: the rope; may be NULL.
+Return:
+  none.
+*/
+void
+d_text_rope_clear
+(
+    struct d_text_rope* _rope
+)
+{
+    if (!_rope)
+    {
+        return;
+    }
+
+    d_internal_text_rope_free_tree(_rope->root);
+    _rope->root = NULL;
+
+    return;
+}
@@ -0,0 +1,1100 @@
+/******************************************************************************
+* djinterp [container]                                           text_search.c
+*
+*   Length-aware substring search (SIMD first/last-byte filter for short
+* needles, Horspool for long ones) over contiguous and segmented text.
+*
+*
+* path:      \src\container\buffer\text_search.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include "..\..\..\inc\container\buffer\text_search.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define D_TEXT_SEARCH_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define D_TEXT_SEARCH_NEON 1
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#if defined(D_TEXT_SEARCH_SSE2) || defined(D_TEXT_SEARCH_NEON)
+    #define D_TEXT_SEARCH_SIMD 1
+#endif
+
+
+// D_INTERNAL_TEXT_SEARCH_BLOCK
+//   constant: positions tested per SIMD filter step.
+#define D_INTERNAL_TEXT_SEARCH_BLOCK 32
+
+
+// =============================================================================
+// internal helper functions
+// =============================================================================
+
+#if defined(D_TEXT_SEARCH_SIMD)
+
+/*
+d_internal_text_search_ctz
+  Index of the lowest set bit of a non-zero mask.
+
+Parameter(s):
+  _mask: a non-zero mask
+Return:
+  The number of trailing zero bits.
+*/
+static unsigned
+d_internal_text_search_ctz
+(
+    uint32_t _mask
+)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(_mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+
+    _BitScanForward(&index, _mask);
+
+    return (unsigned)index;
+#else
+    unsigned n = 0;
+
+    while ((_mask & 1u) == 0)
+    {
+        _mask >>= 1;
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+/*
+d_internal_text_search_top_bit
+  Index of the highest set bit of a non-zero mask.
+
+Parameter(s):
+  _mask: a non-zero mask
+Return:
+  The bit index, 0 to 31.
+*/
+static unsigned
+d_internal_text_search_top_bit
+(
+    uint32_t _mask
+)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 31u - (unsigned)__builtin_clz(_mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+
+    _BitScanReverse(&index, _mask);
+
+    return (unsigned)index;
+#else
+    unsigned n = 0;
+
+    while (_mask >>= 1)
+    {
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+/*
+d_internal_text_search_filter16
+  Tests 16 consecutive candidate positions: position i passes if
+`_first_block[i] == _first` and `_last_block[i] == _last`.
+
+Parameter(s):
+  _first_block: text at the first candidate position
+  _last_block:  text at the first candidate position + needle length - 1
+  _first:       the needle's first byte
+  _last:        the needle's last byte
+Return:
+  A 16-bit mask with bit i set if candidate i passed.
+*/
+D_INLINE uint32_t
+d_internal_text_search_filter16
+(
+    const char* _first_block,
+    const char* _last_block,
+    char        _first,
+    char        _last
+)
+{
+#if defined(D_TEXT_SEARCH_SSE2)
+    __m128i a = _mm_loadu_si128((const __m128i*)(const void*)_first_block);
+    __m128i b = _mm_loadu_si128((const __m128i*)(const void*)_last_block);
+
+    return (uint32_t)_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(a, _mm_set1_epi8(_first)),
+                      _mm_cmpeq_epi8(b, _mm_set1_epi8(_last))));
+#else
+    static const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                         1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t hits;
+
+    hits = vandq_u8(
+        vceqq_u8(vld1q_u8((const uint8_t*)_first_block),
+                 vdupq_n_u8((uint8_t)_first)),
+        vceqq_u8(vld1q_u8((const uint8_t*)_last_block),
+                 vdupq_n_u8((uint8_t)_last)));
+    hits = vandq_u8(hits, vld1q_u8(weights));
+
+    return (uint32_t)vaddv_u8(vget_low_u8(hits)) |
+           ((uint32_t)vaddv_u8(vget_high_u8(hits)) << 8);
+#endif
+}
+
+/*
+d_internal_text_search_filter
+  Tests D_INTERNAL_TEXT_SEARCH_BLOCK consecutive candidate positions as two
+16-byte halves; a full step is usually two loads, two compares and one
+branch on an all-zero mask.
+
+Parameter(s):
+  _first_block: text at the first candidate position
+  _last_block:  text at the first candidate position + needle length - 1
+  _first:       the needle's first byte
+  _last:        the needle's last byte
+Return:
+  A mask with bit i set if candidate i passed.
+*/
+D_INLINE uint32_t
+d_internal_text_search_filter
+(
+    const char* _first_block,
+    const char* _last_block,
+    char        _first,
+    char        _last
+)
+{
+    return d_internal_text_search_filter16(_first_block,
+                                           _last_block,
+                                           _first,
+                                           _last) |
+           (d_internal_text_search_filter16(_first_block + 16,
+                                            _last_block + 16,
+                                            _first,
+                                            _last) << 16);
+}
+
+#endif  // D_TEXT_SEARCH_SIMD
+
+/*
+d_internal_text_search_forward_short
+  Finds the first match of a needle of 2 to D_TEXT_SEARCH_SHORT_MAX bytes
+at or after `_start`. Candidates are filtered on the needle's first and
+last bytes, and only survivors are compared in full.
+
+Parameter(s):
+  _needle:      the needle
+  _length:      the needle's length; at least 2
+  _text:        the text to search
+  _text_length: the text's length; at least `_start + _length`
+  _start:       first position to consider
+Return:
+  The match position, or -1 if there is none.
+*/
+static ssize_t
+d_internal_text_search_forward_short
+(
+    const char* _needle,
+    size_t      _length,
+    const char* _text,
+    size_t      _text_length,
+    size_t      _start
+)
+{
+    const char* hit;
+    size_t      last;
+    size_t      i;
+#if defined(D_TEXT_SEARCH_SIMD)
+    uint32_t    mask;
+    unsigned    bit;
+#endif
+
+    last = _length - 1;
+    i    = _start;
+
+#if defined(D_TEXT_SEARCH_SIMD)
+    while (i + last + D_INTERNAL_TEXT_SEARCH_BLOCK <= _text_length)
+    {
+        mask = d_internal_text_search_filter(_text + i,
+                                             _text + i + last,
+                                             _needle[0],
+                                             _needle[last]);
+
+        while (mask)
+        {
+            bit = d_internal_text_search_ctz(mask);
+
+            if (memcmp(_text + i + bit + 1, _needle + 1, _length - 2) == 0)
+            {
+                return (ssize_t)(i + bit);
+            }
+
+            mask &= mask - 1;
+        }
+
+        i += D_INTERNAL_TEXT_SEARCH_BLOCK;
+    }
+#endif
+
+    // remaining positions (or all of them without SIMD): memchr on the
+    // first byte, then check the last byte before the full compare
+    while (i + _length <= _text_length)
+    {
+        hit = (const char*)memchr(_text + i,
+                                  (unsigned char)_needle[0],
+                                  _text_length - _length + 1 - i);
+
+        if (!hit)
+        {
+            return -1;
+        }
+
+        i = (size_t)(hit - _text);
+
+        if ( (_text[i + last] == _needle[last]) &&
+             (memcmp(_text + i + 1, _needle + 1, _length - 2) == 0) )
+        {
+            return (ssize_t)i;
+        }
+
+        ++i;
+    }
+
+    return -1;
+}
+
+/*
+d_internal_text_search_reverse_short
+  Finds the last match of a needle of 1 to D_TEXT_SEARCH_SHORT_MAX bytes,
+scanning backward from the end of the text.
+
+Parameter(s):
+  _needle:      the needle
+  _length:      the needle's length; at least 1
+  _text:        the text to search
+  _text_length: the text's length; at least `_length`
+Return:
+  The match position, or -1 if there is none.
+*/
+static ssize_t
+d_internal_text_search_reverse_short
+(
+    const char* _needle,
+    size_t      _length,
+    const char* _text,
+    size_t      _text_length
+)
+{
+    size_t   last;
+    size_t   end;
+#if defined(D_TEXT_SEARCH_SIMD)
+    size_t   base;
+    uint32_t mask;
+    unsigned bit;
+#endif
+
+    last = _length - 1;
+
+    // candidate positions are [0, end)
+    end = _text_length - last;
+
+#if defined(D_TEXT_SEARCH_SIMD)
+    while (end >= D_INTERNAL_TEXT_SEARCH_BLOCK)
+    {
+        base = end - D_INTERNAL_TEXT_SEARCH_BLOCK;
+        mask = d_internal_text_search_filter(_text + base,
+                                             _text + base + last,
+                                             _needle[0],
+                                             _needle[last]);
+
+        while (mask)
+        {
+            bit = d_internal_text_search_top_bit(mask);
+
+            if ( (_length <= 2) ||
+                 (memcmp(_text + base + bit + 1,
+                         _needle + 1,
+                         _length - 2) == 0) )
+            {
+                return (ssize_t)(base + bit);
+            }
+
+            mask &= ~(1u << bit);
+        }
+
+        end = base;
+    }
+#endif
+
+    while (end > 0)
+    {
+        --end;
+
+        if ( (_text[end] == _needle[0]) &&
+             (_text[end + last] == _needle[last]) &&
+             ( (_length <= 2) ||
+               (memcmp(_text + end + 1, _needle + 1, _length - 2) == 0) ) )
+        {
+            return (ssize_t)end;
+        }
+    }
+
+    return -1;
+}
+
+/*
+d_internal_text_search_forward_long
+  Horspool search for a needle longer than D_TEXT_SEARCH_SHORT_MAX.
+
+Parameter(s):
+  _searcher:    the prepared needle
+  _text:        the text to search
+  _text_length: the text's length
+  _start:       first position to consider
+Return:
+  The match position, or -1 if there is none.
+*/
+static ssize_t
+d_internal_text_search_forward_long
+(
+    const struct d_text_searcher* _searcher,
+    const char*                   _text,
+    size_t                        _text_length,
+    size_t                        _start
+)
+{
+    const char*   needle;
+    size_t        last;
+    size_t        i;
+    unsigned char c;
+
+    needle = _searcher->needle;
+    last   = _searcher->length - 1;
+    i      = _start;
+
+    while (i + last < _text_length)
+    {
+        c = (unsigned char)_text[i + last];
+
+        if ( (c == (unsigned char)needle[last]) &&
+             (memcmp(_text + i, needle, last) == 0) )
+        {
+            return (ssize_t)i;
+        }
+
+        i += _searcher->skip[c];
+    }
+
+    return -1;
+}
+
+/*
+d_internal_text_search_reverse_long
+  Reverse Horspool search for a needle longer than D_TEXT_SEARCH_SHORT_MAX:
+the window moves toward the start of the text, shifted by the first byte
+under it.
+
+Parameter(s):
+  _searcher:    the prepared needle
+  _text:        the text to search
+  _text_length: the text's length; at least the needle's length
+Return:
+  The match position, or -1 if there is none.
+*/
+static ssize_t
+d_internal_text_search_reverse_long
+(
+    const struct d_text_searcher* _searcher,
+    const char*                   _text,
+    size_t                        _text_length
+)
+{
+    const char*   needle;
+    size_t        length;
+    size_t        i;
+    size_t        shift;
+    unsigned char c;
+
+    needle = _searcher->needle;
+    length = _searcher->length;
+    i      = _text_length - length;
+
+    for (;;)
+    {
+        c = (unsigned char)_text[i];
+
+        if ( (c == (unsigned char)needle[0]) &&
+             (memcmp(_text + i + 1, needle + 1, length - 1) == 0) )
+        {
+            return (ssize_t)i;
+        }
+
+        shift = _searcher->skip_reverse[c];
+
+        if (i < shift)
+        {
+            return -1;
+        }
+
+        i -= shift;
+    }
+}
+
+
+// =============================================================================
+// searcher functions
+// =============================================================================
+
+/*
+d_text_searcher_init
+  Prepares `_needle` for searching. Long needles get Horspool shift tables;
+short ones need no preprocessing.
+
+Parameter(s):
+  _searcher: the searcher to initialize; NULL is ignored.
+  _needle:   the bytes to search for; borrowed, so it must outlive the
+             searcher. May contain NULs.
+  _length:   the needle's length; 0 matches at every position.
+Return:
+  none
+*/
+void
+d_text_searcher_init
+(
+    struct d_text_searcher* _searcher,
+    const char*             _needle,
+    size_t                  _length
+)
+{
+    size_t  j;
+    uint8_t cap;
+
+    if (!_searcher)
+    {
+        return;
+    }
+
+    _searcher->needle = _needle;
+    _searcher->length = (_needle) ? _length : 0;
+
+    if (_searcher->length <= D_TEXT_SEARCH_SHORT_MAX)
+    {
+        return;
+    }
+
+    cap = (_length < UINT8_MAX) ? (uint8_t)_length : UINT8_MAX;
+
+    memset(_searcher->skip, cap, sizeof(_searcher->skip));
+    memset(_searcher->skip_reverse, cap, sizeof(_searcher->skip_reverse));
+
+    // forward: distance from a byte's last occurrence (excluding the final
+    // byte) to the end of the needle
+    for (j = 0; j + 1 < _length; ++j)
+    {
+        _searcher->skip[(unsigned char)_needle[j]] =
+            (_length - 1 - j < UINT8_MAX) ? (uint8_t)(_length - 1 - j)
+                                          : UINT8_MAX;
+    }
+
+    // reverse: distance from the start of the needle to a byte's first
+    // occurrence (excluding the first byte)
+    for (j = _length - 1; j > 0; --j)
+    {
+        _searcher->skip_reverse[(unsigned char)_needle[j]] =
+            (j < UINT8_MAX) ? (uint8_t)j : UINT8_MAX;
+    }
+
+    return;
+}
+
+/*
+d_text_searcher_find
+  Finds the first match at or after `_start`.
+
+Parameter(s):
+  _searcher:    a searcher prepared by d_text_searcher_init.
+  _text:        the text to search; may contain NULs.
+  _text_length: the text's length.
+  _start:       first position to consider.
+Return:
+  The match position, or -1 if there is none. An empty needle matches at
+`_start` (if `_start` is within the text or at its end).
+*/
+ssize_t
+d_text_searcher_find
+(
+    const struct d_text_searcher* _searcher,
+    const char*                   _text,
+    size_t                        _text_length,
+    size_t                        _start
+)
+{
+    const char* hit;
+    size_t      length;
+
+    if ( (!_searcher) ||
+         ( (!_text) && (_text_length != 0) ) ||
+         (_start > _text_length) )
+    {
+        return -1;
+    }
+
+    length = _searcher->length;
+
+    if (length == 0)
+    {
+        return (ssize_t)_start;
+    }
+
+    if (length > _text_length - _start)
+    {
+        return -1;
+    }
+
+    if (length == 1)
+    {
+        hit = (const char*)memchr(_text + _start,
+                                  (unsigned char)_searcher->needle[0],
+                                  _text_length - _start);
+
+        return (hit) ? (ssize_t)(hit - _text) : -1;
+    }
+
+    if (length <= D_TEXT_SEARCH_SHORT_MAX)
+    {
+        return d_internal_text_search_forward_short(_searcher->needle,
+                                                    length,
+                                                    _text,
+                                                    _text_length,
+                                                    _start);
+    }
+
+    return d_internal_text_search_forward_long(_searcher,
+                                               _text,
+                                               _text_length,
+                                               _start);
+}
+
+/*
+d_text_searcher_find_last
+  Finds the last match, scanning backward from the end of the text.
+
+Parameter(s):
+  _searcher:    a searcher prepared by d_text_searcher_init.
+  _text:        the text to search; may contain NULs.
+  _text_length: the text's length.
+Return:
+  The match position, or -1 if there is none. An empty needle matches at
+`_text_length`.
+*/
+ssize_t
+d_text_searcher_find_last
+(
+    const struct d_text_searcher* _searcher,
+    const char*                   _text,
+    size_t                        _text_length
+)
+{
+    if ( (!_searcher) ||
+         ( (!_text) && (_text_length != 0) ) )
+    {
+        return -1;
+    }
+
+    if (_searcher->length == 0)
+    {
+        return (ssize_t)_text_length;
+    }
+
+    if (_searcher->length > _text_length)
+    {
+        return -1;
+    }
+
+    if (_searcher->length <= D_TEXT_SEARCH_SHORT_MAX)
+    {
+        return d_internal_text_search_reverse_short(_searcher->needle,
+                                                    _searcher->length,
+                                                    _text,
+                                                    _text_length);
+    }
+
+    return d_internal_text_search_reverse_long(_searcher,
+                                               _text,
+                                               _text_length);
+}
+
+/*
+d_text_searcher_count
+  Counts non-overlapping matches, scanning left to right.
+
+Parameter(s):
+  _searcher:    a searcher prepared by d_text_searcher_init.
+  _text:        the text to search; may contain NULs.
+  _text_length: the text's length.
+Return:
+  The number of matches; 0 for an empty needle.
+*/
+size_t
+d_text_searcher_count
+(
+    const struct d_text_searcher* _searcher,
+    const char*                   _text,
+    size_t                        _text_length
+)
+{
+    ssize_t found;
+    size_t  count;
+    size_t  pos;
+
+    if ( (!_searcher) ||
+         (_searcher->length == 0) )
+    {
+        return 0;
+    }
+
+    count = 0;
+    pos   = 0;
+
+    while ((found = d_text_searcher_find(_searcher,
+                                         _text,
+                                         _text_length,
+                                         pos)) >= 0)
+    {
+        ++count;
+        pos = (size_t)found + _searcher->length;
+    }
+
+    return count;
+}
+
+
+// =============================================================================
+// segmented text functions
+// =============================================================================
+
+/*
+d_text_searcher_scan_segments
+  Reports every non-overlapping match in the concatenation of `_segments`,
+left to right, starting at `_start`. Matches that straddle segment
+boundaries are found by searching the last (needle length - 1) bytes seen
+so far joined with the head of the next segment.
+
+Parameter(s):
+  _searcher:      a searcher prepared by d_text_searcher_init.
+  _segments:      the text, in order; empty segments are allowed.
+  _segment_count: number of segments.
+  _start:         first position (in the whole text) to consider.
+  _on_match:      called with each match's position; returning false
+                  stops the scan.
+  _context:       passed through to `_on_match`.
+Return:
+  A boolean value corresponding to either:
+  - true, if the scan ran (whether or not anything matched), or
+  - false, if a parameter was invalid or the boundary window could not be
+    allocated. An empty needle reports nothing.
+*/
+bool
+d_text_searcher_scan_segments
+(
+    const struct d_text_searcher* _searcher,
+    const struct d_text_segment*  _segments,
+    size_t                        _segment_count,
+    size_t                        _start,
+    fn_text_search_match          _on_match,
+    void*                         _context
+)
+{
+    char                         local[2 * D_TEXT_SEARCH_SHORT_MAX];
+    char*                        window;
+    const struct d_text_segment* seg;
+    ssize_t                      found;
+    size_t                       length;
+    size_t                       keep;
+    size_t                       offset;
+    size_t                       next;
+    size_t                       carry_len;
+    size_t                       carry_pos;
+    size_t                       head;
+    size_t                       from;
+    size_t                       kept;
+    size_t                       k;
+    bool                         stopped;
+
+    if ( (!_searcher) ||
+         ( (!_segments) && (_segment_count != 0) ) ||
+         (!_on_match) )
+    {
+        return false;
+    }
+
+    length = _searcher->length;
+
+    if (length == 0)
+    {
+        return true;
+    }
+
+    // the window holds the carried tail at [keep - carry_len, keep) and the
+    // next segment's head at [keep, keep + head)
+    keep   = length - 1;
+    window = NULL;
+
+    if ( (keep > 0) &&
+         (_segment_count > 1) )
+    {
+        window = (2 * keep <= sizeof(local)) ? local : malloc(2 * keep);
+
+        if (!window)
+        {
+            return false;
+        }
+    }
+
+    offset    = 0;
+    next      = _start;
+    carry_len = 0;
+    carry_pos = 0;
+    stopped   = false;
+
+    for (k = 0; (k < _segment_count) && (!stopped); ++k)
+    {
+        seg = &_segments[k];
+
+        // matches that begin in the carried tail and end in this segment
+        if ( (carry_len > 0) &&
+             (seg->length > 0) )
+        {
+            head = (seg->length < keep) ? seg->length : keep;
+            from = (next > carry_pos) ? (next - carry_pos) : 0;
+
+            memcpy(window + keep, seg->data, head);
+
+            while (from < carry_len)
+            {
+                found = d_text_searcher_find(_searcher,
+                                             window + keep - carry_len,
+                                             carry_len + head,
+                                             from);
+
+                if ( (found < 0) ||
+                     ((size_t)found >= carry_len) )
+                {
+                    break;
+                }
+
+                if (!_on_match(carry_pos + (size_t)found, _context))
+                {
+                    stopped = true;
+
+                    break;
+                }
+
+                next = carry_pos + (size_t)found + length;
+                from = (size_t)found + length;
+            }
+        }
+
+        if (stopped)
+        {
+            break;
+        }
+
+        // matches inside this segment
+        from = (next > offset) ? (next - offset) : 0;
+
+        while ((found = d_text_searcher_find(_searcher,
+                                             seg->data,
+                                             seg->length,
+                                             from)) >= 0)
+        {
+            if (!_on_match(offset + (size_t)found, _context))
+            {
+                stopped = true;
+
+                break;
+            }
+
+            next = offset + (size_t)found + length;
+            from = (size_t)found + length;
+        }
+
+        // carry the last `keep` bytes of the text seen so far
+        if (window)
+        {
+            if (seg->length >= keep)
+            {
+                memcpy(window, seg->data + seg->length - keep, keep);
+
+                carry_len = keep;
+            }
+            else
+            {
+                kept = (carry_len + seg->length > keep) ? (keep - seg->length)
+                                                        : carry_len;
+
+                memmove(window + keep - seg->length - kept,
+                        window + keep - kept,
+                        kept);
+                memcpy(window + keep - seg->length, seg->data, seg->length);
+
+                carry_len = kept + seg->length;
+            }
+
+            carry_pos = offset + seg->length - carry_len;
+        }
+
+        offset += seg->length;
+    }
+
+    if (window != local)
+    {
+        free(window);
+    }
+
+    return true;
+}
+
+/*
+d_text_searcher_find_last_segments
+  Finds the last match in the concatenation of `_segments`, scanning the
+segments from last to first.
+
+Parameter(s):
+  _searcher:      a searcher prepared by d_text_searcher_init.
+  _segments:      the text, in order; empty segments are allowed.
+  _segment_count: number of segments.
+Return:
+  The match position in the whole text, or -1 if there is none (or the
+boundary window could not be allocated). An empty needle matches at the
+end of the text.
+*/
+ssize_t
+d_text_searcher_find_last_segments
+(
+    const struct d_text_searcher* _searcher,
+    const struct d_text_segment*  _segments,
+    size_t                        _segment_count
+)
+{
+    char                         local[2 * D_TEXT_SEARCH_SHORT_MAX];
+    char*                        window;
+    const struct d_text_segment* seg;
+    ssize_t                      found;
+    ssize_t                      result;
+    size_t                       length;
+    size_t                       keep;
+    size_t                       end;
+    size_t                       front_len;
+    size_t                       tail;
+    size_t                       kept;
+    size_t                       k;
+
+    if ( (!_searcher) ||
+         ( (!_segments) && (_segment_count != 0) ) )
+    {
+        return -1;
+    }
+
+    end = 0;
+
+    for (k = 0; k < _segment_count; ++k)
+    {
+        end += _segments[k].length;
+    }
+
+    length = _searcher->length;
+
+    if (length == 0)
+    {
+        return (ssize_t)end;
+    }
+
+    // the window holds the next segment's tail at [keep - tail, keep) and
+    // the carried front at [keep, keep + front_len)
+    keep   = length - 1;
+    window = NULL;
+    result = -1;
+
+    if ( (keep > 0) &&
+         (_segment_count > 1) )
+    {
+        window = (2 * keep <= sizeof(local)) ? local : malloc(2 * keep);
+
+        if (!window)
+        {
+            return -1;
+        }
+    }
+
+    front_len = 0;
+
+    for (k = _segment_count; k > 0; --k)
+    {
+        seg  = &_segments[k - 1];
+        end -= seg->length;
+
+        // a straddling match starts later than any match inside the segment
+        if ( (front_len > 0) &&
+             (seg->length > 0) )
+        {
+            tail = (seg->length < keep) ? seg->length : keep;
+
+            memcpy(window + keep - tail, seg->data + seg->length - tail, tail);
+
+            found = d_text_searcher_find_last(_searcher,
+                                              window + keep - tail,
+                                              tail + front_len);
+
+            if (found >= 0)
+            {
+                result = (ssize_t)(end + seg->length - tail + (size_t)found);
+
+                break;
+            }
+        }
+
+        found = d_text_searcher_find_last(_searcher, seg->data, seg->length);
+
+        if (found >= 0)
+        {
+            result = (ssize_t)(end + (size_t)found);
+
+            break;
+        }
+
+        // carry the first `keep` bytes of the text after this point
+        if (window)
+        {
+            if (seg->length >= keep)
+            {
+                memcpy(window + keep, seg->data, keep);
+
+                front_len = keep;
+            }
+            else
+            {
+                kept = (front_len + seg->length > keep) ? (keep - seg->length)
+                                                        : front_len;
+
+                memmove(window + keep + seg->length, window + keep, kept);
+                memcpy(window + keep, seg->data, seg->length);
+
+                front_len = seg->length + kept;
+            }
+        }
+    }
+
+    if (window != local)
+    {
+        free(window);
+    }
+
+    return result;
+}
+
+
+// =============================================================================
+// one-shot functions
+// =============================================================================
+
+/*
+d_text_search_find
+  Finds the first occurrence of `_needle` in `_text`.
+
+Parameter(s):
+  _text:          the text to search; may contain NULs.
+  _text_length:   the text's length.
+  _needle:        the bytes to search for.
+  _needle_length: the needle's length.
+Return:
+  The match position, or -1 if there is none.
+*/
+ssize_t
+d_text_search_find
+(
+    const char* _text,
+    size_t      _text_length,
+    const char* _needle,
+    size_t      _needle_length
+)
+{
+    struct d_text_searcher searcher;
+
+    d_text_searcher_init(&searcher, _needle, _needle_length);
+
+    return d_text_searcher_find(&searcher, _text, _text_length, 0);
+}
+
+/*
+d_text_search_find_last
+  Finds the last occurrence of `_needle` in `_text`.
+
+Parameter(s):
+  _text:          the text to search; may contain NULs.
+  _text_length:   the text's length.
+  _needle:        the bytes to search for.
+  _needle_length: the needle's length.
+Return:
+  The match position, or -1 if there is none.
+*/
+ssize_t
+d_text_search_find_last
+(
+    const char* _text,
+    size_t      _text_length,
+    const char* _needle,
+    size_t      _needle_length
+)
+{
+    struct d_text_searcher searcher;
+
+    d_text_searcher_init(&searcher, _needle, _needle_length);
+
+    return d_text_searcher_find_last(&searcher, _text, _text_length);
+}
+
+/*
+d_text_search_count
+  Counts non-overlapping occurrences of `_needle` in `_text`.
+
+Parameter(s):
+  _text:          the text to search; may contain NULs.
+  _text_length:   the text's length.
+  _needle:        the bytes to search for.
+  _needle_length: the needle's length.
+Return:
+  The number of matches; 0 for an empty needle.
+*/
+size_t
+d_text_search_count
+(
+    const char* _text,
+    size_t      _text_length,
+    const char* _needle,
+    size_t      _needle_length
+)
+{
+    struct d_text_searcher searcher;
+
+    d_text_searcher_init(&searcher, _needle, _needle_length);
+
+    return d_text_searcher_count(&searcher, _text, _text_length);
+}
@@ -1,4 +1,1764 @@
+/******************************************************************************
+* djinterp [container]                                                   map.c
+*
+*   Implementation of the d_map container - an open-addressing Robin Hood
+* hash map with SIMD control-byte probing and incremental growth.
+*
+*
+* path:      \src\container\map\map.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2025.09.27
+******************************************************************************/
+
 #include "..\..\..\inc\container\map\map.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define D_MAP_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define D_MAP_NEON 1
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+
+// D_INTERNAL_MAP_NOT_FOUND
+//   constant: slot index returned by failed table searches.
+#define D_INTERNAL_MAP_NOT_FOUND SIZE_MAX
+
+
+// =============================================================================
+// internal helper functions
+// =============================================================================
+
+/*
+d_internal_map_mix
+  Finalizes a 64-bit hash (MurmurHash3 fmix64) so that every output bit
+depends on every input bit; both the slot position (low bits) and the
+control byte (high bits) are taken from the result.
+
+Parameter(s):
+  _h: the value to mix
+Return:
+  The mixed hash, folded to size_t.
+*/
+static size_t
+d_internal_map_mix
+(
+    uint64_t _h
+)
+{
+    _h ^= _h >> 33;
+    _h *= 0xFF51AFD7ED558CCDULL;
+    _h ^= _h >> 33;
+    _h *= 0xC4CEB9FE1A85EC53ULL;
+    _h ^= _h >> 33;
+
+    return (size_t)(_h ^ (_h >> 32 >> (sizeof(size_t) * 8 - 32)));
+}
+
+/*
+d_internal_map_hash
+  Hashes a stored key according to the map's key type.
+
+Parameter(s):
+  _map: the map whose key type applies
+  _key: the key
+Return:
+  The mixed hash of the key.
+*/
+static size_t
+d_internal_map_hash
+(
+    const struct d_map* _map,
+    union d_map_key     _key
+)
+{
+    const unsigned char* s;
+    uint64_t             h;
+
+    switch (_map->key_type)
+    {
+        case D_MAP_KEY_INT:
+        case D_MAP_KEY_UINT64:
+            return d_internal_map_mix(_key.u64);
+
+        case D_MAP_KEY_STRING:
+            // FNV-1a; the mix makes up for its weak high bits
+            h = 0xCBF29CE484222325ULL;
+
+            for (s = (const unsigned char*)_key.ptr; *s; ++s)
+            {
+                h ^= *s;
+                h *= 0x100000001B3ULL;
+            }
+
+            return d_internal_map_mix(h);
+
+        default:
+            return d_internal_map_mix((uint64_t)_map->hash_fn(_key.ptr));
+    }
+}
+
+/*
+d_internal_map_equal
+  Compares two stored keys according to the map's key type.
+
+Parameter(s):
+  _map: the map whose key type applies
+  _a:   first key
+  _b:   second key
+Return:
+  true if the keys are equal, false otherwise.
+*/
+static bool
+d_internal_map_equal
+(
+    const struct d_map* _map,
+    union d_map_key     _a,
+    union d_map_key     _b
+)
+{
+    switch (_map->key_type)
+    {
+        case D_MAP_KEY_INT:
+        case D_MAP_KEY_UINT64:
+            return (_a.u64 == _b.u64);
+
+        case D_MAP_KEY_STRING:
+            return (_a.ptr == _b.ptr) ||
+                   (strcmp((const char*)_a.ptr, (const char*)_b.ptr) == 0);
+
+        default:
+            return (_map->compare_fn(_a.ptr, _b.ptr) == 0);
+    }
+}
+
+/*
+d_internal_map_make_key
+  Converts a generic key pointer into a stored key (integer keys are read
+through the pointer and stored by value).
+
+Parameter(s):
+  _map: the map whose key type applies
+  _key: pointer to (or, for strings and custom keys, the) key
+Return:
+  The stored key.
+*/
+static union d_map_key
+d_internal_map_make_key
+(
+    const struct d_map* _map,
+    const void*         _key
+)
+{
+    union d_map_key key;
+
+    switch (_map->key_type)
+    {
+        case D_MAP_KEY_INT:
+            key.u64 = (uint64_t)(int64_t)*(const int*)_key;
+            break;
+
+        case D_MAP_KEY_UINT64:
+            key.u64 = *(const uint64_t*)_key;
+            break;
+
+        default:
+            key.u64 = 0;
+            key.ptr = _key;
+            break;
+    }
+
+    return key;
+}
+
+/*
+d_internal_map_ctrl_of
+  Control byte of an occupied slot: the high bit plus the top 7 hash bits.
+
+Parameter(s):
+  _hash: the slot's mixed hash
+Return:
+  The control byte.
+*/
+static uint8_t
+d_internal_map_ctrl_of
+(
+    size_t _hash
+)
+{
+    return (uint8_t)(0x80u | (_hash >> (sizeof(size_t) * 8 - 7)));
+}
+
+/*
+d_internal_map_ctz
+  Index of the lowest set bit of a non-zero mask.
+
+Parameter(s):
+  _mask: a non-zero mask
+Return:
+  The number of trailing zero bits.
+*/
+static unsigned
+d_internal_map_ctz
+(
+    uint32_t _mask
+)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(_mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+
+    _BitScanForward(&index, _mask);
+
+    return (unsigned)index;
+#else
+    unsigned n = 0;
+
+    while ((_mask & 1u) == 0)
+    {
+        _mask >>= 1;
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+/*
+d_internal_map_group_match
+  Compares D_MAP_GROUP_WIDTH control bytes against `_byte`.
+
+Parameter(s):
+  _ctrl: first control byte of the group
+  _byte: the byte to look for
+Return:
+  A mask with bit i set if _ctrl[i] == _byte.
+*/
+static uint32_t
+d_internal_map_group_match
+(
+    const uint8_t* _ctrl,
+    uint8_t        _byte
+)
+{
+#if defined(D_MAP_SSE2)
+    __m128i group = _mm_loadu_si128((const __m128i*)(const void*)_ctrl);
+
+    return (uint32_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(group, _mm_set1_epi8((char)_byte)));
+#elif defined(D_MAP_NEON)
+    static const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                         1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t bits;
+
+    bits = vandq_u8(vceqq_u8(vld1q_u8(_ctrl), vdupq_n_u8(_byte)),
+                    vld1q_u8(weights));
+
+    return (uint32_t)vaddv_u8(vget_low_u8(bits)) |
+           ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+#else
+    uint32_t mask = 0;
+    unsigned i;
+
+    for (i = 0; i < D_MAP_GROUP_WIDTH; ++i)
+    {
+        if (_ctrl[i] == _byte)
+        {
+            mask |= (1u << i);
+        }
+    }
+
+    return mask;
+#endif
+}
+
+/*
+d_internal_map_table_init
+  Allocates a table with `_capacity` slots (a power of two, at least
+D_MAP_GROUP_WIDTH) and marks every slot empty. Slots and control bytes
+share one allocation.
+
+Parameter(s):
+  _table:    the table to initialize
+  _capacity: the slot count
+Return:
+  true if successful, false if allocation failed.
+*/
+static bool
+d_internal_map_table_init
+(
+    struct d_map_table* _table,
+    size_t              _capacity
+)
+{
+    size_t ctrl_size;
+
+    ctrl_size     = _capacity + D_MAP_GROUP_WIDTH - 1;
+    _table->slots = malloc((_capacity * sizeof(struct d_map_slot)) + ctrl_size);
+
+    if (!_table->slots)
+    {
+        return false;
+    }
+
+    _table->ctrl     = (uint8_t*)(_table->slots + _capacity);
+    _table->capacity = _capacity;
+    _table->count    = 0;
+
+    memset(_table->ctrl, D_MAP_CTRL_EMPTY, ctrl_size);
+
+    return true;
+}
+
+/*
+d_internal_map_table_release
+  Frees a table's storage and resets it to the unallocated state.
+
+Parameter(s):
+  _table: the table to release
+Return:
+  none
+*/
+static void
+d_internal_map_table_release
+(
+    struct d_map_table* _table
+)
+{
+    free(_table->slots);
+
+    _table->slots    = NULL;
+    _table->ctrl     = NULL;
+    _table->capacity = 0;
+    _table->count    = 0;
+}
+
+/*
+d_internal_map_set_ctrl
+  Sets a control byte, keeping the mirrored copy of the first group in
+sync.
+
+Parameter(s):
+  _table: the table
+  _index: the slot index
+  _ctrl:  the new control byte
+Return:
+  none
+*/
+static void
+d_internal_map_set_ctrl
+(
+    struct d_map_table* _table,
+    size_t              _index,
+    uint8_t             _ctrl
+)
+{
+    _table->ctrl[_index] = _ctrl;
+
+    if (_index < D_MAP_GROUP_WIDTH - 1)
+    {
+        _table->ctrl[_table->capacity + _index] = _ctrl;
+    }
+}
+
+/*
+d_internal_map_distance
+  Probe distance of the occupied slot `_index` from its home slot.
+
+Parameter(s):
+  _table: the table
+  _index: an occupied slot index
+Return:
+  The distance, in slots.
+*/
+static size_t
+d_internal_map_distance
+(
+    const struct d_map_table* _table,
+    size_t                    _index
+)
+{
+    size_t mask = _table->capacity - 1;
+
+    return (_index - (_table->slots[_index].hash & mask)) & mask;
+}
+
+/*
+d_internal_map_table_find
+  Searches one table. Keys sit between their home slot and the first empty
+slot after it, so a group scan only checks hash-matching slots before the
+first empty control byte it sees.
+
+Parameter(s):
+  _map:   the map (key type and comparator)
+  _table: the table to search
+  _key:   the key
+  _hash:  the key's mixed hash
+Return:
+  The slot index, or D_INTERNAL_MAP_NOT_FOUND.
+*/
+static size_t
+d_internal_map_table_find
+(
+    const struct d_map*       _map,
+    const struct d_map_table* _table,
+    union d_map_key           _key,
+    size_t                    _hash
+)
+{
+    size_t   mask;
+    size_t   pos;
+    size_t   index;
+    uint32_t match;
+    uint32_t empty;
+    uint8_t  ctrl;
+
+    if (_table->count == 0)
+    {
+        return D_INTERNAL_MAP_NOT_FOUND;
+    }
+
+    mask = _table->capacity - 1;
+    pos  = _hash & mask;
+    ctrl = d_internal_map_ctrl_of(_hash);
+
+    for (;;)
+    {
+        match = d_internal_map_group_match(_table->ctrl + pos, ctrl);
+        empty = d_internal_map_group_match(_table->ctrl + pos, D_MAP_CTRL_EMPTY);
+
+        if (empty)
+        {
+            // only slots before the first empty one can hold the key
+            match &= (empty & (0u - empty)) - 1u;
+        }
+
+        while (match)
+        {
+            index = (pos + d_internal_map_ctz(match)) & mask;
+
+            if ( (_table->slots[index].hash == _hash) &&
+                 (d_internal_map_equal(_map, _table->slots[index].key, _key)) )
+            {
+                return index;
+            }
+
+            match &= match - 1u;
+        }
+
+        if (empty)
+        {
+            return D_INTERNAL_MAP_NOT_FOUND;
+        }
+
+        pos = (pos + D_MAP_GROUP_WIDTH) & mask;
+    }
+}
+
+/*
+d_internal_map_table_insert
+  Robin Hood insertion of a key known to be absent: walking from its home
+slot, the new entry takes the place of any resident closer to its own home
+and carries that resident on.
+
+Parameter(s):
+  _table: the (live) table, with at least one empty slot
+  _slot:  the entry to insert
+Return:
+  none
+*/
+static void
+d_internal_map_table_insert
+(
+    struct d_map_table* _table,
+    struct d_map_slot   _slot
+)
+{
+    struct d_map_slot displaced;
+    size_t            mask;
+    size_t            pos;
+    size_t            dist;
+    size_t            resident;
+    uint8_t           ctrl;
+    uint8_t           displaced_ctrl;
+
+    mask = _table->capacity - 1;
+    pos  = _slot.hash & mask;
+    dist = 0;
+    ctrl = d_internal_map_ctrl_of(_slot.hash);
+
+    for (;;)
+    {
+        if (_table->ctrl[pos] == D_MAP_CTRL_EMPTY)
+        {
+            _table->slots[pos] = _slot;
+            d_internal_map_set_ctrl(_table, pos, ctrl);
+            _table->count++;
+
+            return;
+        }
+
+        resident = d_internal_map_distance(_table, pos);
+
+        if (resident < dist)
+        {
+            displaced      = _table->slots[pos];
+            displaced_ctrl = _table->ctrl[pos];
+
+            _table->slots[pos] = _slot;
+            d_internal_map_set_ctrl(_table, pos, ctrl);
+
+            _slot = displaced;
+            ctrl  = displaced_ctrl;
+            dist  = resident;
+        }
+
+        pos = (pos + 1) & mask;
+        dist++;
+    }
+}
+
+/*
+d_internal_map_table_erase
+  Removes a slot from the live table by shifting the rest of its run back
+one slot (backward-shift deletion), so no tombstone is left.
+
+Parameter(s):
+  _table: the live table
+  _index: the occupied slot to remove
+Return:
+  none
+*/
+static void
+d_internal_map_table_erase
+(
+    struct d_map_table* _table,
+    size_t              _index
+)
+{
+    size_t mask = _table->capacity - 1;
+    size_t next;
+
+    for (;;)
+    {
+        next = (_index + 1) & mask;
+
+        if ( (_table->ctrl[next] == D_MAP_CTRL_EMPTY) ||
+             (d_internal_map_distance(_table, next) == 0) )
+        {
+            d_internal_map_set_ctrl(_table, _index, D_MAP_CTRL_EMPTY);
+            break;
+        }
+
+        _table->slots[_index] = _table->slots[next];
+        d_internal_map_set_ctrl(_table, _index, _table->ctrl[next]);
+
+        _index = next;
+    }
+
+    _table->count--;
+}
+
+/*
+d_internal_map_migrate
+  Moves up to `_steps` old-table slots into the live table. Migrated slots
+are marked D_MAP_CTRL_MOVED rather than emptied, so keys further along
+their run stay reachable; the old table is freed once fully swept.
+
+Parameter(s):
+  _map:   the map
+  _steps: old slots to visit (SIZE_MAX to finish the migration)
+Return:
+  none
+*/
+static void
+d_internal_map_migrate
+(
+    struct d_map* _map,
+    size_t        _steps
+)
+{
+    struct d_map_table* old = &_map->old;
+
+    while ( (old->capacity > 0)                 &&
+            (old->count > 0)                    &&
+            (_map->migrate_at < old->capacity)  &&
+            (_steps > 0) )
+    {
+        if ((old->ctrl[_map->migrate_at] & 0x80u) != 0)
+        {
+            d_internal_map_table_insert(&_map->table, old->slots[_map->migrate_at]);
+            d_internal_map_set_ctrl(old, _map->migrate_at, D_MAP_CTRL_MOVED);
+            old->count--;
+        }
+
+        _map->migrate_at++;
+        _steps--;
+    }
+
+    if ( (old->capacity > 0) &&
+         (old->count == 0) )
+    {
+        d_internal_map_table_release(old);
+        _map->migrate_at = 0;
+    }
+
+    return;
+}
+
+/*
+d_internal_map_capacity_for
+  Smallest table capacity that holds `_count` entries within the load
+limit.
+
+Parameter(s):
+  _count: the number of entries
+Return:
+  A power of two, at least D_MAP_DEFAULT_CAPACITY, or 0 on overflow.
+*/
+static size_t
+d_internal_map_capacity_for
+(
+    size_t _count
+)
+{
+    size_t capacity = D_MAP_DEFAULT_CAPACITY;
+
+    if (_count > (SIZE_MAX / 100))
+    {
+        return 0;
+    }
+
+    while ((capacity * D_MAP_MAX_LOAD_PERCENT) < (_count * 100))
+    {
+        if (capacity > (SIZE_MAX / 2))
+        {
+            return 0;
+        }
+
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+/*
+d_internal_map_resize
+  Moves every entry into a new live table of `_capacity` slots at once.
+
+Parameter(s):
+  _map:      the map
+  _capacity: the new slot count
+Return:
+  true if successful, false if allocation failed (the map is unchanged).
+*/
+static bool
+d_internal_map_resize
+(
+    struct d_map* _map,
+    size_t        _capacity
+)
+{
+    struct d_map_table table;
+    size_t             i;
+
+    if (!d_internal_map_table_init(&table, _capacity))
+    {
+        return false;
+    }
+
+    for (i = 0; i < _map->old.capacity; ++i)
+    {
+        if ((_map->old.ctrl[i] & 0x80u) != 0)
+        {
+            d_internal_map_table_insert(&table, _map->old.slots[i]);
+        }
+    }
+
+    for (i = 0; i < _map->table.capacity; ++i)
+    {
+        if ((_map->table.ctrl[i] & 0x80u) != 0)
+        {
+            d_internal_map_table_insert(&table, _map->table.slots[i]);
+        }
+    }
+
+    d_internal_map_table_release(&_map->old);
+    d_internal_map_table_release(&_map->table);
+
+    _map->table      = table;
+    _map->migrate_at = 0;
+
+    return true;
+}
+
+/*
+d_internal_map_grow
+  Starts an incremental migration into a table twice the size. A migration
+still in progress (only possible after heavy removal) is finished first.
+
+Parameter(s):
+  _map: the map
+Return:
+  true if successful, false if allocation failed.
+*/
+static bool
+d_internal_map_grow
+(
+    struct d_map* _map
+)
+{
+    struct d_map_table table;
+
+    d_internal_map_migrate(_map, SIZE_MAX);
+
+    if ( (_map->table.capacity > (SIZE_MAX / 2 / sizeof(struct d_map_slot))) ||
+         (!d_internal_map_table_init(&table, _map->table.capacity * 2)) )
+    {
+        return false;
+    }
+
+    _map->old        = _map->table;
+    _map->table      = table;
+    _map->migrate_at = 0;
+
+    // an empty old table has nothing to hand over
+    d_internal_map_migrate(_map, 0);
+
+    return true;
+}
+
+/*
+d_internal_map_locate
+  Finds a key in the live table, then in the table being migrated from.
+
+Parameter(s):
+  _map:   the map
+  _key:   the key
+  _hash:  the key's mixed hash
+  _table: receives the table holding the key
+Return:
+  The slot index, or D_INTERNAL_MAP_NOT_FOUND.
+*/
+static size_t
+d_internal_map_locate
+(
+    const struct d_map*        _map,
+    union d_map_key            _key,
+    size_t                     _hash,
+    const struct d_map_table** _table
+)
+{
+    size_t index;
+
+    index = d_internal_map_table_find(_map, &_map->table, _key, _hash);
+
+    if (index != D_INTERNAL_MAP_NOT_FOUND)
+    {
+        *_table = &_map->table;
+
+        return index;
+    }
+
+    *_table = &_map->old;
+
+    return d_internal_map_table_find(_map, &_map->old, _key, _hash);
+}
+
+/*
+d_internal_map_put_key
+  Inserts or updates a stored key.
+
+Parameter(s):
+  _map:   the map
+  _key:   the stored key
+  _value: the value
+Return:
+  true if successful, false if growing the table failed.
+*/
+static bool
+d_internal_map_put_key
+(
+    struct d_map*   _map,
+    union d_map_key _key,
+    void*           _value
+)
+{
+    const struct d_map_table* table;
+    struct d_map_slot         slot;
+    size_t                    index;
+
+    slot.key   = _key;
+    slot.value = _value;
+    slot.hash  = d_internal_map_hash(_map, _key);
+
+    index = d_internal_map_locate(_map, _key, slot.hash, &table);
+
+    if (index != D_INTERNAL_MAP_NOT_FOUND)
+    {
+        table->slots[index].value = _value;
+
+        return true;
+    }
+
+    if ( ((_map->table.count + _map->old.count + 1) * 100) >
+         (_map->table.capacity * D_MAP_MAX_LOAD_PERCENT) )
+    {
+        if (!d_internal_map_grow(_map))
+        {
+            return false;
+        }
+    }
+
+    d_internal_map_table_insert(&_map->table, slot);
+    d_internal_map_migrate(_map, D_MAP_MIGRATE_STEP);
+
+    return true;
+}
+
+/*
+d_internal_map_get_key
+  Looks up a stored key.
+
+Parameter(s):
+  _map: the map
+  _key: the stored key
+Return:
+  The slot holding the key, or NULL if not found.
+*/
+static struct d_map_slot*
+d_internal_map_get_key
+(
+    const struct d_map* _map,
+    union d_map_key     _key
+)
+{
+    const struct d_map_table* table;
+    size_t                    index;
+
+    index = d_internal_map_locate(_map,
+                                  _key,
+                                  d_internal_map_hash(_map, _key),
+                                  &table);
+
+    return (index != D_INTERNAL_MAP_NOT_FOUND) ? &table->slots[index]
+                                               : NULL;
+}
+
+/*
+d_internal_map_remove_key
+  Removes a stored key. Entries still in the old table are only marked
+moved; that table is discarded when the migration ends.
+
+Parameter(s):
+  _map:       the map
+  _key:       the stored key
+  _out_value: if non-NULL, receives the removed value
+Return:
+  true if the key was removed, false if not found.
+*/
+static bool
+d_internal_map_remove_key
+(
+    struct d_map*   _map,
+    union d_map_key _key,
+    void**          _out_value
+)
+{
+    const struct d_map_table* table;
+    size_t                    index;
+
+    index = d_internal_map_locate(_map,
+                                  _key,
+                                  d_internal_map_hash(_map, _key),
+                                  &table);
+
+    if (index == D_INTERNAL_MAP_NOT_FOUND)
+    {
+        return false;
+    }
+
+    if (_out_value)
+    {
+        *_out_value = table->slots[index].value;
+    }
+
+    if (table == &_map->table)
+    {
+        d_internal_map_table_erase(&_map->table, index);
+    }
+    else
+    {
+        d_internal_map_set_ctrl(&_map->old, index, D_MAP_CTRL_MOVED);
+        _map->old.count--;
+    }
+
+    d_internal_map_migrate(_map, D_MAP_MIGRATE_STEP);
+
+    return true;
+}
+
+
+// =============================================================================
+// public functions
+// =============================================================================
+
+/*
+d_map_new
+  Allocates a new, empty map with user-defined key hashing and comparison.
+
+Parameter(s):
+  _hash_fn:    hashes a key
+  _compare_fn: compares two keys; 0 means equal
+Return:
+  Either a pointer to a new, empty d_map, or NULL if either function is
+  NULL or allocation failed.
+*/
+struct d_map*
+d_map_new
+(
+    fn_map_hash   _hash_fn,
+    fn_comparator _compare_fn
+)
+{
+    return d_map_new_with_capacity(D_MAP_KEY_CUSTOM,
+                                   _hash_fn,
+                                   _compare_fn,
+                                   0);
+}
+
+/*
+d_map_new_with_capacity
+  Allocates a new, empty map able to hold `_capacity` entries before its
+first growth.
+
+Parameter(s):
+  _key_type:   how keys are hashed and compared
+  _hash_fn:    hashes a key (D_MAP_KEY_CUSTOM only, else ignored)
+  _compare_fn: compares two keys (D_MAP_KEY_CUSTOM only, else ignored)
+  _capacity:   entries to hold without growing
+Return:
+  Either a pointer to a new, empty d_map, or NULL if a custom map lacks a
+  function or allocation failed.
+*/
+struct d_map*
+d_map_new_with_capacity
+(
+    enum DMapKeyType _key_type,
+    fn_map_hash      _hash_fn,
+    fn_comparator    _compare_fn,
+    size_t           _capacity
+)
+{
+    struct d_map* new_map;
+    size_t        slots;
+
+    if ( (_key_type == D_MAP_KEY_CUSTOM) &&
+         ( (!_hash_fn) ||
+           (!_compare_fn) ) )
+    {
+        return NULL;
+    }
+
+    slots = d_internal_map_capacity_for(_capacity);
+
+    if (slots == 0)
+    {
+        return NULL;
+    }
+
+    new_map = malloc(sizeof(struct d_map));
+
+    if (!new_map)
+    {
+        return NULL;
+    }
+
+    if (!d_internal_map_table_init(&new_map->table, slots))
+    {
+        free(new_map);
+
+        return NULL;
+    }
+
+    new_map->old.slots    = NULL;
+    new_map->old.ctrl     = NULL;
+    new_map->old.capacity = 0;
+    new_map->old.count    = 0;
+    new_map->migrate_at   = 0;
+    new_map->key_type     = _key_type;
+    new_map->hash_fn      = (_key_type == D_MAP_KEY_CUSTOM) ? _hash_fn : NULL;
+    new_map->compare_fn   = (_key_type == D_MAP_KEY_CUSTOM) ? _compare_fn : NULL;
+
+    return new_map;
+}
+
+/*
+d_map_new_int
+  Allocates a new, empty map with `int` keys.
+
+Parameter(s):
+  none
+Return:
+  Either a pointer to a new, empty d_map, or NULL if allocation failed.
+*/
+struct d_map*
+d_map_new_int
+(
+    void
+)
+{
+    return d_map_new_with_capacity(D_MAP_KEY_INT, NULL, NULL, 0);
+}
+
+/*
+d_map_new_uint64
+  Allocates a new, empty map with `uint64_t` keys.
+
+Parameter(s):
+  none
+Return:
+  Either a pointer to a new, empty d_map, or NULL if allocation failed.
+*/
+struct d_map*
+d_map_new_uint64
+(
+    void
+)
+{
+    return d_map_new_with_capacity(D_MAP_KEY_UINT64, NULL, NULL, 0);
+}
+
+/*
+d_map_new_string
+  Allocates a new, empty map with NUL-terminated string keys.
+
+Parameter(s):
+  none
+Return:
+  Either a pointer to a new, empty d_map, or NULL if allocation failed.
+*/
+struct d_map*
+d_map_new_string
+(
+    void
+)
+{
+    return d_map_new_with_capacity(D_MAP_KEY_STRING, NULL, NULL, 0);
+}
+
+/*
+d_map_clear
+  Removes all entries from the map, keeping the live table's capacity.
+
+Parameter(s):
+  _map: the map to be cleared
+Return:
+  none
+*/
+void
+d_map_clear
+(
+    struct d_map* _map
+)
+{
+    if (!_map)
+    {
+        return;
+    }
+
+    d_internal_map_table_release(&_map->old);
+    _map->migrate_at = 0;
+
+    memset(_map->table.ctrl,
+           D_MAP_CTRL_EMPTY,
+           _map->table.capacity + D_MAP_GROUP_WIDTH - 1);
+    _map->table.count = 0;
+
+    return;
+}
+
+/*
+d_map_contains
+  Checks if the map contains the given key.
+
+Parameter(s):
+  _map: the map
+  _key: pointer to the key (see map.h)
+Return:
+  true if the key exists in the map, false otherwise.
+*/
+bool
+d_map_contains
+(
+    const struct d_map* _map,
+    const void*         _key
+)
+{
+    if ( (!_map) ||
+         (!_key) )
+    {
+        return false;
+    }
+
+    return (d_internal_map_get_key(_map, d_internal_map_make_key(_map, _key)) != NULL);
+}
+
+/*
+d_map_count
+  Returns the number of entries in the map.
+
+Parameter(s):
+  _map: the map
+Return:
+  The number of entries, or 0 if the map is NULL.
+*/
+size_t
+d_map_count
+(
+    const struct d_map* _map
+)
+{
+    if (!_map)
+    {
+        return 0;
+    }
+
+    return _map->table.count + _map->old.count;
+}
+
+/*
+d_map_get
+  Retrieves the value associated with a key.
+
+Parameter(s):
+  _map: the map
+  _key: pointer to the key (see map.h)
+Return:
+  The value associated with the key, or NULL if not found.
+*/
+void*
+d_map_get
+(
+    const struct d_map* _map,
+    const void*         _key
+)
+{
+    struct d_map_slot* slot;
+
+    if ( (!_map) ||
+         (!_key) )
+    {
+        return NULL;
+    }
+
+    slot = d_internal_map_get_key(_map, d_internal_map_make_key(_map, _key));
+
+    return (slot) ? slot->value : NULL;
+}
+
+/*
+d_map_merge
+  Inserts every entry of _source into _destination. Keys present in both
+maps are resolved by `_conflict`:
+    - D_MERGE_CONFLICT_FLAG_IGNORE    => _destination keeps its value
+    - D_MERGE_CONFLICT_FLAG_OVERWRITE => _source's value wins
+    - D_MERGE_CONFLICT_FLAG_KEEP_BOTH => a map holds one value per key, so
+      the merge fails and _destination is left unchanged
+  Only pointers are copied; replaced values are not freed.
+
+Parameter(s):
+  _destination: destination map to be modified
+  _source:      source map (not modified)
+  _conflict:    conflict policy when keys exist in both maps
+Return:
+  true if successful, false if the maps' key types differ, on a KEEP_BOTH
+  conflict or on allocation failure.
+*/
+bool
+d_map_merge
+(
+    struct d_map*           _destination,
+    const struct d_map*     _source,
+    enum DMergeConflictFlag _conflict
+)
+{
+    struct d_map_slot* existing;
+    union d_map_key    key;
+    size_t             cursor;
+    void*              value;
+
+    if ( (_destination == _source) ||
+         (!_source)                ||
+         (d_map_count(_source) == 0) )
+    {
+        return true;
+    }
+    else if ( (!_destination)                                 ||
+              (_destination->key_type   != _source->key_type) ||
+              (_destination->hash_fn    != _source->hash_fn)  ||
+              (_destination->compare_fn != _source->compare_fn) )
+    {
+        return false;
+    }
+
+    if (_conflict == D_MERGE_CONFLICT_FLAG_KEEP_BOTH)
+    {
+        cursor = 0;
+
+        while (d_map_next(_source, &cursor, &key, &value))
+        {
+            if (d_internal_map_get_key(_destination, key))
+            {
+                return false;
+            }
+        }
+    }
+
+    // sized up front so that no put below can fail halfway
+    if (!d_map_reserve(_destination,
+                       d_map_count(_destination) + d_map_count(_source)))
+    {
+        return false;
+    }
+
+    cursor = 0;
+
+    while (d_map_next(_source, &cursor, &key, &value))
+    {
+        existing = d_internal_map_get_key(_destination, key);
+
+        if (existing)
+        {
+            if (_conflict == D_MERGE_CONFLICT_FLAG_OVERWRITE)
+            {
+                existing->value = value;
+            }
+        }
+        else
+        {
+            d_internal_map_put_key(_destination, key, value);
+        }
+    }
+
+    return true;
+}
+
+/*
+d_map_put
+  Inserts or updates a key-value pair in the map.
+
+Parameter(s):
+  _map:   the map
+  _key:   pointer to the key (see map.h)
+  _value: the value to associate with the key
+Return:
+  true if successful, false otherwise.
+*/
+bool
+d_map_put
+(
+    struct d_map* _map,
+    const void*   _key,
+    void*         _value
+)
+{
+    if ( (!_map) ||
+         (!_key) )
+    {
+        return false;
+    }
+
+    return d_internal_map_put_key(_map, d_internal_map_make_key(_map, _key), _value);
+}
+
+/*
+d_map_remove
+  Removes the entry with the given key from the map.
+
+Parameter(s):
+  _map:       the map
+  _key:       pointer to the key (see map.h)
+  _out_value: if non-NULL, receives the removed value
+Return:
+  true if the entry was removed, false if not found or error.
+*/
+bool
+d_map_remove
+(
+    struct d_map* _map,
+    const void*   _key,
+    void**        _out_value
+)
+{
+    if ( (!_map) ||
+         (!_key) )
+    {
+        return false;
+    }
+
+    return d_internal_map_remove_key(_map, d_internal_map_make_key(_map, _key), _out_value);
+}
+
+/*
+d_map_reserve
+  Ensures the map holds `_count` entries without growing. Unlike ordinary
+growth this rehashes every entry at once, and finishes any migration in
+progress.
+
+Parameter(s):
+  _map:   the map
+  _count: the number of entries to make room for
+Return:
+  true if successful, false on allocation failure.
+*/
+bool
+d_map_reserve
+(
+    struct d_map* _map,
+    size_t        _count
+)
+{
+    size_t capacity;
+
+    if (!_map)
+    {
+        return false;
+    }
+
+    capacity = d_internal_map_capacity_for(_count);
+
+    if (capacity == 0)
+    {
+        return false;
+    }
+
+    if (capacity <= _map->table.capacity)
+    {
+        d_internal_map_migrate(_map, SIZE_MAX);
+
+        return true;
+    }
+
+    return d_internal_map_resize(_map, capacity);
+}
+
+/*
+d_map_contains_int
+  Checks if an `int`-keyed map contains the given key.
+
+Parameter(s):
+  _map: the map (D_MAP_KEY_INT)
+  _key: the key
+Return:
+  true if the key exists in the map, false otherwise.
+*/
+bool
+d_map_contains_int
+(
+    const struct d_map* _map,
+    int                 _key
+)
+{
+    union d_map_key key;
+
+    if ( (!_map) ||
+         (_map->key_type != D_MAP_KEY_INT) )
+    {
+        return false;
+    }
+
+    key.u64 = (uint64_t)(int64_t)_key;
+
+    return (d_internal_map_get_key(_map, key) != NULL);
+}
+
+/*
+d_map_get_int
+  Retrieves the value for a key of an `int`-keyed map.
+
+Parameter(s):
+  _map: the map (D_MAP_KEY_INT)
+  _key: the key
+Return:
+  The value associated with the key, or NULL if not found or the map has
+  another key type.
+*/
+void*
+d_map_get_int
+(
+    const struct d_map* _map,
+    int                 _key
+)
+{
+    struct d_map_slot* slot;
+    union d_map_key    key;
+
+    if ( (!_map) ||
+         (_map->key_type != D_MAP_KEY_INT) )
+    {
+        return NULL;
+    }
+
+    key.u64 = (uint64_t)(int64_t)_key;
+    slot    = d_internal_map_get_key(_map, key);
+
+    return (slot) ? slot->value : NULL;
+}
+
+/*
+d_map_put_int
+  Inserts or updates a key-value pair in an `int`-keyed map.
+
+Parameter(s):
+  _map:   the map (D_MAP_KEY_INT)
+  _key:   the key
+  _value: the value to associate with the key
+Return:
+  true if successful, false otherwise.
+*/
+bool
+d_map_put_int
+(
+    struct d_map* _map,
+    int           _key,
+    void*         _value
+)
+{
+    union d_map_key key;
+
+    if ( (!_map) ||
+         (_map->key_type != D_MAP_KEY_INT) )
+    {
+        return false;
+    }
+
+    key.u64 = (uint64_t)(int64_t)_key;
+
+    return d_internal_map_put_key(_map, key, _value);
+}
+
+/*
+d_map_remove_int
+  Removes a key from an `int`-keyed map.
+
+Parameter(s):
+  _map:       the map (D_MAP_KEY_INT)
+  _key:       the key
+  _out_value: if non-NULL, receives the removed value
+Return:
+  true if the entry was removed, false if not found or error.
+*/
+bool
+d_map_remove_int
+(
+    struct d_map* _map,
+    int           _key,
+    void**        _out_value
+)
+{
+    union d_map_key key;
+
+    if ( (!_map) ||
+         (_map->key_type != D_MAP_KEY_INT) )
+    {
+        return false;
+    }
+
+    key.u64 = (uint64_t)(int64_t)_key;
+
+    return d_internal_map_remove_key(_map, key, _out_value);
+}
+
+/*
+d_map_contains_uint64
+  Checks if a `uint64_t`-keyed map contains the given key.
+
+Parameter(s):
+  _map: the map (D_MAP_KEY_UINT64)
+  _key: the key
+Return:
+  true if the key exists in the map, false otherwise.
+*/
+bool
+d_map_contains_uint64
+(
+    const struct d_map* _map,
+    uint64_t            _key
+)
+{
+    union d_map_key key;
+
+    if ( (!_map) ||
+         (_map->key_type != D_MAP_KEY_UINT64) )
+    {
+        return false;
+    }
+
+    key.u64 = _key;
+
+    return (d_internal_map_get_key(_map, key) != NULL);
+}
+
+/*
+d_map_get_uint64
+  Retrieves the value for a key of a `uint64_t`-keyed map.
+
+Parameter(s):
+  _map: the map (D_MAP_KEY_UINT64)
+  _key: the key
+Return:
+  The value associated with the key, or NULL if not found or the map has
+  another key type.
+*/
+void*
+d_map_get_uint64
+(
+    const struct d_map* _map,
+    uint64_t            _key
+)
+{
+    struct d_map_slot* slot;
+    union d_map_key    key;
+
+    if ( (!_map) ||
+         (_map->key_type != D_MAP_KEY_UINT64) )
+    {
+        return NULL;
+    }
+
+    key.u64 = _key;
+    slot    = d_internal_map_get_key(_map, key);
+
+    return (slot) ? slot->value : NULL;
+}
+
+/*
+d_map_put_uint64
+  Inserts or updates a key-value pair in a `uint64_t`-keyed map.
+
+Parameter(s):
+  _map:   the map (D_MAP_KEY_UINT64)
+  _key:   the key
+  _value: the value to associate with the key
+Return:
+  true if successful, false otherwise.
+*/
+bool
+d_map_put_uint64
+(
+    struct d_map* _map,
+    uint64_t      _key,
+    void*         _value
+)
+{
+    union d_map_key key;
+
+    if ( (!_map) ||
+         (_map->key_type != D_MAP_KEY_UINT64) )
+    {
+        return false;
+    }
+
+    key.u64 = _key;
+
+    return d_internal_map_put_key(_map, key, _value);
+}
+
+/*
+d_map_remove_uint64
+  Removes a key from a `uint64_t`-keyed map.
+
+Parameter(s):
+  _map:       the map (D_MAP_KEY_UINT64)
+  _key:       the key
+  _out_value: if non-NULL, receives the removed value
+Return:
+  true if the entry was removed, false if not found or error.
+*/
+bool
+d_map_remove_uint64
+(
+    struct d_map* _map,
+    uint64_t      _key,
+    void**        _out_value
+)
+{
+    union d_map_key key;
+
+    if ( (!_map) ||
+         (_map->key_type != D_MAP_KEY_UINT64) )
+    {
+        return false;
+    }
+
+    key.u64 = _key;
+
+    return d_internal_map_remove_key(_map, key, _out_value);
+}
+
+/*
+d_map_next
+  Iterates over the map's entries in unspecified order. Start with
+`*_cursor` set to 0; the map must not be modified during iteration.
+
+Parameter(s):
+  _map:    the map
+  _cursor: iteration state, advanced past the returned entry
+  _key:    if non-NULL, receives the entry's key
+  _value:  if non-NULL, receives the entry's value
+Return:
+  true if an entry was returned, false once the iteration is complete.
+*/
+bool
+d_map_next
+(
+    const struct d_map* _map,
+    size_t*             _cursor,
+    union d_map_key*    _key,
+    void**              _value
+)
+{
+    const struct d_map_table* table;
+    size_t                    index;
+
+    if ( (!_map) ||
+         (!_cursor) )
+    {
+        return false;
+    }
+
+    // cursor positions cover the old table, then the live one
+    while (*_cursor < (_map->old.capacity + _map->table.capacity))
+    {
+        index = (*_cursor)++;
+        table = &_map->old;
+
+        if (index >= _map->old.capacity)
+        {
+            index -= _map->old.capacity;
+            table  = &_map->table;
+        }
+
+        if ((table->ctrl[index] & 0x80u) != 0)
+        {
+            if (_key)
+            {
+                *_key = table->slots[index].key;
+            }
+
+            if (_value)
+            {
+                *_value = table->slots[index].value;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+d_map_is_growing
+  Checks if the map is migrating entries into a larger table.
+
+Parameter(s):
+  _map: the map
+Return:
+  true if a migration is in progress, false otherwise.
+*/
+bool
+d_map_is_growing
+(
+    const struct d_map* _map
+)
+{
+    return (_map) && (_map->old.capacity > 0);
+}
+
+/*
+d_map_free
+  Frees the map. Keys and values are not freed.
+
+Parameter(s):
+  _map: the map to be freed
+Return:
+  none
+*/
+void
+d_map_free
+(
+    struct d_map* _map
+)
+{
+    if (!_map)
+    {
+        return;
+    }
+
+    d_internal_map_table_release(&_map->old);
+    d_internal_map_table_release(&_map->table);
+    free(_map);
+
+    return;
+}
+
+/*
+d_map_free_deep
+  Frees the map along with its keys and values.
+
+Parameter(s):
+  _map:        the map to be freed
+  _key_free:   if non-NULL, called on each string or custom key
+  _value_free: if non-NULL, called on each value
+Return:
+  none
+*/
+void
+d_map_free_deep
+(
+    struct d_map* _map,
+    fn_free       _key_free,
+    fn_free       _value_free
+)
+{
+    union d_map_key key;
+    size_t          cursor;
+    void*           value;
+    bool            pointer_keys;
+
+    if (!_map)
+    {
+        return;
+    }
+
+    pointer_keys = (_map->key_type == D_MAP_KEY_STRING) ||
+                   (_map->key_type == D_MAP_KEY_CUSTOM);
+    cursor       = 0;
+
+    while (d_map_next(_map, &cursor, &key, &value))
+    {
+        if ( (_key_free) &&
+             (pointer_keys) )
+        {
+            _key_free((void*)key.ptr);
+        }
+
+        if (_value_free)
+        {
+            _value_free(value);
+        }
+    }
+
+    d_map_free(_map);
 
-/** This module is left intentionally blank (for the time being). **/
\ No newline at end of file
+    return;
+}
@@ -163,6 +163,715 @@ d_internal_min_enum_map_grow
 }
 
 
+/*
+d_internal_min_enum_map_sort_entries
+  Stable bottom-up merge sort of entries by key, so that entries with equal
+keys keep their input order.
+
+Parameter(s):
+  _entries: entries to sort
+  _scratch: scratch array of at least `_count` entries
+  _count:   number of entries
+Return:
+  none
+*/
+static void
+d_internal_min_enum_map_sort_entries
+(
+    struct d_enum_map_entry* _entries,
+    struct d_enum_map_entry* _scratch,
+    size_t                   _count
+)
+{
+    struct d_enum_map_entry* from;
+    struct d_enum_map_entry* to;
+    struct d_enum_map_entry* swap;
+    struct d_enum_map_entry  entry;
+    size_t                   width;
+    size_t                   lo;
+    size_t                   mid;
+    size_t                   hi;
+    size_t                   i;
+    size_t                   j;
+    size_t                   out;
+
+    // insertion-sort runs of 16, then merge runs pairwise
+    for (lo = 0; lo < _count; lo += 16)
+    {
+        hi = (lo + 16 < _count) ? (lo + 16) : _count;
+
+        for (i = lo + 1; i < hi; ++i)
+        {
+            entry = _entries[i];
+
+            for (j = i; (j > lo) && (_entries[j - 1].key > entry.key); --j)
+            {
+                _entries[j] = _entries[j - 1];
+            }
+
+            _entries[j] = entry;
+        }
+    }
+
+    from = _entries;
+    to   = _scratch;
+
+    for (width = 16; width < _count; width *= 2)
+    {
+        for (lo = 0; lo < _count; lo += 2 * width)
+        {
+            mid = (lo + width < _count) ? (lo + width) : _count;
+            hi  = (mid + width < _count) ? (mid + width) : _count;
+            i   = lo;
+            j   = mid;
+
+            for (out = lo; out < hi; ++out)
+            {
+                // `<=` takes the left run first on ties: stable
+                if ( (i < mid) &&
+                     ( (j >= hi) ||
+                       (from[i].key <= from[j].key) ) )
+                {
+                    to[out] = from[i++];
+                }
+                else
+                {
+                    to[out] = from[j++];
+                }
+            }
+        }
+
+        swap = from;
+        from = to;
+        to   = swap;
+    }
+
+    if (from != _entries)
+    {
+        memcpy(_entries, from, _count * sizeof(struct d_enum_map_entry));
+    }
+
+    return;
+}
+
+/*
+d_internal_min_enum_map_dedup_entries
+  Collapses runs of equal keys in a stably sorted entry array.
+
+Parameter(s):
+  _entries:  sorted entries; compacted in place
+  _count:    number of entries
+  _conflict: IGNORE keeps each key's first entry, OVERWRITE its last;
+             KEEP_BOTH fails on any duplicate
+Return:
+  The number of entries kept, or SIZE_MAX on a KEEP_BOTH conflict.
+*/
+static size_t
+d_internal_min_enum_map_dedup_entries
+(
+    struct d_enum_map_entry* _entries,
+    size_t                   _count,
+    enum DMergeConflictFlag  _conflict
+)
+{
+    size_t out;
+    size_t i;
+
+    if (_count == 0)
+    {
+        return 0;
+    }
+
+    out = 0;
+
+    for (i = 1; i < _count; ++i)
+    {
+        if (_entries[i].key != _entries[out].key)
+        {
+            _entries[++out] = _entries[i];
+        }
+        else if (_conflict == D_MERGE_CONFLICT_FLAG_KEEP_BOTH)
+        {
+            return SIZE_MAX;
+        }
+        else if (_conflict == D_MERGE_CONFLICT_FLAG_OVERWRITE)
+        {
+            _entries[out].value = _entries[i].value;
+        }
+    }
+
+    return out + 1;
+}
+
+/*
+d_internal_min_enum_map_merge_entries
+  Merges sorted, unique entries into a sorted map in place. The merged size
+is counted first, the array grows only if its spare capacity is short, and
+the merge then runs backwards from the end so no entry is overwritten
+before it has been moved.
+
+Parameter(s):
+  _map:      pointer to a sorted enum map
+  _entries:  sorted entries with unique keys (not aliasing _map's)
+  _count:    number of entries
+  _conflict: policy for keys present in both
+Return:
+  true if successful, false on a KEEP_BOTH conflict or allocation failure
+  (the map is unchanged).
+*/
+static bool
+d_internal_min_enum_map_merge_entries
+(
+    struct d_min_enum_map*         _map,
+    const struct d_enum_map_entry* _entries,
+    size_t                         _count,
+    enum DMergeConflictFlag        _conflict
+)
+{
+    struct d_enum_map_entry* grown;
+    size_t                   duplicates;
+    size_t                   total;
+    size_t                   i;
+    size_t                   j;
+    size_t                   out;
+
+    // count keys present in both
+    duplicates = 0;
+    i          = 0;
+    j          = 0;
+
+    while ( (i < _map->count) &&
+            (j < _count) )
+    {
+        if (_map->entries[i].key < _entries[j].key)
+        {
+            i++;
+        }
+        else if (_entries[j].key < _map->entries[i].key)
+        {
+            j++;
+        }
+        else
+        {
+            duplicates++;
+            i++;
+            j++;
+        }
+    }
+
+    if ( (duplicates > 0) &&
+         (_conflict == D_MERGE_CONFLICT_FLAG_KEEP_BOTH) )
+    {
+        return false;
+    }
+
+    total = _map->count + _count - duplicates;
+
+    if (total > _map->capacity)
+    {
+        grown = realloc(_map->entries, total * sizeof(struct d_enum_map_entry));
+
+        if (!grown)
+        {
+            return false;
+        }
+
+        _map->entries  = grown;
+        _map->capacity = total;
+    }
+
+    // merge from the back; once `_entries` is used up the remaining map
+    // entries are already in place
+    i   = _map->count;
+    j   = _count;
+    out = total;
+
+    while (j > 0)
+    {
+        if ( (i > 0) &&
+             (_map->entries[i - 1].key > _entries[j - 1].key) )
+        {
+            _map->entries[--out] = _map->entries[--i];
+        }
+        else if ( (i > 0) &&
+                  (_map->entries[i - 1].key == _entries[j - 1].key) )
+        {
+            _map->entries[--out] = _map->entries[--i];
+            j--;
+
+            if (_conflict == D_MERGE_CONFLICT_FLAG_OVERWRITE)
+            {
+                _map->entries[out].value = _entries[j].value;
+            }
+        }
+        else
+        {
+            _map->entries[--out] = _entries[--j];
+        }
+    }
+
+    _map->count = total;
+
+    return true;
+}
+
+/*
+d_internal_min_enum_map_ctz64
+  Index of the lowest set bit of a non-zero bitmap word.
+
+Parameter(s):
+  _word: a non-zero word
+Return:
+  The number of trailing zero bits.
+*/
+static unsigned
+d_internal_min_enum_map_ctz64
+(
+    uint64_t _word
+)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(_word);
+#else
+    unsigned n = 0;
+
+    while ((_word & 1u) == 0)
+    {
+        _word >>= 1;
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+/*
+d_internal_min_enum_map_fits_dense
+  Checks if `_count` entries spread over `_span` keys are dense enough for
+the dense layout.
+
+Parameter(s):
+  _span:  number of keys in the window
+  _count: number of entries
+Return:
+  true if the dense layout fits, false if it would be too sparse.
+*/
+static bool
+d_internal_min_enum_map_fits_dense
+(
+    uint64_t _span,
+    size_t   _count
+)
+{
+    return (_span <= D_MIN_ENUM_MAP_DENSE_MIN_SPAN) ||
+           (_span <= (uint64_t)_count * D_MIN_ENUM_MAP_DENSE_MAX_RATIO);
+}
+
+/*
+d_internal_min_enum_map_dense_offset
+  Slot offset of a key in the dense window; a single unsigned compare
+against `span` bounds-checks it.
+
+Parameter(s):
+  _map: pointer to a dense enum map
+  _key: the key
+Return:
+  The key's offset from `min_key` (>= span if outside the window).
+*/
+D_INLINE size_t
+d_internal_min_enum_map_dense_offset
+(
+    const struct d_min_enum_map* _map,
+    int                          _key
+)
+{
+    return (size_t)((unsigned int)_key - (unsigned int)_map->min_key);
+}
+
+/*
+d_internal_min_enum_map_dense_has
+  Checks the presence bit of a slot.
+
+Parameter(s):
+  _map:    pointer to a dense enum map
+  _offset: slot offset (< span)
+Return:
+  true if the slot holds an entry.
+*/
+D_INLINE bool
+d_internal_min_enum_map_dense_has
+(
+    const struct d_min_enum_map* _map,
+    size_t                       _offset
+)
+{
+    return ((_map->present[_offset / 64] >> (_offset % 64)) & 1u) != 0;
+}
+
+/*
+d_internal_min_enum_map_relayout_dense
+  Moves every entry into a new dense window of `_span` slots starting at
+`_min_key`, from either layout. The window must cover every key.
+
+Parameter(s):
+  _map:     pointer to the enum map
+  _min_key: first key of the new window
+  _span:    slots in the new window
+Return:
+  true if successful, false if allocation failed (the map is unchanged).
+*/
+static bool
+d_internal_min_enum_map_relayout_dense
+(
+    struct d_min_enum_map* _map,
+    int                    _min_key,
+    size_t                 _span
+)
+{
+    void**    values;
+    uint64_t* present;
+    size_t    words;
+    size_t    offset;
+    size_t    shift;
+    size_t    i;
+    uint64_t  bits;
+
+    words  = (_span + 63) / 64;
+    values = malloc((_span * sizeof(void*)) + (words * sizeof(uint64_t)));
+
+    if (!values)
+    {
+        return false;
+    }
+
+    present = (uint64_t*)(values + _span);
+    memset(present, 0, words * sizeof(uint64_t));
+
+    if (_map->dense)
+    {
+        // the new window covers the old one, so slots only shift up
+        shift = (size_t)((unsigned int)_map->min_key - (unsigned int)_min_key);
+
+        for (i = 0; i < ((_map->span + 63) / 64); ++i)
+        {
+            for (bits = _map->present[i]; bits; bits &= bits - 1)
+            {
+                offset = (i * 64) + d_internal_min_enum_map_ctz64(bits);
+
+                values[offset + shift]          = _map->values[offset];
+                present[(offset + shift) / 64] |= (uint64_t)1 << ((offset + shift) % 64);
+            }
+        }
+
+        free(_map->values);
+    }
+    else
+    {
+        for (i = 0; i < _map->count; ++i)
+        {
+            offset = (size_t)((unsigned int)_map->entries[i].key - (unsigned int)_min_key);
+
+            values[offset]        = _map->entries[i].value;
+            present[offset / 64] |= (uint64_t)1 << (offset % 64);
+        }
+
+        free(_map->entries);
+
+        _map->entries  = NULL;
+        _map->capacity = 0;
+    }
+
+    _map->values  = values;
+    _map->present = present;
+    _map->min_key = _min_key;
+    _map->span    = _span;
+    _map->dense   = true;
+
+    return true;
+}
+
+/*
+d_internal_min_enum_map_dense_entries
+  Writes a dense map's entries, in ascending key order, to `_entries`.
+
+Parameter(s):
+  _map:     pointer to a dense enum map
+  _entries: destination array of at least `count` entries
+Return:
+  none
+*/
+static void
+d_internal_min_enum_map_dense_entries
+(
+    const struct d_min_enum_map* _map,
+    struct d_enum_map_entry*     _entries
+)
+{
+    size_t   out;
+    size_t   offset;
+    size_t   i;
+    uint64_t bits;
+
+    // ascending bit order is ascending key order
+    out = 0;
+
+    for (i = 0; i < ((_map->span + 63) / 64); ++i)
+    {
+        for (bits = _map->present[i]; bits; bits &= bits - 1)
+        {
+            offset = (i * 64) + d_internal_min_enum_map_ctz64(bits);
+
+            _entries[out].key   = (int)((unsigned int)_map->min_key + (unsigned int)offset);
+            _entries[out].value = _map->values[offset];
+            out++;
+        }
+    }
+
+    return;
+}
+
+/*
+d_internal_min_enum_map_relayout_sorted
+  Moves every entry of a dense map into a sorted entries array.
+
+Parameter(s):
+  _map:      pointer to a dense enum map
+  _capacity: capacity of the new array (>= count)
+Return:
+  true if successful, false if allocation failed (the map is unchanged).
+*/
+static bool
+d_internal_min_enum_map_relayout_sorted
+(
+    struct d_min_enum_map* _map,
+    size_t                 _capacity
+)
+{
+    struct d_enum_map_entry* entries;
+
+    if (_capacity < D_MIN_ENUM_MAP_DEFAULT_CAPACITY)
+    {
+        _capacity = D_MIN_ENUM_MAP_DEFAULT_CAPACITY;
+    }
+
+    entries = malloc(_capacity * sizeof(struct d_enum_map_entry));
+
+    if (!entries)
+    {
+        return false;
+    }
+
+    d_internal_min_enum_map_dense_entries(_map, entries);
+
+    free(_map->values);
+
+    _map->entries  = entries;
+    _map->capacity = _capacity;
+    _map->values   = NULL;
+    _map->present  = NULL;
+    _map->min_key  = 0;
+    _map->span     = 0;
+    _map->dense    = false;
+
+    return true;
+}
+
+/*
+d_internal_min_enum_map_dense_window
+  Computes the window a dense map needs to also hold `_key`: the current
+keys' window extended to `_key`, then doubled in the direction of growth so
+that runs of ascending (or descending) puts reallocate O(log n) times.
+
+Parameter(s):
+  _map:     pointer to the enum map (either layout)
+  _key:     the key to be covered
+  _min_key: receives the first key of the window
+  _span:    receives the window's slot count
+Return:
+  true if the window is dense enough for count + 1 entries, false if the
+  map should use the sorted layout.
+*/
+static bool
+d_internal_min_enum_map_dense_window
+(
+    const struct d_min_enum_map* _map,
+    int                          _key,
+    int*                         _min_key,
+    size_t*                      _span
+)
+{
+    int64_t lo;
+    int64_t hi;
+    int64_t grown;
+
+    if (_map->dense)
+    {
+        lo = _map->min_key;
+        hi = (int64_t)_map->min_key + (int64_t)_map->span - 1;
+    }
+    else if (_map->count > 0)
+    {
+        lo = _map->entries[0].key;
+        hi = _map->entries[_map->count - 1].key;
+    }
+    else
+    {
+        lo = _key;
+        hi = _key;
+    }
+
+    if (_key < lo)
+    {
+        lo = _key;
+    }
+
+    if (_key > hi)
+    {
+        hi = _key;
+    }
+
+    if (!d_internal_min_enum_map_fits_dense((uint64_t)(hi - lo + 1), _map->count + 1))
+    {
+        return false;
+    }
+
+    // room to grow, kept inside the int range
+    grown = (hi - lo + 1) * 2;
+
+    if (grown < D_MIN_ENUM_MAP_DEFAULT_CAPACITY)
+    {
+        grown = D_MIN_ENUM_MAP_DEFAULT_CAPACITY;
+    }
+
+    if ( (_map->dense) &&
+         (_key < _map->min_key) )
+    {
+        lo = hi - grown + 1;
+    }
+    else
+    {
+        hi = lo + grown - 1;
+    }
+
+    if (lo < INT_MIN)
+    {
+        lo = INT_MIN;
+    }
+
+    if (hi > INT_MAX)
+    {
+        hi = INT_MAX;
+    }
+
+    *_min_key = (int)lo;
+    *_span    = (size_t)(hi - lo + 1);
+
+    return true;
+}
+
+/*
+d_internal_min_enum_map_dense_put
+  Inserts or updates an entry of a dense map, widening the window as
+needed or falling back to the sorted layout when the keys get too sparse.
+
+Parameter(s):
+  _map:   pointer to a dense enum map
+  _key:   the key to insert/update
+  _value: the value to associate with the key
+  _done:  set to false if the map fell back to the sorted layout and the
+          caller must insert the entry
+Return:
+  true if successful, false if allocation failed.
+*/
+static bool
+d_internal_min_enum_map_dense_put
+(
+    struct d_min_enum_map* _map,
+    int                    _key,
+    void*                  _value,
+    bool*                  _done
+)
+{
+    size_t offset;
+    size_t span;
+    int    min_key;
+
+    *_done = true;
+    offset = d_internal_min_enum_map_dense_offset(_map, _key);
+
+    if (offset >= _map->span)
+    {
+        if (!d_internal_min_enum_map_dense_window(_map, _key, &min_key, &span))
+        {
+            // too sparse: hand the entry to the sorted layout
+            if (_map->mode == D_MIN_ENUM_MAP_MODE_DENSE)
+            {
+                _map->mode = D_MIN_ENUM_MAP_MODE_SORTED;
+            }
+
+            *_done = false;
+
+            return d_internal_min_enum_map_relayout_sorted(_map, (_map->count + 1) * 2);
+        }
+
+        if (!d_internal_min_enum_map_relayout_dense(_map, min_key, span))
+        {
+            return false;
+        }
+
+        offset = d_internal_min_enum_map_dense_offset(_map, _key);
+    }
+
+    if (!d_internal_min_enum_map_dense_has(_map, offset))
+    {
+        _map->present[offset / 64] |= (uint64_t)1 << (offset % 64);
+        _map->count++;
+    }
+
+    _map->values[offset] = _value;
+
+    return true;
+}
+
+/*
+d_internal_min_enum_map_promote
+  Switches an AUTO-mode sorted map to the dense layout if its keys, plus
+`_key` about to be inserted, are dense enough.
+
+Parameter(s):
+  _map: pointer to a sorted enum map
+  _key: key about to be inserted
+Return:
+  true if the map is now dense, false if it stays sorted.
+*/
+static bool
+d_internal_min_enum_map_promote
+(
+    struct d_min_enum_map* _map,
+    int                    _key
+)
+{
+    size_t span;
+    int    min_key;
+
+    if ( (_map->mode == D_MIN_ENUM_MAP_MODE_SORTED) ||
+         (!d_internal_min_enum_map_dense_window(_map, _key, &min_key, &span)) )
+    {
+        return false;
+    }
+
+    // only promote with room to spare, so one put cannot flip the layout
+    // back and forth
+    if ( (_map->count > 0) &&
+         (!d_internal_min_enum_map_fits_dense((uint64_t)span, _map->count + 1)) )
+    {
+        return false;
+    }
+
+    return d_internal_min_enum_map_relayout_dense(_map, min_key, span);
+}
+
+
 // =============================================================================
 // public functions
 // =============================================================================
@@ -181,6 +890,25 @@ d_min_enum_map_new
 (
     void
 )
+{
+    return d_min_enum_map_new_mode(D_MIN_ENUM_MAP_MODE_SORTED);
+}
+
+/*
+d_min_enum_map_new_mode
+  Allocates and initializes a new (empty) d_min_enum_map using the given
+layout mode.
+
+Parameter(s):
+  _mode: how the map chooses between the sorted and dense layouts
+Return:
+  Either a pointer to a new, empty d_min_enum_map, or NULL if allocation failed.
+*/
+struct d_min_enum_map*
+d_min_enum_map_new_mode
+(
+    enum DMinEnumMapMode _mode
+)
 {
     struct d_min_enum_map* new_map;
 
@@ -191,11 +919,168 @@ d_min_enum_map_new
         new_map->entries  = NULL;
         new_map->count    = 0;
         new_map->capacity = 0;
+        new_map->values   = NULL;
+        new_map->present  = NULL;
+        new_map->min_key  = 0;
+        new_map->span     = 0;
+        new_map->mode     = _mode;
+        new_map->dense    = false;
     }
 
     return new_map;
 }
 
+/*
+d_min_enum_map_new_dense
+  Allocates a new (empty) dense d_min_enum_map whose window already covers
+the keys `_min_key` through `_max_key` (e.g. the first and last values of an
+enum), so no put within that range reallocates.
+
+Parameter(s):
+  _min_key: smallest expected key
+  _max_key: largest expected key
+Return:
+  Either a pointer to a new, empty dense d_min_enum_map, or NULL if the
+  range is reversed or allocation failed.
+*/
+struct d_min_enum_map*
+d_min_enum_map_new_dense
+(
+    int _min_key,
+    int _max_key
+)
+{
+    struct d_min_enum_map* new_map;
+
+    if (_max_key < _min_key)
+    {
+        return NULL;
+    }
+
+    new_map = d_min_enum_map_new_mode(D_MIN_ENUM_MAP_MODE_DENSE);
+
+    if ( (new_map) &&
+         (!d_internal_min_enum_map_relayout_dense(
+              new_map,
+              _min_key,
+              (size_t)((int64_t)_max_key - (int64_t)_min_key + 1))) )
+    {
+        free(new_map);
+
+        return NULL;
+    }
+
+    return new_map;
+}
+
+/*
+d_min_enum_map_new_from_entries
+  Builds a sorted d_min_enum_map from an unsorted entry array in
+O(n log n): the entries are copied, sorted once (stably) and deduplicated,
+instead of being shifted into place by repeated puts.
+
+Parameter(s):
+  _entries:  entries in any order (not modified)
+  _count:    number of entries
+  _conflict: policy for repeated keys: IGNORE keeps the first occurrence,
+             OVERWRITE the last; KEEP_BOTH fails on any repeated key
+Return:
+  Either a pointer to a new d_min_enum_map, or NULL if `_entries` is NULL
+  with a non-zero count, on a KEEP_BOTH conflict or if allocation failed.
+*/
+struct d_min_enum_map*
+d_min_enum_map_new_from_entries
+(
+    const struct d_enum_map_entry* _entries,
+    size_t                         _count,
+    enum DMergeConflictFlag        _conflict
+)
+{
+    struct d_min_enum_map*   new_map;
+    struct d_enum_map_entry* scratch;
+    size_t                   unique;
+
+    if ( (!_entries) &&
+         (_count > 0) )
+    {
+        return NULL;
+    }
+
+    new_map = d_min_enum_map_new();
+
+    if ( (!new_map) ||
+         (_count == 0) )
+    {
+        return new_map;
+    }
+
+    new_map->entries = malloc(_count * sizeof(struct d_enum_map_entry));
+    scratch          = malloc(_count * sizeof(struct d_enum_map_entry));
+
+    if ( (!new_map->entries) ||
+         (!scratch) )
+    {
+        free(scratch);
+        d_min_enum_map_free(new_map);
+
+        return NULL;
+    }
+
+    memcpy(new_map->entries, _entries, _count * sizeof(struct d_enum_map_entry));
+    d_internal_min_enum_map_sort_entries(new_map->entries, scratch, _count);
+    free(scratch);
+
+    unique = d_internal_min_enum_map_dedup_entries(new_map->entries,
+                                                   _count,
+                                                   _conflict);
+
+    if (unique == SIZE_MAX)
+    {
+        d_min_enum_map_free(new_map);
+
+        return NULL;
+    }
+
+    new_map->count    = unique;
+    new_map->capacity = _count;
+
+    return new_map;
+}
+
+/*
+d_min_enum_map_new_from_sentinel
+  Builds a sorted d_min_enum_map from a static entry table terminated by
+D_ENUM_ENTRY_SENTINEL; see d_min_enum_map_new_from_entries.
+
+Parameter(s):
+  _entries:  sentinel-terminated entries in any order (not modified)
+  _conflict: policy for repeated keys
+Return:
+  Either a pointer to a new d_min_enum_map, or NULL if `_entries` is NULL,
+  on a KEEP_BOTH conflict or if allocation failed.
+*/
+struct d_min_enum_map*
+d_min_enum_map_new_from_sentinel
+(
+    const struct d_enum_map_entry* _entries,
+    enum DMergeConflictFlag        _conflict
+)
+{
+    size_t count;
+
+    if (!_entries)
+    {
+        return NULL;
+    }
+
+    for (count = 0; !D_ENUM_ENTRY_IS_SENTINEL(_entries[count]); ++count)
+    {
+        // count entries up to the sentinel
+    }
+
+    return d_min_enum_map_new_from_entries(_entries, count, _conflict);
+}
+
 /*
 d_min_enum_map_clear
   Removes all entries from the map.
@@ -214,6 +1099,11 @@ d_min_enum_map_clear
 {
     if (_map)
     {
+        if (_map->dense)
+        {
+            memset(_map->present, 0, ((_map->span + 63) / 64) * sizeof(uint64_t));
+        }
+
         _map->count = 0;
     }
 
@@ -224,7 +1114,6 @@ d_min_enum_map_clear
 d_min_enum_map_merge
   Merges all entries from _source into _destination.
 
-  Both maps are assumed to be sorted by key (an invariant of this module).
   Duplicate keys are resolved by _overwrite:
     - if _overwrite == true  => _source wins
     - if _overwrite == false => _destination wins
@@ -233,9 +1122,9 @@ d_min_enum_map_merge
   values. If you need that, add a callback-based variant.
 
 Parameter(s):
-  _destination:       destination map to be modified
-  _source:       source map (not modified)
-  _overwrite: conflict policy when keys exist in both maps
+  _destination: destination map to be modified
+  _source:      source map (not modified)
+  _overwrite:   conflict policy when keys exist in both maps
 Return:
   true if successful, false on allocation failure or invalid state.
 */
@@ -247,11 +1136,46 @@ d_min_enum_map_merge
     bool                         _overwrite
 )
 {
-    struct d_enum_map_entry* new_entries;
-    size_t dst_i;
-    size_t src_i;
-    size_t out_i;
-    size_t max_count;
+    return d_min_enum_map_merge_in_place(_destination,
+                                         _source,
+                                         (_overwrite)
+                                             ? D_MERGE_CONFLICT_FLAG_OVERWRITE
+                                             : D_MERGE_CONFLICT_FLAG_IGNORE);
+}
+
+/*
+d_min_enum_map_merge_in_place
+  Merges all entries from _source into _destination, in place: sorted
+entries are merged backwards from the end of _destination's array, which
+only grows (realloc) if its spare capacity is too small. Dense destinations
+take O(1) puts.
+
+  Duplicate keys are resolved by _conflict:
+    - D_MERGE_CONFLICT_FLAG_IGNORE    => _destination wins
+    - D_MERGE_CONFLICT_FLAG_OVERWRITE => _source wins
+    - D_MERGE_CONFLICT_FLAG_KEEP_BOTH => a map holds one value per key, so
+      the merge fails and _destination is left unchanged
+
+Parameter(s):
+  _destination: destination map to be modified
+  _source:      source map (not modified)
+  _conflict:    conflict policy when keys exist in both maps
+Return:
+  true if successful, false on a KEEP_BOTH conflict, allocation failure or
+  invalid state.
+*/
+bool
+d_min_enum_map_merge_in_place
+(
+    struct d_min_enum_map*       _destination,
+    const struct d_min_enum_map* _source,
+    enum DMergeConflictFlag      _conflict
+)
+{
+    struct d_enum_map_entry* source_entries;
+    size_t                   i;
+    int                      key;
+    bool                     merged;
 
     // if either of the following conditions is true: nothing to merge = done:
     // 1. both `_destination` and `_source` must point to different 
@@ -271,80 +1195,79 @@ d_min_enum_map_merge
     //    count.
     else if ( (!_destination) ||
               ( (_source->count > 0) && 
-                (!_source->entries) ) ||
+                (!_source->entries)  &&
+                (!_source->dense) ) ||
               ( (_destination->count > 0) && 
-                (!_destination->entries) ) ) 
+                (!_destination->entries)   &&
+                (!_destination->dense) ) ) 
     {
         return false;
     }
 
-    max_count = (_destination->count + _source->count);
-
-    new_entries = malloc(max_count * sizeof(struct d_enum_map_entry));
+    // dense source: merge from a sorted copy of its entries
+    source_entries = _source->entries;
 
-    if (!new_entries)
+    if (_source->dense)
     {
-        return false;
-    }
+        source_entries = malloc(_source->count * sizeof(struct d_enum_map_entry));
+
+        if (!source_entries)
+        {
+            return false;
+        }
 
-    dst_i = 0;
-    src_i = 0;
-    out_i = 0;
+        d_internal_min_enum_map_dense_entries(_source, source_entries);
+    }
 
-    while ( (dst_i < _destination->count) && 
-            (src_i < _source->count) )
+    if (_destination->dense)
     {
-        const int dst_key = _destination->entries[dst_i].key;
-        const int src_key = _source->entries[src_i].key;
+        merged = true;
 
-        if (dst_key < src_key)
-        {
-            new_entries[out_i++] = _destination->entries[dst_i++];
-        }
-        else if (src_key < dst_key)
+        // dense destination: O(1) lookups and puts, no shifting
+        for (i = 0; (merged) && (i < _source->count); ++i)
         {
-            new_entries[out_i++] = _source->entries[src_i++];
+            if ( (_conflict == D_MERGE_CONFLICT_FLAG_KEEP_BOTH) &&
+                 (d_min_enum_map_contains(_destination, source_entries[i].key)) )
+            {
+                merged = false;
+            }
         }
-        else
+
+        for (i = 0; (merged) && (i < _source->count); ++i)
         {
-            // same key: pick winner based on overwrite policy
-            new_entries[out_i].key = dst_key;
-            new_entries[out_i].value = _overwrite
-                ? _source->entries[src_i].value
-                : _destination->entries[dst_i].value;
-
-            out_i++;
-            dst_i++;
-            src_i++;
+            key = source_entries[i].key;
+
+            if ( (_conflict == D_MERGE_CONFLICT_FLAG_OVERWRITE) ||
+                 (!d_min_enum_map_contains(_destination, key)) )
+            {
+                merged = d_min_enum_map_put(_destination,
+                                            key,
+                                            source_entries[i].value);
+            }
         }
     }
-
-    // append remaining tails
-    while (dst_i < _destination->count)
+    else
     {
-        new_entries[out_i++] = _destination->entries[dst_i++];
+        merged = d_internal_min_enum_map_merge_entries(_destination,
+                                                       source_entries,
+                                                       _source->count,
+                                                       _conflict);
     }
 
-    while (src_i < _source->count)
+    if (source_entries != _source->entries)
     {
-        new_entries[out_i++] = _source->entries[src_i++];
+        free(source_entries);
     }
 
-    // commit (swap arrays)
-    free(_destination->entries);
-
-    _destination->entries  = new_entries;
-    _destination->count    = out_i;
-    _destination->capacity = max_count;
-
-    return true;
+    return merged;
 }
 
 /*
 d_min_enum_map_put
   Inserts or updates a key-value pair in the map.
   If the key already exists, the value is updated.
-  New entries are inserted in sorted order by key.
+  New entries are inserted in sorted order by key, or stored directly in
+  the dense window (see DMinEnumMapMode).
 
 Parameter(s):
   _map:   pointer to the enum map
@@ -363,12 +1286,29 @@ d_min_enum_map_put
 {
     ssize_t index;
     size_t  insert_pos;
+    bool    done;
 
     if (!_map)
     {
         return false;
     }
 
+    done = true;
+
+    if (_map->dense)
+    {
+        if (!d_internal_min_enum_map_dense_put(_map, _key, _value, &done))
+        {
+            return false;
+        }
+
+        // done unless the map just fell back to the sorted layout
+        if (done)
+        {
+            return true;
+        }
+    }
+
     // check if key already exists
     index = d_internal_min_enum_map_find_index(_map, _key);
 
@@ -380,6 +1320,15 @@ d_min_enum_map_put
         return true;
     }
 
+    // AUTO-mode maps whose keys became dense enough switch layouts (but not
+    // on the put that just made them fall back)
+    if ( (done)                                     &&
+         (_map->mode != D_MIN_ENUM_MAP_MODE_SORTED) &&
+         (d_internal_min_enum_map_promote(_map, _key)) )
+    {
+        return d_internal_min_enum_map_dense_put(_map, _key, _value, &done);
+    }
+
     // ensure capacity for new entry
     if (_map->count >= _map->capacity)
     {
@@ -427,6 +1376,18 @@ d_min_enum_map_get
 )
 {
     ssize_t index;
+    size_t  offset;
+
+    if ( (_map) &&
+         (_map->dense) )
+    {
+        offset = d_internal_min_enum_map_dense_offset(_map, _key);
+
+        return ( (offset < _map->span) &&
+                 (d_internal_min_enum_map_dense_has(_map, offset)) )
+            ? _map->values[offset]
+            : NULL;
+    }
 
     index = d_internal_min_enum_map_find_index(_map, _key);
 
@@ -456,12 +1417,29 @@ d_min_enum_map_remove
 )
 {
     ssize_t index;
+    size_t  offset;
 
     if (!_map)
     {
         return false;
     }
 
+    if (_map->dense)
+    {
+        offset = d_internal_min_enum_map_dense_offset(_map, _key);
+
+        if ( (offset >= _map->span) ||
+             (!d_internal_min_enum_map_dense_has(_map, offset)) )
+        {
+            return false;
+        }
+
+        _map->present[offset / 64] &= ~((uint64_t)1 << (offset % 64));
+        _map->count--;
+
+        return true;
+    }
+
     index = d_internal_min_enum_map_find_index(_map, _key);
 
     if (index < 0)
@@ -501,6 +1479,17 @@ d_min_enum_map_contains
     int                          _key
 )
 {
+    size_t offset;
+
+    if ( (_map) &&
+         (_map->dense) )
+    {
+        offset = d_internal_min_enum_map_dense_offset(_map, _key);
+
+        return ( (offset < _map->span) &&
+                 (d_internal_min_enum_map_dense_has(_map, offset)) );
+    }
+
     return (d_internal_min_enum_map_find_index(_map, _key) >= 0);
 }
 
@@ -522,6 +1511,24 @@ d_min_enum_map_count
     return (_map) ? _map->count : 0;
 }
 
+/*
+d_min_enum_map_is_dense
+  Checks if the map currently uses the dense (direct-indexed) layout.
+
+Parameter(s):
+  _map: pointer to the enum map
+Return:
+  true if the map is dense, false if it is sorted or NULL.
+*/
+bool
+d_min_enum_map_is_dense
+(
+    const struct d_min_enum_map* _map
+)
+{
+    return (_map) && (_map->dense);
+}
+
 /*
 d_min_enum_map_free
   Frees the space allocated to the d_min_enum_map and its entries array.
@@ -540,6 +1547,7 @@ d_min_enum_map_free
     if (_map)
     {
         free(_map->entries);
+        free(_map->values);
         free(_map);
     }
 
@@ -1,10 +1,12 @@
 #include "..\..\..\inc\container\node\linked_node.h"
+#include "..\..\..\inc\container\node\linked_node_pool.h"
 
 
 /*
 d_linked_node_new
   Allocates and initializes a new `d_linked_node`, a node with a value and a
-pointer to the next node.
+pointer to the next node. Nodes come from the node pool (linked_node_pool.h)
+unless D_LINKED_NODE_POOL_ENABLED is 0.
 
 Parameter(s):
   _value:      the value held by this node
@@ -20,7 +22,11 @@ d_linked_node_new
 	struct d_linked_node* _next_node
 )
 {
+#if D_LINKED_NODE_POOL_ENABLED
+	struct d_linked_node* new_node = d_linked_node_pool_acquire();
+#else
 	struct d_linked_node* new_node = malloc(sizeof(struct d_linked_node));
+#endif
 
 	if (new_node)
 	{
@@ -48,8 +54,47 @@ d_linked_node_free
 {
 	if (_node)
 	{
+#if D_LINKED_NODE_POOL_ENABLED
+		d_linked_node_pool_release(_node);
+#else
 		free(_node);
+#endif
 	}
 
+	return;
+}
+
+/*
+d_linked_node_free_chain
+  Frees every node in a `next`-linked chain, starting at `_top`. With the
+node pool enabled the whole chain is returned under one lock. Node values
+are not freed.
+
+Parameter(s):
+  _top: the first node of the chain; may be NULL.
+Return:
+  none
+*/
+void
+d_linked_node_free_chain
+(
+	struct d_linked_node* _top
+)
+{
+#if D_LINKED_NODE_POOL_ENABLED
+	d_linked_node_pool_release_chain(_top);
+#else
+	struct d_linked_node* next;
+
+	while (_top)
+	{
+		next = _top->next;
+
+		free(_top);
+
+		_top = next;
+	}
+#endif
+
 	return;
 }
\ No newline at end of file
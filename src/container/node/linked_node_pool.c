@@ -0,0 +1,1004 @@
+/******************************************************************************
+* djinterp [container]                                      linked_node_pool.c
+*
+*   Slab allocator for `d_linked_node`.
+*
+*
+* path:      \src\container\node\linked_node_pool.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include <stdint.h>
+#include "..\..\..\inc\container\node\linked_node_pool.h"
+
+#if defined(_WIN32)
+    #include <malloc.h>
+#endif
+
+#if D_LINKED_NODE_POOL_THREAD_SAFE
+    #include <stdatomic.h>
+#endif
+
+#if ((D_LINKED_NODE_POOL_SLAB_BYTES) & ((D_LINKED_NODE_POOL_SLAB_BYTES) - 1)) != 0
+    #error "D_LINKED_NODE_POOL_SLAB_BYTES must be a power of two"
+#endif
+
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    #if (!D_LINKED_NODE_POOL_THREAD_SAFE) || defined(__STDC_NO_THREADS__)
+        #error "D_LINKED_NODE_POOL_THREAD_CACHE needs C11 atomics and <threads.h>"
+    #endif
+
+    #include <threads.h>
+#endif
+
+
+// d_internal_linked_node_slab
+//   struct: bookkeeping at the start of each slab; its nodes follow at
+// D_LINKED_NODE_POOL_SLAB_HEADER bytes.
+struct d_internal_linked_node_slab
+{
+    struct d_internal_linked_node_slab* prev;       // neighbours in the
+    struct d_internal_linked_node_slab* next;       // pool's slab list
+    struct d_linked_node*               free_list;  // this slab's free nodes
+    size_t                              available;  // nodes on free_list
+};
+
+// the bookkeeping must fit in the slab's reserved header
+typedef char d_internal_linked_node_slab_header_fits[
+    (sizeof(struct d_internal_linked_node_slab) <=
+     D_LINKED_NODE_POOL_SLAB_HEADER) ? 1 : -1];
+
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    // d_internal_linked_node_cache
+    //   struct: a thread's private stack of free nodes. `count` is atomic
+    // only so d_linked_node_pool_get_stats can read it from other threads.
+    struct d_internal_linked_node_cache
+    {
+        struct d_linked_node*                top;
+        atomic_size_t                        count;
+        bool                                 registered;
+        struct d_internal_linked_node_cache* prev;
+        struct d_internal_linked_node_cache* next;
+    };
+
+    static _Thread_local struct d_internal_linked_node_cache d_internal_node_cache;
+
+    static tss_t     d_internal_node_cache_key;
+    static bool      d_internal_node_cache_key_ok = false;
+    static once_flag d_internal_node_cache_once   = ONCE_FLAG_INIT;
+#endif
+
+// d_internal_linked_node_pool
+//   struct: the process-wide shared pool. Slabs with free nodes precede
+// full slabs in the slab list, so the head is the slab to allocate from.
+struct d_internal_linked_node_pool
+{
+    struct d_internal_linked_node_slab*  head;
+    struct d_internal_linked_node_slab*  tail;
+    size_t                               slab_count;
+    size_t                               available;
+    size_t                               reserve;
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    struct d_internal_linked_node_cache* caches;
+#endif
+};
+
+static struct d_internal_linked_node_pool d_internal_node_pool;
+
+#if D_LINKED_NODE_POOL_THREAD_SAFE
+    static atomic_flag d_internal_node_pool_lock = ATOMIC_FLAG_INIT;
+#endif
+
+
+// ============================================================================
+// internal helper functions
+// ============================================================================
+
+D_INLINE void
+d_internal_linked_node_pool_lock
+(
+    void
+)
+{
+#if D_LINKED_NODE_POOL_THREAD_SAFE
+    while (atomic_flag_test_and_set_explicit(&d_internal_node_pool_lock,
+                                             memory_order_acquire))
+    {
+        // spin; critical sections are a handful of pointer updates
+    }
+#endif
+
+    return;
+}
+
+D_INLINE void
+d_internal_linked_node_pool_unlock
+(
+    void
+)
+{
+#if D_LINKED_NODE_POOL_THREAD_SAFE
+    atomic_flag_clear_explicit(&d_internal_node_pool_lock,
+                               memory_order_release);
+#endif
+
+    return;
+}
+
+// d_internal_linked_node_slab_of
+//   the slab a pooled node was carved from; slabs are aligned to their size.
+D_INLINE struct d_internal_linked_node_slab*
+d_internal_linked_node_slab_of
+(
+    const struct d_linked_node* _node
+)
+{
+    return (struct d_internal_linked_node_slab*)
+        ((uintptr_t)_node & ~(uintptr_t)(D_LINKED_NODE_POOL_SLAB_BYTES - 1));
+}
+
+/*
+d_internal_linked_node_slab_new
+  Allocates a size-aligned slab and threads all of its nodes onto the slab's
+free list. Called outside the lock.
+
+Parameter(s):
+  none
+Return:
+  The new slab, or NULL if the allocation failed.
+*/
+static struct d_internal_linked_node_slab*
+d_internal_linked_node_slab_new
+(
+    void
+)
+{
+    struct d_internal_linked_node_slab* slab;
+    struct d_linked_node*               nodes;
+    size_t                              i;
+
+#if defined(_WIN32)
+    slab = _aligned_malloc(D_LINKED_NODE_POOL_SLAB_BYTES,
+                           D_LINKED_NODE_POOL_SLAB_BYTES);
+#else
+    slab = aligned_alloc(D_LINKED_NODE_POOL_SLAB_BYTES,
+                         D_LINKED_NODE_POOL_SLAB_BYTES);
+#endif
+
+    if (!slab)
+    {
+        return NULL;
+    }
+
+    nodes = (struct d_linked_node*)((char*)slab +
+                                    D_LINKED_NODE_POOL_SLAB_HEADER);
+
+    for (i = 0; i + 1 < D_LINKED_NODE_POOL_SLAB_NODES; ++i)
+    {
+        nodes[i].value = NULL;
+        nodes[i].next  = &nodes[i + 1];
+    }
+
+    nodes[i].value = NULL;
+    nodes[i].next  = NULL;
+
+    slab->prev      = NULL;
+    slab->next      = NULL;
+    slab->free_list = &nodes[0];
+    slab->available = D_LINKED_NODE_POOL_SLAB_NODES;
+
+    return slab;
+}
+
+// d_internal_linked_node_slab_free
+//   returns a slab to the system.
+static void
+d_internal_linked_node_slab_free
+(
+    struct d_internal_linked_node_slab* _slab
+)
+{
+#if defined(_WIN32)
+    _aligned_free(_slab);
+#else
+    free(_slab);
+#endif
+
+    return;
+}
+
+// d_internal_linked_node_pool_unlink
+//   removes a slab from the slab list. The caller holds the lock.
+static void
+d_internal_linked_node_pool_unlink
+(
+    struct d_internal_linked_node_slab* _slab
+)
+{
+    if (_slab->prev)
+    {
+        _slab->prev->next = _slab->next;
+    }
+    else
+    {
+        d_internal_node_pool.head = _slab->next;
+    }
+
+    if (_slab->next)
+    {
+        _slab->next->prev = _slab->prev;
+    }
+    else
+    {
+        d_internal_node_pool.tail = _slab->prev;
+    }
+
+    _slab->prev = NULL;
+    _slab->next = NULL;
+
+    return;
+}
+
+// d_internal_linked_node_pool_push_front
+//   links a slab with free nodes in at the head. The caller holds the lock.
+static void
+d_internal_linked_node_pool_push_front
+(
+    struct d_internal_linked_node_slab* _slab
+)
+{
+    _slab->prev = NULL;
+    _slab->next = d_internal_node_pool.head;
+
+    if (d_internal_node_pool.head)
+    {
+        d_internal_node_pool.head->prev = _slab;
+    }
+    else
+    {
+        d_internal_node_pool.tail = _slab;
+    }
+
+    d_internal_node_pool.head = _slab;
+
+    return;
+}
+
+// d_internal_linked_node_pool_push_back
+//   links a full slab in at the tail. The caller holds the lock.
+static void
+d_internal_linked_node_pool_push_back
+(
+    struct d_internal_linked_node_slab* _slab
+)
+{
+    _slab->next = NULL;
+    _slab->prev = d_internal_node_pool.tail;
+
+    if (d_internal_node_pool.tail)
+    {
+        d_internal_node_pool.tail->next = _slab;
+    }
+    else
+    {
+        d_internal_node_pool.head = _slab;
+    }
+
+    d_internal_node_pool.tail = _slab;
+
+    return;
+}
+
+// d_internal_linked_node_pool_add_slab
+//   adds a fresh slab to the pool. The caller holds the lock.
+static void
+d_internal_linked_node_pool_add_slab
+(
+    struct d_internal_linked_node_slab* _slab
+)
+{
+    d_internal_linked_node_pool_push_front(_slab);
+
+    d_internal_node_pool.available += _slab->available;
+
+    ++d_internal_node_pool.slab_count;
+
+    return;
+}
+
+/*
+d_internal_linked_node_pool_put
+  Returns one node to its slab. A slab that becomes fully free is unlinked
+and pushed onto `_idle` when the pool would still hold at least one slab's
+worth of free nodes (and no fewer than the reserve) without it; the caller
+frees those slabs after dropping the lock. The caller holds the lock.
+
+Parameter(s):
+  _node: the node being returned.
+  _idle: list of slabs to free, chained through `next`.
+Return:
+  none
+*/
+static void
+d_internal_linked_node_pool_put
+(
+    struct d_linked_node*                _node,
+    struct d_internal_linked_node_slab** _idle
+)
+{
+    struct d_internal_linked_node_slab* slab;
+    size_t                              keep;
+
+    slab = d_internal_linked_node_slab_of(_node);
+
+    // a full slab sits behind the slabs with free nodes; bring it forward
+    if (slab->available == 0)
+    {
+        d_internal_linked_node_pool_unlink(slab);
+        d_internal_linked_node_pool_push_front(slab);
+    }
+
+    _node->next     = slab->free_list;
+    slab->free_list = _node;
+
+    ++slab->available;
+    ++d_internal_node_pool.available;
+
+    if (slab->available < D_LINKED_NODE_POOL_SLAB_NODES)
+    {
+        return;
+    }
+
+    // keep one idle slab's worth of nodes so a push/pop loop straddling a
+    // slab boundary does not allocate and free a slab every iteration
+    keep = d_internal_node_pool.reserve;
+
+    if (keep < D_LINKED_NODE_POOL_SLAB_NODES)
+    {
+        keep = D_LINKED_NODE_POOL_SLAB_NODES;
+    }
+
+    if (d_internal_node_pool.available - D_LINKED_NODE_POOL_SLAB_NODES < keep)
+    {
+        return;
+    }
+
+    d_internal_linked_node_pool_unlink(slab);
+
+    d_internal_node_pool.available -= D_LINKED_NODE_POOL_SLAB_NODES;
+
+    --d_internal_node_pool.slab_count;
+
+    slab->next = *_idle;
+    *_idle     = slab;
+
+    return;
+}
+
+// d_internal_linked_node_pool_free_idle
+//   frees a list of slabs produced by d_internal_linked_node_pool_put.
+static void
+d_internal_linked_node_pool_free_idle
+(
+    struct d_internal_linked_node_slab* _idle
+)
+{
+    struct d_internal_linked_node_slab* next;
+
+    while (_idle)
+    {
+        next = _idle->next;
+
+        d_internal_linked_node_slab_free(_idle);
+
+        _idle = next;
+    }
+
+    return;
+}
+
+/*
+d_internal_linked_node_pool_take
+  Detaches up to `_want` nodes from the pool as a NULL-terminated chain,
+allocating a slab (outside the lock) if no slab has a free node.
+
+Parameter(s):
+  _want:  the most nodes to take; at least 1.
+  _taken: receives the number of nodes in the returned chain.
+Return:
+  The chain's first node, or NULL if a slab could not be allocated.
+*/
+static struct d_linked_node*
+d_internal_linked_node_pool_take
+(
+    size_t  _want,
+    size_t* _taken
+)
+{
+    struct d_internal_linked_node_slab* slab;
+    struct d_internal_linked_node_slab* fresh;
+    struct d_linked_node*               top;
+    struct d_linked_node*               node;
+    size_t                              count;
+
+    fresh = NULL;
+
+    for (;;)
+    {
+        d_internal_linked_node_pool_lock();
+
+        if (fresh)
+        {
+            d_internal_linked_node_pool_add_slab(fresh);
+
+            fresh = NULL;
+        }
+
+        if (d_internal_node_pool.available > 0)
+        {
+            top   = NULL;
+            count = 0;
+
+            // slabs with free nodes lead the list, so the head always has one
+            while ( (count < _want) &&
+                    (d_internal_node_pool.available > 0) )
+            {
+                slab            = d_internal_node_pool.head;
+                node            = slab->free_list;
+                slab->free_list = node->next;
+
+                --slab->available;
+                --d_internal_node_pool.available;
+
+                if (slab->available == 0)
+                {
+                    d_internal_linked_node_pool_unlink(slab);
+                    d_internal_linked_node_pool_push_back(slab);
+                }
+
+                node->next = top;
+                top        = node;
+
+                ++count;
+            }
+
+            d_internal_linked_node_pool_unlock();
+
+            *_taken = count;
+
+            return top;
+        }
+
+        d_internal_linked_node_pool_unlock();
+
+        fresh = d_internal_linked_node_slab_new();
+
+        if (!fresh)
+        {
+            *_taken = 0;
+
+            return NULL;
+        }
+    }
+}
+
+/*
+d_internal_linked_node_pool_give
+  Returns a NULL-terminated chain of nodes to their slabs under one lock and
+frees any slabs that became idle.
+
+Parameter(s):
+  _top: first node of the chain; NULL is ignored.
+Return:
+  none
+*/
+static void
+d_internal_linked_node_pool_give
+(
+    struct d_linked_node* _top
+)
+{
+    struct d_internal_linked_node_slab* idle;
+    struct d_linked_node*               next;
+
+    if (!_top)
+    {
+        return;
+    }
+
+    idle = NULL;
+
+    d_internal_linked_node_pool_lock();
+
+    while (_top)
+    {
+        next = _top->next;
+
+        d_internal_linked_node_pool_put(_top, &idle);
+
+        _top = next;
+    }
+
+    d_internal_linked_node_pool_unlock();
+
+    d_internal_linked_node_pool_free_idle(idle);
+
+    return;
+}
+
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+
+/*
+d_internal_linked_node_cache_flush
+  Empties a thread cache back into the pool.
+
+Parameter(s):
+  _cache: the calling thread's cache.
+Return:
+  none
+*/
+static void
+d_internal_linked_node_cache_flush
+(
+    struct d_internal_linked_node_cache* _cache
+)
+{
+    struct d_linked_node* top;
+
+    top = _cache->top;
+
+    _cache->top = NULL;
+    atomic_store_explicit(&_cache->count, 0, memory_order_relaxed);
+
+    d_internal_linked_node_pool_give(top);
+
+    return;
+}
+
+// d_internal_linked_node_cache_exit
+//   thread-exit hook: returns the exiting thread's cache to the pool and
+// stops counting it in the stats.
+static void
+d_internal_linked_node_cache_exit
+(
+    void* _cache
+)
+{
+    struct d_internal_linked_node_cache* cache;
+
+    cache = (struct d_internal_linked_node_cache*)_cache;
+
+    d_internal_linked_node_cache_flush(cache);
+
+    d_internal_linked_node_pool_lock();
+
+    if (cache->prev)
+    {
+        cache->prev->next = cache->next;
+    }
+    else
+    {
+        d_internal_node_pool.caches = cache->next;
+    }
+
+    if (cache->next)
+    {
+        cache->next->prev = cache->prev;
+    }
+
+    d_internal_linked_node_pool_unlock();
+
+    cache->registered = false;
+
+    return;
+}
+
+// d_internal_linked_node_cache_key_init
+//   creates the thread-specific key whose destructor runs the exit hook.
+static void
+d_internal_linked_node_cache_key_init
+(
+    void
+)
+{
+    d_internal_node_cache_key_ok =
+        (tss_create(&d_internal_node_cache_key,
+                    d_internal_linked_node_cache_exit) == thrd_success);
+
+    return;
+}
+
+/*
+d_internal_linked_node_cache_register
+  Arms the thread-exit hook for the calling thread's cache and lists the
+cache so the stats can count its nodes. Runs on the thread's first acquire
+or release.
+
+Parameter(s):
+  _cache: the calling thread's cache.
+Return:
+  none
+*/
+static void
+d_internal_linked_node_cache_register
+(
+    struct d_internal_linked_node_cache* _cache
+)
+{
+    call_once(&d_internal_node_cache_once,
+              d_internal_linked_node_cache_key_init);
+
+    _cache->registered = true;
+
+    // without the hook the cache could outlive its listing; leave it out of
+    // the stats (its nodes count as in use) rather than list a dead thread
+    if ( (!d_internal_node_cache_key_ok) ||
+         (tss_set(d_internal_node_cache_key, _cache) != thrd_success) )
+    {
+        return;
+    }
+
+    d_internal_linked_node_pool_lock();
+
+    _cache->prev = NULL;
+    _cache->next = d_internal_node_pool.caches;
+
+    if (d_internal_node_pool.caches)
+    {
+        d_internal_node_pool.caches->prev = _cache;
+    }
+
+    d_internal_node_pool.caches = _cache;
+
+    d_internal_linked_node_pool_unlock();
+
+    return;
+}
+
+#endif  // D_LINKED_NODE_POOL_THREAD_CACHE
+
+
+// ============================================================================
+// public functions
+// ============================================================================
+
+/*
+d_linked_node_pool_acquire
+  Hands out one node. The node's fields are unspecified; the caller
+initializes them.
+
+Parameter(s):
+  none
+Return:
+  A node, or NULL if no slab had a free node and a new slab could not be
+allocated.
+*/
+struct d_linked_node*
+d_linked_node_pool_acquire
+(
+    void
+)
+{
+    size_t                               taken;
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    struct d_internal_linked_node_cache* cache;
+    struct d_linked_node*                node;
+    size_t                               count;
+
+    cache = &d_internal_node_cache;
+    node  = cache->top;
+
+    if (node)
+    {
+        count = atomic_load_explicit(&cache->count, memory_order_relaxed);
+
+        cache->top = node->next;
+        atomic_store_explicit(&cache->count, count - 1, memory_order_relaxed);
+
+        return node;
+    }
+
+    if (!cache->registered)
+    {
+        d_internal_linked_node_cache_register(cache);
+    }
+
+    // refill half the cache in one trip to the shared pool
+    node = d_internal_linked_node_pool_take(D_LINKED_NODE_POOL_CACHE_NODES / 2,
+                                            &taken);
+
+    if (node)
+    {
+        cache->top = node->next;
+        atomic_store_explicit(&cache->count, taken - 1, memory_order_relaxed);
+    }
+
+    return node;
+#else
+    return d_internal_linked_node_pool_take(1, &taken);
+#endif
+}
+
+/*
+d_linked_node_pool_release
+  Returns one node to the pool (or to this thread's cache). NULL is ignored.
+
+Parameter(s):
+  _node: a node obtained from d_linked_node_pool_acquire.
+Return:
+  none
+*/
+void
+d_linked_node_pool_release
+(
+    struct d_linked_node* _node
+)
+{
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    struct d_internal_linked_node_cache* cache;
+    struct d_linked_node*                tail;
+    size_t                               count;
+    size_t                               i;
+#endif
+
+    if (!_node)
+    {
+        return;
+    }
+
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    cache = &d_internal_node_cache;
+
+    // a thread that only frees nodes still needs its cache returned at exit
+    if (!cache->registered)
+    {
+        d_internal_linked_node_cache_register(cache);
+    }
+
+    count = atomic_load_explicit(&cache->count, memory_order_relaxed) + 1;
+
+    _node->next = cache->top;
+    cache->top  = _node;
+
+    if (count < D_LINKED_NODE_POOL_CACHE_NODES)
+    {
+        atomic_store_explicit(&cache->count, count, memory_order_relaxed);
+
+        return;
+    }
+
+    // full: hand the newest half back to the shared pool in one trip
+    tail = _node;
+
+    for (i = 1; i < D_LINKED_NODE_POOL_CACHE_NODES / 2; ++i)
+    {
+        tail = tail->next;
+    }
+
+    cache->top = tail->next;
+    tail->next = NULL;
+
+    atomic_store_explicit(&cache->count,
+                          count - D_LINKED_NODE_POOL_CACHE_NODES / 2,
+                          memory_order_relaxed);
+
+    d_internal_linked_node_pool_give(_node);
+#else
+    _node->next = NULL;
+
+    d_internal_linked_node_pool_give(_node);
+#endif
+
+    return;
+}
+
+/*
+d_linked_node_pool_release_chain
+  Returns an entire `next`-linked chain of nodes to the pool under a single
+lock acquisition. Values are not touched.
+
+Parameter(s):
+  _top: first node of the chain; NULL is ignored.
+Return:
+  none
+*/
+void
+d_linked_node_pool_release_chain
+(
+    struct d_linked_node* _top
+)
+{
+    d_internal_linked_node_pool_give(_top);
+
+    return;
+}
+
+/*
+d_linked_node_pool_reserve
+  Allocates slabs until the pool holds at least `_nodes` free nodes, and
+keeps that many free nodes from being returned to the system until
+d_linked_node_pool_trim.
+
+Parameter(s):
+  _nodes: the number of nodes that should be available.
+Return:
+  A boolean value corresponding to either:
+  - true, if that many nodes are available, or
+  - false, if a slab allocation failed.
+*/
+bool
+d_linked_node_pool_reserve
+(
+    size_t _nodes
+)
+{
+    struct d_internal_linked_node_slab* slab;
+    size_t                              available;
+
+    for (;;)
+    {
+        d_internal_linked_node_pool_lock();
+
+        if (d_internal_node_pool.reserve < _nodes)
+        {
+            d_internal_node_pool.reserve = _nodes;
+        }
+
+        available = d_internal_node_pool.available;
+
+        d_internal_linked_node_pool_unlock();
+
+        if (available >= _nodes)
+        {
+            return true;
+        }
+
+        slab = d_internal_linked_node_slab_new();
+
+        if (!slab)
+        {
+            return false;
+        }
+
+        d_internal_linked_node_pool_lock();
+        d_internal_linked_node_pool_add_slab(slab);
+        d_internal_linked_node_pool_unlock();
+    }
+}
+
+/*
+d_linked_node_pool_trim
+  Frees every slab with no node in use and clears the reserve. The calling
+thread's cache is flushed first; nodes in other threads' caches keep their
+slabs alive until those threads flush or exit.
+
+Parameter(s):
+  none
+Return:
+  A boolean value corresponding to either:
+  - true, if no slabs remain allocated, or
+  - false, if nodes are still held by callers or thread caches.
+*/
+bool
+d_linked_node_pool_trim
+(
+    void
+)
+{
+    struct d_internal_linked_node_slab* slab;
+    struct d_internal_linked_node_slab* next;
+    struct d_internal_linked_node_slab* idle;
+    bool                                empty;
+
+    d_linked_node_pool_thread_flush();
+
+    idle = NULL;
+
+    d_internal_linked_node_pool_lock();
+
+    d_internal_node_pool.reserve = 0;
+
+    for (slab = d_internal_node_pool.head; slab; slab = next)
+    {
+        next = slab->next;
+
+        if (slab->available == D_LINKED_NODE_POOL_SLAB_NODES)
+        {
+            d_internal_linked_node_pool_unlink(slab);
+
+            d_internal_node_pool.available -= D_LINKED_NODE_POOL_SLAB_NODES;
+
+            --d_internal_node_pool.slab_count;
+
+            slab->next = idle;
+            idle       = slab;
+        }
+    }
+
+    empty = (d_internal_node_pool.slab_count == 0);
+
+    d_internal_linked_node_pool_unlock();
+
+    d_internal_linked_node_pool_free_idle(idle);
+
+    return empty;
+}
+
+/*
+d_linked_node_pool_thread_flush
+  Returns every node in the calling thread's cache to the pool. Threads that
+exit flush automatically. Does nothing unless D_LINKED_NODE_POOL_THREAD_CACHE
+is enabled.
+
+Parameter(s):
+  none
+Return:
+  none
+*/
+void
+d_linked_node_pool_thread_flush
+(
+    void
+)
+{
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    d_internal_linked_node_cache_flush(&d_internal_node_cache);
+#endif
+
+    return;
+}
+
+/*
+d_linked_node_pool_get_stats
+  Copies the pool's bookkeeping into `_stats`. Thread caches change without
+taking the lock, so `cached` and `in_use` are only exact while no other
+thread is allocating.
+
+Parameter(s):
+  _stats: receives the snapshot; NULL is ignored.
+Return:
+  none
+*/
+void
+d_linked_node_pool_get_stats
+(
+    struct d_linked_node_pool_stats* _stats
+)
+{
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    struct d_internal_linked_node_cache* cache;
+#endif
+
+    if (!_stats)
+    {
+        return;
+    }
+
+    _stats->cached = 0;
+
+    d_internal_linked_node_pool_lock();
+
+    _stats->slabs     = d_internal_node_pool.slab_count;
+    _stats->capacity  = d_internal_node_pool.slab_count *
+                        D_LINKED_NODE_POOL_SLAB_NODES;
+    _stats->available = d_internal_node_pool.available;
+
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    for (cache = d_internal_node_pool.caches; cache; cache = cache->next)
+    {
+        _stats->cached += atomic_load_explicit(&cache->count,
+                                               memory_order_relaxed);
+    }
+#endif
+
+    d_internal_linked_node_pool_unlock();
+
+    // a refill lands in a cache just after the lock drops; never underflow
+    _stats->in_use = _stats->capacity - _stats->available;
+    _stats->in_use = (_stats->in_use > _stats->cached)
+                         ? (_stats->in_use - _stats->cached)
+                         : 0;
+
+    return;
+}
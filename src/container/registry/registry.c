@@ -5,6 +5,15 @@
 
 #include <ctype.h>   // tolower
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define D_REGISTRY_FOLD_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define D_REGISTRY_FOLD_NEON 1
+#endif
+
 
 /******************************************************************************
  * INTERNAL HELPERS
@@ -73,6 +82,18 @@ d_registry_is_static
     return _reg && ((_reg->flags & D_REGISTRY_FLAG_STATIC_ROWS) != 0);
 }
 
+// d_registry_is_external
+//   the hash index and perfect hash belong to someone else (a mapped image or
+// a constexpr table): they are never freed, rebuilt or written.
+static bool
+d_registry_is_external
+(
+    const struct d_registry* _reg
+)
+{
+    return _reg && _reg->external_index;
+}
+
 static int
 d_registry_lookup_entry_cmp_for_reg
 (
@@ -89,948 +110,3478 @@ d_registry_lookup_entry_cmp_for_reg
     return d_registry_keycmp_nocase(_a->key, _b->key);
 }
 
-static struct d_registry_lookup_entry*
-d_registry_find_lookup_entry
+static bool
+d_registry_is_batching
 (
-    const struct d_registry* _reg,
-    const char* _key
+    const struct d_registry* _reg
 )
 {
-    struct d_registry_lookup_entry probe;
-    int (*cmp)(const void*, const void*) = NULL;
-
-    if (!_reg || !_key || !_reg->lookup || _reg->lookup_count == 0)
-    {
-        return NULL;
-    }
-
-    probe.key       = _key;
-    probe.row_index = 0;
-
-    cmp = ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
-            ? d_registry_lookup_compare
-            : d_registry_lookup_compare_nocase;
-
-    return (struct d_registry_lookup_entry*)bsearch(
-        &probe,
-        _reg->lookup,
-        _reg->lookup_count,
-        sizeof(struct d_registry_lookup_entry),
-        cmp
-    );
+    return _reg && (_reg->batch_depth > 0);
 }
 
-static bool
-d_registry_ensure_row_capacity
+static int
+d_registry_keycmp_for_reg
 (
-    struct d_registry* _reg,
-    size_t _needed
+    const struct d_registry* _reg,
+    const char* _a,
+    const char* _b
 )
 {
-    void*  new_rows;
-    size_t new_cap;
+    return ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
+            ? d_registry_keycmp_case_sensitive(_a, _b)
+            : d_registry_keycmp_nocase(_a, _b);
+}
 
-    if (!_reg) return false;
-    if (_reg->capacity >= _needed) return true;
+// d_registry_key_prefix
+//   packs the first 8 bytes of `_key` big-endian, zero padded, so that
+// unsigned comparison of two prefixes orders like the key comparators.
+static uint64_t
+d_registry_key_prefix
+(
+    const char* _key,
+    bool        _nocase
+)
+{
+    uint64_t      prefix = 0;
+    unsigned char c;
+    size_t        i;
 
-    new_cap = (_reg->capacity == 0) ? D_REGISTRY_DEFAULT_CAPACITY : _reg->capacity;
+    if (!_key)
+    {
+        return 0;
+    }
 
-    while (new_cap < _needed)
+    for (i = 0; i < 8; ++i)
     {
-        new_cap *= D_REGISTRY_GROWTH_FACTOR;
-        if (new_cap < _reg->capacity)  // overflow guard
+        c = (unsigned char)_key[i];
+
+        if (c == '\0')
         {
-            return false;
+            return (i == 0) ? 0 : (prefix << (8 * (8 - i)));
         }
-    }
 
-    new_rows = realloc(_reg->rows, new_cap * _reg->row_size);
-    if (!new_rows)
-    {
-        return false;
+        if (_nocase)
+        {
+            c = (unsigned char)tolower(c);
+        }
+
+        prefix = (prefix << 8) | c;
     }
 
-    _reg->rows     = new_rows;
-    _reg->capacity = new_cap;
+    return prefix;
+}
 
-    return true;
+static void
+d_registry_set_entry_prefix
+(
+    const struct d_registry*        _reg,
+    struct d_registry_lookup_entry* _entry
+)
+{
+    _entry->prefix = ((_reg->flags & D_REGISTRY_FLAG_KEY_PREFIX) != 0)
+                       ? d_registry_key_prefix(
+                             _entry->key,
+                             (_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) != 0)
+                       : 0;
 }
 
+// d_registry_fold_active
+//   true if lookup comparisons should use folded key copies.
 static bool
-d_registry_ensure_lookup_capacity
+d_registry_fold_active
 (
-    struct d_registry* _reg,
-    size_t _needed
+    const struct d_registry* _reg
 )
 {
-    struct d_registry_lookup_entry* new_lookup;
-    size_t new_cap;
+    return _reg->fold_keys &&
+           ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) != 0);
+}
 
-    if (!_reg) return false;
-    if (_reg->lookup_capacity >= _needed) return true;
+// d_registry_fold_ascii
+//   copies `_len` bytes with 'A'-'Z' lowered, 16 at a time where SSE2 or
+// NEON is available. Other bytes, non-ASCII included, are copied unchanged.
+static void
+d_registry_fold_ascii
+(
+    char*       _dst,
+    const char* _src,
+    size_t      _len
+)
+{
+    unsigned char c;
+    size_t        i = 0;
 
-    new_cap = (_reg->lookup_capacity == 0) ? D_REGISTRY_DEFAULT_CAPACITY : _reg->lookup_capacity;
+#if defined(D_REGISTRY_FOLD_SSE2)
+    const __m128i below = _mm_set1_epi8('A' - 1);
+    const __m128i above = _mm_set1_epi8('Z' + 1);
+    const __m128i bit   = _mm_set1_epi8(0x20);
+    __m128i       v;
+    __m128i       upper;
 
-    while (new_cap < _needed)
+    // bytes >= 0x80 compare as negative and never fall inside 'A'-'Z'
+    for (; i + 16 <= _len; i += 16)
     {
-        new_cap *= D_REGISTRY_GROWTH_FACTOR;
-        if (new_cap < _reg->lookup_capacity)  // overflow guard
-        {
-            return false;
-        }
-    }
+        v     = _mm_loadu_si128((const __m128i*)(const void*)(_src + i));
+        upper = _mm_and_si128(_mm_cmpgt_epi8(v, below),
+                              _mm_cmplt_epi8(v, above));
 
-    new_lookup = (struct d_registry_lookup_entry*)realloc(
-        _reg->lookup,
-        new_cap * sizeof(struct d_registry_lookup_entry)
-    );
+        _mm_storeu_si128((__m128i*)(void*)(_dst + i),
+                         _mm_or_si128(v, _mm_and_si128(upper, bit)));
+    }
+#elif defined(D_REGISTRY_FOLD_NEON)
+    const uint8x16_t first = vdupq_n_u8('A');
+    const uint8x16_t span  = vdupq_n_u8('Z' - 'A');
+    const uint8x16_t bit   = vdupq_n_u8(0x20);
+    uint8x16_t       v;
+    uint8x16_t       upper;
 
-    if (!new_lookup)
+    for (; i + 16 <= _len; i += 16)
     {
-        return false;
+        v     = vld1q_u8((const uint8_t*)(_src + i));
+        upper = vcleq_u8(vsubq_u8(v, first), span);
+
+        vst1q_u8((uint8_t*)(_dst + i), vorrq_u8(v, vandq_u8(upper, bit)));
     }
+#endif
 
-    _reg->lookup          = new_lookup;
-    _reg->lookup_capacity = new_cap;
+    for (; i < _len; ++i)
+    {
+        c       = (unsigned char)_src[i];
+        _dst[i] = (char)(((c >= 'A') && (c <= 'Z')) ? (c | 0x20) : c);
+    }
+}
 
-    return true;
+// d_registry_folded_length
+//   length stored in front of a folded key copy.
+static size_t
+d_registry_folded_length
+(
+    const char* _folded
+)
+{
+    return ((const size_t*)(const void*)_folded)[-1];
 }
 
-static void*
-d_registry_row_ptr
+// d_registry_folded_cmp
+//   orders folded copies like d_registry_keycmp_nocase orders their keys.
+static int
+d_registry_folded_cmp
 (
-    const struct d_registry* _reg,
-    size_t _index
+    const char* _a,
+    const char* _b
 )
 {
-    if (!_reg || !_reg->rows) return NULL;
-    return (void*)((char*)_reg->rows + (_index * _reg->row_size));
+    size_t la = d_registry_folded_length(_a);
+    size_t lb = d_registry_folded_length(_b);
+    int    r;
+
+    r = memcmp(_a, _b, (la < lb) ? la : lb);
+
+    if (r != 0)
+    {
+        return (r < 0) ? -1 : 1;
+    }
+
+    if (la == lb) return 0;
+    return (la < lb) ? -1 : 1;
 }
 
-static bool
-d_registry_lookup_entry_is_canonical
+// d_registry_fold_probe
+//   folds a search key into `_buf` (length first, like an arena copy).
+// Returns NULL when folding is off or the key does not fit, in which case
+// the comparators fall back to d_registry_keycmp_nocase.
+static const char*
+d_registry_fold_probe
 (
     const struct d_registry* _reg,
-    const struct d_registry_lookup_entry* _e
+    const char*              _key,
+    size_t*                  _buf,
+    size_t                   _buf_size
 )
 {
-    const char* row_key;
-    int         eq;
+    size_t len;
+    char*  dst;
 
-    if (!_reg || !_e) return false;
-    if (_e->row_index >= _reg->count) return false;
+    if (!d_registry_fold_active(_reg))
+    {
+        return NULL;
+    }
 
-    row_key = D_REGISTRY_ROW_KEY(d_registry_row_ptr(_reg, _e->row_index));
+    len = strlen(_key);
 
-    eq = ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
-            ? (d_registry_keycmp_case_sensitive(_e->key, row_key) == 0)
-            : (d_registry_keycmp_nocase(_e->key, row_key) == 0);
+    if (sizeof(size_t) + len + 1 > _buf_size)
+    {
+        return NULL;
+    }
 
-    return eq;
-}
+    dst     = (char*)(_buf + 1);
+    _buf[0] = len;
 
+    d_registry_fold_ascii(dst, _key, len);
+    dst[len] = '\0';
 
-/******************************************************************************
- * CONSTRUCTORS
- *****************************************************************************/
+    return dst;
+}
 
-struct d_registry*
-d_registry_new
+// d_registry_init_entry_caches
+//   fills a new lookup entry's prefix; its folded copy is made by the next
+// sort_lookup.
+static void
+d_registry_init_entry_caches
 (
-    size_t _row_size
+    const struct d_registry*        _reg,
+    struct d_registry_lookup_entry* _entry
 )
 {
-    return d_registry_new_with_capacity(_row_size, D_REGISTRY_DEFAULT_CAPACITY);
+    d_registry_set_entry_prefix(_reg, _entry);
+    _entry->folded = NULL;
 }
 
-struct d_registry*
-d_registry_new_with_capacity
+static void
+d_registry_refresh_prefixes
 (
-    size_t _row_size,
-    size_t _capacity
+    struct d_registry* _reg
 )
 {
-    struct d_registry* reg;
+    size_t i;
 
-    if (_row_size == 0)
+    if ((_reg->flags & D_REGISTRY_FLAG_KEY_PREFIX) == 0)
     {
-        return NULL;
+        return;
     }
 
-    reg = (struct d_registry*)calloc(1, sizeof(*reg));
-    if (!reg)
+    for (i = 0; i < _reg->lookup_count; ++i)
     {
-        return NULL;
+        d_registry_set_entry_prefix(_reg, &_reg->lookup[i]);
     }
+}
 
-    reg->row_size = _row_size;
-    reg->flags    = (uint8_t)D_REGISTRY_FLAG_DEFAULT;
+// d_registry_lookup_cmp_fn
+//   picks the lookup comparator matching the registry's flags.
+static int (*d_registry_lookup_cmp_fn
+(
+    const struct d_registry* _reg
+))(const void*, const void*)
+{
+    if (d_registry_fold_active(_reg))
+    {
+        return ((_reg->flags & D_REGISTRY_FLAG_KEY_PREFIX) != 0)
+                 ? d_registry_lookup_compare_prefix_folded
+                 : d_registry_lookup_compare_folded;
+    }
 
-    if (_capacity > 0)
+    if ((_reg->flags & D_REGISTRY_FLAG_KEY_PREFIX) != 0)
     {
-        if (!d_registry_reserve(reg, _capacity))
-        {
-            d_registry_free(reg);
-            return NULL;
-        }
-        if (!d_registry_reserve_lookup(reg, _capacity))
-        {
-            d_registry_free(reg);
-            return NULL;
-        }
+        return ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
+                 ? d_registry_lookup_compare_prefix
+                 : d_registry_lookup_compare_prefix_nocase;
     }
 
-    return reg;
+    return ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
+             ? d_registry_lookup_compare
+             : d_registry_lookup_compare_nocase;
 }
 
-struct d_registry*
-d_registry_new_copy
+// d_registry_find_sorted_entry
+//   binary searches only the sorted part of the lookup; outside of a batch
+// that is the whole array.
+static struct d_registry_lookup_entry*
+d_registry_find_sorted_entry
 (
-    const struct d_registry* _other
+    const struct d_registry* _reg,
+    const char* _key
 )
 {
-    struct d_registry* reg;
+    struct d_registry_lookup_entry probe;
+    int (*cmp)(const void*, const void*) = NULL;
+    size_t sorted_count;
+    size_t fold_buf[(D_REGISTRY_FOLD_PROBE_MAX / sizeof(size_t)) + 2];
 
-    if (!_other)
+    if (!_reg || !_key || !_reg->lookup || _reg->lookup_count == 0)
     {
         return NULL;
     }
 
-    reg = d_registry_new_with_capacity(_other->row_size, _other->count);
-    if (!reg)
+    sorted_count = d_registry_is_batching(_reg)
+                     ? _reg->lookup_sorted
+                     : _reg->lookup_count;
+
+    if (sorted_count == 0)
     {
         return NULL;
     }
 
-    reg->flags    = (uint8_t)(_other->flags & ~D_REGISTRY_FLAG_STATIC_ROWS);
-    reg->row_free = _other->row_free;
+    probe.key       = _key;
+    probe.row_index = 0;
 
-    if (_other->count > 0 && _other->rows)
+    d_registry_set_entry_prefix(_reg, &probe);
+
+    // folded once here, so each bsearch step is a memcmp
+    probe.folded = d_registry_fold_probe(_reg, _key, fold_buf, sizeof(fold_buf));
+
+    cmp = d_registry_lookup_cmp_fn(_reg);
+
+    return (struct d_registry_lookup_entry*)bsearch(
+        &probe,
+        _reg->lookup,
+        sorted_count,
+        sizeof(struct d_registry_lookup_entry),
+        cmp
+    );
+}
+
+static struct d_registry_lookup_entry*
+d_registry_find_lookup_entry
+(
+    const struct d_registry* _reg,
+    const char* _key
+)
+{
+    struct d_registry_lookup_entry* e;
+    size_t i;
+
+    e = d_registry_find_sorted_entry(_reg, _key);
+
+    if (e || !d_registry_is_batching(_reg))
     {
-        memcpy(reg->rows, _other->rows, _other->count * _other->row_size);
-        reg->count = _other->count;
+        return e;
     }
 
-    if (_other->lookup_count > 0 && _other->lookup)
+    // Staged entries are unsorted; scan newest-first so that the common
+    // "add a row, then alias it" pattern resolves immediately.
+    for (i = _reg->lookup_count; i > _reg->lookup_sorted; --i)
     {
-        if (!d_registry_reserve_lookup(reg, _other->lookup_count))
+        if (d_registry_keycmp_for_reg(_reg, _reg->lookup[i - 1].key, _key) == 0)
         {
-            d_registry_free(reg);
-            return NULL;
+            return &_reg->lookup[i - 1];
         }
+    }
 
-        memcpy(reg->lookup,
-               _other->lookup,
-               _other->lookup_count * sizeof(struct d_registry_lookup_entry));
+    return NULL;
+}
 
-        reg->lookup_count = _other->lookup_count;
+// d_registry_resort_lookup
+//   re-sorts after a lookup mutation, unless a batch defers it.
+static void
+d_registry_resort_lookup
+(
+    struct d_registry* _reg
+)
+{
+    if (d_registry_is_batching(_reg))
+    {
+        return;
     }
 
-    return reg;
+    d_registry_sort_lookup(_reg);
 }
 
-struct d_registry*
-d_registry_new_from_array
+// d_registry_hash_key
+//   FNV-1a over the key, folded with tolower() for case-insensitive
+// registries so that keys equal under d_registry_keycmp_nocase collide.
+static size_t
+d_registry_hash_key
 (
-    const void* _rows,
-    size_t _row_size,
-    size_t _count
+    const struct d_registry* _reg,
+    const char* _key
 )
 {
-    struct d_registry* reg;
+    const unsigned char* p = (const unsigned char*)_key;
+    uint64_t             h = 14695981039346656037ULL;
 
-    if (!_rows || _row_size == 0)
+    if (!p)
     {
-        return NULL;
+        return 0;
     }
 
-    reg = d_registry_new_with_capacity(_row_size, _count);
-    if (!reg)
+    if ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
     {
-        return NULL;
+        while (*p)
+        {
+            h ^= (uint64_t)*p++;
+            h *= 1099511628211ULL;
+        }
     }
-
-    if (_count > 0)
+    else
     {
-        memcpy(reg->rows, _rows, _count * _row_size);
-        reg->count = _count;
-        d_registry_rebuild_lookup(reg);
+        while (*p)
+        {
+            h ^= (uint64_t)(unsigned char)tolower(*p++);
+            h *= 1099511628211ULL;
+        }
     }
 
-    return reg;
+    return (size_t)(h ^ (h >> 32));
 }
 
-
-/******************************************************************************
- * LOOKUP / COMPARATORS
- *****************************************************************************/
-
-int
-d_registry_lookup_compare
+// d_registry_arena_find
+//   interned header of `_key`, or NULL if it does not point into the arena.
+static const struct d_registry_interned*
+d_registry_arena_find
 (
-    const void* _a,
-    const void* _b
+    const struct d_registry* _reg,
+    const char* _key
 )
 {
-    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
-    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
-    return d_registry_keycmp_case_sensitive(a->key, b->key);
+    const struct d_registry_arena_block* b;
+    uintptr_t                            p;
+    uintptr_t                            start;
+
+    p = (uintptr_t)_key;
+
+    for (b = _reg->arena; b; b = b->next)
+    {
+        start = (uintptr_t)(b + 1);
+
+        if ( (p >= start + sizeof(struct d_registry_interned)) &&
+             (p <  start + b->used) )
+        {
+            return D_REGISTRY_INTERNED(_key);
+        }
+    }
+
+    return NULL;
 }
 
-int
-d_registry_lookup_compare_nocase
+// d_registry_hash_key_cached
+//   d_registry_hash_key, reusing the hash stored with an interned key when
+// it was computed under the registry's current case mode.
+static size_t
+d_registry_hash_key_cached
 (
-    const void* _a,
-    const void* _b
+    const struct d_registry* _reg,
+    const char* _key
 )
 {
-    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
-    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
-    return d_registry_keycmp_nocase(a->key, b->key);
+    const struct d_registry_interned* in;
+
+    in = d_registry_arena_find(_reg, _key);
+
+    if ( (in) &&
+         (in->nocase == (uint32_t)((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) != 0)) )
+    {
+        return in->hash;
+    }
+
+    return d_registry_hash_key(_reg, _key);
 }
 
-void
-d_registry_sort_lookup
+// d_registry_arena_alloc
+//   hands out `_bytes` (rounded up to sizeof(size_t)) from the newest block
+// of the chain at `_head` (the interned key or folded key arena), chaining a
+// larger block when it is full.
+static char*
+d_registry_arena_alloc
 (
-    struct d_registry* _registry
+    struct d_registry_arena_block** _head,
+    size_t _bytes
 )
 {
-    int (*cmp)(const void*, const void*) = NULL;
+    struct d_registry_arena_block* b;
+    size_t                         size;
+    char*                          p;
 
-    if (!_registry || !_registry->lookup || _registry->lookup_count <= 1)
+    _bytes = (_bytes + (sizeof(size_t) - 1)) & ~(sizeof(size_t) - 1);
+    b      = *_head;
+
+    if ( (!b) ||
+         (b->size - b->used < _bytes) )
     {
-        return;
+        size = (b) ? (b->size * 2) : D_REGISTRY_ARENA_BLOCK_MIN;
+
+        if (size > D_REGISTRY_ARENA_BLOCK_MAX)
+        {
+            size = D_REGISTRY_ARENA_BLOCK_MAX;
+        }
+
+        if (size < _bytes)
+        {
+            size = _bytes;
+        }
+
+        b = (struct d_registry_arena_block*)malloc(sizeof(*b) + size);
+        if (!b)
+        {
+            return NULL;
+        }
+
+        b->next = *_head;
+        b->used = 0;
+        b->size = size;
+        *_head  = b;
     }
 
-    cmp = ((_registry->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
-            ? d_registry_lookup_compare
-            : d_registry_lookup_compare_nocase;
+    p        = (char*)(b + 1) + b->used;
+    b->used += _bytes;
 
-    qsort(_registry->lookup,
-          _registry->lookup_count,
-          sizeof(struct d_registry_lookup_entry),
-          cmp);
+    return p;
 }
 
-void
-d_registry_rebuild_lookup
+// d_registry_arena_rollback
+//   returns the arena to a mark taken before a failed `_intern` operation.
+static void
+d_registry_arena_rollback
 (
-    struct d_registry* _registry
+    struct d_registry* _reg,
+    struct d_registry_arena_block* _block,
+    size_t _used
 )
 {
-    size_t i;
+    struct d_registry_arena_block* b;
 
-    if (!_registry)
+    while ( (_reg->arena) &&
+            (_reg->arena != _block) )
     {
-        return;
+        b           = _reg->arena;
+        _reg->arena = b->next;
+        free(b);
     }
 
-    // Per header comment: rebuilds from row keys only (aliases are dropped).
-    _registry->lookup_count = 0;
-
-    if (_registry->count == 0)
+    if (_reg->arena)
     {
-        return;
+        _reg->arena->used = _used;
     }
+}
 
-    if (!d_registry_ensure_lookup_capacity(_registry, _registry->count))
-    {
-        return;
-    }
+static void
+d_registry_arena_free
+(
+    struct d_registry_arena_block** _head
+)
+{
+    struct d_registry_arena_block* b;
 
-    for (i = 0; i < _registry->count; ++i)
+    while (*_head)
     {
-        void* row = d_registry_row_ptr(_registry, i);
-
-        _registry->lookup[i].key       = D_REGISTRY_ROW_KEY(row);
-        _registry->lookup[i].row_index = i;
+        b      = *_head;
+        *_head = b->next;
+        free(b);
     }
-
-    _registry->lookup_count = _registry->count;
-
-    d_registry_sort_lookup(_registry);
 }
 
-
-/******************************************************************************
- * PRIMARY LOOKUP
- *****************************************************************************/
-
-void*
-d_registry_get
+// d_registry_fold_copy
+//   stores a folded copy of `_key` in the folded key arena.
+static const char*
+d_registry_fold_copy
 (
-    const struct d_registry* _registry,
+    struct d_registry* _reg,
     const char* _key
 )
 {
-    struct d_registry_lookup_entry* e;
+    size_t len;
+    char*  p;
 
-    if (!_registry || !_key)
-    {
-        return NULL;
-    }
+    len = strlen(_key);
+    p   = d_registry_arena_alloc(&_reg->fold_arena, sizeof(size_t) + len + 1);
 
-    e = d_registry_find_lookup_entry(_registry, _key);
-    if (!e || e->row_index >= _registry->count)
+    if (!p)
     {
         return NULL;
     }
 
-    return d_registry_row_ptr(_registry, e->row_index);
-}
+    memcpy(p, &len, sizeof(len));
+    p += sizeof(size_t);
 
+    d_registry_fold_ascii(p, _key, len);
+    p[len] = '\0';
 
-/******************************************************************************
- * ROW MANIPULATION
- *****************************************************************************/
+    return p;
+}
 
-bool
-d_registry_add
+// d_registry_refresh_folded
+//   gives every lookup entry that lacks one a folded copy. An entry left
+// without a copy (allocation failure) is still compared correctly, only
+// more slowly.
+static void
+d_registry_refresh_folded
 (
-    struct d_registry* _registry,
-    const void* _row
+    struct d_registry* _reg
 )
 {
-    const char* key;
-    size_t      insert_at;
-    size_t      i;
+    size_t i;
 
-    if (!_registry || !_row)
+    if (!d_registry_fold_active(_reg))
     {
-        return false;
+        return;
     }
 
-    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    for (i = 0; i < _reg->lookup_count; ++i)
     {
-        return false;
+        if ( (!_reg->lookup[i].folded) &&
+             (_reg->lookup[i].key) )
+        {
+            _reg->lookup[i].folded = d_registry_fold_copy(_reg, _reg->lookup[i].key);
+        }
     }
+}
 
-    key = D_REGISTRY_ROW_KEY(_row);
-    if (!key)
+// d_registry_arena_translate
+//   maps a key in `_src`'s arena to its copy in `_dst` (laid out by
+// d_registry_arena_clone); other keys are returned unchanged.
+static const char*
+d_registry_arena_translate
+(
+    const struct d_registry* _src,
+    const struct d_registry_arena_block* _dst,
+    const char* _key
+)
+{
+    const struct d_registry_arena_block* b;
+    uintptr_t                            p;
+    uintptr_t                            start;
+    size_t                               offset;
+
+    p      = (uintptr_t)_key;
+    offset = 0;
+
+    for (b = _src->arena; b; b = b->next)
     {
-        return false;
+        start = (uintptr_t)(b + 1);
+
+        if ( (p >= start) &&
+             (p <  start + b->used) )
+        {
+            return (const char*)(_dst + 1) + offset + (p - start);
+        }
+
+        offset += b->used;
     }
 
-    if (d_registry_contains(_registry, key))
+    return _key;
+}
+
+// d_registry_arena_clone
+//   copies `_src`'s arena into a single block owned by `_reg` and repoints
+// the (already copied) row and lookup keys that referred to it.
+static bool
+d_registry_arena_clone
+(
+    struct d_registry* _reg,
+    const struct d_registry* _src
+)
+{
+    const struct d_registry_arena_block* b;
+    struct d_registry_arena_block*       block;
+    const char*                          key;
+    size_t                               total;
+    size_t                               i;
+
+    if (!_src->arena)
     {
-        return false;
+        return true;
     }
 
-    insert_at = _registry->count;
+    total = 0;
 
-    // Optional sorted insertion by key.
-    if ((_registry->flags & D_REGISTRY_FLAG_SORTED) != 0)
+    for (b = _src->arena; b; b = b->next)
     {
-        for (i = 0; i < _registry->count; ++i)
-        {
-            const char* row_key = D_REGISTRY_ROW_KEY(d_registry_row_ptr(_registry, i));
-            int cmp = ((_registry->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
-                        ? d_registry_keycmp_case_sensitive(key, row_key)
-                        : d_registry_keycmp_nocase(key, row_key);
-
-            if (cmp < 0)
-            {
-                insert_at = i;
-                break;
-            }
-        }
+        total += b->used;
     }
 
-    if (!d_registry_ensure_row_capacity(_registry, _registry->count + 1))
+    block = (struct d_registry_arena_block*)malloc(
+        sizeof(*block) + ((total > D_REGISTRY_ARENA_BLOCK_MIN) ? total
+                                                               : D_REGISTRY_ARENA_BLOCK_MIN));
+    if (!block)
     {
         return false;
     }
 
-    if (!d_registry_ensure_lookup_capacity(_registry, _registry->lookup_count + 1))
+    block->next = NULL;
+    block->used = 0;
+    block->size = (total > D_REGISTRY_ARENA_BLOCK_MIN) ? total
+                                                       : D_REGISTRY_ARENA_BLOCK_MIN;
+
+    // every block's `used` is a multiple of sizeof(size_t), so headers stay
+    // aligned when the blocks are laid end to end
+    for (b = _src->arena; b; b = b->next)
     {
-        return false;
+        memcpy((char*)(block + 1) + block->used, b + 1, b->used);
+        block->used += b->used;
     }
 
-    // Make space in rows if inserting in the middle.
-    if (insert_at < _registry->count)
+    for (i = 0; i < _reg->count; ++i)
     {
-        memmove(
-            (char*)_registry->rows + ((insert_at + 1) * _registry->row_size),
-            (char*)_registry->rows + (insert_at * _registry->row_size),
-            (_registry->count - insert_at) * _registry->row_size
-        );
+        char* row = (char*)_reg->rows + (i * _reg->row_size);
 
-        // Any lookup entry that points at rows >= insert_at must shift.
-        for (i = 0; i < _registry->lookup_count; ++i)
-        {
-            if (_registry->lookup[i].row_index >= insert_at)
-            {
-                _registry->lookup[i].row_index += 1;
-            }
-        }
+        key = d_registry_arena_translate(_src, block, D_REGISTRY_ROW_KEY(row));
+        memcpy(row, &key, sizeof(key));
     }
 
-    memcpy(d_registry_row_ptr(_registry, insert_at), _row, _registry->row_size);
-    _registry->count += 1;
-
-    // Add canonical key entry.
-    _registry->lookup[_registry->lookup_count].key       = D_REGISTRY_ROW_KEY(d_registry_row_ptr(_registry, insert_at));
-    _registry->lookup[_registry->lookup_count].row_index = insert_at;
-    _registry->lookup_count += 1;
+    for (i = 0; i < _reg->lookup_count; ++i)
+    {
+        _reg->lookup[i].key = d_registry_arena_translate(_src, block, _reg->lookup[i].key);
+    }
 
-    d_registry_sort_lookup(_registry);
+    _reg->arena = block;
 
     return true;
 }
 
-bool
-d_registry_add_rows
+static bool
+d_registry_hash_is_live
 (
-    struct d_registry* _registry,
-    const void* _rows,
-    size_t _count
+    const struct d_registry* _reg
 )
 {
-    size_t i;
+    return _reg->hash_slots &&
+           ((_reg->flags & D_REGISTRY_FLAG_HASH_INDEX) != 0) &&
+           (_reg->batch_depth == 0);
+}
 
-    if (!_registry || !_rows || _count == 0)
+static void
+d_registry_hash_put
+(
+    struct d_registry_hash_slot* _slots,
+    size_t _capacity,
+    const char* _key,
+    size_t _hash,
+    size_t _row_index
+)
+{
+    size_t i = _hash & (_capacity - 1);
+
+    while (_slots[i].key)
     {
-        return false;
+        i = (i + 1) & (_capacity - 1);
     }
 
-    for (i = 0; i < _count; ++i)
-    {
-        const void* row = (const void*)((const char*)_rows + (i * _registry->row_size));
+    _slots[i].key       = _key;
+    _slots[i].row_index = _row_index;
+    _slots[i].hash      = _hash;
+}
 
-        if (!d_registry_add(_registry, row))
+static struct d_registry_hash_slot*
+d_registry_hash_find
+(
+    const struct d_registry* _reg,
+    const char* _key
+)
+{
+    size_t hash;
+    size_t mask;
+    size_t i;
+
+    hash = d_registry_hash_key(_reg, _key);
+    mask = _reg->hash_capacity - 1;
+
+    for (i = hash & mask; _reg->hash_slots[i].key; i = (i + 1) & mask)
+    {
+        if ( (_reg->hash_slots[i].hash == hash) &&
+             (d_registry_keycmp_for_reg(_reg, _reg->hash_slots[i].key, _key) == 0) )
         {
-            return false;  // partial adds may have occurred
+            return &_reg->hash_slots[i];
         }
     }
 
-    return true;
+    return NULL;
 }
 
-bool
-d_registry_set
+// d_registry_hash_rebuild
+//   rebuilds the hash index from the lookup array at load <= 1/2. No-op while
+// a batch is open (the commit rebuilds) or if the index is disabled.
+static bool
+d_registry_hash_rebuild
 (
-    struct d_registry* _registry,
-    const char* _key,
-    const void* _row
+    struct d_registry* _reg
 )
 {
-    struct d_registry_lookup_entry* e;
-    void* dst;
-    const char* existing_key;
+    struct d_registry_hash_slot* slots;
+    size_t capacity;
+    size_t i;
 
-    if (!_registry || !_key || !_row)
+    if ((_reg->flags & D_REGISTRY_FLAG_HASH_INDEX) == 0)
     {
-        return false;
+        return true;
     }
 
-    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    if (_reg->batch_depth > 0)
     {
-        return false;
+        return true;
     }
 
-    e = d_registry_find_lookup_entry(_registry, _key);
-    if (!e || e->row_index >= _registry->count)
+    if (d_registry_is_external(_reg))
     {
         return false;
     }
 
-    dst = d_registry_row_ptr(_registry, e->row_index);
+    capacity = D_REGISTRY_HASH_MIN_CAPACITY;
 
-    // Preserve the canonical key in the row (dont allow key changes via set).
-    existing_key = D_REGISTRY_ROW_KEY(dst);
+    while (capacity < (_reg->lookup_count * 2))
+    {
+        capacity *= 2;
+    }
 
-    memcpy(dst, _row, _registry->row_size);
-    *((const char**)dst) = existing_key;
+    slots = (struct d_registry_hash_slot*)calloc(capacity, sizeof(*slots));
+    if (!slots)
+    {
+        // Leave the index absent; lookups fall back to binary search.
+        free(_reg->hash_slots);
+        _reg->hash_slots    = NULL;
+        _reg->hash_count    = 0;
+        _reg->hash_capacity = 0;
+
+        return false;
+    }
+
+    for (i = 0; i < _reg->lookup_count; ++i)
+    {
+        d_registry_hash_put(slots,
+                            capacity,
+                            _reg->lookup[i].key,
+                            d_registry_hash_key_cached(_reg, _reg->lookup[i].key),
+                            _reg->lookup[i].row_index);
+    }
+
+    free(_reg->hash_slots);
+    _reg->hash_slots    = slots;
+    _reg->hash_count    = _reg->lookup_count;
+    _reg->hash_capacity = capacity;
 
     return true;
 }
 
-bool
-d_registry_remove_at
+// d_registry_hash_insert
+//   records a lookup entry that has already been appended to the lookup.
+static void
+d_registry_hash_insert
 (
-    struct d_registry* _registry,
-    size_t _index
+    struct d_registry* _reg,
+    const char* _key,
+    size_t _row_index
 )
 {
-    size_t i;
-    size_t w;
+    if ( ((_reg->flags & D_REGISTRY_FLAG_HASH_INDEX) == 0) ||
+         (_reg->batch_depth > 0) )
+    {
+        return;
+    }
 
-    if (!_registry)
+    // grow past 3/4 load; the rebuild picks up the new entry from lookup
+    if ( (!_reg->hash_slots) ||
+         ((_reg->hash_count + 1) * 4 > _reg->hash_capacity * 3) )
     {
-        return false;
+        d_registry_hash_rebuild(_reg);
+        return;
     }
 
-    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    d_registry_hash_put(_reg->hash_slots,
+                        _reg->hash_capacity,
+                        _key,
+                        d_registry_hash_key_cached(_reg, _key),
+                        _row_index);
+    _reg->hash_count += 1;
+}
+
+// d_registry_hash_erase
+//   removes a key with backward-shift deletion, so no tombstones are left.
+static void
+d_registry_hash_erase
+(
+    struct d_registry* _reg,
+    const char* _key
+)
+{
+    struct d_registry_hash_slot* slot;
+    size_t mask;
+    size_t i;
+    size_t j;
+    size_t home;
+
+    if (!d_registry_hash_is_live(_reg))
     {
-        return false;
+        return;
     }
 
-    if (_index >= _registry->count)
+    slot = d_registry_hash_find(_reg, _key);
+    if (!slot)
     {
-        return false;
+        return;
     }
 
-    // Row destructor if enabled.
-    if ((_registry->flags & D_REGISTRY_FLAG_OWNS_ROWS) != 0 && _registry->row_free)
+    mask = _reg->hash_capacity - 1;
+    i    = (size_t)(slot - _reg->hash_slots);
+    j    = i;
+
+    for (;;)
     {
-        _registry->row_free(d_registry_row_ptr(_registry, _index));
+        j = (j + 1) & mask;
+
+        if (!_reg->hash_slots[j].key)
+        {
+            break;
+        }
+
+        home = _reg->hash_slots[j].hash & mask;
+
+        // move j back into the hole at i unless its home lies in (i, j]
+        if ( (i <= j) ? ((home <= i) || (home > j))
+                      : ((home <= i) && (home > j)) )
+        {
+            _reg->hash_slots[i] = _reg->hash_slots[j];
+            i = j;
+        }
     }
 
-    // Shift rows down.
-    if (_index + 1 < _registry->count)
+    _reg->hash_slots[i].key = NULL;
+    _reg->hash_count       -= 1;
+}
+
+// d_registry_mix
+//   splitmix64 finalizer; derives bucket and slot positions from a key hash.
+static uint64_t
+d_registry_mix
+(
+    uint64_t _x
+)
+{
+    _x ^= _x >> 30;
+    _x *= 0xBF58476D1CE4E5B9ULL;
+    _x ^= _x >> 27;
+    _x *= 0x94D049BB133111EBULL;
+    _x ^= _x >> 31;
+
+    return _x;
+}
+
+static size_t
+d_registry_perfect_slot
+(
+    uint64_t _hash,
+    uint32_t _displacement,
+    size_t _slots
+)
+{
+    return (size_t)(d_registry_mix(_hash ^ ((uint64_t)(_displacement + 1u) *
+                                            0x9E3779B97F4A7C15ULL)) % _slots);
+}
+
+// d_registry_perfect_find
+//   one hash, one displacement read, one map read, one verifying compare.
+static struct d_registry_lookup_entry*
+d_registry_perfect_find
+(
+    const struct d_registry* _reg,
+    const char* _key
+)
+{
+    uint64_t hash;
+    uint32_t idx;
+    size_t   bucket;
+    size_t   slot;
+
+    hash   = (uint64_t)d_registry_hash_key(_reg, _key);
+    bucket = (size_t)(d_registry_mix(hash) % _reg->perfect_buckets);
+    slot   = d_registry_perfect_slot(hash,
+                                     _reg->perfect_hash[bucket],
+                                     _reg->perfect_slots);
+    idx    = _reg->perfect_hash[_reg->perfect_buckets + slot];
+
+    if ( ((size_t)idx >= _reg->lookup_count) ||
+         (d_registry_keycmp_for_reg(_reg, _reg->lookup[idx].key, _key) != 0) )
     {
-        memmove(
-            (char*)_registry->rows + (_index * _registry->row_size),
-            (char*)_registry->rows + ((_index + 1) * _registry->row_size),
-            (_registry->count - (_index + 1)) * _registry->row_size
-        );
+        return NULL;
     }
 
-    _registry->count -= 1;
+    return &_reg->lookup[idx];
+}
 
-    // Remove lookup entries pointing to this row and shift indices above it.
-    w = 0;
-    for (i = 0; i < _registry->lookup_count; ++i)
+// d_registry_perfect_refresh
+//   the perfect hash maps slots to lookup positions, so it is dropped on any
+// lookup change and rebuilt straight away for frozen registries.
+static void
+d_registry_perfect_refresh
+(
+    struct d_registry* _reg
+)
+{
+    d_registry_drop_perfect_hash(_reg);
+
+    if (d_registry_is_frozen(_reg) && !d_registry_is_batching(_reg))
     {
-        struct d_registry_lookup_entry e = _registry->lookup[i];
+        d_registry_build_perfect_hash(_reg);
+    }
+}
 
-        if (e.row_index == _index)
+// d_registry_resolve_row
+//   resolves a key or alias to its row index, via the perfect hash or the
+// hash index if present.
+static bool
+d_registry_resolve_row
+(
+    const struct d_registry* _reg,
+    const char* _key,
+    size_t* _out_row
+)
+{
+    struct d_registry_lookup_entry* e;
+    struct d_registry_hash_slot*    slot;
+
+    if (!_reg || !_key)
+    {
+        return false;
+    }
+
+    if (_reg->perfect_hash && !d_registry_is_batching(_reg))
+    {
+        e = d_registry_perfect_find(_reg, _key);
+        if (!e || e->row_index >= _reg->count)
         {
-            continue; // drop canonical + aliases pointing to removed row
+            return false;
         }
 
-        if (e.row_index > _index)
+        *_out_row = e->row_index;
+
+        return true;
+    }
+
+    if (d_registry_hash_is_live(_reg))
+    {
+        slot = d_registry_hash_find(_reg, _key);
+        if (!slot || slot->row_index >= _reg->count)
         {
-            e.row_index -= 1;
+            return false;
         }
 
-        _registry->lookup[w++] = e;
+        *_out_row = slot->row_index;
+
+        return true;
     }
 
-    _registry->lookup_count = w;
+    e = d_registry_find_lookup_entry(_reg, _key);
+    if (!e || e->row_index >= _reg->count)
+    {
+        return false;
+    }
 
-    d_registry_sort_lookup(_registry);
+    *_out_row = e->row_index;
 
     return true;
 }
 
-bool
-d_registry_remove
+static bool
+d_registry_ensure_row_capacity
 (
-    struct d_registry* _registry,
-    const char* _key
+    struct d_registry* _reg,
+    size_t _needed
 )
 {
-    struct d_registry_lookup_entry* e;
+    void*  new_rows;
+    size_t new_cap;
+
+    if (!_reg) return false;
+    if (_reg->capacity >= _needed) return true;
+
+    new_cap = (_reg->capacity == 0) ? D_REGISTRY_DEFAULT_CAPACITY : _reg->capacity;
+
+    while (new_cap < _needed)
+    {
+        new_cap *= D_REGISTRY_GROWTH_FACTOR;
+        if (new_cap < _reg->capacity)  // overflow guard
+        {
+            return false;
+        }
+    }
 
-    if (!_registry || !_key)
+    new_rows = realloc(_reg->rows, new_cap * _reg->row_size);
+    if (!new_rows)
     {
         return false;
     }
 
-    e = d_registry_find_lookup_entry(_registry, _key);
-    if (!e)
+    _reg->rows     = new_rows;
+    _reg->capacity = new_cap;
+
+    return true;
+}
+
+static bool
+d_registry_ensure_lookup_capacity
+(
+    struct d_registry* _reg,
+    size_t _needed
+)
+{
+    struct d_registry_lookup_entry* new_lookup;
+    size_t new_cap;
+
+    if (!_reg) return false;
+    if (_reg->lookup_capacity >= _needed) return true;
+
+    new_cap = (_reg->lookup_capacity == 0) ? D_REGISTRY_DEFAULT_CAPACITY : _reg->lookup_capacity;
+
+    while (new_cap < _needed)
+    {
+        new_cap *= D_REGISTRY_GROWTH_FACTOR;
+        if (new_cap < _reg->lookup_capacity)  // overflow guard
+        {
+            return false;
+        }
+    }
+
+    new_lookup = (struct d_registry_lookup_entry*)realloc(
+        _reg->lookup,
+        new_cap * sizeof(struct d_registry_lookup_entry)
+    );
+
+    if (!new_lookup)
     {
         return false;
     }
 
-    return d_registry_remove_at(_registry, e->row_index);
+    _reg->lookup          = new_lookup;
+    _reg->lookup_capacity = new_cap;
+
+    return true;
 }
 
-void
-d_registry_clear
+static void*
+d_registry_row_ptr
 (
-    struct d_registry* _registry
+    const struct d_registry* _reg,
+    size_t _index
 )
 {
-    size_t i;
+    if (!_reg || !_reg->rows) return NULL;
+    return (void*)((char*)_reg->rows + (_index * _reg->row_size));
+}
 
-    if (!_registry)
+static bool
+d_registry_lookup_entry_is_canonical
+(
+    const struct d_registry* _reg,
+    const struct d_registry_lookup_entry* _e
+)
+{
+    const char* row_key;
+    int         eq;
+
+    if (!_reg || !_e) return false;
+    if (_e->row_index >= _reg->count) return false;
+
+    row_key = D_REGISTRY_ROW_KEY(d_registry_row_ptr(_reg, _e->row_index));
+
+    eq = ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
+            ? (d_registry_keycmp_case_sensitive(_e->key, row_key) == 0)
+            : (d_registry_keycmp_nocase(_e->key, row_key) == 0);
+
+    return eq;
+}
+
+// d_registry_compact_rows
+//   squeezes tombstoned slots out of the rows array. Lookup entries never
+// reference dead rows, so every entry has a remap target.
+static bool
+d_registry_compact_rows
+(
+    struct d_registry* _reg
+)
+{
+    size_t* remap;
+    void*   row;
+    size_t  i;
+    size_t  w;
+
+    if (_reg->dead_count == 0)
     {
-        return;
+        return true;
     }
 
-    if (d_registry_is_static(_registry))
+    remap = (size_t*)malloc(_reg->count * sizeof(size_t));
+    if (!remap)
     {
-        // Static registry tables are immutable; just drop lookup view.
-        _registry->lookup_count = 0;
-        _registry->count        = _registry->count; // no-op clarity
-        return;
+        return false;
     }
 
-    if ((_registry->flags & D_REGISTRY_FLAG_OWNS_ROWS) != 0 && _registry->row_free)
+    w = 0;
+
+    for (i = 0; i < _reg->count; ++i)
     {
-        for (i = 0; i < _registry->count; ++i)
+        row = d_registry_row_ptr(_reg, i);
+
+        if (D_REGISTRY_ROW_IS_DEAD(row))
+        {
+            continue;
+        }
+
+        if (w != i)
         {
-            _registry->row_free(d_registry_row_ptr(_registry, i));
+            memcpy(d_registry_row_ptr(_reg, w), row, _reg->row_size);
         }
+
+        remap[i] = w++;
     }
 
-    _registry->count        = 0;
-    _registry->lookup_count = 0;
-}
+    for (i = 0; i < _reg->lookup_count; ++i)
+    {
+        _reg->lookup[i].row_index = remap[_reg->lookup[i].row_index];
+    }
 
+    free(remap);
 
-/******************************************************************************
- * ALIASES
- *****************************************************************************/
+    _reg->count      = w;
+    _reg->dead_count = 0;
 
-bool
-d_registry_add_alias
+    d_registry_hash_rebuild(_reg);
+
+    return true;
+}
+
+// d_registry_remove_tombstone
+//   D_REGISTRY_FLAG_TOMBSTONES removal: drops the row's lookup entries and
+// clears its key in place; no row moves and no row index changes.
+static bool
+d_registry_remove_tombstone
 (
-    struct d_registry* _registry,
-    const char* _key,
-    const char* _alias
+    struct d_registry* _reg,
+    size_t _index
 )
 {
     struct d_registry_lookup_entry* e;
-    size_t row_index;
+    void*                           row;
+    size_t                          sorted;
+    size_t                          i;
+    size_t                          w;
 
-    if (!_registry || !_key || !_alias)
+    row = d_registry_row_ptr(_reg, _index);
+    e   = NULL;
+
+    // Without aliases or staged entries the canonical entry is the only one
+    // referencing the row, and binary search finds it.
+    if ( (!d_registry_is_batching(_reg)) &&
+         (_reg->lookup_count == _reg->count - _reg->dead_count) )
     {
-        return false;
+        e = d_registry_find_sorted_entry(_reg, D_REGISTRY_ROW_KEY(row));
+
+        if ( (e) &&
+             (e->row_index != _index) )
+        {
+            e = NULL;
+        }
     }
 
-    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
-    {
-        return false;
+    if (e)
+    {
+        d_registry_hash_erase(_reg, e->key);
+
+        memmove(e,
+                e + 1,
+                (size_t)((_reg->lookup + _reg->lookup_count) - (e + 1)) *
+                    sizeof(struct d_registry_lookup_entry));
+
+        _reg->lookup_count  -= 1;
+        _reg->lookup_sorted  = _reg->lookup_count;
+    }
+    else
+    {
+        sorted = _reg->lookup_sorted;
+        w      = 0;
+
+        for (i = 0; i < _reg->lookup_count; ++i)
+        {
+            if (_reg->lookup[i].row_index == _index)
+            {
+                if (i < sorted)
+                {
+                    _reg->lookup_sorted -= 1;
+                }
+
+                d_registry_hash_erase(_reg, _reg->lookup[i].key);
+
+                continue;
+            }
+
+            _reg->lookup[w++] = _reg->lookup[i];
+        }
+
+        _reg->lookup_count = w;
+    }
+
+    if ((_reg->flags & D_REGISTRY_FLAG_OWNS_ROWS) != 0 && _reg->row_free)
+    {
+        _reg->row_free(row);
+    }
+
+    *(const char**)row = NULL;
+    _reg->dead_count  += 1;
+
+    if ( (!d_registry_is_batching(_reg)) &&
+         (_reg->dead_count * 100 >= _reg->count * D_REGISTRY_TOMBSTONE_COMPACT_PERCENT) )
+    {
+        // best effort: on allocation failure the tombstones simply remain
+        d_registry_compact_rows(_reg);
+    }
+
+    return true;
+}
+
+
+/******************************************************************************
+ * CONSTRUCTORS
+ *****************************************************************************/
+
+struct d_registry*
+d_registry_new
+(
+    size_t _row_size
+)
+{
+    return d_registry_new_with_capacity(_row_size, D_REGISTRY_DEFAULT_CAPACITY);
+}
+
+struct d_registry*
+d_registry_new_with_capacity
+(
+    size_t _row_size,
+    size_t _capacity
+)
+{
+    struct d_registry* reg;
+
+    if (_row_size == 0)
+    {
+        return NULL;
+    }
+
+    reg = (struct d_registry*)calloc(1, sizeof(*reg));
+    if (!reg)
+    {
+        return NULL;
+    }
+
+    reg->row_size = _row_size;
+    reg->flags    = (uint8_t)D_REGISTRY_FLAG_DEFAULT;
+
+    if (_capacity > 0)
+    {
+        if (!d_registry_reserve(reg, _capacity))
+        {
+            d_registry_free(reg);
+            return NULL;
+        }
+        if (!d_registry_reserve_lookup(reg, _capacity))
+        {
+            d_registry_free(reg);
+            return NULL;
+        }
+    }
+
+    return reg;
+}
+
+struct d_registry*
+d_registry_new_copy
+(
+    const struct d_registry* _other
+)
+{
+    struct d_registry* reg;
+    size_t             i;
+
+    if (!_other)
+    {
+        return NULL;
+    }
+
+    reg = d_registry_new_with_capacity(_other->row_size, _other->count);
+    if (!reg)
+    {
+        return NULL;
+    }
+
+    reg->flags    = (uint8_t)(_other->flags & ~D_REGISTRY_FLAG_STATIC_ROWS);
+    reg->row_free = _other->row_free;
+
+    if (_other->count > 0 && _other->rows)
+    {
+        memcpy(reg->rows, _other->rows, _other->count * _other->row_size);
+        reg->count      = _other->count;
+        reg->dead_count = _other->dead_count;
+    }
+
+    if (_other->lookup_count > 0 && _other->lookup)
+    {
+        // not reserve_lookup: that refuses once FROZEN has been copied
+        if (!d_registry_ensure_lookup_capacity(reg, _other->lookup_count))
+        {
+            d_registry_free(reg);
+            return NULL;
+        }
+
+        memcpy(reg->lookup,
+               _other->lookup,
+               _other->lookup_count * sizeof(struct d_registry_lookup_entry));
+
+        reg->lookup_count  = _other->lookup_count;
+        reg->lookup_sorted = _other->lookup_sorted;
+
+        // folded copies live in the source's arena; refolded below
+        for (i = 0; i < reg->lookup_count; ++i)
+        {
+            reg->lookup[i].folded = NULL;
+        }
+    }
+
+    if (!d_registry_arena_clone(reg, _other))
+    {
+        // the rows still reference the source's keys; do not destroy them
+        reg->count        = 0;
+        reg->lookup_count = 0;
+        d_registry_free(reg);
+        return NULL;
+    }
+
+    reg->fold_keys = _other->fold_keys;
+
+    // a copy taken mid-batch does not inherit the open batch: it commits the
+    // staged entries it copied, which also rebuilds its indexes
+    if (d_registry_is_batching(_other))
+    {
+        reg->batch_depth = 1;
+        d_registry_end_batch(reg);
+
+        return reg;
+    }
+
+    d_registry_refresh_folded(reg);
+    d_registry_hash_rebuild(reg);
+    d_registry_perfect_refresh(reg);
+
+    return reg;
+}
+
+struct d_registry*
+d_registry_new_from_array
+(
+    const void* _rows,
+    size_t _row_size,
+    size_t _count
+)
+{
+    return d_registry_new_from_array_flags(_rows,
+                                           _row_size,
+                                           _count,
+                                           (uint8_t)D_REGISTRY_FLAG_DEFAULT);
+}
+
+struct d_registry*
+d_registry_new_from_array_flags
+(
+    const void* _rows,
+    size_t _row_size,
+    size_t _count,
+    uint8_t _flags
+)
+{
+    struct d_registry* reg;
+    size_t i;
+
+    if (!_rows || _row_size == 0)
+    {
+        return NULL;
+    }
+
+    reg = d_registry_new_with_capacity(_row_size, _count);
+    if (!reg)
+    {
+        return NULL;
+    }
+
+    // Rows are copied onto the heap, so STATIC_ROWS never applies; FROZEN is
+    // applied once the rows have been committed.
+    reg->flags = (uint8_t)(_flags & ~(D_REGISTRY_FLAG_STATIC_ROWS |
+                                      D_REGISTRY_FLAG_FROZEN));
+
+    if (_count > 0)
+    {
+        memcpy(reg->rows, _rows, _count * _row_size);
+        reg->count = _count;
+
+        // Stage every canonical key and commit with a single sort.
+        d_registry_begin_batch(reg);
+
+        for (i = 0; i < _count; ++i)
+        {
+            reg->lookup[i].key       = D_REGISTRY_ROW_KEY(d_registry_row_ptr(reg, i));
+            reg->lookup[i].row_index = i;
+
+            d_registry_init_entry_caches(reg, &reg->lookup[i]);
+        }
+
+        reg->lookup_count = _count;
+
+        d_registry_end_batch(reg);
+    }
+
+    reg->flags |= (uint8_t)(_flags & D_REGISTRY_FLAG_FROZEN);
+
+    return reg;
+}
+
+
+/******************************************************************************
+ * LOOKUP / COMPARATORS
+ *****************************************************************************/
+
+int
+d_registry_lookup_compare
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
+    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
+    return d_registry_keycmp_case_sensitive(a->key, b->key);
+}
+
+int
+d_registry_lookup_compare_nocase
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
+    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
+    return d_registry_keycmp_nocase(a->key, b->key);
+}
+
+// d_registry_lookup_compare_prefix_impl
+//   equal prefixes with a NUL inside them mean equal keys; otherwise only
+// the bytes past the prefix still need comparing.
+static int
+d_registry_lookup_compare_prefix_impl
+(
+    const struct d_registry_lookup_entry* _a,
+    const struct d_registry_lookup_entry* _b,
+    bool                                  _nocase
+)
+{
+    if (_a->prefix != _b->prefix)
+    {
+        return (_a->prefix < _b->prefix) ? -1 : 1;
+    }
+
+    if ( (!_a->key) ||
+         (!_b->key) )
+    {
+        return d_registry_keycmp_case_sensitive(_a->key, _b->key);
+    }
+
+    if ((_a->prefix & 0xFF) == 0)
+    {
+        return 0;
+    }
+
+    return _nocase ? d_registry_keycmp_nocase(_a->key + 8, _b->key + 8)
+                   : d_registry_keycmp_case_sensitive(_a->key + 8, _b->key + 8);
+}
+
+int
+d_registry_lookup_compare_prefix
+(
+    const void* _a,
+    const void* _b
+)
+{
+    return d_registry_lookup_compare_prefix_impl(
+        (const struct d_registry_lookup_entry*)_a,
+        (const struct d_registry_lookup_entry*)_b,
+        false);
+}
+
+int
+d_registry_lookup_compare_prefix_nocase
+(
+    const void* _a,
+    const void* _b
+)
+{
+    return d_registry_lookup_compare_prefix_impl(
+        (const struct d_registry_lookup_entry*)_a,
+        (const struct d_registry_lookup_entry*)_b,
+        true);
+}
+
+int
+d_registry_lookup_compare_folded
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
+    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
+
+    if ( (!a->folded) ||
+         (!b->folded) )
+    {
+        return d_registry_keycmp_nocase(a->key, b->key);
+    }
+
+    return d_registry_folded_cmp(a->folded, b->folded);
+}
+
+int
+d_registry_lookup_compare_prefix_folded
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
+    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
+
+    if (a->prefix != b->prefix)
+    {
+        return (a->prefix < b->prefix) ? -1 : 1;
+    }
+
+    return d_registry_lookup_compare_folded(_a, _b);
+}
+
+void
+d_registry_sort_lookup
+(
+    struct d_registry* _registry
+)
+{
+    int (*cmp)(const void*, const void*) = NULL;
+
+    if ( (!_registry) ||
+         (d_registry_is_external(_registry)) )
+    {
+        return;
+    }
+
+    // prefixes are refreshed because the case flag may have been toggled
+    d_registry_refresh_prefixes(_registry);
+    d_registry_refresh_folded(_registry);
+
+    if (_registry->lookup && _registry->lookup_count > 1)
+    {
+        cmp = d_registry_lookup_cmp_fn(_registry);
+
+        qsort(_registry->lookup,
+              _registry->lookup_count,
+              sizeof(struct d_registry_lookup_entry),
+              cmp);
+    }
+
+    _registry->lookup_sorted = _registry->lookup_count;
+
+    d_registry_perfect_refresh(_registry);
+}
+
+void
+d_registry_rebuild_lookup
+(
+    struct d_registry* _registry
+)
+{
+    size_t i;
+
+    if ( (!_registry) ||
+         (d_registry_is_external(_registry)) )
+    {
+        return;
+    }
+
+    // Per header comment: rebuilds from row keys only (aliases are dropped).
+    _registry->lookup_count  = 0;
+    _registry->lookup_sorted = 0;
+
+    // every entry is recreated, so their folded copies can all go
+    d_registry_arena_free(&_registry->fold_arena);
+
+    if ( (_registry->count == 0) ||
+         (!d_registry_ensure_lookup_capacity(_registry, _registry->count)) )
+    {
+        d_registry_hash_rebuild(_registry);
+        d_registry_perfect_refresh(_registry);
+
+        return;
+    }
+
+    for (i = 0; i < _registry->count; ++i)
+    {
+        void* row = d_registry_row_ptr(_registry, i);
+
+        if (D_REGISTRY_ROW_IS_DEAD(row))
+        {
+            continue;
+        }
+
+        _registry->lookup[_registry->lookup_count].key       = D_REGISTRY_ROW_KEY(row);
+        _registry->lookup[_registry->lookup_count].row_index = i;
+        _registry->lookup[_registry->lookup_count].folded    = NULL;
+        _registry->lookup_count += 1;
+    }
+
+    d_registry_sort_lookup(_registry);
+    d_registry_hash_rebuild(_registry);
+}
+
+bool
+d_registry_build_hash_index
+(
+    struct d_registry* _registry
+)
+{
+    if ( (!_registry) ||
+         (d_registry_is_external(_registry)) )
+    {
+        return false;
+    }
+
+    _registry->flags |= (uint8_t)D_REGISTRY_FLAG_HASH_INDEX;
+
+    return d_registry_hash_rebuild(_registry);
+}
+
+void
+d_registry_drop_hash_index
+(
+    struct d_registry* _registry
+)
+{
+    if ( (!_registry) ||
+         (d_registry_is_external(_registry)) )
+    {
+        return;
+    }
+
+    _registry->flags &= (uint8_t)~D_REGISTRY_FLAG_HASH_INDEX;
+
+    free(_registry->hash_slots);
+    _registry->hash_slots    = NULL;
+    _registry->hash_count    = 0;
+    _registry->hash_capacity = 0;
+}
+
+// d_registry_perfect_bucket
+//   internal: bucket descriptor used while placing buckets largest-first.
+struct d_registry_perfect_bucket
+{
+    uint32_t bucket;
+    uint32_t size;
+};
+
+static int
+d_registry_perfect_bucket_compare
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_perfect_bucket* a = (const struct d_registry_perfect_bucket*)_a;
+    const struct d_registry_perfect_bucket* b = (const struct d_registry_perfect_bucket*)_b;
+
+    if (a->size != b->size) return (a->size > b->size) ? -1 : 1;
+    if (a->bucket == b->bucket) return 0;
+    return (a->bucket < b->bucket) ? -1 : 1;
+}
+
+bool
+d_registry_build_perfect_hash
+(
+    struct d_registry* _registry
+)
+{
+    struct d_registry_perfect_bucket* order;
+    uint64_t* hashes;
+    uint32_t* table;
+    uint32_t* start;
+    uint32_t* members;
+    size_t*   tried;
+    uint8_t*  taken;
+    size_t    n;
+    size_t    r;
+    size_t    i;
+    size_t    k;
+    size_t    m;
+    bool      ok;
+
+    if ( (!_registry) ||
+         (d_registry_is_external(_registry)) )
+    {
+        return false;
+    }
+
+    d_registry_drop_perfect_hash(_registry);
+
+    n = _registry->lookup_count;
+
+    if ( (n == 0) || (!_registry->lookup) ||
+         (n >= (size_t)UINT32_MAX) || d_registry_is_batching(_registry) )
+    {
+        return false;
+    }
+
+    // two keys per bucket on average
+    r = (n / 2) + 1;
+
+    table   = (uint32_t*)malloc((r + n) * sizeof(uint32_t));
+    hashes  = (uint64_t*)malloc(n * sizeof(uint64_t));
+    start   = (uint32_t*)calloc(r + 1, sizeof(uint32_t));
+    members = (uint32_t*)malloc(n * sizeof(uint32_t));
+    order   = (struct d_registry_perfect_bucket*)malloc(r * sizeof(*order));
+    tried   = (size_t*)malloc(n * sizeof(size_t));
+    taken   = (uint8_t*)calloc(n, sizeof(uint8_t));
+
+    ok = table && hashes && start && members && order && tried && taken;
+
+    if (ok)
+    {
+        // bucket the entries (counting sort)
+        for (i = 0; i < n; ++i)
+        {
+            hashes[i] = (uint64_t)d_registry_hash_key_cached(_registry, _registry->lookup[i].key);
+            start[(size_t)(d_registry_mix(hashes[i]) % r) + 1] += 1;
+        }
+
+        for (i = 0; i < r; ++i)
+        {
+            order[i].bucket = (uint32_t)i;
+            order[i].size   = start[i + 1];
+            start[i + 1]   += start[i];
+            table[i]        = 0;
+        }
+
+        for (i = 0; i < n; ++i)
+        {
+            size_t b = (size_t)(d_registry_mix(hashes[i]) % r);
+
+            members[start[b] + (--order[b].size)] = (uint32_t)i;
+        }
+
+        for (i = 0; i < r; ++i)
+        {
+            order[i].size = start[i + 1] - start[i];
+        }
+
+        for (i = 0; i < n; ++i)
+        {
+            table[r + i] = UINT32_MAX;
+        }
+
+        qsort(order, r, sizeof(*order), d_registry_perfect_bucket_compare);
+
+        // place buckets largest-first, searching for a displacement that
+        // sends every member to a distinct free slot
+        for (i = 0; ok && i < r && order[i].size > 0; ++i)
+        {
+            const uint32_t* bm     = &members[start[order[i].bucket]];
+            uint32_t        d;
+            bool            placed = false;
+
+            for (d = 0; !placed && d < D_REGISTRY_PERFECT_HASH_MAX_TRIES; ++d)
+            {
+                placed = true;
+
+                for (k = 0; placed && k < order[i].size; ++k)
+                {
+                    tried[k] = d_registry_perfect_slot(hashes[bm[k]], d, n);
+
+                    for (m = 0; m < k; ++m)
+                    {
+                        if (tried[m] == tried[k]) break;
+                    }
+
+                    if (m == k)
+                    {
+                        placed = !taken[tried[k]];
+                    }
+                    else if ( (hashes[bm[m]] == hashes[bm[k]]) &&
+                              (d_registry_keycmp_for_reg(_registry,
+                                                         _registry->lookup[bm[m]].key,
+                                                         _registry->lookup[bm[k]].key) == 0) )
+                    {
+                        // duplicate key: resolves through the first entry
+                        tried[k] = (size_t)-1;
+                    }
+                    else
+                    {
+                        placed = false;
+                    }
+                }
+
+                if (placed)
+                {
+                    table[order[i].bucket] = d;
+
+                    for (k = 0; k < order[i].size; ++k)
+                    {
+                        if (tried[k] != (size_t)-1)
+                        {
+                            taken[tried[k]]      = 1;
+                            table[r + tried[k]] = bm[k];
+                        }
+                    }
+                }
+            }
+
+            ok = placed;
+        }
+    }
+
+    free(hashes);
+    free(start);
+    free(members);
+    free(order);
+    free(tried);
+    free(taken);
+
+    if (!ok)
+    {
+        free(table);
+        return false;
+    }
+
+    _registry->perfect_hash    = table;
+    _registry->perfect_buckets = r;
+    _registry->perfect_slots   = n;
+
+    return true;
+}
+
+void
+d_registry_drop_perfect_hash
+(
+    struct d_registry* _registry
+)
+{
+    if ( (!_registry) ||
+         (d_registry_is_external(_registry)) )
+    {
+        return;
+    }
+
+    free(_registry->perfect_hash);
+    _registry->perfect_hash    = NULL;
+    _registry->perfect_buckets = 0;
+    _registry->perfect_slots   = 0;
+}
+
+bool
+d_registry_enable_key_prefix
+(
+    struct d_registry* _registry
+)
+{
+    if ( (!_registry) ||
+         (d_registry_is_external(_registry)) )
+    {
+        return false;
+    }
+
+    // prefixes order exactly like the keys, so the lookup stays sorted
+    _registry->flags |= (uint8_t)D_REGISTRY_FLAG_KEY_PREFIX;
+    d_registry_refresh_prefixes(_registry);
+
+    return true;
+}
+
+void
+d_registry_disable_key_prefix
+(
+    struct d_registry* _registry
+)
+{
+    if (!_registry)
+    {
+        return;
+    }
+
+    _registry->flags &= (uint8_t)~D_REGISTRY_FLAG_KEY_PREFIX;
+}
+
+bool
+d_registry_enable_folded_keys
+(
+    struct d_registry* _registry
+)
+{
+    if ( (!_registry) ||
+         (d_registry_is_frozen(_registry)) )
+    {
+        return false;
+    }
+
+    // folded copies order exactly like the keys, so the lookup stays sorted
+    _registry->fold_keys = true;
+    d_registry_refresh_folded(_registry);
+
+    return true;
+}
+
+void
+d_registry_disable_folded_keys
+(
+    struct d_registry* _registry
+)
+{
+    size_t i;
+
+    if ( (!_registry) ||
+         (!_registry->fold_keys) )
+    {
+        return;
+    }
+
+    _registry->fold_keys = false;
+
+    for (i = 0; i < _registry->lookup_count; ++i)
+    {
+        _registry->lookup[i].folded = NULL;
+    }
+
+    d_registry_arena_free(&_registry->fold_arena);
+}
+
+
+/******************************************************************************
+ * PRIMARY LOOKUP
+ *****************************************************************************/
+
+void*
+d_registry_get
+(
+    const struct d_registry* _registry,
+    const char* _key
+)
+{
+    size_t row_index;
+
+    if (!d_registry_resolve_row(_registry, _key, &row_index))
+    {
+        return NULL;
+    }
+
+    return d_registry_row_ptr(_registry, row_index);
+}
+
+
+/******************************************************************************
+ * ROW MANIPULATION
+ *****************************************************************************/
+
+bool
+d_registry_add
+(
+    struct d_registry* _registry,
+    const void* _row
+)
+{
+    const char* key;
+    size_t      insert_at;
+    size_t      i;
+
+    if (!_registry || !_row)
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    key = D_REGISTRY_ROW_KEY(_row);
+    if (!key)
+    {
+        return false;
+    }
+
+    // Inside a batch only the pre-batch keys are checked here; collisions
+    // between staged keys are resolved by d_registry_end_batch.
+    if (d_registry_find_sorted_entry(_registry, key))
+    {
+        return false;
+    }
+
+    insert_at = _registry->count;
+
+    // Optional sorted insertion by key (batches reorder rows on commit).
+    if ( ((_registry->flags & D_REGISTRY_FLAG_SORTED) != 0) &&
+         (!d_registry_is_batching(_registry)) )
+    {
+        for (i = 0; i < _registry->count; ++i)
+        {
+            const char* row_key = D_REGISTRY_ROW_KEY(d_registry_row_ptr(_registry, i));
+            int cmp = ((_registry->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
+                        ? d_registry_keycmp_case_sensitive(key, row_key)
+                        : d_registry_keycmp_nocase(key, row_key);
+
+            if (cmp < 0)
+            {
+                insert_at = i;
+                break;
+            }
+        }
+    }
+
+    if (!d_registry_ensure_row_capacity(_registry, _registry->count + 1))
+    {
+        return false;
+    }
+
+    if (!d_registry_ensure_lookup_capacity(_registry, _registry->lookup_count + 1))
+    {
+        return false;
+    }
+
+    // Make space in rows if inserting in the middle.
+    if (insert_at < _registry->count)
+    {
+        memmove(
+            (char*)_registry->rows + ((insert_at + 1) * _registry->row_size),
+            (char*)_registry->rows + (insert_at * _registry->row_size),
+            (_registry->count - insert_at) * _registry->row_size
+        );
+
+        // Any lookup entry that points at rows >= insert_at must shift.
+        for (i = 0; i < _registry->lookup_count; ++i)
+        {
+            if (_registry->lookup[i].row_index >= insert_at)
+            {
+                _registry->lookup[i].row_index += 1;
+            }
+        }
+    }
+
+    memcpy(d_registry_row_ptr(_registry, insert_at), _row, _registry->row_size);
+    _registry->count += 1;
+
+    // Add canonical key entry.
+    _registry->lookup[_registry->lookup_count].key       = D_REGISTRY_ROW_KEY(d_registry_row_ptr(_registry, insert_at));
+    _registry->lookup[_registry->lookup_count].row_index = insert_at;
+    d_registry_init_entry_caches(_registry, &_registry->lookup[_registry->lookup_count]);
+    _registry->lookup_count += 1;
+
+    d_registry_resort_lookup(_registry);
+
+    // a middle insertion shifted row indices; the index must be rebuilt
+    if (insert_at + 1 < _registry->count)
+    {
+        d_registry_hash_rebuild(_registry);
+    }
+    else
+    {
+        d_registry_hash_insert(_registry, key, insert_at);
+    }
+
+    return true;
+}
+
+bool
+d_registry_add_rows
+(
+    struct d_registry* _registry,
+    const void* _rows,
+    size_t _count
+)
+{
+    size_t i;
+    bool   ok;
+
+    if (!_registry || !_rows || _count == 0)
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    if ( (!d_registry_ensure_row_capacity(_registry, _registry->count + _count)) ||
+         (!d_registry_ensure_lookup_capacity(_registry, _registry->lookup_count + _count)) )
+    {
+        return false;
+    }
+
+    if (!d_registry_begin_batch(_registry))
+    {
+        return false;
+    }
+
+    ok = true;
+
+    for (i = 0; i < _count; ++i)
+    {
+        const void* row = (const void*)((const char*)_rows + (i * _registry->row_size));
+
+        // keep staging the remaining rows; conflicts only fail the result
+        if (!d_registry_add(_registry, row))
+        {
+            ok = false;
+        }
+    }
+
+    return d_registry_end_batch(_registry) && ok;
+}
+
+bool
+d_registry_set
+(
+    struct d_registry* _registry,
+    const char* _key,
+    const void* _row
+)
+{
+    size_t row_index;
+    void* dst;
+    const char* existing_key;
+
+    if (!_registry || !_key || !_row)
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    if (!d_registry_resolve_row(_registry, _key, &row_index))
+    {
+        return false;
+    }
+
+    dst = d_registry_row_ptr(_registry, row_index);
+
+    // Preserve the canonical key in the row (dont allow key changes via set).
+    existing_key = D_REGISTRY_ROW_KEY(dst);
+
+    memcpy(dst, _row, _registry->row_size);
+    *((const char**)dst) = existing_key;
+
+    return true;
+}
+
+bool
+d_registry_remove_at
+(
+    struct d_registry* _registry,
+    size_t _index
+)
+{
+    size_t i;
+    size_t w;
+    size_t sorted;
+
+    if (!_registry)
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    if ( (_index >= _registry->count) ||
+         (D_REGISTRY_ROW_IS_DEAD(d_registry_row_ptr(_registry, _index))) )
+    {
+        return false;
+    }
+
+    if ((_registry->flags & D_REGISTRY_FLAG_TOMBSTONES) != 0)
+    {
+        return d_registry_remove_tombstone(_registry, _index);
+    }
+
+    // Row destructor if enabled.
+    if ((_registry->flags & D_REGISTRY_FLAG_OWNS_ROWS) != 0 && _registry->row_free)
+    {
+        _registry->row_free(d_registry_row_ptr(_registry, _index));
+    }
+
+    // Shift rows down.
+    if (_index + 1 < _registry->count)
+    {
+        memmove(
+            (char*)_registry->rows + (_index * _registry->row_size),
+            (char*)_registry->rows + ((_index + 1) * _registry->row_size),
+            (_registry->count - (_index + 1)) * _registry->row_size
+        );
+    }
+
+    _registry->count -= 1;
+
+    // Remove lookup entries pointing to this row and shift indices above it.
+    sorted = _registry->lookup_sorted;
+    w      = 0;
+    for (i = 0; i < _registry->lookup_count; ++i)
+    {
+        struct d_registry_lookup_entry e = _registry->lookup[i];
+
+        if (e.row_index == _index)
+        {
+            if (i < sorted)
+            {
+                _registry->lookup_sorted -= 1;
+            }
+
+            continue; // drop canonical + aliases pointing to removed row
+        }
+
+        if (e.row_index > _index)
+        {
+            e.row_index -= 1;
+        }
+
+        _registry->lookup[w++] = e;
+    }
+
+    _registry->lookup_count = w;
+
+    d_registry_resort_lookup(_registry);
+    d_registry_hash_rebuild(_registry);
+
+    return true;
+}
+
+bool
+d_registry_remove
+(
+    struct d_registry* _registry,
+    const char* _key
+)
+{
+    size_t row_index;
+
+    if (!d_registry_resolve_row(_registry, _key, &row_index))
+    {
+        return false;
+    }
+
+    return d_registry_remove_at(_registry, row_index);
+}
+
+void
+d_registry_clear
+(
+    struct d_registry* _registry
+)
+{
+    size_t i;
+
+    // an external registry's lookup must stay in step with its indexes
+    if ( (!_registry) ||
+         (d_registry_is_external(_registry)) )
+    {
+        return;
+    }
+
+    if (d_registry_is_static(_registry))
+    {
+        // Static registry tables are immutable; just drop lookup view.
+        _registry->lookup_count  = 0;
+        _registry->lookup_sorted = 0;
+        d_registry_arena_free(&_registry->fold_arena);
+        d_registry_hash_rebuild(_registry);
+        d_registry_perfect_refresh(_registry);
+        _registry->count        = _registry->count; // no-op clarity
+        return;
+    }
+
+    if ((_registry->flags & D_REGISTRY_FLAG_OWNS_ROWS) != 0 && _registry->row_free)
+    {
+        for (i = 0; i < _registry->count; ++i)
+        {
+            void* row = d_registry_row_ptr(_registry, i);
+
+            if (!D_REGISTRY_ROW_IS_DEAD(row))
+            {
+                _registry->row_free(row);
+            }
+        }
+    }
+
+    _registry->count         = 0;
+    _registry->dead_count    = 0;
+    _registry->lookup_count  = 0;
+    _registry->lookup_sorted = 0;
+
+    d_registry_arena_free(&_registry->arena);
+    d_registry_arena_free(&_registry->fold_arena);
+
+    if (_registry->hash_slots)
+    {
+        memset(_registry->hash_slots,
+               0,
+               _registry->hash_capacity * sizeof(struct d_registry_hash_slot));
+        _registry->hash_count = 0;
+    }
+
+    d_registry_perfect_refresh(_registry);
+}
+
+bool
+d_registry_compact
+(
+    struct d_registry* _registry
+)
+{
+    if (!_registry)
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    return d_registry_compact_rows(_registry);
+}
+
+
+/******************************************************************************
+ * ALIASES
+ *****************************************************************************/
+
+bool
+d_registry_add_alias
+(
+    struct d_registry* _registry,
+    const char* _key,
+    const char* _alias
+)
+{
+    struct d_registry_lookup_entry* e;
+    size_t row_index;
+
+    if (!_registry || !_key || !_alias)
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    e = d_registry_find_lookup_entry(_registry, _key);
+    if (!e)
+    {
+        return false;
+    }
+
+    row_index = e->row_index;
+
+    // alias already in use (as key or alias); staged collisions are
+    // resolved by d_registry_end_batch
+    if (d_registry_find_sorted_entry(_registry, _alias))
+    {
+        return false;
+    }
+
+    if (!d_registry_ensure_lookup_capacity(_registry, _registry->lookup_count + 1))
+    {
+        return false;
+    }
+
+    _registry->lookup[_registry->lookup_count].key       = _alias;
+    _registry->lookup[_registry->lookup_count].row_index = row_index;
+    d_registry_init_entry_caches(_registry, &_registry->lookup[_registry->lookup_count]);
+    _registry->lookup_count += 1;
+
+    d_registry_resort_lookup(_registry);
+    d_registry_hash_insert(_registry, _alias, row_index);
+
+    return true;
+}
+
+bool
+d_registry_add_aliases
+(
+    struct d_registry* _registry,
+    const char* _key,
+    const char** _aliases,
+    size_t _count
+)
+{
+    size_t i;
+
+    if (!_registry || !_key || !_aliases || _count == 0)
+    {
+        return false;
+    }
+
+    for (i = 0; i < _count; ++i)
+    {
+        if (!d_registry_add_alias(_registry, _key, _aliases[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+d_registry_remove_alias
+(
+    struct d_registry* _registry,
+    const char* _alias
+)
+{
+    struct d_registry_lookup_entry* e;
+    size_t i;
+    size_t idx;
+
+    if (!_registry || !_alias)
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    e = d_registry_find_lookup_entry(_registry, _alias);
+    if (!e)
+    {
+        return false;
+    }
+
+    // Dont remove canonical keys via remove_alias.
+    if (d_registry_lookup_entry_is_canonical(_registry, e))
+    {
+        return false;
+    }
+
+    idx = (size_t)(e - _registry->lookup);
+
+    for (i = idx + 1; i < _registry->lookup_count; ++i)
+    {
+        _registry->lookup[i - 1] = _registry->lookup[i];
+    }
+
+    _registry->lookup_count -= 1;
+
+    if (idx < _registry->lookup_sorted)
+    {
+        _registry->lookup_sorted -= 1;
+    }
+
+    d_registry_hash_erase(_registry, _alias);
+    d_registry_perfect_refresh(_registry);
+
+    return true;
+}
+
+void
+d_registry_clear_aliases
+(
+    struct d_registry* _registry
+)
+{
+    size_t i;
+    size_t w;
+    size_t sorted;
+
+    if (!_registry)
+    {
+        return;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return;
+    }
+
+    sorted = _registry->lookup_sorted;
+    w      = 0;
+    for (i = 0; i < _registry->lookup_count; ++i)
+    {
+        if (d_registry_lookup_entry_is_canonical(_registry, &_registry->lookup[i]))
+        {
+            _registry->lookup[w++] = _registry->lookup[i];
+        }
+        else if (i < sorted)
+        {
+            _registry->lookup_sorted -= 1;
+        }
+    }
+
+    _registry->lookup_count = w;
+
+    d_registry_resort_lookup(_registry);
+    d_registry_hash_rebuild(_registry);
+}
+
+size_t
+d_registry_alias_count
+(
+    const struct d_registry* _registry
+)
+{
+    size_t i;
+    size_t n = 0;
+
+    if (!_registry)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < _registry->lookup_count; ++i)
+    {
+        if (!d_registry_lookup_entry_is_canonical(_registry, &_registry->lookup[i]))
+        {
+            n += 1;
+        }
+    }
+
+    return n;
+}
+
+
+/******************************************************************************
+ * INTERNED KEYS
+ *****************************************************************************/
+
+const char*
+d_registry_intern
+(
+    struct d_registry* _registry,
+    const char* _str
+)
+{
+    struct d_registry_interned*     in;
+    struct d_registry_lookup_entry* e;
+    size_t                          len;
+
+    if (!_registry || !_str)
+    {
+        return NULL;
+    }
+
+    // an entry with the same bytes whose key is already interned is shared
+    e = d_registry_find_lookup_entry(_registry, _str);
+
+    if ( (e) &&
+         (strcmp(e->key, _str) == 0) &&
+         (d_registry_arena_find(_registry, e->key)) )
+    {
+        return e->key;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return NULL;
+    }
+
+    len = strlen(_str);
+    if (len >= UINT32_MAX)
+    {
+        return NULL;
+    }
+
+    in = (struct d_registry_interned*)d_registry_arena_alloc(
+        &_registry->arena,
+        sizeof(struct d_registry_interned) + len + 1);
+    if (!in)
+    {
+        return NULL;
+    }
+
+    memcpy(in + 1, _str, len + 1);
+
+    in->length = (uint32_t)len;
+    in->nocase = (uint32_t)((_registry->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) != 0);
+    in->hash   = d_registry_hash_key(_registry, (const char*)(in + 1));
+
+    return (const char*)(in + 1);
+}
+
+bool
+d_registry_is_interned
+(
+    const struct d_registry* _registry,
+    const char* _key
+)
+{
+    return _registry && _key && (d_registry_arena_find(_registry, _key) != NULL);
+}
+
+bool
+d_registry_add_intern
+(
+    struct d_registry* _registry,
+    const void* _row
+)
+{
+    struct d_registry_arena_block* mark;
+    size_t                         mark_used;
+    const char*                    key;
+    void*                          row;
+    bool                           ok;
+
+    if (!_registry || !_row || !D_REGISTRY_ROW_KEY(_row))
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    mark      = _registry->arena;
+    mark_used = (mark) ? mark->used : 0;
+
+    key = d_registry_intern(_registry, D_REGISTRY_ROW_KEY(_row));
+    row = malloc(_registry->row_size);
+    ok  = (key != NULL) && (row != NULL);
+
+    if (ok)
+    {
+        memcpy(row, _row, _registry->row_size);
+        memcpy(row, &key, sizeof(key));
+
+        ok = d_registry_add(_registry, row);
+    }
+
+    free(row);
+
+    if (!ok)
+    {
+        d_registry_arena_rollback(_registry, mark, mark_used);
+    }
+
+    return ok;
+}
+
+bool
+d_registry_add_rows_intern
+(
+    struct d_registry* _registry,
+    const void* _rows,
+    size_t _count
+)
+{
+    size_t i;
+    bool   ok;
+
+    if (!_registry || !_rows || _count == 0)
+    {
+        return false;
+    }
+
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    {
+        return false;
+    }
+
+    if ( (!d_registry_ensure_row_capacity(_registry, _registry->count + _count)) ||
+         (!d_registry_ensure_lookup_capacity(_registry, _registry->lookup_count + _count)) )
+    {
+        return false;
+    }
+
+    if (!d_registry_begin_batch(_registry))
+    {
+        return false;
+    }
+
+    ok = true;
+
+    for (i = 0; i < _count; ++i)
+    {
+        const void* row = (const void*)((const char*)_rows + (i * _registry->row_size));
+
+        if (!d_registry_add_intern(_registry, row))
+        {
+            ok = false;
+        }
+    }
+
+    return d_registry_end_batch(_registry) && ok;
+}
+
+bool
+d_registry_add_alias_intern
+(
+    struct d_registry* _registry,
+    const char* _key,
+    const char* _alias
+)
+{
+    struct d_registry_arena_block* mark;
+    size_t                         mark_used;
+    const char*                    alias;
+    bool                           ok;
+
+    if (!_registry || !_key || !_alias)
+    {
+        return false;
+    }
+
+    mark      = _registry->arena;
+    mark_used = (mark) ? mark->used : 0;
+
+    alias = d_registry_intern(_registry, _alias);
+    ok    = (alias != NULL) && d_registry_add_alias(_registry, _key, alias);
+
+    if (!ok)
+    {
+        d_registry_arena_rollback(_registry, mark, mark_used);
+    }
+
+    return ok;
+}
+
+
+/******************************************************************************
+ * QUERIES
+ *****************************************************************************/
+
+bool
+d_registry_contains
+(
+    const struct d_registry* _registry,
+    const char* _key
+)
+{
+    return (d_registry_index_of(_registry, _key) >= 0);
+}
+
+ssize_t
+d_registry_index_of
+(
+    const struct d_registry* _registry,
+    const char* _key
+)
+{
+    size_t row_index;
+
+    if (!d_registry_resolve_row(_registry, _key, &row_index))
+    {
+        return (ssize_t)-1;
+    }
+
+    return (ssize_t)row_index;
+}
+
+void*
+d_registry_at
+(
+    const struct d_registry* _registry,
+    size_t _index
+)
+{
+    void* row;
+
+    if (!_registry || _index >= _registry->count)
+    {
+        return NULL;
+    }
+
+    row = d_registry_row_ptr(_registry, _index);
+
+    return (row && D_REGISTRY_ROW_IS_DEAD(row)) ? NULL : row;
+}
+
+size_t
+d_registry_count
+(
+    const struct d_registry* _registry
+)
+{
+    return _registry ? (_registry->count - _registry->dead_count) : 0;
+}
+
+size_t
+d_registry_capacity
+(
+    const struct d_registry* _registry
+)
+{
+    return _registry ? _registry->capacity : 0;
+}
+
+bool
+d_registry_is_empty
+(
+    const struct d_registry* _registry
+)
+{
+    return !_registry || (_registry->count == _registry->dead_count);
+}
+
+
+/******************************************************************************
+ * BATCHES
+ *****************************************************************************/
+
+// D_INTERNAL_REGISTRY_ROW_DEAD / D_INTERNAL_REGISTRY_ROW_UNPLACED
+//   constants: sentinel row remap values used while committing a batch.
+#define D_INTERNAL_REGISTRY_ROW_DEAD     ((size_t)-1)
+#define D_INTERNAL_REGISTRY_ROW_UNPLACED ((size_t)-2)
+
+// d_registry_lookup_compare_batch
+//   orders by key, then by row index so that older rows precede staged ones.
+static int
+d_registry_lookup_compare_batch
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
+    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
+    int cmp = d_registry_keycmp_case_sensitive(a->key, b->key);
+
+    if (cmp != 0) return cmp;
+    if (a->row_index == b->row_index) return 0;
+    return (a->row_index < b->row_index) ? -1 : 1;
+}
+
+static int
+d_registry_lookup_compare_batch_nocase
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
+    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
+    int cmp = d_registry_keycmp_nocase(a->key, b->key);
+
+    if (cmp != 0) return cmp;
+    if (a->row_index == b->row_index) return 0;
+    return (a->row_index < b->row_index) ? -1 : 1;
+}
+
+static size_t
+d_registry_lookup_run_end
+(
+    const struct d_registry* _reg,
+    size_t _start
+)
+{
+    size_t end = _start + 1;
+
+    while ( (end < _reg->lookup_count) &&
+            (d_registry_keycmp_for_reg(_reg,
+                                       _reg->lookup[_start].key,
+                                       _reg->lookup[end].key) == 0) )
+    {
+        end += 1;
+    }
+
+    return end;
+}
+
+// d_registry_commit_batch
+//   sorts the lookup once, drops colliding entries, then compacts (and for
+// SORTED registries reorders) the rows and remaps every row_index in one pass.
+static bool
+d_registry_commit_batch
+(
+    struct d_registry* _reg
+)
+{
+    size_t* remap;
+    void*   new_rows;
+    size_t  i;
+    size_t  j;
+    size_t  k;
+    size_t  w;
+    size_t  next;
+    size_t  old_count;
+    bool    clean;
+    bool    in_place;
+
+    // tombstones would otherwise need their own remap entries below
+    if (!d_registry_compact_rows(_reg))
+    {
+        d_registry_sort_lookup(_reg);
+        return false;
+    }
+
+    old_count = _reg->count;
+    remap     = NULL;
+    new_rows  = NULL;
+    clean     = true;
+
+    if (old_count > 0)
+    {
+        remap = (size_t*)malloc(old_count * sizeof(size_t));
+    }
+
+    if (old_count > 0 && !remap)
+    {
+        // Still leave a searchable registry behind.
+        d_registry_sort_lookup(_reg);
+        return false;
+    }
+
+    // the commit sorts without d_registry_sort_lookup; fold staged entries here
+    d_registry_refresh_folded(_reg);
+
+    if (_reg->lookup && _reg->lookup_count > 1)
+    {
+        qsort(_reg->lookup,
+              _reg->lookup_count,
+              sizeof(struct d_registry_lookup_entry),
+              ((_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) == 0)
+                ? d_registry_lookup_compare_batch
+                : d_registry_lookup_compare_batch_nocase);
+    }
+
+    for (i = 0; i < old_count; ++i)
+    {
+        remap[i] = D_INTERNAL_REGISTRY_ROW_UNPLACED;
+    }
+
+    // Pass 1: a canonical key shadowed by an older row's canonical key kills
+    // the newer row.
+    for (i = 0; i < _reg->lookup_count; i = j)
+    {
+        size_t kept = D_INTERNAL_REGISTRY_ROW_DEAD;
+
+        j = d_registry_lookup_run_end(_reg, i);
+
+        if (j - i < 2)
+        {
+            continue;
+        }
+
+        for (k = i; k < j; ++k)
+        {
+            size_t row = _reg->lookup[k].row_index;
+
+            if (!d_registry_lookup_entry_is_canonical(_reg, &_reg->lookup[k]))
+            {
+                continue;
+            }
+
+            if (kept == D_INTERNAL_REGISTRY_ROW_DEAD)
+            {
+                kept = row;
+            }
+            else if (row != kept)
+            {
+                remap[row] = D_INTERNAL_REGISTRY_ROW_DEAD;
+            }
+        }
+    }
+
+    // Pass 2: keep one live entry per key, preferring the canonical one.
+    w = 0;
+    for (i = 0; i < _reg->lookup_count; i = j)
+    {
+        size_t winner = D_INTERNAL_REGISTRY_ROW_DEAD;
+
+        j = d_registry_lookup_run_end(_reg, i);
+
+        for (k = i; k < j; ++k)
+        {
+            size_t row = _reg->lookup[k].row_index;
+
+            if ( (row >= old_count) ||
+                 (remap[row] == D_INTERNAL_REGISTRY_ROW_DEAD) )
+            {
+                continue;
+            }
+
+            if (winner == D_INTERNAL_REGISTRY_ROW_DEAD)
+            {
+                winner = k;
+            }
+
+            if ( (j - i == 1) ||
+                 d_registry_lookup_entry_is_canonical(_reg, &_reg->lookup[k]) )
+            {
+                winner = k;
+                break;
+            }
+        }
+
+        if (winner != D_INTERNAL_REGISTRY_ROW_DEAD)
+        {
+            _reg->lookup[w++] = _reg->lookup[winner];
+        }
+
+        if ((j - i) != ((winner != D_INTERNAL_REGISTRY_ROW_DEAD) ? 1u : 0u))
+        {
+            clean = false;
+        }
+    }
+
+    _reg->lookup_count  = w;
+    _reg->lookup_sorted = w;
+
+    // Pass 3: assign final row positions. SORTED registries take the order of
+    // their canonical entries, which the lookup already holds in key order.
+    next = 0;
+
+    if ((_reg->flags & D_REGISTRY_FLAG_SORTED) != 0)
+    {
+        for (i = 0; i < _reg->lookup_count; ++i)
+        {
+            size_t row = _reg->lookup[i].row_index;
+
+            if ( (remap[row] == D_INTERNAL_REGISTRY_ROW_UNPLACED) &&
+                 d_registry_lookup_entry_is_canonical(_reg, &_reg->lookup[i]) )
+            {
+                remap[row] = next++;
+            }
+        }
+    }
+
+    for (i = 0; i < old_count; ++i)
+    {
+        if (remap[i] == D_INTERNAL_REGISTRY_ROW_UNPLACED)
+        {
+            remap[i] = next++;
+        }
+    }
+
+    // Pass 4: move the rows. Compaction alone only ever moves rows down, so
+    // it can be done in place; a reorder needs a second buffer.
+    in_place = true;
+    for (i = 0, k = 0; i < old_count; ++i)
+    {
+        if (remap[i] == D_INTERNAL_REGISTRY_ROW_DEAD)
+        {
+            continue;
+        }
+
+        if (remap[i] != k++)
+        {
+            in_place = false;
+            break;
+        }
+    }
+
+    if (!in_place)
+    {
+        new_rows = malloc(_reg->capacity * _reg->row_size);
+
+        if (!new_rows)
+        {
+            // Fall back to insertion order; lookup stays consistent.
+            clean = false;
+            for (i = 0, k = 0; i < old_count; ++i)
+            {
+                if (remap[i] != D_INTERNAL_REGISTRY_ROW_DEAD)
+                {
+                    remap[i] = k++;
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < old_count; ++i)
+    {
+        void* row = d_registry_row_ptr(_reg, i);
+
+        if (remap[i] == D_INTERNAL_REGISTRY_ROW_DEAD)
+        {
+            // The registry accepted the row when it was staged.
+            if ((_reg->flags & D_REGISTRY_FLAG_OWNS_ROWS) != 0 && _reg->row_free)
+            {
+                _reg->row_free(row);
+            }
+
+            continue;
+        }
+
+        if (new_rows)
+        {
+            memcpy((char*)new_rows + (remap[i] * _reg->row_size), row, _reg->row_size);
+        }
+        else if (remap[i] != i)
+        {
+            memmove(d_registry_row_ptr(_reg, remap[i]), row, _reg->row_size);
+        }
     }
 
-    e = d_registry_find_lookup_entry(_registry, _key);
-    if (!e)
+    if (new_rows)
     {
-        return false;
+        free(_reg->rows);
+        _reg->rows = new_rows;
     }
 
-    row_index = e->row_index;
+    _reg->count = next;
 
-    if (d_registry_contains(_registry, _alias))
+    for (i = 0; i < _reg->lookup_count; ++i)
     {
-        return false; // alias already in use (as key or alias)
+        _reg->lookup[i].row_index = remap[_reg->lookup[i].row_index];
     }
 
-    if (!d_registry_ensure_lookup_capacity(_registry, _registry->lookup_count + 1))
+    free(remap);
+
+    if (!d_registry_hash_rebuild(_reg))
     {
-        return false;
+        clean = false;
     }
 
-    _registry->lookup[_registry->lookup_count].key       = _alias;
-    _registry->lookup[_registry->lookup_count].row_index = row_index;
-    _registry->lookup_count += 1;
-
-    d_registry_sort_lookup(_registry);
+    d_registry_perfect_refresh(_reg);
 
-    return true;
+    return clean;
 }
 
 bool
-d_registry_add_aliases
+d_registry_begin_batch
 (
-    struct d_registry* _registry,
-    const char* _key,
-    const char** _aliases,
-    size_t _count
+    struct d_registry* _registry
 )
 {
-    size_t i;
+    if (!_registry)
+    {
+        return false;
+    }
 
-    if (!_registry || !_key || !_aliases || _count == 0)
+    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
     {
         return false;
     }
 
-    for (i = 0; i < _count; ++i)
+    if (_registry->batch_depth == 0)
     {
-        if (!d_registry_add_alias(_registry, _key, _aliases[i]))
-        {
-            return false;
-        }
+        _registry->lookup_sorted = _registry->lookup_count;
+        d_registry_drop_perfect_hash(_registry);
     }
 
+    _registry->batch_depth += 1;
+
     return true;
 }
 
 bool
-d_registry_remove_alias
+d_registry_end_batch
 (
-    struct d_registry* _registry,
-    const char* _alias
+    struct d_registry* _registry
 )
 {
-    struct d_registry_lookup_entry* e;
-    size_t i;
-    size_t idx;
-
-    if (!_registry || !_alias)
-    {
-        return false;
-    }
-
-    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    if (!_registry || _registry->batch_depth == 0)
     {
         return false;
     }
 
-    e = d_registry_find_lookup_entry(_registry, _alias);
-    if (!e)
-    {
-        return false;
-    }
+    _registry->batch_depth -= 1;
 
-    // Dont remove canonical keys via remove_alias.
-    if (d_registry_lookup_entry_is_canonical(_registry, e))
+    if (_registry->batch_depth > 0)
     {
-        return false;
+        return true;
     }
 
-    idx = (size_t)(e - _registry->lookup);
+    return d_registry_commit_batch(_registry);
+}
 
-    for (i = idx + 1; i < _registry->lookup_count; ++i)
-    {
-        _registry->lookup[i - 1] = _registry->lookup[i];
-    }
+bool
+d_registry_in_batch
+(
+    const struct d_registry* _registry
+)
+{
+    return d_registry_is_batching(_registry);
+}
 
-    _registry->lookup_count -= 1;
 
-    return true;
-}
+/******************************************************************************
+ * RANGE QUERIES
+ *****************************************************************************/
 
-void
-d_registry_clear_aliases
+// d_registry_prefix_cmp
+//   compares the first `_len` bytes of `_key` against `_prefix`; 0 means the
+// key starts with the prefix. Monotone over the sorted lookup.
+static int
+d_registry_prefix_cmp
 (
-    struct d_registry* _registry
+    const char* _key,
+    const char* _prefix,
+    size_t      _len,
+    bool        _nocase
 )
 {
-    size_t i;
-    size_t w;
+    unsigned char ck;
+    unsigned char cp;
+    size_t        i;
 
-    if (!_registry)
+    if (!_key)
     {
-        return;
+        return -1;
     }
 
-    if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry))
+    for (i = 0; i < _len; ++i)
     {
-        return;
-    }
+        ck = (unsigned char)_key[i];
+        cp = (unsigned char)_prefix[i];
 
-    w = 0;
-    for (i = 0; i < _registry->lookup_count; ++i)
-    {
-        if (d_registry_lookup_entry_is_canonical(_registry, &_registry->lookup[i]))
+        if (_nocase)
         {
-            _registry->lookup[w++] = _registry->lookup[i];
+            ck = (unsigned char)tolower(ck);
+            cp = (unsigned char)tolower(cp);
         }
-    }
 
-    _registry->lookup_count = w;
+        if (ck != cp)
+        {
+            return (ck < cp) ? -1 : 1;
+        }
+    }
 
-    d_registry_sort_lookup(_registry);
+    return 0;
 }
 
-size_t
-d_registry_alias_count
+// d_registry_sorted_count
+//   number of lookup entries that are in sorted order.
+static size_t
+d_registry_sorted_count
 (
-    const struct d_registry* _registry
+    const struct d_registry* _reg
 )
 {
-    size_t i;
-    size_t n = 0;
-
-    if (!_registry)
+    if (!_reg->lookup)
     {
         return 0;
     }
 
-    for (i = 0; i < _registry->lookup_count; ++i)
+    return d_registry_is_batching(_reg) ? _reg->lookup_sorted
+                                        : _reg->lookup_count;
+}
+
+// d_registry_lower_bound
+//   first sorted lookup index whose key is not less than `_key`.
+static size_t
+d_registry_lower_bound
+(
+    const struct d_registry* _reg,
+    const char* _key
+)
+{
+    size_t lo = 0;
+    size_t hi = d_registry_sorted_count(_reg);
+    size_t mid;
+
+    while (lo < hi)
     {
-        if (!d_registry_lookup_entry_is_canonical(_registry, &_registry->lookup[i]))
+        mid = lo + ((hi - lo) / 2);
+
+        if (d_registry_keycmp_for_reg(_reg, _reg->lookup[mid].key, _key) < 0)
         {
-            n += 1;
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
         }
     }
 
-    return n;
+    return lo;
 }
 
-
-/******************************************************************************
- * QUERIES
- *****************************************************************************/
-
-bool
-d_registry_contains
+// d_registry_prefix_bound
+//   first sorted lookup index whose key compares >= (or, with `_upper`, >)
+// the prefix under d_registry_prefix_cmp.
+static size_t
+d_registry_prefix_bound
 (
-    const struct d_registry* _registry,
-    const char* _key
+    const struct d_registry* _reg,
+    const char* _prefix,
+    size_t      _len,
+    bool        _upper
 )
 {
-    return (d_registry_index_of(_registry, _key) >= 0);
+    bool   nocase = (_reg->flags & D_REGISTRY_FLAG_CASE_INSENSITIVE) != 0;
+    size_t lo     = 0;
+    size_t hi     = d_registry_sorted_count(_reg);
+    size_t mid;
+    int    cmp;
+
+    while (lo < hi)
+    {
+        mid = lo + ((hi - lo) / 2);
+        cmp = d_registry_prefix_cmp(_reg->lookup[mid].key, _prefix, _len, nocase);
+
+        if ( (cmp < 0) ||
+             (_upper && (cmp == 0)) )
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
 }
 
-ssize_t
-d_registry_index_of
+struct d_registry_slice
+d_registry_find_prefix
 (
     const struct d_registry* _registry,
-    const char* _key
+    const char* _prefix
 )
 {
-    struct d_registry_lookup_entry* e;
+    struct d_registry_slice slice;
+    size_t                  len;
 
-    if (!_registry || !_key)
-    {
-        return (ssize_t)-1;
-    }
+    slice.first = NULL;
+    slice.last  = NULL;
 
-    e = d_registry_find_lookup_entry(_registry, _key);
-    if (!e)
+    if ( (!_registry) ||
+         (!_prefix)   ||
+         (!_registry->lookup) )
     {
-        return (ssize_t)-1;
+        return slice;
     }
 
-    return (ssize_t)e->row_index;
+    len = strlen(_prefix);
+
+    slice.first = _registry->lookup +
+                  d_registry_prefix_bound(_registry, _prefix, len, false);
+    slice.last  = _registry->lookup +
+                  d_registry_prefix_bound(_registry, _prefix, len, true);
+
+    return slice;
 }
 
-void*
-d_registry_at
+struct d_registry_slice
+d_registry_range
 (
     const struct d_registry* _registry,
-    size_t _index
+    const char* _low,
+    const char* _high
 )
 {
-    if (!_registry || _index >= _registry->count)
+    struct d_registry_slice slice;
+    size_t                  first;
+    size_t                  last;
+
+    slice.first = NULL;
+    slice.last  = NULL;
+
+    if ( (!_registry) ||
+         (!_registry->lookup) )
     {
-        return NULL;
+        return slice;
     }
 
-    return d_registry_row_ptr(_registry, _index);
-}
+    first = (_low)  ? d_registry_lower_bound(_registry, _low)
+                    : 0;
+    last  = (_high) ? d_registry_lower_bound(_registry, _high)
+                    : d_registry_sorted_count(_registry);
 
-size_t
-d_registry_count
-(
-    const struct d_registry* _registry
-)
-{
-    return _registry ? _registry->count : 0;
-}
+    // an inverted interval is empty
+    if (last < first)
+    {
+        last = first;
+    }
 
-size_t
-d_registry_capacity
-(
-    const struct d_registry* _registry
-)
-{
-    return _registry ? _registry->capacity : 0;
-}
+    slice.first = _registry->lookup + first;
+    slice.last  = _registry->lookup + last;
 
-bool
-d_registry_is_empty
-(
-    const struct d_registry* _registry
-)
-{
-    return !_registry || _registry->count == 0;
+    return slice;
 }
 
 
@@ -1045,10 +3596,12 @@ d_registry_iterator_new
 )
 {
     struct d_registry_iterator it;
-    it.registry   = _registry;
-    it.current    = 0;
-    it.filter     = NULL;
-    it.filter_ctx = NULL;
+    it.registry    = _registry;
+    it.current     = 0;
+    it.filter      = NULL;
+    it.filter_ctx  = NULL;
+    it.slice.first = NULL;
+    it.slice.last  = NULL;
     return it;
 }
 
@@ -1061,13 +3614,74 @@ d_registry_iterator_filtered
 )
 {
     struct d_registry_iterator it;
-    it.registry   = _registry;
-    it.current    = 0;
-    it.filter     = _filter;
-    it.filter_ctx = _context;
+    it.registry    = _registry;
+    it.current     = 0;
+    it.filter      = _filter;
+    it.filter_ctx  = _context;
+    it.slice.first = NULL;
+    it.slice.last  = NULL;
+    return it;
+}
+
+struct d_registry_iterator
+d_registry_iterator_slice
+(
+    struct d_registry* _registry,
+    struct d_registry_slice _slice
+)
+{
+    struct d_registry_iterator it;
+
+    it       = d_registry_iterator_new(_registry);
+    it.slice = _slice;
+
+    // an empty slice iterates nothing rather than the whole registry
+    if (_slice.first == _slice.last)
+    {
+        it.registry = NULL;
+    }
+
     return it;
 }
 
+struct d_registry_iterator
+d_registry_iterator_prefix
+(
+    struct d_registry* _registry,
+    const char* _prefix
+)
+{
+    return d_registry_iterator_slice(_registry,
+                                     d_registry_find_prefix(_registry, _prefix));
+}
+
+// d_registry_iterator_end
+//   one past the last position the iterator visits.
+static size_t
+d_registry_iterator_end
+(
+    const struct d_registry_iterator* _iter
+)
+{
+    return (_iter->slice.first) ? D_REGISTRY_SLICE_COUNT(_iter->slice)
+                                : _iter->registry->count;
+}
+
+// d_registry_iterator_row
+//   row at iterator position `_pos`.
+static void*
+d_registry_iterator_row
+(
+    const struct d_registry_iterator* _iter,
+    size_t _pos
+)
+{
+    return d_registry_row_ptr(_iter->registry,
+                              (_iter->slice.first)
+                                ? _iter->slice.first[_pos].row_index
+                                : _pos);
+}
+
 bool
 d_registry_iterator_has_next
 (
@@ -1081,15 +3695,16 @@ d_registry_iterator_has_next
         return false;
     }
 
-    if (!_iter->filter)
+    for (i = _iter->current; i < d_registry_iterator_end(_iter); ++i)
     {
-        return _iter->current < _iter->registry->count;
-    }
+        void* row = d_registry_iterator_row(_iter, i);
 
-    for (i = _iter->current; i < _iter->registry->count; ++i)
-    {
-        void* row = d_registry_row_ptr(_iter->registry, i);
-        if (_iter->filter(row, _iter->filter_ctx))
+        if (D_REGISTRY_ROW_IS_DEAD(row))
+        {
+            continue;
+        }
+
+        if (!_iter->filter || _iter->filter(row, _iter->filter_ctx))
         {
             return true;
         }
@@ -1109,11 +3724,16 @@ d_registry_iterator_next
         return NULL;
     }
 
-    while (_iter->current < _iter->registry->count)
+    while (_iter->current < d_registry_iterator_end(_iter))
     {
-        void* row = d_registry_row_ptr(_iter->registry, _iter->current);
+        void* row = d_registry_iterator_row(_iter, _iter->current);
         _iter->current += 1;
 
+        if (D_REGISTRY_ROW_IS_DEAD(row))
+        {
+            continue;
+        }
+
         if (!_iter->filter || _iter->filter(row, _iter->filter_ctx))
         {
             return row;
@@ -1153,6 +3773,12 @@ d_registry_foreach
     for (i = 0; i < _registry->count; ++i)
     {
         void* row = d_registry_row_ptr(_registry, i);
+
+        if (D_REGISTRY_ROW_IS_DEAD(row))
+        {
+            continue;
+        }
+
         if (!_visitor(row, _context))
         {
             break;
@@ -1181,7 +3807,8 @@ d_registry_foreach_if
     {
         void* row = d_registry_row_ptr(_registry, i);
 
-        if (_predicate && !_predicate(row, _pred_ctx))
+        if ( (D_REGISTRY_ROW_IS_DEAD(row)) ||
+             (_predicate && !_predicate(row, _pred_ctx)) )
         {
             continue;
         }
@@ -1246,6 +3873,8 @@ d_registry_shrink_to_fit
     if (!_registry) return false;
     if (d_registry_is_frozen(_registry) || d_registry_is_static(_registry)) return false;
 
+    if (!d_registry_is_batching(_registry) && !d_registry_compact_rows(_registry)) return false;
+
     if (_registry->capacity > _registry->count)
     {
         rows_new = realloc(_registry->rows, _registry->count * _registry->row_size);
@@ -1275,7 +3904,20 @@ d_registry_freeze
 )
 {
     if (!_registry) return false;
+
+    // already frozen with its perfect hash, or frozen for good
+    if ( (d_registry_is_external(_registry)) ||
+         ( (d_registry_is_frozen(_registry)) &&
+           (_registry->perfect_hash) ) )
+    {
+        return true;
+    }
+
     _registry->flags |= (uint8_t)D_REGISTRY_FLAG_FROZEN;
+
+    // Best effort: without a perfect hash, lookups use the other indexes.
+    d_registry_perfect_refresh(_registry);
+
     return true;
 }
 
@@ -1286,7 +3928,12 @@ d_registry_thaw
 )
 {
     if (!_registry) return false;
+
+    // the lookup and indexes of an external registry are read-only
+    if (d_registry_is_external(_registry)) return false;
+
     _registry->flags &= (uint8_t)~D_REGISTRY_FLAG_FROZEN;
+    d_registry_drop_perfect_hash(_registry);
     return true;
 }
 
@@ -1350,5 +3997,14 @@ d_registry_free
         free(_registry->lookup);
     }
 
+    d_registry_arena_free(&_registry->arena);
+    d_registry_arena_free(&_registry->fold_arena);
+
+    if (!d_registry_is_external(_registry))
+    {
+        free(_registry->hash_slots);
+        free(_registry->perfect_hash);
+    }
+
     free(_registry);
 }
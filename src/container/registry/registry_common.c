@@ -1,5 +1,8 @@
 #include "..\..\..\inc\container\registry\registry_common.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 
 
 //==============================================================================
@@ -117,3 +120,423 @@ d_registry_schema_max_enum_key
 
     return max_key;
 }
+
+
+//==============================================================================
+// Name lookup
+//==============================================================================
+
+// d_internal_cvar_hash
+//   function: 32-bit FNV-1a over a name, ASCII-folded unless case-sensitive.
+static uint32_t
+d_internal_cvar_hash
+(
+    const char* _name,
+    bool        _case_sensitive
+)
+{
+    const unsigned char* p = (const unsigned char*)_name;
+    uint32_t             h = 2166136261u;
+
+    if ( _case_sensitive )
+    {
+        while ( *p != 0u )
+        {
+            h ^= (uint32_t)*p++;
+            h *= 16777619u;
+        }
+    }
+    else
+    {
+        while ( *p != 0u )
+        {
+            h ^= (uint32_t)d_internal_ascii_tolower(*p++);
+            h *= 16777619u;
+        }
+    }
+
+    return h;
+}
+
+// d_internal_cvar_case_sensitive
+//   function: true if the registry compares names case-sensitively.
+static bool
+d_internal_cvar_case_sensitive
+(
+    const struct d_cvar_registry* _registry
+)
+{
+    return (_registry->flags & D_CVAR_REGISTRY_FLAG_CASE_SENSITIVE) != 0u;
+}
+
+// d_internal_cvar_lookup_put
+//   function: inserts a name, skipping exact repeats of the same alias.
+//   return:
+//     false if the name is already bound to a different enum_key.
+static bool
+d_internal_cvar_lookup_put
+(
+    struct d_cvar_lookup_slot* _slots,
+    size_t                     _capacity,
+    const char*                _name,
+    uint16_t                   _enum_key,
+    bool                       _case_sensitive
+)
+{
+    const uint32_t hash = d_internal_cvar_hash(_name, _case_sensitive);
+    size_t         i    = (size_t)hash & (_capacity - 1u);
+
+    while ( _slots[i].name )
+    {
+        if ( (_slots[i].hash == hash) &&
+             (d_registry_strcmp(_slots[i].name, _name, _case_sensitive) == 0) )
+        {
+            return _slots[i].enum_key == _enum_key;
+        }
+
+        i = (i + 1u) & (_capacity - 1u);
+    }
+
+    _slots[i].name     = _name;
+    _slots[i].hash     = hash;
+    _slots[i].enum_key = _enum_key;
+
+    return true;
+}
+
+// d_cvar_registry_build_lookup
+//   function: (re)builds the name lookup from the schema at load <= 1/2.
+//   return:
+//     false on allocation failure, or if a name maps to two enum_keys (the
+//     registry is then left without a lookup).
+bool
+d_cvar_registry_build_lookup
+(
+    struct d_cvar_registry* _registry
+)
+{
+    struct d_cvar_lookup_slot* slots;
+    size_t                     capacity;
+    size_t                     names;
+    size_t                     i;
+    bool                       case_sensitive;
+
+    if ( (!_registry) || ((!_registry->schema) && (_registry->schema_count != 0u)) )
+    {
+        return false;
+    }
+
+    d_cvar_registry_drop_lookup(_registry);
+
+    case_sensitive = d_internal_cvar_case_sensitive(_registry);
+    names          = 0u;
+
+    for ( i = 0u; i < _registry->schema_count; ++i )
+    {
+        names += (_registry->schema[i].key          ? 1u : 0u) +
+                 (_registry->schema[i].abbreviation ? 1u : 0u);
+    }
+
+    capacity = 16u;
+
+    while ( capacity < (names * 2u) )
+    {
+        capacity *= 2u;
+    }
+
+    slots = (struct d_cvar_lookup_slot*)calloc(capacity, sizeof(*slots));
+
+    if ( !slots )
+    {
+        return false;
+    }
+
+    for ( i = 0u; i < _registry->schema_count; ++i )
+    {
+        const struct d_registry_schema_row* row = &_registry->schema[i];
+
+        if ( ( (row->key) &&
+               (!d_internal_cvar_lookup_put(slots, capacity, row->key,
+                                            row->enum_key, case_sensitive)) ) ||
+             ( (row->abbreviation) &&
+               (!d_internal_cvar_lookup_put(slots, capacity, row->abbreviation,
+                                            row->enum_key, case_sensitive)) ) )
+        {
+            free(slots);
+
+            return false;
+        }
+    }
+
+    _registry->lookup          = slots;
+    _registry->lookup_capacity = capacity;
+
+    return true;
+}
+
+// d_cvar_registry_drop_lookup
+//   function: frees the name lookup; names then resolve by schema scan.
+void
+d_cvar_registry_drop_lookup
+(
+    struct d_cvar_registry* _registry
+)
+{
+    if ( !_registry )
+    {
+        return;
+    }
+
+    free(_registry->lookup);
+    _registry->lookup          = NULL;
+    _registry->lookup_capacity = 0u;
+}
+
+// d_cvar_registry_find
+//   function: resolves a key or abbreviation to its enum_key.
+bool
+d_cvar_registry_find
+(
+    const struct d_cvar_registry* _registry,
+    const char*                   _name,
+    uint16_t*                     _out_enum_key
+)
+{
+    bool   case_sensitive;
+    size_t i;
+
+    if ( (!_registry) || (!_name) )
+    {
+        return false;
+    }
+
+    case_sensitive = d_internal_cvar_case_sensitive(_registry);
+
+    if ( _registry->lookup )
+    {
+        const uint32_t hash = d_internal_cvar_hash(_name, case_sensitive);
+        const size_t   mask = _registry->lookup_capacity - 1u;
+
+        for ( i = (size_t)hash & mask; _registry->lookup[i].name; i = (i + 1u) & mask )
+        {
+            if ( (_registry->lookup[i].hash == hash) &&
+                 (d_registry_strcmp(_registry->lookup[i].name, _name, case_sensitive) == 0) )
+            {
+                if ( _out_enum_key )
+                {
+                    *_out_enum_key = _registry->lookup[i].enum_key;
+                }
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // no lookup built: linear scan
+    for ( i = 0u; (_registry->schema) && (i < _registry->schema_count); ++i )
+    {
+        const struct d_registry_schema_row* row = &_registry->schema[i];
+
+        if ( ((row->key) &&
+              (d_registry_strcmp(row->key, _name, case_sensitive) == 0)) ||
+             ((row->abbreviation) &&
+              (d_registry_strcmp(row->abbreviation, _name, case_sensitive) == 0)) )
+        {
+            if ( _out_enum_key )
+            {
+                *_out_enum_key = row->enum_key;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// d_cvar_registry_value_by_name
+//   function: resolves a name directly to its value slot.
+struct d_registry_value*
+d_cvar_registry_value_by_name
+(
+    const struct d_cvar_registry* _registry,
+    const char*                   _name
+)
+{
+    uint16_t enum_key;
+
+    if ( (!d_cvar_registry_find(_registry, _name, &enum_key)) ||
+         (!_registry->values) ||
+         ((size_t)enum_key >= _registry->values_count) )
+    {
+        return NULL;
+    }
+
+    return &_registry->values[enum_key];
+}
+
+
+//==============================================================================
+// Typed access by enum_key
+//==============================================================================
+
+// d_internal_cvar_slot
+//   function: value slot for enum_key, or NULL if out of range.
+static struct d_registry_value*
+d_internal_cvar_slot
+(
+    const struct d_cvar_registry* _registry,
+    uint16_t                      _enum_key
+)
+{
+    if ( (!_registry) ||
+         (!_registry->values) ||
+         ((size_t)_enum_key >= _registry->values_count) )
+    {
+        return NULL;
+    }
+
+    return &_registry->values[_enum_key];
+}
+
+// d_internal_cvar_release
+//   function: frees an owned current value and clears the slot.
+static void
+d_internal_cvar_release
+(
+    struct d_registry_value* _slot
+)
+{
+    if ( (_slot->flags & D_REGISTRY_VALUE_FLAG_OWNED) != 0u )
+    {
+        // boxes from d_cvar_registry_set_copy are plain malloc blocks
+        if ( (_slot->free_fn) && (_slot->size == 0u) )
+        {
+            _slot->free_fn(_slot->value);
+        }
+        else
+        {
+            free(_slot->value);
+        }
+    }
+
+    _slot->value  = NULL;
+    _slot->size   = 0u;
+    _slot->flags &= ~(D_REGISTRY_VALUE_FLAG_HAS_VALUE | D_REGISTRY_VALUE_FLAG_OWNED);
+}
+
+// d_cvar_registry_get
+//   function: current value, falling back to the default.
+const void*
+d_cvar_registry_get
+(
+    const struct d_cvar_registry* _registry,
+    uint16_t                      _enum_key
+)
+{
+    const struct d_registry_value* slot = d_internal_cvar_slot(_registry, _enum_key);
+
+    if ( !slot )
+    {
+        return NULL;
+    }
+
+    return ((slot->flags & D_REGISTRY_VALUE_FLAG_HAS_VALUE) != 0u)
+             ? slot->value
+             : slot->default_value;
+}
+
+// d_cvar_registry_set
+//   function: stores an unowned value pointer.
+bool
+d_cvar_registry_set
+(
+    struct d_cvar_registry* _registry,
+    uint16_t                _enum_key,
+    void*                   _value
+)
+{
+    struct d_registry_value* slot = d_internal_cvar_slot(_registry, _enum_key);
+
+    if ( !slot )
+    {
+        return false;
+    }
+
+    d_internal_cvar_release(slot);
+
+    slot->value  = _value;
+    slot->flags |= D_REGISTRY_VALUE_FLAG_HAS_VALUE;
+
+    return true;
+}
+
+// d_cvar_registry_set_copy
+//   function: stores a registry-owned copy of `_size` bytes.
+//   notes:
+//     - an owned box of the same size is reused.
+bool
+d_cvar_registry_set_copy
+(
+    struct d_cvar_registry* _registry,
+    uint16_t                _enum_key,
+    const void*             _src,
+    size_t                  _size
+)
+{
+    struct d_registry_value* slot = d_internal_cvar_slot(_registry, _enum_key);
+    void*                    box;
+
+    if ( (!slot) || (!_src) || (_size == 0u) )
+    {
+        return false;
+    }
+
+    if ( ((slot->flags & D_REGISTRY_VALUE_FLAG_OWNED) != 0u) &&
+         (slot->size == _size) )
+    {
+        memcpy(slot->value, _src, _size);
+
+        return true;
+    }
+
+    box = malloc(_size);
+
+    if ( !box )
+    {
+        return false;
+    }
+
+    memcpy(box, _src, _size);
+
+    d_internal_cvar_release(slot);
+
+    slot->value  = box;
+    slot->size   = _size;
+    slot->flags |= D_REGISTRY_VALUE_FLAG_HAS_VALUE | D_REGISTRY_VALUE_FLAG_OWNED;
+
+    return true;
+}
+
+// d_cvar_registry_reset
+//   function: drops the current value so the default applies again.
+bool
+d_cvar_registry_reset
+(
+    struct d_cvar_registry* _registry,
+    uint16_t                _enum_key
+)
+{
+    struct d_registry_value* slot = d_internal_cvar_slot(_registry, _enum_key);
+
+    if ( !slot )
+    {
+        return false;
+    }
+
+    d_internal_cvar_release(slot);
+
+    return true;
+}
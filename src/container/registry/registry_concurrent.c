@@ -0,0 +1,438 @@
+#include "..\..\..\inc\container\registry\registry_concurrent.h"
+
+
+/******************************************************************************
+ * INTERNAL HELPERS
+ *****************************************************************************/
+
+static bool
+d_registry_concurrent_reader_valid
+(
+    const struct d_registry_concurrent* _concurrent,
+    int _reader
+)
+{
+    return _concurrent                                      &&
+           (_reader >= 0)                                   &&
+           (_reader < D_REGISTRY_CONCURRENT_MAX_READERS);
+}
+
+// d_registry_concurrent_min_epoch
+//   oldest epoch any reader is currently inside, or UINT64_MAX if none.
+static uint64_t
+d_registry_concurrent_min_epoch
+(
+    struct d_registry_concurrent* _concurrent
+)
+{
+    uint64_t min_epoch = UINT64_MAX;
+    uint64_t e;
+    size_t   i;
+
+    for (i = 0; i < D_REGISTRY_CONCURRENT_MAX_READERS; ++i)
+    {
+        e = atomic_load(&_concurrent->readers[i].epoch);
+
+        if ( (e != 0) &&
+             (e < min_epoch) )
+        {
+            min_epoch = e;
+        }
+    }
+
+    return min_epoch;
+}
+
+// d_registry_concurrent_apply
+//   runs one change against the draft; without an open draft the change is
+// published on success and discarded on failure.
+static bool
+d_registry_concurrent_apply
+(
+    struct d_registry_concurrent* _concurrent,
+    const void* _row,
+    const char* _key,
+    const char* _alias
+)
+{
+    struct d_registry* draft;
+    bool               implicit;
+    bool               ok;
+
+    if (!_concurrent)
+    {
+        return false;
+    }
+
+    implicit = (_concurrent->draft == NULL);
+    draft    = d_registry_concurrent_write_begin(_concurrent);
+
+    if (!draft)
+    {
+        return false;
+    }
+
+    if (_row)
+    {
+        ok = d_registry_add(draft, _row);
+    }
+    else if (_alias)
+    {
+        ok = d_registry_add_alias(draft, _key, _alias);
+    }
+    else
+    {
+        ok = d_registry_remove(draft, _key);
+    }
+
+    if (!implicit)
+    {
+        return ok;
+    }
+
+    if (!ok)
+    {
+        d_registry_concurrent_write_abort(_concurrent);
+
+        return false;
+    }
+
+    return d_registry_concurrent_publish(_concurrent);
+}
+
+
+/******************************************************************************
+ * CONSTRUCTOR / DESTRUCTOR FUNCTIONS
+ *****************************************************************************/
+
+struct d_registry_concurrent*
+d_registry_concurrent_new
+(
+    struct d_registry* _registry
+)
+{
+    struct d_registry_concurrent* c;
+    size_t                        i;
+
+    if ( (!_registry) ||
+         ((_registry->flags & (D_REGISTRY_FLAG_STATIC_ROWS |
+                               D_REGISTRY_FLAG_OWNS_ROWS)) != 0) ||
+         (d_registry_in_batch(_registry)) )
+    {
+        return NULL;
+    }
+
+    c = malloc(sizeof(struct d_registry_concurrent));
+    if (!c)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < D_REGISTRY_CONCURRENT_MAX_READERS; ++i)
+    {
+        atomic_init(&c->readers[i].epoch, 0);
+        atomic_init(&c->readers[i].in_use, false);
+    }
+
+    d_registry_freeze(_registry);
+
+    atomic_init(&c->current, _registry);
+    atomic_init(&c->epoch, 1);
+    c->draft         = NULL;
+    c->retired       = NULL;
+    c->retired_count = 0;
+
+    return c;
+}
+
+void
+d_registry_concurrent_free
+(
+    struct d_registry_concurrent* _concurrent
+)
+{
+    struct d_registry_retired* node;
+    struct d_registry_retired* next;
+
+    if (!_concurrent)
+    {
+        return;
+    }
+
+    d_registry_concurrent_write_abort(_concurrent);
+
+    for (node = _concurrent->retired; node; node = next)
+    {
+        next = node->next;
+        d_registry_free(node->snapshot);
+        free(node);
+    }
+
+    d_registry_free(atomic_load(&_concurrent->current));
+    free(_concurrent);
+}
+
+
+/******************************************************************************
+ * READER FUNCTIONS
+ *****************************************************************************/
+
+int
+d_registry_concurrent_reader_register
+(
+    struct d_registry_concurrent* _concurrent
+)
+{
+    bool expected;
+    int  i;
+
+    if (!_concurrent)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < D_REGISTRY_CONCURRENT_MAX_READERS; ++i)
+    {
+        expected = false;
+
+        if (atomic_compare_exchange_strong(&_concurrent->readers[i].in_use,
+                                           &expected,
+                                           true))
+        {
+            atomic_store(&_concurrent->readers[i].epoch, 0);
+
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void
+d_registry_concurrent_reader_unregister
+(
+    struct d_registry_concurrent* _concurrent,
+    int _reader
+)
+{
+    if (!d_registry_concurrent_reader_valid(_concurrent, _reader))
+    {
+        return;
+    }
+
+    atomic_store(&_concurrent->readers[_reader].epoch, 0);
+    atomic_store(&_concurrent->readers[_reader].in_use, false);
+}
+
+const struct d_registry*
+d_registry_concurrent_read_begin
+(
+    struct d_registry_concurrent* _concurrent,
+    int _reader
+)
+{
+    if (!d_registry_concurrent_reader_valid(_concurrent, _reader))
+    {
+        return NULL;
+    }
+
+    // Both operations are sequentially consistent: if the writer's reclaim
+    // scan misses this epoch, the swap it follows is already visible to the
+    // load below, so the snapshot read here was never retired.
+    atomic_store(&_concurrent->readers[_reader].epoch,
+                 atomic_load(&_concurrent->epoch));
+
+    return atomic_load(&_concurrent->current);
+}
+
+void
+d_registry_concurrent_read_end
+(
+    struct d_registry_concurrent* _concurrent,
+    int _reader
+)
+{
+    if (!d_registry_concurrent_reader_valid(_concurrent, _reader))
+    {
+        return;
+    }
+
+    atomic_store_explicit(&_concurrent->readers[_reader].epoch,
+                          0,
+                          memory_order_release);
+}
+
+
+/******************************************************************************
+ * WRITER FUNCTIONS
+ *****************************************************************************/
+
+struct d_registry*
+d_registry_concurrent_write_begin
+(
+    struct d_registry_concurrent* _concurrent
+)
+{
+    if (!_concurrent)
+    {
+        return NULL;
+    }
+
+    if (!_concurrent->draft)
+    {
+        // only the writer swaps `current`, so it cannot be freed under us
+        _concurrent->draft = d_registry_new_copy(atomic_load(&_concurrent->current));
+
+        if (_concurrent->draft)
+        {
+            d_registry_thaw(_concurrent->draft);
+        }
+    }
+
+    return _concurrent->draft;
+}
+
+bool
+d_registry_concurrent_publish
+(
+    struct d_registry_concurrent* _concurrent
+)
+{
+    struct d_registry_retired* node;
+    struct d_registry*         old;
+
+    if ( (!_concurrent) ||
+         (!_concurrent->draft) ||
+         (d_registry_in_batch(_concurrent->draft)) )
+    {
+        return false;
+    }
+
+    node = malloc(sizeof(struct d_registry_retired));
+    if (!node)
+    {
+        return false;
+    }
+
+    d_registry_freeze(_concurrent->draft);
+
+    old = atomic_exchange(&_concurrent->current, _concurrent->draft);
+    _concurrent->draft = NULL;
+
+    // readers entering from here on see an epoch past `node->epoch`, and
+    // therefore the new snapshot
+    node->snapshot = old;
+    node->epoch    = atomic_fetch_add(&_concurrent->epoch, 1);
+    node->next     = _concurrent->retired;
+
+    _concurrent->retired        = node;
+    _concurrent->retired_count += 1;
+
+    d_registry_concurrent_reclaim(_concurrent);
+
+    return true;
+}
+
+void
+d_registry_concurrent_write_abort
+(
+    struct d_registry_concurrent* _concurrent
+)
+{
+    if ( (!_concurrent) ||
+         (!_concurrent->draft) )
+    {
+        return;
+    }
+
+    d_registry_free(_concurrent->draft);
+    _concurrent->draft = NULL;
+}
+
+size_t
+d_registry_concurrent_reclaim
+(
+    struct d_registry_concurrent* _concurrent
+)
+{
+    struct d_registry_retired** link;
+    struct d_registry_retired*  node;
+    uint64_t                    min_epoch;
+
+    if (!_concurrent)
+    {
+        return 0;
+    }
+
+    min_epoch = d_registry_concurrent_min_epoch(_concurrent);
+    link      = &_concurrent->retired;
+
+    while (*link)
+    {
+        node = *link;
+
+        // readers that entered at or before the retire epoch may hold it
+        if (node->epoch < min_epoch)
+        {
+            *link = node->next;
+
+            d_registry_free(node->snapshot);
+            free(node);
+
+            _concurrent->retired_count -= 1;
+        }
+        else
+        {
+            link = &node->next;
+        }
+    }
+
+    return _concurrent->retired_count;
+}
+
+bool
+d_registry_concurrent_add
+(
+    struct d_registry_concurrent* _concurrent,
+    const void* _row
+)
+{
+    if (!_row)
+    {
+        return false;
+    }
+
+    return d_registry_concurrent_apply(_concurrent, _row, NULL, NULL);
+}
+
+bool
+d_registry_concurrent_add_alias
+(
+    struct d_registry_concurrent* _concurrent,
+    const char* _key,
+    const char* _alias
+)
+{
+    if ( (!_key) ||
+         (!_alias) )
+    {
+        return false;
+    }
+
+    return d_registry_concurrent_apply(_concurrent, NULL, _key, _alias);
+}
+
+bool
+d_registry_concurrent_remove
+(
+    struct d_registry_concurrent* _concurrent,
+    const char* _key
+)
+{
+    if (!_key)
+    {
+        return false;
+    }
+
+    return d_registry_concurrent_apply(_concurrent, NULL, _key, NULL);
+}
@@ -0,0 +1,578 @@
+#include "..\..\..\inc\container\registry\registry_cvar_versioned.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/******************************************************************************
+ * INTERNAL HELPERS
+ *****************************************************************************/
+
+static size_t
+d_cvar_snapshot_align
+(
+    size_t _n
+)
+{
+    return (_n + (D_CVAR_SNAPSHOT_ALIGN - 1)) & ~(size_t)(D_CVAR_SNAPSHOT_ALIGN - 1);
+}
+
+static bool
+d_cvar_versioned_reader_valid
+(
+    const struct d_cvar_versioned* _versioned,
+    int _reader
+)
+{
+    return _versioned                                       &&
+           (_reader >= 0)                                   &&
+           (_reader < D_REGISTRY_CONCURRENT_MAX_READERS);
+}
+
+// d_cvar_value_is_boxed
+//   true if the slot's current value is a set_copy box, which the registry
+// may overwrite in place and must therefore be copied into snapshots.
+static bool
+d_cvar_value_is_boxed
+(
+    const struct d_registry_value* _slot
+)
+{
+    return ((_slot->flags & D_REGISTRY_VALUE_FLAG_HAS_VALUE) != 0u) &&
+           ((_slot->flags & D_REGISTRY_VALUE_FLAG_OWNED) != 0u)     &&
+           (_slot->size > 0u);
+}
+
+// d_cvar_snapshot_build
+//   builds the snapshot for `_version`. Enum_keys set in `_changed` (or all
+// of them when it is NULL) get `changed_at = _version`; the others keep the
+// version recorded in `_previous`.
+static struct d_cvar_snapshot*
+d_cvar_snapshot_build
+(
+    const struct d_cvar_registry* _registry,
+    const struct d_cvar_snapshot* _previous,
+    const uint64_t*               _changed,
+    uint64_t                      _version
+)
+{
+    struct d_cvar_snapshot*        snap;
+    const struct d_registry_value* slot;
+    unsigned char*                 base;
+    unsigned char*                 pool;
+    size_t                         count;
+    size_t                         words;
+    size_t                         pool_size;
+    size_t                         offset;
+    size_t                         k;
+
+    count = (_registry->values) ? _registry->values_count : 0;
+    words = (count + 63) / 64;
+
+    pool_size = 0;
+
+    for (k = 0; k < count; ++k)
+    {
+        if (d_cvar_value_is_boxed(&_registry->values[k]))
+        {
+            pool_size += d_cvar_snapshot_align(_registry->values[k].size);
+        }
+    }
+
+    // struct | values | changed_at | dirty | pool
+    offset = d_cvar_snapshot_align(sizeof(struct d_cvar_snapshot));
+    offset = d_cvar_snapshot_align(offset + (count * sizeof(const void*)));
+    offset = d_cvar_snapshot_align(offset + (count * sizeof(uint64_t)));
+    offset = d_cvar_snapshot_align(offset + (words * sizeof(uint64_t)));
+
+    base = (unsigned char*)malloc(offset + pool_size);
+    if (!base)
+    {
+        return NULL;
+    }
+
+    snap              = (struct d_cvar_snapshot*)base;
+    snap->version     = _version;
+    snap->count       = count;
+    snap->dirty_words = words;
+
+    offset           = d_cvar_snapshot_align(sizeof(struct d_cvar_snapshot));
+    snap->values     = (const void**)(base + offset);
+    offset           = d_cvar_snapshot_align(offset + (count * sizeof(const void*)));
+    snap->changed_at = (uint64_t*)(base + offset);
+    offset           = d_cvar_snapshot_align(offset + (count * sizeof(uint64_t)));
+    snap->dirty      = (uint64_t*)(base + offset);
+    offset           = d_cvar_snapshot_align(offset + (words * sizeof(uint64_t)));
+    pool             = base + offset;
+
+    for (k = 0; k < words; ++k)
+    {
+        snap->dirty[k] = (_changed) ? _changed[k] : ~(uint64_t)0;
+    }
+
+    // keep bits past `count` clear
+    if ( (words > 0) &&
+         ((count % 64) != 0) )
+    {
+        snap->dirty[words - 1] &= ((uint64_t)1 << (count % 64)) - 1;
+    }
+
+    for (k = 0; k < count; ++k)
+    {
+        slot = &_registry->values[k];
+
+        if (d_cvar_value_is_boxed(slot))
+        {
+            memcpy(pool, slot->value, slot->size);
+            snap->values[k] = pool;
+            pool           += d_cvar_snapshot_align(slot->size);
+        }
+        else if ((slot->flags & D_REGISTRY_VALUE_FLAG_HAS_VALUE) != 0u)
+        {
+            snap->values[k] = slot->value;
+        }
+        else
+        {
+            snap->values[k] = slot->default_value;
+        }
+
+        snap->changed_at[k] = ( (!_previous) ||
+                                (k >= _previous->count) ||
+                                (D_CVAR_SNAPSHOT_IS_DIRTY(snap, k)) )
+                                ? _version
+                                : _previous->changed_at[k];
+    }
+
+    return snap;
+}
+
+// d_cvar_versioned_min_epoch
+//   oldest epoch any reader is currently inside, or UINT64_MAX if none.
+static uint64_t
+d_cvar_versioned_min_epoch
+(
+    struct d_cvar_versioned* _versioned
+)
+{
+    uint64_t min_epoch = UINT64_MAX;
+    uint64_t e;
+    size_t   i;
+
+    for (i = 0; i < D_REGISTRY_CONCURRENT_MAX_READERS; ++i)
+    {
+        e = atomic_load(&_versioned->readers[i].epoch);
+
+        if ( (e != 0) &&
+             (e < min_epoch) )
+        {
+            min_epoch = e;
+        }
+    }
+
+    return min_epoch;
+}
+
+// d_cvar_versioned_stage
+//   records `_enum_key` as changed since the last publish.
+static void
+d_cvar_versioned_stage
+(
+    struct d_cvar_versioned* _versioned,
+    uint16_t _enum_key
+)
+{
+    _versioned->staged[_enum_key / 64] |= (uint64_t)1 << (_enum_key % 64);
+    _versioned->has_staged              = true;
+}
+
+static bool
+d_cvar_versioned_key_valid
+(
+    const struct d_cvar_versioned* _versioned,
+    uint16_t _enum_key
+)
+{
+    return _versioned                                   &&
+           ((size_t)_enum_key < _versioned->value_count);
+}
+
+
+/******************************************************************************
+ * CONSTRUCTOR / DESTRUCTOR FUNCTIONS
+ *****************************************************************************/
+
+struct d_cvar_versioned*
+d_cvar_versioned_new
+(
+    struct d_cvar_registry* _registry
+)
+{
+    struct d_cvar_versioned* v;
+    struct d_cvar_snapshot*  snap;
+    size_t                   words;
+    size_t                   i;
+
+    if (!_registry)
+    {
+        return NULL;
+    }
+
+    v = malloc(sizeof(struct d_cvar_versioned));
+    if (!v)
+    {
+        return NULL;
+    }
+
+    v->value_count = (_registry->values) ? _registry->values_count : 0;
+
+    words     = (v->value_count + 63) / 64;
+    v->staged = (uint64_t*)calloc((words > 0) ? words : 1, sizeof(uint64_t));
+    snap      = d_cvar_snapshot_build(_registry, NULL, NULL, 1);
+
+    if ( (!v->staged) ||
+         (!snap) )
+    {
+        free(snap);
+        free(v->staged);
+        free(v);
+
+        return NULL;
+    }
+
+    for (i = 0; i < D_REGISTRY_CONCURRENT_MAX_READERS; ++i)
+    {
+        atomic_init(&v->readers[i].epoch, 0);
+        atomic_init(&v->readers[i].in_use, false);
+    }
+
+    atomic_init(&v->current, snap);
+    atomic_init(&v->epoch, 1);
+    atomic_init(&v->version, 1);
+    v->registry      = _registry;
+    v->has_staged    = false;
+    v->retired       = NULL;
+    v->retired_count = 0;
+
+    return v;
+}
+
+void
+d_cvar_versioned_free
+(
+    struct d_cvar_versioned* _versioned
+)
+{
+    struct d_cvar_snapshot_retired* node;
+    struct d_cvar_snapshot_retired* next;
+
+    if (!_versioned)
+    {
+        return;
+    }
+
+    for (node = _versioned->retired; node; node = next)
+    {
+        next = node->next;
+        free(node->snapshot);
+        free(node);
+    }
+
+    free(atomic_load(&_versioned->current));
+    free(_versioned->staged);
+    free(_versioned);
+}
+
+
+/******************************************************************************
+ * READER FUNCTIONS
+ *****************************************************************************/
+
+int
+d_cvar_versioned_reader_register
+(
+    struct d_cvar_versioned* _versioned
+)
+{
+    bool expected;
+    int  i;
+
+    if (!_versioned)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < D_REGISTRY_CONCURRENT_MAX_READERS; ++i)
+    {
+        expected = false;
+
+        if (atomic_compare_exchange_strong(&_versioned->readers[i].in_use,
+                                           &expected,
+                                           true))
+        {
+            atomic_store(&_versioned->readers[i].epoch, 0);
+
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void
+d_cvar_versioned_reader_unregister
+(
+    struct d_cvar_versioned* _versioned,
+    int _reader
+)
+{
+    if (!d_cvar_versioned_reader_valid(_versioned, _reader))
+    {
+        return;
+    }
+
+    atomic_store(&_versioned->readers[_reader].epoch, 0);
+    atomic_store(&_versioned->readers[_reader].in_use, false);
+}
+
+const struct d_cvar_snapshot*
+d_cvar_versioned_read_begin
+(
+    struct d_cvar_versioned* _versioned,
+    int _reader
+)
+{
+    if (!d_cvar_versioned_reader_valid(_versioned, _reader))
+    {
+        return NULL;
+    }
+
+    // same ordering argument as d_registry_concurrent_read_begin
+    atomic_store(&_versioned->readers[_reader].epoch,
+                 atomic_load(&_versioned->epoch));
+
+    return atomic_load(&_versioned->current);
+}
+
+void
+d_cvar_versioned_read_end
+(
+    struct d_cvar_versioned* _versioned,
+    int _reader
+)
+{
+    if (!d_cvar_versioned_reader_valid(_versioned, _reader))
+    {
+        return;
+    }
+
+    atomic_store_explicit(&_versioned->readers[_reader].epoch,
+                          0,
+                          memory_order_release);
+}
+
+uint64_t
+d_cvar_versioned_version
+(
+    const struct d_cvar_versioned* _versioned
+)
+{
+    if (!_versioned)
+    {
+        return 0;
+    }
+
+    return atomic_load_explicit(&((struct d_cvar_versioned*)_versioned)->version,
+                                memory_order_acquire);
+}
+
+bool
+d_cvar_versioned_changed_since
+(
+    const struct d_cvar_versioned* _versioned,
+    uint64_t _version
+)
+{
+    return d_cvar_versioned_version(_versioned) > _version;
+}
+
+
+/******************************************************************************
+ * WRITER FUNCTIONS
+ *****************************************************************************/
+
+bool
+d_cvar_versioned_set
+(
+    struct d_cvar_versioned* _versioned,
+    uint16_t _enum_key,
+    void* _value
+)
+{
+    if ( (!d_cvar_versioned_key_valid(_versioned, _enum_key)) ||
+         (!d_cvar_registry_set(_versioned->registry, _enum_key, _value)) )
+    {
+        return false;
+    }
+
+    d_cvar_versioned_stage(_versioned, _enum_key);
+
+    return true;
+}
+
+bool
+d_cvar_versioned_set_copy
+(
+    struct d_cvar_versioned* _versioned,
+    uint16_t _enum_key,
+    const void* _src,
+    size_t _size
+)
+{
+    if ( (!d_cvar_versioned_key_valid(_versioned, _enum_key)) ||
+         (!d_cvar_registry_set_copy(_versioned->registry, _enum_key, _src, _size)) )
+    {
+        return false;
+    }
+
+    d_cvar_versioned_stage(_versioned, _enum_key);
+
+    return true;
+}
+
+bool
+d_cvar_versioned_reset
+(
+    struct d_cvar_versioned* _versioned,
+    uint16_t _enum_key
+)
+{
+    if ( (!d_cvar_versioned_key_valid(_versioned, _enum_key)) ||
+         (!d_cvar_registry_reset(_versioned->registry, _enum_key)) )
+    {
+        return false;
+    }
+
+    d_cvar_versioned_stage(_versioned, _enum_key);
+
+    return true;
+}
+
+bool
+d_cvar_versioned_mark
+(
+    struct d_cvar_versioned* _versioned,
+    uint16_t _enum_key
+)
+{
+    if (!d_cvar_versioned_key_valid(_versioned, _enum_key))
+    {
+        return false;
+    }
+
+    d_cvar_versioned_stage(_versioned, _enum_key);
+
+    return true;
+}
+
+bool
+d_cvar_versioned_publish
+(
+    struct d_cvar_versioned* _versioned
+)
+{
+    struct d_cvar_snapshot_retired* node;
+    struct d_cvar_snapshot*         old;
+    struct d_cvar_snapshot*         snap;
+    size_t                          words;
+
+    if (!_versioned)
+    {
+        return false;
+    }
+
+    if (!_versioned->has_staged)
+    {
+        return true;
+    }
+
+    if ( (!_versioned->registry->values) ||
+         (_versioned->registry->values_count != _versioned->value_count) )
+    {
+        return false;
+    }
+
+    old  = atomic_load(&_versioned->current);
+    node = malloc(sizeof(struct d_cvar_snapshot_retired));
+    snap = d_cvar_snapshot_build(_versioned->registry,
+                                 old,
+                                 _versioned->staged,
+                                 old->version + 1);
+
+    if ( (!node) ||
+         (!snap) )
+    {
+        // staged bits are kept for the next attempt
+        free(node);
+        free(snap);
+
+        return false;
+    }
+
+    atomic_exchange(&_versioned->current, snap);
+    atomic_store_explicit(&_versioned->version, snap->version, memory_order_release);
+
+    node->snapshot = old;
+    node->epoch    = atomic_fetch_add(&_versioned->epoch, 1);
+    node->next     = _versioned->retired;
+
+    _versioned->retired        = node;
+    _versioned->retired_count += 1;
+
+    words = snap->dirty_words;
+    memset(_versioned->staged, 0, ((words > 0) ? words : 1) * sizeof(uint64_t));
+    _versioned->has_staged = false;
+
+    d_cvar_versioned_reclaim(_versioned);
+
+    return true;
+}
+
+size_t
+d_cvar_versioned_reclaim
+(
+    struct d_cvar_versioned* _versioned
+)
+{
+    struct d_cvar_snapshot_retired** link;
+    struct d_cvar_snapshot_retired*  node;
+    uint64_t                         min_epoch;
+
+    if (!_versioned)
+    {
+        return 0;
+    }
+
+    min_epoch = d_cvar_versioned_min_epoch(_versioned);
+    link      = &_versioned->retired;
+
+    while (*link)
+    {
+        node = *link;
+
+        if (node->epoch < min_epoch)
+        {
+            *link = node->next;
+
+            free(node->snapshot);
+            free(node);
+
+            _versioned->retired_count -= 1;
+        }
+        else
+        {
+            link = &node->next;
+        }
+    }
+
+    return _versioned->retired_count;
+}
@@ -0,0 +1,666 @@
+// pread is POSIX; strict ISO modes (-std=c11) hide it without this
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "..\..\..\inc\container\registry\registry_image.h"
+
+#include <stdio.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+/******************************************************************************
+ * INTERNAL TYPES
+ *****************************************************************************/
+
+// d_registry_image_map
+//   internal: mapping handle; `registry` must stay the first member so the
+// registry pointer handed out can be converted back.
+struct d_registry_image_map
+{
+    struct d_registry registry;
+    void*             base;       // start of the mapping
+    size_t            size;       // mapped bytes
+    bool              relocated;  // rebased copy-on-write mapping
+};
+
+// d_registry_image_string
+//   internal: original key pointer and its string table offset.
+struct d_registry_image_string
+{
+    uintptr_t key;
+    uint64_t  offset;
+};
+
+
+/******************************************************************************
+ * INTERNAL HELPERS
+ *****************************************************************************/
+
+static uint64_t
+d_registry_image_align
+(
+    uint64_t _n
+)
+{
+    return (_n + (D_REGISTRY_IMAGE_ALIGN - 1)) & ~(uint64_t)(D_REGISTRY_IMAGE_ALIGN - 1);
+}
+
+static int
+d_registry_image_string_compare
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_image_string* a = (const struct d_registry_image_string*)_a;
+    const struct d_registry_image_string* b = (const struct d_registry_image_string*)_b;
+
+    if (a->key == b->key) return 0;
+    return (a->key < b->key) ? -1 : 1;
+}
+
+// d_registry_image_string_find
+//   string table offset of an original key pointer; every key reachable from
+// the lookup or the rows was added to `_map` before this is called.
+static uint64_t
+d_registry_image_string_find
+(
+    const struct d_registry_image_string* _map,
+    size_t      _count,
+    const char* _key
+)
+{
+    struct d_registry_image_string  probe;
+    struct d_registry_image_string* hit;
+
+    probe.key    = (uintptr_t)_key;
+    probe.offset = 0;
+
+    hit = (struct d_registry_image_string*)bsearch(&probe,
+                                                   _map,
+                                                   _count,
+                                                   sizeof(struct d_registry_image_string),
+                                                   d_registry_image_string_compare);
+
+    return hit ? hit->offset : 0;
+}
+
+// d_registry_image_pick_base
+//   deterministic preferred base for an image, spread over the configured
+// address window so that different images rarely collide.
+static uint64_t
+d_registry_image_pick_base
+(
+    const unsigned char* _strings,
+    size_t               _size,
+    uint64_t             _total
+)
+{
+    uint64_t h = 14695981039346656037ULL;
+    size_t   i;
+
+    if ( (sizeof(void*) < 8) ||
+         (_total > ((uint64_t)1 << 28)) )
+    {
+        return 0;
+    }
+
+    for (i = 0; i < _size; ++i)
+    {
+        h ^= _strings[i];
+        h *= 1099511628211ULL;
+    }
+
+    h ^= _total;
+    h *= 1099511628211ULL;
+
+    return D_REGISTRY_IMAGE_BASE_MIN + ((h % D_REGISTRY_IMAGE_BASE_SLOTS) << 28);
+}
+
+// d_registry_image_valid
+//   checks that a header matches this build and fits in `_file_size` bytes.
+static bool
+d_registry_image_valid
+(
+    const struct d_registry_image_header* _h,
+    uint64_t _file_size
+)
+{
+    if ( (memcmp(_h->magic, D_REGISTRY_IMAGE_MAGIC, sizeof(D_REGISTRY_IMAGE_MAGIC)) != 0) ||
+         (_h->version      != D_REGISTRY_IMAGE_VERSION)                     ||
+         (_h->byte_order   != 0x01020304u)                                  ||
+         (_h->pointer_size != sizeof(void*))                                ||
+         (_h->entry_size   != sizeof(struct d_registry_lookup_entry))       ||
+         (_h->slot_size    != sizeof(struct d_registry_hash_slot))          ||
+         (_h->total_size   >  _file_size)                                   ||
+         (_h->row_size     <  sizeof(const char*)) )
+    {
+        return false;
+    }
+
+    return (_h->rows_offset    + (_h->row_count * _h->row_size)                     <= _h->total_size) &&
+           (_h->lookup_offset  + (_h->lookup_count * _h->entry_size)                <= _h->total_size) &&
+           (_h->perfect_offset + ((_h->perfect_buckets + _h->perfect_slots) * 4u)   <= _h->total_size) &&
+           (_h->hash_offset    + (_h->hash_capacity * _h->slot_size)                <= _h->total_size) &&
+           (_h->strings_offset + _h->strings_size                                   == _h->total_size);
+}
+
+// d_registry_image_relocate
+//   rebases every stored key pointer by `_delta` (modular arithmetic).
+static void
+d_registry_image_relocate
+(
+    unsigned char*                        _image,
+    const struct d_registry_image_header* _h,
+    uintptr_t                             _delta
+)
+{
+    struct d_registry_lookup_entry* lookup;
+    struct d_registry_hash_slot*    slots;
+    uintptr_t                       key;
+    size_t                          i;
+
+    for (i = 0; i < _h->row_count; ++i)
+    {
+        unsigned char* row = _image + _h->rows_offset + (i * _h->row_size);
+
+        memcpy(&key, row, sizeof(key));
+
+        if (key)
+        {
+            key += _delta;
+            memcpy(row, &key, sizeof(key));
+        }
+    }
+
+    lookup = (struct d_registry_lookup_entry*)(_image + _h->lookup_offset);
+
+    for (i = 0; i < _h->lookup_count; ++i)
+    {
+        lookup[i].key = (const char*)((uintptr_t)lookup[i].key + _delta);
+    }
+
+    slots = (struct d_registry_hash_slot*)(_image + _h->hash_offset);
+
+    for (i = 0; i < _h->hash_capacity; ++i)
+    {
+        if (slots[i].key)
+        {
+            slots[i].key = (const char*)((uintptr_t)slots[i].key + _delta);
+        }
+    }
+}
+
+
+/******************************************************************************
+ * SAVING
+ *****************************************************************************/
+
+bool
+d_registry_save_image
+(
+    const struct d_registry* _registry,
+    const char* _path
+)
+{
+    struct d_registry_image_header  h;
+    struct d_registry_image_string* strings;
+    struct d_registry*              frozen;
+    const uint32_t*                 perfect;
+    unsigned char*                  image;
+    const char*                     key;
+    struct d_registry_lookup_entry  e;
+    struct d_registry_hash_slot     slot;
+    FILE*                           file;
+    uint64_t                        offset;
+    uint64_t                        str_size;
+    size_t                          str_count;
+    size_t                          len;
+    size_t                          i;
+    uintptr_t                       stored;
+    bool                            ok;
+
+    if ( (!_registry) ||
+         (!_path)     ||
+         (d_registry_in_batch(_registry)) ||
+         (_registry->dead_count != 0) )
+    {
+        return false;
+    }
+
+    // Mapped registries are frozen, so ship a perfect hash even when the
+    // source does not have one yet.
+    frozen  = NULL;
+    perfect = _registry->perfect_hash;
+
+    memset(&h, 0, sizeof(h));
+    h.perfect_buckets = _registry->perfect_buckets;
+    h.perfect_slots   = _registry->perfect_slots;
+
+    if ( (!perfect) &&
+         (_registry->lookup_count > 0) )
+    {
+        frozen = d_registry_new_copy(_registry);
+
+        if ( (frozen) &&
+             (d_registry_freeze(frozen)) &&
+             (frozen->perfect_hash) )
+        {
+            perfect           = frozen->perfect_hash;
+            h.perfect_buckets = frozen->perfect_buckets;
+            h.perfect_slots   = frozen->perfect_slots;
+        }
+    }
+
+    if (!perfect)
+    {
+        h.perfect_buckets = 0;
+        h.perfect_slots   = 0;
+    }
+
+    // one string per distinct key pointer among rows and lookup entries
+    strings = (struct d_registry_image_string*)malloc(
+        (_registry->count + _registry->lookup_count + 1) *
+            sizeof(struct d_registry_image_string));
+
+    if (!strings)
+    {
+        d_registry_free(frozen);
+
+        return false;
+    }
+
+    str_count = 0;
+
+    for (i = 0; i < _registry->count; ++i)
+    {
+        strings[str_count++].key = (uintptr_t)D_REGISTRY_ROW_KEY(
+            (const char*)_registry->rows + (i * _registry->row_size));
+    }
+
+    for (i = 0; i < _registry->lookup_count; ++i)
+    {
+        strings[str_count++].key = (uintptr_t)_registry->lookup[i].key;
+    }
+
+    qsort(strings, str_count, sizeof(*strings), d_registry_image_string_compare);
+
+    str_size = 0;
+    offset   = 0;
+
+    for (i = 0; i < str_count; ++i)
+    {
+        if ( (offset > 0) &&
+             (strings[offset - 1].key == strings[i].key) )
+        {
+            continue;
+        }
+
+        strings[offset].key    = strings[i].key;
+        strings[offset].offset = str_size;
+        offset++;
+
+        if (strings[i].key)
+        {
+            str_size += strlen((const char*)strings[i].key) + 1;
+        }
+    }
+
+    str_count = (size_t)offset;
+
+    // section layout
+    memcpy(h.magic, D_REGISTRY_IMAGE_MAGIC, sizeof(D_REGISTRY_IMAGE_MAGIC));
+    h.version      = D_REGISTRY_IMAGE_VERSION;
+    h.byte_order   = 0x01020304u;
+    h.pointer_size = (uint32_t)sizeof(void*);
+    h.entry_size   = (uint32_t)sizeof(struct d_registry_lookup_entry);
+    h.slot_size    = (uint32_t)sizeof(struct d_registry_hash_slot);
+    h.flags        = _registry->flags;
+    h.row_size     = _registry->row_size;
+    h.row_count    = _registry->count;
+    h.lookup_count = _registry->lookup_count;
+
+    if ( (_registry->hash_slots) &&
+         ((_registry->flags & D_REGISTRY_FLAG_HASH_INDEX) != 0) )
+    {
+        h.hash_capacity = _registry->hash_capacity;
+        h.hash_count    = _registry->hash_count;
+    }
+
+    offset           = d_registry_image_align(sizeof(h));
+    h.rows_offset    = offset;
+    offset          += d_registry_image_align(h.row_count * h.row_size);
+    h.lookup_offset  = offset;
+    offset          += d_registry_image_align(h.lookup_count * h.entry_size);
+    h.perfect_offset = offset;
+    offset          += d_registry_image_align((h.perfect_buckets + h.perfect_slots) * 4u);
+    h.hash_offset    = offset;
+    offset          += d_registry_image_align(h.hash_capacity * h.slot_size);
+    h.strings_offset = offset;
+    h.strings_size   = str_size;
+    h.total_size     = offset + str_size;
+
+    image = (unsigned char*)calloc(1, (size_t)h.total_size);
+    if (!image)
+    {
+        free(strings);
+        d_registry_free(frozen);
+
+        return false;
+    }
+
+    // strings first: the preferred base is derived from their contents
+    for (i = 0; i < str_count; ++i)
+    {
+        if (strings[i].key)
+        {
+            len = strlen((const char*)strings[i].key) + 1;
+            memcpy(image + h.strings_offset + strings[i].offset,
+                   (const char*)strings[i].key,
+                   len);
+        }
+    }
+
+    h.base = d_registry_image_pick_base(image + h.strings_offset,
+                                        (size_t)h.strings_size,
+                                        h.total_size);
+
+    // d_registry_image_string_find never fails for keys collected above;
+    // NULL keys are stored as NULL
+#define D_INTERNAL_REGISTRY_IMAGE_PTR(key_ptr)                              \
+    ((key_ptr) ? (uintptr_t)(h.base + h.strings_offset +                    \
+                     d_registry_image_string_find(strings, str_count,       \
+                                                  (key_ptr)))               \
+               : (uintptr_t)0)
+
+    for (i = 0; i < h.row_count; ++i)
+    {
+        unsigned char* row = image + h.rows_offset + (i * h.row_size);
+
+        memcpy(row,
+               (const char*)_registry->rows + (i * _registry->row_size),
+               _registry->row_size);
+
+        key    = D_REGISTRY_ROW_KEY(row);
+        stored = D_INTERNAL_REGISTRY_IMAGE_PTR(key);
+        memcpy(row, &stored, sizeof(stored));
+    }
+
+    for (i = 0; i < h.lookup_count; ++i)
+    {
+        e     = _registry->lookup[i];
+        e.key = (const char*)D_INTERNAL_REGISTRY_IMAGE_PTR(e.key);
+
+        // folded copies are heap-only; a mapped registry never folds
+        e.folded = NULL;
+
+        memcpy(image + h.lookup_offset + (i * h.entry_size), &e, sizeof(e));
+    }
+
+    for (i = 0; i < h.hash_capacity; ++i)
+    {
+        slot     = _registry->hash_slots[i];
+        slot.key = (const char*)D_INTERNAL_REGISTRY_IMAGE_PTR(slot.key);
+
+        memcpy(image + h.hash_offset + (i * h.slot_size), &slot, sizeof(slot));
+    }
+
+#undef D_INTERNAL_REGISTRY_IMAGE_PTR
+
+    if (perfect)
+    {
+        memcpy(image + h.perfect_offset,
+               perfect,
+               (size_t)(h.perfect_buckets + h.perfect_slots) * sizeof(uint32_t));
+    }
+
+    memcpy(image, &h, sizeof(h));
+
+    free(strings);
+    d_registry_free(frozen);
+
+    file = fopen(_path, "wb");
+    ok   = (file != NULL);
+
+    if (ok)
+    {
+        ok = (fwrite(image, 1, (size_t)h.total_size, file) == (size_t)h.total_size);
+        ok = (fclose(file) == 0) && ok;
+    }
+
+    free(image);
+
+    return ok;
+}
+
+
+/******************************************************************************
+ * MAPPING
+ *****************************************************************************/
+
+struct d_registry*
+d_registry_map_image
+(
+    const char* _path
+)
+{
+    struct d_registry_image_header h;
+    struct d_registry_image_map*   map;
+    struct d_registry*             reg;
+    unsigned char*                 image;
+    void*                          hint;
+    bool                           relocated;
+
+    if (!_path)
+    {
+        return NULL;
+    }
+
+    image     = NULL;
+    relocated = false;
+
+#if defined(_WIN32)
+    {
+        HANDLE        file;
+        HANDLE        mapping;
+        LARGE_INTEGER size;
+        DWORD         got;
+        DWORD         old_protect;
+
+        file = CreateFileA(_path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return NULL;
+        }
+
+        if ( (!GetFileSizeEx(file, &size)) ||
+             (!ReadFile(file, &h, (DWORD)sizeof(h), &got, NULL)) ||
+             (got != sizeof(h)) ||
+             (!d_registry_image_valid(&h, (uint64_t)size.QuadPart)) )
+        {
+            CloseHandle(file);
+
+            return NULL;
+        }
+
+        mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        CloseHandle(file);
+
+        if (!mapping)
+        {
+            return NULL;
+        }
+
+        hint  = (void*)(uintptr_t)h.base;
+        image = (hint) ? (unsigned char*)MapViewOfFileEx(mapping, FILE_MAP_READ,
+                                                         0, 0, (SIZE_T)h.total_size,
+                                                         hint)
+                       : NULL;
+
+        if (!image)
+        {
+            image = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_COPY,
+                                                  0, 0, (SIZE_T)h.total_size);
+            relocated = (image != NULL);
+        }
+
+        CloseHandle(mapping);
+
+        if (!image)
+        {
+            return NULL;
+        }
+
+        if (relocated)
+        {
+            d_registry_image_relocate(image, &h, (uintptr_t)image - (uintptr_t)h.base);
+            VirtualProtect(image, (SIZE_T)h.total_size, PAGE_READONLY, &old_protect);
+        }
+    }
+#else
+    {
+        struct stat st;
+        int         fd;
+
+        fd = open(_path, O_RDONLY);
+
+        if (fd < 0)
+        {
+            return NULL;
+        }
+
+        if ( (fstat(fd, &st) != 0) ||
+             (pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h)) ||
+             (!d_registry_image_valid(&h, (uint64_t)st.st_size)) )
+        {
+            close(fd);
+
+            return NULL;
+        }
+
+        hint  = (void*)(uintptr_t)h.base;
+        image = (unsigned char*)mmap(hint, (size_t)h.total_size, PROT_READ,
+                                     MAP_SHARED, fd, 0);
+
+        // the kernel treats the address as a hint; anywhere else needs fixups
+        if ( (image != MAP_FAILED) &&
+             ((!hint) || (image != hint)) )
+        {
+            munmap(image, (size_t)h.total_size);
+
+            image = (unsigned char*)mmap(NULL, (size_t)h.total_size,
+                                         PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                                         fd, 0);
+            relocated = true;
+        }
+
+        close(fd);
+
+        if (image == MAP_FAILED)
+        {
+            return NULL;
+        }
+
+        if (relocated)
+        {
+            d_registry_image_relocate(image, &h, (uintptr_t)image - (uintptr_t)h.base);
+            mprotect(image, (size_t)h.total_size, PROT_READ);
+        }
+    }
+#endif
+
+    map = (struct d_registry_image_map*)calloc(1, sizeof(struct d_registry_image_map));
+
+    if (!map)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(image);
+#else
+        munmap(image, (size_t)h.total_size);
+#endif
+        return NULL;
+    }
+
+    map->base      = image;
+    map->size      = (size_t)h.total_size;
+    map->relocated = relocated;
+
+    reg                  = &map->registry;
+    reg->rows            = image + h.rows_offset;
+    reg->row_size        = (size_t)h.row_size;
+    reg->count           = (size_t)h.row_count;
+    reg->capacity        = (size_t)h.row_count;
+    reg->lookup          = (struct d_registry_lookup_entry*)(image + h.lookup_offset);
+    reg->lookup_count    = (size_t)h.lookup_count;
+    reg->lookup_capacity = (size_t)h.lookup_count;
+    reg->lookup_sorted   = (size_t)h.lookup_count;
+    reg->row_free        = NULL;
+    reg->external_index  = true;
+    reg->flags           = (uint8_t)((h.flags & ~(D_REGISTRY_FLAG_OWNS_ROWS |
+                                                  D_REGISTRY_FLAG_TOMBSTONES |
+                                                  D_REGISTRY_FLAG_HASH_INDEX)) |
+                                     D_REGISTRY_FLAG_STATIC_ROWS                |
+                                     D_REGISTRY_FLAG_FROZEN);
+
+    if (h.hash_capacity > 0)
+    {
+        reg->flags         |= (uint8_t)D_REGISTRY_FLAG_HASH_INDEX;
+        reg->hash_slots     = (struct d_registry_hash_slot*)(image + h.hash_offset);
+        reg->hash_capacity  = (size_t)h.hash_capacity;
+        reg->hash_count     = (size_t)h.hash_count;
+    }
+
+    if (h.perfect_slots > 0)
+    {
+        reg->perfect_hash    = (uint32_t*)(image + h.perfect_offset);
+        reg->perfect_buckets = (size_t)h.perfect_buckets;
+        reg->perfect_slots   = (size_t)h.perfect_slots;
+    }
+
+    return reg;
+}
+
+void
+d_registry_unmap_image
+(
+    struct d_registry* _registry
+)
+{
+    struct d_registry_image_map* map;
+
+    if (!_registry)
+    {
+        return;
+    }
+
+    map = (struct d_registry_image_map*)_registry;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(map->base);
+#else
+    munmap(map->base, map->size);
+#endif
+
+    free(map);
+}
+
+bool
+d_registry_image_is_relocated
+(
+    const struct d_registry* _registry
+)
+{
+    return _registry &&
+           ((const struct d_registry_image_map*)_registry)->relocated;
+}
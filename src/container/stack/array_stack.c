@@ -0,0 +1,1704 @@
+/******************************************************************************
+* djinterp [container]                                         array_stack.c
+*
+* LIFO (last-in, first-out) stack stored in one contiguous array of value
+* pointers.
+*
+*
+* path:      \src\container\stack\array_stack.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include "..\..\..\inc\container\stack\array_stack.h"
+
+
+/******************************************************************************
+ * INTERNAL HELPERS
+ *****************************************************************************/
+
+static bool
+d_internal_array_stack_normalize_index
+(
+    size_t   _count,
+    d_index  _index,
+    size_t*  _out_index
+)
+{
+    d_index normalized;
+
+    if (!_out_index)
+    {
+        return false;
+    }
+
+    normalized = _index;
+
+    if (normalized < 0)
+    {
+        normalized = (d_index)_count + normalized;
+    }
+
+    if ( (normalized < 0) || (normalized >= (d_index)_count) )
+    {
+        return false;
+    }
+
+    *_out_index = (size_t)normalized;
+
+    return true;
+}
+
+static bool
+d_internal_array_stack_normalize_insert_index
+(
+    size_t   _count,
+    d_index  _index,
+    size_t*  _out_index
+)
+{
+    d_index normalized;
+
+    if (!_out_index)
+    {
+        return false;
+    }
+
+    normalized = _index;
+
+    if (normalized < 0)
+    {
+        normalized = (d_index)_count + normalized;
+    }
+
+    if ( (normalized < 0) || (normalized > (d_index)_count) )
+    {
+        return false;
+    }
+
+    *_out_index = (size_t)normalized;
+
+    return true;
+}
+
+static bool
+d_internal_array_stack_normalize_range
+(
+    size_t   _count,
+    d_index  _start,
+    d_index  _end,
+    size_t*  _out_start,
+    size_t*  _out_end
+)
+{
+    if (_start < 0)
+    {
+        _start = (d_index)_count + _start;
+    }
+
+    if (_end < 0)
+    {
+        _end = (d_index)_count + _end;
+    }
+
+    if ( (_start < 0)                 ||
+         (_end < 0)                   ||
+         (_start >= (d_index)_count)  ||
+         (_end >= (d_index)_count)    ||
+         (_start > _end) )
+    {
+        return false;
+    }
+
+    *_out_start = (size_t)_start;
+    *_out_end   = (size_t)_end;
+
+    return true;
+}
+
+static bool
+d_internal_array_stack_value_matches
+(
+    const void*    _a,
+    const void*    _b,
+    fn_comparator  _comparator
+)
+{
+    if (_comparator)
+    {
+        return (_comparator(_a, _b) == 0);
+    }
+
+    return (_a == _b);
+}
+
+static bool
+d_internal_array_stack_ensure
+(
+    struct d_array_stack* _stack,
+    size_t                _required
+)
+{
+    void* values;
+
+    if (_required <= _stack->capacity)
+    {
+        return true;
+    }
+
+    values = (void*)_stack->values;
+
+    if (!d_vector_common_ensure_capacity(&values,
+                                         _stack->count,
+                                         &_stack->capacity,
+                                         sizeof(void*),
+                                         _required))
+    {
+        return false;
+    }
+
+    _stack->values = (void**)values;
+
+    return true;
+}
+
+/*
+d_internal_array_stack_open_gap
+  Makes room for `_gap` values at top-first index `_index` and returns the
+first slot of the gap; the value that should end up at index `_index` goes in
+the gap's highest slot.
+*/
+static void**
+d_internal_array_stack_open_gap
+(
+    struct d_array_stack* _stack,
+    size_t                _index,
+    size_t                _gap
+)
+{
+    size_t position;
+
+    if (_stack->count > SIZE_MAX - _gap)
+    {
+        return NULL;
+    }
+
+    if (!d_internal_array_stack_ensure(_stack, _stack->count + _gap))
+    {
+        return NULL;
+    }
+
+    // everything at or below `_index` keeps its slot
+    position = _stack->count - _index;
+
+    if (_index > 0)
+    {
+        memmove(&_stack->values[position + _gap],
+                &_stack->values[position],
+                _index * sizeof(void*));
+    }
+
+    _stack->count += _gap;
+
+    return &_stack->values[position];
+}
+
+/*
+d_internal_array_stack_insert_range
+  Inserts a copy of `_source`'s top-first range [`_start`, `_end`] at
+`_index`. The range is copied out first when both stacks are the same.
+*/
+static bool
+d_internal_array_stack_insert_range
+(
+    struct d_array_stack*       _destination,
+    const struct d_array_stack* _source,
+    size_t                      _start,
+    size_t                      _end,
+    size_t                      _index
+)
+{
+    void**       gap;
+    void**       block;
+    const size_t length = _end - _start + 1;
+
+    // a top-first range is a contiguous, bottom-first run of slots
+    block = &_source->values[_source->count - 1 - _end];
+
+    if (_destination == _source)
+    {
+        block = malloc(length * sizeof(void*));
+
+        if (!block)
+        {
+            return false;
+        }
+
+        d_memcpy(block,
+                 &_source->values[_source->count - 1 - _end],
+                 length * sizeof(void*));
+    }
+
+    gap = d_internal_array_stack_open_gap(_destination, _index, length);
+
+    if (gap)
+    {
+        d_memcpy(gap, block, length * sizeof(void*));
+    }
+
+    if (_destination == _source)
+    {
+        free(block);
+    }
+
+    return (gap != NULL);
+}
+
+static void
+d_internal_array_stack_reverse_slots
+(
+    void** _values,
+    size_t _count
+)
+{
+    size_t low;
+    size_t high;
+    void*  tmp;
+
+    if (_count < 2)
+    {
+        return;
+    }
+
+    low  = 0;
+    high = _count - 1;
+
+    while (low < high)
+    {
+        tmp           = _values[low];
+        _values[low]  = _values[high];
+        _values[high] = tmp;
+
+        ++low;
+        --high;
+    }
+
+    return;
+}
+
+/*
+d_internal_array_stack_merge_sort
+  Stable bottom-up merge sort of `_values` into ascending `_comparator`
+order, using `_scratch` (at least `_count` slots).
+*/
+static void
+d_internal_array_stack_merge_sort
+(
+    void**        _values,
+    void**        _scratch,
+    size_t        _count,
+    fn_comparator _comparator
+)
+{
+    void** src;
+    void** dst;
+    void** tmp;
+    size_t width;
+    size_t low;
+    size_t mid;
+    size_t high;
+    size_t i;
+    size_t j;
+    size_t k;
+
+    src = _values;
+    dst = _scratch;
+
+    for (width = 1; width < _count; width *= 2)
+    {
+        for (low = 0; low < _count; low += 2 * width)
+        {
+            mid  = (low + width < _count) ? (low + width) : _count;
+            high = (mid + width < _count) ? (mid + width) : _count;
+            i    = low;
+            j    = mid;
+            k    = low;
+
+            while ( (i < mid) && (j < high) )
+            {
+                // take from the right run only if strictly smaller
+                dst[k++] = (_comparator(src[j], src[i]) < 0) ? src[j++]
+                                                             : src[i++];
+            }
+
+            while (i < mid)
+            {
+                dst[k++] = src[i++];
+            }
+
+            while (j < high)
+            {
+                dst[k++] = src[j++];
+            }
+        }
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != _values)
+    {
+        d_memcpy(_values, src, _count * sizeof(void*));
+    }
+
+    return;
+}
+
+/*
+d_internal_array_stack_insertion_sort
+  Stable in-place sort used when no scratch buffer could be allocated.
+*/
+static void
+d_internal_array_stack_insertion_sort
+(
+    void**        _values,
+    size_t        _count,
+    fn_comparator _comparator
+)
+{
+    size_t i;
+    size_t j;
+    void*  value;
+
+    for (i = 1; i < _count; ++i)
+    {
+        value = _values[i];
+        j     = i;
+
+        while ( (j > 0) &&
+                (_comparator(value, _values[j - 1]) < 0) )
+        {
+            _values[j] = _values[j - 1];
+            --j;
+        }
+
+        _values[j] = value;
+    }
+
+    return;
+}
+
+
+/******************************************************************************
+ * CREATION
+ *****************************************************************************/
+
+/*
+d_array_stack_new
+  Creates a new empty stack. No storage is allocated until the first push.
+
+Return:
+  Pointer to new stack, or NULL if allocation failed.
+*/
+struct d_array_stack*
+d_array_stack_new
+(
+    void
+)
+{
+    struct d_array_stack* result;
+
+    result = (struct d_array_stack*)malloc(sizeof(struct d_array_stack));
+    if (!result)
+    {
+        return NULL;
+    }
+
+    result->count    = 0;
+    result->capacity = 0;
+    result->values   = NULL;
+
+    return result;
+}
+
+/*
+d_array_stack_new_with_capacity
+  Creates a new empty stack with room for `_capacity` values.
+*/
+struct d_array_stack*
+d_array_stack_new_with_capacity
+(
+    size_t _capacity
+)
+{
+    struct d_array_stack* result;
+
+    result = d_array_stack_new();
+    if (!result)
+    {
+        return NULL;
+    }
+
+    if (!d_array_stack_reserve(result, _capacity))
+    {
+        free(result);
+
+        return NULL;
+    }
+
+    return result;
+}
+
+/*
+d_array_stack_new_from_arr
+  Creates a new stack from an array of value pointers.
+
+Note:
+  Values are treated as top-first order: `_values[0]` becomes the top element.
+*/
+struct d_array_stack*
+d_array_stack_new_from_arr
+(
+    const void* const* _values,
+    size_t             _value_count
+)
+{
+    struct d_array_stack* result;
+
+    if ( (_value_count > 0) && (!_values) )
+    {
+        return NULL;
+    }
+
+    result = d_array_stack_new_with_capacity(_value_count);
+    if (!result)
+    {
+        return NULL;
+    }
+
+    if (!d_array_stack_push_values(result, _values, _value_count))
+    {
+        d_array_stack_free(result);
+
+        return NULL;
+    }
+
+    return result;
+}
+
+/*
+d_array_stack_new_from_args
+  Creates a new stack from varargs containing value pointers.
+
+Note:
+  Values are treated as top-first order.
+*/
+struct d_array_stack*
+d_array_stack_new_from_args
+(
+    size_t _arg_count,
+    ...
+)
+{
+    struct d_array_stack* result;
+    va_list               args;
+    size_t                i;
+
+    result = d_array_stack_new_with_capacity(_arg_count);
+    if (!result)
+    {
+        return NULL;
+    }
+
+    va_start(args, _arg_count);
+
+    // the first argument is the top, i.e. the last slot
+    for (i = 0; i < _arg_count; ++i)
+    {
+        result->values[_arg_count - 1 - i] = va_arg(args, void*);
+    }
+
+    va_end(args);
+
+    result->count = _arg_count;
+
+    return result;
+}
+
+/*
+d_array_stack_new_copy
+  Creates a new stack that is a shallow copy of `_other`.
+*/
+struct d_array_stack*
+d_array_stack_new_copy
+(
+    const struct d_array_stack* _other
+)
+{
+    struct d_array_stack* result;
+
+    if (!_other)
+    {
+        return NULL;
+    }
+
+    result = d_array_stack_new_with_capacity(_other->count);
+    if (!result)
+    {
+        return NULL;
+    }
+
+    if (_other->count > 0)
+    {
+        d_memcpy(result->values, _other->values, _other->count * sizeof(void*));
+    }
+
+    result->count = _other->count;
+
+    return result;
+}
+
+/*
+d_array_stack_new_copy_range
+  Creates a new stack that is a shallow copy of a range of `_other`.
+
+Note:
+  `_start` and `_end` are inclusive indices. Negative indices count backward
+  from the end (e.g. -1 is the last element).
+*/
+struct d_array_stack*
+d_array_stack_new_copy_range
+(
+    const struct d_array_stack* _other,
+    d_index                     _start,
+    d_index                     _end
+)
+{
+    struct d_array_stack* result;
+
+    if (!_other)
+    {
+        return NULL;
+    }
+
+    result = d_array_stack_new();
+    if (!result)
+    {
+        return NULL;
+    }
+
+    if (_other->count == 0)
+    {
+        return result;
+    }
+
+    if (!d_array_stack_push_stack_range(result, _other, _start, _end))
+    {
+        d_array_stack_free(result);
+
+        return NULL;
+    }
+
+    return result;
+}
+
+/*
+d_array_stack_new_slice
+  Creates a shallow copy slice from `_start` to the end of `_other`.
+*/
+struct d_array_stack*
+d_array_stack_new_slice
+(
+    const struct d_array_stack* _other,
+    d_index                     _start
+)
+{
+    if (!_other)
+    {
+        return NULL;
+    }
+
+    if (_other->count == 0)
+    {
+        return d_array_stack_new();
+    }
+
+    return d_array_stack_new_copy_range(_other,
+                                        _start,
+                                        (d_index)(_other->count - 1));
+}
+
+/*
+d_array_stack_new_slice_range
+  Creates a shallow copy slice from `_start` to `_end` within `_other`.
+*/
+struct d_array_stack*
+d_array_stack_new_slice_range
+(
+    const struct d_array_stack* _other,
+    d_index                     _start,
+    d_index                     _end
+)
+{
+    return d_array_stack_new_copy_range(_other, _start, _end);
+}
+
+/*
+d_array_stack_new_fill
+  Creates a stack containing `_count` copies of the value pointer `_value`.
+*/
+struct d_array_stack*
+d_array_stack_new_fill
+(
+    size_t _count,
+    void*  _value
+)
+{
+    struct d_array_stack* result;
+    size_t                i;
+
+    result = d_array_stack_new_with_capacity(_count);
+    if (!result)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < _count; ++i)
+    {
+        result->values[i] = _value;
+    }
+
+    result->count = _count;
+
+    return result;
+}
+
+/*
+d_array_stack_new_merge
+  Creates a new stack by concatenating multiple stacks (shallow copy).
+
+Note:
+  Stacks are concatenated in the given order, from first to last.
+  Within each source stack, values retain their top-to-bottom order.
+*/
+struct d_array_stack*
+d_array_stack_new_merge
+(
+    size_t _stack_count,
+    ...
+)
+{
+    struct d_array_stack*       result;
+    const struct d_array_stack* src;
+    va_list                     args;
+    size_t                      i;
+
+    result = d_array_stack_new();
+    if (!result)
+    {
+        return NULL;
+    }
+
+    va_start(args, _stack_count);
+
+    for (i = 0; i < _stack_count; ++i)
+    {
+        src = va_arg(args, const struct d_array_stack*);
+
+        if ( (!src) ||
+             (!d_array_stack_append_stack(result, src)) )
+        {
+            va_end(args);
+
+            d_array_stack_free(result);
+
+            return NULL;
+        }
+    }
+
+    va_end(args);
+
+    return result;
+}
+
+
+/******************************************************************************
+ * MANIPULATION
+ *****************************************************************************/
+
+/*
+d_array_stack_push
+  Pushes a value onto the stack. Amortized O(1).
+*/
+bool
+d_array_stack_push
+(
+    struct d_array_stack* _stack,
+    void*                 _value
+)
+{
+    if (!_stack)
+    {
+        return false;
+    }
+
+    if ( (_stack->count == _stack->capacity) &&
+         (!d_internal_array_stack_ensure(_stack, _stack->count + 1)) )
+    {
+        return false;
+    }
+
+    _stack->values[_stack->count++] = _value;
+
+    return true;
+}
+
+/*
+d_array_stack_push_values
+  Pushes multiple values onto the stack (top-first order).
+
+Note:
+  `_values[0]` becomes the new top element, `_values[1]` becomes the next, etc.
+*/
+bool
+d_array_stack_push_values
+(
+    struct d_array_stack* _stack,
+    const void* const*    _values,
+    size_t                _value_count
+)
+{
+    return d_array_stack_insert_values(_stack, _values, _value_count, 0);
+}
+
+/*
+d_array_stack_push_args
+  Pushes multiple values onto the stack from varargs (top-first order).
+*/
+bool
+d_array_stack_push_args
+(
+    struct d_array_stack* _stack,
+    size_t                _arg_count,
+    ...
+)
+{
+    void**  gap;
+    va_list args;
+    size_t  i;
+
+    if (!_stack)
+    {
+        return false;
+    }
+
+    if (_arg_count == 0)
+    {
+        return true;
+    }
+
+    gap = d_internal_array_stack_open_gap(_stack, 0, _arg_count);
+    if (!gap)
+    {
+        return false;
+    }
+
+    va_start(args, _arg_count);
+
+    for (i = 0; i < _arg_count; ++i)
+    {
+        gap[_arg_count - 1 - i] = va_arg(args, void*);
+    }
+
+    va_end(args);
+
+    return true;
+}
+
+/*
+d_array_stack_push_stack
+  Pushes a shallow copy of `_source` onto `_destination` (top-first order).
+*/
+bool
+d_array_stack_push_stack
+(
+    struct d_array_stack*       _destination,
+    const struct d_array_stack* _source
+)
+{
+    return d_array_stack_insert_stack(_destination, _source, 0);
+}
+
+/*
+d_array_stack_push_stack_range
+  Pushes a shallow copy of a range of `_source` onto `_destination`.
+
+Note:
+  `_start` and `_end` are inclusive indices and support negative indexing.
+*/
+bool
+d_array_stack_push_stack_range
+(
+    struct d_array_stack*       _destination,
+    const struct d_array_stack* _source,
+    d_index                     _start,
+    d_index                     _end
+)
+{
+    return d_array_stack_insert_stack_range(_destination,
+                                            _source,
+                                            _start,
+                                            _end,
+                                            0);
+}
+
+/*
+d_array_stack_insert
+  Inserts a value pointer at an index (0 inserts at the top).
+
+Note:
+  Negative indices count backward from the end (e.g. -1 inserts before the last
+  element). Use `d_array_stack_append()` to insert at the bottom.
+*/
+bool
+d_array_stack_insert
+(
+    struct d_array_stack* _stack,
+    void*                 _value,
+    d_index               _index
+)
+{
+    return d_array_stack_insert_values(_stack,
+                                       (const void* const*)&_value,
+                                       1,
+                                       _index);
+}
+
+/*
+d_array_stack_insert_values
+  Inserts multiple values at an index (top-first within the inserted block).
+*/
+bool
+d_array_stack_insert_values
+(
+    struct d_array_stack* _stack,
+    const void* const*    _values,
+    size_t                _value_count,
+    d_index               _index
+)
+{
+    void** gap;
+    size_t index;
+    size_t i;
+
+    if (!_stack)
+    {
+        return false;
+    }
+
+    if ( (_value_count > 0) && (!_values) )
+    {
+        return false;
+    }
+
+    index = 0;
+
+    if (!d_internal_array_stack_normalize_insert_index(_stack->count,
+                                                       _index,
+                                                       &index))
+    {
+        return false;
+    }
+
+    if (_value_count == 0)
+    {
+        return true;
+    }
+
+    gap = d_internal_array_stack_open_gap(_stack, index, _value_count);
+    if (!gap)
+    {
+        return false;
+    }
+
+    for (i = 0; i < _value_count; ++i)
+    {
+        gap[_value_count - 1 - i] = (void*)_values[i];
+    }
+
+    return true;
+}
+
+/*
+d_array_stack_insert_stack
+  Inserts a shallow copy of `_source` into `_destination` at an index.
+*/
+bool
+d_array_stack_insert_stack
+(
+    struct d_array_stack*       _destination,
+    const struct d_array_stack* _source,
+    d_index                     _index
+)
+{
+    if ( (!_destination) || (!_source) )
+    {
+        return false;
+    }
+
+    if (_source->count == 0)
+    {
+        return true;
+    }
+
+    return d_array_stack_insert_stack_range(_destination,
+                                            _source,
+                                            0,
+                                            (d_index)(_source->count - 1),
+                                            _index);
+}
+
+/*
+d_array_stack_insert_stack_range
+  Inserts a shallow copy of a range of `_source` into `_destination` at an
+  index.
+
+Note:
+  `_start` and `_end` are inclusive indices and support negative indexing.
+*/
+bool
+d_array_stack_insert_stack_range
+(
+    struct d_array_stack*       _destination,
+    const struct d_array_stack* _source,
+    d_index                     _start,
+    d_index                     _end,
+    d_index                     _index
+)
+{
+    size_t start;
+    size_t end;
+    size_t index;
+
+    if ( (!_destination) || (!_source) )
+    {
+        return false;
+    }
+
+    if (_source->count == 0)
+    {
+        return true;
+    }
+
+    start = 0;
+    end   = 0;
+    index = 0;
+
+    if ( (!d_internal_array_stack_normalize_range(_source->count,
+                                                  _start,
+                                                  _end,
+                                                  &start,
+                                                  &end)) ||
+         (!d_internal_array_stack_normalize_insert_index(_destination->count,
+                                                         _index,
+                                                         &index)) )
+    {
+        return false;
+    }
+
+    return d_internal_array_stack_insert_range(_destination,
+                                               _source,
+                                               start,
+                                               end,
+                                               index);
+}
+
+/*
+d_array_stack_append
+  Appends a value pointer to the bottom of the stack. O(n), since every
+  value moves up one slot.
+*/
+bool
+d_array_stack_append
+(
+    struct d_array_stack* _stack,
+    void*                 _value
+)
+{
+    if (!_stack)
+    {
+        return false;
+    }
+
+    return d_array_stack_insert(_stack, _value, (d_index)_stack->count);
+}
+
+/*
+d_array_stack_append_values
+  Appends multiple values to the bottom of the stack (top-first order within
+  the appended block).
+*/
+bool
+d_array_stack_append_values
+(
+    struct d_array_stack* _stack,
+    const void* const*    _values,
+    size_t                _value_count
+)
+{
+    if (!_stack)
+    {
+        return false;
+    }
+
+    return d_array_stack_insert_values(_stack,
+                                       _values,
+                                       _value_count,
+                                       (d_index)_stack->count);
+}
+
+/*
+d_array_stack_append_stack
+  Appends a shallow copy of `_source` to the bottom of `_destination`.
+*/
+bool
+d_array_stack_append_stack
+(
+    struct d_array_stack*       _destination,
+    const struct d_array_stack* _source
+)
+{
+    if ( (!_destination) || (!_source) )
+    {
+        return false;
+    }
+
+    return d_array_stack_insert_stack(_destination,
+                                      _source,
+                                      (d_index)_destination->count);
+}
+
+/*
+d_array_stack_append_stack_range
+  Appends a shallow copy of a range of `_source` to the bottom of
+  `_destination`.
+*/
+bool
+d_array_stack_append_stack_range
+(
+    struct d_array_stack*       _destination,
+    const struct d_array_stack* _source,
+    d_index                     _start,
+    d_index                     _end
+)
+{
+    if ( (!_destination) || (!_source) )
+    {
+        return false;
+    }
+
+    return d_array_stack_insert_stack_range(_destination,
+                                            _source,
+                                            _start,
+                                            _end,
+                                            (d_index)_destination->count);
+}
+
+/*
+d_array_stack_peek
+  Returns the value at the top of the stack, or NULL if empty.
+*/
+void*
+d_array_stack_peek
+(
+    const struct d_array_stack* _stack
+)
+{
+    if ( (!_stack) || (_stack->count == 0) )
+    {
+        return NULL;
+    }
+
+    return _stack->values[_stack->count - 1];
+}
+
+/*
+d_array_stack_peek_if_nonnull
+  Returns the value at the top of the stack, or NULL if stack is NULL or empty.
+*/
+void*
+d_array_stack_peek_if_nonnull
+(
+    const struct d_array_stack* _stack
+)
+{
+    return d_array_stack_peek(_stack);
+}
+
+/*
+d_array_stack_pop
+  Pops the top value from the stack. Storage is kept for later pushes.
+*/
+void*
+d_array_stack_pop
+(
+    struct d_array_stack* _stack
+)
+{
+    if ( (!_stack) || (_stack->count == 0) )
+    {
+        return NULL;
+    }
+
+    return _stack->values[--_stack->count];
+}
+
+/*
+d_array_stack_get
+  Returns the value pointer at an index, or NULL if out of range.
+
+Note:
+  Negative indices count backward from the end (e.g. -1 is the last element).
+*/
+void*
+d_array_stack_get
+(
+    const struct d_array_stack* _stack,
+    d_index                     _index
+)
+{
+    void** slot;
+
+    slot = d_array_stack_get_slot(_stack, _index);
+
+    return (slot) ? *slot : NULL;
+}
+
+/*
+d_array_stack_set
+  Sets the value pointer at an index.
+
+Note:
+  Negative indices count backward from the end (e.g. -1 is the last element).
+
+Return:
+  true if the index exists, otherwise false.
+*/
+bool
+d_array_stack_set
+(
+    struct d_array_stack* _stack,
+    d_index               _index,
+    void*                 _value
+)
+{
+    void** slot;
+
+    slot = d_array_stack_get_slot(_stack, _index);
+    if (!slot)
+    {
+        return false;
+    }
+
+    *slot = _value;
+
+    return true;
+}
+
+/*
+d_array_stack_get_slot
+  Returns a pointer to the slot at an index, or NULL if out of range. The
+  pointer is invalidated by any operation that adds or removes values.
+
+Note:
+  Negative indices count backward from the end (e.g. -1 is the last element).
+*/
+void**
+d_array_stack_get_slot
+(
+    const struct d_array_stack* _stack,
+    d_index                     _index
+)
+{
+    size_t index;
+
+    if (!_stack)
+    {
+        return NULL;
+    }
+
+    index = 0;
+
+    if (!d_internal_array_stack_normalize_index(_stack->count, _index, &index))
+    {
+        return NULL;
+    }
+
+    return &_stack->values[_stack->count - 1 - index];
+}
+
+/*
+d_array_stack_remove_at
+  Removes the value at an index and returns it.
+
+Note:
+  Negative indices count backward from the end (e.g. -1 is the last element).
+*/
+void*
+d_array_stack_remove_at
+(
+    struct d_array_stack* _stack,
+    d_index               _index
+)
+{
+    void** slot;
+    void*  value;
+    size_t above;
+
+    slot = d_array_stack_get_slot(_stack, _index);
+    if (!slot)
+    {
+        return NULL;
+    }
+
+    value = *slot;
+    above = (size_t)(&_stack->values[_stack->count - 1] - slot);
+
+    if (above > 0)
+    {
+        memmove(slot, slot + 1, above * sizeof(void*));
+    }
+
+    --_stack->count;
+
+    return value;
+}
+
+/*
+d_array_stack_remove_first_match
+  Removes the first matching value (from the top) and returns it through
+  `_removed_value`.
+
+Return:
+  true if a value was removed, otherwise false.
+*/
+bool
+d_array_stack_remove_first_match
+(
+    struct d_array_stack* _stack,
+    const void*           _value,
+    fn_comparator         _comparator,
+    void**                _removed_value
+)
+{
+    ssize_t index;
+    void*   value;
+
+    index = d_array_stack_find(_stack, _value, _comparator);
+    if (index < 0)
+    {
+        return false;
+    }
+
+    value = d_array_stack_remove_at(_stack, (d_index)index);
+
+    if (_removed_value)
+    {
+        *_removed_value = value;
+    }
+
+    return true;
+}
+
+/*
+d_array_stack_is_empty
+  Returns true if the stack is empty (or NULL), otherwise false.
+*/
+bool
+d_array_stack_is_empty
+(
+    const struct d_array_stack* _stack
+)
+{
+    if (!_stack)
+    {
+        return true;
+    }
+
+    return (_stack->count == 0);
+}
+
+/*
+d_array_stack_contains
+  Returns true if the stack contains the value.
+
+Comparator behavior:
+  If `_comparator` is NULL, pointer equality is used.
+*/
+bool
+d_array_stack_contains
+(
+    const struct d_array_stack* _stack,
+    const void*                 _value,
+    fn_comparator               _comparator
+)
+{
+    return (d_array_stack_find(_stack, _value, _comparator) >= 0);
+}
+
+/*
+d_array_stack_find
+  Returns the index of the first match from the top, or -1 if not found.
+
+Comparator behavior:
+  If `_comparator` is NULL, pointer equality is used.
+*/
+ssize_t
+d_array_stack_find
+(
+    const struct d_array_stack* _stack,
+    const void*                 _value,
+    fn_comparator               _comparator
+)
+{
+    size_t i;
+
+    if (!_stack)
+    {
+        return (ssize_t)-1;
+    }
+
+    for (i = 0; i < _stack->count; ++i)
+    {
+        if (d_internal_array_stack_value_matches(_stack->values[_stack->count - 1 - i],
+                                                 _value,
+                                                 _comparator))
+        {
+            return (ssize_t)i;
+        }
+    }
+
+    return (ssize_t)-1;
+}
+
+/*
+d_array_stack_find_slot
+  Returns the slot of the first match from the top, or NULL if not found.
+*/
+void**
+d_array_stack_find_slot
+(
+    const struct d_array_stack* _stack,
+    const void*                 _value,
+    fn_comparator               _comparator
+)
+{
+    ssize_t index;
+
+    index = d_array_stack_find(_stack, _value, _comparator);
+    if (index < 0)
+    {
+        return NULL;
+    }
+
+    return &_stack->values[_stack->count - 1 - (size_t)index];
+}
+
+/*
+d_array_stack_reverse
+  Reverses the stack order in place.
+*/
+bool
+d_array_stack_reverse
+(
+    struct d_array_stack* _stack
+)
+{
+    if (!_stack)
+    {
+        return false;
+    }
+
+    d_internal_array_stack_reverse_slots(_stack->values, _stack->count);
+
+    return true;
+}
+
+
+/******************************************************************************
+ * SORTING
+ *****************************************************************************/
+
+/*
+d_array_stack_sort
+  Stable sort of the stack. Uses a merge sort with one scratch allocation,
+  or an in-place insertion sort if that allocation fails.
+
+Ordering:
+  If `_comparator(a, b) < 0`, `a` will appear before `b` (closer to the top).
+*/
+void
+d_array_stack_sort
+(
+    struct d_array_stack* _stack,
+    fn_comparator         _comparator
+)
+{
+    void** scratch;
+
+    if ( (!_stack)      ||
+         (!_comparator) ||
+         (_stack->count < 2) )
+    {
+        return;
+    }
+
+    // sort in top-first order, then restore the bottom-first layout
+    d_internal_array_stack_reverse_slots(_stack->values, _stack->count);
+
+    scratch = malloc(_stack->count * sizeof(void*));
+
+    if (scratch)
+    {
+        d_internal_array_stack_merge_sort(_stack->values,
+                                          scratch,
+                                          _stack->count,
+                                          _comparator);
+        free(scratch);
+    }
+    else
+    {
+        d_internal_array_stack_insertion_sort(_stack->values,
+                                              _stack->count,
+                                              _comparator);
+    }
+
+    d_internal_array_stack_reverse_slots(_stack->values, _stack->count);
+
+    return;
+}
+
+
+/******************************************************************************
+ * CAPACITY
+ *****************************************************************************/
+
+/*
+d_array_stack_reserve
+  Ensures room for at least `_capacity` values without reallocation.
+*/
+bool
+d_array_stack_reserve
+(
+    struct d_array_stack* _stack,
+    size_t                _capacity
+)
+{
+    void* values;
+
+    if (!_stack)
+    {
+        return false;
+    }
+
+    values = (void*)_stack->values;
+
+    if (!d_vector_common_reserve(&values,
+                                 _stack->count,
+                                 &_stack->capacity,
+                                 sizeof(void*),
+                                 _capacity))
+    {
+        return false;
+    }
+
+    _stack->values = (void**)values;
+
+    return true;
+}
+
+/*
+d_array_stack_shrink_to_fit
+  Releases unused capacity.
+*/
+bool
+d_array_stack_shrink_to_fit
+(
+    struct d_array_stack* _stack
+)
+{
+    void** values;
+
+    if (!_stack)
+    {
+        return false;
+    }
+
+    if (_stack->count == _stack->capacity)
+    {
+        return true;
+    }
+
+    if (_stack->count == 0)
+    {
+        free(_stack->values);
+
+        _stack->values   = NULL;
+        _stack->capacity = 0;
+
+        return true;
+    }
+
+    values = realloc(_stack->values, _stack->count * sizeof(void*));
+    if (!values)
+    {
+        return false;
+    }
+
+    _stack->values   = values;
+    _stack->capacity = _stack->count;
+
+    return true;
+}
+
+
+/******************************************************************************
+ * ITERATION
+ *****************************************************************************/
+
+/*
+d_array_stack_iter_begin
+  Returns the top slot, or NULL if the stack is NULL or empty.
+*/
+void**
+d_array_stack_iter_begin
+(
+    const struct d_array_stack* _stack
+)
+{
+    if ( (!_stack) || (_stack->count == 0) )
+    {
+        return NULL;
+    }
+
+    return &_stack->values[_stack->count - 1];
+}
+
+/*
+d_array_stack_iter_next
+  Returns the slot below `_slot`, or NULL once the bottom has been passed.
+*/
+void**
+d_array_stack_iter_next
+(
+    const struct d_array_stack* _stack,
+    void**                      _slot
+)
+{
+    if ( (!_stack) || (!_slot) || (_slot == _stack->values) )
+    {
+        return NULL;
+    }
+
+    return _slot - 1;
+}
+
+
+/******************************************************************************
+ * MEMORY MANAGEMENT
+ *****************************************************************************/
+
+/*
+d_array_stack_clear
+  Clears a stack (shallow; does not free stored values). Capacity is kept.
+
+Return:
+  true if the stack pointer was valid, otherwise false.
+*/
+bool
+d_array_stack_clear
+(
+    struct d_array_stack* _stack
+)
+{
+    if (!_stack)
+    {
+        return false;
+    }
+
+    _stack->count = 0;
+
+    return true;
+}
+
+/*
+d_array_stack_clear_deep
+  Clears a stack and frees stored values (top to bottom) using `_free_fn`.
+
+Return:
+  true if the stack pointer was valid, otherwise false.
+*/
+bool
+d_array_stack_clear_deep
+(
+    struct d_array_stack* _stack,
+    fn_free               _free_fn
+)
+{
+    if (!_stack)
+    {
+        return false;
+    }
+
+    if (_free_fn)
+    {
+        while (_stack->count > 0)
+        {
+            _free_fn(_stack->values[--_stack->count]);
+        }
+    }
+
+    _stack->count = 0;
+
+    return true;
+}
+
+/*
+d_array_stack_free
+  Frees a stack (shallow; does not free stored values).
+*/
+void
+d_array_stack_free
+(
+    struct d_array_stack* _stack
+)
+{
+    if (_stack)
+    {
+        free(_stack->values);
+        free(_stack);
+    }
+
+    return;
+}
+
+/*
+d_array_stack_free_deep
+  Frees a stack and also frees stored values using `_free_fn`.
+*/
+void
+d_array_stack_free_deep
+(
+    struct d_array_stack* _stack,
+    fn_free               _free_fn
+)
+{
+    if (_stack)
+    {
+        d_array_stack_clear_deep(_stack, _free_fn);
+        d_array_stack_free(_stack);
+    }
+
+    return;
+}
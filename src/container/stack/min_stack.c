@@ -48,24 +48,10 @@ d_min_stack_clear
 	struct d_min_stack* _min_stack
 )
 {
-	struct d_linked_node* node;
-	struct d_linked_node* next;
-
 	if (_min_stack)
 	{
-		node = _min_stack->top;
-
-		while (node)
-		{
-			// save next node
-			next = node->next;
-
-			// free current node
-			d_linked_node_free(node);
-
-			// current node is now whichever node was next
-			node = next;
-		}
+		// release the whole chain of nodes at once
+		d_linked_node_free_chain(_min_stack->top);
 
 		// reset top to NULL after clearing all nodes
 		_min_stack->top = NULL;
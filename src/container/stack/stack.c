@@ -10,6 +10,7 @@
 ******************************************************************************/
 
 #include ".\stack.h"
+#include <limits.h>
 
 
 
@@ -708,6 +709,11 @@ d_stack_reverse
  * SORTING
  *****************************************************************************/
 
+// D_INTERNAL_STACK_SORT_LEVELS
+//   constant: merge levels d_stack_sort needs for any stack that fits in
+// memory (one per bit of size_t).
+#define D_INTERNAL_STACK_SORT_LEVELS (sizeof(size_t) * CHAR_BIT)
+
 static bool
 d_internal_stack_sort_before
 (
@@ -725,12 +731,131 @@ d_internal_stack_sort_before
     return (_comparator(_a, _b) < 0);
 }
 
+/*
+d_internal_stack_sort_take_run
+  Detaches the natural run at the front of `*_cursor`. A non-descending run
+is cut off as-is; a strictly descending run is reversed while it is read
+(strictly, so equal values never swap and the sort stays stable).
+
+Parameter(s):
+  _cursor:     the unsorted remainder; advanced past the run.
+  _comparator: comparison function.
+Return:
+  The run, as a NULL-terminated list in sorted order.
+*/
+static struct d_linked_node*
+d_internal_stack_sort_take_run
+(
+    struct d_linked_node** _cursor,
+    fn_comparator          _comparator
+)
+{
+    struct d_linked_node* run;
+    struct d_linked_node* tail;
+    struct d_linked_node* node;
+    struct d_linked_node* next;
+
+    run  = *_cursor;
+    node = run->next;
+
+    // descending run: prepend each node, reversing the run in one pass
+    if ( (node) &&
+         (d_internal_stack_sort_before(node->value, run->value, _comparator)) )
+    {
+        run->next = NULL;
+
+        do
+        {
+            next       = node->next;
+            node->next = run;
+            run        = node;
+            node       = next;
+        } while ( (node) &&
+                  (d_internal_stack_sort_before(node->value,
+                                                run->value,
+                                                _comparator)) );
+
+        *_cursor = node;
+
+        return run;
+    }
+
+    // non-descending run: extend while no node sorts before its predecessor
+    // (the first pair, if any, was just compared above)
+    tail = (node) ? node : run;
+
+    while ( (tail->next) &&
+            (!d_internal_stack_sort_before(tail->next->value,
+                                           tail->value,
+                                           _comparator)) )
+    {
+        tail = tail->next;
+    }
+
+    *_cursor   = tail->next;
+    tail->next = NULL;
+
+    return run;
+}
+
+/*
+d_internal_stack_sort_merge
+  Stably merges two sorted lists; on ties, nodes from `_a` come first.
+
+Parameter(s):
+  _a:          the sorted list that came first in the original order.
+  _b:          the sorted list that came after it.
+  _comparator: comparison function.
+Return:
+  The merged list.
+*/
+static struct d_linked_node*
+d_internal_stack_sort_merge
+(
+    struct d_linked_node* _a,
+    struct d_linked_node* _b,
+    fn_comparator         _comparator
+)
+{
+    struct d_linked_node  head;
+    struct d_linked_node* tail;
+
+    tail = &head;
+
+    while ( (_a) &&
+            (_b) )
+    {
+        if (d_internal_stack_sort_before(_b->value, _a->value, _comparator))
+        {
+            tail->next = _b;
+            _b         = _b->next;
+        }
+        else
+        {
+            tail->next = _a;
+            _a         = _a->next;
+        }
+
+        tail = tail->next;
+    }
+
+    tail->next = (_a) ? _a : _b;
+
+    return head.next;
+}
+
 /*
 d_stack_sort
-  Sorts the stack in-place by relinking nodes.
+  Sorts the stack in-place by relinking nodes, using a stable bottom-up
+merge sort over the stack's natural runs. No memory is allocated.
+  Input is split into maximal non-descending runs (strictly descending runs
+are reversed on the fly), and runs are merged pairwise like a binary
+counter, so an already sorted or reverse sorted stack costs n - 1
+comparisons and the worst case is O(n log n).
 
 Ordering:
   If `_comparator(a, b) < 0`, `a` will appear before `b` (closer to the top).
+  Values that compare equal keep their relative order.
 */
 void
 d_stack_sort
@@ -739,61 +864,58 @@ d_stack_sort
     fn_comparator   _comparator
 )
 {
-    struct d_linked_node* sorted;
-    struct d_linked_node* cur;
-    struct d_linked_node* next;
-    struct d_linked_node* insert_prev;
+    struct d_linked_node* pending[D_INTERNAL_STACK_SORT_LEVELS];
+    struct d_linked_node* cursor;
+    struct d_linked_node* run;
+    size_t                levels;
+    size_t                i;
 
     if ( (!_stack) || (!_comparator) )
     {
         return;
     }
 
-    sorted = NULL;
-    cur    = _stack->top;
-    next   = NULL;
+    // pending[i] holds a merged run built from about 2^i natural runs;
+    // higher levels always came earlier in the stack
+    levels = 0;
+    cursor = _stack->top;
 
-    while (cur)
+    while (cursor)
     {
-        next = cur->next;
-        cur->next = NULL;
+        run = d_internal_stack_sort_take_run(&cursor, _comparator);
 
-        if (!sorted)
+        for (i = 0; (i < levels) && (pending[i]); ++i)
         {
-            sorted = cur;
-            cur    = next;
-            continue;
+            run        = d_internal_stack_sort_merge(pending[i],
+                                                     run,
+                                                     _comparator);
+            pending[i] = NULL;
         }
 
-        // insert at head?
-        if (d_internal_stack_sort_before(cur->value,
-                                         sorted->value,
-                                         _comparator))
+        // the run count is bounded by SIZE_MAX, so `i` never runs off the end
+        pending[i] = run;
+
+        if (i == levels)
         {
-            cur->next = sorted;
-            sorted    = cur;
-            cur       = next;
-            continue;
+            ++levels;
         }
+    }
 
-        // find insertion point
-        insert_prev = sorted;
+    // fold the leftover levels, newest (lowest) first
+    run = NULL;
 
-        while (insert_prev->next &&
-               !d_internal_stack_sort_before(cur->value,
-                                             insert_prev->next->value,
-                                             _comparator))
+    for (i = 0; i < levels; ++i)
+    {
+        if (pending[i])
         {
-            insert_prev = insert_prev->next;
+            run = (run) ? d_internal_stack_sort_merge(pending[i],
+                                                      run,
+                                                      _comparator)
+                        : pending[i];
         }
-
-        cur->next = insert_prev->next;
-        insert_prev->next = cur;
-
-        cur = next;
     }
 
-    _stack->top = sorted;
+    _stack->top = run;
 
     return;
 }
@@ -1108,7 +1108,8 @@ d_stack_common_validate_params
 
 /*
 d_stack_common_free_nodes
-  Frees every node in a stack (shallow; does not free node values).
+  Frees every node in a stack (shallow; does not free node values). The
+  whole chain is released in one call rather than node by node.
 
 Parameter(s):
   _top: the top node, or NULL.
@@ -1119,20 +1120,7 @@ d_stack_common_free_nodes
     struct d_linked_node* _top
 )
 {
-    struct d_linked_node* cur;
-    struct d_linked_node* next;
-
-    cur  = _top;
-    next = NULL;
-
-    while (cur)
-    {
-        next = cur->next;
-
-        d_linked_node_free(cur);
-
-        cur = next;
-    }
+    d_linked_node_free_chain(_top);
 
     return;
 }
@@ -1153,27 +1141,16 @@ d_stack_common_free_nodes_deep
 )
 {
     struct d_linked_node* cur;
-    struct d_linked_node* next;
 
-    if (!_free_fn)
+    if (_free_fn)
     {
-        d_stack_common_free_nodes(_top);
-
-        return;
+        for (cur = _top; cur; cur = cur->next)
+        {
+            _free_fn(cur->value);
+        }
     }
 
-    cur  = _top;
-    next = NULL;
-
-    while (cur)
-    {
-        next = cur->next;
-
-        _free_fn(cur->value);
-        d_linked_node_free(cur);
-
-        cur = next;
-    }
+    d_linked_node_free_chain(_top);
 
     return;
 }
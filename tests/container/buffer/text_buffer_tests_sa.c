@@ -17,7 +17,10 @@ d_tests_sa_text_buffer_run_all
   - Filter functions
   - Utility functions
   - Conversion functions
+  - Rope mode functions
+  - Gap mode functions
   - Memory management functions
+  - The mode-agnostic categories again, in forced rope and gap modes
 */
 bool
 d_tests_sa_text_buffer_run_all
@@ -38,5 +41,9 @@ d_tests_sa_text_buffer_run_all
            d_tests_sa_text_buffer_filter_all(_counter)          &&
            d_tests_sa_text_buffer_utility_all(_counter)         &&
            d_tests_sa_text_buffer_conversion_all(_counter)      &&
-           d_tests_sa_text_buffer_memory_all(_counter);
+           d_tests_sa_text_buffer_rope_all(_counter)            &&
+           d_tests_sa_text_buffer_gap_all(_counter)             &&
+           d_tests_sa_text_buffer_memory_all(_counter)          &&
+           d_tests_sa_text_buffer_forced_rope_all(_counter)     &&
+           d_tests_sa_text_buffer_forced_gap_all(_counter);
 }
\ No newline at end of file
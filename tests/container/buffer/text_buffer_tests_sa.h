@@ -5,7 +5,9 @@
 *   Provides comprehensive testing of all d_text_buffer functions including
 * creation, capacity management, string operations (resize and append modes),
 * modification, access, search, comparison, text processing, utility,
-* conversion, and memory management.
+* conversion, rope and gap modes, and memory management. The mode-agnostic
+* categories are also rerun with every constructed buffer forced into rope
+* mode and then gap mode (see text_buffer_tests_sa_forced.c).
 *
 *   NOTE: Section X (filter) is excluded because it depends on the external
 * d_filter_expr / d_filter_evaluate API from filter.h, which is tested
@@ -29,6 +31,48 @@
 #include "..\..\..\inc\string_fn.h"
 
 
+// d_tests_sa_text_buffer_mode
+//   enum: mode every buffer constructed by the tests is switched to; only
+// changed for the duration of a forced run.
+enum d_tests_sa_text_buffer_mode
+{
+    D_TESTS_SA_TEXT_BUFFER_MODE_RESIZE = 0,
+    D_TESTS_SA_TEXT_BUFFER_MODE_ROPE,
+    D_TESTS_SA_TEXT_BUFFER_MODE_GAP
+};
+
+struct d_text_buffer* d_tests_sa_text_buffer_force_mode(struct d_text_buffer* _buffer);
+
+// constructors used by the tests pass their result through
+// d_tests_sa_text_buffer_force_mode, so forced runs need no test changes
+#define d_text_buffer_new(capacity)                                         \
+    d_tests_sa_text_buffer_force_mode(d_text_buffer_new(capacity))
+#define d_text_buffer_new_default_capacity()                                \
+    d_tests_sa_text_buffer_force_mode(d_text_buffer_new_default_capacity())
+#define d_text_buffer_new_from_string(string)                               \
+    d_tests_sa_text_buffer_force_mode(d_text_buffer_new_from_string(string))
+#define d_text_buffer_new_from_string_n(string, length)                     \
+    d_tests_sa_text_buffer_force_mode(                                      \
+        d_text_buffer_new_from_string_n(string, length))
+#define d_text_buffer_new_from_strings(...)                                 \
+    d_tests_sa_text_buffer_force_mode(                                      \
+        d_text_buffer_new_from_strings(__VA_ARGS__))
+#define d_text_buffer_new_from_buffer(data, length)                         \
+    d_tests_sa_text_buffer_force_mode(                                      \
+        d_text_buffer_new_from_buffer(data, length))
+#define d_text_buffer_new_copy(other)                                       \
+    d_tests_sa_text_buffer_force_mode(d_text_buffer_new_copy(other))
+#define d_text_buffer_new_copy_range(other, start, end)                     \
+    d_tests_sa_text_buffer_force_mode(                                      \
+        d_text_buffer_new_copy_range(other, start, end))
+#define d_text_buffer_new_fill(length, fill_char)                           \
+    d_tests_sa_text_buffer_force_mode(                                      \
+        d_text_buffer_new_fill(length, fill_char))
+#define d_text_buffer_new_formatted(...)                                    \
+    d_tests_sa_text_buffer_force_mode(                                      \
+        d_text_buffer_new_formatted(__VA_ARGS__))
+
+
 // I. creation function tests
 bool d_tests_sa_text_buffer_new(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_new_default_capacity(struct d_test_counter* _counter);
@@ -80,6 +124,7 @@ bool d_tests_sa_text_buffer_set_buffer(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_set_formatted(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_replace_char(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_replace_string(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_replace_many(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_replace_range(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_remove_char(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_remove_range(struct d_test_counter* _counter);
@@ -107,6 +152,12 @@ bool d_tests_sa_text_buffer_starts_with(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_ends_with(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_count_char(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_count_string(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_search_embedded_nul(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_search_chunked(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_search_chunk_straddle(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_find_any(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_count_each(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_matcher_chunk_prefix(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_search_all(struct d_test_counter* _counter);
 
 // comparison operations function tests
@@ -144,6 +195,9 @@ bool d_tests_sa_text_buffer_length(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_capacity(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_utilization(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_hash(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_hash_chunks(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_hash_splits(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_incremental_hash(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_utility_all(struct d_test_counter* _counter);
 
 // conversion function tests
@@ -153,10 +207,29 @@ bool d_tests_sa_text_buffer_copy_to_buffer_n(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_to_d_string(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_conversion_all(struct d_test_counter* _counter);
 
+// rope mode function tests
+bool d_tests_sa_text_buffer_enable_rope(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_rope_edits(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_rope_interleaved(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_rope_matches_flat(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_rope_chunks(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_rope_all(struct d_test_counter* _counter);
+
+// gap mode function tests
+bool d_tests_sa_text_buffer_enable_gap(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_gap_edits(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_gap_interleaved(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_gap_matches_flat(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_gap_all(struct d_test_counter* _counter);
+
 // destruction tests
 bool d_tests_sa_text_buffer_free(struct d_test_counter* _counter);
 bool d_tests_sa_text_buffer_memory_all(struct d_test_counter* _counter);
 
+// forced mode runs
+bool d_tests_sa_text_buffer_forced_rope_all(struct d_test_counter* _counter);
+bool d_tests_sa_text_buffer_forced_gap_all(struct d_test_counter* _counter);
+
 
 // module-level aggregation
 bool d_tests_sa_text_buffer_run_all(struct d_test_counter* _counter);
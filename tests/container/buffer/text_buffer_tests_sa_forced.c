@@ -0,0 +1,135 @@
+#include ".\text_buffer_tests_sa.h"
+
+
+// mode applied by d_tests_sa_text_buffer_force_mode, and the number of
+// buffers it switched during the current forced run
+static enum d_tests_sa_text_buffer_mode d_tests_sa_text_buffer_forced_mode =
+    D_TESTS_SA_TEXT_BUFFER_MODE_RESIZE;
+static size_t d_tests_sa_text_buffer_forced_count = 0;
+
+
+/*
+d_tests_sa_text_buffer_force_mode
+  Switches a freshly constructed buffer to the current forced mode. NULL
+and resize mode pass through untouched.
+*/
+struct d_text_buffer*
+d_tests_sa_text_buffer_force_mode
+(
+    struct d_text_buffer* _buffer
+)
+{
+    if (!_buffer)
+    {
+        return NULL;
+    }
+
+    switch (d_tests_sa_text_buffer_forced_mode)
+    {
+        case D_TESTS_SA_TEXT_BUFFER_MODE_ROPE:
+            if (d_text_buffer_enable_rope(_buffer))
+            {
+                d_tests_sa_text_buffer_forced_count++;
+            }
+
+            break;
+
+        case D_TESTS_SA_TEXT_BUFFER_MODE_GAP:
+            if (d_text_buffer_enable_gap(_buffer))
+            {
+                d_tests_sa_text_buffer_forced_count++;
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+    return _buffer;
+}
+
+/*
+d_tests_sa_text_buffer_forced_run
+  Reruns every mode-agnostic category with `_mode` forced on each buffer the
+tests construct, then restores resize mode. The rope and gap sections are
+left out: they check the mode switches themselves.
+*/
+static bool
+d_tests_sa_text_buffer_forced_run
+(
+    enum d_tests_sa_text_buffer_mode _mode,
+    const char*                      _name,
+    struct d_test_counter*           _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    d_tests_sa_text_buffer_forced_mode  = _mode;
+    d_tests_sa_text_buffer_forced_count = 0;
+
+    result = d_tests_sa_text_buffer_creation_all(_counter) && result;
+    result = d_tests_sa_text_buffer_capacity_all(_counter) && result;
+    result = d_tests_sa_text_buffer_string_ops_all(_counter) && result;
+    result = d_tests_sa_text_buffer_append_mode_all(_counter) && result;
+    result = d_tests_sa_text_buffer_modification_all(_counter) && result;
+    result = d_tests_sa_text_buffer_access_all(_counter) && result;
+    result = d_tests_sa_text_buffer_search_all(_counter) && result;
+    result = d_tests_sa_text_buffer_comparison_all(_counter) && result;
+    result = d_tests_sa_text_buffer_text_processing_all(_counter) && result;
+    result = d_tests_sa_text_buffer_filter_all(_counter) && result;
+    result = d_tests_sa_text_buffer_utility_all(_counter) && result;
+    result = d_tests_sa_text_buffer_conversion_all(_counter) && result;
+    result = d_tests_sa_text_buffer_memory_all(_counter) && result;
+
+    d_tests_sa_text_buffer_forced_mode = D_TESTS_SA_TEXT_BUFFER_MODE_RESIZE;
+
+    // guards against the constructor hooks silently not applying
+    result = d_assert_standalone(
+        d_tests_sa_text_buffer_forced_count > 0,
+        _name,
+        "Constructed buffers should have been switched to the forced mode",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_forced_rope_all
+  Aggregation function that reruns the mode-agnostic categories with every
+buffer in rope mode.
+*/
+bool
+d_tests_sa_text_buffer_forced_rope_all
+(
+    struct d_test_counter* _counter
+)
+{
+    printf("\n  [SECTION] Forced Rope Mode (all categories)\n");
+    printf("  --------------------------------------------\n");
+
+    return d_tests_sa_text_buffer_forced_run(D_TESTS_SA_TEXT_BUFFER_MODE_ROPE,
+                                             "forced_rope_applied",
+                                             _counter);
+}
+
+/*
+d_tests_sa_text_buffer_forced_gap_all
+  Aggregation function that reruns the mode-agnostic categories with every
+buffer in gap mode.
+*/
+bool
+d_tests_sa_text_buffer_forced_gap_all
+(
+    struct d_test_counter* _counter
+)
+{
+    printf("\n  [SECTION] Forced Gap Mode (all categories)\n");
+    printf("  -------------------------------------------\n");
+
+    return d_tests_sa_text_buffer_forced_run(D_TESTS_SA_TEXT_BUFFER_MODE_GAP,
+                                             "forced_gap_applied",
+                                             _counter);
+}
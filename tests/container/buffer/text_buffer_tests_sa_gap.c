@@ -0,0 +1,383 @@
+#include ".\text_buffer_tests_sa.h"
+
+
+/*
+d_tests_sa_text_buffer_enable_gap
+  Tests the d_text_buffer_enable_gap, d_text_buffer_disable_gap and
+d_text_buffer_is_gap functions.
+  Tests the following:
+  - NULL buffer is rejected
+  - enabling keeps the existing text
+  - gap and rope mode exclude each other
+  - disabling closes the gap
+*/
+bool
+d_tests_sa_text_buffer_enable_gap
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* buffer;
+
+    result = true;
+
+    // test 1: NULL
+    result = d_assert_standalone(
+        (!d_text_buffer_enable_gap(NULL)) &&
+        (!d_text_buffer_disable_gap(NULL)) &&
+        (!d_text_buffer_is_gap(NULL)),
+        "enable_gap_null",
+        "NULL buffer should be rejected",
+        _counter) && result;
+
+    buffer = d_text_buffer_new_from_string("Hello World");
+
+    if (buffer)
+    {
+        // test 2: enable
+        result = d_assert_standalone(
+            (!d_text_buffer_is_gap(buffer)) &&
+            (d_text_buffer_enable_gap(buffer)) &&
+            (d_text_buffer_is_gap(buffer)) &&
+            (strcmp(d_text_buffer_get_string(buffer), "Hello World") == 0),
+            "enable_gap_keeps_text",
+            "Enabling gap mode should keep the text",
+            _counter) && result;
+
+        // test 3: modes exclude each other
+        d_text_buffer_insert_char(buffer, 5, ',');
+
+        result = d_assert_standalone(
+            (d_text_buffer_enable_rope(buffer)) &&
+            (!d_text_buffer_is_gap(buffer)) &&
+            (d_text_buffer_enable_gap(buffer)) &&
+            (!d_text_buffer_is_rope(buffer)) &&
+            (d_text_buffer_equals_string(buffer, "Hello, World")),
+            "enable_gap_exclusive",
+            "Switching between rope and gap mode should keep the text",
+            _counter) && result;
+
+        // test 4: disable closes the gap
+        d_text_buffer_insert_string(buffer, 6, " big");
+
+        result = d_assert_standalone(
+            (buffer->flat_stale) &&
+            (d_text_buffer_disable_gap(buffer)) &&
+            (!d_text_buffer_is_gap(buffer)) &&
+            (!buffer->flat_stale) &&
+            (strcmp(buffer->data, "Hello, big World") == 0),
+            "disable_gap_closes",
+            "Disabling should close the gap into data",
+            _counter) && result;
+
+        d_text_buffer_free(buffer);
+    }
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_gap_edits
+  Tests the gap-mode paths of the insert, remove, replace_range, append,
+prepend, consume and character access functions.
+  Tests the following:
+  - successive inserts at a cursor extend the gap start
+  - backspace and delete at the cursor only move the gap edges
+  - get_char and set_char address text on both sides of the gap
+  - get_string and to_cstring close the gap lazily
+  - appends far from the cursor move the gap
+*/
+bool
+d_tests_sa_text_buffer_gap_edits
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* buffer;
+    char*                 copy;
+
+    result = true;
+    buffer = d_text_buffer_new_from_string("the fox");
+
+    if (!buffer)
+    {
+        return false;
+    }
+
+    d_text_buffer_enable_gap(buffer);
+
+    // test 1: typing at a cursor
+    d_text_buffer_insert_char(buffer, 4, 'q');
+    d_text_buffer_insert_string(buffer, 5, "uick");
+    d_text_buffer_insert_char(buffer, 9, ' ');
+
+    result = d_assert_standalone(
+        (buffer->flat_stale) &&
+        (buffer->gap_start == 10) &&
+        (d_text_buffer_length(buffer) == 13) &&
+        (d_text_buffer_get_char(buffer, 9) == ' ') &&
+        (d_text_buffer_get_char(buffer, 10) == 'f') &&
+        (d_text_buffer_get_char(buffer, -1) == 'x'),
+        "gap_edits_typing",
+        "Inserts at the cursor should grow the text before the gap",
+        _counter) && result;
+
+    // test 2: backspace and delete
+    d_text_buffer_remove_char(buffer, 9);
+    d_text_buffer_remove_char(buffer, 9);
+    d_text_buffer_insert_string(buffer, 9, " f");
+
+    result = d_assert_standalone(
+        (buffer->gap_start == 11) &&
+        (strcmp(d_text_buffer_get_string(buffer), "the quick fox") == 0) &&
+        (!buffer->flat_stale),
+        "gap_edits_delete",
+        "Backspace/delete around the cursor should edit in place",
+        _counter) && result;
+
+    // test 3: set_char on both sides of an open gap
+    d_text_buffer_insert_char(buffer, 4, '(');
+    d_text_buffer_set_char(buffer, 0, 'T');
+    d_text_buffer_set_char(buffer, -1, 'X');
+
+    copy = d_text_buffer_to_cstring(buffer);
+
+    result = d_assert_standalone(
+        (copy != NULL) &&
+        (strcmp(copy, "The (quick foX") == 0),
+        "gap_edits_set_char",
+        "set_char should write through the gap mapping",
+        _counter) && result;
+
+    free(copy);
+
+    // test 4: appends, prepends, ranges and consume
+    d_text_buffer_insert_char(buffer, 5, '[');
+    d_text_buffer_append_string(buffer, "!");
+    d_text_buffer_prepend_char(buffer, '>');
+    d_text_buffer_remove_range(buffer, 5, 7);
+    d_text_buffer_replace_range(buffer, -4, -1, "cat");
+    d_text_buffer_consume_front(buffer, 1);
+    d_text_buffer_consume_back(buffer, 1);
+
+    result = d_assert_standalone(
+        d_text_buffer_equals_string(buffer, "The quick cat"),
+        "gap_edits_mixed",
+        "Edits far from the cursor should move the gap correctly",
+        _counter) && result;
+
+    d_text_buffer_free(buffer);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_gap_interleaved
+  Tests that gap mode stays consistent when gap edits are interleaved with
+functions that work on `data` directly.
+  Tests the following:
+  - a data mutation (reverse) sees the text with the gap closed
+  - gap edits after a data mutation see the mutated text
+  - searches and resize_to_fit close an open gap first
+  - clear discards an open gap
+*/
+bool
+d_tests_sa_text_buffer_gap_interleaved
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* buffer;
+
+    result = true;
+    buffer = d_text_buffer_new_from_string("abc");
+
+    if (!buffer)
+    {
+        return false;
+    }
+
+    d_text_buffer_enable_gap(buffer);
+
+    // test 1: gap edit, data mutation, gap edit
+    d_text_buffer_insert_string(buffer, 1, "xy");
+    d_text_buffer_reverse(buffer);
+    d_text_buffer_insert_char(buffer, 2, '-');
+
+    result = d_assert_standalone(
+        d_text_buffer_equals_string(buffer, "cb-yxa"),
+        "gap_interleaved_mutation",
+        "Gap and data edits should see each other's results",
+        _counter) && result;
+
+    // test 2: searches and resize_to_fit
+    d_text_buffer_insert_char(buffer, 0, '<');
+
+    result = d_assert_standalone(
+        (d_text_buffer_find_char(buffer, 'x') == 5) &&
+        (d_text_buffer_starts_with(buffer, "<cb")) &&
+        (d_text_buffer_insert_char(buffer, 7, '>')) &&
+        (d_text_buffer_resize_to_fit(buffer)) &&
+        (d_text_buffer_equals_string(buffer, "<cb-yxa>")),
+        "gap_interleaved_search",
+        "Readers should close the gap first",
+        _counter) && result;
+
+    // test 3: clear
+    d_text_buffer_insert_char(buffer, 3, '.');
+    d_text_buffer_clear(buffer);
+    d_text_buffer_insert_string(buffer, 0, "new");
+
+    result = d_assert_standalone(
+        (d_text_buffer_is_gap(buffer)) &&
+        (d_text_buffer_equals_string(buffer, "new")),
+        "gap_interleaved_clear",
+        "Clear should discard an open gap",
+        _counter) && result;
+
+    d_text_buffer_free(buffer);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_gap_matches_flat
+  Applies the same pseudo-random cursor edits (a cursor that mostly steps
+locally, with occasional jumps) to a gap-mode buffer and a resize-mode
+buffer, comparing the texts at intervals.
+*/
+bool
+d_tests_sa_text_buffer_gap_matches_flat
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_text_buffer* gap;
+    struct d_text_buffer* flat;
+    char                  piece[24];
+    size_t                length;
+    size_t                cursor;
+    size_t                amount;
+    size_t                i;
+    uint64_t              state;
+    int                   round;
+    bool                  agree;
+
+    gap    = d_text_buffer_new(0);
+    flat   = d_text_buffer_new(0);
+    state  = 0x853C49E6748FEA9BULL;
+    cursor = 0;
+    agree  = (gap != NULL) && (flat != NULL) &&
+             (d_text_buffer_enable_gap(gap));
+
+    for (round = 0; (round < 8000) && agree; ++round)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        length = d_text_buffer_length(flat);
+
+        // mostly local cursor movement, sometimes a jump
+        if (state % 16 == 0)
+        {
+            cursor = (size_t)(state >> 20) % (length + 1);
+        }
+        else if ( ((state >> 4) % 3 == 0) &&
+                  (cursor > 0) )
+        {
+            --cursor;
+        }
+
+        if (cursor > length)
+        {
+            cursor = length;
+        }
+
+        amount = 1 + (size_t)(state >> 40) % (sizeof(piece) - 1);
+
+        for (i = 0; i < amount; ++i)
+        {
+            piece[i] = (char)('a' + (round + i) % 26);
+        }
+
+        piece[amount] = '\0';
+
+        switch ((state >> 8) % 4)
+        {
+            case 0:
+            case 1:
+                agree = (d_text_buffer_insert_string(gap, (d_index)cursor, piece)) &&
+                        (d_text_buffer_insert_string(flat, (d_index)cursor, piece));
+                cursor += amount;
+
+                break;
+
+            case 2:
+                if (cursor < length)
+                {
+                    agree = (d_text_buffer_remove_char(gap, (d_index)cursor)) &&
+                            (d_text_buffer_remove_char(flat, (d_index)cursor));
+                }
+
+                break;
+
+            default:
+                if (cursor > 0)
+                {
+                    --cursor;
+                    agree = (d_text_buffer_remove_char(gap, (d_index)cursor)) &&
+                            (d_text_buffer_remove_char(flat, (d_index)cursor));
+                }
+
+                break;
+        }
+
+        agree = agree &&
+                (d_text_buffer_length(gap) == d_text_buffer_length(flat));
+
+        if (round % 101 == 0)
+        {
+            agree = agree && (d_text_buffer_compare(gap, flat) == 0);
+        }
+    }
+
+    agree = agree && (d_text_buffer_compare(gap, flat) == 0);
+
+    d_text_buffer_free(gap);
+    d_text_buffer_free(flat);
+
+    return d_assert_standalone(
+        agree,
+        "gap_matches_flat",
+        "Gap-mode buffer should match a resize-mode buffer",
+        _counter);
+}
+
+/*
+d_tests_sa_text_buffer_gap_all
+  Aggregation function that runs all gap mode tests.
+*/
+bool
+d_tests_sa_text_buffer_gap_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Gap Mode Functions\n");
+    printf("  -----------------------------\n");
+
+    result = d_tests_sa_text_buffer_enable_gap(_counter) && result;
+    result = d_tests_sa_text_buffer_gap_edits(_counter) && result;
+    result = d_tests_sa_text_buffer_gap_interleaved(_counter) && result;
+    result = d_tests_sa_text_buffer_gap_matches_flat(_counter) && result;
+
+    return result;
+}
@@ -384,6 +384,151 @@ d_tests_sa_text_buffer_replace_string
     return result;
 }
 
+/*
+d_tests_sa_text_buffer_replace_many
+  Tests the d_text_buffer_replace_many function.
+  Tests the following:
+  - NULL buffer, matcher or replacements returns false
+  - every pattern is replaced in a single call
+  - longer and shorter replacements, and NULL (removal), size the output
+  - replacement text is not rescanned
+  - overflow chunks are replaced and folded into the primary store
+  - no match leaves the buffer unchanged
+  - many matches are all replaced
+*/
+bool
+d_tests_sa_text_buffer_replace_many
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_text_buffer*  buffer;
+    struct d_text_matcher* matcher;
+    static const char*     patterns[]     = { "hunter2", "s3cr3t", "token=" };
+    static const char*     replacements[] = { "*******", "[x]", NULL };
+    size_t                 i;
+    bool                   many_ok;
+
+    result  = true;
+    matcher = d_text_matcher_new(patterns, 3);
+
+    // test 1: NULL arguments
+    result = d_assert_standalone(
+        d_text_buffer_replace_many(NULL, matcher, replacements) == false,
+        "replace_many_null",
+        "NULL buffer should return false",
+        _counter) && result;
+
+    buffer = d_text_buffer_new_from_string("pw=hunter2 key=s3cr3t token=abc");
+
+    if ( (buffer) &&
+         (matcher) )
+    {
+        result = d_assert_standalone(
+            (d_text_buffer_replace_many(buffer, NULL, replacements) == false) &&
+            (d_text_buffer_replace_many(buffer, matcher, NULL) == false),
+            "replace_many_null_args",
+            "NULL matcher or replacements should return false",
+            _counter) && result;
+
+        // test 2: all patterns in one pass
+        result = d_assert_standalone(
+            d_text_buffer_replace_many(buffer, matcher, replacements) == true,
+            "replace_many_all",
+            "Replace many should succeed",
+            _counter) && result;
+
+        result = d_assert_standalone(
+            (buffer->count == 22) &&
+            (strcmp(buffer->data, "pw=******* key=[x] abc") == 0),
+            "replace_many_all_content",
+            "Content should be 'pw=******* key=[x] abc'",
+            _counter) && result;
+
+        // test 3: replacements are not rescanned
+        d_text_buffer_free(buffer);
+        buffer = d_text_buffer_new_from_string("s3cr3t");
+
+        if (buffer)
+        {
+            static const char* echo[] = { "s3cr3t", "s3cr3ts3cr3t", "" };
+
+            d_text_buffer_replace_many(buffer, matcher, echo);
+
+            result = d_assert_standalone(
+                strcmp(buffer->data, "s3cr3ts3cr3t") == 0,
+                "replace_many_no_rescan",
+                "Replacement text should not be replaced again",
+                _counter) && result;
+        }
+
+        // test 4: chunks
+        d_text_buffer_free(buffer);
+        buffer = d_text_buffer_new_from_string("a=hun");
+
+        if (buffer)
+        {
+            d_text_buffer_append_string_chunked(buffer, "ter2 b=", 0);
+            d_text_buffer_append_string_chunked(buffer, "s3cr3t!", 0);
+            d_text_buffer_replace_many(buffer, matcher, replacements);
+
+            result = d_assert_standalone(
+                (!d_text_buffer_has_chunks(buffer)) &&
+                (strcmp(buffer->data, "a=******* b=[x]!") == 0),
+                "replace_many_chunked",
+                "Chunked matches should be replaced and consolidated",
+                _counter) && result;
+        }
+
+        // test 5: no match
+        d_text_buffer_free(buffer);
+        buffer = d_text_buffer_new_from_string("nothing here");
+
+        if (buffer)
+        {
+            result = d_assert_standalone(
+                (d_text_buffer_replace_many(buffer, matcher, replacements)) &&
+                (strcmp(buffer->data, "nothing here") == 0),
+                "replace_many_no_match",
+                "Buffer without matches should be unchanged",
+                _counter) && result;
+        }
+
+        // test 6: more matches than the on-stack match log holds
+        d_text_buffer_free(buffer);
+        buffer = d_text_buffer_new_default_capacity();
+
+        if (buffer)
+        {
+            for (i = 0; i < 100; ++i)
+            {
+                d_text_buffer_append_string(buffer, "s3cr3t,");
+            }
+
+            d_text_buffer_replace_many(buffer, matcher, replacements);
+
+            many_ok = (buffer->count == 400);
+
+            for (i = 0; (i < 100) && many_ok; ++i)
+            {
+                many_ok = (memcmp(buffer->data + (i * 4), "[x],", 4) == 0);
+            }
+
+            result = d_assert_standalone(
+                many_ok,
+                "replace_many_large",
+                "All 100 matches should be replaced",
+                _counter) && result;
+        }
+    }
+
+    d_text_buffer_free(buffer);
+    d_text_matcher_free(matcher);
+
+    return result;
+}
+
 /*
 d_tests_sa_text_buffer_replace_range
   Tests the d_text_buffer_replace_range function.
@@ -772,6 +917,7 @@ d_tests_sa_text_buffer_modification_all
     result = d_tests_sa_text_buffer_set_formatted(_counter) && result;
     result = d_tests_sa_text_buffer_replace_char(_counter) && result;
     result = d_tests_sa_text_buffer_replace_string(_counter) && result;
+    result = d_tests_sa_text_buffer_replace_many(_counter) && result;
     result = d_tests_sa_text_buffer_replace_range(_counter) && result;
     result = d_tests_sa_text_buffer_remove_char(_counter) && result;
     result = d_tests_sa_text_buffer_remove_range(_counter) && result;
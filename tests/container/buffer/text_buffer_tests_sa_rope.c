@@ -0,0 +1,460 @@
+#include ".\text_buffer_tests_sa.h"
+
+
+/*
+d_tests_sa_text_buffer_enable_rope
+  Tests the d_text_buffer_enable_rope, d_text_buffer_disable_rope and
+d_text_buffer_is_rope functions.
+  Tests the following:
+  - NULL buffer is rejected
+  - enabling keeps the existing text, and enabling twice is harmless
+  - disabling flattens pending rope edits into `data`
+  - disabling a non-rope buffer succeeds
+*/
+bool
+d_tests_sa_text_buffer_enable_rope
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* buffer;
+
+    result = true;
+
+    // test 1: NULL
+    result = d_assert_standalone(
+        (!d_text_buffer_enable_rope(NULL)) &&
+        (!d_text_buffer_disable_rope(NULL)) &&
+        (!d_text_buffer_is_rope(NULL)),
+        "enable_rope_null",
+        "NULL buffer should be rejected",
+        _counter) && result;
+
+    buffer = d_text_buffer_new_from_string("Hello World");
+
+    if (buffer)
+    {
+        // test 2: enable
+        result = d_assert_standalone(
+            (!d_text_buffer_is_rope(buffer)) &&
+            (d_text_buffer_enable_rope(buffer)) &&
+            (d_text_buffer_enable_rope(buffer)) &&
+            (d_text_buffer_is_rope(buffer)) &&
+            (strcmp(d_text_buffer_get_string(buffer), "Hello World") == 0),
+            "enable_rope_keeps_text",
+            "Enabling rope mode should keep the text",
+            _counter) && result;
+
+        // test 3: disable flattens
+        d_text_buffer_insert_string(buffer, 5, ",");
+
+        result = d_assert_standalone(
+            (d_text_buffer_disable_rope(buffer)) &&
+            (!d_text_buffer_is_rope(buffer)) &&
+            (buffer->count == 12) &&
+            (strcmp(buffer->data, "Hello, World") == 0),
+            "disable_rope_flattens",
+            "Disabling should leave the edited text in data",
+            _counter) && result;
+
+        // test 4: disable again
+        result = d_assert_standalone(
+            d_text_buffer_disable_rope(buffer),
+            "disable_rope_plain",
+            "Disabling a non-rope buffer should succeed",
+            _counter) && result;
+
+        d_text_buffer_free(buffer);
+    }
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_rope_edits
+  Tests the rope-mode paths of the insert, remove, replace_range, append,
+prepend, consume and character access functions.
+  Tests the following:
+  - length is exact while `data` is stale
+  - get_char and set_char work without flattening
+  - get_string and to_cstring flatten lazily
+  - negative indices behave as in resize mode
+  - consume_front / consume_back clamp to the length
+*/
+bool
+d_tests_sa_text_buffer_rope_edits
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* buffer;
+    char*                 copy;
+
+    result = true;
+    buffer = d_text_buffer_new_from_string("brown fox");
+
+    if (!buffer)
+    {
+        return false;
+    }
+
+    d_text_buffer_enable_rope(buffer);
+
+    // test 1: inserts, appends and prepends
+    d_text_buffer_insert_string(buffer, 0, "quick ");
+    d_text_buffer_prepend_string(buffer, "the ");
+    d_text_buffer_append_string(buffer, " jumps");
+    d_text_buffer_insert_char(buffer, -6, '!');
+    d_text_buffer_append_chars(buffer, '.', 3);
+
+    result = d_assert_standalone(
+        (buffer->flat_stale) &&
+        (d_text_buffer_length(buffer) == 29) &&
+        (d_text_buffer_get_char(buffer, 4) == 'q') &&
+        (d_text_buffer_get_char(buffer, -1) == '.'),
+        "rope_edits_lazy",
+        "Edits should update the length without flattening",
+        _counter) && result;
+
+    // test 2: get_string flattens
+    result = d_assert_standalone(
+        (strcmp(d_text_buffer_get_string(buffer),
+                "the quick brown fox! jumps...") == 0) &&
+        (!buffer->flat_stale),
+        "rope_edits_get_string",
+        "get_string should return the flattened text",
+        _counter) && result;
+
+    // test 3: removes and replace_range
+    d_text_buffer_remove_range(buffer, 4, 10);
+    d_text_buffer_remove_char(buffer, -1);
+    d_text_buffer_replace_range(buffer, 0, 3, "A");
+    d_text_buffer_set_char(buffer, 2, 'B');
+
+    copy = d_text_buffer_to_cstring(buffer);
+
+    result = d_assert_standalone(
+        (copy != NULL) &&
+        (strcmp(copy, "A Brown fox! jumps..") == 0),
+        "rope_edits_remove_replace",
+        "Removes and replacements should apply in order",
+        _counter) && result;
+
+    free(copy);
+
+    // test 4: consume
+    d_text_buffer_consume_front(buffer, 2);
+    d_text_buffer_consume_back(buffer, 2);
+
+    result = d_assert_standalone(
+        (d_text_buffer_equals_string(buffer, "Brown fox! jumps")) &&
+        (d_text_buffer_consume_back(buffer, 100)) &&
+        (d_text_buffer_is_empty(buffer)),
+        "rope_edits_consume",
+        "Consume should trim both ends and clamp",
+        _counter) && result;
+
+    d_text_buffer_free(buffer);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_rope_interleaved
+  Tests that rope mode stays consistent when rope edits are interleaved
+with functions that work on `data` directly.
+  Tests the following:
+  - a data mutation (to_upper) after rope edits sees the edited text
+  - rope edits after a data mutation see the mutated text
+  - text appended in chunks stays in its chunks across rope edits
+  - clear resets a rope-mode buffer
+*/
+bool
+d_tests_sa_text_buffer_rope_interleaved
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* buffer;
+
+    result = true;
+    buffer = d_text_buffer_new_from_string("abc");
+
+    if (!buffer)
+    {
+        return false;
+    }
+
+    d_text_buffer_enable_rope(buffer);
+
+    // test 1: rope edit, then data mutation, then rope edit
+    d_text_buffer_insert_string(buffer, 1, "xy");
+    d_text_buffer_to_upper(buffer);
+    d_text_buffer_insert_string(buffer, 0, "<");
+    d_text_buffer_append_string(buffer, ">");
+
+    result = d_assert_standalone(
+        d_text_buffer_equals_string(buffer, "<AXYBC>"),
+        "rope_interleaved_mutation",
+        "Rope and data edits should see each other's results",
+        _counter) && result;
+
+    // test 2: chunked append then rope edit
+    d_text_buffer_append_string_chunked(buffer, "tail", 16);
+    d_text_buffer_insert_char(buffer, 0, '^');
+
+    result = d_assert_standalone(
+        (d_text_buffer_has_chunks(buffer)) &&
+        (d_text_buffer_total_length(buffer) == 12) &&
+        (d_text_buffer_consolidate(buffer)) &&
+        (d_text_buffer_equals_string(buffer, "^<AXYBC>tail")),
+        "rope_interleaved_chunks",
+        "Rope edits should leave overflow chunks in place",
+        _counter) && result;
+
+    // test 3: searches see pending edits
+    d_text_buffer_remove_range(buffer, 1, 2);
+
+    result = d_assert_standalone(
+        (d_text_buffer_find_string(buffer, "BC>") == 4) &&
+        (d_text_buffer_count_char(buffer, 'A') == 1),
+        "rope_interleaved_search",
+        "Searches should flatten pending edits first",
+        _counter) && result;
+
+    // test 4: clear
+    d_text_buffer_clear(buffer);
+    d_text_buffer_append_string(buffer, "new");
+
+    result = d_assert_standalone(
+        (d_text_buffer_is_rope(buffer)) &&
+        (d_text_buffer_equals_string(buffer, "new")),
+        "rope_interleaved_clear",
+        "Clear should reset a rope-mode buffer",
+        _counter) && result;
+
+    d_text_buffer_free(buffer);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_rope_matches_flat
+  Applies the same pseudo-random inserts, removes and range replacements
+to a rope-mode buffer and a resize-mode buffer, comparing the texts at
+intervals so both stale and freshly flattened states are exercised.
+*/
+bool
+d_tests_sa_text_buffer_rope_matches_flat
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_text_buffer* rope;
+    struct d_text_buffer* flat;
+    char                  piece[40];
+    size_t                length;
+    size_t                position;
+    size_t                amount;
+    size_t                i;
+    uint64_t              state;
+    int                   round;
+    bool                  agree;
+
+    rope  = d_text_buffer_new_default_capacity();
+    flat  = d_text_buffer_new_default_capacity();
+    state = 0xD1B54A32D192ED03ULL;
+    agree = (rope != NULL) && (flat != NULL) &&
+            (d_text_buffer_enable_rope(rope));
+
+    for (round = 0; (round < 5000) && agree; ++round)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        length   = d_text_buffer_length(flat);
+        position = (size_t)(state >> 20) % (length + 1);
+        amount   = 1 + (size_t)(state >> 40) % (sizeof(piece) - 1);
+
+        for (i = 0; i < amount; ++i)
+        {
+            piece[i] = (char)('a' + (round + i) % 26);
+        }
+
+        piece[amount] = '\0';
+
+        if ( (state % 3 != 0) ||
+             (length == 0) )
+        {
+            agree = (d_text_buffer_insert_string(rope, (d_index)position, piece)) &&
+                    (d_text_buffer_insert_string(flat, (d_index)position, piece));
+        }
+        else
+        {
+            amount = (position + amount > length) ? (length - position) : amount;
+
+            agree = (d_text_buffer_replace_range(rope,
+                                                 (d_index)position,
+                                                 (d_index)(position + amount),
+                                                 piece + amount / 2)) &&
+                    (d_text_buffer_replace_range(flat,
+                                                 (d_index)position,
+                                                 (d_index)(position + amount),
+                                                 piece + amount / 2));
+        }
+
+        agree = agree &&
+                (d_text_buffer_length(rope) == d_text_buffer_length(flat));
+
+        if (round % 97 == 0)
+        {
+            agree = agree && (d_text_buffer_compare(rope, flat) == 0);
+        }
+    }
+
+    agree = agree && (d_text_buffer_compare(rope, flat) == 0);
+
+    d_text_buffer_free(rope);
+    d_text_buffer_free(flat);
+
+    return d_assert_standalone(
+        agree,
+        "rope_matches_flat",
+        "Rope-mode buffer should match a resize-mode buffer",
+        _counter);
+}
+
+/*
+d_tests_sa_text_buffer_rope_agrees
+  Returns true if two buffers hold the same text as seen by the readers
+that span overflow chunks: lengths, a search and the hash.
+*/
+static bool
+d_tests_sa_text_buffer_rope_agrees
+(
+    struct d_text_buffer* _rope,
+    struct d_text_buffer* _flat
+)
+{
+    return (d_text_buffer_length(_rope) == d_text_buffer_length(_flat))         &&
+           (d_text_buffer_total_length(_rope) ==
+                d_text_buffer_total_length(_flat))                              &&
+           (d_text_buffer_find_string(_rope, "CHUNK") ==
+                d_text_buffer_find_string(_flat, "CHUNK"))                      &&
+           (d_text_buffer_find_string(_rope, "tail") ==
+                d_text_buffer_find_string(_flat, "tail"))                       &&
+           (d_text_buffer_hash(_rope) == d_text_buffer_hash(_flat));
+}
+
+/*
+d_tests_sa_text_buffer_rope_chunks
+  Tests that rope mode leaves overflow chunks alone, so a rope-mode buffer
+with chunked appends behaves exactly like a resize-mode one.
+  Tests the following:
+  - appends, inserts and removes after a chunked append
+  - edits at positions past the primary store fail in both modes
+  - reverse and consolidate give the same text
+*/
+bool
+d_tests_sa_text_buffer_rope_chunks
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_text_buffer* rope;
+    struct d_text_buffer* flat;
+    bool                  result;
+    bool                  agree;
+    size_t                past;
+
+    result = true;
+
+    rope  = d_text_buffer_new_from_string("hello world");
+    flat  = d_text_buffer_new_from_string("hello world");
+    agree = (rope != NULL) && (flat != NULL) &&
+            (d_text_buffer_enable_rope(rope));
+
+    // chunked appends, then plain edits on top of them
+    agree = agree &&
+            (d_text_buffer_append_string_chunked(rope, "CHUNK-one", 4)) &&
+            (d_text_buffer_append_string_chunked(flat, "CHUNK-one", 4)) &&
+            (d_text_buffer_insert_string(rope, 5, ",")) &&
+            (d_text_buffer_insert_string(flat, 5, ",")) &&
+            (d_text_buffer_append_string(rope, " tail")) &&
+            (d_text_buffer_append_string(flat, " tail")) &&
+            (d_tests_sa_text_buffer_rope_agrees(rope, flat));
+
+    result = d_assert_standalone(
+        agree && d_text_buffer_has_chunks(rope),
+        "rope_chunks_append",
+        "Appends after a chunked append should land where resize mode puts them",
+        _counter) && result;
+
+    // removes and an insert into the chunk region
+    past  = (agree) ? d_text_buffer_length(flat) + 2 : 0;
+    agree = agree &&
+            (d_text_buffer_remove_range(rope, 0, 2)) &&
+            (d_text_buffer_remove_range(flat, 0, 2)) &&
+            (d_text_buffer_insert_char(rope, (d_index)past, '!') ==
+                 d_text_buffer_insert_char(flat, (d_index)past, '!')) &&
+            (d_tests_sa_text_buffer_rope_agrees(rope, flat));
+
+    result = d_assert_standalone(
+        agree && d_text_buffer_has_chunks(rope),
+        "rope_chunks_edits",
+        "Edits around the chunk region should match resize mode",
+        _counter) && result;
+
+    // reverse, then fold the chunks in
+    agree = agree &&
+            (d_text_buffer_reverse(rope)) &&
+            (d_text_buffer_reverse(flat)) &&
+            (d_tests_sa_text_buffer_rope_agrees(rope, flat)) &&
+            (d_text_buffer_consolidate(rope)) &&
+            (d_text_buffer_consolidate(flat)) &&
+            (d_text_buffer_insert_string(rope, 3, "mid")) &&
+            (d_text_buffer_insert_string(flat, 3, "mid")) &&
+            (d_text_buffer_equals(rope, flat)) &&
+            (d_tests_sa_text_buffer_rope_agrees(rope, flat));
+
+    result = d_assert_standalone(
+        agree,
+        "rope_chunks_consolidate",
+        "Reverse and consolidate should match resize mode",
+        _counter) && result;
+
+    d_text_buffer_free(rope);
+    d_text_buffer_free(flat);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_rope_all
+  Aggregation function that runs all rope mode tests.
+*/
+bool
+d_tests_sa_text_buffer_rope_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Rope Mode Functions\n");
+    printf("  ------------------------------\n");
+
+    result = d_tests_sa_text_buffer_enable_rope(_counter) && result;
+    result = d_tests_sa_text_buffer_rope_edits(_counter) && result;
+    result = d_tests_sa_text_buffer_rope_interleaved(_counter) && result;
+    result = d_tests_sa_text_buffer_rope_matches_flat(_counter) && result;
+    result = d_tests_sa_text_buffer_rope_chunks(_counter) && result;
+
+    return result;
+}
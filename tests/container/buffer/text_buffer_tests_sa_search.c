@@ -688,6 +688,490 @@ d_tests_sa_text_buffer_count_string
     return result;
 }
 
+/*
+d_tests_sa_text_buffer_search_embedded_nul
+  Tests that string searches respect the buffer's length rather than
+stopping at an embedded NUL.
+  Tests the following:
+  - find_string finds text after a NUL
+  - find_last_string finds the last match after a NUL
+  - count_string counts matches on both sides of a NUL
+  - replace_string replaces matches after a NUL
+*/
+bool
+d_tests_sa_text_buffer_search_embedded_nul
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* buffer;
+
+    result = true;
+    buffer = d_text_buffer_new_from_buffer("key=1\0key=2\0key=3", 17);
+
+    if (buffer)
+    {
+        // test 1: find after the first NUL
+        result = d_assert_standalone(
+            d_text_buffer_find_string_from(buffer, "key", 1) == 6,
+            "search_nul_find",
+            "'key' from 1 should be found at 6",
+            _counter) && result;
+
+        // test 2: find last
+        result = d_assert_standalone(
+            d_text_buffer_find_last_string(buffer, "key=") == 12,
+            "search_nul_find_last",
+            "Last 'key=' should be at 12",
+            _counter) && result;
+
+        // test 3: count
+        result = d_assert_standalone(
+            d_text_buffer_count_string(buffer, "key") == 3,
+            "search_nul_count",
+            "'key' should be counted 3 times",
+            _counter) && result;
+
+        // test 4: replace
+        d_text_buffer_replace_string(buffer, "key", "k");
+
+        result = d_assert_standalone(
+            (buffer->count == 11) &&
+            (memcmp(buffer->data, "k=1\0k=2\0k=3", 11) == 0),
+            "search_nul_replace",
+            "Every 'key' should be replaced",
+            _counter) && result;
+
+        d_text_buffer_free(buffer);
+    }
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_search_chunked
+  Tests that searches cover append-mode overflow chunks.
+  Tests the following:
+  - find_string finds a match that straddles the primary store and a chunk
+  - find_char and find_last_char see chunk contents
+  - count_string counts matches inside and across chunks
+  - find_last_string returns the last match in the last chunk
+*/
+bool
+d_tests_sa_text_buffer_search_chunked
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* buffer;
+
+    result = true;
+    buffer = d_text_buffer_new_from_string("error: disk fu");
+
+    if (buffer)
+    {
+        d_text_buffer_append_string_chunked(buffer, "ll; err", 0);
+        d_text_buffer_append_string_chunked(buffer, "or: disk full", 0);
+
+        // test 1: straddling primary and first chunk
+        result = d_assert_standalone(
+            d_text_buffer_find_string(buffer, "full") == 12,
+            "search_chunked_straddle",
+            "'full' should be found at 12",
+            _counter) && result;
+
+        // test 2: characters inside chunks
+        result = d_assert_standalone(
+            (d_text_buffer_find_char(buffer, ';') == 16) &&
+            (d_text_buffer_find_last_char(buffer, 'k') == 28),
+            "search_chunked_char",
+            "';' should be at 16 and the last 'k' at 28",
+            _counter) && result;
+
+        // test 3: count across chunks
+        result = d_assert_standalone(
+            d_text_buffer_count_string(buffer, "error") == 2,
+            "search_chunked_count",
+            "'error' should be counted twice",
+            _counter) && result;
+
+        // test 4: last match
+        result = d_assert_standalone(
+            d_text_buffer_find_last_string(buffer, "disk") == 25,
+            "search_chunked_find_last",
+            "Last 'disk' should be at 25",
+            _counter) && result;
+
+        d_text_buffer_free(buffer);
+    }
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_search_chunk_straddle
+  Tests string searches on needles split across the primary store and an
+overflow chunk at every split point, for a short needle, a needle of
+exactly the SIMD filter's maximum length and a long (Horspool) needle.
+  Tests the following:
+  - find_string finds the straddling match
+  - find_last_string prefers a later match inside the chunk
+  - count_string counts both matches
+  - find_string_from past the straddling match finds the chunk copy
+*/
+bool
+d_tests_sa_text_buffer_search_chunk_straddle
+(
+    struct d_test_counter* _counter
+)
+{
+    static const char* needles[3] =
+    {
+        "disk",
+        "0123456789abcdefghijklmnopqrstuv",
+        "the quick brown fox jumps over the lazy dog, twice"
+    };
+
+    struct d_text_buffer* buffer;
+    char                  tail[128];
+    const char*           needle;
+    size_t                length;
+    size_t                split;
+    size_t                n;
+    bool                  find_ok;
+    bool                  last_ok;
+    bool                  count_ok;
+    bool                  from_ok;
+    bool                  result;
+
+    result   = true;
+    find_ok  = true;
+    last_ok  = true;
+    count_ok = true;
+    from_ok  = true;
+
+    for (n = 0; n < 3; ++n)
+    {
+        needle = needles[n];
+        length = strlen(needle);
+
+        for (split = 1; split < length; ++split)
+        {
+            // "<<" + needle[0, split) | needle[split, length) + ">>" + needle
+            buffer = d_text_buffer_new_from_string("<<");
+
+            if (!buffer)
+            {
+                return false;
+            }
+
+            d_text_buffer_append_string_n(buffer, needle, split);
+
+            memcpy(tail, needle + split, length - split);
+            memcpy(tail + length - split, ">>", 2);
+            memcpy(tail + length - split + 2, needle, length);
+
+            d_text_buffer_append_buffer_chunked(buffer,
+                                                tail,
+                                                2 * length - split + 2,
+                                                0);
+
+            find_ok  = find_ok &&
+                       (d_text_buffer_find_string(buffer, needle) == 2);
+            last_ok  = last_ok &&
+                       (d_text_buffer_find_last_string(buffer, needle) ==
+                            (ssize_t)(length + 4));
+            count_ok = count_ok &&
+                       (d_text_buffer_count_string(buffer, needle) == 2);
+            from_ok  = from_ok &&
+                       (d_text_buffer_find_string_from(buffer, needle, 3) ==
+                            (ssize_t)(length + 4));
+
+            d_text_buffer_free(buffer);
+        }
+    }
+
+    result = d_assert_standalone(
+        find_ok,
+        "search_straddle_find",
+        "Needles split at every point should be found at 2",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        last_ok,
+        "search_straddle_find_last",
+        "Last match should be the copy inside the chunk",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        count_ok,
+        "search_straddle_count",
+        "Straddling and chunk matches should both be counted",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        from_ok,
+        "search_straddle_find_from",
+        "Searching past the straddling match should find the chunk copy",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_find_any
+  Tests the d_text_buffer_find_any function.
+  Tests the following:
+  - NULL buffer or matcher returns -1
+  - the earliest match of any pattern is reported with its pattern index
+  - at the same position, the longest pattern wins
+  - a match straddling the primary store and a chunk is found
+  - no match returns -1
+*/
+bool
+d_tests_sa_text_buffer_find_any
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_text_buffer*  buffer;
+    struct d_text_matcher* matcher;
+    size_t                 pattern;
+    static const char*     patterns[] = { "token", "password", "pass" };
+
+    result  = true;
+    matcher = d_text_matcher_new(patterns, 3);
+
+    // test 1: NULL arguments
+    result = d_assert_standalone(
+        (d_text_buffer_find_any(NULL, matcher, NULL) == -1),
+        "find_any_null",
+        "NULL buffer should return -1",
+        _counter) && result;
+
+    buffer = d_text_buffer_new_from_string("user=bob password=hunter2 token=x");
+
+    if ( (buffer) &&
+         (matcher) )
+    {
+        result = d_assert_standalone(
+            d_text_buffer_find_any(buffer, NULL, NULL) == -1,
+            "find_any_null_matcher",
+            "NULL matcher should return -1",
+            _counter) && result;
+
+        // test 2: earliest, longest match
+        pattern = 99;
+
+        result = d_assert_standalone(
+            (d_text_buffer_find_any(buffer, matcher, &pattern) == 9) &&
+            (pattern == 1),
+            "find_any_longest",
+            "'password' (pattern 1) should be found at 9",
+            _counter) && result;
+
+        // test 3: straddling a chunk boundary
+        d_text_buffer_set_string(buffer, "api_to");
+        d_text_buffer_append_string_chunked(buffer, "ken=1", 0);
+
+        result = d_assert_standalone(
+            (d_text_buffer_find_any(buffer, matcher, &pattern) == 4) &&
+            (pattern == 0),
+            "find_any_chunked",
+            "'token' should be found at 4 across the chunk",
+            _counter) && result;
+
+        // test 4: no match
+        d_text_buffer_free(buffer);
+        buffer = d_text_buffer_new_from_string("nothing to see");
+
+        result = d_assert_standalone(
+            (buffer) &&
+            (d_text_buffer_find_any(buffer, matcher, NULL) == -1),
+            "find_any_none",
+            "No pattern present should return -1",
+            _counter) && result;
+    }
+
+    d_text_buffer_free(buffer);
+    d_text_matcher_free(matcher);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_count_each
+  Tests the d_text_buffer_count_each function.
+  Tests the following:
+  - NULL buffer returns 0
+  - per-pattern counts and the total are reported
+  - overlapping candidates are resolved leftmost-longest
+  - counts include overflow chunks
+*/
+bool
+d_tests_sa_text_buffer_count_each
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_text_buffer*  buffer;
+    struct d_text_matcher* matcher;
+    size_t                 counts[3];
+    static const char*     patterns[] = { "he", "she", "hers" };
+
+    result  = true;
+    matcher = d_text_matcher_new(patterns, 3);
+
+    // test 1: NULL buffer
+    result = d_assert_standalone(
+        d_text_buffer_count_each(NULL, matcher, counts) == 0,
+        "count_each_null",
+        "NULL buffer should count 0",
+        _counter) && result;
+
+    buffer = d_text_buffer_new_from_string("ushers he she");
+
+    if ( (buffer) &&
+         (matcher) )
+    {
+        // test 2: "ushers" -> "she" at 1 wins over "hers" at 2
+        result = d_assert_standalone(
+            (d_text_buffer_count_each(buffer, matcher, counts) == 3) &&
+            (counts[0] == 1) &&
+            (counts[1] == 2) &&
+            (counts[2] == 0),
+            "count_each_counts",
+            "Counts should be he=1, she=2, hers=0",
+            _counter) && result;
+
+        // test 3: chunks are counted
+        d_text_buffer_append_string_chunked(buffer, " h", 0);
+        d_text_buffer_append_string_chunked(buffer, "ers", 0);
+
+        result = d_assert_standalone(
+            (d_text_buffer_count_each(buffer, matcher, counts) == 4) &&
+            (counts[2] == 1),
+            "count_each_chunked",
+            "'hers' split across chunks should be counted",
+            _counter) && result;
+    }
+
+    d_text_buffer_free(buffer);
+    d_text_matcher_free(matcher);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_matcher_chunk_prefix
+  Tests find_any and count_each with a pattern that is a prefix of another
+("pass" / "password"), with the longer pattern split across the primary
+store and an overflow chunk at every split point.
+  Tests the following:
+  - the straddling longer pattern beats its prefix
+  - a longer candidate that fails inside the chunk falls back to the prefix
+*/
+bool
+d_tests_sa_text_buffer_matcher_chunk_prefix
+(
+    struct d_test_counter* _counter
+)
+{
+    static const char*     patterns[] = { "pass", "password" };
+    static const char      word[]     = "password";
+
+    struct d_text_buffer*  buffer;
+    struct d_text_matcher* matcher;
+    size_t                 counts[2];
+    size_t                 pattern;
+    size_t                 split;
+    bool                   longest_ok;
+    bool                   fallback_ok;
+    bool                   result;
+
+    result      = true;
+    matcher     = d_text_matcher_new(patterns, 2);
+    longest_ok  = (matcher != NULL);
+    fallback_ok = (matcher != NULL);
+
+    for (split = 1; (matcher) && (split < sizeof(word) - 1); ++split)
+    {
+        // "x" + word[0, split) | word[split, 8) + " pass"
+        buffer = d_text_buffer_new_from_string("x");
+
+        if (!buffer)
+        {
+            d_text_matcher_free(matcher);
+
+            return false;
+        }
+
+        d_text_buffer_append_string_n(buffer, word, split);
+        d_text_buffer_append_buffer_chunked(buffer,
+                                            word + split,
+                                            sizeof(word) - 1 - split,
+                                            0);
+        d_text_buffer_append_string_chunked(buffer, " pass", 0);
+
+        pattern    = 99;
+        longest_ok = longest_ok &&
+                     (d_text_buffer_find_any(buffer, matcher, &pattern) == 1) &&
+                     (pattern == 1) &&
+                     (d_text_buffer_count_each(buffer, matcher, counts) == 2) &&
+                     (counts[0] == 1) &&
+                     (counts[1] == 1);
+
+        d_text_buffer_free(buffer);
+
+        // "x" + word[0, split) | "X" (the longer candidate dies in the chunk)
+        buffer = d_text_buffer_new_from_string("x");
+
+        if (!buffer)
+        {
+            d_text_matcher_free(matcher);
+
+            return false;
+        }
+
+        d_text_buffer_append_string_n(buffer, word, split);
+        d_text_buffer_append_string_chunked(buffer, "X", 0);
+
+        pattern     = 99;
+        fallback_ok = fallback_ok &&
+                      (d_text_buffer_count_each(buffer, matcher, counts) ==
+                           ((split >= 4) ? 1u : 0u)) &&
+                      (counts[1] == 0) &&
+                      ( (split < 4)
+                        ? (d_text_buffer_find_any(buffer, matcher, NULL) == -1)
+                        : ( (d_text_buffer_find_any(buffer,
+                                                    matcher,
+                                                    &pattern) == 1) &&
+                            (pattern == 0) ) );
+
+        d_text_buffer_free(buffer);
+    }
+
+    d_text_matcher_free(matcher);
+
+    result = d_assert_standalone(
+        longest_ok,
+        "matcher_chunk_prefix_longest",
+        "'password' split over a chunk should beat 'pass'",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        fallback_ok,
+        "matcher_chunk_prefix_fallback",
+        "A 'password' cut short in the chunk should fall back to 'pass'",
+        _counter) && result;
+
+    return result;
+}
+
 /*
 d_tests_sa_text_buffer_search_all
   Aggregation function that runs all search operation tests.
@@ -719,6 +1203,15 @@ d_tests_sa_text_buffer_search_all
     result = d_tests_sa_text_buffer_ends_with(_counter) && result;
     result = d_tests_sa_text_buffer_count_char(_counter) && result;
     result = d_tests_sa_text_buffer_count_string(_counter) && result;
+    result = d_tests_sa_text_buffer_search_embedded_nul(_counter)
+             && result;
+    result = d_tests_sa_text_buffer_search_chunked(_counter) && result;
+    result = d_tests_sa_text_buffer_search_chunk_straddle(_counter)
+             && result;
+    result = d_tests_sa_text_buffer_find_any(_counter) && result;
+    result = d_tests_sa_text_buffer_count_each(_counter) && result;
+    result = d_tests_sa_text_buffer_matcher_chunk_prefix(_counter)
+             && result;
 
     return result;
 }
@@ -455,6 +455,353 @@ d_tests_sa_text_buffer_hash
     return result;
 }
 
+/*
+d_tests_sa_text_buffer_hash_chunks
+  Tests that d_text_buffer_hash covers overflow chunks.
+  Tests the following:
+  - text split between `data` and chunks hashes like the contiguous text
+  - hashing does not consolidate the chunks
+  - a buffer holding only chunks hashes like the contiguous text
+*/
+bool
+d_tests_sa_text_buffer_hash_chunks
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_text_buffer* flat;
+    struct d_text_buffer* chunked;
+
+    result = true;
+    flat   = d_text_buffer_new_from_string(
+                 "Hello, World! This line is long enough for a full stripe.");
+
+    if (!flat)
+    {
+        return false;
+    }
+
+    // test 1: data followed by chunks
+    chunked = d_text_buffer_new_from_string("Hello, ");
+
+    if (chunked)
+    {
+        d_text_buffer_append_string_chunked(chunked, "World! This line ", 8);
+        d_text_buffer_append_string_chunked(chunked,
+                                            "is long enough for a full stripe.",
+                                            8);
+
+        result = d_assert_standalone(
+            (d_text_buffer_hash(chunked) == d_text_buffer_hash(flat)) &&
+            (d_text_buffer_has_chunks(chunked)),
+            "hash_chunks_split",
+            "Chunks should be hashed in place as part of the text",
+            _counter) && result;
+
+        d_text_buffer_free(chunked);
+    }
+
+    // test 2: chunks only
+    chunked = d_text_buffer_new(0);
+
+    if (chunked)
+    {
+        d_text_buffer_append_string_chunked(
+            chunked,
+            "Hello, World! This line is long enough for a full stripe.",
+            5);
+
+        result = d_assert_standalone(
+            d_text_buffer_hash(chunked) == d_text_buffer_hash(flat),
+            "hash_chunks_only",
+            "A buffer holding only chunks should hash its chunks",
+            _counter) && result;
+
+        d_text_buffer_free(chunked);
+    }
+
+    d_text_buffer_free(flat);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_hash_splits
+  Tests d_text_buffer_hash against a one-shot XXH64 of the same text for
+every split point of a three-stripe text between the primary store and
+what follows it.
+  Tests the following:
+  - primary store followed by one overflow chunk
+  - incremental hash taken after the first part, then a plain append
+  - incremental hash taken after the first part, then a chunked append
+*/
+bool
+d_tests_sa_text_buffer_hash_splits
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_text_buffer* buffer;
+    char                  text[3 * D_TEXT_HASH_STRIPE + 5];
+    size_t                expected;
+    size_t                split;
+    size_t                i;
+    bool                  chunk_ok;
+    bool                  append_ok;
+    bool                  chunked_ok;
+    bool                  result;
+
+    for (i = 0; i < sizeof(text); ++i)
+    {
+        text[i] = (char)('!' + (i * 11) % 90);
+    }
+
+    expected   = (size_t)d_text_hash_bytes(text, sizeof(text), 0);
+    chunk_ok   = true;
+    append_ok  = true;
+    chunked_ok = true;
+    result     = true;
+
+    for (split = 0; split <= sizeof(text); ++split)
+    {
+        // test 1: data | chunk
+        buffer = d_text_buffer_new_from_buffer(text, split);
+
+        if (!buffer)
+        {
+            return false;
+        }
+
+        d_text_buffer_append_buffer_chunked(buffer,
+                                            text + split,
+                                            sizeof(text) - split,
+                                            0);
+
+        chunk_ok = chunk_ok && (d_text_buffer_hash(buffer) == expected);
+
+        d_text_buffer_free(buffer);
+
+        // test 2: incremental, hashed mid-way, then appended to `data`
+        buffer = d_text_buffer_new_from_buffer(text, split);
+
+        if (!buffer)
+        {
+            return false;
+        }
+
+        d_text_buffer_enable_incremental_hash(buffer);
+        d_text_buffer_hash(buffer);
+        d_text_buffer_append_buffer(buffer, text + split, sizeof(text) - split);
+
+        append_ok = append_ok && (d_text_buffer_hash(buffer) == expected);
+
+        d_text_buffer_free(buffer);
+
+        // test 3: incremental, hashed mid-way, then appended as a chunk
+        buffer = d_text_buffer_new_from_buffer(text, split);
+
+        if (!buffer)
+        {
+            return false;
+        }
+
+        d_text_buffer_enable_incremental_hash(buffer);
+        d_text_buffer_hash(buffer);
+        d_text_buffer_append_buffer_chunked(buffer,
+                                            text + split,
+                                            sizeof(text) - split,
+                                            0);
+
+        chunked_ok = chunked_ok && (d_text_buffer_hash(buffer) == expected);
+
+        d_text_buffer_free(buffer);
+    }
+
+    result = d_assert_standalone(
+        chunk_ok,
+        "hash_splits_chunk",
+        "Data followed by a chunk should hash like the whole text",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        append_ok,
+        "hash_splits_incremental",
+        "Incremental hash across an append should match one-shot",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        chunked_ok,
+        "hash_splits_incremental_chunked",
+        "Incremental hash across a chunked append should match one-shot",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_buffer_incremental_hash
+  Tests the d_text_buffer_enable_incremental_hash and
+d_text_buffer_disable_incremental_hash functions by applying the same
+pseudo-random appends and edits to an incremental buffer and a plain
+resize-mode one, comparing their hashes after every step.
+  Tests the following:
+  - NULL buffer is rejected
+  - appends of every kind leave the hash state to be extended
+  - other edits reset it, and the next hash still agrees
+  - text appended to `data` after chunks is handled
+  - rope and gap mode buffers agree as well
+*/
+bool
+d_tests_sa_text_buffer_incremental_hash
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    bool                  agree;
+    bool                  extended;
+    struct d_text_buffer* incremental;
+    struct d_text_buffer* plain;
+    uint64_t              state;
+    uint64_t              seen;
+    int                   mode;
+    int                   round;
+
+    result = true;
+
+    // test 1: NULL
+    result = d_assert_standalone(
+        (!d_text_buffer_enable_incremental_hash(NULL)) &&
+        (!d_text_buffer_disable_incremental_hash(NULL)),
+        "incremental_hash_null",
+        "NULL buffer should be rejected",
+        _counter) && result;
+
+    // test 2: resize, rope and gap mode against a plain buffer
+    for (mode = 0; mode < 3; ++mode)
+    {
+        incremental = d_text_buffer_new_from_string("<html>");
+        plain       = d_text_buffer_new_from_string("<html>");
+        state       = 0x9E3779B97F4A7C15ULL + (uint64_t)mode;
+        extended    = true;
+        agree       = (incremental != NULL) && (plain != NULL) &&
+                      (d_text_buffer_enable_incremental_hash(incremental)) &&
+                      (d_text_buffer_enable_incremental_hash(incremental));
+
+        // the reference buffer stays in resize mode; every mode orders
+        // text appended to `data` after chunks the same way
+        if ( (agree) &&
+             (mode == 1) )
+        {
+            agree = d_text_buffer_enable_rope(incremental);
+        }
+        else if ( (agree) &&
+                  (mode == 2) )
+        {
+            agree = d_text_buffer_enable_gap(incremental);
+        }
+
+        for (round = 0; (round < 400) && agree; ++round)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            seen   = incremental->hash->total;
+
+            switch (state % 8)
+            {
+                case 0:
+                    d_text_buffer_append_string(incremental, "<li>item</li>");
+                    d_text_buffer_append_string(plain, "<li>item</li>");
+
+                    break;
+
+                case 1:
+                    d_text_buffer_append_chars(incremental, ' ', (size_t)(state >> 8) % 40);
+                    d_text_buffer_append_chars(plain, ' ', (size_t)(state >> 8) % 40);
+
+                    break;
+
+                case 2:
+                    d_text_buffer_append_formatted(incremental, "<td>%d</td>", round);
+                    d_text_buffer_append_formatted(plain, "<td>%d</td>", round);
+
+                    break;
+
+                case 3:
+                    d_text_buffer_append_string_chunked(incremental, "<p>chunk</p>", 16);
+                    d_text_buffer_append_string_chunked(plain, "<p>chunk</p>", 16);
+
+                    break;
+
+                case 4:
+                    d_text_buffer_append_char_chunked(incremental, '\n', 16);
+                    d_text_buffer_append_char_chunked(plain, '\n', 16);
+
+                    break;
+
+                case 5:
+                    d_text_buffer_consolidate(incremental);
+                    d_text_buffer_consolidate(plain);
+
+                    break;
+
+                case 6:
+                    d_text_buffer_append_char(incremental, (char)('a' + round % 26));
+                    d_text_buffer_append_char(plain, (char)('a' + round % 26));
+
+                    break;
+
+                default:
+                    // a non-append edit
+                    d_text_buffer_set_char(incremental, 1, (char)('A' + round % 26));
+                    d_text_buffer_set_char(plain, 1, (char)('A' + round % 26));
+
+                    break;
+            }
+
+            // appends must leave the state alone; only set_char resets it
+            if ( (state % 8 != 7) &&
+                 (incremental->hash->total != seen) )
+            {
+                extended = false;
+            }
+
+            agree = (d_text_buffer_hash(incremental) == d_text_buffer_hash(plain));
+        }
+
+        agree = agree &&
+                (d_text_buffer_hash(incremental) == d_text_buffer_hash(plain));
+
+        result = d_assert_standalone(
+            (agree) &&
+            (extended),
+            (mode == 0) ? "incremental_hash_resize" :
+            (mode == 1) ? "incremental_hash_rope" :
+                          "incremental_hash_gap",
+            "Incremental hashes should match full hashes",
+            _counter) && result;
+
+        // test 3: disabling keeps the same hash
+        if (incremental)
+        {
+            result = d_assert_standalone(
+                (d_text_buffer_disable_incremental_hash(incremental)) &&
+                (incremental->hash == NULL) &&
+                (d_text_buffer_hash(incremental) == d_text_buffer_hash(plain)),
+                "incremental_hash_disable",
+                "Disabling should not change the hash",
+                _counter) && result;
+        }
+
+        d_text_buffer_free(incremental);
+        d_text_buffer_free(plain);
+    }
+
+    return result;
+}
+
 /*
 d_tests_sa_text_buffer_utility_all
   Aggregation function that runs all utility tests.
@@ -478,6 +825,9 @@ d_tests_sa_text_buffer_utility_all
     result = d_tests_sa_text_buffer_capacity(_counter) && result;
     result = d_tests_sa_text_buffer_utilization(_counter) && result;
     result = d_tests_sa_text_buffer_hash(_counter) && result;
+    result = d_tests_sa_text_buffer_hash_chunks(_counter) && result;
+    result = d_tests_sa_text_buffer_hash_splits(_counter) && result;
+    result = d_tests_sa_text_buffer_incremental_hash(_counter) && result;
 
     return result;
 }
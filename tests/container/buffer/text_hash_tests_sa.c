@@ -0,0 +1,248 @@
+#include ".\text_hash_tests_sa.h"
+
+
+/*
+d_tests_sa_text_hash_reference
+  Tests d_text_hash_bytes against published XXH64 values (seed 0). The
+values assume a little-endian target.
+  Tests the following:
+  - empty input
+  - inputs shorter than one stripe (1-, 4- and 8-byte tail steps)
+  - an input longer than one stripe
+*/
+bool
+d_tests_sa_text_hash_reference
+(
+    struct d_test_counter* _counter
+)
+{
+    bool        result;
+    const char* long_text;
+
+    result    = true;
+    long_text = "Nobody inspects the spammish repetition";
+
+    // test 1: empty
+    result = d_assert_standalone(
+        (d_text_hash_bytes("", 0, 0) == 0xEF46DB3751D8E999ULL) &&
+        (d_text_hash_bytes(NULL, 0, 0) == 0xEF46DB3751D8E999ULL),
+        "hash_reference_empty",
+        "Empty input should hash to the XXH64 reference value",
+        _counter) && result;
+
+    // test 2: short inputs
+    result = d_assert_standalone(
+        (d_text_hash_bytes("a", 1, 0) == 0xD24EC4F1A98C6E5BULL) &&
+        (d_text_hash_bytes("abc", 3, 0) == 0x44BC2CF5AD770999ULL),
+        "hash_reference_short",
+        "Short inputs should hash to the XXH64 reference values",
+        _counter) && result;
+
+    // test 3: more than one stripe
+    result = d_assert_standalone(
+        d_text_hash_bytes(long_text, strlen(long_text), 0) ==
+            0xFBCEA83C8A378BF1ULL,
+        "hash_reference_long",
+        "A multi-stripe input should hash to the XXH64 reference value",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_hash_streaming
+  Tests that d_text_hash_update gives the same digest however the input is
+split.
+  Tests the following:
+  - every split of a 3-stripe input into three updates matches one-shot
+  - byte-at-a-time updates match one-shot
+  - digest does not disturb the state, so updates can continue after it
+*/
+bool
+d_tests_sa_text_hash_streaming
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    bool               agree;
+    struct d_text_hash state;
+    char               text[3 * D_TEXT_HASH_STRIPE + 7];
+    uint64_t           expected;
+    size_t             first;
+    size_t             second;
+    size_t             i;
+
+    result = true;
+
+    for (i = 0; i < sizeof(text); ++i)
+    {
+        text[i] = (char)('a' + (i * 7 + i / 26) % 26);
+    }
+
+    expected = d_text_hash_bytes(text, sizeof(text), 0);
+    agree    = true;
+
+    // test 1: all three-way splits
+    for (first = 0; first <= sizeof(text); ++first)
+    {
+        for (second = first; second <= sizeof(text); ++second)
+        {
+            d_text_hash_init(&state, 0);
+            d_text_hash_update(&state, text, first);
+            d_text_hash_update(&state, text + first, second - first);
+            d_text_hash_update(&state, text + second, sizeof(text) - second);
+
+            agree = agree && (d_text_hash_digest(&state) == expected);
+        }
+    }
+
+    result = d_assert_standalone(
+        agree,
+        "hash_streaming_splits",
+        "Any split of the input should give the one-shot digest",
+        _counter) && result;
+
+    // test 2: byte at a time, with a digest after every byte
+    d_text_hash_init(&state, 0);
+    agree = true;
+
+    for (i = 0; i < sizeof(text); ++i)
+    {
+        d_text_hash_update(&state, text + i, 1);
+
+        agree = agree &&
+                (d_text_hash_digest(&state) == d_text_hash_bytes(text, i + 1, 0));
+    }
+
+    result = d_assert_standalone(
+        (agree) &&
+        (state.total == sizeof(text)),
+        "hash_streaming_bytes",
+        "Byte-at-a-time updates should match one-shot at every length",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_hash_split_lengths
+  Tests two-update streaming against one-shot hashing for every input
+length up to three stripes and every split point of each, with and
+without a seed.
+  Tests the following:
+  - inputs shorter than a stripe (the short-input finish)
+  - splits landing before, on and after every stripe boundary
+  - empty first or second update
+*/
+bool
+d_tests_sa_text_hash_split_lengths
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               agree;
+    struct d_text_hash state;
+    char               text[3 * D_TEXT_HASH_STRIPE + 1];
+    uint64_t           seeds[2] = { 0, 0x9E3779B97F4A7C15ULL };
+    uint64_t           expected;
+    size_t             length;
+    size_t             split;
+    size_t             i;
+
+    for (i = 0; i < sizeof(text); ++i)
+    {
+        text[i] = (char)(i * 131 + 17);
+    }
+
+    agree = true;
+
+    for (i = 0; i < 2; ++i)
+    {
+        for (length = 0; length <= sizeof(text); ++length)
+        {
+            expected = d_text_hash_bytes(text, length, seeds[i]);
+
+            for (split = 0; split <= length; ++split)
+            {
+                d_text_hash_init(&state, seeds[i]);
+                d_text_hash_update(&state, text, split);
+                d_text_hash_update(&state, text + split, length - split);
+
+                agree = agree &&
+                        (d_text_hash_digest(&state) == expected) &&
+                        (state.total == length);
+            }
+        }
+    }
+
+    return d_assert_standalone(
+        agree,
+        "hash_split_lengths",
+        "Every split of every length should give the one-shot digest",
+        _counter);
+}
+
+/*
+d_tests_sa_text_hash_seed
+  Tests seeding and NULL handling.
+  Tests the following:
+  - different seeds give different digests
+  - the same seed gives the same digest
+  - NULL state is ignored
+*/
+bool
+d_tests_sa_text_hash_seed
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // test 1: seeds
+    result = d_assert_standalone(
+        (d_text_hash_bytes("seed", 4, 0) != d_text_hash_bytes("seed", 4, 1)) &&
+        (d_text_hash_bytes("seed", 4, 7) == d_text_hash_bytes("seed", 4, 7)),
+        "hash_seed",
+        "The seed should select an independent hash",
+        _counter) && result;
+
+    // test 2: NULL state
+    d_text_hash_init(NULL, 0);
+    d_text_hash_update(NULL, "x", 1);
+
+    result = d_assert_standalone(
+        d_text_hash_digest(NULL) == 0,
+        "hash_seed_null",
+        "A NULL state should be ignored",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_hash_run_all
+  Module-level aggregation function that runs all text_hash tests.
+*/
+bool
+d_tests_sa_text_hash_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Text Hash\n");
+    printf("  -------------------\n");
+
+    result = d_tests_sa_text_hash_reference(_counter) && result;
+    result = d_tests_sa_text_hash_streaming(_counter) && result;
+    result = d_tests_sa_text_hash_split_lengths(_counter) && result;
+    result = d_tests_sa_text_hash_seed(_counter) && result;
+
+    return result;
+}
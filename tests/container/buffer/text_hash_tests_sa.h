@@ -0,0 +1,36 @@
+/******************************************************************************
+* djinterp [test]                                         text_hash_tests_sa.h
+*
+*   Unit test declarations for `text_hash.h` module.
+*   Covers the XXH64 reference values, independence of the digest from how
+* the input is split across update calls, and seeding.
+*
+*
+* path:      \tests\container\buffer\text_hash_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_TEXT_HASH_SA_
+#define DJINTERP_TESTS_TEXT_HASH_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\buffer\text_hash.h"
+
+
+// hash function tests
+bool d_tests_sa_text_hash_reference(struct d_test_counter* _counter);
+bool d_tests_sa_text_hash_streaming(struct d_test_counter* _counter);
+bool d_tests_sa_text_hash_split_lengths(struct d_test_counter* _counter);
+bool d_tests_sa_text_hash_seed(struct d_test_counter* _counter);
+
+
+// module-level aggregation
+bool d_tests_sa_text_hash_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_TEXT_HASH_SA_
@@ -0,0 +1,568 @@
+#include ".\text_matcher_tests_sa.h"
+
+
+// d_tests_sa_text_matcher_hits
+//   struct: match log filled by d_tests_sa_text_matcher_collect.
+struct d_tests_sa_text_matcher_hits
+{
+    size_t positions[64];
+    size_t patterns[64];
+    size_t count;
+    size_t stop_after;   // 0 = never stop
+};
+
+// d_tests_sa_text_matcher_collect
+//   fn_text_matcher_match that stores up to 64 matches.
+static bool
+d_tests_sa_text_matcher_collect
+(
+    size_t _position,
+    size_t _pattern,
+    void*  _context
+)
+{
+    struct d_tests_sa_text_matcher_hits* hits;
+
+    hits = (struct d_tests_sa_text_matcher_hits*)_context;
+
+    if (hits->count < 64)
+    {
+        hits->positions[hits->count] = _position;
+        hits->patterns[hits->count]  = _pattern;
+    }
+
+    ++hits->count;
+
+    return (hits->stop_after == 0) || (hits->count < hits->stop_after);
+}
+
+
+/*
+d_tests_sa_text_matcher_new
+  Tests the d_text_matcher_new and d_text_matcher_new_n functions.
+  Tests the following:
+  - NULL pattern array, zero count, NULL or empty pattern return NULL
+  - pattern count and lengths are reported
+  - patterns are copied (the caller's storage can change afterwards)
+*/
+bool
+d_tests_sa_text_matcher_new
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_text_matcher* matcher;
+    char                   mutable_pattern[8];
+    const char*            patterns[3];
+    static const char*     with_null[] = { "a", NULL };
+    static const char*     with_empty[] = { "a", "" };
+
+    result = true;
+
+    // test 1: invalid input
+    result = d_assert_standalone(
+        (d_text_matcher_new(NULL, 1) == NULL) &&
+        (d_text_matcher_new(with_null, 0) == NULL) &&
+        (d_text_matcher_new(with_null, 2) == NULL) &&
+        (d_text_matcher_new(with_empty, 2) == NULL),
+        "new_invalid",
+        "Invalid pattern sets should return NULL",
+        _counter) && result;
+
+    // test 2: counts and lengths
+    memcpy(mutable_pattern, "abc", 4);
+
+    patterns[0] = mutable_pattern;
+    patterns[1] = "de";
+    patterns[2] = "fghij";
+
+    matcher = d_text_matcher_new(patterns, 3);
+
+    result = d_assert_standalone(
+        (matcher != NULL) &&
+        (d_text_matcher_pattern_count(matcher) == 3) &&
+        (d_text_matcher_pattern_length(matcher, 0) == 3) &&
+        (d_text_matcher_pattern_length(matcher, 2) == 5) &&
+        (d_text_matcher_pattern_length(matcher, 3) == 0),
+        "new_lengths",
+        "Matcher should report 3 patterns and their lengths",
+        _counter) && result;
+
+    // test 3: patterns are copied
+    mutable_pattern[0] = 'x';
+
+    result = d_assert_standalone(
+        d_text_matcher_find(matcher, "zzabc", 5, NULL) == 2,
+        "new_copies",
+        "Changing the caller's pattern should not affect the matcher",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_matcher_find
+  Tests the d_text_matcher_find function.
+  Tests the following:
+  - the classic he/she/his/hers set resolves leftmost-longest
+  - a pattern that is a prefix of another loses to the longer one
+  - duplicate patterns report the lowest index
+  - patterns with embedded NULs match via d_text_matcher_new_n
+  - no match and empty text return -1
+*/
+bool
+d_tests_sa_text_matcher_find
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_text_matcher* matcher;
+    size_t                 pattern;
+    static const char*     classic[] = { "he", "she", "his", "hers" };
+    static const char*     dupes[]   = { "ab", "xy", "ab" };
+    static const char*     binary[]  = { "k\0v", "\0\0" };
+    static const size_t    binary_lengths[] = { 3, 2 };
+
+    result = true;
+
+    // test 1: leftmost wins, then longest at that position
+    matcher = d_text_matcher_new(classic, 4);
+    pattern = 99;
+
+    result = d_assert_standalone(
+        (d_text_matcher_find(matcher, "ushers", 6, &pattern) == 1) &&
+        (pattern == 1),
+        "find_leftmost",
+        "'she' at 1 should beat 'hers' at 2",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        (d_text_matcher_find(matcher, "xhersx", 6, &pattern) == 1) &&
+        (pattern == 3),
+        "find_longest",
+        "'hers' should beat its prefix 'he'",
+        _counter) && result;
+
+    // test 2: no match / empty text
+    result = d_assert_standalone(
+        (d_text_matcher_find(matcher, "abcdef", 6, NULL) == -1) &&
+        (d_text_matcher_find(matcher, "", 0, NULL) == -1),
+        "find_none",
+        "Text without patterns should return -1",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    // test 3: duplicates
+    matcher = d_text_matcher_new(dupes, 3);
+
+    result = d_assert_standalone(
+        (d_text_matcher_find(matcher, "--ab", 4, &pattern) == 2) &&
+        (pattern == 0),
+        "find_duplicate",
+        "Duplicate pattern should report the lowest index",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    // test 4: embedded NULs
+    matcher = d_text_matcher_new_n(binary, binary_lengths, 2);
+
+    result = d_assert_standalone(
+        (d_text_matcher_find(matcher, "a\0k\0v", 5, &pattern) == 2) &&
+        (pattern == 0),
+        "find_embedded_nul",
+        "'k\\0v' should be found at 2",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_matcher_segments
+  Tests the d_text_matcher_scan_segments function.
+  Tests the following:
+  - matches are reported in order at their global positions
+  - matches straddling segment boundaries, including empty segments, are
+    found
+  - a candidate held across a boundary is replaced by a longer one
+  - returning false from the callback stops the scan
+*/
+bool
+d_tests_sa_text_matcher_segments
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                                result;
+    struct d_text_matcher*              matcher;
+    struct d_tests_sa_text_matcher_hits hits;
+    struct d_text_segment               segments[5];
+    static const char*                  patterns[] = { "he", "hers", "apple" };
+
+    result  = true;
+    matcher = d_text_matcher_new(patterns, 3);
+
+    // "an ap" | "pl" | "" | "e; h" | "ers"
+    segments[0].data = "an ap";  segments[0].length = 5;
+    segments[1].data = "pl";     segments[1].length = 2;
+    segments[2].data = "";       segments[2].length = 0;
+    segments[3].data = "e; h";   segments[3].length = 4;
+    segments[4].data = "ers";    segments[4].length = 3;
+
+    // test 1: straddling matches
+    memset(&hits, 0, sizeof(hits));
+
+    result = d_assert_standalone(
+        (d_text_matcher_scan_segments(matcher,
+                                      segments,
+                                      5,
+                                      d_tests_sa_text_matcher_collect,
+                                      &hits)) &&
+        (hits.count == 2) &&
+        (hits.positions[0] == 3) && (hits.patterns[0] == 2) &&
+        (hits.positions[1] == 10) && (hits.patterns[1] == 1),
+        "segments_straddle",
+        "'apple' at 3 and 'hers' at 10 should be found",
+        _counter) && result;
+
+    // test 2: early stop
+    memset(&hits, 0, sizeof(hits));
+    hits.stop_after = 1;
+
+    result = d_assert_standalone(
+        (!d_text_matcher_scan_segments(matcher,
+                                       segments,
+                                       5,
+                                       d_tests_sa_text_matcher_collect,
+                                       &hits)) &&
+        (hits.count == 1),
+        "segments_stop",
+        "Callback returning false should stop the scan",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_matcher_prefix_overlap
+  Tests pattern sets in which one pattern is a prefix of another.
+  Tests the following:
+  - a chain of prefixes resolves to the longest one present at each start
+  - a longer pattern that fails partway falls back to its matched prefix
+  - a failed longer candidate yields a shorter match that starts later
+  - self-overlapping patterns are reported without overlap
+  - the same holds when the text is split inside the candidates
+*/
+bool
+d_tests_sa_text_matcher_prefix_overlap
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                                result;
+    struct d_text_matcher*              matcher;
+    struct d_tests_sa_text_matcher_hits hits;
+    struct d_text_segment               segments[4];
+    static const char*                  chain[]    = { "a", "ab", "abc", "abcd" };
+    static const char*                  fallback[] = { "ab", "abcd" };
+    static const char*                  later[]    = { "abcde", "bc", "c" };
+    static const char*                  overlap[]  = { "abab", "bab" };
+
+    result = true;
+
+    // test 1: a, ab, abc, abcd
+    matcher = d_text_matcher_new(chain, 4);
+    memset(&hits, 0, sizeof(hits));
+
+    segments[0].data = "abcabab a abcdx";  segments[0].length = 15;
+
+    d_text_matcher_scan_segments(matcher,
+                                 segments,
+                                 1,
+                                 d_tests_sa_text_matcher_collect,
+                                 &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 5) &&
+        (hits.positions[0] == 0)  && (hits.patterns[0] == 2) &&
+        (hits.positions[1] == 3)  && (hits.patterns[1] == 1) &&
+        (hits.positions[2] == 5)  && (hits.patterns[2] == 1) &&
+        (hits.positions[3] == 8)  && (hits.patterns[3] == 0) &&
+        (hits.positions[4] == 10) && (hits.patterns[4] == 3),
+        "prefix_chain",
+        "Each start should report its longest prefix pattern",
+        _counter) && result;
+
+    // test 2: the chain split inside "abcd"
+    memset(&hits, 0, sizeof(hits));
+
+    segments[0].data = "ab";  segments[0].length = 2;
+    segments[1].data = "c";   segments[1].length = 1;
+    segments[2].data = "";    segments[2].length = 0;
+    segments[3].data = "da";  segments[3].length = 2;
+
+    d_text_matcher_scan_segments(matcher,
+                                 segments,
+                                 4,
+                                 d_tests_sa_text_matcher_collect,
+                                 &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 2) &&
+        (hits.positions[0] == 0) && (hits.patterns[0] == 3) &&
+        (hits.positions[1] == 4) && (hits.patterns[1] == 0),
+        "prefix_chain_segments",
+        "'abcd' split over segments should beat its prefixes",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    // test 3: ab / abcd where abcd fails at the last byte
+    matcher = d_text_matcher_new(fallback, 2);
+    memset(&hits, 0, sizeof(hits));
+
+    segments[0].data = "abc";  segments[0].length = 3;
+    segments[1].data = "ab";   segments[1].length = 2;
+
+    d_text_matcher_scan_segments(matcher,
+                                 segments,
+                                 2,
+                                 d_tests_sa_text_matcher_collect,
+                                 &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 2) &&
+        (hits.positions[0] == 0) && (hits.patterns[0] == 0) &&
+        (hits.positions[1] == 3) && (hits.patterns[1] == 0),
+        "prefix_fallback",
+        "Failed 'abcd' should fall back to 'ab' at 0, then 'ab' at 3",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    // test 4: abcde fails, so the leftmost match is bc at 1
+    matcher = d_text_matcher_new(later, 3);
+    memset(&hits, 0, sizeof(hits));
+
+    segments[0].data = "ab";  segments[0].length = 2;
+    segments[1].data = "cd";  segments[1].length = 2;
+    segments[2].data = "x";   segments[2].length = 1;
+
+    d_text_matcher_scan_segments(matcher,
+                                 segments,
+                                 3,
+                                 d_tests_sa_text_matcher_collect,
+                                 &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 1) &&
+        (hits.positions[0] == 1) && (hits.patterns[0] == 1) &&
+        (d_text_matcher_find(matcher, "abcdx", 5, NULL) == 1),
+        "prefix_later_start",
+        "A failed 'abcde' should leave 'bc' at 1 as the only match",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    // test 5: abab / bab on "abababab"
+    matcher = d_text_matcher_new(overlap, 2);
+    memset(&hits, 0, sizeof(hits));
+
+    segments[0].data = "abababab";  segments[0].length = 8;
+
+    d_text_matcher_scan_segments(matcher,
+                                 segments,
+                                 1,
+                                 d_tests_sa_text_matcher_collect,
+                                 &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 2) &&
+        (hits.positions[0] == 0) && (hits.patterns[0] == 0) &&
+        (hits.positions[1] == 4) && (hits.patterns[1] == 0),
+        "prefix_self_overlap",
+        "'abab' should be reported at 0 and 4 without overlap",
+        _counter) && result;
+
+    d_text_matcher_free(matcher);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_matcher_matches_naive
+  Compares the segmented scan against a naive leftmost-longest scan over
+pseudo-random texts and pattern sets (small alphabets, so overlapping and
+nested patterns are frequent), with the text cut into uneven segments.
+*/
+bool
+d_tests_sa_text_matcher_matches_naive
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_text_matcher*              matcher;
+    struct d_tests_sa_text_matcher_hits hits;
+    struct d_text_segment               segments[6];
+    char                                text[128];
+    char                                storage[6][8];
+    const char*                         patterns[6];
+    size_t                              lengths[6];
+    size_t                              expect_positions[64];
+    size_t                              expect_patterns[64];
+    size_t                              expect_count;
+    size_t                              pattern_count;
+    size_t                              text_len;
+    size_t                              best;
+    size_t                              i;
+    size_t                              j;
+    size_t                              k;
+    size_t                              cut;
+    uint64_t                            state;
+    int                                 round;
+    bool                                agree;
+
+    agree = true;
+    state = 0x2545F4914F6CDD1DULL;
+
+    for (round = 0; (round < 2000) && agree; ++round)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        text_len      = (size_t)(state % sizeof(text));
+        pattern_count = 1 + (size_t)((state >> 8) % 6);
+
+        for (i = 0; i < text_len; ++i)
+        {
+            text[i] = (char)('a' + ((state >> (i % 48)) ^ (i * 7)) % 3);
+        }
+
+        for (k = 0; k < pattern_count; ++k)
+        {
+            lengths[k]  = 1 + (size_t)((state >> (12 + k * 5)) % 7);
+            patterns[k] = storage[k];
+
+            for (j = 0; j < lengths[k]; ++j)
+            {
+                storage[k][j] = (char)('a' + ((state >> ((k * 7 + j) % 50)) % 3));
+            }
+        }
+
+        // naive leftmost-longest, non-overlapping
+        expect_count = 0;
+
+        for (i = 0; i < text_len; )
+        {
+            best = pattern_count;
+
+            for (k = 0; k < pattern_count; ++k)
+            {
+                if ( (i + lengths[k] <= text_len) &&
+                     (memcmp(text + i, patterns[k], lengths[k]) == 0) &&
+                     ( (best == pattern_count) ||
+                       (lengths[k] > lengths[best]) ) )
+                {
+                    best = k;
+                }
+            }
+
+            if (best == pattern_count)
+            {
+                ++i;
+
+                continue;
+            }
+
+            if (expect_count < 64)
+            {
+                expect_positions[expect_count] = i;
+                expect_patterns[expect_count]  = best;
+            }
+
+            ++expect_count;
+            i += lengths[best];
+        }
+
+        matcher = d_text_matcher_new_n(patterns, lengths, pattern_count);
+
+        if (!matcher)
+        {
+            agree = false;
+
+            break;
+        }
+
+        // the same text cut into 6 uneven segments
+        for (j = 0, i = 0; j < 6; ++j)
+        {
+            cut = (j == 5) ? (text_len - i)
+                           : (size_t)((state >> (j * 6)) % 11) % (text_len - i + 1);
+
+            segments[j].data   = text + i;
+            segments[j].length = cut;
+            i                 += cut;
+        }
+
+        memset(&hits, 0, sizeof(hits));
+
+        d_text_matcher_scan_segments(matcher,
+                                     segments,
+                                     6,
+                                     d_tests_sa_text_matcher_collect,
+                                     &hits);
+
+        agree = (hits.count == expect_count);
+
+        for (i = 0; (i < expect_count) && (i < 64) && agree; ++i)
+        {
+            agree = (hits.positions[i] == expect_positions[i]) &&
+                    (hits.patterns[i] == expect_patterns[i]);
+        }
+
+        d_text_matcher_free(matcher);
+    }
+
+    return d_assert_standalone(
+        agree,
+        "matches_naive",
+        "Matcher results should match a naive scan",
+        _counter);
+}
+
+
+/*
+d_tests_sa_text_matcher_run_all
+  Module-level aggregation function that runs all text_matcher tests.
+*/
+bool
+d_tests_sa_text_matcher_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Text Matcher\n");
+    printf("  ----------------------\n");
+
+    result = d_tests_sa_text_matcher_new(_counter) && result;
+    result = d_tests_sa_text_matcher_find(_counter) && result;
+    result = d_tests_sa_text_matcher_segments(_counter) && result;
+    result = d_tests_sa_text_matcher_prefix_overlap(_counter) && result;
+    result = d_tests_sa_text_matcher_matches_naive(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,39 @@
+/******************************************************************************
+* djinterp [test]                                      text_matcher_tests_sa.h
+*
+*   Unit test declarations for `text_matcher.h` module.
+*   Covers matcher construction (including invalid input), leftmost-longest
+* resolution of overlapping patterns, NUL-containing patterns, segmented
+* text with matches straddling segment boundaries, and a randomized
+* comparison against a naive multi-pattern scan.
+*
+*
+* path:      \tests\container\buffer\text_matcher_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_TEXT_MATCHER_SA_
+#define DJINTERP_TESTS_TEXT_MATCHER_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\buffer\text_matcher.h"
+
+
+// matcher function tests
+bool d_tests_sa_text_matcher_new(struct d_test_counter* _counter);
+bool d_tests_sa_text_matcher_find(struct d_test_counter* _counter);
+bool d_tests_sa_text_matcher_segments(struct d_test_counter* _counter);
+bool d_tests_sa_text_matcher_prefix_overlap(struct d_test_counter* _counter);
+bool d_tests_sa_text_matcher_matches_naive(struct d_test_counter* _counter);
+
+
+// module-level aggregation
+bool d_tests_sa_text_matcher_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_TEXT_MATCHER_SA_
@@ -0,0 +1,562 @@
+#include ".\text_rope_tests_sa.h"
+
+
+// d_tests_sa_text_rope_equals
+//   true if a rope holds exactly `_length` bytes equal to `_expected`.
+static bool
+d_tests_sa_text_rope_equals
+(
+    const struct d_text_rope* _rope,
+    const char*               _expected,
+    size_t                    _length
+)
+{
+    char* copy;
+    bool  equal;
+
+    if (d_text_rope_length(_rope) != _length)
+    {
+        return false;
+    }
+
+    copy = malloc(_length + 1);
+
+    if (!copy)
+    {
+        return false;
+    }
+
+    equal = (d_text_rope_copy(_rope, 0, _length, copy) == _length) &&
+            (memcmp(copy, _expected, _length) == 0);
+
+    free(copy);
+
+    return equal;
+}
+
+// d_tests_sa_text_rope_fill
+//   fills `_text` with a repeating, position-dependent pattern.
+static void
+d_tests_sa_text_rope_fill
+(
+    char*  _text,
+    size_t _length
+)
+{
+    size_t i;
+
+    for (i = 0; i < _length; ++i)
+    {
+        _text[i] = (char)('a' + (i * 7 + i / 26) % 26);
+    }
+
+    return;
+}
+
+
+/*
+d_tests_sa_text_rope_assign
+  Tests the d_text_rope_init, d_text_rope_assign and d_text_rope_copy
+functions.
+  Tests the following:
+  - a new rope is empty
+  - assigning text spanning several leaves round-trips through copy
+  - reassigning replaces the contents
+  - NULL text with a nonzero length is rejected
+  - copy clamps to the end of the rope
+*/
+bool
+d_tests_sa_text_rope_assign
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_text_rope rope;
+    char               text[3 * D_TEXT_ROPE_LEAF + 17];
+    char               out[8];
+
+    result = true;
+
+    d_text_rope_init(&rope);
+    d_tests_sa_text_rope_fill(text, sizeof(text));
+
+    // test 1: empty rope
+    result = d_assert_standalone(
+        (d_text_rope_length(&rope) == 0) &&
+        (d_text_rope_copy(&rope, 0, 4, out) == 0),
+        "assign_empty",
+        "New rope should be empty",
+        _counter) && result;
+
+    // test 2: multi-leaf round trip
+    result = d_assert_standalone(
+        (d_text_rope_assign(&rope, text, sizeof(text))) &&
+        (d_tests_sa_text_rope_equals(&rope, text, sizeof(text))),
+        "assign_round_trip",
+        "Assigned text should copy back unchanged",
+        _counter) && result;
+
+    // test 3: reassign
+    result = d_assert_standalone(
+        (d_text_rope_assign(&rope, "short", 5)) &&
+        (d_tests_sa_text_rope_equals(&rope, "short", 5)),
+        "assign_replace",
+        "Reassigning should replace the contents",
+        _counter) && result;
+
+    // test 4: invalid input
+    result = d_assert_standalone(
+        (!d_text_rope_assign(&rope, NULL, 3)) &&
+        (d_tests_sa_text_rope_equals(&rope, "short", 5)),
+        "assign_invalid",
+        "NULL text should be rejected without changing the rope",
+        _counter) && result;
+
+    // test 5: clamped copy
+    result = d_assert_standalone(
+        (d_text_rope_copy(&rope, 3, 100, out) == 2) &&
+        (memcmp(out, "rt", 2) == 0),
+        "copy_clamped",
+        "Copy past the end should be clamped",
+        _counter) && result;
+
+    d_text_rope_clear(&rope);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_rope_access
+  Tests the d_text_rope_get and d_text_rope_set functions.
+  Tests the following:
+  - get returns the byte at every position of a multi-leaf rope
+  - set overwrites one byte
+  - out-of-range get returns '\0' and set fails
+*/
+bool
+d_tests_sa_text_rope_access
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    bool               agree;
+    struct d_text_rope rope;
+    char               text[2 * D_TEXT_ROPE_LEAF + 5];
+    size_t             i;
+
+    result = true;
+
+    d_text_rope_init(&rope);
+    d_tests_sa_text_rope_fill(text, sizeof(text));
+    d_text_rope_assign(&rope, text, sizeof(text));
+
+    // test 1: every position
+    agree = true;
+
+    for (i = 0; (i < sizeof(text)) && agree; ++i)
+    {
+        agree = (d_text_rope_get(&rope, i) == text[i]);
+    }
+
+    result = d_assert_standalone(
+        agree,
+        "get_every_position",
+        "get should return each byte of the text",
+        _counter) && result;
+
+    // test 2: set
+    result = d_assert_standalone(
+        (d_text_rope_set(&rope, D_TEXT_ROPE_LEAF, '#')) &&
+        (d_text_rope_get(&rope, D_TEXT_ROPE_LEAF) == '#') &&
+        (d_text_rope_get(&rope, D_TEXT_ROPE_LEAF - 1) == text[D_TEXT_ROPE_LEAF - 1]),
+        "set_one",
+        "set should change exactly one byte",
+        _counter) && result;
+
+    // test 3: out of range
+    result = d_assert_standalone(
+        (d_text_rope_get(&rope, sizeof(text)) == '\0') &&
+        (!d_text_rope_set(&rope, sizeof(text), 'x')),
+        "access_out_of_range",
+        "Out-of-range access should fail",
+        _counter) && result;
+
+    d_text_rope_clear(&rope);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_rope_insert
+  Tests the d_text_rope_insert function.
+  Tests the following:
+  - insertion into an empty rope, at the front, middle and end
+  - text longer than a leaf inserted in the middle of a multi-leaf rope
+  - many small inserts at one position (in-place path filling a leaf)
+  - an index past the end is rejected
+*/
+bool
+d_tests_sa_text_rope_insert
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_text_rope rope;
+    char               big[D_TEXT_ROPE_LEAF * 2 + 3];
+    char               expected[D_TEXT_ROPE_LEAF * 4];
+    size_t             i;
+
+    result = true;
+
+    d_text_rope_init(&rope);
+    d_tests_sa_text_rope_fill(big, sizeof(big));
+
+    // test 1: front / middle / end
+    result = d_assert_standalone(
+        (d_text_rope_insert(&rope, 0, "world", 5)) &&
+        (d_text_rope_insert(&rope, 0, "hello", 5)) &&
+        (d_text_rope_insert(&rope, 5, ", ", 2)) &&
+        (d_text_rope_insert(&rope, 12, "!", 1)) &&
+        (d_tests_sa_text_rope_equals(&rope, "hello, world!", 13)),
+        "insert_basic",
+        "Rope should read 'hello, world!'",
+        _counter) && result;
+
+    // test 2: large insert in the middle
+    memcpy(expected, "hello, ", 7);
+    memcpy(expected + 7, big, sizeof(big));
+    memcpy(expected + 7 + sizeof(big), "world!", 6);
+
+    result = d_assert_standalone(
+        (d_text_rope_insert(&rope, 7, big, sizeof(big))) &&
+        (d_tests_sa_text_rope_equals(&rope, expected, sizeof(big) + 13)),
+        "insert_large",
+        "Multi-leaf text should be spliced into the middle",
+        _counter) && result;
+
+    // test 3: repeated single-byte inserts at one point
+    d_text_rope_assign(&rope, "[]", 2);
+
+    for (i = 0; i < D_TEXT_ROPE_LEAF + 10; ++i)
+    {
+        d_text_rope_insert(&rope, 1, "x", 1);
+    }
+
+    expected[0] = '[';
+    memset(expected + 1, 'x', D_TEXT_ROPE_LEAF + 10);
+    expected[D_TEXT_ROPE_LEAF + 11] = ']';
+
+    result = d_assert_standalone(
+        d_tests_sa_text_rope_equals(&rope, expected, D_TEXT_ROPE_LEAF + 12),
+        "insert_repeated",
+        "Repeated inserts should overflow a leaf correctly",
+        _counter) && result;
+
+    // test 4: past the end
+    result = d_assert_standalone(
+        (!d_text_rope_insert(&rope, D_TEXT_ROPE_LEAF + 13, "y", 1)) &&
+        (d_text_rope_length(&rope) == D_TEXT_ROPE_LEAF + 12),
+        "insert_out_of_range",
+        "Insert past the end should fail",
+        _counter) && result;
+
+    d_text_rope_clear(&rope);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_rope_remove
+  Tests the d_text_rope_remove function.
+  Tests the following:
+  - a range inside one leaf
+  - a range spanning several leaves
+  - removing everything leaves an empty, reusable rope
+  - a range past the end is rejected
+*/
+bool
+d_tests_sa_text_rope_remove
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_text_rope rope;
+    char               text[D_TEXT_ROPE_LEAF * 3];
+    char               expected[D_TEXT_ROPE_LEAF * 3];
+    size_t             length;
+
+    result = true;
+
+    d_text_rope_init(&rope);
+    d_tests_sa_text_rope_fill(text, sizeof(text));
+    d_text_rope_assign(&rope, text, sizeof(text));
+
+    // test 1: inside one leaf
+    length = sizeof(text) - 3;
+    memcpy(expected, text, 10);
+    memcpy(expected + 10, text + 13, sizeof(text) - 13);
+
+    result = d_assert_standalone(
+        (d_text_rope_remove(&rope, 10, 3)) &&
+        (d_tests_sa_text_rope_equals(&rope, expected, length)),
+        "remove_in_leaf",
+        "Three bytes should be removed from the first leaf",
+        _counter) && result;
+
+    // test 2: spanning leaves
+    memmove(expected + 100,
+            expected + 100 + D_TEXT_ROPE_LEAF,
+            length - 100 - D_TEXT_ROPE_LEAF);
+    length -= D_TEXT_ROPE_LEAF;
+
+    result = d_assert_standalone(
+        (d_text_rope_remove(&rope, 100, D_TEXT_ROPE_LEAF)) &&
+        (d_tests_sa_text_rope_equals(&rope, expected, length)),
+        "remove_spanning",
+        "A leaf-sized range across a boundary should be removed",
+        _counter) && result;
+
+    // test 3: out of range
+    result = d_assert_standalone(
+        (!d_text_rope_remove(&rope, length - 1, 2)) &&
+        (d_text_rope_length(&rope) == length),
+        "remove_out_of_range",
+        "Removing past the end should fail",
+        _counter) && result;
+
+    // test 4: everything
+    result = d_assert_standalone(
+        (d_text_rope_remove(&rope, 0, length)) &&
+        (d_text_rope_length(&rope) == 0) &&
+        (d_text_rope_insert(&rope, 0, "ok", 2)) &&
+        (d_tests_sa_text_rope_equals(&rope, "ok", 2)),
+        "remove_all",
+        "Emptied rope should be reusable",
+        _counter) && result;
+
+    d_text_rope_clear(&rope);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_rope_split_concat
+  Tests the d_text_rope_split and d_text_rope_concat functions.
+  Tests the following:
+  - split inside a leaf divides the text
+  - concat restores it and empties the right rope
+  - split at 0 and at the end
+  - splitting a rope into itself is rejected
+*/
+bool
+d_tests_sa_text_rope_split_concat
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_text_rope rope;
+    struct d_text_rope right;
+    char               text[D_TEXT_ROPE_LEAF * 2 + 100];
+    size_t             cut;
+
+    result = true;
+
+    d_text_rope_init(&rope);
+    d_text_rope_init(&right);
+    d_tests_sa_text_rope_fill(text, sizeof(text));
+    d_text_rope_assign(&rope, text, sizeof(text));
+
+    cut = D_TEXT_ROPE_LEAF + 37;
+
+    // test 1: split
+    result = d_assert_standalone(
+        (d_text_rope_split(&rope, cut, &right)) &&
+        (d_tests_sa_text_rope_equals(&rope, text, cut)) &&
+        (d_tests_sa_text_rope_equals(&right, text + cut, sizeof(text) - cut)),
+        "split_middle",
+        "Split should divide the text at the index",
+        _counter) && result;
+
+    // test 2: concat
+    d_text_rope_concat(&rope, &right);
+
+    result = d_assert_standalone(
+        (d_tests_sa_text_rope_equals(&rope, text, sizeof(text))) &&
+        (d_text_rope_length(&right) == 0),
+        "concat_restore",
+        "Concat should restore the text and empty the right rope",
+        _counter) && result;
+
+    // test 3: ends
+    result = d_assert_standalone(
+        (d_text_rope_split(&rope, sizeof(text), &right)) &&
+        (d_text_rope_length(&right) == 0) &&
+        (d_text_rope_split(&rope, 0, &right)) &&
+        (d_text_rope_length(&rope) == 0) &&
+        (d_tests_sa_text_rope_equals(&right, text, sizeof(text))),
+        "split_ends",
+        "Splits at either end should move all or nothing",
+        _counter) && result;
+
+    // test 4: invalid
+    result = d_assert_standalone(
+        (!d_text_rope_split(&right, 1, &right)) &&
+        (!d_text_rope_split(&rope, 1, &right)),
+        "split_invalid",
+        "Self-split and out-of-range split should fail",
+        _counter) && result;
+
+    d_text_rope_clear(&rope);
+    d_text_rope_clear(&right);
+
+    return result;
+}
+
+/*
+d_tests_sa_text_rope_matches_flat
+  Applies a pseudo-random sequence of inserts, removes, sets, splits and
+concats to a rope and to a flat array, comparing the two throughout.
+*/
+bool
+d_tests_sa_text_rope_matches_flat
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_text_rope rope;
+    struct d_text_rope right;
+    char*              flat;
+    char               piece[D_TEXT_ROPE_LEAF + 64];
+    size_t             capacity;
+    size_t             length;
+    size_t             position;
+    size_t             amount;
+    size_t             i;
+    uint64_t           state;
+    int                round;
+    bool               agree;
+
+    capacity = 1 << 16;
+    flat     = malloc(capacity);
+    length   = 0;
+    state    = 0x9E3779B97F4A7C15ULL;
+    agree    = (flat != NULL);
+
+    d_text_rope_init(&rope);
+    d_text_rope_init(&right);
+
+    for (round = 0; (round < 20000) && agree; ++round)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        position = (size_t)(state >> 20) % (length + 1);
+
+        switch (state % 5)
+        {
+            case 0:
+            case 1:
+                amount = ((state >> 8) % 4 == 0) ? (size_t)(state >> 40) % sizeof(piece)
+                                                 : (size_t)(state >> 40) % 6;
+
+                if (length + amount > capacity)
+                {
+                    break;
+                }
+
+                for (i = 0; i < amount; ++i)
+                {
+                    piece[i] = (char)('A' + (round + i) % 26);
+                }
+
+                agree = d_text_rope_insert(&rope, position, piece, amount);
+
+                memmove(flat + position + amount, flat + position, length - position);
+                memcpy(flat + position, piece, amount);
+                length += amount;
+
+                break;
+
+            case 2:
+                amount = ((state >> 8) % 4 == 0) ? (size_t)(state >> 40) % 2000
+                                                 : (size_t)(state >> 40) % 5;
+
+                if (amount > length - position)
+                {
+                    amount = length - position;
+                }
+
+                agree = d_text_rope_remove(&rope, position, amount);
+
+                memmove(flat + position, flat + position + amount, length - position - amount);
+                length -= amount;
+
+                break;
+
+            case 3:
+                if (position < length)
+                {
+                    agree = (d_text_rope_get(&rope, position) == flat[position]) &&
+                            (d_text_rope_set(&rope, position, '*'));
+                    flat[position] = '*';
+                }
+
+                break;
+
+            default:
+                agree = (d_text_rope_split(&rope, position, &right)) &&
+                        (d_text_rope_length(&right) == length - position);
+                d_text_rope_concat(&rope, &right);
+
+                break;
+        }
+
+        agree = agree && (d_text_rope_length(&rope) == length);
+    }
+
+    agree = agree && d_tests_sa_text_rope_equals(&rope, flat, length);
+
+    d_text_rope_clear(&rope);
+    d_text_rope_clear(&right);
+    free(flat);
+
+    return d_assert_standalone(
+        agree,
+        "matches_flat",
+        "Rope should match a flat array after random edits",
+        _counter);
+}
+
+
+/*
+d_tests_sa_text_rope_run_all
+  Module-level aggregation function that runs all text_rope tests.
+*/
+bool
+d_tests_sa_text_rope_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Text Rope\n");
+    printf("  -------------------\n");
+
+    result = d_tests_sa_text_rope_assign(_counter) && result;
+    result = d_tests_sa_text_rope_access(_counter) && result;
+    result = d_tests_sa_text_rope_insert(_counter) && result;
+    result = d_tests_sa_text_rope_remove(_counter) && result;
+    result = d_tests_sa_text_rope_split_concat(_counter) && result;
+    result = d_tests_sa_text_rope_matches_flat(_counter) && result;
+
+    return result;
+}
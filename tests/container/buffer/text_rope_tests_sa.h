@@ -0,0 +1,39 @@
+/******************************************************************************
+* djinterp [test]                                         text_rope_tests_sa.h
+*
+*   Unit test declarations for `text_rope.h` module.
+*   Covers assignment and copying, indexed access, in-place and splitting
+* inserts and removes (including ranges spanning many leaves), split and
+* concat, and a randomized comparison against a flat character array.
+*
+*
+* path:      \tests\container\buffer\text_rope_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_TEXT_ROPE_SA_
+#define DJINTERP_TESTS_TEXT_ROPE_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\buffer\text_rope.h"
+
+
+// rope function tests
+bool d_tests_sa_text_rope_assign(struct d_test_counter* _counter);
+bool d_tests_sa_text_rope_access(struct d_test_counter* _counter);
+bool d_tests_sa_text_rope_insert(struct d_test_counter* _counter);
+bool d_tests_sa_text_rope_remove(struct d_test_counter* _counter);
+bool d_tests_sa_text_rope_split_concat(struct d_test_counter* _counter);
+bool d_tests_sa_text_rope_matches_flat(struct d_test_counter* _counter);
+
+
+// module-level aggregation
+bool d_tests_sa_text_rope_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_TEXT_ROPE_SA_
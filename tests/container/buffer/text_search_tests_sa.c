@@ -0,0 +1,616 @@
+#include ".\text_search_tests_sa.h"
+
+
+// a needle longer than D_TEXT_SEARCH_SHORT_MAX, so it takes the Horspool path
+static const char d_tests_sa_text_search_long_needle[] =
+    "the quick brown fox jumps over the lazy dog, twice";
+
+// d_tests_sa_text_search_collect
+//   fn_text_search_match that stores up to 16 match positions.
+struct d_tests_sa_text_search_hits
+{
+    size_t positions[16];
+    size_t count;
+};
+
+static bool
+d_tests_sa_text_search_collect
+(
+    size_t _position,
+    void*  _context
+)
+{
+    struct d_tests_sa_text_search_hits* hits;
+
+    hits = (struct d_tests_sa_text_search_hits*)_context;
+
+    if (hits->count < 16)
+    {
+        hits->positions[hits->count] = _position;
+    }
+
+    ++hits->count;
+
+    return true;
+}
+
+
+/*
+d_tests_sa_text_search_find
+  Tests the d_text_search_find and d_text_searcher_find functions.
+  Tests the following:
+  - empty needle matches at the start position
+  - single-byte, short and long needles are found
+  - matches past the first SIMD block are found
+  - embedded NULs in text and needle are ordinary bytes
+  - start position skips earlier matches
+  - needle longer than the text returns -1
+*/
+bool
+d_tests_sa_text_search_find
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_text_searcher searcher;
+    char                   text[200];
+    size_t                 long_len;
+
+    result   = true;
+    long_len = sizeof(d_tests_sa_text_search_long_needle) - 1;
+
+    // test 1: empty needle
+    result = d_assert_standalone(
+        d_text_search_find("abc", 3, "", 0) == 0,
+        "find_empty_needle",
+        "Empty needle should match at 0",
+        _counter) && result;
+
+    // test 2: single byte
+    result = d_assert_standalone(
+        d_text_search_find("hello", 5, "l", 1) == 2,
+        "find_single_byte",
+        "'l' should be found at 2",
+        _counter) && result;
+
+    // test 3: short needle beyond the first 32-position block
+    result = d_assert_standalone(
+        d_text_search_find("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab"
+                           "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+                           80,
+                           "aab",
+                           3) == 38,
+        "find_short_late",
+        "'aab' should be found at 38",
+        _counter) && result;
+
+    // test 4: embedded NUL in text and needle
+    result = d_assert_standalone(
+        d_text_search_find("ab\0cd\0ef", 8, "\0ef", 3) == 5,
+        "find_embedded_nul",
+        "Needle with NUL should be found at 5",
+        _counter) && result;
+
+    // test 5: long needle (Horspool)
+    memset(text, '.', sizeof(text));
+    memcpy(text + 120, d_tests_sa_text_search_long_needle, long_len);
+
+    result = d_assert_standalone(
+        d_text_search_find(text,
+                           sizeof(text),
+                           d_tests_sa_text_search_long_needle,
+                           long_len) == 120,
+        "find_long_needle",
+        "Long needle should be found at 120",
+        _counter) && result;
+
+    // test 6: start position
+    d_text_searcher_init(&searcher, "abc", 3);
+
+    result = d_assert_standalone(
+        d_text_searcher_find(&searcher, "abc-abc-abc", 11, 1) == 4,
+        "find_from_start",
+        "Search from 1 should find 'abc' at 4",
+        _counter) && result;
+
+    // test 7: needle longer than text
+    result = d_assert_standalone(
+        d_text_search_find("ab", 2, "abc", 3) == -1,
+        "find_needle_too_long",
+        "Needle longer than text should return -1",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_search_find_last
+  Tests the d_text_search_find_last function.
+  Tests the following:
+  - empty needle matches at the end of the text
+  - last of several matches is returned for every needle size
+  - overlapping candidates resolve to the last start
+  - missing needle returns -1
+*/
+bool
+d_tests_sa_text_search_find_last
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    char   text[300];
+    size_t long_len;
+
+    result   = true;
+    long_len = sizeof(d_tests_sa_text_search_long_needle) - 1;
+
+    // test 1: empty needle
+    result = d_assert_standalone(
+        d_text_search_find_last("abc", 3, "", 0) == 3,
+        "find_last_empty_needle",
+        "Empty needle should match at the end",
+        _counter) && result;
+
+    // test 2: single byte
+    result = d_assert_standalone(
+        d_text_search_find_last("abcabcabcabcabcabcabc", 21, "a", 1) == 18,
+        "find_last_single_byte",
+        "Last 'a' should be at 18",
+        _counter) && result;
+
+    // test 3: short needle
+    result = d_assert_standalone(
+        d_text_search_find_last("foo bar baz foo", 15, "foo", 3) == 12,
+        "find_last_short",
+        "Last 'foo' should be at 12",
+        _counter) && result;
+
+    // test 4: overlapping candidates
+    result = d_assert_standalone(
+        d_text_search_find_last("aaaa", 4, "aa", 2) == 2,
+        "find_last_overlap",
+        "Last 'aa' in 'aaaa' should start at 2",
+        _counter) && result;
+
+    // test 5: long needle, two copies
+    memset(text, '.', sizeof(text));
+    memcpy(text + 10, d_tests_sa_text_search_long_needle, long_len);
+    memcpy(text + 200, d_tests_sa_text_search_long_needle, long_len);
+
+    result = d_assert_standalone(
+        d_text_search_find_last(text,
+                                sizeof(text),
+                                d_tests_sa_text_search_long_needle,
+                                long_len) == 200,
+        "find_last_long",
+        "Last long needle should be at 200",
+        _counter) && result;
+
+    // test 6: not found
+    result = d_assert_standalone(
+        d_text_search_find_last("abcdef", 6, "xyz", 3) == -1,
+        "find_last_not_found",
+        "Missing needle should return -1",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_search_count
+  Tests the d_text_search_count function.
+  Tests the following:
+  - empty needle counts 0
+  - matches are counted without overlap
+  - matches across a NUL are counted
+*/
+bool
+d_tests_sa_text_search_count
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // test 1: empty needle
+    result = d_assert_standalone(
+        d_text_search_count("abc", 3, "", 0) == 0,
+        "count_empty_needle",
+        "Empty needle should count 0",
+        _counter) && result;
+
+    // test 2: non-overlapping
+    result = d_assert_standalone(
+        d_text_search_count("aaaaa", 5, "aa", 2) == 2,
+        "count_non_overlapping",
+        "'aa' in 'aaaaa' should count 2",
+        _counter) && result;
+
+    // test 3: embedded NUL
+    result = d_assert_standalone(
+        d_text_search_count("ab\0ab\0ab", 8, "ab", 2) == 3,
+        "count_embedded_nul",
+        "'ab' should count 3 across NULs",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_search_segments
+  Tests the d_text_searcher_scan_segments and
+d_text_searcher_find_last_segments functions.
+  Tests the following:
+  - a match inside one segment is reported at its global position
+  - a match straddling two segments is found
+  - a match spanning several tiny and empty segments is found
+  - start position and early stop are honoured
+  - reverse search prefers a later straddling match
+*/
+bool
+d_tests_sa_text_search_segments
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                               result;
+    struct d_text_searcher             searcher;
+    struct d_tests_sa_text_search_hits hits;
+    struct d_text_segment              segments[5];
+
+    result = true;
+
+    // "hello wo" | "rld, hel" | "" | "l" | "o"
+    segments[0].data = "hello wo";  segments[0].length = 8;
+    segments[1].data = "rld, hel";  segments[1].length = 8;
+    segments[2].data = "";          segments[2].length = 0;
+    segments[3].data = "l";         segments[3].length = 1;
+    segments[4].data = "o";         segments[4].length = 1;
+
+    // test 1: straddling match
+    d_text_searcher_init(&searcher, "world", 5);
+    hits.count = 0;
+
+    d_text_searcher_scan_segments(&searcher,
+                                  segments,
+                                  5,
+                                  0,
+                                  d_tests_sa_text_search_collect,
+                                  &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 1) && (hits.positions[0] == 6),
+        "segments_straddle",
+        "'world' should be found once at 6",
+        _counter) && result;
+
+    // test 2: inside a segment and across several tiny segments
+    d_text_searcher_init(&searcher, "hello", 5);
+    hits.count = 0;
+
+    d_text_searcher_scan_segments(&searcher,
+                                  segments,
+                                  5,
+                                  0,
+                                  d_tests_sa_text_search_collect,
+                                  &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 2) &&
+        (hits.positions[0] == 0) &&
+        (hits.positions[1] == 13),
+        "segments_many",
+        "'hello' should be found at 0 and 13",
+        _counter) && result;
+
+    // test 3: start position skips the first match
+    hits.count = 0;
+
+    d_text_searcher_scan_segments(&searcher,
+                                  segments,
+                                  5,
+                                  1,
+                                  d_tests_sa_text_search_collect,
+                                  &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 1) && (hits.positions[0] == 13),
+        "segments_start",
+        "Search from 1 should only find 'hello' at 13",
+        _counter) && result;
+
+    // test 4: reverse search finds the straddling match
+    result = d_assert_standalone(
+        d_text_searcher_find_last_segments(&searcher, segments, 5) == 13,
+        "segments_find_last",
+        "Last 'hello' should be at 13",
+        _counter) && result;
+
+    // test 5: reverse search inside the first segment
+    d_text_searcher_init(&searcher, "lo w", 4);
+
+    result = d_assert_standalone(
+        d_text_searcher_find_last_segments(&searcher, segments, 5) == 3,
+        "segments_find_last_first",
+        "Last 'lo w' should be at 3",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_search_edge_needles
+  Tests empty and one-byte needles on flat and segmented text.
+  Tests the following:
+  - an empty needle matches at any start up to the end, but not past it
+  - an empty needle is found in empty text and reported by no scan
+  - one-byte needles are found at the first and last byte, and past the
+    first SIMD block
+  - one-byte needles are found in every segment, skipping empty ones
+  - reverse one-byte search falls back to an earlier segment
+*/
+bool
+d_tests_sa_text_search_edge_needles
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                               result;
+    struct d_text_searcher             searcher;
+    struct d_tests_sa_text_search_hits hits;
+    struct d_text_segment              segments[4];
+    char                               text[100];
+
+    result = true;
+
+    // test 1: empty needle against start positions
+    d_text_searcher_init(&searcher, "", 0);
+
+    result = d_assert_standalone(
+        (d_text_searcher_find(&searcher, "abc", 3, 2) == 2) &&
+        (d_text_searcher_find(&searcher, "abc", 3, 3) == 3) &&
+        (d_text_searcher_find(&searcher, "abc", 3, 4) == -1),
+        "edge_empty_start",
+        "Empty needle should match at any start up to the end",
+        _counter) && result;
+
+    // test 2: empty needle in empty text
+    result = d_assert_standalone(
+        (d_text_search_find("", 0, "", 0) == 0) &&
+        (d_text_search_find_last("", 0, "", 0) == 0) &&
+        (d_text_search_count("", 0, "", 0) == 0),
+        "edge_empty_empty",
+        "Empty needle should match empty text at 0 and count 0",
+        _counter) && result;
+
+    // "ab" | "" | "cab" | "b"
+    segments[0].data = "ab";   segments[0].length = 2;
+    segments[1].data = "";     segments[1].length = 0;
+    segments[2].data = "cab";  segments[2].length = 3;
+    segments[3].data = "b";    segments[3].length = 1;
+
+    // test 3: empty needle over segments
+    hits.count = 0;
+
+    d_text_searcher_scan_segments(&searcher,
+                                  segments,
+                                  4,
+                                  0,
+                                  d_tests_sa_text_search_collect,
+                                  &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 0) &&
+        (d_text_searcher_find_last_segments(&searcher, segments, 4) == 6),
+        "edge_empty_segments",
+        "Empty needle should report no scan hits and match last at the end",
+        _counter) && result;
+
+    // test 4: one-byte needle at both ends and past the first block
+    memset(text, '.', sizeof(text));
+    text[0]  = 'x';
+    text[70] = 'x';
+    text[99] = 'x';
+
+    result = d_assert_standalone(
+        (d_text_search_find(text, sizeof(text), "x", 1) == 0) &&
+        (d_text_search_find(text + 1, sizeof(text) - 1, "x", 1) == 69) &&
+        (d_text_search_find_last(text, sizeof(text), "x", 1) == 99) &&
+        (d_text_search_find_last(text, 99, "x", 1) == 70) &&
+        (d_text_search_count(text, sizeof(text), "x", 1) == 3) &&
+        (d_text_search_find("", 0, "x", 1) == -1),
+        "edge_one_byte_flat",
+        "One-byte needle should be found at 0, 70 and 99",
+        _counter) && result;
+
+    // test 5: one-byte needle in every non-empty segment
+    d_text_searcher_init(&searcher, "b", 1);
+    hits.count = 0;
+
+    d_text_searcher_scan_segments(&searcher,
+                                  segments,
+                                  4,
+                                  0,
+                                  d_tests_sa_text_search_collect,
+                                  &hits);
+
+    result = d_assert_standalone(
+        (hits.count == 3) &&
+        (hits.positions[0] == 1) &&
+        (hits.positions[1] == 4) &&
+        (hits.positions[2] == 5) &&
+        (d_text_searcher_find_last_segments(&searcher, segments, 4) == 5),
+        "edge_one_byte_segments",
+        "'b' should be found at 1, 4 and 5",
+        _counter) && result;
+
+    // test 6: reverse search that only matches in the first segment
+    d_text_searcher_init(&searcher, "a", 1);
+    segments[2].data = "cdb";
+
+    result = d_assert_standalone(
+        d_text_searcher_find_last_segments(&searcher, segments, 4) == 0,
+        "edge_one_byte_find_last",
+        "Last 'a' should be at 0",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_text_search_matches_naive
+  Compares find, find_last, count and the segmented scan against a naive
+search over pseudo-random texts and needles (small alphabets, so matches
+and near-misses are frequent) of lengths crossing every strategy threshold.
+*/
+bool
+d_tests_sa_text_search_matches_naive
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_text_searcher             searcher;
+    struct d_tests_sa_text_search_hits hits;
+    struct d_text_segment              segments[8];
+    char                               text[256];
+    char                               needle[64];
+    uint64_t                           state;
+    ssize_t                            expect_first;
+    ssize_t                            expect_last;
+    size_t                             expect_count;
+    size_t                             text_len;
+    size_t                             needle_len;
+    size_t                             i;
+    size_t                             j;
+    size_t                             cut;
+    int                                round;
+    bool                               agree;
+
+    agree = true;
+    state = 0x9E3779B97F4A7C15ULL;
+
+    for (round = 0; (round < 3000) && agree; ++round)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        text_len   = (size_t)(state % sizeof(text));
+        needle_len = 1 + (size_t)((state >> 16) % (sizeof(needle) - 1));
+
+        for (i = 0; i < text_len; ++i)
+        {
+            text[i] = (char)('a' + ((state >> (i % 48)) ^ i) % 2);
+        }
+
+        // take the needle from the text half the time
+        for (i = 0; i < needle_len; ++i)
+        {
+            needle[i] = ( (round % 2) && (needle_len <= text_len) )
+                ? text[(size_t)(state >> 24) % (text_len - needle_len + 1) + i]
+                : (char)('a' + ((state >> (i % 40)) & 1));
+        }
+
+        // naive reference
+        expect_first = -1;
+        expect_last  = -1;
+        expect_count = 0;
+
+        for (i = 0; i + needle_len <= text_len; ++i)
+        {
+            if (memcmp(text + i, needle, needle_len) == 0)
+            {
+                if (expect_first < 0)
+                {
+                    expect_first = (ssize_t)i;
+                }
+
+                expect_last = (ssize_t)i;
+            }
+        }
+
+        for (i = 0; i + needle_len <= text_len; )
+        {
+            if (memcmp(text + i, needle, needle_len) == 0)
+            {
+                ++expect_count;
+                i += needle_len;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        d_text_searcher_init(&searcher, needle, needle_len);
+
+        agree = (d_text_searcher_find(&searcher, text, text_len, 0) == expect_first) &&
+                (d_text_searcher_find_last(&searcher, text, text_len) == expect_last) &&
+                (d_text_searcher_count(&searcher, text, text_len) == expect_count);
+
+        // the same text cut into 8 uneven segments
+        for (j = 0, i = 0; j < 8; ++j)
+        {
+            cut = (j == 7) ? (text_len - i)
+                           : (size_t)((state >> (j * 5)) % 9) % (text_len - i + 1);
+
+            segments[j].data   = text + i;
+            segments[j].length = cut;
+            i                 += cut;
+        }
+
+        hits.count = 0;
+
+        d_text_searcher_scan_segments(&searcher,
+                                      segments,
+                                      8,
+                                      0,
+                                      d_tests_sa_text_search_collect,
+                                      &hits);
+
+        agree = agree &&
+                (hits.count == expect_count) &&
+                ( (expect_count == 0) ||
+                  ((ssize_t)hits.positions[0] == expect_first) ) &&
+                (d_text_searcher_find_last_segments(&searcher, segments, 8) ==
+                 expect_last);
+    }
+
+    return d_assert_standalone(
+        agree,
+        "matches_naive",
+        "Searcher results should match a naive search",
+        _counter);
+}
+
+
+/*
+d_tests_sa_text_search_run_all
+  Module-level aggregation function that runs all text_search tests.
+*/
+bool
+d_tests_sa_text_search_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Text Search\n");
+    printf("  ---------------------\n");
+
+    result = d_tests_sa_text_search_find(_counter) && result;
+    result = d_tests_sa_text_search_find_last(_counter) && result;
+    result = d_tests_sa_text_search_count(_counter) && result;
+    result = d_tests_sa_text_search_segments(_counter) && result;
+    result = d_tests_sa_text_search_edge_needles(_counter) && result;
+    result = d_tests_sa_text_search_matches_naive(_counter) && result;
+
+    return result;
+}
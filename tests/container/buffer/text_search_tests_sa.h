@@ -0,0 +1,40 @@
+/******************************************************************************
+* djinterp [test]                                       text_search_tests_sa.h
+*
+*   Unit test declarations for `text_search.h` module.
+*   Covers every search strategy (single byte, SIMD-filtered short needles,
+* Horspool long needles) forward and in reverse, non-overlapping counts,
+* segmented text with matches straddling segment boundaries, empty and
+* one-byte needles, and a randomized comparison against a naive search.
+*
+*
+* path:      \tests\container\buffer\text_search_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_TEXT_SEARCH_SA_
+#define DJINTERP_TESTS_TEXT_SEARCH_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\buffer\text_search.h"
+
+
+// search function tests
+bool d_tests_sa_text_search_find(struct d_test_counter* _counter);
+bool d_tests_sa_text_search_find_last(struct d_test_counter* _counter);
+bool d_tests_sa_text_search_count(struct d_test_counter* _counter);
+bool d_tests_sa_text_search_segments(struct d_test_counter* _counter);
+bool d_tests_sa_text_search_edge_needles(struct d_test_counter* _counter);
+bool d_tests_sa_text_search_matches_naive(struct d_test_counter* _counter);
+
+
+// module-level aggregation
+bool d_tests_sa_text_search_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_TEXT_SEARCH_SA_
@@ -0,0 +1,45 @@
+/******************************************************************************
+* djinterp [test]                                               map_tests_sa.c
+*
+*   Master test runner for map module.
+*   Coordinates execution of all test categories.
+*
+*
+* path:      \test\container\map\map_tests_sa.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+#include ".\map_tests_sa.h"
+
+
+/*
+d_tests_map_run_all
+  Master test runner for all map tests.
+  Tests the following:
+  - Core map operations (new, put, get, typed keys, remove)
+  - Advanced operations (growth, reserve, merge, iteration, free_deep)
+*/
+struct d_test_object*
+d_tests_map_run_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    // create master test group
+    group = d_test_object_new_interior("map Module Tests", 2);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    // add all test categories
+    idx = 0;
+    group->elements[idx++] = d_tests_map_core_all();
+    group->elements[idx++] = d_tests_map_advanced_all();
+
+    return group;
+}
@@ -0,0 +1,98 @@
+/******************************************************************************
+* djinterp [test]                                               map_tests_sa.h
+*
+*   Unit tests for the map module (open-addressing hash map).
+*   Tests cover creation, the generic and typed insert/lookup/remove paths,
+* incremental growth, merging, iteration and destruction.
+*
+*
+* path:      \test\container\map\map_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_MAP_TESTS_STANDALONE_
+#define DJINTERP_MAP_TESTS_STANDALONE_ 1
+
+#include "..\..\..\inc\djinterp.h"
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\map\map.h"
+
+
+/******************************************************************************
+ * TEST CONFIGURATION
+ *****************************************************************************/
+
+// D_TEST_MAP_MEDIUM_SIZE
+//   constant: entries for standard tests (forces several growths).
+#define D_TEST_MAP_MEDIUM_SIZE      200
+
+// D_TEST_MAP_STRESS_SIZE
+//   constant: entries for stress tests.
+#define D_TEST_MAP_STRESS_SIZE      5000
+
+
+/******************************************************************************
+ * TEST UTILITY FUNCTIONS
+ *****************************************************************************/
+
+// d_test_map_constant_hash
+//   function: hash that sends every key to the same slot, so every entry
+// collides.
+size_t d_test_map_constant_hash(const void* _key);
+
+// d_test_map_int_hash
+//   function: hash of the int `_key` points at.
+size_t d_test_map_int_hash(const void* _key);
+
+// d_test_map_int_compare
+//   function: compares the ints `_a` and `_b` point at.
+int d_test_map_int_compare(const void* _a, const void* _b);
+
+
+/******************************************************************************
+ * CORE OPERATION TESTS
+ *****************************************************************************/
+
+// creation tests
+struct d_test_object* d_tests_map_new(void);
+
+// insertion and retrieval tests
+struct d_test_object* d_tests_map_put_get(void);
+struct d_test_object* d_tests_map_typed_keys(void);
+
+// removal tests
+struct d_test_object* d_tests_map_remove(void);
+
+// core operations aggregator
+struct d_test_object* d_tests_map_core_all(void);
+
+
+/******************************************************************************
+ * ADVANCED OPERATION TESTS
+ *****************************************************************************/
+
+// growth tests
+struct d_test_object* d_tests_map_growth(void);
+struct d_test_object* d_tests_map_reserve(void);
+
+// merge operation tests
+struct d_test_object* d_tests_map_merge(void);
+
+// iteration and destruction tests
+struct d_test_object* d_tests_map_next(void);
+struct d_test_object* d_tests_map_free_deep(void);
+
+// advanced operations aggregator
+struct d_test_object* d_tests_map_advanced_all(void);
+
+
+/******************************************************************************
+ * MASTER TEST RUNNER
+ *****************************************************************************/
+
+// master test runner for all map tests
+struct d_test_object* d_tests_map_run_all(void);
+
+
+#endif  // DJINTERP_MAP_TESTS_STANDALONE_
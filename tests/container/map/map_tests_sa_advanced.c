@@ -0,0 +1,659 @@
+/******************************************************************************
+* djinterp [test]                                      map_tests_sa_advanced.c
+*
+*   Advanced operation tests for map module.
+*   Tests incremental growth, reserve, merging, iteration and destruction.
+*
+*
+* path:      \test\container\map\map_tests_sa_advanced.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\map_tests_sa.h"
+
+
+/******************************************************************************
+ * GROWTH TESTS
+ *****************************************************************************/
+
+/*
+d_tests_map_growth
+  Tests incremental growth.
+  Tests the following:
+  - crossing the load limit starts a migration instead of rehashing
+  - every key is found while the migration is in progress
+  - keys still in the old table can be updated and removed
+  - later puts finish the migration and free the old table
+  - a stress run of inserts and removals keeps every key reachable
+*/
+struct d_test_object*
+d_tests_map_growth
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         map;
+    static int            values[D_TEST_MAP_STRESS_SIZE];
+    size_t                old_capacity;
+    size_t                inserted;
+    bool                  test_starts_growing;
+    bool                  test_lookup_mid;
+    bool                  test_modify_old;
+    bool                  test_finishes;
+    bool                  test_stress;
+    int                   pick;
+    int                   i;
+    size_t                idx;
+
+    for (i = 0; i < D_TEST_MAP_STRESS_SIZE; ++i)
+    {
+        values[i] = i;
+    }
+
+    // test 1: crossing the load limit starts a migration
+    map          = d_map_new_int();
+    old_capacity = (map) ? map->table.capacity : 0;
+    inserted     = 0;
+
+    while ( (map)                       &&
+            (!d_map_is_growing(map))    &&
+            (inserted < D_TEST_MAP_STRESS_SIZE) )
+    {
+        d_map_put_int(map, (int)inserted, &values[inserted]);
+        inserted++;
+    }
+
+    test_starts_growing = ( (map != NULL)                              &&
+                            (d_map_is_growing(map))                    &&
+                            (map->table.capacity == old_capacity * 2)  &&
+                            (map->old.count > 0)                       &&
+                            (d_map_count(map) == inserted) );
+
+    // test 2: lookups during the migration
+    test_lookup_mid = (map != NULL);
+
+    for (i = 0; (size_t)i < inserted; ++i)
+    {
+        test_lookup_mid = test_lookup_mid &&
+                          (d_map_get_int(map, i) == &values[i]);
+    }
+
+    // test 3: update and remove a key that has not migrated yet (the
+    // migration sweeps upward, so the old table's last slots go last)
+    test_modify_old = false;
+    pick            = -1;
+
+    for (idx = (map) ? map->old.capacity : 0; idx > 0; --idx)
+    {
+        if ((map->old.ctrl[idx - 1] & 0x80u) != 0)
+        {
+            pick = (int)(int64_t)map->old.slots[idx - 1].key.u64;
+
+            break;
+        }
+    }
+
+    if (pick >= 0)
+    {
+        test_modify_old = ( (d_map_put_int(map, pick, &values[1]))   &&
+                            (d_map_get_int(map, pick) == &values[1]) &&
+                            (d_map_remove_int(map, pick, NULL))      &&
+                            (!d_map_contains_int(map, pick))         &&
+                            (d_map_count(map) == inserted - 1) );
+        d_map_put_int(map, pick, &values[pick]);
+    }
+
+    // test 4: further puts finish the migration
+    while ( (map)                     &&
+            (d_map_is_growing(map))   &&
+            (inserted < D_TEST_MAP_STRESS_SIZE) )
+    {
+        d_map_put_int(map, (int)inserted, &values[inserted]);
+        inserted++;
+    }
+
+    test_finishes = ( (map != NULL)               &&
+                      (!d_map_is_growing(map))    &&
+                      (map->old.slots == NULL)    &&
+                      (d_map_count(map) == inserted) );
+
+    for (i = 0; (map) && ((size_t)i < inserted); ++i)
+    {
+        test_finishes = test_finishes &&
+                        (d_map_get_int(map, i) == &values[i]);
+    }
+
+    d_map_free(map);
+
+    // test 5: stress inserts and removals
+    map         = d_map_new_uint64();
+    test_stress = (map != NULL);
+
+    for (i = 0; (map) && (i < D_TEST_MAP_STRESS_SIZE); ++i)
+    {
+        test_stress = test_stress &&
+                      d_map_put_uint64(map, (uint64_t)i * 0x9E3779B9ULL, &values[i]);
+
+        // remove every third key shortly after inserting it
+        if ( (i >= 2) &&
+             ((i % 3) == 2) )
+        {
+            test_stress = test_stress &&
+                          d_map_remove_uint64(map, (uint64_t)(i - 2) * 0x9E3779B9ULL, NULL);
+        }
+    }
+
+    for (i = 0; (map) && (i < D_TEST_MAP_STRESS_SIZE); ++i)
+    {
+        if ( ((i % 3) == 0) &&
+             (i + 2 < D_TEST_MAP_STRESS_SIZE) )
+        {
+            test_stress = test_stress &&
+                          !d_map_contains_uint64(map, (uint64_t)i * 0x9E3779B9ULL);
+        }
+        else
+        {
+            test_stress = test_stress &&
+                          (d_map_get_uint64(map, (uint64_t)i * 0x9E3779B9ULL) == &values[i]);
+        }
+    }
+
+    d_map_free(map);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_growth", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("starts_growing",
+                                           test_starts_growing,
+                                           "load limit starts a migration");
+    group->elements[idx++] = D_ASSERT_TRUE("lookup_mid",
+                                           test_lookup_mid,
+                                           "keys found during migration");
+    group->elements[idx++] = D_ASSERT_TRUE("modify_old",
+                                           test_modify_old,
+                                           "unmigrated keys updated and removed");
+    group->elements[idx++] = D_ASSERT_TRUE("finishes",
+                                           test_finishes,
+                                           "puts finish the migration");
+    group->elements[idx++] = D_ASSERT_TRUE("stress",
+                                           test_stress,
+                                           "stress run keeps keys reachable");
+
+    return group;
+}
+
+/*
+d_tests_map_reserve
+  Tests d_map_reserve.
+  Tests the following:
+  - reserving grows the table at once, without a migration
+  - reserved entries are inserted without growing
+  - reserving during a migration finishes it
+  - d_map_clear empties the map and keeps its capacity
+*/
+struct d_test_object*
+d_tests_map_reserve
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         map;
+    int                   values[D_TEST_MAP_MEDIUM_SIZE];
+    size_t                capacity;
+    bool                  test_immediate;
+    bool                  test_no_growth;
+    bool                  test_finishes_migration;
+    bool                  test_clear;
+    int                   i;
+    size_t                idx;
+
+    for (i = 0; i < D_TEST_MAP_MEDIUM_SIZE; ++i)
+    {
+        values[i] = i;
+    }
+
+    // test 1: immediate resize
+    map = d_map_new_int();
+    d_map_put_int(map, -1, &values[0]);
+    test_immediate = ( (d_map_reserve(map, D_TEST_MAP_MEDIUM_SIZE)) &&
+                       (!d_map_is_growing(map))                     &&
+                       (map->table.capacity >= 256)                 &&
+                       (d_map_get_int(map, -1) == &values[0]) );
+
+    // test 2: no growth while filling the reservation
+    capacity       = (map) ? map->table.capacity : 0;
+    test_no_growth = (map != NULL);
+
+    for (i = 1; (map) && (i < D_TEST_MAP_MEDIUM_SIZE); ++i)
+    {
+        test_no_growth = test_no_growth &&
+                         d_map_put_int(map, i, &values[i]) &&
+                         (!d_map_is_growing(map));
+    }
+
+    test_no_growth = test_no_growth &&
+                     (map->table.capacity == capacity);
+
+    d_map_free(map);
+
+    // test 3: reserve ends a migration in progress
+    map = d_map_new_int();
+
+    for (i = 0; (map) && (!d_map_is_growing(map)); ++i)
+    {
+        d_map_put_int(map, i, &values[i]);
+    }
+
+    test_finishes_migration = ( (d_map_reserve(map, 1))      &&
+                                (!d_map_is_growing(map))     &&
+                                (d_map_count(map) == (size_t)i) &&
+                                (d_map_get_int(map, i - 1) == &values[i - 1]) );
+
+    // test 4: clear
+    capacity = (map) ? map->table.capacity : 0;
+    d_map_clear(map);
+    test_clear = ( (map != NULL)                        &&
+                   (d_map_count(map) == 0)              &&
+                   (map->table.capacity == capacity)    &&
+                   (!d_map_contains_int(map, 0))        &&
+                   (d_map_put_int(map, 0, &values[0]))  &&
+                   (d_map_count(map) == 1) );
+
+    d_map_free(map);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_reserve", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("immediate",
+                                           test_immediate,
+                                           "reserve resizes at once");
+    group->elements[idx++] = D_ASSERT_TRUE("no_growth",
+                                           test_no_growth,
+                                           "reserved entries fit");
+    group->elements[idx++] = D_ASSERT_TRUE("finishes_migration",
+                                           test_finishes_migration,
+                                           "reserve finishes a migration");
+    group->elements[idx++] = D_ASSERT_TRUE("clear",
+                                           test_clear,
+                                           "clear empties and keeps capacity");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * MERGE TESTS
+ *****************************************************************************/
+
+/*
+d_tests_map_merge
+  Tests d_map_merge.
+  Tests the following:
+  - maps of different key types are rejected
+  - IGNORE keeps the destination's values on conflict
+  - OVERWRITE takes the source's values on conflict
+  - KEEP_BOTH fails on conflict and leaves the destination unchanged
+  - KEEP_BOTH succeeds when no key conflicts
+*/
+struct d_test_object*
+d_tests_map_merge
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         dst;
+    struct d_map*         src;
+    struct d_map*         disjoint;
+    struct d_map*         strings;
+    int                   values[8];
+    bool                  test_type_mismatch;
+    bool                  test_ignore;
+    bool                  test_overwrite;
+    bool                  test_keep_both_conflict;
+    bool                  test_keep_both_disjoint;
+    int                   i;
+    size_t                idx;
+
+    for (i = 0; i < 8; ++i)
+    {
+        values[i] = i;
+    }
+
+    dst      = d_map_new_int();
+    src      = d_map_new_int();
+    disjoint = d_map_new_int();
+    strings  = d_map_new_string();
+
+    // dst: 1 -> v1, 2 -> v2 ; src: 2 -> v5, 3 -> v6 ; disjoint: 4 -> v7
+    d_map_put_int(dst, 1, &values[1]);
+    d_map_put_int(dst, 2, &values[2]);
+    d_map_put_int(src, 2, &values[5]);
+    d_map_put_int(src, 3, &values[6]);
+    d_map_put_int(disjoint, 4, &values[7]);
+    d_map_put(strings, "x", &values[0]);
+
+    // test 1: key type mismatch
+    test_type_mismatch = ( (!d_map_merge(dst, strings, D_MERGE_CONFLICT_FLAG_OVERWRITE)) &&
+                           (d_map_merge(dst, NULL, D_MERGE_CONFLICT_FLAG_OVERWRITE))     &&
+                           (d_map_count(dst) == 2) );
+
+    // test 2: KEEP_BOTH conflict leaves dst unchanged
+    test_keep_both_conflict = ( (!d_map_merge(dst, src, D_MERGE_CONFLICT_FLAG_KEEP_BOTH)) &&
+                                (d_map_count(dst) == 2)                                 &&
+                                (!d_map_contains_int(dst, 3)) );
+
+    // test 3: IGNORE
+    test_ignore = ( (d_map_merge(dst, src, D_MERGE_CONFLICT_FLAG_IGNORE)) &&
+                    (d_map_count(dst) == 3)                              &&
+                    (d_map_get_int(dst, 2) == &values[2])                &&
+                    (d_map_get_int(dst, 3) == &values[6])                &&
+                    (d_map_count(src) == 2) );
+
+    // test 4: OVERWRITE
+    test_overwrite = ( (d_map_merge(dst, src, D_MERGE_CONFLICT_FLAG_OVERWRITE)) &&
+                       (d_map_count(dst) == 3)                                 &&
+                       (d_map_get_int(dst, 1) == &values[1])                   &&
+                       (d_map_get_int(dst, 2) == &values[5]) );
+
+    // test 5: KEEP_BOTH without conflicts
+    test_keep_both_disjoint = ( (d_map_merge(dst, disjoint, D_MERGE_CONFLICT_FLAG_KEEP_BOTH)) &&
+                                (d_map_count(dst) == 4)                                     &&
+                                (d_map_get_int(dst, 4) == &values[7]) );
+
+    // cleanup
+    d_map_free(dst);
+    d_map_free(src);
+    d_map_free(disjoint);
+    d_map_free(strings);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_merge", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("type_mismatch",
+                                           test_type_mismatch,
+                                           "different key types rejected");
+    group->elements[idx++] = D_ASSERT_TRUE("keep_both_conflict",
+                                           test_keep_both_conflict,
+                                           "KEEP_BOTH conflict fails cleanly");
+    group->elements[idx++] = D_ASSERT_TRUE("ignore",
+                                           test_ignore,
+                                           "IGNORE keeps destination values");
+    group->elements[idx++] = D_ASSERT_TRUE("overwrite",
+                                           test_overwrite,
+                                           "OVERWRITE takes source values");
+    group->elements[idx++] = D_ASSERT_TRUE("keep_both_disjoint",
+                                           test_keep_both_disjoint,
+                                           "KEEP_BOTH merges disjoint maps");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * ITERATION AND DESTRUCTION TESTS
+ *****************************************************************************/
+
+/*
+d_tests_map_next
+  Tests d_map_next.
+  Tests the following:
+  - an empty map yields nothing
+  - every entry is visited exactly once, including during a migration
+  - keys and values are reported together
+*/
+struct d_test_object*
+d_tests_map_next
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         map;
+    int                   values[D_TEST_MAP_MEDIUM_SIZE];
+    int                   seen[D_TEST_MAP_MEDIUM_SIZE];
+    union d_map_key       key;
+    void*                 value;
+    size_t                cursor;
+    size_t                visited;
+    bool                  test_empty;
+    bool                  test_each_once;
+    bool                  test_pairs;
+    int                   i;
+    size_t                idx;
+
+    for (i = 0; i < D_TEST_MAP_MEDIUM_SIZE; ++i)
+    {
+        values[i] = i;
+        seen[i]   = 0;
+    }
+
+    // test 1: empty map
+    map        = d_map_new_int();
+    cursor     = 0;
+    test_empty = (!d_map_next(map, &cursor, &key, &value));
+
+    // fill until the map is mid-migration
+    for (i = 0; (map) && (i < D_TEST_MAP_MEDIUM_SIZE); ++i)
+    {
+        d_map_put_int(map, i, &values[i]);
+
+        if ( (i > 20) &&
+             (d_map_is_growing(map)) )
+        {
+            i++;
+            break;
+        }
+    }
+
+    // test 2 & 3: each entry once, with its value
+    test_pairs = true;
+    cursor     = 0;
+    visited    = 0;
+
+    while (d_map_next(map, &cursor, &key, &value))
+    {
+        visited++;
+
+        if ((int64_t)key.u64 < (int64_t)D_TEST_MAP_MEDIUM_SIZE)
+        {
+            seen[key.u64]++;
+            test_pairs = test_pairs &&
+                         (value == &values[key.u64]);
+        }
+    }
+
+    test_each_once = ( (map != NULL) &&
+                       (visited == d_map_count(map)) );
+
+    while (i-- > 0)
+    {
+        test_each_once = test_each_once &&
+                         (seen[i] == 1);
+    }
+
+    d_map_free(map);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_next", 3);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("empty",
+                                           test_empty,
+                                           "empty map yields nothing");
+    group->elements[idx++] = D_ASSERT_TRUE("each_once",
+                                           test_each_once,
+                                           "every entry visited once");
+    group->elements[idx++] = D_ASSERT_TRUE("pairs",
+                                           test_pairs,
+                                           "keys and values reported together");
+
+    return group;
+}
+
+/*
+d_tests_map_free_deep
+  Tests d_map_free and d_map_free_deep.
+  Tests the following:
+  - NULL map is handled
+  - string keys and values are freed (checked under a leak detector)
+  - integer keys are not passed to the key free function
+*/
+struct d_test_object*
+d_tests_map_free_deep
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         strings;
+    struct d_map*         ints;
+    char*                 key;
+    int*                  value;
+    bool                  test_null;
+    bool                  test_owned;
+    bool                  test_int_keys;
+    int                   i;
+    size_t                idx;
+
+    // test 1: NULL map
+    d_map_free(NULL);
+    d_map_free_deep(NULL, free, free);
+    test_null = true;
+
+    // test 2: owned string keys and values
+    strings    = d_map_new_string();
+    test_owned = (strings != NULL);
+
+    for (i = 0; (strings) && (i < 40); ++i)
+    {
+        key   = malloc(8);
+        value = malloc(sizeof(int));
+
+        if ( (!key) ||
+             (!value) )
+        {
+            free(key);
+            free(value);
+            test_owned = false;
+
+            break;
+        }
+
+        key[0] = 'k';
+        key[1] = (char)('0' + (i / 10));
+        key[2] = (char)('0' + (i % 10));
+        key[3] = '\0';
+        *value = i;
+
+        test_owned = test_owned &&
+                     d_map_put(strings, key, value);
+    }
+
+    test_owned = test_owned &&
+                 (d_map_count(strings) == 40);
+
+    d_map_free_deep(strings, free, free);
+
+    // test 3: integer keys are values, only the values are freed
+    ints          = d_map_new_int();
+    value         = malloc(sizeof(int));
+    test_int_keys = ( (ints != NULL)                   &&
+                      (value != NULL)                  &&
+                      (d_map_put_int(ints, 12345, value)) );
+
+    if (!test_int_keys)
+    {
+        free(value);
+    }
+
+    d_map_free_deep(ints, free, free);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_free_deep", 3);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("null",
+                                           test_null,
+                                           "NULL map handled");
+    group->elements[idx++] = D_ASSERT_TRUE("owned",
+                                           test_owned,
+                                           "string keys and values freed");
+    group->elements[idx++] = D_ASSERT_TRUE("int_keys",
+                                           test_int_keys,
+                                           "integer keys not freed");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * ADVANCED OPERATIONS AGGREGATOR
+ *****************************************************************************/
+
+/*
+d_tests_map_advanced_all
+  Runs all advanced operation tests.
+  Tests the following:
+  - incremental growth
+  - d_map_reserve / d_map_clear
+  - d_map_merge
+  - d_map_next
+  - d_map_free / d_map_free_deep
+*/
+struct d_test_object*
+d_tests_map_advanced_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    group = d_test_object_new_interior("Advanced Map Operations", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = d_tests_map_growth();
+    group->elements[idx++] = d_tests_map_reserve();
+    group->elements[idx++] = d_tests_map_merge();
+    group->elements[idx++] = d_tests_map_next();
+    group->elements[idx++] = d_tests_map_free_deep();
+
+    return group;
+}
@@ -0,0 +1,606 @@
+/******************************************************************************
+* djinterp [test]                                          map_tests_sa_core.c
+*
+*   Core operation tests for map module.
+*   Tests creation, insertion, retrieval, and removal operations.
+*
+*
+* path:      \test\container\map\map_tests_sa_core.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\map_tests_sa.h"
+
+
+/******************************************************************************
+ * HELPER FUNCTIONS
+ *****************************************************************************/
+
+/*
+d_test_map_constant_hash
+  Hash function that maps every key to the same value.
+
+Parameter(s):
+  _key: ignored
+Return:
+  Always 7.
+*/
+size_t
+d_test_map_constant_hash
+(
+    const void* _key
+)
+{
+    (void)_key;
+
+    return 7;
+}
+
+/*
+d_test_map_int_hash
+  Identity hash of an int key.
+
+Parameter(s):
+  _key: pointer to an int
+Return:
+  The int's value.
+*/
+size_t
+d_test_map_int_hash
+(
+    const void* _key
+)
+{
+    return (size_t)*(const int*)_key;
+}
+
+/*
+d_test_map_int_compare
+  Three-way comparison of two int keys.
+
+Parameter(s):
+  _a: pointer to the first int
+  _b: pointer to the second int
+Return:
+  Negative, zero or positive as *_a is less than, equal to or greater than
+  *_b.
+*/
+int
+d_test_map_int_compare
+(
+    const void* _a,
+    const void* _b
+)
+{
+    int a = *(const int*)_a;
+    int b = *(const int*)_b;
+
+    return (a > b) - (a < b);
+}
+
+
+/******************************************************************************
+ * MAP CREATION TESTS
+ *****************************************************************************/
+
+/*
+d_tests_map_new
+  Tests the d_map creation functions.
+  Tests the following:
+  - custom map requires hash and compare functions
+  - custom map allocates with an empty default-sized table
+  - typed constructors set their key type
+  - new_with_capacity sizes the table for the requested entries
+  - new map is not growing
+*/
+struct d_test_object*
+d_tests_map_new
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         custom;
+    struct d_map*         ints;
+    struct d_map*         u64s;
+    struct d_map*         strings;
+    struct d_map*         sized;
+    bool                  test_requires_fns;
+    bool                  test_custom_alloc;
+    bool                  test_key_types;
+    bool                  test_capacity;
+    bool                  test_not_growing;
+    size_t                idx;
+
+    // test 1: custom maps need both functions
+    test_requires_fns =
+        ( (d_map_new(NULL, d_test_map_int_compare) == NULL) &&
+          (d_map_new(d_test_map_int_hash, NULL) == NULL) );
+
+    // test 2: custom map allocates empty
+    custom = d_map_new(d_test_map_int_hash, d_test_map_int_compare);
+    test_custom_alloc = ( (custom != NULL)                                &&
+                          (custom->key_type == D_MAP_KEY_CUSTOM)          &&
+                          (custom->table.capacity == D_MAP_DEFAULT_CAPACITY) &&
+                          (d_map_count(custom) == 0) );
+
+    // test 3: typed constructors
+    ints    = d_map_new_int();
+    u64s    = d_map_new_uint64();
+    strings = d_map_new_string();
+    test_key_types = ( (ints != NULL)                            &&
+                       (u64s != NULL)                            &&
+                       (strings != NULL)                         &&
+                       (ints->key_type == D_MAP_KEY_INT)         &&
+                       (u64s->key_type == D_MAP_KEY_UINT64)      &&
+                       (strings->key_type == D_MAP_KEY_STRING)   &&
+                       (ints->hash_fn == NULL) );
+
+    // test 4: capacity holds the requested entries within the load limit
+    sized = d_map_new_with_capacity(D_MAP_KEY_INT, NULL, NULL, 100);
+    test_capacity = ( (sized != NULL)                  &&
+                      (sized->table.capacity == 128) );
+
+    // test 5: not growing
+    test_not_growing = ( (custom != NULL)             &&
+                         (!d_map_is_growing(custom))  &&
+                         (!d_map_is_growing(NULL)) );
+
+    // cleanup
+    d_map_free(custom);
+    d_map_free(ints);
+    d_map_free(u64s);
+    d_map_free(strings);
+    d_map_free(sized);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_new", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("requires_fns",
+                                           test_requires_fns,
+                                           "custom map requires both functions");
+    group->elements[idx++] = D_ASSERT_TRUE("custom_alloc",
+                                           test_custom_alloc,
+                                           "custom map allocates empty");
+    group->elements[idx++] = D_ASSERT_TRUE("key_types",
+                                           test_key_types,
+                                           "typed constructors set key type");
+    group->elements[idx++] = D_ASSERT_TRUE("capacity",
+                                           test_capacity,
+                                           "capacity fits requested entries");
+    group->elements[idx++] = D_ASSERT_TRUE("not_growing",
+                                           test_not_growing,
+                                           "new map is not growing");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * INSERTION AND RETRIEVAL TESTS
+ *****************************************************************************/
+
+/*
+d_tests_map_put_get
+  Tests d_map_put, d_map_get and d_map_contains through the generic paths.
+  Tests the following:
+  - NULL map or key is rejected
+  - string keys are compared by content
+  - putting an existing key updates it without changing the count
+  - custom keys are found through the user functions
+  - fully colliding keys are all retrievable
+  - missing keys return NULL / false
+*/
+struct d_test_object*
+d_tests_map_put_get
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         strings;
+    struct d_map*         custom;
+    struct d_map*         colliding;
+    char                  lookup[8];
+    int                   keys[D_TEST_MAP_MEDIUM_SIZE];
+    int                   values[D_TEST_MAP_MEDIUM_SIZE];
+    int                   missing;
+    bool                  test_null_args;
+    bool                  test_string_content;
+    bool                  test_update;
+    bool                  test_custom;
+    bool                  test_collisions;
+    bool                  test_missing;
+    size_t                i;
+    size_t                idx;
+
+    for (i = 0; i < D_TEST_MAP_MEDIUM_SIZE; ++i)
+    {
+        keys[i]   = (int)(i * 3);
+        values[i] = (int)i;
+    }
+
+    // test 1: NULL arguments
+    strings = d_map_new_string();
+    test_null_args = ( (!d_map_put(NULL, "a", &values[0]))  &&
+                       (!d_map_put(strings, NULL, &values[0])) &&
+                       (d_map_get(NULL, "a") == NULL)       &&
+                       (!d_map_contains(strings, NULL)) );
+
+    // test 2: string keys by content
+    d_map_put(strings, "alpha", &values[1]);
+    d_map_put(strings, "beta", &values[2]);
+    lookup[0] = 'a'; lookup[1] = 'l'; lookup[2] = 'p';
+    lookup[3] = 'h'; lookup[4] = 'a'; lookup[5] = '\0';
+    test_string_content = ( (d_map_get(strings, lookup) == &values[1]) &&
+                            (d_map_get(strings, "beta") == &values[2]) );
+
+    // test 3: update in place
+    test_update = ( (d_map_put(strings, "alpha", &values[3]))        &&
+                    (d_map_get(strings, "alpha") == &values[3])      &&
+                    (d_map_count(strings) == 2) );
+
+    // test 4: custom keys
+    custom      = d_map_new(d_test_map_int_hash, d_test_map_int_compare);
+    test_custom = (custom != NULL);
+
+    for (i = 0; (custom) && (i < D_TEST_MAP_MEDIUM_SIZE); ++i)
+    {
+        test_custom = test_custom && d_map_put(custom, &keys[i], &values[i]);
+    }
+
+    for (i = 0; (custom) && (i < D_TEST_MAP_MEDIUM_SIZE); ++i)
+    {
+        missing     = (int)(i * 3);
+        test_custom = test_custom &&
+                      (d_map_get(custom, &missing) == &values[i]);
+    }
+
+    test_custom = test_custom &&
+                  (d_map_count(custom) == D_TEST_MAP_MEDIUM_SIZE);
+
+    // test 5: every key collides
+    colliding       = d_map_new(d_test_map_constant_hash, d_test_map_int_compare);
+    test_collisions = (colliding != NULL);
+
+    for (i = 0; (colliding) && (i < 40); ++i)
+    {
+        test_collisions = test_collisions &&
+                          d_map_put(colliding, &keys[i], &values[i]);
+    }
+
+    for (i = 0; (colliding) && (i < 40); ++i)
+    {
+        test_collisions = test_collisions &&
+                          (d_map_get(colliding, &keys[i]) == &values[i]);
+    }
+
+    // test 6: missing keys
+    missing      = 1;
+    test_missing = ( (d_map_get(strings, "gamma") == NULL)  &&
+                     (!d_map_contains(strings, "gamma"))    &&
+                     (d_map_get(custom, &missing) == NULL)  &&
+                     (!d_map_contains(colliding, &missing)) );
+
+    // cleanup
+    d_map_free(strings);
+    d_map_free(custom);
+    d_map_free(colliding);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_put_get", 6);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("null_args",
+                                           test_null_args,
+                                           "NULL map or key rejected");
+    group->elements[idx++] = D_ASSERT_TRUE("string_content",
+                                           test_string_content,
+                                           "string keys compared by content");
+    group->elements[idx++] = D_ASSERT_TRUE("update",
+                                           test_update,
+                                           "existing key updated in place");
+    group->elements[idx++] = D_ASSERT_TRUE("custom",
+                                           test_custom,
+                                           "custom keys use user functions");
+    group->elements[idx++] = D_ASSERT_TRUE("collisions",
+                                           test_collisions,
+                                           "colliding keys all retrievable");
+    group->elements[idx++] = D_ASSERT_TRUE("missing",
+                                           test_missing,
+                                           "missing keys not found");
+
+    return group;
+}
+
+/*
+d_tests_map_typed_keys
+  Tests the int and uint64_t fast paths.
+  Tests the following:
+  - int keys, including negative ones, round-trip
+  - generic and typed int paths see the same entries
+  - uint64_t keys beyond 32 bits round-trip
+  - typed functions reject maps of another key type
+  - NULL values are stored and reported by contains
+*/
+struct d_test_object*
+d_tests_map_typed_keys
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         ints;
+    struct d_map*         u64s;
+    int                   values[D_TEST_MAP_MEDIUM_SIZE];
+    int                   key;
+    uint64_t              wide;
+    bool                  test_int_round_trip;
+    bool                  test_int_generic;
+    bool                  test_uint64;
+    bool                  test_wrong_type;
+    bool                  test_null_value;
+    int                   i;
+    size_t                idx;
+
+    for (i = 0; i < D_TEST_MAP_MEDIUM_SIZE; ++i)
+    {
+        values[i] = i;
+    }
+
+    // test 1: int keys, negative included
+    ints                = d_map_new_int();
+    test_int_round_trip = (ints != NULL);
+
+    for (i = 0; (ints) && (i < D_TEST_MAP_MEDIUM_SIZE); ++i)
+    {
+        test_int_round_trip = test_int_round_trip &&
+            d_map_put_int(ints, i - (D_TEST_MAP_MEDIUM_SIZE / 2), &values[i]);
+    }
+
+    for (i = 0; (ints) && (i < D_TEST_MAP_MEDIUM_SIZE); ++i)
+    {
+        test_int_round_trip = test_int_round_trip &&
+            (d_map_get_int(ints, i - (D_TEST_MAP_MEDIUM_SIZE / 2)) == &values[i]);
+    }
+
+    // test 2: generic path sees typed entries
+    key              = -7;
+    test_int_generic = ( (d_map_get(ints, &key) ==
+                          &values[(D_TEST_MAP_MEDIUM_SIZE / 2) - 7]) &&
+                         (d_map_contains_int(ints, -7))              &&
+                         (!d_map_contains_int(ints, D_TEST_MAP_MEDIUM_SIZE)) );
+
+    // test 3: wide uint64_t keys (differ only above bit 32)
+    u64s        = d_map_new_uint64();
+    wide        = 0x100000000ULL;
+    test_uint64 = ( (d_map_put_uint64(u64s, wide, &values[1]))          &&
+                    (d_map_put_uint64(u64s, wide * 2, &values[2]))      &&
+                    (d_map_put_uint64(u64s, UINT64_MAX, &values[3]))    &&
+                    (d_map_get_uint64(u64s, wide) == &values[1])        &&
+                    (d_map_get_uint64(u64s, wide * 2) == &values[2])    &&
+                    (d_map_get(u64s, &wide) == &values[1])              &&
+                    (d_map_contains_uint64(u64s, UINT64_MAX))           &&
+                    (!d_map_contains_uint64(u64s, 0)) );
+
+    // test 4: wrong key type
+    test_wrong_type = ( (!d_map_put_int(u64s, 1, &values[0]))      &&
+                        (!d_map_put_uint64(ints, 1, &values[0]))   &&
+                        (d_map_get_uint64(ints, 1) == NULL)        &&
+                        (!d_map_remove_int(u64s, 1, NULL)) );
+
+    // test 5: NULL values
+    test_null_value = ( (d_map_put_int(ints, 100000, NULL))    &&
+                        (d_map_contains_int(ints, 100000))     &&
+                        (d_map_get_int(ints, 100000) == NULL) );
+
+    // cleanup
+    d_map_free(ints);
+    d_map_free(u64s);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_typed_keys", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("int_round_trip",
+                                           test_int_round_trip,
+                                           "int keys round-trip");
+    group->elements[idx++] = D_ASSERT_TRUE("int_generic",
+                                           test_int_generic,
+                                           "generic and typed paths agree");
+    group->elements[idx++] = D_ASSERT_TRUE("uint64",
+                                           test_uint64,
+                                           "wide uint64_t keys round-trip");
+    group->elements[idx++] = D_ASSERT_TRUE("wrong_type",
+                                           test_wrong_type,
+                                           "typed calls reject other key types");
+    group->elements[idx++] = D_ASSERT_TRUE("null_value",
+                                           test_null_value,
+                                           "NULL values are stored");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * REMOVAL TESTS
+ *****************************************************************************/
+
+/*
+d_tests_map_remove
+  Tests d_map_remove and its typed variants.
+  Tests the following:
+  - missing keys are not removed
+  - removed value is returned through _out_value
+  - removing from the middle of a collision run keeps the rest reachable
+  - removal leaves no tombstones (table counts return to zero)
+  - removed keys can be inserted again
+*/
+struct d_test_object*
+d_tests_map_remove
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_map*         colliding;
+    struct d_map*         ints;
+    int                   keys[32];
+    int                   values[32];
+    void*                 out;
+    bool                  test_missing;
+    bool                  test_out_value;
+    bool                  test_run_intact;
+    bool                  test_no_tombstones;
+    bool                  test_reinsert;
+    size_t                i;
+    size_t                idx;
+
+    for (i = 0; i < 32; ++i)
+    {
+        keys[i]   = (int)i;
+        values[i] = (int)(i * 10);
+    }
+
+    colliding = d_map_new(d_test_map_constant_hash, d_test_map_int_compare);
+
+    for (i = 0; (colliding) && (i < 12); ++i)
+    {
+        d_map_put(colliding, &keys[i], &values[i]);
+    }
+
+    // test 1: missing key
+    test_missing = ( (!d_map_remove(colliding, &keys[20], NULL)) &&
+                     (!d_map_remove(NULL, &keys[0], NULL))       &&
+                     (d_map_count(colliding) == 12) );
+
+    // test 2: removed value returned
+    out            = NULL;
+    test_out_value = ( (d_map_remove(colliding, &keys[5], &out)) &&
+                       (out == &values[5])                       &&
+                       (!d_map_contains(colliding, &keys[5])) );
+
+    // test 3: rest of the run still reachable
+    test_run_intact = (d_map_count(colliding) == 11);
+
+    for (i = 0; i < 12; ++i)
+    {
+        if (i != 5)
+        {
+            test_run_intact = test_run_intact &&
+                              (d_map_get(colliding, &keys[i]) == &values[i]);
+        }
+    }
+
+    // test 4: emptying leaves every control byte empty
+    for (i = 0; i < 12; ++i)
+    {
+        d_map_remove(colliding, &keys[i], NULL);
+    }
+
+    test_no_tombstones = ( (colliding != NULL) &&
+                           (d_map_count(colliding) == 0) );
+
+    for (i = 0; (colliding) && (i < colliding->table.capacity); ++i)
+    {
+        test_no_tombstones = test_no_tombstones &&
+                             (colliding->table.ctrl[i] == D_MAP_CTRL_EMPTY);
+    }
+
+    // test 5: reinsert after removal (typed path)
+    ints          = d_map_new_int();
+    test_reinsert = ( (d_map_put_int(ints, 3, &values[3]))         &&
+                      (d_map_remove_int(ints, 3, &out))            &&
+                      (out == &values[3])                          &&
+                      (!d_map_contains_int(ints, 3))               &&
+                      (d_map_put_int(ints, 3, &values[4]))         &&
+                      (d_map_get_int(ints, 3) == &values[4])       &&
+                      (d_map_count(ints) == 1) );
+
+    // cleanup
+    d_map_free(colliding);
+    d_map_free(ints);
+
+    // build result tree
+    group = d_test_object_new_interior("d_map_remove", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("missing",
+                                           test_missing,
+                                           "missing key not removed");
+    group->elements[idx++] = D_ASSERT_TRUE("out_value",
+                                           test_out_value,
+                                           "removed value returned");
+    group->elements[idx++] = D_ASSERT_TRUE("run_intact",
+                                           test_run_intact,
+                                           "collision run stays reachable");
+    group->elements[idx++] = D_ASSERT_TRUE("no_tombstones",
+                                           test_no_tombstones,
+                                           "removal leaves no tombstones");
+    group->elements[idx++] = D_ASSERT_TRUE("reinsert",
+                                           test_reinsert,
+                                           "removed key can be reinserted");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * CORE OPERATIONS AGGREGATOR
+ *****************************************************************************/
+
+/*
+d_tests_map_core_all
+  Runs all core operation tests.
+  Tests the following:
+  - d_map_new
+  - d_map_put / d_map_get / d_map_contains
+  - typed key fast paths
+  - d_map_remove
+*/
+struct d_test_object*
+d_tests_map_core_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    group = d_test_object_new_interior("Core Map Operations", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = d_tests_map_new();
+    group->elements[idx++] = d_tests_map_put_get();
+    group->elements[idx++] = d_tests_map_typed_keys();
+    group->elements[idx++] = d_tests_map_remove();
+
+    return group;
+}
@@ -20,6 +20,8 @@ d_tests_min_enum_map_run_all
   - Memory management (clear, free)
   - Advanced operations (merge, macros, ordering)
   - Edge cases and stress testing
+  - Dense layout (direct indexing, layout selection, fallback)
+  - Batch operations (construction from entries, in-place merge)
   
   This function aggregates all test categories and returns a complete
   test tree for execution by the test framework.
@@ -34,7 +36,7 @@ d_tests_min_enum_map_run_all
     size_t                idx;
 
     // create master test group
-    group = d_test_object_new_interior("min_enum_map Module Tests", 4);
+    group = d_test_object_new_interior("min_enum_map Module Tests", 6);
 
     if (!group)
     {
@@ -47,6 +49,8 @@ d_tests_min_enum_map_run_all
     group->elements[idx++] = d_tests_min_enum_map_memory_all();
     group->elements[idx++] = d_tests_min_enum_map_advanced_all();
     group->elements[idx++] = d_tests_min_enum_map_edge_stress_all();
+    group->elements[idx++] = d_tests_min_enum_map_dense_all();
+    group->elements[idx++] = d_tests_min_enum_map_batch_all();
 
     return group;
 }
@@ -149,6 +149,37 @@ struct d_test_object* d_tests_min_enum_map_stress(void);
 struct d_test_object* d_tests_min_enum_map_edge_stress_all(void);
 
 
+/******************************************************************************
+ * DENSE LAYOUT TESTS
+ *****************************************************************************/
+
+// dense operation tests
+struct d_test_object* d_tests_min_enum_map_dense_ops(void);
+
+// layout selection and fallback tests
+struct d_test_object* d_tests_min_enum_map_dense_layout(void);
+
+// dense merge tests
+struct d_test_object* d_tests_min_enum_map_dense_merge(void);
+
+// dense layout aggregator
+struct d_test_object* d_tests_min_enum_map_dense_all(void);
+
+
+/******************************************************************************
+ * BATCH OPERATION TESTS
+ *****************************************************************************/
+
+// batch construction tests
+struct d_test_object* d_tests_min_enum_map_new_from_entries(void);
+
+// in-place merge tests
+struct d_test_object* d_tests_min_enum_map_merge_in_place(void);
+
+// batch operations aggregator
+struct d_test_object* d_tests_min_enum_map_batch_all(void);
+
+
 /******************************************************************************
  * MASTER TEST RUNNER
  *****************************************************************************/
@@ -0,0 +1,325 @@
+/******************************************************************************
+* djinterp [test]                               min_enum_map_tests_sa_batch.c
+*
+*   Batch construction and in-place merge tests for min_enum_map module.
+*
+*
+* path:      \test\container\map\min_enum_map_tests_sa_batch.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\min_enum_map_tests_sa.h"
+
+
+/******************************************************************************
+ * BATCH CONSTRUCTION TESTS
+ *****************************************************************************/
+
+/*
+d_tests_min_enum_map_new_from_entries
+  Tests d_min_enum_map_new_from_entries and d_min_enum_map_new_from_sentinel.
+  Tests the following:
+  - NULL entries with a count are rejected; zero entries give an empty map
+  - unsorted input is sorted
+  - IGNORE keeps the first of repeated keys, OVERWRITE the last
+  - KEEP_BOTH fails on repeated keys
+  - a sentinel-terminated static table is loaded
+  - a large shuffled input is sorted and complete
+*/
+struct d_test_object*
+d_tests_min_enum_map_new_from_entries
+(
+    void
+)
+{
+    static const struct d_enum_map_entry color_names[] =
+    {
+        D_ENUM_ENTRY_STR(TEST_COLOR_BLUE,  "blue"),
+        D_ENUM_ENTRY_STR(TEST_COLOR_RED,   "red"),
+        D_ENUM_ENTRY_STR(TEST_COLOR_WHITE, "white"),
+        D_ENUM_ENTRY_STR(TEST_COLOR_GREEN, "green"),
+        D_ENUM_ENTRY_SENTINEL
+    };
+    struct d_test_object*   group;
+    struct d_min_enum_map*  map;
+    struct d_enum_map_entry entries[D_TEST_MIN_ENUM_MAP_STRESS_SIZE];
+    int                     values[4];
+    bool                    test_null_empty;
+    bool                    test_sorted;
+    bool                    test_duplicates;
+    bool                    test_keep_both;
+    bool                    test_sentinel;
+    bool                    test_large;
+    size_t                  i;
+    size_t                  idx;
+
+    // test 1: NULL and empty input
+    map             = d_min_enum_map_new_from_entries(NULL, 0, D_MERGE_CONFLICT_FLAG_IGNORE);
+    test_null_empty = ( (map != NULL)                     &&
+                        (d_min_enum_map_count(map) == 0)  &&
+                        (d_min_enum_map_new_from_entries(NULL, 3, D_MERGE_CONFLICT_FLAG_IGNORE) == NULL) );
+    d_min_enum_map_free(map);
+
+    // test 2: unsorted input
+    entries[0].key = 30; entries[0].value = &values[0];
+    entries[1].key = 10; entries[1].value = &values[1];
+    entries[2].key = 20; entries[2].value = &values[2];
+    map         = d_min_enum_map_new_from_entries(entries, 3, D_MERGE_CONFLICT_FLAG_IGNORE);
+    test_sorted = ( (map != NULL)                                &&
+                    (d_min_enum_map_count(map) == 3)             &&
+                    (map->entries[0].key == 10)                  &&
+                    (map->entries[1].key == 20)                  &&
+                    (map->entries[2].key == 30)                  &&
+                    (d_min_enum_map_get(map, 30) == &values[0]) );
+    d_min_enum_map_free(map);
+
+    // test 3: repeated keys (20 appears three times)
+    entries[3].key = 20; entries[3].value = &values[3];
+    entries[4].key = 20; entries[4].value = &values[0];
+    map             = d_min_enum_map_new_from_entries(entries, 5, D_MERGE_CONFLICT_FLAG_IGNORE);
+    test_duplicates = ( (map != NULL)                                &&
+                        (d_min_enum_map_count(map) == 3)             &&
+                        (d_min_enum_map_get(map, 20) == &values[2]) );
+    d_min_enum_map_free(map);
+
+    map             = d_min_enum_map_new_from_entries(entries, 5, D_MERGE_CONFLICT_FLAG_OVERWRITE);
+    test_duplicates = test_duplicates                             &&
+                      (map != NULL)                               &&
+                      (d_min_enum_map_count(map) == 3)            &&
+                      (d_min_enum_map_get(map, 20) == &values[0]);
+    d_min_enum_map_free(map);
+
+    // test 4: KEEP_BOTH
+    map            = d_min_enum_map_new_from_entries(entries, 3, D_MERGE_CONFLICT_FLAG_KEEP_BOTH);
+    test_keep_both = ( (map != NULL) &&
+                       (d_min_enum_map_new_from_entries(entries, 5, D_MERGE_CONFLICT_FLAG_KEEP_BOTH) == NULL) );
+    d_min_enum_map_free(map);
+
+    // test 5: sentinel-terminated static table
+    map           = d_min_enum_map_new_from_sentinel(color_names, D_MERGE_CONFLICT_FLAG_IGNORE);
+    test_sentinel = ( (map != NULL)                                            &&
+                      (d_min_enum_map_count(map) == 4)                         &&
+                      (map->entries[0].key == TEST_COLOR_RED)                  &&
+                      (map->entries[3].key == TEST_COLOR_WHITE)                &&
+                      (d_min_enum_map_get(map, TEST_COLOR_BLUE) == color_names[0].value) &&
+                      (d_min_enum_map_new_from_sentinel(NULL, D_MERGE_CONFLICT_FLAG_IGNORE) == NULL) );
+    d_min_enum_map_free(map);
+
+    // test 6: large shuffled input (7919 is coprime with the size)
+    for (i = 0; i < D_TEST_MIN_ENUM_MAP_STRESS_SIZE; ++i)
+    {
+        entries[i].key   = (int)((i * 7919) % D_TEST_MIN_ENUM_MAP_STRESS_SIZE);
+        entries[i].value = &entries[i];
+    }
+
+    map        = d_min_enum_map_new_from_entries(entries,
+                                                 D_TEST_MIN_ENUM_MAP_STRESS_SIZE,
+                                                 D_MERGE_CONFLICT_FLAG_KEEP_BOTH);
+    test_large = ( (map != NULL) &&
+                   (d_min_enum_map_count(map) == D_TEST_MIN_ENUM_MAP_STRESS_SIZE) );
+
+    for (i = 0; (test_large) && (i < D_TEST_MIN_ENUM_MAP_STRESS_SIZE); ++i)
+    {
+        test_large = (map->entries[i].key == (int)i) &&
+                     (((struct d_enum_map_entry*)map->entries[i].value)->key == (int)i);
+    }
+
+    d_min_enum_map_free(map);
+
+    // build result tree
+    group = d_test_object_new_interior("d_min_enum_map_new_from_entries", 6);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("null_empty",
+                                           test_null_empty,
+                                           "NULL rejected, empty input allowed");
+    group->elements[idx++] = D_ASSERT_TRUE("sorted",
+                                           test_sorted,
+                                           "unsorted input is sorted");
+    group->elements[idx++] = D_ASSERT_TRUE("duplicates",
+                                           test_duplicates,
+                                           "IGNORE keeps first, OVERWRITE last");
+    group->elements[idx++] = D_ASSERT_TRUE("keep_both",
+                                           test_keep_both,
+                                           "KEEP_BOTH fails on repeats");
+    group->elements[idx++] = D_ASSERT_TRUE("sentinel",
+                                           test_sentinel,
+                                           "sentinel table is loaded");
+    group->elements[idx++] = D_ASSERT_TRUE("large",
+                                           test_large,
+                                           "large shuffled input is sorted");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * IN-PLACE MERGE TESTS
+ *****************************************************************************/
+
+/*
+d_tests_min_enum_map_merge_in_place
+  Tests d_min_enum_map_merge_in_place.
+  Tests the following:
+  - spare capacity is reused (no reallocation)
+  - interleaved keys are merged in sorted order
+  - KEEP_BOTH fails on a shared key and leaves the destination unchanged
+  - OVERWRITE replaces shared keys' values
+  - the array grows when spare capacity is too small
+  - a dense source merges into a sorted destination
+*/
+struct d_test_object*
+d_tests_min_enum_map_merge_in_place
+(
+    void
+)
+{
+    struct d_test_object*    group;
+    struct d_min_enum_map*   dst;
+    struct d_min_enum_map*   src;
+    struct d_min_enum_map*   dense;
+    struct d_enum_map_entry* before;
+    int                      values[8];
+    bool                     test_reuse;
+    bool                     test_order;
+    bool                     test_keep_both;
+    bool                     test_overwrite;
+    bool                     test_grow;
+    bool                     test_dense_source;
+    int                      i;
+    size_t                   idx;
+
+    for (i = 0; i < 8; ++i)
+    {
+        values[i] = i;
+    }
+
+    // dst: 10, 30 (capacity 8) ; src: 20, 40
+    dst = d_min_enum_map_new();
+    src = d_min_enum_map_new();
+    d_min_enum_map_put(dst, 10, &values[1]);
+    d_min_enum_map_put(dst, 30, &values[3]);
+    d_min_enum_map_put(src, 40, &values[4]);
+    d_min_enum_map_put(src, 20, &values[2]);
+
+    // test 1 & 2: reuse and order
+    before     = (dst) ? dst->entries : NULL;
+    test_reuse = ( (d_min_enum_map_merge_in_place(dst, src, D_MERGE_CONFLICT_FLAG_KEEP_BOTH)) &&
+                   (dst->entries == before)                                                &&
+                   (dst->capacity == D_MIN_ENUM_MAP_DEFAULT_CAPACITY) );
+    test_order = ( (dst != NULL)                                &&
+                   (d_min_enum_map_count(dst) == 4)             &&
+                   (dst->entries[0].key == 10)                  &&
+                   (dst->entries[1].key == 20)                  &&
+                   (dst->entries[2].key == 30)                  &&
+                   (dst->entries[3].key == 40)                  &&
+                   (d_min_enum_map_get(dst, 20) == &values[2]) );
+
+    // test 3: KEEP_BOTH conflict
+    d_min_enum_map_put(src, 20, &values[5]);
+    test_keep_both = ( (!d_min_enum_map_merge_in_place(dst, src, D_MERGE_CONFLICT_FLAG_KEEP_BOTH)) &&
+                       (d_min_enum_map_count(dst) == 4)                                         &&
+                       (d_min_enum_map_get(dst, 20) == &values[2]) );
+
+    // test 4: OVERWRITE
+    test_overwrite = ( (d_min_enum_map_merge_in_place(dst, src, D_MERGE_CONFLICT_FLAG_OVERWRITE)) &&
+                       (d_min_enum_map_count(dst) == 4)                                        &&
+                       (d_min_enum_map_get(dst, 20) == &values[5])                             &&
+                       (d_min_enum_map_get(dst, 10) == &values[1]) );
+
+    // test 5: grows past spare capacity
+    for (i = 0; (src) && (i < 10); ++i)
+    {
+        d_min_enum_map_put(src, 100 + i, &values[i % 8]);
+    }
+
+    test_grow = ( (d_min_enum_map_merge_in_place(dst, src, D_MERGE_CONFLICT_FLAG_IGNORE)) &&
+                  (d_min_enum_map_count(dst) == 14)                                    &&
+                  (dst->capacity >= 14)                                                &&
+                  (dst->entries[13].key == 109)                                        &&
+                  (d_min_enum_map_get(dst, 20) == &values[5]) );
+
+    // test 6: dense source
+    dense = d_min_enum_map_new_dense(0, 7);
+    d_min_enum_map_put(dense, 5, &values[5]);
+    d_min_enum_map_put(dense, 10, &values[6]);
+    test_dense_source = ( (d_min_enum_map_merge_in_place(dst, dense, D_MERGE_CONFLICT_FLAG_IGNORE)) &&
+                          (d_min_enum_map_count(dst) == 15)                                      &&
+                          (dst->entries[0].key == 5)                                             &&
+                          (d_min_enum_map_get(dst, 10) == &values[1]) );
+
+    d_min_enum_map_free(dst);
+    d_min_enum_map_free(src);
+    d_min_enum_map_free(dense);
+
+    // build result tree
+    group = d_test_object_new_interior("d_min_enum_map_merge_in_place", 6);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("reuse",
+                                           test_reuse,
+                                           "spare capacity is reused");
+    group->elements[idx++] = D_ASSERT_TRUE("order",
+                                           test_order,
+                                           "merged keys are sorted");
+    group->elements[idx++] = D_ASSERT_TRUE("keep_both",
+                                           test_keep_both,
+                                           "KEEP_BOTH conflict fails cleanly");
+    group->elements[idx++] = D_ASSERT_TRUE("overwrite",
+                                           test_overwrite,
+                                           "OVERWRITE replaces shared keys");
+    group->elements[idx++] = D_ASSERT_TRUE("grow",
+                                           test_grow,
+                                           "array grows when needed");
+    group->elements[idx++] = D_ASSERT_TRUE("dense_source",
+                                           test_dense_source,
+                                           "dense source merges into sorted");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * BATCH OPERATIONS AGGREGATOR
+ *****************************************************************************/
+
+/*
+d_tests_min_enum_map_batch_all
+  Runs all batch construction and in-place merge tests.
+  Tests the following:
+  - d_min_enum_map_new_from_entries / d_min_enum_map_new_from_sentinel
+  - d_min_enum_map_merge_in_place
+*/
+struct d_test_object*
+d_tests_min_enum_map_batch_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    group = d_test_object_new_interior("Batch Operations", 2);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = d_tests_min_enum_map_new_from_entries();
+    group->elements[idx++] = d_tests_min_enum_map_merge_in_place();
+
+    return group;
+}
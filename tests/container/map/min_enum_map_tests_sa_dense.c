@@ -0,0 +1,393 @@
+/******************************************************************************
+* djinterp [test]                               min_enum_map_tests_sa_dense.c
+*
+*   Dense layout tests for min_enum_map module.
+*   Tests direct-indexed storage, automatic layout selection and the
+* fallback to the sorted layout.
+*
+*
+* path:      \test\container\map\min_enum_map_tests_sa_dense.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\min_enum_map_tests_sa.h"
+
+
+/******************************************************************************
+ * DENSE CREATION AND OPERATION TESTS
+ *****************************************************************************/
+
+/*
+d_tests_min_enum_map_dense_ops
+  Tests the dense layout's basic operations.
+  Tests the following:
+  - new_dense preallocates a window covering the requested range
+  - new_dense rejects a reversed range
+  - put / get / contains within the window
+  - NULL values are present
+  - remove clears an entry and updates count
+  - clear empties the map and keeps the window
+*/
+struct d_test_object*
+d_tests_min_enum_map_dense_ops
+(
+    void
+)
+{
+    struct d_test_object*  group;
+    struct d_min_enum_map* map;
+    int                    values[8];
+    bool                   test_window;
+    bool                   test_reversed;
+    bool                   test_put_get;
+    bool                   test_null_value;
+    bool                   test_remove;
+    bool                   test_clear;
+    int                    i;
+    size_t                 idx;
+
+    for (i = 0; i < 8; ++i)
+    {
+        values[i] = i;
+    }
+
+    // test 1: window covers the range
+    map         = d_min_enum_map_new_dense(TEST_COLOR_RED, TEST_COLOR_WHITE);
+    test_window = ( (map != NULL)                          &&
+                    (d_min_enum_map_is_dense(map))         &&
+                    (map->min_key == TEST_COLOR_RED)       &&
+                    (map->span == 8)                       &&
+                    (d_min_enum_map_count(map) == 0) );
+
+    // test 2: reversed range
+    test_reversed = (d_min_enum_map_new_dense(5, 4) == NULL);
+
+    // test 3: put / get / contains
+    test_put_get = (map != NULL);
+
+    for (i = TEST_COLOR_RED; (map) && (i <= TEST_COLOR_WHITE); ++i)
+    {
+        test_put_get = test_put_get &&
+                       d_min_enum_map_put(map, i, &values[i]);
+    }
+
+    test_put_get = test_put_get                                             &&
+                   (d_min_enum_map_count(map) == 8)                         &&
+                   (d_min_enum_map_get(map, TEST_COLOR_BLUE) == &values[2]) &&
+                   (d_min_enum_map_contains(map, TEST_COLOR_WHITE))         &&
+                   (!d_min_enum_map_contains(map, -1))                      &&
+                   (d_min_enum_map_get(map, 8) == NULL)                     &&
+                   (d_min_enum_map_is_dense(map));
+
+    // test 4: NULL values
+    test_null_value = ( (d_min_enum_map_put(map, TEST_COLOR_GREEN, NULL)) &&
+                        (d_min_enum_map_contains(map, TEST_COLOR_GREEN))   &&
+                        (d_min_enum_map_count(map) == 8) );
+
+    // test 5: remove
+    test_remove = ( (d_min_enum_map_remove(map, TEST_COLOR_BLUE))   &&
+                    (!d_min_enum_map_remove(map, TEST_COLOR_BLUE))  &&
+                    (!d_min_enum_map_contains(map, TEST_COLOR_BLUE)) &&
+                    (d_min_enum_map_count(map) == 7)                &&
+                    (d_min_enum_map_get(map, TEST_COLOR_YELLOW) == &values[3]) );
+
+    // test 6: clear
+    d_min_enum_map_clear(map);
+    test_clear = ( (map != NULL)                               &&
+                   (d_min_enum_map_count(map) == 0)            &&
+                   (!d_min_enum_map_contains(map, TEST_COLOR_RED)) &&
+                   (map->span == 8)                            &&
+                   (d_min_enum_map_put(map, TEST_COLOR_RED, &values[0])) &&
+                   (d_min_enum_map_count(map) == 1) );
+
+    d_min_enum_map_free(map);
+
+    // build result tree
+    group = d_test_object_new_interior("dense_ops", 6);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("window",
+                                           test_window,
+                                           "new_dense covers the range");
+    group->elements[idx++] = D_ASSERT_TRUE("reversed",
+                                           test_reversed,
+                                           "reversed range rejected");
+    group->elements[idx++] = D_ASSERT_TRUE("put_get",
+                                           test_put_get,
+                                           "put/get/contains in the window");
+    group->elements[idx++] = D_ASSERT_TRUE("null_value",
+                                           test_null_value,
+                                           "NULL values are present");
+    group->elements[idx++] = D_ASSERT_TRUE("remove",
+                                           test_remove,
+                                           "remove clears the entry");
+    group->elements[idx++] = D_ASSERT_TRUE("clear",
+                                           test_clear,
+                                           "clear keeps the window");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * LAYOUT SELECTION TESTS
+ *****************************************************************************/
+
+/*
+d_tests_min_enum_map_dense_layout
+  Tests automatic layout selection.
+  Tests the following:
+  - the default mode never uses the dense layout
+  - AUTO maps with dense keys become dense, including negative keys and
+    windows growing downward
+  - a DENSE map falls back to sorted order, for good, once too sparse
+  - an AUTO map falls back when sparse and returns once dense again
+*/
+struct d_test_object*
+d_tests_min_enum_map_dense_layout
+(
+    void
+)
+{
+    struct d_test_object*  group;
+    struct d_min_enum_map* map;
+    int                    values[D_TEST_MIN_ENUM_MAP_LARGE_SIZE];
+    bool                   test_default_sorted;
+    bool                   test_auto_dense;
+    bool                   test_dense_fallback;
+    bool                   test_auto_round_trip;
+    int                    i;
+    size_t                 idx;
+
+    for (i = 0; i < D_TEST_MIN_ENUM_MAP_LARGE_SIZE; ++i)
+    {
+        values[i] = i;
+    }
+
+    // test 1: default mode stays sorted
+    map = d_min_enum_map_new();
+
+    for (i = 0; (map) && (i < 10); ++i)
+    {
+        d_min_enum_map_put(map, i, &values[i]);
+    }
+
+    test_default_sorted = ( (map != NULL)                  &&
+                            (!d_min_enum_map_is_dense(map)) &&
+                            (map->entries[9].key == 9) );
+
+    d_min_enum_map_free(map);
+
+    // test 2: AUTO with descending, partly negative keys
+    map             = d_min_enum_map_new_mode(D_MIN_ENUM_MAP_MODE_AUTO);
+    test_auto_dense = (map != NULL);
+
+    for (i = 49; (map) && (i >= -50); --i)
+    {
+        test_auto_dense = test_auto_dense &&
+                          d_min_enum_map_put(map, i, &values[i + 50]);
+    }
+
+    test_auto_dense = test_auto_dense                         &&
+                      (d_min_enum_map_is_dense(map))          &&
+                      (d_min_enum_map_count(map) == 100);
+
+    for (i = -50; (map) && (i < 50); ++i)
+    {
+        test_auto_dense = test_auto_dense &&
+                          (d_min_enum_map_get(map, i) == &values[i + 50]);
+    }
+
+    d_min_enum_map_free(map);
+
+    // test 3: DENSE falls back for good
+    map = d_min_enum_map_new_mode(D_MIN_ENUM_MAP_MODE_DENSE);
+
+    for (i = 0; (map) && (i < 4); ++i)
+    {
+        d_min_enum_map_put(map, i, &values[i]);
+    }
+
+    test_dense_fallback = ( (d_min_enum_map_is_dense(map))              &&
+                            (d_min_enum_map_put(map, 100000, &values[4])) &&
+                            (!d_min_enum_map_is_dense(map))             &&
+                            (map->mode == D_MIN_ENUM_MAP_MODE_SORTED)   &&
+                            (d_min_enum_map_count(map) == 5)            &&
+                            (map->entries[0].key == 0)                  &&
+                            (map->entries[4].key == 100000)             &&
+                            (d_min_enum_map_get(map, 3) == &values[3])  &&
+                            (d_min_enum_map_get(map, 100000) == &values[4]) );
+
+    d_min_enum_map_remove(map, 100000);
+    d_min_enum_map_put(map, 4, &values[4]);
+    test_dense_fallback = test_dense_fallback &&
+                          (!d_min_enum_map_is_dense(map));
+
+    d_min_enum_map_free(map);
+
+    // test 4: AUTO falls back and returns
+    map = d_min_enum_map_new_mode(D_MIN_ENUM_MAP_MODE_AUTO);
+
+    for (i = 0; (map) && (i < 4); ++i)
+    {
+        d_min_enum_map_put(map, i, &values[i]);
+    }
+
+    test_auto_round_trip = ( (d_min_enum_map_put(map, -100000, &values[9])) &&
+                             (!d_min_enum_map_is_dense(map))                &&
+                             (d_min_enum_map_remove(map, -100000))          &&
+                             (d_min_enum_map_put(map, 4, &values[4]))       &&
+                             (d_min_enum_map_is_dense(map))                 &&
+                             (d_min_enum_map_count(map) == 5) );
+
+    for (i = 0; (map) && (i < 5); ++i)
+    {
+        test_auto_round_trip = test_auto_round_trip &&
+                               (d_min_enum_map_get(map, i) == &values[i]);
+    }
+
+    d_min_enum_map_free(map);
+
+    // build result tree
+    group = d_test_object_new_interior("dense_layout", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("default_sorted",
+                                           test_default_sorted,
+                                           "default mode stays sorted");
+    group->elements[idx++] = D_ASSERT_TRUE("auto_dense",
+                                           test_auto_dense,
+                                           "AUTO map with dense keys is dense");
+    group->elements[idx++] = D_ASSERT_TRUE("dense_fallback",
+                                           test_dense_fallback,
+                                           "DENSE map falls back for good");
+    group->elements[idx++] = D_ASSERT_TRUE("auto_round_trip",
+                                           test_auto_round_trip,
+                                           "AUTO map returns to dense");
+
+    return group;
+}
+
+/*
+d_tests_min_enum_map_dense_merge
+  Tests d_min_enum_map_merge with dense maps.
+  Tests the following:
+  - dense destination, sorted source, without overwrite
+  - sorted destination, dense source, with overwrite
+  - result keeps the destination's layout and sorted order
+*/
+struct d_test_object*
+d_tests_min_enum_map_dense_merge
+(
+    void
+)
+{
+    struct d_test_object*  group;
+    struct d_min_enum_map* dense;
+    struct d_min_enum_map* sorted;
+    int                    values[8];
+    bool                   test_into_dense;
+    bool                   test_into_sorted;
+    int                    i;
+    size_t                 idx;
+
+    for (i = 0; i < 8; ++i)
+    {
+        values[i] = i;
+    }
+
+    dense  = d_min_enum_map_new_dense(0, 7);
+    sorted = d_min_enum_map_new();
+
+    // dense: 0 -> v0, 1 -> v1 ; sorted: 1 -> v5, 6 -> v6
+    d_min_enum_map_put(dense, 0, &values[0]);
+    d_min_enum_map_put(dense, 1, &values[1]);
+    d_min_enum_map_put(sorted, 1, &values[5]);
+    d_min_enum_map_put(sorted, 6, &values[6]);
+
+    // test 1: into dense, destination wins
+    test_into_dense = ( (d_min_enum_map_merge(dense, sorted, false)) &&
+                        (d_min_enum_map_is_dense(dense))             &&
+                        (d_min_enum_map_count(dense) == 3)           &&
+                        (d_min_enum_map_get(dense, 1) == &values[1]) &&
+                        (d_min_enum_map_get(dense, 6) == &values[6]) );
+
+    // test 2: into sorted, source wins
+    d_min_enum_map_put(dense, 1, &values[2]);
+    test_into_sorted = ( (d_min_enum_map_merge(sorted, dense, true))   &&
+                         (!d_min_enum_map_is_dense(sorted))            &&
+                         (d_min_enum_map_count(sorted) == 3)           &&
+                         (sorted->entries[0].key == 0)                 &&
+                         (sorted->entries[1].key == 1)                 &&
+                         (sorted->entries[2].key == 6)                 &&
+                         (d_min_enum_map_get(sorted, 1) == &values[2]) );
+
+    d_min_enum_map_free(dense);
+    d_min_enum_map_free(sorted);
+
+    // build result tree
+    group = d_test_object_new_interior("dense_merge", 2);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("into_dense",
+                                           test_into_dense,
+                                           "merge into a dense map");
+    group->elements[idx++] = D_ASSERT_TRUE("into_sorted",
+                                           test_into_sorted,
+                                           "merge a dense map into a sorted one");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * DENSE LAYOUT AGGREGATOR
+ *****************************************************************************/
+
+/*
+d_tests_min_enum_map_dense_all
+  Runs all dense layout tests.
+  Tests the following:
+  - dense operations
+  - layout selection and fallback
+  - merging dense maps
+*/
+struct d_test_object*
+d_tests_min_enum_map_dense_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    group = d_test_object_new_interior("Dense Layout", 3);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = d_tests_min_enum_map_dense_ops();
+    group->elements[idx++] = d_tests_min_enum_map_dense_layout();
+    group->elements[idx++] = d_tests_min_enum_map_dense_merge();
+
+    return group;
+}
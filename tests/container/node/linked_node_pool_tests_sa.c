@@ -0,0 +1,340 @@
+/******************************************************************************
+* djinterp [container]                               linked_node_pool_tests_sa.c
+*
+*   Test suite implementation for the linked_node pool allocator.
+*
+*
+* path:      \test\container\node\linked_node_pool_tests_sa.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\linked_node_tests_sa.h"
+
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    #include <threads.h>
+#endif
+
+
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+/*
+d_test_sa_linked_node_pool_cache_thread
+  Thread body for the thread-exit test: churns a few nodes through its own
+cache and exits without flushing it.
+
+Parameter(s):
+  _arg: unused.
+Return:
+  0.
+*/
+static int
+d_test_sa_linked_node_pool_cache_thread
+(
+    void* _arg
+)
+{
+    struct d_linked_node* nodes[8];
+    size_t                i;
+
+    (void)_arg;
+
+    for (i = 0; i < 8; ++i)
+    {
+        nodes[i] = d_linked_node_pool_acquire();
+    }
+
+    for (i = 0; i < 8; ++i)
+    {
+        d_linked_node_pool_release(nodes[i]);
+    }
+
+    return 0;
+}
+#endif
+
+
+/******************************************************************************
+ * TEST GROUP: LINKED NODE POOL
+ *****************************************************************************/
+
+/*
+d_test_sa_linked_node_pool
+  Tests for the d_linked_node_pool functions and d_linked_node_free_chain.
+
+Parameter(s):
+  none
+Return:
+  Test object tree containing all pool-related tests.
+*/
+struct d_test_object*
+d_test_sa_linked_node_pool
+(
+    void
+)
+{
+    struct d_test_object*           group;
+    struct d_test_object*           test_recycle;
+    struct d_test_object*           test_chain;
+    struct d_test_object*           test_reserve;
+    struct d_test_object*           test_trim;
+    struct d_test_object*           test_idle;
+    struct d_linked_node_pool_stats before;
+    struct d_linked_node_pool_stats after;
+    struct d_linked_node*           first;
+    struct d_linked_node*           second;
+    struct d_linked_node*           top;
+    struct d_linked_node*           node;
+    bool                            chain_built;
+    bool                            chain_counted;
+    bool                            chain_returned;
+    bool                            idle_grew;
+    bool                            idle_freed;
+    size_t                          i;
+    size_t                          child_idx;
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    struct d_test_object*           test_exit;
+    thrd_t                          thread;
+    bool                            thread_ran;
+#endif
+
+    // create test group
+    group = d_test_object_new_interior("d_linked_node_pool",
+                                       4 + 1 + D_LINKED_NODE_POOL_THREAD_CACHE);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    child_idx = 0;
+
+    // ===========================================================================
+    // Test 1: A released node is handed out again
+    // ===========================================================================
+    first = d_linked_node_pool_acquire();
+    d_linked_node_pool_release(first);
+    second = d_linked_node_pool_acquire();
+
+    test_recycle = d_test_object_new_interior("node recycling", 2);
+
+    if (test_recycle)
+    {
+        d_test_object_add_child(test_recycle,
+            D_ASSERT_NOT_NULL("acquire returns a node", first,
+                             "d_linked_node_pool_acquire returned NULL"),
+            0);
+
+        d_test_object_add_child(test_recycle,
+            D_ASSERT_TRUE("released node is reused",
+                         (first == second),
+                         "the pool did not reuse the released node"),
+            1);
+    }
+
+    d_test_object_add_child(group, test_recycle, child_idx++);
+
+    d_linked_node_pool_release(second);
+
+    // ===========================================================================
+    // Test 2: A whole chain is counted out and returned in one call
+    // ===========================================================================
+    // thread-cached nodes count as in use; start from an empty cache
+    d_linked_node_pool_thread_flush();
+    d_linked_node_pool_get_stats(&before);
+
+    top         = NULL;
+    chain_built = true;
+
+    for (i = 0; i < 3 * D_LINKED_NODE_POOL_SLAB_NODES; ++i)
+    {
+        node = d_linked_node_new(NULL, top);
+
+        if (!node)
+        {
+            chain_built = false;
+
+            break;
+        }
+
+        top = node;
+    }
+
+    d_linked_node_pool_get_stats(&after);
+
+#if D_LINKED_NODE_POOL_ENABLED
+    chain_counted = (after.in_use >= before.in_use + i);
+#else
+    chain_counted = true;
+#endif
+
+    d_linked_node_free_chain(top);
+    d_linked_node_pool_thread_flush();
+    d_linked_node_pool_get_stats(&after);
+
+    chain_returned = (after.in_use == before.in_use);
+
+    test_chain = d_test_object_new_interior("chain release", 3);
+
+    if (test_chain)
+    {
+        d_test_object_add_child(test_chain,
+            D_ASSERT_TRUE("chain allocates across slabs", chain_built,
+                         "d_linked_node_new failed while building the chain"),
+            0);
+
+        d_test_object_add_child(test_chain,
+            D_ASSERT_TRUE("chain nodes are counted in use", chain_counted,
+                         "pool did not account for the chain's nodes"),
+            1);
+
+        d_test_object_add_child(test_chain,
+            D_ASSERT_TRUE("free_chain returns every node", chain_returned,
+                         "d_linked_node_free_chain left nodes in use"),
+            2);
+    }
+
+    d_test_object_add_child(group, test_chain, child_idx++);
+
+    // ===========================================================================
+    // Test 3: Reserve fills the free list ahead of time
+    // ===========================================================================
+    d_linked_node_pool_get_stats(&before);
+
+    test_reserve = d_test_object_new_interior("reserve", 2);
+
+    if (test_reserve)
+    {
+        d_test_object_add_child(test_reserve,
+            D_ASSERT_TRUE("reserve succeeds",
+                         d_linked_node_pool_reserve(before.available + 1000),
+                         "d_linked_node_pool_reserve failed"),
+            0);
+
+        d_linked_node_pool_get_stats(&after);
+
+        d_test_object_add_child(test_reserve,
+            D_ASSERT_TRUE("reserved nodes are available",
+                         ( (after.available >= before.available + 1000) &&
+                           (after.capacity == after.slabs * D_LINKED_NODE_POOL_SLAB_NODES) ),
+                         "reserve did not add enough nodes"),
+            1);
+    }
+
+    d_test_object_add_child(group, test_reserve, child_idx++);
+
+    // ===========================================================================
+    // Test 4: Trim only frees slabs once nothing is in use
+    // ===========================================================================
+    first = d_linked_node_pool_acquire();
+
+    test_trim = d_test_object_new_interior("trim", 2);
+
+    if (test_trim)
+    {
+        d_test_object_add_child(test_trim,
+            D_ASSERT_FALSE("trim refuses while a node is held",
+                          d_linked_node_pool_trim(),
+                          "d_linked_node_pool_trim freed a slab in use"),
+            0);
+
+        d_linked_node_pool_release(first);
+
+        d_test_object_add_child(test_trim,
+            D_ASSERT_TRUE("trim frees every slab when idle",
+                         d_linked_node_pool_trim(),
+                         "d_linked_node_pool_trim failed on an idle pool"),
+            1);
+    }
+    else
+    {
+        d_linked_node_pool_release(first);
+    }
+
+    d_test_object_add_child(group, test_trim, child_idx++);
+
+    // ===========================================================================
+    // Test 5: Slabs whose nodes are all free again go back to the system
+    // ===========================================================================
+    d_linked_node_pool_get_stats(&before);
+
+    top = NULL;
+
+    for (i = 0; i < 4 * D_LINKED_NODE_POOL_SLAB_NODES; ++i)
+    {
+        node = d_linked_node_pool_acquire();
+
+        if (!node)
+        {
+            break;
+        }
+
+        node->next = top;
+        top        = node;
+    }
+
+    d_linked_node_pool_get_stats(&after);
+
+    idle_grew = (after.slabs >= before.slabs + 4);
+
+    d_linked_node_pool_release_chain(top);
+    d_linked_node_pool_thread_flush();
+    d_linked_node_pool_get_stats(&after);
+
+    // at most one idle slab is kept back
+    idle_freed = ( (after.slabs <= before.slabs + 1) &&
+                   (after.in_use == before.in_use) );
+
+    test_idle = d_test_object_new_interior("idle slab release", 2);
+
+    if (test_idle)
+    {
+        d_test_object_add_child(test_idle,
+            D_ASSERT_TRUE("chain spans several slabs", idle_grew,
+                         "acquiring 4 slabs' worth of nodes added too few slabs"),
+            0);
+
+        d_test_object_add_child(test_idle,
+            D_ASSERT_TRUE("idle slabs are freed", idle_freed,
+                         "fully free slabs stayed allocated after release"),
+            1);
+    }
+
+    d_test_object_add_child(group, test_idle, child_idx++);
+
+#if D_LINKED_NODE_POOL_THREAD_CACHE
+    // ===========================================================================
+    // Test 6: A thread that exits without flushing returns its cache
+    // ===========================================================================
+    d_linked_node_pool_thread_flush();
+    d_linked_node_pool_get_stats(&before);
+
+    thread_ran = ( (thrd_create(&thread,
+                                d_test_sa_linked_node_pool_cache_thread,
+                                NULL) == thrd_success) &&
+                   (thrd_join(thread, NULL) == thrd_success) );
+
+    d_linked_node_pool_get_stats(&after);
+
+    test_exit = d_test_object_new_interior("thread exit", 2);
+
+    if (test_exit)
+    {
+        d_test_object_add_child(test_exit,
+            D_ASSERT_TRUE("worker thread ran", thread_ran,
+                         "could not run the cache worker thread"),
+            0);
+
+        d_test_object_add_child(test_exit,
+            D_ASSERT_TRUE("exited thread's cache is returned",
+                         ( (after.cached == before.cached) &&
+                           (after.in_use == before.in_use) &&
+                           (after.available >= before.available) ),
+                         "nodes cached by an exited thread were not returned"),
+            1);
+    }
+
+    d_test_object_add_child(group, test_exit, child_idx++);
+#endif
+
+    return group;
+}
@@ -308,10 +308,11 @@ d_test_sa_linked_node_module
     struct d_test_object* module;
     struct d_test_object* creation_tests;
     struct d_test_object* destruction_tests;
+    struct d_test_object* pool_tests;
     size_t                child_idx;
 
     // create module root
-    module = d_test_object_new_interior("linked_node", 2);
+    module = d_test_object_new_interior("linked_node", 3);
     
     if (!module)
     {
@@ -327,5 +328,8 @@ d_test_sa_linked_node_module
     destruction_tests = d_test_sa_linked_node_destruction();
     d_test_object_add_child(module, destruction_tests, child_idx++);
 
+    pool_tests = d_test_sa_linked_node_pool();
+    d_test_object_add_child(module, pool_tests, child_idx++);
+
     return module;
 }
@@ -17,6 +17,7 @@
 #include "..\..\..\inc\djinterp.h"
 #include "..\..\..\inc\test\test_standalone.h"
 #include "..\..\..\inc\container\node\linked_node.h"
+#include "..\..\..\inc\container\node\linked_node_pool.h"
 
 
 /******************************************************************************
@@ -41,5 +42,9 @@ struct d_test_object* d_test_sa_linked_node_creation(void);
 //   function: tests for d_linked_node_free and memory management.
 struct d_test_object* d_test_sa_linked_node_destruction(void);
 
+// d_test_sa_linked_node_pool
+//   function: tests for the node pool and d_linked_node_free_chain.
+struct d_test_object* d_test_sa_linked_node_pool(void);
+
 
 #endif  // DJINTERP_TESTING_CONTAINER_LINKED_NODE_STANDALONE_
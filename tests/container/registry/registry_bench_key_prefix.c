@@ -0,0 +1,284 @@
+/******************************************************************************
+* djinterp [test]                                  registry_bench_key_prefix.c
+*
+*   Benchmark for D_REGISTRY_FLAG_KEY_PREFIX. Builds 100k-key registries
+* whose key strings are allocated individually in shuffled order (so every
+* key dereference is a likely cache miss) and compares binary-search lookups
+* with and without inline key prefixes.
+*   Two figures are reported per key set:
+*   - ns/lookup via d_registry_get
+*   - key reads/lookup: comparisons the lookup comparator could not settle
+*     from the inline prefix, i.e. the pointer chases the prefix avoids
+*   The "namespaced" set shares an 8+ byte leading component, which is the
+* worst case for an 8-byte prefix; the "flat" set is the common case.
+*   Not part of the standalone test run; build it on its own, e.g.
+*     cc -O2 registry_bench_key_prefix.c registry.c -o bench
+* and use `perf stat -e cache-misses ./bench` for hardware miss counts.
+*
+* path:      \tests\container\registry\registry_bench_key_prefix.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include "..\..\..\inc\container\registry\registry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+#define D_BENCH_REGISTRY_KEYS     100000
+#define D_BENCH_REGISTRY_LOOKUPS  1000000
+
+
+struct bench_row
+{
+    const char* key;
+    size_t      value;
+};
+
+static size_t g_key_reads;
+
+static int
+bench_counting_compare
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
+    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
+
+    g_key_reads++;
+
+    return strcmp(a->key, b->key);
+}
+
+static int
+bench_counting_compare_prefix
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_registry_lookup_entry* a = (const struct d_registry_lookup_entry*)_a;
+    const struct d_registry_lookup_entry* b = (const struct d_registry_lookup_entry*)_b;
+
+    if (a->prefix == b->prefix)
+    {
+        g_key_reads++;
+    }
+
+    return d_registry_lookup_compare_prefix(_a, _b);
+}
+
+// bench_key_prefix
+//   case-sensitive copy of the registry's internal prefix packing.
+static uint64_t
+bench_key_prefix
+(
+    const char* _key
+)
+{
+    uint64_t prefix = 0;
+    size_t   i;
+
+    for (i = 0; i < 8; ++i)
+    {
+        if (!_key[i])
+        {
+            return (i == 0) ? 0 : (prefix << (8 * (8 - i)));
+        }
+
+        prefix = (prefix << 8) | (unsigned char)_key[i];
+    }
+
+    return prefix;
+}
+
+static double
+bench_seconds
+(
+    void
+)
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static uint64_t
+bench_rand
+(
+    uint64_t* _state
+)
+{
+    *_state ^= *_state << 13;
+    *_state ^= *_state >> 7;
+    *_state ^= *_state << 17;
+
+    return *_state;
+}
+
+static void
+bench_run
+(
+    const char* _label,
+    const char* _format
+)
+{
+    struct bench_row*              rows;
+    char**                         keys;
+    size_t*                        order;
+    struct d_registry*             reg;
+    struct d_registry_lookup_entry probe;
+    uint64_t                       state;
+    double                         t0;
+    double                         elapsed[2];
+    size_t                         reads[2];
+    size_t                         hits;
+    size_t                         i;
+    size_t                         j;
+    size_t                         tmp;
+    int                            mode;
+
+    rows  = malloc(D_BENCH_REGISTRY_KEYS * sizeof(*rows));
+    keys  = malloc(D_BENCH_REGISTRY_KEYS * sizeof(*keys));
+    order = malloc(D_BENCH_REGISTRY_KEYS * sizeof(*order));
+
+    if (!rows || !keys || !order)
+    {
+        free(rows);
+        free(keys);
+        free(order);
+
+        return;
+    }
+
+    state = 0x9E3779B97F4A7C15ULL;
+
+    for (i = 0; i < D_BENCH_REGISTRY_KEYS; ++i)
+    {
+        order[i] = i;
+    }
+
+    for (i = D_BENCH_REGISTRY_KEYS - 1; i > 0; --i)
+    {
+        j        = (size_t)(bench_rand(&state) % (i + 1));
+        tmp      = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    // allocate key strings in shuffled order so sorted neighbours are
+    // scattered across the heap
+    for (i = 0; i < D_BENCH_REGISTRY_KEYS; ++i)
+    {
+        keys[order[i]] = malloc(48);
+
+        if (keys[order[i]])
+        {
+            snprintf(keys[order[i]], 48, _format,
+                     (unsigned long)((order[i] * 2654435761UL) % 1000003UL),
+                     (unsigned long)order[i]);
+        }
+    }
+
+    for (i = 0; i < D_BENCH_REGISTRY_KEYS; ++i)
+    {
+        rows[i].key   = keys[i];
+        rows[i].value = i;
+    }
+
+    reg = d_registry_new_from_array(rows, sizeof(*rows), D_BENCH_REGISTRY_KEYS);
+
+    for (mode = 0; reg && (mode < 2); ++mode)
+    {
+        if (mode == 1)
+        {
+            d_registry_enable_key_prefix(reg);
+        }
+
+        // timed lookups
+        hits  = 0;
+        state = 0x2545F4914F6CDD1DULL;
+        t0    = bench_seconds();
+
+        for (i = 0; i < D_BENCH_REGISTRY_LOOKUPS; ++i)
+        {
+            if (d_registry_get(reg, keys[bench_rand(&state) % D_BENCH_REGISTRY_KEYS]))
+            {
+                hits++;
+            }
+        }
+
+        elapsed[mode] = bench_seconds() - t0;
+
+        // counted lookups with the same search the registry performs
+        g_key_reads = 0;
+        state       = 0x2545F4914F6CDD1DULL;
+
+        for (i = 0; i < D_BENCH_REGISTRY_LOOKUPS; ++i)
+        {
+            probe.key       = keys[bench_rand(&state) % D_BENCH_REGISTRY_KEYS];
+            probe.row_index = 0;
+            probe.prefix    = (mode == 1) ? bench_key_prefix(probe.key) : 0;
+
+            bsearch(&probe,
+                    reg->lookup,
+                    reg->lookup_count,
+                    sizeof(struct d_registry_lookup_entry),
+                    (mode == 1) ? bench_counting_compare_prefix
+                                : bench_counting_compare);
+        }
+
+        reads[mode] = g_key_reads;
+
+        if (hits != D_BENCH_REGISTRY_LOOKUPS)
+        {
+            printf("  %s: unexpected misses (%zu)\n", _label, D_BENCH_REGISTRY_LOOKUPS - hits);
+        }
+    }
+
+    if (reg)
+    {
+        printf("  %-10s plain : %7.1f ns/lookup  %5.2f key reads/lookup\n",
+               _label,
+               elapsed[0] * 1e9 / D_BENCH_REGISTRY_LOOKUPS,
+               (double)reads[0] / D_BENCH_REGISTRY_LOOKUPS);
+        printf("  %-10s prefix: %7.1f ns/lookup  %5.2f key reads/lookup\n",
+               _label,
+               elapsed[1] * 1e9 / D_BENCH_REGISTRY_LOOKUPS,
+               (double)reads[1] / D_BENCH_REGISTRY_LOOKUPS);
+    }
+
+    d_registry_free(reg);
+
+    for (i = 0; i < D_BENCH_REGISTRY_KEYS; ++i)
+    {
+        free(keys[i]);
+    }
+
+    free(rows);
+    free(keys);
+    free(order);
+}
+
+int
+main
+(
+    void
+)
+{
+    printf("d_registry key prefix benchmark (%d keys, %d lookups)\n",
+           D_BENCH_REGISTRY_KEYS,
+           D_BENCH_REGISTRY_LOOKUPS);
+
+    bench_run("flat", "%06lx_%lu");
+    bench_run("namespaced", "settings.%06lx.%lu");
+
+    return 0;
+}
@@ -7,6 +7,7 @@ d_tests_sa_registry_common_run_all
   Executes tests for all categories:
   - String comparison functions (d_registry_strcmp)
   - Schema max enum key functions (d_registry_schema_max_enum_key)
+  - Cvar name lookup and typed access (d_cvar_registry_*)
 */
 bool
 d_tests_sa_registry_common_run_all
@@ -21,6 +22,7 @@ d_tests_sa_registry_common_run_all
     // run all test categories
     result = d_tests_sa_registry_strcmp_all(_counter) && result;
     result = d_tests_sa_registry_schema_max_enum_key_all(_counter) && result;
+    result = d_tests_sa_cvar_registry_lookup_all(_counter) && result;
 
     return result;
 }
@@ -78,6 +78,24 @@ bool d_tests_sa_registry_schema_max_enum_key_sparse(struct d_test_counter* _coun
 bool d_tests_sa_registry_schema_max_enum_key_all(struct d_test_counter* _counter);
 
 
+/******************************************************************************
+ * III. CVAR LOOKUP AND TYPED ACCESS TESTS (d_cvar_registry_*)
+ *****************************************************************************/
+
+// name lookup tests
+bool d_tests_sa_cvar_registry_build_lookup(struct d_test_counter* _counter);
+bool d_tests_sa_cvar_registry_find(struct d_test_counter* _counter);
+bool d_tests_sa_cvar_registry_find_case(struct d_test_counter* _counter);
+bool d_tests_sa_cvar_registry_value_by_name(struct d_test_counter* _counter);
+
+// typed access tests
+bool d_tests_sa_cvar_registry_get_set(struct d_test_counter* _counter);
+bool d_tests_sa_cvar_registry_set_copy(struct d_test_counter* _counter);
+
+// III. aggregation function
+bool d_tests_sa_cvar_registry_lookup_all(struct d_test_counter* _counter);
+
+
 /******************************************************************************
  * MODULE-LEVEL AGGREGATION
  *****************************************************************************/
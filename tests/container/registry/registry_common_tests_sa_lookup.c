@@ -0,0 +1,459 @@
+#include ".\registry_common_tests_sa.h"
+
+
+/******************************************************************************
+ * HELPER DEFINITIONS FOR TEST CVARS
+ *****************************************************************************/
+
+enum test_cvar
+{
+    TEST_CVAR_GRAVITY = 0,
+    TEST_CVAR_MAXPLAYERS,
+    TEST_CVAR_HOSTNAME,
+    TEST_CVAR_COUNT
+};
+
+static const int    g_test_default_gravity    = 800;
+static const int    g_test_default_maxplayers = 16;
+static const char   g_test_default_hostname[] = "server";
+
+// g_test_cvar_schema
+//   schema with abbreviations and one alias row sharing an enum_key.
+static const struct d_registry_schema_row g_test_cvar_schema[] =
+{
+    D_REGISTRY_SCHEMA_ROW("sv_gravity",    "grav", TEST_CVAR_GRAVITY,    0, &g_test_default_gravity,    NULL),
+    D_REGISTRY_SCHEMA_ROW("sv_maxplayers", "maxp", TEST_CVAR_MAXPLAYERS, 0, &g_test_default_maxplayers, NULL),
+    D_REGISTRY_SCHEMA_ROW("hostname",      NULL,   TEST_CVAR_HOSTNAME,   0, g_test_default_hostname,    NULL),
+    D_REGISTRY_SCHEMA_ROW("sv_hostname",   NULL,   TEST_CVAR_HOSTNAME,   0, g_test_default_hostname,    NULL)
+};
+
+// test_cvar_init
+//   helper: wires a registry over g_test_cvar_schema and `_values`.
+static void
+test_cvar_init
+(
+    struct d_cvar_registry*  _registry,
+    struct d_registry_value* _values,
+    uint32_t                 _flags
+)
+{
+    size_t i;
+
+    memset(_registry, 0, sizeof(*_registry));
+    memset(_values, 0, TEST_CVAR_COUNT * sizeof(*_values));
+
+    for ( i = 0u; i < sizeof(g_test_cvar_schema) / sizeof(g_test_cvar_schema[0]); ++i )
+    {
+        _values[g_test_cvar_schema[i].enum_key].default_value = g_test_cvar_schema[i].default_value;
+    }
+
+    _registry->schema       = g_test_cvar_schema;
+    _registry->schema_count = sizeof(g_test_cvar_schema) / sizeof(g_test_cvar_schema[0]);
+    _registry->values       = _values;
+    _registry->values_count = TEST_CVAR_COUNT;
+    _registry->flags        = _flags;
+}
+
+
+/*
+d_tests_sa_cvar_registry_build_lookup
+  Tests d_cvar_registry_build_lookup and d_cvar_registry_drop_lookup.
+  Tests the following:
+  - NULL registry fails
+  - a valid schema builds a power-of-two table at load <= 1/2
+  - alias rows sharing an enum_key are accepted
+  - a name bound to two enum_keys fails and leaves no lookup
+  - drop frees the table
+*/
+bool
+d_tests_sa_cvar_registry_build_lookup
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_cvar_registry  reg;
+    struct d_registry_value values[TEST_CVAR_COUNT];
+
+    struct d_registry_schema_row conflicting[] =
+    {
+        D_REGISTRY_SCHEMA_ROW("a", NULL, 0, 0, NULL, NULL),
+        D_REGISTRY_SCHEMA_ROW("b", "a",  1, 0, NULL, NULL)
+    };
+
+    result = true;
+
+    // test 1: NULL
+    result = d_assert_standalone(
+        d_cvar_registry_build_lookup(NULL) == false,
+        "cvar_build_null",
+        "Building for a NULL registry should fail",
+        _counter) && result;
+
+    // test 2: valid schema (6 names incl. a repeated alias)
+    test_cvar_init(&reg, values, D_CVAR_REGISTRY_FLAG_NONE);
+
+    result = d_assert_standalone(
+        d_cvar_registry_build_lookup(&reg) == true
+        && reg.lookup != NULL
+        && reg.lookup_capacity >= 12u
+        && (reg.lookup_capacity & (reg.lookup_capacity - 1u)) == 0u,
+        "cvar_build_ok",
+        "A valid schema should build a power-of-two lookup",
+        _counter) && result;
+
+    // test 3: conflicting names
+    reg.schema       = conflicting;
+    reg.schema_count = 2u;
+
+    result = d_assert_standalone(
+        d_cvar_registry_build_lookup(&reg) == false
+        && reg.lookup == NULL,
+        "cvar_build_conflict",
+        "A name bound to two enum_keys should fail",
+        _counter) && result;
+
+    // test 4: drop
+    test_cvar_init(&reg, values, D_CVAR_REGISTRY_FLAG_NONE);
+    d_cvar_registry_build_lookup(&reg);
+    d_cvar_registry_drop_lookup(&reg);
+    d_cvar_registry_drop_lookup(NULL);
+
+    result = d_assert_standalone(
+        reg.lookup == NULL
+        && reg.lookup_capacity == 0u,
+        "cvar_drop",
+        "Dropping should clear the lookup",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_cvar_registry_find
+  Tests d_cvar_registry_find with and without a lookup.
+  Tests the following:
+  - keys, abbreviations and alias rows resolve to their enum_key
+  - unknown names and NULL arguments fail
+  - results match the schema-scan fallback
+*/
+bool
+d_tests_sa_cvar_registry_find
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    int                     pass;
+    struct d_cvar_registry  reg;
+    struct d_registry_value values[TEST_CVAR_COUNT];
+    uint16_t                a;
+    uint16_t                b;
+    uint16_t                c;
+
+    result = true;
+
+    test_cvar_init(&reg, values, D_CVAR_REGISTRY_FLAG_NONE);
+
+    // pass 0 scans the schema, pass 1 uses the lookup
+    for ( pass = 0; pass < 2; ++pass )
+    {
+        if ( pass == 1 )
+        {
+            d_cvar_registry_build_lookup(&reg);
+        }
+
+        // test 1: keys and abbreviations
+        a = b = c = 0xFFFFu;
+
+        result = d_assert_standalone(
+            d_cvar_registry_find(&reg, "sv_gravity", &a)
+            && d_cvar_registry_find(&reg, "maxp", &b)
+            && d_cvar_registry_find(&reg, "sv_hostname", &c)
+            && a == TEST_CVAR_GRAVITY
+            && b == TEST_CVAR_MAXPLAYERS
+            && c == TEST_CVAR_HOSTNAME,
+            pass ? "cvar_find_hash" : "cvar_find_scan",
+            "Keys, abbreviations and aliases should resolve",
+            _counter) && result;
+
+        // test 2: misses
+        result = d_assert_standalone(
+            !d_cvar_registry_find(&reg, "sv_cheats", &a)
+            && !d_cvar_registry_find(&reg, "", &a)
+            && !d_cvar_registry_find(&reg, NULL, &a)
+            && !d_cvar_registry_find(NULL, "grav", &a)
+            && d_cvar_registry_find(&reg, "grav", NULL),
+            pass ? "cvar_find_hash_miss" : "cvar_find_scan_miss",
+            "Unknown names and NULL arguments should fail",
+            _counter) && result;
+    }
+
+    d_cvar_registry_drop_lookup(&reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_cvar_registry_find_case
+  Tests case handling of d_cvar_registry_find.
+  Tests the following:
+  - by default names match ignoring ASCII case
+  - with D_CVAR_REGISTRY_FLAG_CASE_SENSITIVE only exact names match
+*/
+bool
+d_tests_sa_cvar_registry_find_case
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_cvar_registry  reg;
+    struct d_registry_value values[TEST_CVAR_COUNT];
+    uint16_t                k;
+
+    result = true;
+
+    // test 1: case-insensitive
+    test_cvar_init(&reg, values, D_CVAR_REGISTRY_FLAG_NONE);
+    d_cvar_registry_build_lookup(&reg);
+
+    result = d_assert_standalone(
+        d_cvar_registry_find(&reg, "SV_Gravity", &k)
+        && k == TEST_CVAR_GRAVITY
+        && d_cvar_registry_find(&reg, "MAXP", &k)
+        && k == TEST_CVAR_MAXPLAYERS,
+        "cvar_find_nocase",
+        "Names should match ignoring case by default",
+        _counter) && result;
+
+    d_cvar_registry_drop_lookup(&reg);
+
+    // test 2: case-sensitive
+    test_cvar_init(&reg, values, D_CVAR_REGISTRY_FLAG_CASE_SENSITIVE);
+    d_cvar_registry_build_lookup(&reg);
+
+    result = d_assert_standalone(
+        !d_cvar_registry_find(&reg, "SV_Gravity", &k)
+        && d_cvar_registry_find(&reg, "sv_gravity", &k)
+        && k == TEST_CVAR_GRAVITY,
+        "cvar_find_case",
+        "Case-sensitive registries should match exact names only",
+        _counter) && result;
+
+    d_cvar_registry_drop_lookup(&reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_cvar_registry_value_by_name
+  Tests d_cvar_registry_value_by_name.
+  Tests the following:
+  - names resolve to &values[enum_key]
+  - unknown names and out-of-range enum_keys return NULL
+*/
+bool
+d_tests_sa_cvar_registry_value_by_name
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_cvar_registry  reg;
+    struct d_registry_value values[TEST_CVAR_COUNT];
+
+    result = true;
+
+    test_cvar_init(&reg, values, D_CVAR_REGISTRY_FLAG_NONE);
+    d_cvar_registry_build_lookup(&reg);
+
+    // test 1: slot
+    result = d_assert_standalone(
+        d_cvar_registry_value_by_name(&reg, "grav") == &values[TEST_CVAR_GRAVITY]
+        && d_cvar_registry_value_by_name(&reg, "hostname") == &values[TEST_CVAR_HOSTNAME],
+        "cvar_value_by_name",
+        "Names should resolve to their value slot",
+        _counter) && result;
+
+    // test 2: misses
+    reg.values_count = TEST_CVAR_HOSTNAME;
+
+    result = d_assert_standalone(
+        d_cvar_registry_value_by_name(&reg, "nope") == NULL
+        && d_cvar_registry_value_by_name(&reg, "hostname") == NULL,
+        "cvar_value_by_name_miss",
+        "Unknown or out-of-range names should return NULL",
+        _counter) && result;
+
+    d_cvar_registry_drop_lookup(&reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_cvar_registry_get_set
+  Tests d_cvar_registry_get, d_cvar_registry_set and d_cvar_registry_reset.
+  Tests the following:
+  - unset slots read their default
+  - set stores an unowned pointer
+  - reset falls back to the default
+  - out-of-range enum_keys are rejected
+*/
+bool
+d_tests_sa_cvar_registry_get_set
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_cvar_registry  reg;
+    struct d_registry_value values[TEST_CVAR_COUNT];
+    int                     gravity;
+
+    result = true;
+
+    test_cvar_init(&reg, values, D_CVAR_REGISTRY_FLAG_NONE);
+
+    // test 1: defaults
+    result = d_assert_standalone(
+        D_CVAR_REGISTRY_GET_AS(&reg, TEST_CVAR_GRAVITY, int) == 800
+        && d_cvar_registry_get(&reg, TEST_CVAR_HOSTNAME) == g_test_default_hostname,
+        "cvar_get_default",
+        "Unset cvars should read their default",
+        _counter) && result;
+
+    // test 2: unowned pointer
+    gravity = 400;
+
+    result = d_assert_standalone(
+        d_cvar_registry_set(&reg, TEST_CVAR_GRAVITY, &gravity)
+        && d_cvar_registry_get(&reg, TEST_CVAR_GRAVITY) == &gravity
+        && (values[TEST_CVAR_GRAVITY].flags & D_REGISTRY_VALUE_FLAG_OWNED) == 0u,
+        "cvar_set_pointer",
+        "set should store the caller's pointer",
+        _counter) && result;
+
+    // test 3: reset
+    result = d_assert_standalone(
+        d_cvar_registry_reset(&reg, TEST_CVAR_GRAVITY)
+        && D_CVAR_REGISTRY_GET_AS(&reg, TEST_CVAR_GRAVITY, int) == 800,
+        "cvar_reset",
+        "reset should restore the default",
+        _counter) && result;
+
+    // test 4: out of range
+    result = d_assert_standalone(
+        d_cvar_registry_get(&reg, TEST_CVAR_COUNT) == NULL
+        && !d_cvar_registry_set(&reg, TEST_CVAR_COUNT, &gravity)
+        && !d_cvar_registry_reset(&reg, TEST_CVAR_COUNT)
+        && d_cvar_registry_get(NULL, 0) == NULL,
+        "cvar_get_range",
+        "Out-of-range enum_keys should be rejected",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_cvar_registry_set_copy
+  Tests d_cvar_registry_set_copy.
+  Tests the following:
+  - values are boxed into registry-owned memory
+  - setting the same size again reuses the box
+  - a different size replaces the box
+  - set releases an owned box
+*/
+bool
+d_tests_sa_cvar_registry_set_copy
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_cvar_registry  reg;
+    struct d_registry_value values[TEST_CVAR_COUNT];
+    void*                   box;
+    int                     players;
+
+    result = true;
+
+    test_cvar_init(&reg, values, D_CVAR_REGISTRY_FLAG_NONE);
+
+    // test 1: boxed
+    players = 32;
+
+    result = d_assert_standalone(
+        D_CVAR_REGISTRY_SET_AS(&reg, TEST_CVAR_MAXPLAYERS, int, players)
+        && D_CVAR_REGISTRY_GET_AS(&reg, TEST_CVAR_MAXPLAYERS, int) == 32
+        && (values[TEST_CVAR_MAXPLAYERS].flags & D_REGISTRY_VALUE_FLAG_OWNED) != 0u
+        && values[TEST_CVAR_MAXPLAYERS].value != &players,
+        "cvar_set_copy",
+        "set_copy should box the value",
+        _counter) && result;
+
+    // test 2: reuse
+    box = values[TEST_CVAR_MAXPLAYERS].value;
+
+    result = d_assert_standalone(
+        D_CVAR_REGISTRY_SET_AS(&reg, TEST_CVAR_MAXPLAYERS, int, 64)
+        && values[TEST_CVAR_MAXPLAYERS].value == box
+        && D_CVAR_REGISTRY_GET_AS(&reg, TEST_CVAR_MAXPLAYERS, int) == 64,
+        "cvar_set_copy_reuse",
+        "Same-size sets should reuse the box",
+        _counter) && result;
+
+    // test 3: resize
+    result = d_assert_standalone(
+        D_CVAR_REGISTRY_SET_AS(&reg, TEST_CVAR_MAXPLAYERS, int64_t, 128)
+        && values[TEST_CVAR_MAXPLAYERS].size == sizeof(int64_t)
+        && D_CVAR_REGISTRY_GET_AS(&reg, TEST_CVAR_MAXPLAYERS, int64_t) == 128,
+        "cvar_set_copy_resize",
+        "A different size should replace the box",
+        _counter) && result;
+
+    // test 4: set releases the box
+    result = d_assert_standalone(
+        d_cvar_registry_set(&reg, TEST_CVAR_MAXPLAYERS, &players)
+        && values[TEST_CVAR_MAXPLAYERS].size == 0u
+        && D_CVAR_REGISTRY_GET_AS(&reg, TEST_CVAR_MAXPLAYERS, int) == 32
+        && !d_cvar_registry_set_copy(&reg, TEST_CVAR_MAXPLAYERS, NULL, 4u),
+        "cvar_set_releases",
+        "set should release an owned box",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_cvar_registry_lookup_all
+  Aggregation function that runs all cvar lookup and typed access tests.
+*/
+bool
+d_tests_sa_cvar_registry_lookup_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Cvar Lookup and Typed Access (d_cvar_registry_*)\n");
+    printf("  ------------------------------------------------------------\n");
+
+    result = d_tests_sa_cvar_registry_build_lookup(_counter) && result;
+    result = d_tests_sa_cvar_registry_find(_counter) && result;
+    result = d_tests_sa_cvar_registry_find_case(_counter) && result;
+    result = d_tests_sa_cvar_registry_value_by_name(_counter) && result;
+    result = d_tests_sa_cvar_registry_get_set(_counter) && result;
+    result = d_tests_sa_cvar_registry_set_copy(_counter) && result;
+
+    return result;
+}
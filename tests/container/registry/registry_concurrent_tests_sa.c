@@ -0,0 +1,26 @@
+#include ".\registry_concurrent_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_concurrent_run_all
+  Module-level aggregation function that runs all registry_concurrent tests.
+  Executes tests for all categories:
+  - Reader functions (slots, read sections)
+  - Writer functions (drafts, publication, reclamation)
+*/
+bool
+d_tests_sa_registry_concurrent_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_registry_concurrent_readers_all(_counter) && result;
+    result = d_tests_sa_registry_concurrent_writers_all(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+* djinterp [test]                                registry_concurrent_tests_sa.h
+*
+*   Unit test declarations for `registry_concurrent.h` module.
+*   Exercises reader slot management, snapshot publication and epoch-based
+* reclamation. Tests are single-threaded: interleavings are staged by hand so
+* that reclamation decisions are deterministic.
+*
+*
+* path:      \tests\container\registry\registry_concurrent_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_REGISTRY_CONCURRENT_SA_
+#define DJINTERP_TESTS_REGISTRY_CONCURRENT_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\registry\registry_concurrent.h"
+#include "..\..\..\inc\string_fn.h"
+
+
+/******************************************************************************
+ * TEST HELPER TYPES
+ *****************************************************************************/
+
+struct test_concurrent_row
+{
+    const char* key;
+    int         value;
+};
+
+
+/******************************************************************************
+ * I. READER FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_concurrent_new(struct d_test_counter* _counter);
+bool d_tests_sa_registry_concurrent_reader_register(struct d_test_counter* _counter);
+bool d_tests_sa_registry_concurrent_read_section(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_registry_concurrent_readers_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. WRITER FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_concurrent_publish(struct d_test_counter* _counter);
+bool d_tests_sa_registry_concurrent_reclaim(struct d_test_counter* _counter);
+bool d_tests_sa_registry_concurrent_helpers(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_registry_concurrent_writers_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_registry_concurrent_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_REGISTRY_CONCURRENT_SA_
@@ -0,0 +1,261 @@
+#include ".\registry_concurrent_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_concurrent_new
+  Tests d_registry_concurrent_new and d_registry_concurrent_free.
+  Tests the following:
+  - NULL registry returns NULL
+  - OWNS_ROWS registries are rejected
+  - the registry becomes the first, frozen snapshot
+  - free(NULL) does not crash
+*/
+bool
+d_tests_sa_registry_concurrent_new
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct d_registry*            reg;
+    struct d_registry_concurrent* c;
+    struct test_concurrent_row    row;
+
+    result = true;
+
+    // test 1: NULL registry
+    result = d_assert_standalone(
+        d_registry_concurrent_new(NULL) == NULL,
+        "concurrent_new_null",
+        "NULL registry should return NULL",
+        _counter) && result;
+
+    d_registry_concurrent_free(NULL);
+
+    reg = d_registry_new(sizeof(struct test_concurrent_row));
+
+    if (reg)
+    {
+        // test 2: OWNS_ROWS rejected
+        reg->flags |= (uint8_t)D_REGISTRY_FLAG_OWNS_ROWS;
+
+        result = d_assert_standalone(
+            d_registry_concurrent_new(reg) == NULL,
+            "concurrent_new_owns_rows",
+            "OWNS_ROWS registries should be rejected",
+            _counter) && result;
+
+        reg->flags &= (uint8_t)~D_REGISTRY_FLAG_OWNS_ROWS;
+
+        row.key = "alpha";  row.value = 1;
+        d_registry_add(reg, &row);
+
+        // test 3: first snapshot
+        c = d_registry_concurrent_new(reg);
+
+        result = d_assert_standalone(
+            c != NULL
+            && atomic_load(&c->current) == reg
+            && D_REGISTRY_IS_FROZEN(reg)
+            && c->draft == NULL
+            && c->retired_count == 0,
+            "concurrent_new_ok",
+            "Registry should be published frozen",
+            _counter) && result;
+
+        if (c)
+        {
+            d_registry_concurrent_free(c);
+        }
+        else
+        {
+            d_registry_free(reg);
+        }
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_concurrent_reader_register
+  Tests reader slot registration.
+  Tests the following:
+  - NULL wrapper returns -1
+  - slots are handed out until exhausted, then -1
+  - unregistered slots are reused
+*/
+bool
+d_tests_sa_registry_concurrent_reader_register
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct d_registry_concurrent* c;
+    int                           ids[D_REGISTRY_CONCURRENT_MAX_READERS];
+    int                           i;
+    bool                          distinct;
+
+    result = true;
+
+    // test 1: NULL wrapper
+    result = d_assert_standalone(
+        d_registry_concurrent_reader_register(NULL) == -1,
+        "reader_register_null",
+        "NULL wrapper should return -1",
+        _counter) && result;
+
+    c = d_registry_concurrent_new(d_registry_new(sizeof(struct test_concurrent_row)));
+
+    if (c)
+    {
+        // test 2: exhaust the slots
+        distinct = true;
+
+        for (i = 0; i < D_REGISTRY_CONCURRENT_MAX_READERS; ++i)
+        {
+            ids[i] = d_registry_concurrent_reader_register(c);
+
+            if (ids[i] != i)
+            {
+                distinct = false;
+            }
+        }
+
+        result = d_assert_standalone(
+            distinct
+            && d_registry_concurrent_reader_register(c) == -1,
+            "reader_register_exhaust",
+            "Every slot should be handed out once",
+            _counter) && result;
+
+        // test 3: reuse
+        d_registry_concurrent_reader_unregister(c, ids[5]);
+
+        result = d_assert_standalone(
+            d_registry_concurrent_reader_register(c) == 5,
+            "reader_register_reuse",
+            "Released slots should be reused",
+            _counter) && result;
+
+        d_registry_concurrent_free(c);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_concurrent_read_section
+  Tests d_registry_concurrent_read_begin / read_end.
+  Tests the following:
+  - invalid reader ids return NULL
+  - read_begin returns the current snapshot and records the epoch
+  - keys resolve through the snapshot
+  - read_end clears the reader's epoch
+*/
+bool
+d_tests_sa_registry_concurrent_read_section
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct d_registry*            reg;
+    struct d_registry_concurrent* c;
+    struct test_concurrent_row    row;
+    struct test_concurrent_row*   found;
+    const struct d_registry*      snap;
+    int                           id;
+
+    result = true;
+
+    reg = d_registry_new(sizeof(struct test_concurrent_row));
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    row.key = "alpha";  row.value = 1;
+    d_registry_add(reg, &row);
+    row.key = "beta";   row.value = 2;
+    d_registry_add(reg, &row);
+
+    c = d_registry_concurrent_new(reg);
+
+    if (c)
+    {
+        // test 1: invalid ids
+        result = d_assert_standalone(
+            d_registry_concurrent_read_begin(c, -1) == NULL
+            && d_registry_concurrent_read_begin(c, D_REGISTRY_CONCURRENT_MAX_READERS) == NULL
+            && d_registry_concurrent_read_begin(NULL, 0) == NULL,
+            "read_begin_invalid",
+            "Invalid reader ids should return NULL",
+            _counter) && result;
+
+        id   = d_registry_concurrent_reader_register(c);
+        snap = d_registry_concurrent_read_begin(c, id);
+
+        // test 2: snapshot and epoch
+        result = d_assert_standalone(
+            snap == reg
+            && atomic_load(&c->readers[id].epoch) == atomic_load(&c->epoch),
+            "read_begin_snapshot",
+            "read_begin should return the current snapshot",
+            _counter) && result;
+
+        // test 3: lookups
+        found = D_REGISTRY_GET(snap, "beta", struct test_concurrent_row);
+
+        result = d_assert_standalone(
+            found != NULL && found->value == 2,
+            "read_section_get",
+            "Keys should resolve through the snapshot",
+            _counter) && result;
+
+        // test 4: read_end
+        d_registry_concurrent_read_end(c, id);
+
+        result = d_assert_standalone(
+            atomic_load(&c->readers[id].epoch) == 0,
+            "read_end_clears",
+            "read_end should clear the reader epoch",
+            _counter) && result;
+
+        d_registry_concurrent_free(c);
+    }
+    else
+    {
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_concurrent_readers_all
+  Aggregation function that runs all reader tests.
+*/
+bool
+d_tests_sa_registry_concurrent_readers_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Reader Functions\n");
+    printf("  --------------------------\n");
+
+    result = d_tests_sa_registry_concurrent_new(_counter) && result;
+    result = d_tests_sa_registry_concurrent_reader_register(_counter) && result;
+    result = d_tests_sa_registry_concurrent_read_section(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,370 @@
+#include ".\registry_concurrent_tests_sa.h"
+
+
+/*
+test_concurrent_make
+  Helper: builds a wrapper over a registry holding "alpha" (1) and
+  "beta" (2).
+*/
+static struct d_registry_concurrent*
+test_concurrent_make
+(
+    void
+)
+{
+    struct d_registry*            reg;
+    struct d_registry_concurrent* c;
+    struct test_concurrent_row    row;
+
+    reg = d_registry_new(sizeof(struct test_concurrent_row));
+
+    if (!reg)
+    {
+        return NULL;
+    }
+
+    row.key = "alpha";  row.value = 1;
+    d_registry_add(reg, &row);
+    row.key = "beta";   row.value = 2;
+    d_registry_add(reg, &row);
+
+    c = d_registry_concurrent_new(reg);
+
+    if (!c)
+    {
+        d_registry_free(reg);
+    }
+
+    return c;
+}
+
+
+/*
+d_tests_sa_registry_concurrent_publish
+  Tests d_registry_concurrent_write_begin, publish and write_abort.
+  Tests the following:
+  - publish without a draft fails
+  - write_begin returns a thawed private copy, reused until publish
+  - draft changes are invisible to readers until publish
+  - a reader inside a read section keeps its snapshot across a publish
+  - publish advances the epoch and freezes the new snapshot
+  - write_abort discards the draft
+*/
+bool
+d_tests_sa_registry_concurrent_publish
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct d_registry_concurrent* c;
+    struct d_registry*            draft;
+    struct test_concurrent_row    row;
+    const struct d_registry*      before;
+    const struct d_registry*      after;
+    int                           id;
+    uint64_t                      epoch;
+
+    result = true;
+
+    c = test_concurrent_make();
+
+    if (!c)
+    {
+        return result;
+    }
+
+    // test 1: no draft
+    result = d_assert_standalone(
+        d_registry_concurrent_publish(c) == false,
+        "publish_no_draft",
+        "publish without a draft should fail",
+        _counter) && result;
+
+    // test 2: draft
+    draft = d_registry_concurrent_write_begin(c);
+
+    result = d_assert_standalone(
+        draft != NULL
+        && draft != atomic_load(&c->current)
+        && !D_REGISTRY_IS_FROZEN(draft)
+        && d_registry_concurrent_write_begin(c) == draft,
+        "write_begin_draft",
+        "write_begin should return one thawed private copy",
+        _counter) && result;
+
+    // test 3: invisible until publish
+    row.key = "gamma";  row.value = 3;
+    d_registry_add(draft, &row);
+
+    id     = d_registry_concurrent_reader_register(c);
+    before = d_registry_concurrent_read_begin(c, id);
+
+    result = d_assert_standalone(
+        d_registry_get(before, "gamma") == NULL,
+        "publish_invisible",
+        "Draft changes should not be visible before publish",
+        _counter) && result;
+
+    // test 4: reader keeps its snapshot
+    epoch = atomic_load(&c->epoch);
+
+    result = d_assert_standalone(
+        d_registry_concurrent_publish(c) == true
+        && d_registry_get(before, "alpha") != NULL
+        && d_registry_get(before, "gamma") == NULL
+        && c->retired_count == 1,
+        "publish_reader_keeps",
+        "An active reader should keep its old snapshot",
+        _counter) && result;
+
+    d_registry_concurrent_read_end(c, id);
+
+    // test 5: new snapshot
+    after = d_registry_concurrent_read_begin(c, id);
+
+    result = d_assert_standalone(
+        after == draft
+        && D_REGISTRY_IS_FROZEN(after)
+        && d_registry_get(after, "gamma") != NULL
+        && atomic_load(&c->epoch) == epoch + 1
+        && c->draft == NULL,
+        "publish_new_snapshot",
+        "New read sections should see the published draft",
+        _counter) && result;
+
+    d_registry_concurrent_read_end(c, id);
+
+    // test 6: abort
+    draft = d_registry_concurrent_write_begin(c);
+    row.key = "delta";  row.value = 4;
+    d_registry_add(draft, &row);
+    d_registry_concurrent_write_abort(c);
+
+    result = d_assert_standalone(
+        c->draft == NULL
+        && d_registry_get(atomic_load(&c->current), "delta") == NULL,
+        "write_abort",
+        "Aborted drafts should never be published",
+        _counter) && result;
+
+    d_registry_concurrent_free(c);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_concurrent_reclaim
+  Tests epoch-based reclamation of retired snapshots.
+  Tests the following:
+  - with no readers, publish frees the old snapshot immediately
+  - a reader that entered before a publish pins the old snapshot
+  - a reader that entered after the publish does not pin it
+  - reclaim frees the snapshot once the old reader leaves
+*/
+bool
+d_tests_sa_registry_concurrent_reclaim
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct d_registry_concurrent* c;
+    struct test_concurrent_row    row;
+    int                           old_reader;
+    int                           new_reader;
+
+    result = true;
+
+    c = test_concurrent_make();
+
+    if (!c)
+    {
+        return result;
+    }
+
+    // test 1: no readers
+    row.key = "gamma";  row.value = 3;
+    d_registry_concurrent_add(c, &row);
+
+    result = d_assert_standalone(
+        c->retired_count == 0
+        && d_registry_concurrent_reclaim(c) == 0,
+        "reclaim_no_readers",
+        "Without readers old snapshots should be freed at once",
+        _counter) && result;
+
+    // test 2: pinned by an old reader
+    old_reader = d_registry_concurrent_reader_register(c);
+    new_reader = d_registry_concurrent_reader_register(c);
+
+    d_registry_concurrent_read_begin(c, old_reader);
+
+    row.key = "delta";  row.value = 4;
+    d_registry_concurrent_add(c, &row);
+
+    result = d_assert_standalone(
+        c->retired_count == 1,
+        "reclaim_pinned",
+        "A reader inside an older epoch should pin the snapshot",
+        _counter) && result;
+
+    // test 3: newer readers do not pin
+    d_registry_concurrent_read_begin(c, new_reader);
+
+    result = d_assert_standalone(
+        d_registry_concurrent_reclaim(c) == 1,
+        "reclaim_new_reader",
+        "Old snapshot should stay until the old reader leaves",
+        _counter) && result;
+
+    // test 4: old reader leaves
+    d_registry_concurrent_read_end(c, old_reader);
+
+    result = d_assert_standalone(
+        d_registry_concurrent_reclaim(c) == 0
+        && c->retired == NULL,
+        "reclaim_after_leave",
+        "Snapshot should be freed once no reader can reach it",
+        _counter) && result;
+
+    d_registry_concurrent_read_end(c, new_reader);
+    d_registry_concurrent_free(c);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_concurrent_helpers
+  Tests d_registry_concurrent_add, add_alias and remove.
+  Tests the following:
+  - NULL arguments return false
+  - without a draft each change is published immediately
+  - a failing change is not published and leaves no draft
+  - with an open draft changes accumulate until publish
+*/
+bool
+d_tests_sa_registry_concurrent_helpers
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct d_registry_concurrent* c;
+    struct test_concurrent_row    row;
+    const struct d_registry*      snap;
+    uint64_t                      epoch;
+
+    result = true;
+
+    // test 1: NULL arguments
+    row.key = "x";  row.value = 0;
+
+    result = d_assert_standalone(
+        d_registry_concurrent_add(NULL, &row) == false
+        && d_registry_concurrent_add_alias(NULL, "a", "b") == false
+        && d_registry_concurrent_remove(NULL, "a") == false,
+        "helpers_null",
+        "NULL wrapper should return false",
+        _counter) && result;
+
+    c = test_concurrent_make();
+
+    if (!c)
+    {
+        return result;
+    }
+
+    // test 2: immediate publication
+    row.key = "gamma";  row.value = 3;
+
+    result = d_assert_standalone(
+        d_registry_concurrent_add(c, &row)
+        && d_registry_concurrent_add_alias(c, "gamma", "g")
+        && d_registry_concurrent_remove(c, "alpha"),
+        "helpers_immediate_ok",
+        "Single changes should succeed",
+        _counter) && result;
+
+    snap = atomic_load(&c->current);
+
+    result = d_assert_standalone(
+        d_registry_get(snap, "g") != NULL
+        && d_registry_get(snap, "alpha") == NULL
+        && c->draft == NULL,
+        "helpers_immediate_visible",
+        "Single changes should be published at once",
+        _counter) && result;
+
+    // test 3: failure
+    epoch = atomic_load(&c->epoch);
+    row.key = "beta";  row.value = 9;
+
+    result = d_assert_standalone(
+        d_registry_concurrent_add(c, &row) == false
+        && d_registry_concurrent_remove(c, "missing") == false
+        && atomic_load(&c->epoch) == epoch
+        && c->draft == NULL,
+        "helpers_failure",
+        "Failed changes should not publish",
+        _counter) && result;
+
+    // test 4: batched through an open draft
+    d_registry_concurrent_write_begin(c);
+
+    row.key = "delta";    row.value = 4;
+    d_registry_concurrent_add(c, &row);
+    row.key = "epsilon";  row.value = 5;
+    d_registry_concurrent_add(c, &row);
+
+    snap = atomic_load(&c->current);
+
+    result = d_assert_standalone(
+        d_registry_get(snap, "delta") == NULL
+        && atomic_load(&c->epoch) == epoch,
+        "helpers_batched_pending",
+        "Changes to an open draft should wait for publish",
+        _counter) && result;
+
+    d_registry_concurrent_publish(c);
+    snap = atomic_load(&c->current);
+
+    result = d_assert_standalone(
+        d_registry_get(snap, "delta") != NULL
+        && d_registry_get(snap, "epsilon") != NULL
+        && atomic_load(&c->epoch) == epoch + 1,
+        "helpers_batched_publish",
+        "One publish should expose all batched changes",
+        _counter) && result;
+
+    d_registry_concurrent_free(c);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_concurrent_writers_all
+  Aggregation function that runs all writer tests.
+*/
+bool
+d_tests_sa_registry_concurrent_writers_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Writer Functions\n");
+    printf("  --------------------------\n");
+
+    result = d_tests_sa_registry_concurrent_publish(_counter) && result;
+    result = d_tests_sa_registry_concurrent_reclaim(_counter) && result;
+    result = d_tests_sa_registry_concurrent_helpers(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,27 @@
+#include ".\registry_cvar_versioned_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_cvar_versioned_run_all
+  Module-level aggregation function that runs all registry_cvar_versioned
+  tests.
+  Executes tests for all categories:
+  - Reader functions (snapshots, version polling)
+  - Writer functions (staging, publication, dirty tracking, reclamation)
+*/
+bool
+d_tests_sa_registry_cvar_versioned_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_registry_cvar_versioned_readers_all(_counter) && result;
+    result = d_tests_sa_registry_cvar_versioned_writers_all(_counter) && result;
+
+    return result;
+}
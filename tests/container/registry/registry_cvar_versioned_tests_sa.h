@@ -0,0 +1,78 @@
+/******************************************************************************
+* djinterp [test]                            registry_cvar_versioned_tests_sa.h
+*
+*   Unit test declarations for `registry_cvar_versioned.h` module.
+*   Exercises snapshot publication, version polling, dirty tracking and
+* epoch-based reclamation. Tests are single-threaded: interleavings are
+* staged by hand so that reclamation decisions are deterministic.
+*
+*
+* path:      \tests\container\registry\registry_cvar_versioned_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_REGISTRY_CVAR_VERSIONED_SA_
+#define DJINTERP_TESTS_REGISTRY_CVAR_VERSIONED_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\registry\registry_cvar_versioned.h"
+#include "..\..\..\inc\string_fn.h"
+
+
+/******************************************************************************
+ * TEST HELPER TYPES
+ *****************************************************************************/
+
+enum test_versioned_cvar
+{
+    TEST_VCVAR_GRAVITY = 0,
+    TEST_VCVAR_FRICTION,
+    TEST_VCVAR_TICKRATE,
+    TEST_VCVAR_COUNT
+};
+
+// test_versioned_fixture
+//   registry plus the storage it points at.
+struct test_versioned_fixture
+{
+    struct d_cvar_registry  registry;
+    struct d_registry_value values[TEST_VCVAR_COUNT];
+};
+
+
+/******************************************************************************
+ * I. READER FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_cvar_versioned_new(struct d_test_counter* _counter);
+bool d_tests_sa_registry_cvar_versioned_read_section(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_registry_cvar_versioned_readers_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. WRITER FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_cvar_versioned_publish(struct d_test_counter* _counter);
+bool d_tests_sa_registry_cvar_versioned_dirty(struct d_test_counter* _counter);
+bool d_tests_sa_registry_cvar_versioned_reclaim(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_registry_cvar_versioned_writers_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_registry_cvar_versioned_run_all(struct d_test_counter* _counter);
+
+// test_versioned_init
+//   helper (readers section): zeroed fixture with defaults 1, 2, 3.
+void test_versioned_init(struct test_versioned_fixture* _fixture);
+
+
+#endif  // DJINTERP_TESTS_REGISTRY_CVAR_VERSIONED_SA_
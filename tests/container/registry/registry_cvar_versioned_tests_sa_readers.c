@@ -0,0 +1,213 @@
+#include ".\registry_cvar_versioned_tests_sa.h"
+
+
+static const int g_test_vcvar_defaults[TEST_VCVAR_COUNT] = { 1, 2, 3 };
+
+
+/*
+test_versioned_init
+  Helper: zeroed fixture over TEST_VCVAR_COUNT values whose defaults are
+  1, 2 and 3.
+*/
+void
+test_versioned_init
+(
+    struct test_versioned_fixture* _fixture
+)
+{
+    size_t i;
+
+    memset(_fixture, 0, sizeof(*_fixture));
+
+    for (i = 0; i < TEST_VCVAR_COUNT; ++i)
+    {
+        _fixture->values[i].default_value = &g_test_vcvar_defaults[i];
+    }
+
+    _fixture->registry.values       = _fixture->values;
+    _fixture->registry.values_count = TEST_VCVAR_COUNT;
+}
+
+
+/*
+d_tests_sa_registry_cvar_versioned_new
+  Tests d_cvar_versioned_new and d_cvar_versioned_free.
+  Tests the following:
+  - NULL registry returns NULL
+  - the first snapshot is version 1 with every enum_key dirty
+  - unset cvars read their defaults
+  - free(NULL) does not crash
+*/
+bool
+d_tests_sa_registry_cvar_versioned_new
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct test_versioned_fixture f;
+    struct d_cvar_versioned*      v;
+    const struct d_cvar_snapshot* s;
+
+    result = true;
+
+    // test 1: NULL registry
+    result = d_assert_standalone(
+        d_cvar_versioned_new(NULL) == NULL,
+        "versioned_new_null",
+        "NULL registry should return NULL",
+        _counter) && result;
+
+    d_cvar_versioned_free(NULL);
+
+    test_versioned_init(&f);
+    v = d_cvar_versioned_new(&f.registry);
+
+    if (!v)
+    {
+        return result;
+    }
+
+    s = atomic_load(&v->current);
+
+    // test 2: version 1, all dirty
+    result = d_assert_standalone(
+        d_cvar_versioned_version(v) == 1
+        && s->version == 1
+        && s->count == TEST_VCVAR_COUNT
+        && s->dirty[0] == 0x7u
+        && s->changed_at[TEST_VCVAR_TICKRATE] == 1,
+        "versioned_new_first",
+        "The first snapshot should be version 1, all dirty",
+        _counter) && result;
+
+    // test 3: defaults
+    result = d_assert_standalone(
+        D_CVAR_SNAPSHOT_GET_AS(s, TEST_VCVAR_GRAVITY, int) == 1
+        && D_CVAR_SNAPSHOT_GET_AS(s, TEST_VCVAR_TICKRATE, int) == 3,
+        "versioned_new_defaults",
+        "Unset cvars should read their defaults",
+        _counter) && result;
+
+    d_cvar_versioned_free(v);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_cvar_versioned_read_section
+  Tests reader slots, read sections and version polling.
+  Tests the following:
+  - readers get distinct slots; invalid ids are rejected
+  - changed_since is false until a publish
+  - a reader keeps a consistent snapshot across a publish
+  - the next read section sees the new version
+*/
+bool
+d_tests_sa_registry_cvar_versioned_read_section
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct test_versioned_fixture f;
+    struct d_cvar_versioned*      v;
+    const struct d_cvar_snapshot* before;
+    const struct d_cvar_snapshot* after;
+    int                           a;
+    int                           b;
+    int                           gravity;
+
+    result = true;
+
+    test_versioned_init(&f);
+    v = d_cvar_versioned_new(&f.registry);
+
+    if (!v)
+    {
+        return result;
+    }
+
+    // test 1: slots
+    a = d_cvar_versioned_reader_register(v);
+    b = d_cvar_versioned_reader_register(v);
+
+    result = d_assert_standalone(
+        a >= 0
+        && b >= 0
+        && a != b
+        && d_cvar_versioned_read_begin(v, -1) == NULL
+        && d_cvar_versioned_read_begin(v, D_REGISTRY_CONCURRENT_MAX_READERS) == NULL,
+        "versioned_reader_slots",
+        "Readers should get distinct valid slots",
+        _counter) && result;
+
+    // test 2: polling
+    result = d_assert_standalone(
+        !d_cvar_versioned_changed_since(v, 1)
+        && d_cvar_versioned_changed_since(v, 0),
+        "versioned_changed_since",
+        "changed_since should compare against the published version",
+        _counter) && result;
+
+    // test 3: consistent snapshot across a publish
+    before  = d_cvar_versioned_read_begin(v, a);
+    gravity = 10;
+
+    d_cvar_versioned_set_copy(v, TEST_VCVAR_GRAVITY, &gravity, sizeof(gravity));
+    d_cvar_versioned_publish(v);
+
+    result = d_assert_standalone(
+        D_CVAR_SNAPSHOT_GET_AS(before, TEST_VCVAR_GRAVITY, int) == 1
+        && before->version == 1
+        && d_cvar_versioned_changed_since(v, before->version),
+        "versioned_reader_consistent",
+        "An open read section should keep its snapshot",
+        _counter) && result;
+
+    d_cvar_versioned_read_end(v, a);
+
+    // test 4: new version
+    after = d_cvar_versioned_read_begin(v, b);
+
+    result = d_assert_standalone(
+        after != NULL
+        && after->version == 2
+        && D_CVAR_SNAPSHOT_GET_AS(after, TEST_VCVAR_GRAVITY, int) == 10,
+        "versioned_reader_new",
+        "A new read section should see the published version",
+        _counter) && result;
+
+    d_cvar_versioned_read_end(v, b);
+    d_cvar_versioned_reader_unregister(v, a);
+    d_cvar_versioned_reader_unregister(v, b);
+    d_cvar_versioned_free(v);
+    d_cvar_registry_reset(&f.registry, TEST_VCVAR_GRAVITY);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_cvar_versioned_readers_all
+  Aggregation function that runs all reader tests.
+*/
+bool
+d_tests_sa_registry_cvar_versioned_readers_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Reader Functions\n");
+    printf("  --------------------------\n");
+
+    result = d_tests_sa_registry_cvar_versioned_new(_counter) && result;
+    result = d_tests_sa_registry_cvar_versioned_read_section(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,277 @@
+#include ".\registry_cvar_versioned_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_cvar_versioned_publish
+  Tests staging and d_cvar_versioned_publish.
+  Tests the following:
+  - publish with nothing staged keeps the version
+  - staged changes are invisible until publish
+  - boxed values are copied, so later sets do not leak into old snapshots
+  - out-of-range enum_keys are rejected
+*/
+bool
+d_tests_sa_registry_cvar_versioned_publish
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct test_versioned_fixture f;
+    struct d_cvar_versioned*      v;
+    const struct d_cvar_snapshot* s1;
+    const struct d_cvar_snapshot* s2;
+    int                           id;
+    int                           value;
+
+    result = true;
+
+    test_versioned_init(&f);
+    v = d_cvar_versioned_new(&f.registry);
+
+    if (!v)
+    {
+        return result;
+    }
+
+    // test 1: empty publish
+    result = d_assert_standalone(
+        d_cvar_versioned_publish(v) == true
+        && d_cvar_versioned_version(v) == 1
+        && v->retired_count == 0,
+        "publish_empty",
+        "Publishing nothing should keep the version",
+        _counter) && result;
+
+    // test 2: invisible until publish
+    value = 20;
+    d_cvar_versioned_set_copy(v, TEST_VCVAR_FRICTION, &value, sizeof(value));
+
+    result = d_assert_standalone(
+        D_CVAR_SNAPSHOT_GET_AS(atomic_load(&v->current), TEST_VCVAR_FRICTION, int) == 2
+        && d_cvar_versioned_version(v) == 1
+        && v->has_staged,
+        "publish_staged_invisible",
+        "Staged changes should wait for publish",
+        _counter) && result;
+
+    // test 3: boxed values are copied
+    id = d_cvar_versioned_reader_register(v);
+    d_cvar_versioned_publish(v);
+    s1 = d_cvar_versioned_read_begin(v, id);
+
+    value = 30;
+    d_cvar_versioned_set_copy(v, TEST_VCVAR_FRICTION, &value, sizeof(value));
+    d_cvar_versioned_publish(v);
+    s2 = atomic_load(&v->current);
+
+    result = d_assert_standalone(
+        s1->version == 2
+        && s2->version == 3
+        && D_CVAR_SNAPSHOT_GET_AS(s1, TEST_VCVAR_FRICTION, int) == 20
+        && D_CVAR_SNAPSHOT_GET_AS(s2, TEST_VCVAR_FRICTION, int) == 30
+        && s2->values[TEST_VCVAR_FRICTION] != f.values[TEST_VCVAR_FRICTION].value,
+        "publish_boxed_copy",
+        "Snapshots should hold their own copies of boxed values",
+        _counter) && result;
+
+    d_cvar_versioned_read_end(v, id);
+
+    // test 4: range
+    result = d_assert_standalone(
+        !d_cvar_versioned_set(v, TEST_VCVAR_COUNT, &value)
+        && !d_cvar_versioned_mark(v, TEST_VCVAR_COUNT)
+        && !d_cvar_versioned_reset(NULL, 0),
+        "publish_range",
+        "Out-of-range enum_keys should be rejected",
+        _counter) && result;
+
+    d_cvar_versioned_free(v);
+    d_cvar_registry_reset(&f.registry, TEST_VCVAR_FRICTION);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_cvar_versioned_dirty
+  Tests dirty bitsets and per-key change versions.
+  Tests the following:
+  - only the enum_keys staged for a version are dirty in it
+  - changed_at keeps the last version each enum_key changed in
+  - mark stages a change made directly through the registry
+  - reset stages a return to the default
+*/
+bool
+d_tests_sa_registry_cvar_versioned_dirty
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct test_versioned_fixture f;
+    struct d_cvar_versioned*      v;
+    const struct d_cvar_snapshot* s;
+    int                           tickrate;
+
+    result = true;
+
+    test_versioned_init(&f);
+    v = d_cvar_versioned_new(&f.registry);
+
+    if (!v)
+    {
+        return result;
+    }
+
+    // test 1: version 2 touches gravity only
+    tickrate = 64;
+    d_cvar_versioned_set(v, TEST_VCVAR_GRAVITY, &tickrate);
+    d_cvar_versioned_publish(v);
+    s = atomic_load(&v->current);
+
+    result = d_assert_standalone(
+        D_CVAR_SNAPSHOT_IS_DIRTY(s, TEST_VCVAR_GRAVITY)
+        && !D_CVAR_SNAPSHOT_IS_DIRTY(s, TEST_VCVAR_FRICTION)
+        && s->dirty[0] == 0x1u,
+        "dirty_single",
+        "Only staged enum_keys should be dirty",
+        _counter) && result;
+
+    // test 2: mark a direct registry change (version 3)
+    d_cvar_registry_set(&f.registry, TEST_VCVAR_TICKRATE, &tickrate);
+    d_cvar_versioned_mark(v, TEST_VCVAR_TICKRATE);
+    d_cvar_versioned_publish(v);
+    s = atomic_load(&v->current);
+
+    result = d_assert_standalone(
+        s->dirty[0] == 0x4u
+        && D_CVAR_SNAPSHOT_GET_AS(s, TEST_VCVAR_TICKRATE, int) == 64,
+        "dirty_mark",
+        "mark should stage a direct registry change",
+        _counter) && result;
+
+    // test 3: changed_at
+    result = d_assert_standalone(
+        s->changed_at[TEST_VCVAR_GRAVITY] == 2
+        && s->changed_at[TEST_VCVAR_FRICTION] == 1
+        && s->changed_at[TEST_VCVAR_TICKRATE] == 3
+        && D_CVAR_SNAPSHOT_CHANGED_SINCE(s, TEST_VCVAR_GRAVITY, 1)
+        && !D_CVAR_SNAPSHOT_CHANGED_SINCE(s, TEST_VCVAR_GRAVITY, 2),
+        "dirty_changed_at",
+        "changed_at should record each key's last change",
+        _counter) && result;
+
+    // test 4: reset (version 4)
+    d_cvar_versioned_reset(v, TEST_VCVAR_GRAVITY);
+    d_cvar_versioned_publish(v);
+    s = atomic_load(&v->current);
+
+    result = d_assert_standalone(
+        s->version == 4
+        && s->dirty[0] == 0x1u
+        && D_CVAR_SNAPSHOT_GET_AS(s, TEST_VCVAR_GRAVITY, int) == 1,
+        "dirty_reset",
+        "reset should publish the default as a change",
+        _counter) && result;
+
+    d_cvar_versioned_free(v);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_cvar_versioned_reclaim
+  Tests epoch-based reclamation of retired snapshots.
+  Tests the following:
+  - with no readers, publish frees the old snapshot immediately
+  - a reader that entered before a publish pins the old snapshot
+  - reclaim frees it once that reader leaves
+*/
+bool
+d_tests_sa_registry_cvar_versioned_reclaim
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                          result;
+    struct test_versioned_fixture f;
+    struct d_cvar_versioned*      v;
+    int                           id;
+    int                           value;
+
+    result = true;
+
+    test_versioned_init(&f);
+    v = d_cvar_versioned_new(&f.registry);
+
+    if (!v)
+    {
+        return result;
+    }
+
+    // test 1: no readers
+    value = 5;
+    d_cvar_versioned_set(v, TEST_VCVAR_GRAVITY, &value);
+    d_cvar_versioned_publish(v);
+
+    result = d_assert_standalone(
+        v->retired_count == 0,
+        "versioned_reclaim_no_readers",
+        "Without readers old snapshots should be freed at once",
+        _counter) && result;
+
+    // test 2: pinned
+    id = d_cvar_versioned_reader_register(v);
+    d_cvar_versioned_read_begin(v, id);
+
+    d_cvar_versioned_mark(v, TEST_VCVAR_GRAVITY);
+    d_cvar_versioned_publish(v);
+
+    result = d_assert_standalone(
+        v->retired_count == 1
+        && d_cvar_versioned_reclaim(v) == 1,
+        "versioned_reclaim_pinned",
+        "An older reader should pin the snapshot",
+        _counter) && result;
+
+    // test 3: released
+    d_cvar_versioned_read_end(v, id);
+
+    result = d_assert_standalone(
+        d_cvar_versioned_reclaim(v) == 0
+        && v->retired == NULL,
+        "versioned_reclaim_after_leave",
+        "Snapshot should be freed once no reader can reach it",
+        _counter) && result;
+
+    d_cvar_versioned_free(v);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_cvar_versioned_writers_all
+  Aggregation function that runs all writer tests.
+*/
+bool
+d_tests_sa_registry_cvar_versioned_writers_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Writer Functions\n");
+    printf("  --------------------------\n");
+
+    result = d_tests_sa_registry_cvar_versioned_publish(_counter) && result;
+    result = d_tests_sa_registry_cvar_versioned_dirty(_counter) && result;
+    result = d_tests_sa_registry_cvar_versioned_reclaim(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,26 @@
+#include ".\registry_image_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_image_run_all
+  Module-level aggregation function that runs all registry_image tests.
+  Executes tests for all categories:
+  - Save functions (validation, header contents)
+  - Map functions (round trip, indexes, relocation, bad files)
+*/
+bool
+d_tests_sa_registry_image_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_registry_image_save_all(_counter) && result;
+    result = d_tests_sa_registry_image_map_all(_counter) && result;
+
+    return result;
+}
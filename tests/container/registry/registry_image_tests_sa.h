@@ -0,0 +1,71 @@
+/******************************************************************************
+* djinterp [test]                                     registry_image_tests_sa.h
+*
+*   Unit test declarations for `registry_image.h` module.
+*   Exercises saving registries to image files, mapping them back at their
+* preferred base and rebasing them when that address is unavailable. Image
+* files are written to the working directory and removed afterwards.
+*
+*
+* path:      \tests\container\registry\registry_image_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_REGISTRY_IMAGE_SA_
+#define DJINTERP_TESTS_REGISTRY_IMAGE_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\registry\registry_image.h"
+#include "..\..\..\inc\string_fn.h"
+
+
+/******************************************************************************
+ * TEST HELPER TYPES
+ *****************************************************************************/
+
+struct test_image_row
+{
+    const char* key;
+    int         value;
+};
+
+// TEST_IMAGE_PATH
+//   constant: scratch file used by every image test.
+#define TEST_IMAGE_PATH "d_registry_image_test.bin"
+
+
+/******************************************************************************
+ * I. SAVE FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_image_save_invalid(struct d_test_counter* _counter);
+bool d_tests_sa_registry_image_save_header(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_registry_image_save_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. MAP FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_image_map_roundtrip(struct d_test_counter* _counter);
+bool d_tests_sa_registry_image_map_indexes(struct d_test_counter* _counter);
+bool d_tests_sa_registry_image_map_frozen(struct d_test_counter* _counter);
+bool d_tests_sa_registry_image_map_relocated(struct d_test_counter* _counter);
+bool d_tests_sa_registry_image_map_invalid(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_registry_image_map_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_registry_image_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_REGISTRY_IMAGE_SA_
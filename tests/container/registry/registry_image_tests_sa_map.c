@@ -0,0 +1,569 @@
+#include ".\registry_image_tests_sa.h"
+
+
+/*
+test_image_save_sample
+  Helper: saves a registry holding "alpha" (1), "beta" (2) and "gamma" (3),
+  with the alias "a" for "alpha", using `_flags`. Optionally builds a hash
+  index and key prefixes first. The source is freed before returning so
+  that mapped keys cannot alias it.
+*/
+static bool
+test_image_save_sample
+(
+    uint8_t _flags,
+    bool    _indexes
+)
+{
+    static const struct test_image_row rows[] =
+    {
+        { "alpha", 1 },
+        { "beta",  2 },
+        { "gamma", 3 }
+    };
+
+    struct d_registry* reg;
+    bool               ok;
+
+    reg = d_registry_new_from_array_flags(rows,
+                                          sizeof(struct test_image_row),
+                                          3,
+                                          _flags);
+
+    if (!reg)
+    {
+        return false;
+    }
+
+    ok = d_registry_add_alias(reg, "alpha", "a");
+
+    if (_indexes)
+    {
+        ok = d_registry_build_hash_index(reg) && ok;
+        ok = d_registry_enable_key_prefix(reg) && ok;
+        ok = d_registry_freeze(reg) && ok;
+    }
+
+    ok = d_registry_save_image(reg, TEST_IMAGE_PATH) && ok;
+
+    d_registry_free(reg);
+
+    return ok;
+}
+
+/*
+test_image_value
+  Helper: value stored under `_key`, or -1 if it does not resolve.
+*/
+static int
+test_image_value
+(
+    const struct d_registry* _registry,
+    const char* _key
+)
+{
+    struct test_image_row* row;
+
+    row = D_REGISTRY_GET(_registry, _key, struct test_image_row);
+
+    return row ? row->value : -1;
+}
+
+
+/*
+d_tests_sa_registry_image_map_roundtrip
+  Tests d_registry_map_image on a plain registry.
+  Tests the following:
+  - keys and aliases resolve to the saved rows
+  - missing keys do not resolve
+  - the mapped registry is static and frozen, and does not own rows
+  - row keys point into the mapping, not the freed source
+  - the lookup stays sorted
+*/
+bool
+d_tests_sa_registry_image_map_roundtrip
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_registry*     reg;
+    struct test_image_row* row;
+
+    result = true;
+
+    if (!test_image_save_sample(D_REGISTRY_FLAG_NONE, false))
+    {
+        result = d_assert_standalone(
+            false,
+            "roundtrip_save",
+            "Sample image should save",
+            _counter) && result;
+
+        return result;
+    }
+
+    reg = d_registry_map_image(TEST_IMAGE_PATH);
+
+    // test 1: mapped
+    result = d_assert_standalone(
+        reg != NULL,
+        "roundtrip_map",
+        "A saved image should map",
+        _counter) && result;
+
+    if (!reg)
+    {
+        remove(TEST_IMAGE_PATH);
+
+        return result;
+    }
+
+    // test 2: keys and aliases
+    result = d_assert_standalone(
+        test_image_value(reg, "alpha") == 1
+        && test_image_value(reg, "beta") == 2
+        && test_image_value(reg, "gamma") == 3
+        && test_image_value(reg, "a") == 1,
+        "roundtrip_get",
+        "Keys and aliases should resolve to saved rows",
+        _counter) && result;
+
+    // test 3: misses
+    result = d_assert_standalone(
+        test_image_value(reg, "delta") == -1
+        && test_image_value(reg, "ALPHA") == -1,
+        "roundtrip_miss",
+        "Unknown keys should not resolve",
+        _counter) && result;
+
+    // test 4: flags
+    result = d_assert_standalone(
+        D_REGISTRY_IS_FROZEN(reg)
+        && D_REGISTRY_HAS_FLAG(reg, D_REGISTRY_FLAG_STATIC_ROWS)
+        && !D_REGISTRY_HAS_FLAG(reg, D_REGISTRY_FLAG_OWNS_ROWS)
+        && d_registry_count(reg) == 3
+        && reg->perfect_hash != NULL,
+        "roundtrip_flags",
+        "Mapped registries should be static, frozen and hashed",
+        _counter) && result;
+
+    // test 5: keys live in the mapping
+    row = (struct test_image_row*)d_registry_at(reg, 1);
+
+    result = d_assert_standalone(
+        row != NULL
+        && strcmp(row->key, "beta") == 0
+        && (const void*)row->key > (const void*)reg->rows,
+        "roundtrip_keys",
+        "Row keys should point into the string table",
+        _counter) && result;
+
+    // test 6: sorted lookup
+    result = d_assert_standalone(
+        reg->lookup_count == 4
+        && strcmp(reg->lookup[0].key, "a") == 0
+        && strcmp(reg->lookup[3].key, "gamma") == 0,
+        "roundtrip_sorted",
+        "The lookup should be stored sorted",
+        _counter) && result;
+
+    d_registry_unmap_image(reg);
+    remove(TEST_IMAGE_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_image_map_indexes
+  Tests that optional indexes survive the round trip.
+  Tests the following:
+  - case-insensitive lookups still fold case
+  - a stored hash index is mapped and used
+  - key prefixes are kept and prefix queries work
+*/
+bool
+d_tests_sa_registry_image_map_indexes
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_registry*      reg;
+    struct d_registry_slice slice;
+
+    result = true;
+
+    if (!test_image_save_sample(D_REGISTRY_FLAG_CASE_INSENSITIVE, true))
+    {
+        result = d_assert_standalone(
+            false,
+            "indexes_save",
+            "Indexed sample image should save",
+            _counter) && result;
+
+        return result;
+    }
+
+    reg = d_registry_map_image(TEST_IMAGE_PATH);
+
+    if (!reg)
+    {
+        result = d_assert_standalone(
+            false,
+            "indexes_map",
+            "Indexed image should map",
+            _counter) && result;
+
+        remove(TEST_IMAGE_PATH);
+
+        return result;
+    }
+
+    // test 1: case folding
+    result = d_assert_standalone(
+        test_image_value(reg, "ALPHA") == 1
+        && test_image_value(reg, "Gamma") == 3
+        && test_image_value(reg, "A") == 1,
+        "indexes_nocase",
+        "Case-insensitive images should fold case",
+        _counter) && result;
+
+    // test 2: hash index
+    result = d_assert_standalone(
+        D_REGISTRY_HAS_HASH_INDEX(reg)
+        && reg->hash_slots != NULL
+        && reg->hash_count == 4,
+        "indexes_hash",
+        "The hash index should be mapped",
+        _counter) && result;
+
+    // test 3: prefixes
+    slice = d_registry_find_prefix(reg, "g");
+
+    result = d_assert_standalone(
+        D_REGISTRY_HAS_KEY_PREFIX(reg)
+        && reg->lookup[1].prefix != 0
+        && D_REGISTRY_SLICE_COUNT(slice) == 1,
+        "indexes_prefix",
+        "Key prefixes and prefix queries should survive",
+        _counter) && result;
+
+    d_registry_unmap_image(reg);
+    remove(TEST_IMAGE_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_image_map_frozen
+  Tests that a mapped registry's indexes are never freed or rebuilt.
+  Tests the following:
+  - the mapped registry reports an external index
+  - freeze succeeds and leaves the mapped indexes in place
+  - thaw and index rebuilds are refused
+  - drop and clear leave the mapped indexes usable
+*/
+bool
+d_tests_sa_registry_image_map_frozen
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    uint32_t*          perfect;
+    void*              slots;
+
+    result = true;
+
+    if (!test_image_save_sample(D_REGISTRY_FLAG_NONE, true))
+    {
+        result = d_assert_standalone(
+            false,
+            "frozen_save",
+            "Indexed sample image should save",
+            _counter) && result;
+
+        return result;
+    }
+
+    reg = d_registry_map_image(TEST_IMAGE_PATH);
+
+    if (!reg)
+    {
+        result = d_assert_standalone(
+            false,
+            "frozen_map",
+            "Indexed image should map",
+            _counter) && result;
+
+        remove(TEST_IMAGE_PATH);
+
+        return result;
+    }
+
+    perfect = reg->perfect_hash;
+    slots   = reg->hash_slots;
+
+    // test 1: external
+    result = d_assert_standalone(
+        D_REGISTRY_HAS_EXTERNAL_INDEX(reg)
+        && perfect != NULL
+        && slots != NULL,
+        "frozen_external",
+        "Mapped indexes should be marked external",
+        _counter) && result;
+
+    // test 2: freeze
+    result = d_assert_standalone(
+        d_registry_freeze(reg)
+        && D_REGISTRY_IS_FROZEN(reg)
+        && reg->perfect_hash == perfect
+        && reg->hash_slots == slots,
+        "frozen_freeze",
+        "Freezing a mapped registry should keep its indexes",
+        _counter) && result;
+
+    // test 3: thaw and rebuilds refused
+    result = d_assert_standalone(
+        !d_registry_thaw(reg)
+        && !d_registry_build_hash_index(reg)
+        && !d_registry_build_perfect_hash(reg)
+        && D_REGISTRY_IS_FROZEN(reg),
+        "frozen_thaw",
+        "Thaw and index rebuilds should be refused",
+        _counter) && result;
+
+    // test 4: drop and clear
+    d_registry_drop_hash_index(reg);
+    d_registry_drop_perfect_hash(reg);
+    d_registry_clear(reg);
+
+    result = d_assert_standalone(
+        reg->perfect_hash == perfect
+        && reg->hash_slots == slots
+        && test_image_value(reg, "beta") == 2
+        && test_image_value(reg, "a") == 1,
+        "frozen_drop",
+        "Drop and clear should leave the mapped registry usable",
+        _counter) && result;
+
+    d_registry_unmap_image(reg);
+    remove(TEST_IMAGE_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_image_map_relocated
+  Tests rebasing when the preferred base is taken.
+  Tests the following:
+  - a second mapping of the same image is relocated
+  - both mappings resolve every key and alias
+  - the two mappings do not share key storage
+  - unmapping one leaves the other usable
+*/
+bool
+d_tests_sa_registry_image_map_relocated
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_registry*     first;
+    struct d_registry*     second;
+    struct test_image_row* a;
+    struct test_image_row* b;
+
+    result = true;
+
+    if (!test_image_save_sample(D_REGISTRY_FLAG_NONE, true))
+    {
+        return result;
+    }
+
+    first  = d_registry_map_image(TEST_IMAGE_PATH);
+    second = d_registry_map_image(TEST_IMAGE_PATH);
+
+    if ( (!first) ||
+         (!second) )
+    {
+        result = d_assert_standalone(
+            false,
+            "relocated_map",
+            "An image should map twice",
+            _counter) && result;
+
+        d_registry_unmap_image(first);
+        d_registry_unmap_image(second);
+        remove(TEST_IMAGE_PATH);
+
+        return result;
+    }
+
+    // test 1: relocation
+    result = d_assert_standalone(
+        d_registry_image_is_relocated(second),
+        "relocated_second",
+        "The second mapping should be rebased",
+        _counter) && result;
+
+    // test 2: lookups on both
+    result = d_assert_standalone(
+        test_image_value(first, "beta") == 2
+        && test_image_value(first, "a") == 1
+        && test_image_value(second, "beta") == 2
+        && test_image_value(second, "a") == 1
+        && test_image_value(second, "zeta") == -1,
+        "relocated_get",
+        "Both mappings should resolve keys and aliases",
+        _counter) && result;
+
+    // test 3: separate storage
+    a = (struct test_image_row*)d_registry_at(first, 0);
+    b = (struct test_image_row*)d_registry_at(second, 0);
+
+    result = d_assert_standalone(
+        a && b
+        && a->key != b->key
+        && strcmp(a->key, b->key) == 0,
+        "relocated_keys",
+        "Mappings should hold equal keys at different addresses",
+        _counter) && result;
+
+    // test 4: independent lifetime
+    d_registry_unmap_image(first);
+
+    result = d_assert_standalone(
+        test_image_value(second, "gamma") == 3,
+        "relocated_unmap_one",
+        "Unmapping one image should leave the other usable",
+        _counter) && result;
+
+    d_registry_unmap_image(second);
+    remove(TEST_IMAGE_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_image_map_invalid
+  Tests d_registry_map_image rejection paths.
+  Tests the following:
+  - NULL or missing paths return NULL
+  - truncated images return NULL
+  - images with a bad magic return NULL
+  - unmap and is_relocated accept NULL
+*/
+bool
+d_tests_sa_registry_image_map_invalid
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                           result;
+    struct d_registry_image_header h;
+    FILE*                          file;
+
+    result = true;
+
+    // test 1: missing
+    result = d_assert_standalone(
+        d_registry_map_image(NULL) == NULL
+        && d_registry_map_image("no_such_image.bin") == NULL,
+        "map_missing",
+        "NULL or missing paths should return NULL",
+        _counter) && result;
+
+    // test 2: truncated (header only)
+    test_image_save_sample(D_REGISTRY_FLAG_NONE, false);
+
+    memset(&h, 0, sizeof(h));
+    file = fopen(TEST_IMAGE_PATH, "rb");
+
+    if (file)
+    {
+        if (fread(&h, 1, sizeof(h), file) != sizeof(h))
+        {
+            memset(&h, 0, sizeof(h));
+        }
+
+        fclose(file);
+    }
+
+    file = fopen(TEST_IMAGE_PATH, "wb");
+
+    if (file)
+    {
+        fwrite(&h, 1, sizeof(h), file);
+        fclose(file);
+    }
+
+    result = d_assert_standalone(
+        d_registry_map_image(TEST_IMAGE_PATH) == NULL,
+        "map_truncated",
+        "Truncated images should be rejected",
+        _counter) && result;
+
+    // test 3: bad magic
+    test_image_save_sample(D_REGISTRY_FLAG_NONE, false);
+
+    file = fopen(TEST_IMAGE_PATH, "r+b");
+
+    if (file)
+    {
+        fputc('X', file);
+        fclose(file);
+    }
+
+    result = d_assert_standalone(
+        d_registry_map_image(TEST_IMAGE_PATH) == NULL,
+        "map_bad_magic",
+        "Images with a bad magic should be rejected",
+        _counter) && result;
+
+    // test 4: NULL handling
+    d_registry_unmap_image(NULL);
+
+    result = d_assert_standalone(
+        d_registry_image_is_relocated(NULL) == false,
+        "map_null_handle",
+        "unmap and is_relocated should accept NULL",
+        _counter) && result;
+
+    remove(TEST_IMAGE_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_image_map_all
+  Aggregation function that runs all map tests.
+*/
+bool
+d_tests_sa_registry_image_map_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Map Functions\n");
+    printf("  -----------------------\n");
+
+    result = d_tests_sa_registry_image_map_roundtrip(_counter) && result;
+    result = d_tests_sa_registry_image_map_indexes(_counter) && result;
+    result = d_tests_sa_registry_image_map_frozen(_counter) && result;
+    result = d_tests_sa_registry_image_map_relocated(_counter) && result;
+    result = d_tests_sa_registry_image_map_invalid(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,251 @@
+#include ".\registry_image_tests_sa.h"
+
+
+/*
+test_image_make
+  Helper: builds a registry holding "alpha" (1), "beta" (2) and "gamma" (3)
+  with the alias "a" for "alpha".
+*/
+static struct d_registry*
+test_image_make
+(
+    void
+)
+{
+    struct d_registry*    reg;
+    struct test_image_row row;
+
+    reg = d_registry_new(sizeof(struct test_image_row));
+
+    if (!reg)
+    {
+        return NULL;
+    }
+
+    row.key = "alpha";  row.value = 1;
+    d_registry_add(reg, &row);
+    row.key = "beta";   row.value = 2;
+    d_registry_add(reg, &row);
+    row.key = "gamma";  row.value = 3;
+    d_registry_add(reg, &row);
+
+    d_registry_add_alias(reg, "alpha", "a");
+
+    return reg;
+}
+
+
+/*
+d_tests_sa_registry_image_save_invalid
+  Tests d_registry_save_image rejection paths.
+  Tests the following:
+  - NULL registry or path fails
+  - a registry with an open batch fails
+  - a registry with tombstoned rows fails until compacted
+  - an unwritable path fails
+*/
+bool
+d_tests_sa_registry_image_save_invalid
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    struct d_registry*    reg;
+    struct test_image_row row;
+
+    result = true;
+
+    reg = test_image_make();
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    // test 1: NULL arguments
+    result = d_assert_standalone(
+        d_registry_save_image(NULL, TEST_IMAGE_PATH) == false
+        && d_registry_save_image(reg, NULL) == false,
+        "save_null",
+        "NULL registry or path should fail",
+        _counter) && result;
+
+    // test 2: open batch
+    d_registry_begin_batch(reg);
+
+    result = d_assert_standalone(
+        d_registry_save_image(reg, TEST_IMAGE_PATH) == false,
+        "save_in_batch",
+        "Saving during a batch should fail",
+        _counter) && result;
+
+    d_registry_end_batch(reg);
+
+    // test 3: tombstones (enough rows to stay below auto-compaction)
+    row.key = "delta";    row.value = 4;
+    d_registry_add(reg, &row);
+    row.key = "epsilon";  row.value = 5;
+    d_registry_add(reg, &row);
+
+    reg->flags |= (uint8_t)D_REGISTRY_FLAG_TOMBSTONES;
+    d_registry_remove(reg, "beta");
+
+    result = d_assert_standalone(
+        d_registry_save_image(reg, TEST_IMAGE_PATH) == false,
+        "save_tombstones",
+        "Saving with dead rows should fail",
+        _counter) && result;
+
+    d_registry_compact(reg);
+
+    result = d_assert_standalone(
+        d_registry_save_image(reg, TEST_IMAGE_PATH) == true,
+        "save_after_compact",
+        "Saving after compaction should succeed",
+        _counter) && result;
+
+    // test 4: unwritable path
+    result = d_assert_standalone(
+        d_registry_save_image(reg, "no_such_dir/image.bin") == false,
+        "save_bad_path",
+        "An unwritable path should fail",
+        _counter) && result;
+
+    remove(TEST_IMAGE_PATH);
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_image_save_header
+  Tests the header written by d_registry_save_image.
+  Tests the following:
+  - magic, version and layout sizes match this build
+  - counts match the source registry
+  - sections are aligned and the string table ends the file
+  - a perfect hash is stored even for an unfrozen source
+  - the source registry is left unchanged
+*/
+bool
+d_tests_sa_registry_image_save_header
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                           result;
+    struct d_registry*             reg;
+    struct d_registry_image_header h;
+    FILE*                          file;
+    long                           size;
+    size_t                         got;
+
+    result = true;
+
+    reg = test_image_make();
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    d_registry_save_image(reg, TEST_IMAGE_PATH);
+
+    got  = 0;
+    size = 0;
+    file = fopen(TEST_IMAGE_PATH, "rb");
+
+    if (file)
+    {
+        got = fread(&h, 1, sizeof(h), file);
+        fseek(file, 0, SEEK_END);
+        size = ftell(file);
+        fclose(file);
+    }
+
+    if (got != sizeof(h))
+    {
+        result = d_assert_standalone(
+            false,
+            "header_read",
+            "Image header should be readable",
+            _counter) && result;
+
+        remove(TEST_IMAGE_PATH);
+        d_registry_free(reg);
+
+        return result;
+    }
+
+    // test 1: identification
+    result = d_assert_standalone(
+        memcmp(h.magic, D_REGISTRY_IMAGE_MAGIC, sizeof(D_REGISTRY_IMAGE_MAGIC)) == 0
+        && h.version == D_REGISTRY_IMAGE_VERSION
+        && h.pointer_size == sizeof(void*)
+        && h.entry_size == sizeof(struct d_registry_lookup_entry),
+        "header_ident",
+        "Header should identify this build's layout",
+        _counter) && result;
+
+    // test 2: counts
+    result = d_assert_standalone(
+        h.row_count == 3
+        && h.lookup_count == 4
+        && h.row_size == sizeof(struct test_image_row),
+        "header_counts",
+        "Header counts should match the source",
+        _counter) && result;
+
+    // test 3: layout
+    result = d_assert_standalone(
+        (h.rows_offset % D_REGISTRY_IMAGE_ALIGN) == 0
+        && (h.lookup_offset % D_REGISTRY_IMAGE_ALIGN) == 0
+        && (h.strings_offset % D_REGISTRY_IMAGE_ALIGN) == 0
+        && h.strings_offset + h.strings_size == h.total_size
+        && h.total_size == (uint64_t)size
+        && h.strings_size == sizeof("alpha") + sizeof("beta")
+                           + sizeof("gamma") + sizeof("a"),
+        "header_layout",
+        "Sections should be aligned and strings stored once",
+        _counter) && result;
+
+    // test 4: perfect hash
+    result = d_assert_standalone(
+        h.perfect_slots > 0
+        && reg->perfect_hash == NULL
+        && !D_REGISTRY_IS_FROZEN(reg),
+        "header_perfect",
+        "A perfect hash should be stored without freezing the source",
+        _counter) && result;
+
+    remove(TEST_IMAGE_PATH);
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_image_save_all
+  Aggregation function that runs all save tests.
+*/
+bool
+d_tests_sa_registry_image_save_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Save Functions\n");
+    printf("  ------------------------\n");
+
+    result = d_tests_sa_registry_image_save_invalid(_counter) && result;
+    result = d_tests_sa_registry_image_save_header(_counter) && result;
+
+    return result;
+}
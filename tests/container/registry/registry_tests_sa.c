@@ -16,6 +16,9 @@ d_tests_sa_registry_run_all
   - Destructor functions
   - Internal comparison functions
   - Registry common functions
+  - Batch functions
+  - Hash index functions
+  - Perfect hash functions
 */
 bool
 d_tests_sa_registry_run_all
@@ -39,6 +42,14 @@ d_tests_sa_registry_run_all
     result = d_tests_sa_registry_destructor_all(_counter) && result;
     result = d_tests_sa_registry_comparison_all(_counter) && result;
     result = d_tests_sa_registry_common_all(_counter) && result;
+    result = d_tests_sa_registry_batch_all(_counter) && result;
+    result = d_tests_sa_registry_hash_all(_counter) && result;
+    result = d_tests_sa_registry_perfect_hash_all(_counter) && result;
+    result = d_tests_sa_registry_key_prefix_all(_counter) && result;
+    result = d_tests_sa_registry_range_all(_counter) && result;
+    result = d_tests_sa_registry_tombstone_all(_counter) && result;
+    result = d_tests_sa_registry_intern_all(_counter) && result;
+    result = d_tests_sa_registry_folded_keys_all(_counter) && result;
 
     return result;
 }
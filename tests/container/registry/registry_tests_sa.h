@@ -172,6 +172,93 @@ bool d_tests_sa_registry_schema_max_enum_key(struct d_test_counter* _counter);
 bool d_tests_sa_registry_common_all(struct d_test_counter* _counter);
 
 
+/******************************************************************************
+ * XII. BATCH FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_begin_batch(struct d_test_counter* _counter);
+bool d_tests_sa_registry_end_batch(struct d_test_counter* _counter);
+bool d_tests_sa_registry_batch_sorted(struct d_test_counter* _counter);
+bool d_tests_sa_registry_batch_copy(struct d_test_counter* _counter);
+bool d_tests_sa_registry_new_from_array_flags(struct d_test_counter* _counter);
+
+// XII. aggregation function
+bool d_tests_sa_registry_batch_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * XIII. HASH INDEX FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_build_hash_index(struct d_test_counter* _counter);
+bool d_tests_sa_registry_hash_index_maintenance(struct d_test_counter* _counter);
+
+// XIII. aggregation function
+bool d_tests_sa_registry_hash_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * XIV. PERFECT HASH FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_build_perfect_hash(struct d_test_counter* _counter);
+bool d_tests_sa_registry_perfect_hash_static(struct d_test_counter* _counter);
+bool d_tests_sa_registry_perfect_hash_ownership(struct d_test_counter* _counter);
+
+// XIV. aggregation function
+bool d_tests_sa_registry_perfect_hash_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * XV. KEY PREFIX FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_enable_key_prefix(struct d_test_counter* _counter);
+bool d_tests_sa_registry_key_prefix_maintenance(struct d_test_counter* _counter);
+
+// XV. aggregation function
+bool d_tests_sa_registry_key_prefix_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * XVI. RANGE QUERY FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_find_prefix(struct d_test_counter* _counter);
+bool d_tests_sa_registry_range(struct d_test_counter* _counter);
+bool d_tests_sa_registry_iterator_slice(struct d_test_counter* _counter);
+
+// XVI. aggregation function
+bool d_tests_sa_registry_range_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * XVII. TOMBSTONE FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_tombstone_remove(struct d_test_counter* _counter);
+bool d_tests_sa_registry_tombstone_iteration(struct d_test_counter* _counter);
+bool d_tests_sa_registry_tombstone_compact(struct d_test_counter* _counter);
+
+// XVII. aggregation function
+bool d_tests_sa_registry_tombstone_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * XVIII. INTERNED KEY FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_intern(struct d_test_counter* _counter);
+bool d_tests_sa_registry_add_intern(struct d_test_counter* _counter);
+bool d_tests_sa_registry_intern_lifetime(struct d_test_counter* _counter);
+
+// XVIII. aggregation function
+bool d_tests_sa_registry_intern_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * XIX. FOLDED KEY FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_registry_enable_folded_keys(struct d_test_counter* _counter);
+bool d_tests_sa_registry_folded_keys_maintenance(struct d_test_counter* _counter);
+
+// XIX. aggregation function
+bool d_tests_sa_registry_folded_keys_all(struct d_test_counter* _counter);
+
+
 /******************************************************************************
  * MODULE-LEVEL AGGREGATION
  *****************************************************************************/
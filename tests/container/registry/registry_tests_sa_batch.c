@@ -0,0 +1,528 @@
+#include ".\registry_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_begin_batch
+  Tests the d_registry_begin_batch function.
+  Tests the following:
+  - NULL registry returns false
+  - frozen registry returns false
+  - static registry returns false
+  - opening a batch sets in_batch
+  - batches nest; only the outermost end_batch commits
+  - staged rows are findable before commit
+*/
+bool
+d_tests_sa_registry_begin_batch
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+
+    result = true;
+
+    // test 1: NULL registry
+    result = d_assert_standalone(
+        d_registry_begin_batch(NULL) == false,
+        "begin_batch_null",
+        "NULL registry should return false",
+        _counter) && result;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        // test 2: frozen registry
+        d_registry_freeze(reg);
+        result = d_assert_standalone(
+            d_registry_begin_batch(reg) == false,
+            "begin_batch_frozen",
+            "Frozen registry should return false",
+            _counter) && result;
+        d_registry_thaw(reg);
+
+        // test 3: static registry
+        reg->flags |= (uint8_t)D_REGISTRY_FLAG_STATIC_ROWS;
+        result = d_assert_standalone(
+            d_registry_begin_batch(reg) == false,
+            "begin_batch_static",
+            "Static registry should return false",
+            _counter) && result;
+        reg->flags &= (uint8_t)~D_REGISTRY_FLAG_STATIC_ROWS;
+
+        // test 4: open batch
+        result = d_assert_standalone(
+            d_registry_begin_batch(reg) == true
+            && d_registry_in_batch(reg) == true,
+            "begin_batch_open",
+            "begin_batch should open a batch",
+            _counter) && result;
+
+        // test 5: nesting
+        d_registry_begin_batch(reg);
+
+        row.key = "zeta";   row.value = 1;
+        d_registry_add(reg, &row);
+        row.key = "alpha";  row.value = 2;
+        d_registry_add(reg, &row);
+
+        d_registry_end_batch(reg);
+
+        result = d_assert_standalone(
+            d_registry_in_batch(reg) == true,
+            "begin_batch_nested",
+            "Inner end_batch should leave the outer batch open",
+            _counter) && result;
+
+        // test 6: staged rows findable before commit
+        found = (struct test_row*)d_registry_get(reg, "alpha");
+        result = d_assert_standalone(
+            found != NULL && found->value == 2,
+            "begin_batch_staged_get",
+            "Staged row 'alpha' should be findable inside the batch",
+            _counter) && result;
+
+        d_registry_end_batch(reg);
+
+        result = d_assert_standalone(
+            d_registry_in_batch(reg) == false,
+            "begin_batch_closed",
+            "Outer end_batch should close the batch",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_end_batch
+  Tests the d_registry_end_batch function.
+  Tests the following:
+  - NULL registry returns false
+  - no open batch returns false
+  - commit leaves the lookup sorted
+  - aliases of staged rows resolve after commit
+  - staged key colliding with another staged key is discarded, returns false
+  - alias colliding with a staged canonical key loses to the key
+*/
+bool
+d_tests_sa_registry_end_batch
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+    size_t             i;
+    bool               sorted;
+
+    result = true;
+
+    // test 1: NULL registry
+    result = d_assert_standalone(
+        d_registry_end_batch(NULL) == false,
+        "end_batch_null",
+        "NULL registry should return false",
+        _counter) && result;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        // test 2: no open batch
+        result = d_assert_standalone(
+            d_registry_end_batch(reg) == false,
+            "end_batch_not_open",
+            "end_batch without begin_batch should return false",
+            _counter) && result;
+
+        row.key = "mango";  row.value = 1;
+        d_registry_add(reg, &row);
+
+        d_registry_begin_batch(reg);
+
+        row.key = "zebra";  row.value = 2;
+        d_registry_add(reg, &row);
+        d_registry_add_alias(reg, "zebra", "z");
+        row.key = "apple";  row.value = 3;
+        d_registry_add(reg, &row);
+        d_registry_add_alias(reg, "mango", "m");
+
+        result = d_assert_standalone(
+            d_registry_end_batch(reg) == true,
+            "end_batch_clean",
+            "Commit without collisions should return true",
+            _counter) && result;
+
+        // test 3: sorted
+        sorted = true;
+
+        for (i = 1; i < reg->lookup_count; ++i)
+        {
+            if (d_string_compare(reg->lookup[i - 1].key,
+                                 reg->lookup[i].key) >= 0)
+            {
+                sorted = false;
+                break;
+            }
+        }
+
+        result = d_assert_standalone(
+            sorted && reg->lookup_count == 5,
+            "end_batch_sorted",
+            "Lookup should hold 5 strictly ascending entries",
+            _counter) && result;
+
+        // test 4: aliases resolve
+        found = (struct test_row*)d_registry_get(reg, "z");
+        result = d_assert_standalone(
+            found != NULL && found->value == 2,
+            "end_batch_alias",
+            "Alias 'z' should resolve to 'zebra'",
+            _counter) && result;
+
+        found = (struct test_row*)d_registry_get(reg, "m");
+        result = d_assert_standalone(
+            found != NULL && found->value == 1,
+            "end_batch_alias_old",
+            "Alias 'm' should resolve to pre-batch row 'mango'",
+            _counter) && result;
+
+        // test 5: staged collision
+        d_registry_begin_batch(reg);
+
+        row.key = "kiwi";   row.value = 10;
+        d_registry_add(reg, &row);
+        row.key = "kiwi";   row.value = 11;
+        d_registry_add(reg, &row);
+
+        result = d_assert_standalone(
+            d_registry_end_batch(reg) == false,
+            "end_batch_dup",
+            "Commit with a staged duplicate should return false",
+            _counter) && result;
+
+        found = (struct test_row*)d_registry_get(reg, "kiwi");
+        result = d_assert_standalone(
+            d_registry_count(reg) == 4
+            && found != NULL && found->value == 10,
+            "end_batch_dup_first_wins",
+            "The first staged 'kiwi' should be kept",
+            _counter) && result;
+
+        // test 6: alias vs staged canonical key
+        d_registry_begin_batch(reg);
+
+        d_registry_add_alias(reg, "apple", "pear");
+        row.key = "pear";   row.value = 20;
+        d_registry_add(reg, &row);
+
+        d_registry_end_batch(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "pear");
+        result = d_assert_standalone(
+            found != NULL && found->value == 20,
+            "end_batch_key_beats_alias",
+            "Canonical key 'pear' should win over alias 'pear'",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_batch_sorted
+  Tests batch commits on D_REGISTRY_FLAG_SORTED registries.
+  Tests the following:
+  - rows are in key order after commit
+  - aliases follow their rows through the reorder
+  - add_rows on a SORTED registry produces sorted rows
+*/
+bool
+d_tests_sa_registry_batch_sorted
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    batch[4];
+    struct test_row*   found;
+    size_t             i;
+    bool               sorted;
+
+    result = true;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        reg->flags |= (uint8_t)D_REGISTRY_FLAG_SORTED;
+
+        batch[0].key = "delta";  batch[0].value = 4;
+        batch[1].key = "bravo";  batch[1].value = 2;
+
+        d_registry_add_rows(reg, batch, 2);
+        d_registry_add_alias(reg, "delta", "d");
+
+        batch[0].key = "charlie";  batch[0].value = 3;
+        batch[1].key = "echo";     batch[1].value = 5;
+        batch[2].key = "alpha";    batch[2].value = 1;
+        batch[3].key = "foxtrot";  batch[3].value = 6;
+
+        // test 1: add_rows into a SORTED registry
+        result = d_assert_standalone(
+            d_registry_add_rows(reg, batch, 4) == true,
+            "batch_sorted_add_rows",
+            "add_rows into a SORTED registry should succeed",
+            _counter) && result;
+
+        sorted = (d_registry_count(reg) == 6);
+
+        for (i = 0; sorted && i < d_registry_count(reg); ++i)
+        {
+            found = (struct test_row*)d_registry_at(reg, i);
+            sorted = (found->value == (int)(i + 1));
+        }
+
+        result = d_assert_standalone(
+            sorted,
+            "batch_sorted_rows",
+            "Rows should be stored in key order",
+            _counter) && result;
+
+        // test 2: alias follows its row
+        found = (struct test_row*)d_registry_get(reg, "d");
+        result = d_assert_standalone(
+            found != NULL && found->value == 4,
+            "batch_sorted_alias",
+            "Alias 'd' should still resolve to 'delta'",
+            _counter) && result;
+
+        result = d_assert_standalone(
+            d_registry_index_of(reg, "foxtrot") == 5,
+            "batch_sorted_index",
+            "'foxtrot' should be the last row",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_batch_copy
+  Tests d_registry_new_copy on a registry with an open batch.
+  Tests the following:
+  - the copy is not left in a batch
+  - staged keys and aliases resolve in the copy through the sorted lookup
+  - a key staged twice keeps its first row in the copy
+  - the source's batch is still open and commits independently
+*/
+bool
+d_tests_sa_registry_batch_copy
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct d_registry* copy;
+    struct test_row    row;
+    struct test_row*   found;
+
+    result = true;
+    reg    = d_registry_new(sizeof(struct test_row));
+
+    if (!reg)
+    {
+        return false;
+    }
+
+    row.key = "mango"; row.value = 1; d_registry_add(reg, &row);
+
+    d_registry_begin_batch(reg);
+    row.key = "apple"; row.value = 2; d_registry_add(reg, &row);
+    row.key = "zebra"; row.value = 3; d_registry_add(reg, &row);
+    row.key = "apple"; row.value = 4; d_registry_add(reg, &row);
+    d_registry_add_alias(reg, "zebra", "z");
+
+    copy = d_registry_new_copy(reg);
+
+    // test 1: the batch stays with the source
+    result = d_assert_standalone(
+        copy != NULL
+        && !d_registry_in_batch(copy)
+        && d_registry_in_batch(reg),
+        "batch_copy_not_batching",
+        "A copy taken mid-batch should not inherit the open batch",
+        _counter) && result;
+
+    if (copy)
+    {
+        // test 2: staged entries are committed in the copy
+        result = d_assert_standalone(
+            copy->lookup_sorted == copy->lookup_count
+            && d_registry_count(copy) == 3,
+            "batch_copy_committed",
+            "The copy's lookup should be fully sorted after the commit",
+            _counter) && result;
+
+        found = (struct test_row*)d_registry_get(copy, "z");
+        result = d_assert_standalone(
+            found != NULL && found->value == 3,
+            "batch_copy_alias",
+            "Alias staged in the batch should resolve in the copy",
+            _counter) && result;
+
+        // test 3: the duplicate staged key loses to the first one
+        found = (struct test_row*)d_registry_get(copy, "apple");
+        result = d_assert_standalone(
+            found != NULL && found->value == 2,
+            "batch_copy_duplicate",
+            "The first staged 'apple' should win in the copy",
+            _counter) && result;
+
+        d_registry_free(copy);
+    }
+
+    // test 4: the source still commits its own batch
+    d_registry_end_batch(reg);
+    found = (struct test_row*)d_registry_get(reg, "zebra");
+
+    result = d_assert_standalone(
+        !d_registry_in_batch(reg)
+        && found != NULL && found->value == 3
+        && d_registry_count(reg) == 3,
+        "batch_copy_source_commit",
+        "The source's batch should commit after the copy is gone",
+        _counter) && result;
+
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_new_from_array_flags
+  Tests the d_registry_new_from_array_flags function.
+  Tests the following:
+  - NULL rows returns NULL
+  - SORTED flag orders the copied rows
+  - duplicate keys in the source array are dropped
+  - CASE_INSENSITIVE flag is honored by the built lookup
+  - FROZEN flag is applied after the rows are committed
+*/
+bool
+d_tests_sa_registry_new_from_array_flags
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    rows[4];
+    struct test_row*   found;
+
+    result = true;
+
+    rows[0].key = "cherry";  rows[0].value = 3;
+    rows[1].key = "Apple";   rows[1].value = 1;
+    rows[2].key = "banana";  rows[2].value = 2;
+    rows[3].key = "apple";   rows[3].value = 9;   // duplicate when nocase
+
+    // test 1: NULL rows
+    result = d_assert_standalone(
+        d_registry_new_from_array_flags(NULL, sizeof(struct test_row), 4,
+            (uint8_t)D_REGISTRY_FLAG_SORTED) == NULL,
+        "from_arr_flags_null",
+        "NULL rows should return NULL",
+        _counter) && result;
+
+    reg = d_registry_new_from_array_flags(
+              rows,
+              sizeof(struct test_row),
+              4,
+              (uint8_t)(D_REGISTRY_FLAG_SORTED |
+                        D_REGISTRY_FLAG_CASE_INSENSITIVE |
+                        D_REGISTRY_FLAG_FROZEN));
+
+    if (reg)
+    {
+        // test 2: duplicate dropped
+        result = d_assert_standalone(
+            d_registry_count(reg) == 3,
+            "from_arr_flags_dedup",
+            "Case-insensitive duplicate should be dropped",
+            _counter) && result;
+
+        // test 3: sorted rows
+        found = (struct test_row*)d_registry_at(reg, 0);
+        result = d_assert_standalone(
+            found != NULL && found->value == 1,
+            "from_arr_flags_sorted",
+            "First row should be 'Apple'",
+            _counter) && result;
+
+        // test 4: nocase lookup
+        found = (struct test_row*)d_registry_get(reg, "CHERRY");
+        result = d_assert_standalone(
+            found != NULL && found->value == 3,
+            "from_arr_flags_nocase",
+            "'CHERRY' should resolve case-insensitively",
+            _counter) && result;
+
+        // test 5: frozen
+        result = d_assert_standalone(
+            D_REGISTRY_IS_FROZEN(reg),
+            "from_arr_flags_frozen",
+            "Registry should be frozen",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_batch_all
+  Aggregation function that runs all batch tests.
+*/
+bool
+d_tests_sa_registry_batch_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Batch Functions\n");
+    printf("  -------------------------\n");
+
+    result = d_tests_sa_registry_begin_batch(_counter) && result;
+    result = d_tests_sa_registry_end_batch(_counter) && result;
+    result = d_tests_sa_registry_batch_sorted(_counter) && result;
+    result = d_tests_sa_registry_batch_copy(_counter) && result;
+    result = d_tests_sa_registry_new_from_array_flags(_counter) && result;
+
+    return result;
+}
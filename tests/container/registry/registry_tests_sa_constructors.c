@@ -183,6 +183,7 @@ d_tests_sa_registry_new_copy
   - STATIC_ROWS flag is cleared on copy
   - flags (other than STATIC_ROWS) are preserved
   - row_free function pointer is copied
+  - frozen sources can be copied
 */
 bool
 d_tests_sa_registry_new_copy
@@ -279,6 +280,19 @@ d_tests_sa_registry_new_copy
             d_registry_free(cpy);
         }
 
+        // test 8: frozen source
+        d_registry_freeze(src);
+        cpy = d_registry_new_copy(src);
+
+        result = d_assert_standalone(
+            cpy != NULL
+            && D_REGISTRY_IS_FROZEN(cpy)
+            && d_registry_get(cpy, "gamma") != NULL,
+            "copy_frozen",
+            "Frozen registries should be copyable",
+            _counter) && result;
+
+        d_registry_free(cpy);
         d_registry_free(src);
     }
 
@@ -0,0 +1,312 @@
+#include ".\registry_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_enable_folded_keys
+  Tests d_registry_enable_folded_keys and d_registry_disable_folded_keys.
+  Tests the following:
+  - NULL and frozen registries are rejected
+  - every lookup entry gets a lowercased copy with its length
+  - mixed-case lookups of short and long (SIMD-width) keys resolve
+  - non-ASCII bytes are not folded
+  - probes longer than D_REGISTRY_FOLD_PROBE_MAX still resolve
+  - disabling clears every copy and lookups still work
+*/
+bool
+d_tests_sa_registry_enable_folded_keys
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    rows[4];
+    struct test_row*   found;
+    char               long_key[D_REGISTRY_FOLD_PROBE_MAX + 16];
+    char               long_probe[D_REGISTRY_FOLD_PROBE_MAX + 16];
+    bool               all_folded;
+    size_t             i;
+
+    result = true;
+
+    // test 1: NULL registry
+    result = d_assert_standalone(
+        d_registry_enable_folded_keys(NULL) == false,
+        "folded_enable_null",
+        "NULL registry should be rejected",
+        _counter) && result;
+
+    d_registry_disable_folded_keys(NULL);
+
+    memset(long_key, 'k', sizeof(long_key) - 1);
+    long_key[sizeof(long_key) - 1] = '\0';
+    memset(long_probe, 'K', sizeof(long_probe) - 1);
+    long_probe[sizeof(long_probe) - 1] = '\0';
+
+    rows[0].key = "Alpha";                            rows[0].value = 0;
+    rows[1].key = "Config.Render.ShadowMapResolution"; rows[1].value = 1;
+    rows[2].key = "\xC0lpha";                         rows[2].value = 2;
+    rows[3].key = long_key;                           rows[3].value = 3;
+
+    reg = d_registry_new_from_array_flags(rows,
+                                          sizeof(struct test_row),
+                                          4,
+                                          (uint8_t)D_REGISTRY_FLAG_CASE_INSENSITIVE);
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    // test 2: copies
+    result = d_assert_standalone(
+        d_registry_enable_folded_keys(reg)
+        && D_REGISTRY_HAS_FOLDED_KEYS(reg)
+        && reg->fold_arena != NULL,
+        "folded_enable",
+        "Enabling should fold every entry",
+        _counter) && result;
+
+    all_folded = true;
+
+    for (i = 0; i < reg->lookup_count; ++i)
+    {
+        all_folded = all_folded
+                     && reg->lookup[i].folded != NULL
+                     && ((const size_t*)(const void*)reg->lookup[i].folded)[-1]
+                        == strlen(reg->lookup[i].key);
+    }
+
+    found = (struct test_row*)d_registry_get(reg, "config.render.shadowmapresolution");
+
+    result = d_assert_standalone(
+        all_folded
+        && found != NULL && found->value == 1
+        && d_registry_index_of(reg, "ALPHA") == 0
+        && d_registry_index_of(reg, "CONFIG.RENDER.SHADOWMAPRESOLUTION") == 1,
+        "folded_lookup",
+        "Mixed-case lookups should resolve through folded copies",
+        _counter) && result;
+
+    // test 3: non-ASCII
+    result = d_assert_standalone(
+        d_registry_index_of(reg, "\xC0LPHA") == 2
+        && d_registry_index_of(reg, "\xE0lpha") == -1,
+        "folded_non_ascii",
+        "Only ASCII letters should be folded",
+        _counter) && result;
+
+    // test 4: long probe
+    result = d_assert_standalone(
+        d_registry_index_of(reg, long_probe) == 3,
+        "folded_long_probe",
+        "Probes too long to fold on the stack should still resolve",
+        _counter) && result;
+
+    // test 5: frozen
+    d_registry_disable_folded_keys(reg);
+
+    all_folded = false;
+
+    for (i = 0; i < reg->lookup_count; ++i)
+    {
+        all_folded = all_folded || (reg->lookup[i].folded != NULL);
+    }
+
+    result = d_assert_standalone(
+        !D_REGISTRY_HAS_FOLDED_KEYS(reg)
+        && reg->fold_arena == NULL
+        && !all_folded
+        && d_registry_index_of(reg, "alpha") == 0,
+        "folded_disable",
+        "Disabling should drop every copy",
+        _counter) && result;
+
+    d_registry_freeze(reg);
+
+    result = d_assert_standalone(
+        d_registry_enable_folded_keys(reg) == false,
+        "folded_enable_frozen",
+        "Frozen registries should be rejected",
+        _counter) && result;
+
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_folded_keys_maintenance
+  Tests that folded copies follow lookup changes.
+  Tests the following:
+  - rows, aliases and batched rows added later are folded
+  - case-sensitive registries keep no copies until made case-insensitive
+  - the folded order matches the per-character nocase order
+  - copies combine with inline key prefixes
+  - d_registry_new_copy refolds into its own arena
+  - rebuild_lookup and clear release the arena
+*/
+bool
+d_tests_sa_registry_folded_keys_maintenance
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct d_registry* copy;
+    struct test_row    row;
+    struct test_row    rows[3];
+    bool               ordered;
+    size_t             i;
+
+    result = true;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    // test 1: case-sensitive registries keep no copies
+    d_registry_enable_folded_keys(reg);
+
+    row.key   = "Zulu";
+    row.value = 0;
+    d_registry_add(reg, &row);
+
+    result = d_assert_standalone(
+        reg->lookup[0].folded == NULL
+        && reg->fold_arena == NULL,
+        "folded_case_sensitive",
+        "Case-sensitive registries should not fold",
+        _counter) && result;
+
+    // test 2: toggled case-insensitive
+    reg->flags |= (uint8_t)D_REGISTRY_FLAG_CASE_INSENSITIVE;
+    d_registry_sort_lookup(reg);
+
+    result = d_assert_standalone(
+        reg->lookup[0].folded != NULL
+        && strcmp(reg->lookup[0].folded, "zulu") == 0
+        && d_registry_contains(reg, "ZULU"),
+        "folded_toggle",
+        "Making the registry case-insensitive should fold its keys",
+        _counter) && result;
+
+    // test 3: later additions, batch and alias
+    row.key   = "alpha_[bracket]";
+    row.value = 1;
+    d_registry_add(reg, &row);
+    d_registry_add_alias(reg, "zulu", "Omega");
+
+    rows[0].key = "Mike";   rows[0].value = 2;
+    rows[1].key = "bravo";  rows[1].value = 3;
+    rows[2].key = "ALPHA";  rows[2].value = 4;
+    d_registry_add_rows(reg, rows, 3);
+
+    ordered = true;
+
+    for (i = 0; i < reg->lookup_count; ++i)
+    {
+        ordered = ordered && (reg->lookup[i].folded != NULL);
+
+        // '[' sorts between 'Z' and 'a', so this checks the fold direction
+        if (i > 0)
+        {
+            ordered = ordered
+                      && d_registry_lookup_compare_nocase(&reg->lookup[i - 1],
+                                                          &reg->lookup[i]) < 0;
+        }
+    }
+
+    result = d_assert_standalone(
+        ordered
+        && reg->lookup_count == 6
+        && d_registry_index_of(reg, "OMEGA") == 0
+        && d_registry_contains(reg, "ALPHA_[BRACKET]")
+        && d_registry_contains(reg, "BRAVO"),
+        "folded_additions",
+        "Later rows and aliases should be folded and ordered",
+        _counter) && result;
+
+    // test 4: with key prefixes
+    d_registry_enable_key_prefix(reg);
+
+    result = d_assert_standalone(
+        d_registry_contains(reg, "Alpha_[Bracket]")
+        && d_registry_contains(reg, "mIKE")
+        && !d_registry_contains(reg, "alpha_[bracket"),
+        "folded_key_prefix",
+        "Folded copies should combine with inline prefixes",
+        _counter) && result;
+
+    // test 5: copy
+    copy = d_registry_new_copy(reg);
+
+    if (copy)
+    {
+        result = d_assert_standalone(
+            D_REGISTRY_HAS_FOLDED_KEYS(copy)
+            && copy->fold_arena != NULL
+            && copy->fold_arena != reg->fold_arena
+            && copy->lookup[0].folded != reg->lookup[0].folded
+            && d_registry_contains(copy, "BRAVO"),
+            "folded_copy",
+            "Copies should fold into their own arena",
+            _counter) && result;
+
+        d_registry_free(copy);
+    }
+
+    // test 6: rebuild and clear
+    d_registry_rebuild_lookup(reg);
+
+    result = d_assert_standalone(
+        reg->lookup_count == 5
+        && reg->lookup[0].folded != NULL
+        && !d_registry_contains(reg, "omega")
+        && d_registry_contains(reg, "mike"),
+        "folded_rebuild",
+        "Rebuilding should refold the surviving keys",
+        _counter) && result;
+
+    d_registry_clear(reg);
+
+    result = d_assert_standalone(
+        reg->fold_arena == NULL
+        && D_REGISTRY_HAS_FOLDED_KEYS(reg),
+        "folded_clear",
+        "Clearing should release copies but keep the mode",
+        _counter) && result;
+
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_folded_keys_all
+  Aggregation function that runs all folded key tests.
+*/
+bool
+d_tests_sa_registry_folded_keys_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Folded Key Functions\n");
+    printf("  ------------------------------\n");
+
+    result = d_tests_sa_registry_enable_folded_keys(_counter) && result;
+    result = d_tests_sa_registry_folded_keys_maintenance(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,262 @@
+#include ".\registry_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_build_hash_index
+  Tests the d_registry_build_hash_index and d_registry_drop_hash_index
+  functions.
+  Tests the following:
+  - NULL registry returns false / does not crash
+  - build sets D_REGISTRY_FLAG_HASH_INDEX and allocates the index
+  - existing keys and aliases resolve through the index
+  - missing keys return NULL
+  - case-insensitive registries hash case-folded keys
+  - drop clears the flag and lookups fall back to binary search
+*/
+bool
+d_tests_sa_registry_build_hash_index
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+
+    result = true;
+
+    // test 1: NULL registry
+    result = d_assert_standalone(
+        d_registry_build_hash_index(NULL) == false,
+        "hash_build_null",
+        "NULL registry should return false",
+        _counter) && result;
+
+    d_registry_drop_hash_index(NULL);
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        row.key = "alpha";  row.value = 1;
+        d_registry_add(reg, &row);
+        row.key = "beta";   row.value = 2;
+        d_registry_add(reg, &row);
+        d_registry_add_alias(reg, "beta", "b");
+
+        // test 2: build
+        result = d_assert_standalone(
+            d_registry_build_hash_index(reg) == true
+            && D_REGISTRY_HAS_HASH_INDEX(reg)
+            && reg->hash_slots != NULL
+            && reg->hash_count == 3,
+            "hash_build_ok",
+            "Index should hold 2 keys and 1 alias",
+            _counter) && result;
+
+        // test 3: keys and aliases resolve
+        found = (struct test_row*)d_registry_get(reg, "b");
+        result = d_assert_standalone(
+            found != NULL && found->value == 2
+            && d_registry_index_of(reg, "alpha") == 0,
+            "hash_build_get",
+            "Key and alias should resolve through the index",
+            _counter) && result;
+
+        // test 4: missing key
+        result = d_assert_standalone(
+            d_registry_get(reg, "gamma") == NULL
+            && d_registry_contains(reg, "ALPHA") == false,
+            "hash_build_missing",
+            "Missing keys should not resolve",
+            _counter) && result;
+
+        // test 5: case-insensitive
+        reg->flags |= (uint8_t)D_REGISTRY_FLAG_CASE_INSENSITIVE;
+        d_registry_sort_lookup(reg);
+        d_registry_build_hash_index(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "ALPHA");
+        result = d_assert_standalone(
+            found != NULL && found->value == 1,
+            "hash_build_nocase",
+            "'ALPHA' should resolve case-insensitively",
+            _counter) && result;
+
+        // test 6: drop
+        d_registry_drop_hash_index(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "B");
+        result = d_assert_standalone(
+            !D_REGISTRY_HAS_HASH_INDEX(reg)
+            && reg->hash_slots == NULL
+            && found != NULL && found->value == 2,
+            "hash_drop",
+            "Dropped index should fall back to binary search",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_hash_index_maintenance
+  Tests that row and alias operations keep the hash index in sync.
+  Tests the following:
+  - rows added after the build are found, including across growth
+  - added and removed aliases are reflected
+  - removing a row drops its key and aliases and shifts later rows
+  - rebuild_lookup rebuilds the index from keys only
+  - a batch commit rebuilds the index
+  - clear empties the index
+*/
+bool
+d_tests_sa_registry_hash_index_maintenance
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+    char               keys[64][8];
+    size_t             i;
+    bool               all_found;
+
+    result = true;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        d_registry_build_hash_index(reg);
+
+        // test 1: growth
+        for (i = 0; i < 64; ++i)
+        {
+            keys[i][0] = 'k';
+            keys[i][1] = (char)('0' + (i / 10));
+            keys[i][2] = (char)('0' + (i % 10));
+            keys[i][3] = '\0';
+
+            row.key   = keys[i];
+            row.value = (int)i;
+            d_registry_add(reg, &row);
+        }
+
+        all_found = true;
+
+        for (i = 0; i < 64; ++i)
+        {
+            found = (struct test_row*)d_registry_get(reg, keys[i]);
+            if (!found || found->value != (int)i)
+            {
+                all_found = false;
+            }
+        }
+
+        result = d_assert_standalone(
+            all_found && reg->hash_count == 64,
+            "hash_maint_growth",
+            "All 64 keys should resolve after index growth",
+            _counter) && result;
+
+        // test 2: aliases
+        d_registry_add_alias(reg, "k10", "ten");
+        d_registry_add_alias(reg, "k11", "eleven");
+        d_registry_remove_alias(reg, "ten");
+
+        found = (struct test_row*)d_registry_get(reg, "eleven");
+        result = d_assert_standalone(
+            d_registry_get(reg, "ten") == NULL
+            && found != NULL && found->value == 11,
+            "hash_maint_alias",
+            "Alias add/remove should be reflected in the index",
+            _counter) && result;
+
+        // test 3: remove row
+        d_registry_remove(reg, "k11");
+
+        found = (struct test_row*)d_registry_get(reg, "k12");
+        result = d_assert_standalone(
+            d_registry_get(reg, "eleven") == NULL
+            && d_registry_get(reg, "k11") == NULL
+            && found != NULL && found->value == 12
+            && d_registry_index_of(reg, "k12") == 11,
+            "hash_maint_remove",
+            "Removed row should drop its keys and shift later rows",
+            _counter) && result;
+
+        // test 4: rebuild_lookup
+        d_registry_add_alias(reg, "k00", "zero");
+        d_registry_rebuild_lookup(reg);
+
+        result = d_assert_standalone(
+            d_registry_get(reg, "zero") == NULL
+            && d_registry_get(reg, "k00") != NULL
+            && reg->hash_count == 63,
+            "hash_maint_rebuild",
+            "rebuild_lookup should rebuild the index from keys only",
+            _counter) && result;
+
+        // test 5: batch commit
+        d_registry_begin_batch(reg);
+
+        row.key = "batched";  row.value = 100;
+        d_registry_add(reg, &row);
+        d_registry_add_alias(reg, "batched", "bt");
+
+        d_registry_end_batch(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "bt");
+        result = d_assert_standalone(
+            found != NULL && found->value == 100
+            && reg->hash_count == 65,
+            "hash_maint_batch",
+            "Batch commit should rebuild the index",
+            _counter) && result;
+
+        // test 6: clear
+        d_registry_clear(reg);
+
+        result = d_assert_standalone(
+            reg->hash_count == 0
+            && d_registry_get(reg, "k00") == NULL,
+            "hash_maint_clear",
+            "clear should empty the index",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_hash_all
+  Aggregation function that runs all hash index tests.
+*/
+bool
+d_tests_sa_registry_hash_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Hash Index Functions\n");
+    printf("  ------------------------------\n");
+
+    result = d_tests_sa_registry_build_hash_index(_counter) && result;
+    result = d_tests_sa_registry_hash_index_maintenance(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,345 @@
+#include ".\registry_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_intern
+  Tests d_registry_intern and d_registry_is_interned.
+  Tests the following:
+  - NULL arguments return NULL / false
+  - interning copies the string and records its length and hash
+  - keys already held interned by an entry are shared, not copied
+  - caller strings are not reported as interned
+  - frozen registries only hand out existing copies
+*/
+bool
+d_tests_sa_registry_intern
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    const char*        a;
+    const char*        b;
+    char               buf[16];
+
+    result = true;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    // test 1: NULL arguments
+    result = d_assert_standalone(
+        d_registry_intern(NULL, "x") == NULL
+        && d_registry_intern(reg, NULL) == NULL
+        && d_registry_is_interned(NULL, "x") == false
+        && d_registry_is_interned(reg, NULL) == false,
+        "intern_null",
+        "NULL arguments should be rejected",
+        _counter) && result;
+
+    // test 2: copy with length and hash
+    strcpy(buf, "alpha");
+    a = d_registry_intern(reg, buf);
+
+    result = d_assert_standalone(
+        a != NULL
+        && a != buf
+        && strcmp(a, "alpha") == 0
+        && D_REGISTRY_INTERNED_LENGTH(a) == 5
+        && D_REGISTRY_INTERNED(a)->nocase == 0
+        && d_registry_is_interned(reg, a)
+        && !d_registry_is_interned(reg, buf),
+        "intern_copy",
+        "Interning should copy the key with its length",
+        _counter) && result;
+
+    // test 3: shared once an entry holds it
+    row.key   = a;
+    row.value = 1;
+    d_registry_add(reg, &row);
+
+    b = d_registry_intern(reg, buf);
+
+    result = d_assert_standalone(
+        b == a,
+        "intern_shared",
+        "Interning a held key should return the existing copy",
+        _counter) && result;
+
+    // test 4: frozen
+    d_registry_freeze(reg);
+
+    result = d_assert_standalone(
+        d_registry_intern(reg, "alpha") == a
+        && d_registry_intern(reg, "beta") == NULL,
+        "intern_frozen",
+        "Frozen registries should only share existing copies",
+        _counter) && result;
+
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_add_intern
+  Tests d_registry_add_intern, d_registry_add_rows_intern and
+  d_registry_add_alias_intern.
+  Tests the following:
+  - rows added from a temporary key buffer stay reachable after the buffer
+    is overwritten
+  - duplicate keys fail without growing the arena
+  - aliases are interned and resolve to their row
+  - bulk adds intern every key in one batch
+  - the hash index reuses the stored hashes
+*/
+bool
+d_tests_sa_registry_add_intern
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                 result;
+    struct d_registry*   reg;
+    struct test_row      row;
+    struct test_row      rows[3];
+    struct test_row*     found;
+    char                 buf[16];
+    size_t               used;
+
+    result = true;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    d_registry_build_hash_index(reg);
+
+    // test 1: temporary key buffer
+    strcpy(buf, "first");
+    row.key   = buf;
+    row.value = 1;
+
+    result = d_assert_standalone(
+        d_registry_add_intern(reg, &row) == true,
+        "add_intern_ok",
+        "add_intern should succeed",
+        _counter) && result;
+
+    strcpy(buf, "xxxxx");
+    found = D_REGISTRY_GET(reg, "first", struct test_row);
+
+    result = d_assert_standalone(
+        found != NULL
+        && found->value == 1
+        && found->key != buf
+        && d_registry_is_interned(reg, found->key)
+        && D_REGISTRY_GET(reg, "xxxxx", struct test_row) == NULL,
+        "add_intern_owned",
+        "Interned rows should not depend on the caller's buffer",
+        _counter) && result;
+
+    // test 2: duplicate
+    used      = reg->arena->used;
+    row.key   = "first";
+    row.value = 2;
+
+    result = d_assert_standalone(
+        d_registry_add_intern(reg, &row) == false
+        && reg->arena->used == used
+        && d_registry_count(reg) == 1,
+        "add_intern_duplicate",
+        "Duplicates should fail without using arena space",
+        _counter) && result;
+
+    // test 3: alias
+    strcpy(buf, "f");
+
+    result = d_assert_standalone(
+        d_registry_add_alias_intern(reg, "first", buf) == true
+        && d_registry_add_alias_intern(reg, "missing", "m") == false,
+        "add_alias_intern",
+        "Aliases should be interned for existing keys only",
+        _counter) && result;
+
+    strcpy(buf, "z");
+    found = D_REGISTRY_GET(reg, "f", struct test_row);
+
+    result = d_assert_standalone(
+        found != NULL
+        && found->value == 1
+        && D_REGISTRY_GET(reg, "m", struct test_row) == NULL,
+        "add_alias_intern_get",
+        "Interned aliases should resolve to their row",
+        _counter) && result;
+
+    // test 4: bulk
+    rows[0].key = "c";  rows[0].value = 30;
+    rows[1].key = "a";  rows[1].value = 10;
+    rows[2].key = "b";  rows[2].value = 20;
+
+    result = d_assert_standalone(
+        d_registry_add_rows_intern(reg, rows, 3) == true
+        && d_registry_count(reg) == 4
+        && d_registry_is_interned(reg, D_REGISTRY_GET(reg, "a", struct test_row)->key)
+        && D_REGISTRY_GET(reg, "c", struct test_row)->value == 30,
+        "add_rows_intern",
+        "add_rows_intern should intern every key",
+        _counter) && result;
+
+    // test 5: hash index
+    found = D_REGISTRY_GET(reg, "b", struct test_row);
+
+    result = d_assert_standalone(
+        D_REGISTRY_HAS_HASH_INDEX(reg)
+        && reg->hash_count == reg->lookup_count
+        && found != NULL
+        && found->value == 20,
+        "add_intern_hash",
+        "The hash index should resolve interned keys",
+        _counter) && result;
+
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_intern_lifetime
+  Tests arena ownership across copies and clears.
+  Tests the following:
+  - d_registry_new_copy gives the copy its own interned keys
+  - the copy keeps working after the source is freed
+  - d_registry_clear releases the arena
+  - case-insensitive registries store folded hashes
+*/
+bool
+d_tests_sa_registry_intern_lifetime
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct d_registry* copy;
+    struct test_row    row;
+    struct test_row*   a;
+    struct test_row*   b;
+
+    result = true;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    row.key = "one";  row.value = 1;
+    d_registry_add_intern(reg, &row);
+    row.key = "two";  row.value = 2;
+    d_registry_add_intern(reg, &row);
+    d_registry_add_alias_intern(reg, "two", "deux");
+
+    // test 1: copy owns its keys
+    copy = d_registry_new_copy(reg);
+    a    = D_REGISTRY_GET(reg, "two", struct test_row);
+    b    = (copy) ? D_REGISTRY_GET(copy, "two", struct test_row) : NULL;
+
+    result = d_assert_standalone(
+        copy != NULL
+        && copy->arena != NULL
+        && a && b
+        && a->key != b->key
+        && d_registry_is_interned(copy, b->key)
+        && !d_registry_is_interned(copy, a->key),
+        "intern_copy_owns",
+        "A copy should hold its own interned keys",
+        _counter) && result;
+
+    // test 2: copy survives the source
+    d_registry_free(reg);
+
+    result = d_assert_standalone(
+        copy != NULL
+        && D_REGISTRY_GET(copy, "deux", struct test_row) != NULL
+        && D_REGISTRY_GET(copy, "one", struct test_row)->value == 1,
+        "intern_copy_survives",
+        "The copy should keep working after the source is freed",
+        _counter) && result;
+
+    // test 3: clear
+    d_registry_clear(copy);
+
+    result = d_assert_standalone(
+        copy != NULL
+        && copy->arena == NULL
+        && d_registry_count(copy) == 0,
+        "intern_clear",
+        "Clearing should release the arena",
+        _counter) && result;
+
+    d_registry_free(copy);
+
+    // test 4: folded hash
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        reg->flags |= (uint8_t)D_REGISTRY_FLAG_CASE_INSENSITIVE;
+        d_registry_build_hash_index(reg);
+
+        row.key = "Mixed";  row.value = 7;
+        d_registry_add_intern(reg, &row);
+
+        a = D_REGISTRY_GET(reg, "mIXED", struct test_row);
+
+        result = d_assert_standalone(
+            a != NULL
+            && a->value == 7
+            && D_REGISTRY_INTERNED(a->key)->nocase == 1,
+            "intern_nocase",
+            "Case-insensitive interned keys should hash folded",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_intern_all
+  Aggregation function that runs all interned key tests.
+*/
+bool
+d_tests_sa_registry_intern_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Interned Keys\n");
+    printf("  -----------------------\n");
+
+    result = d_tests_sa_registry_intern(_counter) && result;
+    result = d_tests_sa_registry_add_intern(_counter) && result;
+    result = d_tests_sa_registry_intern_lifetime(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,280 @@
+#include ".\registry_tests_sa.h"
+
+
+/*
+d_tests_sa_registry_enable_key_prefix
+  Tests the d_registry_enable_key_prefix and d_registry_disable_key_prefix
+  functions.
+  Tests the following:
+  - NULL registry returns false / does not crash
+  - enable sets D_REGISTRY_FLAG_KEY_PREFIX and fills every entry's prefix
+  - keys shorter than, equal to and longer than the prefix resolve
+  - keys sharing a long common prefix resolve to the right rows
+  - missing keys return NULL
+  - rows added after enabling carry prefixes and stay sorted
+  - toggling case-insensitivity plus sort_lookup refreshes folded prefixes
+  - disable clears the flag and lookups still work
+*/
+bool
+d_tests_sa_registry_enable_key_prefix
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+    size_t             i;
+    bool               sorted;
+
+    result = true;
+
+    // test 1: NULL registry
+    result = d_assert_standalone(
+        d_registry_enable_key_prefix(NULL) == false,
+        "prefix_enable_null",
+        "NULL registry should return false",
+        _counter) && result;
+
+    d_registry_disable_key_prefix(NULL);
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        row.key = "ab";                     row.value = 1;
+        d_registry_add(reg, &row);
+        row.key = "abcdefgh";               row.value = 2;
+        d_registry_add(reg, &row);
+        row.key = "abcdefgh_long_tail_1";   row.value = 3;
+        d_registry_add(reg, &row);
+        row.key = "abcdefgh_long_tail_2";   row.value = 4;
+        d_registry_add(reg, &row);
+
+        // test 2: enable
+        result = d_assert_standalone(
+            d_registry_enable_key_prefix(reg) == true
+            && D_REGISTRY_HAS_KEY_PREFIX(reg)
+            && reg->lookup[0].prefix == 0x6162000000000000ULL
+            && reg->lookup[1].prefix == 0x6162636465666768ULL,
+            "prefix_enable_ok",
+            "Entries should carry big-endian packed prefixes",
+            _counter) && result;
+
+        // test 3: short / exact / long keys
+        found = (struct test_row*)d_registry_get(reg, "abcdefgh");
+        result = d_assert_standalone(
+            found != NULL && found->value == 2
+            && d_registry_index_of(reg, "ab") == 0,
+            "prefix_get_short",
+            "Keys up to 8 bytes should resolve",
+            _counter) && result;
+
+        // test 4: shared 8-byte prefix
+        found = (struct test_row*)d_registry_get(reg, "abcdefgh_long_tail_2");
+        result = d_assert_standalone(
+            found != NULL && found->value == 4,
+            "prefix_get_long",
+            "Keys sharing a prefix should compare their tails",
+            _counter) && result;
+
+        // test 5: missing keys
+        result = d_assert_standalone(
+            d_registry_get(reg, "abc") == NULL
+            && d_registry_get(reg, "abcdefgh_long_tail_") == NULL
+            && d_registry_get(reg, "") == NULL,
+            "prefix_get_missing",
+            "Missing keys should not resolve",
+            _counter) && result;
+
+        // test 6: later insertions
+        row.key = "aardvark";  row.value = 5;
+        d_registry_add(reg, &row);
+        d_registry_add_alias(reg, "ab", "abcdefgh_alias");
+
+        sorted = true;
+
+        for (i = 1; i < reg->lookup_count; ++i)
+        {
+            if (strcmp(reg->lookup[i - 1].key, reg->lookup[i].key) >= 0)
+            {
+                sorted = false;
+            }
+        }
+
+        found = (struct test_row*)d_registry_get(reg, "abcdefgh_alias");
+        result = d_assert_standalone(
+            sorted
+            && found != NULL && found->value == 1
+            && d_registry_index_of(reg, "aardvark") == 4,
+            "prefix_add_later",
+            "Rows and aliases added later should be found",
+            _counter) && result;
+
+        // test 7: case-insensitive toggle
+        reg->flags |= (uint8_t)D_REGISTRY_FLAG_CASE_INSENSITIVE;
+        d_registry_sort_lookup(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "ABCDEFGH_LONG_TAIL_1");
+        result = d_assert_standalone(
+            found != NULL && found->value == 3
+            && d_registry_contains(reg, "AB"),
+            "prefix_nocase",
+            "Folded prefixes should match mixed-case lookups",
+            _counter) && result;
+
+        // test 8: disable
+        d_registry_disable_key_prefix(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "abcdefgh_long_tail_1");
+        result = d_assert_standalone(
+            !D_REGISTRY_HAS_KEY_PREFIX(reg)
+            && found != NULL && found->value == 3,
+            "prefix_disable",
+            "Lookups should work after disabling prefixes",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_key_prefix_maintenance
+  Tests that inline key prefixes survive the bulk paths.
+  Tests the following:
+  - d_registry_new_from_array_flags with D_REGISTRY_FLAG_KEY_PREFIX
+  - keys added in a batch resolve after commit
+  - rebuild_lookup refills prefixes
+  - the prefix comparators agree with the full-key comparators
+*/
+bool
+d_tests_sa_registry_key_prefix_maintenance
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                           result;
+    struct d_registry*             reg;
+    struct test_row                row;
+    struct test_row*               found;
+    struct d_registry_lookup_entry a;
+    struct d_registry_lookup_entry b;
+    struct test_row                rows[3] =
+    {
+        { "settings.video.width",  1 },
+        { "settings.video.height", 2 },
+        { "settings.audio",        3 }
+    };
+
+    result = true;
+
+    reg = d_registry_new_from_array_flags(rows,
+                                          sizeof(struct test_row),
+                                          3,
+                                          D_REGISTRY_FLAG_KEY_PREFIX);
+
+    if (reg)
+    {
+        // test 1: built with prefixes
+        found = (struct test_row*)d_registry_get(reg, "settings.video.height");
+        result = d_assert_standalone(
+            D_REGISTRY_HAS_KEY_PREFIX(reg)
+            && found != NULL && found->value == 2
+            && d_registry_get(reg, "settings.video") == NULL,
+            "prefix_from_array",
+            "from_array_flags should honor KEY_PREFIX",
+            _counter) && result;
+
+        // test 2: batch
+        d_registry_begin_batch(reg);
+
+        row.key = "settings.audio.volume";  row.value = 4;
+        d_registry_add(reg, &row);
+        row.key = "settings.a";             row.value = 5;
+        d_registry_add(reg, &row);
+
+        found = (struct test_row*)d_registry_get(reg, "settings.a");
+        result = d_assert_standalone(
+            found != NULL && found->value == 5,
+            "prefix_batch_staged",
+            "Staged keys should be visible during a batch",
+            _counter) && result;
+
+        d_registry_end_batch(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "settings.audio.volume");
+        result = d_assert_standalone(
+            found != NULL && found->value == 4
+            && d_registry_index_of(reg, "settings.audio") == 2,
+            "prefix_batch_commit",
+            "Committed keys should resolve",
+            _counter) && result;
+
+        // test 3: rebuild
+        d_registry_rebuild_lookup(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "settings.video.width");
+        result = d_assert_standalone(
+            found != NULL && found->value == 1
+            && reg->lookup[0].prefix != 0,
+            "prefix_rebuild",
+            "rebuild_lookup should refill prefixes",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    // test 4: comparators
+    a.key    = "abcdefghZ";
+    a.prefix = 0x6162636465666768ULL;
+    b.key    = "ABCDEFGHz";
+    b.prefix = 0x6162636465666768ULL;
+
+    result = d_assert_standalone(
+        d_registry_lookup_compare_prefix_nocase(&a, &b) == 0
+        && d_registry_lookup_compare_prefix(&a, &a) == 0,
+        "prefix_compare_equal",
+        "Equal prefixes should fall through to the tails",
+        _counter) && result;
+
+    b.key    = "abcdefgi";
+    b.prefix = 0x6162636465666769ULL;
+
+    result = d_assert_standalone(
+        d_registry_lookup_compare_prefix(&a, &b) < 0
+        && d_registry_lookup_compare_prefix(&b, &a) > 0
+        && d_registry_lookup_compare(&a, &b) < 0,
+        "prefix_compare_order",
+        "Prefix order should match key order",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_key_prefix_all
+  Aggregation function that runs all key prefix tests.
+*/
+bool
+d_tests_sa_registry_key_prefix_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Key Prefix Functions\n");
+    printf("  ------------------------------\n");
+
+    result = d_tests_sa_registry_enable_key_prefix(_counter) && result;
+    result = d_tests_sa_registry_key_prefix_maintenance(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,298 @@
+#include ".\registry_tests_sa.h"
+
+
+D_REGISTRY_DEFINE(g_perfect_static, struct test_row,
+    D_REGISTRY_ROW("zebra", 1),
+    D_REGISTRY_ROW("apple", 2),
+    D_REGISTRY_ROW("mango", 3),
+    D_REGISTRY_ROW("kiwi",  4)
+);
+
+
+/*
+d_tests_sa_registry_build_perfect_hash
+  Tests the d_registry_build_perfect_hash and d_registry_drop_perfect_hash
+  functions.
+  Tests the following:
+  - NULL registry returns false / does not crash
+  - empty registry returns false
+  - freeze builds a perfect hash covering keys and aliases
+  - every key of a large registry resolves; missing keys do not
+  - case-insensitive registries resolve case-folded probes
+  - thaw drops the perfect hash
+*/
+bool
+d_tests_sa_registry_build_perfect_hash
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+    char               keys[500][8];
+    size_t             i;
+    bool               all_found;
+
+    result = true;
+
+    // test 1: NULL registry
+    result = d_assert_standalone(
+        d_registry_build_perfect_hash(NULL) == false,
+        "perfect_null",
+        "NULL registry should return false",
+        _counter) && result;
+
+    d_registry_drop_perfect_hash(NULL);
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        // test 2: empty
+        result = d_assert_standalone(
+            d_registry_build_perfect_hash(reg) == false
+            && reg->perfect_hash == NULL,
+            "perfect_empty",
+            "Empty registry should not build a perfect hash",
+            _counter) && result;
+
+        // test 3: freeze builds
+        for (i = 0; i < 500; ++i)
+        {
+            keys[i][0] = 'K';
+            keys[i][1] = (char)('0' + (i / 100));
+            keys[i][2] = (char)('0' + ((i / 10) % 10));
+            keys[i][3] = (char)('0' + (i % 10));
+            keys[i][4] = '\0';
+
+            row.key   = keys[i];
+            row.value = (int)i;
+            d_registry_add(reg, &row);
+        }
+
+        d_registry_add_alias(reg, "K042", "answer");
+        reg->flags |= (uint8_t)D_REGISTRY_FLAG_CASE_INSENSITIVE;
+        d_registry_sort_lookup(reg);
+        d_registry_freeze(reg);
+
+        result = d_assert_standalone(
+            reg->perfect_hash != NULL
+            && reg->perfect_slots == 501,
+            "perfect_freeze_builds",
+            "Freeze should build a perfect hash over 501 entries",
+            _counter) && result;
+
+        // test 4: all keys resolve
+        all_found = true;
+
+        for (i = 0; i < 500; ++i)
+        {
+            found = (struct test_row*)d_registry_get(reg, keys[i]);
+            if (!found || found->value != (int)i)
+            {
+                all_found = false;
+            }
+        }
+
+        found = (struct test_row*)d_registry_get(reg, "answer");
+        result = d_assert_standalone(
+            all_found && found != NULL && found->value == 42,
+            "perfect_all_found",
+            "Every key and alias should resolve via the perfect hash",
+            _counter) && result;
+
+        result = d_assert_standalone(
+            d_registry_get(reg, "K500") == NULL
+            && d_registry_get(reg, "") == NULL,
+            "perfect_missing",
+            "Missing keys should not resolve",
+            _counter) && result;
+
+        // test 5: case-insensitive
+        found = (struct test_row*)d_registry_get(reg, "k123");
+        result = d_assert_standalone(
+            found != NULL && found->value == 123,
+            "perfect_nocase",
+            "'k123' should resolve case-insensitively",
+            _counter) && result;
+
+        // test 6: thaw drops
+        d_registry_thaw(reg);
+
+        found = (struct test_row*)d_registry_get(reg, "ANSWER");
+        result = d_assert_standalone(
+            reg->perfect_hash == NULL
+            && found != NULL && found->value == 42,
+            "perfect_thaw",
+            "Thaw should drop the perfect hash and fall back",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_perfect_hash_static
+  Tests the perfect hash on a D_REGISTRY_DEFINE'd static registry.
+  Tests the following:
+  - D_REGISTRY_INIT freezes the registry and builds the perfect hash
+  - rows are found without touching the static tables
+  - missing keys return NULL
+*/
+bool
+d_tests_sa_registry_perfect_hash_static
+(
+    struct d_test_counter* _counter
+)
+{
+    bool             result;
+    struct test_row* found;
+
+    result = true;
+
+    D_REGISTRY_INIT(&g_perfect_static);
+
+    // test 1: frozen with perfect hash
+    result = d_assert_standalone(
+        D_REGISTRY_IS_FROZEN(&g_perfect_static)
+        && g_perfect_static.perfect_hash != NULL,
+        "perfect_static_init",
+        "D_REGISTRY_INIT should freeze and build the perfect hash",
+        _counter) && result;
+
+    // test 2: rows found
+    found = D_REGISTRY_GET(&g_perfect_static, "mango", struct test_row);
+    result = d_assert_standalone(
+        found != NULL && found->value == 3,
+        "perfect_static_get",
+        "'mango' should resolve to value 3",
+        _counter) && result;
+
+    // test 3: missing key
+    result = d_assert_standalone(
+        d_registry_get(&g_perfect_static, "pear") == NULL,
+        "perfect_static_missing",
+        "'pear' should not resolve",
+        _counter) && result;
+
+    d_registry_drop_perfect_hash(&g_perfect_static);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_perfect_hash_ownership
+  Tests freeze idempotence and registries whose perfect hash is external.
+  Tests the following:
+  - freezing a frozen registry keeps its perfect hash
+  - freeze leaves an external perfect hash in place
+  - thaw, drop and rebuild refuse to touch an external perfect hash
+  - d_registry_free does not free an external perfect hash
+*/
+bool
+d_tests_sa_registry_perfect_hash_ownership
+(
+    struct d_test_counter* _counter
+)
+{
+    static uint32_t    external[64];
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+    uint32_t*          table;
+    size_t             size;
+
+    result = true;
+    reg    = d_registry_new(sizeof(struct test_row));
+
+    if (!reg)
+    {
+        return false;
+    }
+
+    row.key = "zebra"; row.value = 1; d_registry_add(reg, &row);
+    row.key = "apple"; row.value = 2; d_registry_add(reg, &row);
+    row.key = "mango"; row.value = 3; d_registry_add(reg, &row);
+    d_registry_freeze(reg);
+
+    // test 1: refreezing is a no-op
+    table = reg->perfect_hash;
+
+    result = d_assert_standalone(
+        table != NULL
+        && d_registry_freeze(reg)
+        && reg->perfect_hash == table,
+        "perfect_refreeze",
+        "Freezing a frozen registry should keep its perfect hash",
+        _counter) && result;
+
+    // move the table into storage the registry does not own
+    size = reg->perfect_buckets + reg->perfect_slots;
+
+    if ( (table) &&
+         (size <= (sizeof(external) / sizeof(external[0]))) )
+    {
+        memcpy(external, table, size * sizeof(uint32_t));
+        free(table);
+        reg->perfect_hash   = external;
+        reg->external_index = true;
+
+        // test 2: freeze, thaw, drop and rebuild leave it alone
+        result = d_assert_standalone(
+            d_registry_freeze(reg)
+            && !d_registry_thaw(reg)
+            && !d_registry_build_perfect_hash(reg)
+            && D_REGISTRY_IS_FROZEN(reg)
+            && reg->perfect_hash == external,
+            "perfect_external_kept",
+            "An external perfect hash should survive freeze/thaw/rebuild",
+            _counter) && result;
+
+        d_registry_drop_perfect_hash(reg);
+        found = (struct test_row*)d_registry_get(reg, "mango");
+
+        result = d_assert_standalone(
+            reg->perfect_hash == external
+            && found != NULL && found->value == 3,
+            "perfect_external_drop",
+            "Dropping should not detach an external perfect hash",
+            _counter) && result;
+    }
+
+    // test 3: free skips the external table (ASan reports it otherwise)
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_perfect_hash_all
+  Aggregation function that runs all perfect hash tests.
+*/
+bool
+d_tests_sa_registry_perfect_hash_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Perfect Hash Functions\n");
+    printf("  --------------------------------\n");
+
+    result = d_tests_sa_registry_build_perfect_hash(_counter) && result;
+    result = d_tests_sa_registry_perfect_hash_static(_counter) && result;
+    result = d_tests_sa_registry_perfect_hash_ownership(_counter) && result;
+
+    return result;
+}
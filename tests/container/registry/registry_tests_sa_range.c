@@ -0,0 +1,337 @@
+#include ".\registry_tests_sa.h"
+
+
+/******************************************************************************
+ * HELPER CALLBACKS
+ *****************************************************************************/
+
+
+/*
+pred_value_greater
+  Predicate: returns true if the row's value field is > *(int*)_context.
+*/
+static bool
+pred_value_greater
+(
+    const void* _row,
+    const void* _context
+)
+{
+    if ( (!_row) ||
+         (!_context) )
+    {
+        return false;
+    }
+
+    return ((const struct test_row*)_row)->value > *(const int*)_context;
+}
+
+
+/*
+d_tests_sa_registry_find_prefix
+  Tests the d_registry_find_prefix function.
+  Tests the following:
+  - NULL registry / NULL prefix return an empty slice
+  - a prefix selects exactly the matching keys and aliases, in key order
+  - an empty prefix selects every lookup entry
+  - a prefix matching nothing returns an empty slice
+  - case-insensitive registries match the prefix case-insensitively
+*/
+bool
+d_tests_sa_registry_find_prefix
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_registry*      reg;
+    struct test_row         row;
+    struct d_registry_slice slice;
+
+    result = true;
+
+    // test 1: NULL arguments
+    slice = d_registry_find_prefix(NULL, "a");
+    result = d_assert_standalone(
+        D_REGISTRY_SLICE_COUNT(slice) == 0,
+        "find_prefix_null_reg",
+        "NULL registry should give an empty slice",
+        _counter) && result;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        slice = d_registry_find_prefix(reg, NULL);
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(slice) == 0,
+            "find_prefix_null_prefix",
+            "NULL prefix should give an empty slice",
+            _counter) && result;
+
+        row.key = "sv_cheats";    row.value = 1;
+        d_registry_add(reg, &row);
+        row.key = "sv_gravity";   row.value = 2;
+        d_registry_add(reg, &row);
+        row.key = "cl_fov";       row.value = 3;
+        d_registry_add(reg, &row);
+        row.key = "sv";           row.value = 4;
+        d_registry_add(reg, &row);
+        d_registry_add_alias(reg, "cl_fov", "sv_fov_alias");
+
+        // test 2: prefix selects keys and aliases
+        slice = d_registry_find_prefix(reg, "sv_");
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(slice) == 3
+            && strcmp(slice.first[0].key, "sv_cheats") == 0
+            && strcmp(slice.first[1].key, "sv_fov_alias") == 0
+            && strcmp(slice.first[2].key, "sv_gravity") == 0,
+            "find_prefix_match",
+            "sv_ should match three entries in key order",
+            _counter) && result;
+
+        // test 3: empty prefix
+        slice = d_registry_find_prefix(reg, "");
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(slice) == reg->lookup_count
+            && slice.first == reg->lookup,
+            "find_prefix_empty",
+            "Empty prefix should select every entry",
+            _counter) && result;
+
+        // test 4: no match
+        slice = d_registry_find_prefix(reg, "zz");
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(slice) == 0,
+            "find_prefix_no_match",
+            "Unmatched prefix should give an empty slice",
+            _counter) && result;
+
+        // test 5: case-insensitive
+        slice = d_registry_find_prefix(reg, "SV_");
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(slice) == 0,
+            "find_prefix_case_sensitive",
+            "Case-sensitive registries should not fold the prefix",
+            _counter) && result;
+
+        reg->flags |= (uint8_t)D_REGISTRY_FLAG_CASE_INSENSITIVE;
+        d_registry_sort_lookup(reg);
+
+        slice = d_registry_find_prefix(reg, "SV_G");
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(slice) == 1
+            && strcmp(slice.first[0].key, "sv_gravity") == 0,
+            "find_prefix_nocase",
+            "Case-insensitive registries should fold the prefix",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_range
+  Tests the d_registry_range function.
+  Tests the following:
+  - NULL registry returns an empty slice
+  - [low, high) selects keys in the half-open interval
+  - NULL bounds are unbounded
+  - an inverted interval is empty
+*/
+bool
+d_tests_sa_registry_range
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_registry*      reg;
+    struct test_row         row;
+    struct d_registry_slice slice;
+
+    result = true;
+
+    // test 1: NULL registry
+    slice = d_registry_range(NULL, "a", "b");
+    result = d_assert_standalone(
+        D_REGISTRY_SLICE_COUNT(slice) == 0,
+        "range_null",
+        "NULL registry should give an empty slice",
+        _counter) && result;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        row.key = "apple";   row.value = 1;
+        d_registry_add(reg, &row);
+        row.key = "banana";  row.value = 2;
+        d_registry_add(reg, &row);
+        row.key = "cherry";  row.value = 3;
+        d_registry_add(reg, &row);
+        row.key = "date";    row.value = 4;
+        d_registry_add(reg, &row);
+
+        // test 2: half-open interval
+        slice = d_registry_range(reg, "banana", "date");
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(slice) == 2
+            && strcmp(slice.first[0].key, "banana") == 0
+            && strcmp(slice.first[1].key, "cherry") == 0,
+            "range_half_open",
+            "[banana, date) should hold banana and cherry",
+            _counter) && result;
+
+        // test 3: unbounded sides
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(d_registry_range(reg, NULL, "b")) == 1
+            && D_REGISTRY_SLICE_COUNT(d_registry_range(reg, "c", NULL)) == 2
+            && D_REGISTRY_SLICE_COUNT(d_registry_range(reg, NULL, NULL)) == 4,
+            "range_unbounded",
+            "NULL bounds should be open-ended",
+            _counter) && result;
+
+        // test 4: inverted
+        slice = d_registry_range(reg, "date", "apple");
+        result = d_assert_standalone(
+            D_REGISTRY_SLICE_COUNT(slice) == 0,
+            "range_inverted",
+            "Inverted interval should be empty",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_iterator_slice
+  Tests the d_registry_iterator_slice and d_registry_iterator_prefix
+  functions.
+  Tests the following:
+  - prefix iterator yields matching rows in key order
+  - filters apply to slice iterators
+  - reset restarts the slice
+  - empty slices yield nothing
+*/
+bool
+d_tests_sa_registry_iterator_slice
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                       result;
+    struct d_registry*         reg;
+    struct test_row            row;
+    struct test_row*           r;
+    struct d_registry_iterator it;
+    int                        values[4];
+    size_t                     n;
+    int                        threshold;
+
+    result = true;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (reg)
+    {
+        row.key = "ns.zeta";   row.value = 1;
+        d_registry_add(reg, &row);
+        row.key = "other";     row.value = 2;
+        d_registry_add(reg, &row);
+        row.key = "ns.alpha";  row.value = 3;
+        d_registry_add(reg, &row);
+        row.key = "ns.mid";    row.value = 4;
+        d_registry_add(reg, &row);
+
+        // test 1: prefix iterator in key order
+        it = d_registry_iterator_prefix(reg, "ns.");
+        n  = 0;
+
+        while (d_registry_iterator_has_next(&it) && n < 4)
+        {
+            r = (struct test_row*)d_registry_iterator_next(&it);
+            values[n++] = r->value;
+        }
+
+        result = d_assert_standalone(
+            n == 3 && values[0] == 3 && values[1] == 4 && values[2] == 1
+            && d_registry_iterator_next(&it) == NULL,
+            "iter_slice_order",
+            "Prefix iterator should yield ns.* rows in key order",
+            _counter) && result;
+
+        // test 2: filter
+        threshold = 2;
+        it = d_registry_iterator_slice(reg, d_registry_find_prefix(reg, "ns."));
+        it.filter     = pred_value_greater;
+        it.filter_ctx = &threshold;
+        n  = 0;
+
+        while ((r = (struct test_row*)d_registry_iterator_next(&it)) != NULL)
+        {
+            n++;
+        }
+
+        result = d_assert_standalone(
+            n == 2,
+            "iter_slice_filter",
+            "Filter should apply to slice iterators",
+            _counter) && result;
+
+        // test 3: reset
+        d_registry_iterator_reset(&it);
+        r = (struct test_row*)d_registry_iterator_next(&it);
+
+        result = d_assert_standalone(
+            r != NULL && r->value == 3,
+            "iter_slice_reset",
+            "Reset should restart at the first slice entry",
+            _counter) && result;
+
+        // test 4: empty
+        it = d_registry_iterator_prefix(reg, "none.");
+
+        result = d_assert_standalone(
+            !d_registry_iterator_has_next(&it)
+            && d_registry_iterator_next(&it) == NULL,
+            "iter_slice_empty",
+            "Empty slice should yield nothing",
+            _counter) && result;
+
+        d_registry_free(reg);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_range_all
+  Aggregation function that runs all range query tests.
+*/
+bool
+d_tests_sa_registry_range_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Range Query Functions\n");
+    printf("  -------------------------------\n");
+
+    result = d_tests_sa_registry_find_prefix(_counter) && result;
+    result = d_tests_sa_registry_range(_counter) && result;
+    result = d_tests_sa_registry_iterator_slice(_counter) && result;
+
+    return result;
+}
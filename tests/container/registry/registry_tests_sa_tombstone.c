@@ -0,0 +1,394 @@
+#include ".\registry_tests_sa.h"
+
+
+/******************************************************************************
+ * HELPER CALLBACKS
+ *****************************************************************************/
+
+static int g_tombstone_free_calls;
+
+
+/*
+tombstone_row_free
+  Row destructor: counts calls.
+*/
+static void
+tombstone_row_free
+(
+    void* _row
+)
+{
+    (void)_row;
+
+    g_tombstone_free_calls++;
+}
+
+
+/*
+tombstone_visit_sum
+  Visitor: adds the row's value to *(int*)_context.
+*/
+static bool
+tombstone_visit_sum
+(
+    void*       _row,
+    void*       _context
+)
+{
+    *(int*)_context += ((struct test_row*)_row)->value;
+
+    return true;
+}
+
+
+/*
+tombstone_make
+  Helper: registry with D_REGISTRY_FLAG_TOMBSTONES and rows k0..k9 holding
+  values 1..10.
+*/
+static struct d_registry*
+tombstone_make
+(
+    void
+)
+{
+    static const char* keys[10] =
+    {
+        "k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7", "k8", "k9"
+    };
+    struct d_registry* reg;
+    struct test_row    row;
+    int                i;
+
+    reg = d_registry_new(sizeof(struct test_row));
+
+    if (!reg)
+    {
+        return NULL;
+    }
+
+    reg->flags |= (uint8_t)D_REGISTRY_FLAG_TOMBSTONES;
+
+    for (i = 0; i < 10; ++i)
+    {
+        row.key   = keys[i];
+        row.value = i + 1;
+        d_registry_add(reg, &row);
+    }
+
+    return reg;
+}
+
+
+/*
+d_tests_sa_registry_tombstone_remove
+  Tests removal with D_REGISTRY_FLAG_TOMBSTONES.
+  Tests the following:
+  - removal leaves the slot in place and keeps other row indices stable
+  - count reports live rows; at() returns NULL for the dead slot
+  - the removed key and its aliases no longer resolve
+  - removing a dead slot again fails
+  - the key can be added again
+  - the hash index stays consistent
+*/
+bool
+d_tests_sa_registry_tombstone_remove
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+
+    result = true;
+
+    reg = tombstone_make();
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    d_registry_build_hash_index(reg);
+    d_registry_add_alias(reg, "k3", "three");
+
+    // test 1: stable indices
+    result = d_assert_standalone(
+        d_registry_remove(reg, "k3") == true
+        && reg->count == 10
+        && reg->dead_count == 1
+        && d_registry_index_of(reg, "k7") == 7,
+        "tombstone_stable_index",
+        "Removal should not move other rows",
+        _counter) && result;
+
+    // test 2: live count and dead slot
+    result = d_assert_standalone(
+        d_registry_count(reg) == 9
+        && d_registry_at(reg, 3) == NULL
+        && d_registry_at(reg, 4) != NULL
+        && !d_registry_is_empty(reg),
+        "tombstone_count",
+        "count should report live rows only",
+        _counter) && result;
+
+    // test 3: key and alias gone
+    result = d_assert_standalone(
+        d_registry_get(reg, "k3") == NULL
+        && d_registry_get(reg, "three") == NULL
+        && reg->lookup_count == 9
+        && reg->hash_count == 9,
+        "tombstone_lookup_dropped",
+        "Key, alias and hash entries should be dropped",
+        _counter) && result;
+
+    // test 4: double removal
+    result = d_assert_standalone(
+        d_registry_remove_at(reg, 3) == false
+        && d_registry_remove(reg, "k3") == false,
+        "tombstone_remove_twice",
+        "A dead slot cannot be removed again",
+        _counter) && result;
+
+    // test 5: re-add
+    row.key = "k3";  row.value = 33;
+    d_registry_add(reg, &row);
+
+    found = (struct test_row*)d_registry_get(reg, "k3");
+    result = d_assert_standalone(
+        found != NULL && found->value == 33
+        && d_registry_index_of(reg, "k3") == 10,
+        "tombstone_readd",
+        "A removed key should be addable again",
+        _counter) && result;
+
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_tombstone_iteration
+  Tests that iteration skips dead rows.
+  Tests the following:
+  - D_REGISTRY_FOREACH
+  - d_registry_iterator_new / has_next / next
+  - d_registry_foreach and d_registry_foreach_if
+*/
+bool
+d_tests_sa_registry_tombstone_iteration
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                       result;
+    struct d_registry*         reg;
+    struct d_registry_iterator it;
+    struct test_row*           r;
+    int                        sum;
+
+    result = true;
+
+    reg = tombstone_make();
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    // values 1..10 sum to 55; k0 (1) and k9 (10) are removed
+    d_registry_remove(reg, "k0");
+    d_registry_remove(reg, "k9");
+
+    // test 1: FOREACH
+    sum = 0;
+
+    D_REGISTRY_FOREACH(reg, struct test_row, row)
+    {
+        sum += row->value;
+    }
+
+    result = d_assert_standalone(
+        sum == 44,
+        "tombstone_foreach_macro",
+        "D_REGISTRY_FOREACH should skip dead rows",
+        _counter) && result;
+
+    // test 2: iterator
+    sum = 0;
+    it  = d_registry_iterator_new(reg);
+
+    while (d_registry_iterator_has_next(&it))
+    {
+        r = (struct test_row*)d_registry_iterator_next(&it);
+
+        if (r)
+        {
+            sum += r->value;
+        }
+    }
+
+    result = d_assert_standalone(
+        sum == 44,
+        "tombstone_iterator",
+        "Iterators should skip dead rows",
+        _counter) && result;
+
+    // test 3: callbacks
+    sum = 0;
+    d_registry_foreach(reg, tombstone_visit_sum, &sum);
+    d_registry_foreach_if(reg, NULL, NULL, tombstone_visit_sum, &sum);
+
+    result = d_assert_standalone(
+        sum == 88,
+        "tombstone_foreach_fn",
+        "foreach and foreach_if should skip dead rows",
+        _counter) && result;
+
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_tombstone_compact
+  Tests lazy and explicit compaction.
+  Tests the following:
+  - crossing D_REGISTRY_TOMBSTONE_COMPACT_PERCENT compacts automatically
+  - compaction remaps lookup and hash row indices
+  - d_registry_compact removes remaining tombstones
+  - row_free runs once per removed row, including on clear
+  - a batch commit compacts tombstones first
+*/
+bool
+d_tests_sa_registry_tombstone_compact
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_registry* reg;
+    struct test_row    row;
+    struct test_row*   found;
+    size_t             threshold;
+    size_t             removed;
+
+    result = true;
+
+    reg = tombstone_make();
+
+    if (!reg)
+    {
+        return result;
+    }
+
+    reg->flags    |= (uint8_t)D_REGISTRY_FLAG_OWNS_ROWS;
+    reg->row_free  = tombstone_row_free;
+    g_tombstone_free_calls = 0;
+    d_registry_build_hash_index(reg);
+
+    // test 1: automatic compaction
+    threshold = (10 * D_REGISTRY_TOMBSTONE_COMPACT_PERCENT + 99) / 100;
+    removed   = 0;
+
+    while ( (removed < threshold) &&
+            (reg->dead_count == removed) )
+    {
+        d_registry_remove_at(reg, removed * 2);
+        removed++;
+    }
+
+    result = d_assert_standalone(
+        reg->dead_count == 0
+        && reg->count == 10 - threshold
+        && g_tombstone_free_calls == (int)threshold,
+        "tombstone_auto_compact",
+        "Crossing the threshold should compact the rows",
+        _counter) && result;
+
+    // test 2: remapped indices
+    found = (struct test_row*)d_registry_get(reg, "k9");
+    result = d_assert_standalone(
+        found != NULL && found->value == 10
+        && d_registry_index_of(reg, "k9") == (ssize_t)(reg->count - 1)
+        && reg->hash_count == reg->lookup_count,
+        "tombstone_compact_remap",
+        "Lookups should follow compacted rows",
+        _counter) && result;
+
+    // test 3: explicit compaction
+    d_registry_remove(reg, "k9");
+
+    result = d_assert_standalone(
+        reg->dead_count == 1
+        && d_registry_compact(reg) == true
+        && reg->dead_count == 0
+        && d_registry_count(reg) == reg->count
+        && d_registry_compact(NULL) == false,
+        "tombstone_compact_explicit",
+        "d_registry_compact should remove tombstones",
+        _counter) && result;
+
+    // test 4: batch commit
+    d_registry_remove(reg, "k1");
+    d_registry_begin_batch(reg);
+    row.key = "z0";  row.value = 100;
+    d_registry_add(reg, &row);
+    d_registry_end_batch(reg);
+
+    found = (struct test_row*)d_registry_get(reg, "z0");
+    result = d_assert_standalone(
+        reg->dead_count == 0
+        && found != NULL && found->value == 100
+        && d_registry_get(reg, "k1") == NULL
+        && d_registry_get(reg, "k5") != NULL,
+        "tombstone_batch_commit",
+        "A batch commit should compact tombstones",
+        _counter) && result;
+
+    // test 5: clear frees only live rows
+    d_registry_remove(reg, "k5");
+    g_tombstone_free_calls = 0;
+    removed = d_registry_count(reg);
+    d_registry_clear(reg);
+
+    result = d_assert_standalone(
+        g_tombstone_free_calls == (int)removed
+        && reg->dead_count == 0,
+        "tombstone_clear",
+        "clear should free each live row once",
+        _counter) && result;
+
+    d_registry_free(reg);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_registry_tombstone_all
+  Aggregation function that runs all tombstone tests.
+*/
+bool
+d_tests_sa_registry_tombstone_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Tombstone Removal\n");
+    printf("  ---------------------------\n");
+
+    result = d_tests_sa_registry_tombstone_remove(_counter) && result;
+    result = d_tests_sa_registry_tombstone_iteration(_counter) && result;
+    result = d_tests_sa_registry_tombstone_compact(_counter) && result;
+
+    return result;
+}
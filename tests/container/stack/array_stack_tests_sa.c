@@ -0,0 +1,50 @@
+/******************************************************************************
+* djinterp [test]                                       array_stack_tests_sa.c
+*
+*   Master test runner for array_stack module.
+*   Coordinates execution of all test categories.
+*
+*
+* path:      \test\container\stack\array_stack_tests_sa.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\array_stack_tests_sa.h"
+
+
+/******************************************************************************
+ * MASTER TEST RUNNER
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_run_all
+  Master test runner for all array_stack tests.
+  Tests the following:
+  - Core stack operations (new, push/pop, get/set, insert/append, remove)
+  - Advanced scenarios (iteration, copy/merge, sort, capacity)
+*/
+struct d_test_object*
+d_tests_array_stack_run_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    // create master test group
+    group = d_test_object_new_interior("array_stack Module Tests", 2);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    // add all test categories
+    idx = 0;
+    group->elements[idx++] = d_tests_array_stack_core_all();
+    group->elements[idx++] = d_tests_array_stack_advanced_all();
+
+    return group;
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+* djinterp [test]                                       array_stack_tests_sa.h
+*
+*   Unit tests for the array_stack module (contiguous LIFO stack).
+*   Tests cover creation, push/pop/peek, indexed access, insertion and
+* removal, iteration, sorting and capacity management.
+*
+*
+* path:      \test\container\stack\array_stack_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_ARRAY_STACK_TESTS_STANDALONE_
+#define DJINTERP_ARRAY_STACK_TESTS_STANDALONE_ 1
+
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\stack\array_stack.h"
+
+
+/******************************************************************************
+ * TEST CONFIGURATION
+ *****************************************************************************/
+
+// D_TEST_ARRAY_STACK_SMALL_SIZE
+//   constant: small number of elements for basic tests.
+#define D_TEST_ARRAY_STACK_SMALL_SIZE     5
+
+// D_TEST_ARRAY_STACK_STRESS_SIZE
+//   constant: number of elements for growth and sort tests.
+#define D_TEST_ARRAY_STACK_STRESS_SIZE    1000
+
+
+/******************************************************************************
+ * TEST UTILITY FUNCTIONS
+ *****************************************************************************/
+
+// d_test_array_stack_int_compare
+//   function: three-way comparison of two int pointers.
+int d_test_array_stack_int_compare(const void* _a, const void* _b);
+
+
+/******************************************************************************
+ * CORE OPERATION TESTS
+ *****************************************************************************/
+
+struct d_test_object* d_tests_array_stack_new(void);
+struct d_test_object* d_tests_array_stack_push_pop(void);
+struct d_test_object* d_tests_array_stack_get_set(void);
+struct d_test_object* d_tests_array_stack_insert_append(void);
+struct d_test_object* d_tests_array_stack_remove(void);
+
+// core operations aggregator
+struct d_test_object* d_tests_array_stack_core_all(void);
+
+
+/******************************************************************************
+ * ADVANCED SCENARIO TESTS
+ *****************************************************************************/
+
+struct d_test_object* d_tests_array_stack_foreach(void);
+struct d_test_object* d_tests_array_stack_copy_merge(void);
+struct d_test_object* d_tests_array_stack_sort(void);
+struct d_test_object* d_tests_array_stack_capacity(void);
+
+// advanced tests aggregator
+struct d_test_object* d_tests_array_stack_advanced_all(void);
+
+
+/******************************************************************************
+ * MASTER TEST RUNNER
+ *****************************************************************************/
+
+// master test runner for all array_stack tests
+struct d_test_object* d_tests_array_stack_run_all(void);
+
+
+#endif  // DJINTERP_ARRAY_STACK_TESTS_STANDALONE_
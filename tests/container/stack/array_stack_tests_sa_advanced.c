@@ -0,0 +1,481 @@
+/******************************************************************************
+* djinterp [test]                              array_stack_tests_sa_advanced.c
+*
+*   Advanced scenario tests for array_stack module.
+*   Tests iteration, copying and merging, sorting and capacity management.
+*
+*
+* path:      \test\container\stack\array_stack_tests_sa_advanced.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\array_stack_tests_sa.h"
+
+
+/******************************************************************************
+ * ITERATION TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_foreach
+  Tests D_ARRAY_STACK_FOREACH and D_ARRAY_STACK_FOREACH_VALUE.
+  Tests the following:
+  - values are visited top to bottom
+  - writing through the slot updates the stack
+  - empty and NULL stacks are not iterated
+*/
+struct d_test_object*
+d_tests_array_stack_foreach
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* stack;
+    struct d_array_stack* empty;
+    int                   vals[3] = { 1, 2, 3 };
+    int                   other   = 0;
+    void*                 value;
+    size_t                visited;
+    bool                  test_order;
+    bool                  test_write;
+    bool                  test_empty;
+    size_t                idx;
+
+    stack = d_array_stack_new_from_args(3, &vals[0], &vals[1], &vals[2]);
+    empty = d_array_stack_new();
+
+    // test 1: top to bottom
+    visited    = 0;
+    test_order = (stack != NULL);
+
+    D_ARRAY_STACK_FOREACH_VALUE(value, slot, stack)
+    {
+        test_order = test_order && (value == &vals[visited]);
+        ++visited;
+    }
+
+    test_order = test_order && (visited == 3);
+
+    // test 2: write through the slot
+    D_ARRAY_STACK_FOREACH(slot, stack)
+    {
+        if (*slot == &vals[1])
+        {
+            *slot = &other;
+        }
+    }
+
+    test_write = (d_array_stack_get(stack, 1) == &other);
+
+    // test 3: nothing to visit
+    visited = 0;
+
+    D_ARRAY_STACK_FOREACH(slot, empty)
+    {
+        ++visited;
+    }
+
+    D_ARRAY_STACK_FOREACH(slot, (struct d_array_stack*)NULL)
+    {
+        ++visited;
+    }
+
+    test_empty = (visited == 0);
+
+    // cleanup
+    d_array_stack_free(stack);
+    d_array_stack_free(empty);
+
+    // build result tree
+    group = d_test_object_new_interior("D_ARRAY_STACK_FOREACH", 3);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("order",
+                                           test_order,
+                                           "values are visited top to bottom");
+    group->elements[idx++] = D_ASSERT_TRUE("write",
+                                           test_write,
+                                           "slot writes update the stack");
+    group->elements[idx++] = D_ASSERT_TRUE("empty",
+                                           test_empty,
+                                           "empty stacks are not iterated");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * COPY AND MERGE TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_copy_merge
+  Tests the copy, slice and merge constructors.
+  Tests the following:
+  - new_copy duplicates the values into separate storage
+  - new_copy_range copies an inclusive top-first range
+  - new_slice copies from an index to the bottom
+  - invalid ranges are rejected
+  - new_merge concatenates stacks in argument order
+*/
+struct d_test_object*
+d_tests_array_stack_copy_merge
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* stack;
+    struct d_array_stack* copy;
+    struct d_array_stack* range;
+    struct d_array_stack* slice;
+    struct d_array_stack* merged;
+    int                   vals[4] = { 0, 1, 2, 3 };
+    bool                  test_copy;
+    bool                  test_range;
+    bool                  test_slice;
+    bool                  test_invalid;
+    bool                  test_merge;
+    size_t                idx;
+
+    stack = d_array_stack_new_from_args(4, &vals[0], &vals[1], &vals[2], &vals[3]);
+
+    // test 1: copy
+    copy = d_array_stack_new_copy(stack);
+    test_copy = ( (copy != NULL)                          &&
+                  (copy->count == 4)                      &&
+                  (copy->values != stack->values)         &&
+                  (d_array_stack_peek(copy) == &vals[0])  &&
+                  (d_array_stack_get(copy, -1) == &vals[3]) );
+
+    // test 2: range (1, 2)
+    range = d_array_stack_new_copy_range(stack, 1, 2);
+    test_range = ( (range != NULL)                           &&
+                   (range->count == 2)                       &&
+                   (d_array_stack_get(range, 0) == &vals[1]) &&
+                   (d_array_stack_get(range, 1) == &vals[2]) );
+
+    // test 3: slice from -2
+    slice = d_array_stack_new_slice(stack, -2);
+    test_slice = ( (slice != NULL)                           &&
+                   (slice->count == 2)                       &&
+                   (d_array_stack_get(slice, 0) == &vals[2]) &&
+                   (d_array_stack_get(slice, 1) == &vals[3]) );
+
+    // test 4: invalid ranges
+    test_invalid = ( (d_array_stack_new_copy_range(stack, 2, 1) == NULL) &&
+                     (d_array_stack_new_copy_range(stack, 0, 4) == NULL) &&
+                     (d_array_stack_new_copy(NULL) == NULL) );
+
+    // test 5: merge (range then slice)
+    merged = d_array_stack_new_merge(2, range, slice);
+    test_merge = ( (merged != NULL)                           &&
+                   (merged->count == 4)                       &&
+                   (d_array_stack_get(merged, 0) == &vals[1]) &&
+                   (d_array_stack_get(merged, 1) == &vals[2]) &&
+                   (d_array_stack_get(merged, 2) == &vals[2]) &&
+                   (d_array_stack_get(merged, 3) == &vals[3]) );
+
+    // cleanup
+    d_array_stack_free(stack);
+    d_array_stack_free(copy);
+    d_array_stack_free(range);
+    d_array_stack_free(slice);
+    d_array_stack_free(merged);
+
+    // build result tree
+    group = d_test_object_new_interior("d_array_stack_copy_merge", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("copy",
+                                           test_copy,
+                                           "new_copy duplicates values");
+    group->elements[idx++] = D_ASSERT_TRUE("range",
+                                           test_range,
+                                           "new_copy_range is inclusive");
+    group->elements[idx++] = D_ASSERT_TRUE("slice",
+                                           test_slice,
+                                           "new_slice copies to the bottom");
+    group->elements[idx++] = D_ASSERT_TRUE("invalid",
+                                           test_invalid,
+                                           "invalid ranges are rejected");
+    group->elements[idx++] = D_ASSERT_TRUE("merge",
+                                           test_merge,
+                                           "new_merge concatenates in order");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * SORTING TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_sort
+  Tests d_array_stack_sort and d_array_stack_reverse.
+  Tests the following:
+  - smaller values end up closer to the top
+  - equal values keep their relative order
+  - a large reverse-ordered stack sorts correctly
+  - reverse flips the order
+*/
+struct d_test_object*
+d_tests_array_stack_sort
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* stack;
+    struct d_array_stack* large;
+    int                   vals[5] = { 3, 1, 2, 1, 3 };
+    int*                  numbers;
+    size_t                i;
+    bool                  test_order;
+    bool                  test_stable;
+    bool                  test_large;
+    bool                  test_reverse;
+    size_t                idx;
+
+    stack = d_array_stack_new_from_args(5,
+                                        &vals[0],
+                                        &vals[1],
+                                        &vals[2],
+                                        &vals[3],
+                                        &vals[4]);
+
+    d_array_stack_sort(stack, d_test_array_stack_int_compare);
+
+    // test 1: ascending from the top
+    test_order = ( (stack != NULL)                                  &&
+                   (*(int*)d_array_stack_get(stack, 0) == 1)        &&
+                   (*(int*)d_array_stack_get(stack, 2) == 2)        &&
+                   (*(int*)d_array_stack_get(stack, 4) == 3) );
+
+    // test 2: stability
+    test_stable = ( (d_array_stack_get(stack, 0) == &vals[1]) &&
+                    (d_array_stack_get(stack, 1) == &vals[3]) &&
+                    (d_array_stack_get(stack, 3) == &vals[0]) &&
+                    (d_array_stack_get(stack, 4) == &vals[4]) );
+
+    // test 3: large reverse-ordered input
+    numbers    = malloc(D_TEST_ARRAY_STACK_STRESS_SIZE * sizeof(int));
+    large      = d_array_stack_new();
+    test_large = ( (numbers != NULL) && (large != NULL) );
+
+    for (i = 0; test_large && (i < D_TEST_ARRAY_STACK_STRESS_SIZE); ++i)
+    {
+        numbers[i] = (int)i;
+        test_large = d_array_stack_push(large, &numbers[i]);
+    }
+
+    d_array_stack_sort(large, d_test_array_stack_int_compare);
+
+    for (i = 0; test_large && (i < D_TEST_ARRAY_STACK_STRESS_SIZE); ++i)
+    {
+        test_large = (*(int*)d_array_stack_get(large, (d_index)i) == (int)i);
+    }
+
+    // test 4: reverse
+    test_reverse = ( d_array_stack_reverse(stack)              &&
+                     (d_array_stack_get(stack, 0) == &vals[4]) &&
+                     (d_array_stack_get(stack, 4) == &vals[1]) &&
+                     (!d_array_stack_reverse(NULL)) );
+
+    // cleanup
+    d_array_stack_free(stack);
+    d_array_stack_free(large);
+    free(numbers);
+
+    // build result tree
+    group = d_test_object_new_interior("d_array_stack_sort", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("order",
+                                           test_order,
+                                           "smaller values end up on top");
+    group->elements[idx++] = D_ASSERT_TRUE("stable",
+                                           test_stable,
+                                           "equal values keep their order");
+    group->elements[idx++] = D_ASSERT_TRUE("large",
+                                           test_large,
+                                           "large stack sorts correctly");
+    group->elements[idx++] = D_ASSERT_TRUE("reverse",
+                                           test_reverse,
+                                           "reverse flips the order");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * CAPACITY TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_capacity
+  Tests growth, d_array_stack_reserve, d_array_stack_shrink_to_fit and the
+  clear functions.
+  Tests the following:
+  - pushes grow the storage geometrically
+  - reserve never shrinks
+  - shrink_to_fit trims capacity to the count
+  - clear keeps capacity, clear_deep frees the values
+*/
+struct d_test_object*
+d_tests_array_stack_capacity
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* stack;
+    size_t                reallocations;
+    size_t                capacity;
+    size_t                i;
+    int*                  value;
+    bool                  test_growth;
+    bool                  test_reserve;
+    bool                  test_shrink;
+    bool                  test_clear;
+    size_t                idx;
+
+    // test 1: few reallocations for many pushes
+    stack         = d_array_stack_new();
+    reallocations = 0;
+    capacity      = 0;
+    test_growth   = (stack != NULL);
+
+    for (i = 0; test_growth && (i < D_TEST_ARRAY_STACK_STRESS_SIZE); ++i)
+    {
+        test_growth = d_array_stack_push(stack, NULL);
+
+        if (stack->capacity != capacity)
+        {
+            capacity = stack->capacity;
+            ++reallocations;
+        }
+    }
+
+    test_growth = ( test_growth                                      &&
+                    (stack->count == D_TEST_ARRAY_STACK_STRESS_SIZE) &&
+                    (reallocations < 12) );
+
+    // test 2: reserve
+    test_reserve = ( (stack != NULL)                     &&
+                     d_array_stack_reserve(stack, 10)    &&
+                     (stack->capacity == capacity)       &&
+                     d_array_stack_reserve(stack, 5000)  &&
+                     (stack->capacity >= 5000) );
+
+    // test 3: shrink
+    test_shrink = ( (stack != NULL)                                      &&
+                    d_array_stack_shrink_to_fit(stack)                   &&
+                    (stack->capacity == D_TEST_ARRAY_STACK_STRESS_SIZE) );
+
+    // test 4: clear keeps storage; clear_deep frees values (checked by ASan)
+    test_clear = ( (stack != NULL)            &&
+                   d_array_stack_clear(stack) &&
+                   (stack->count == 0)        &&
+                   (stack->capacity == D_TEST_ARRAY_STACK_STRESS_SIZE) );
+
+    for (i = 0; test_clear && (i < D_TEST_ARRAY_STACK_SMALL_SIZE); ++i)
+    {
+        value = malloc(sizeof(int));
+
+        if ( (!value) ||
+             (!d_array_stack_push(stack, value)) )
+        {
+            free(value);
+            test_clear = false;
+        }
+    }
+
+    test_clear = ( test_clear                                  &&
+                   d_array_stack_clear_deep(stack, free)       &&
+                   (d_array_stack_is_empty(stack)) );
+
+    // cleanup
+    d_array_stack_free(stack);
+
+    // build result tree
+    group = d_test_object_new_interior("d_array_stack_capacity", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("growth",
+                                           test_growth,
+                                           "storage grows geometrically");
+    group->elements[idx++] = D_ASSERT_TRUE("reserve",
+                                           test_reserve,
+                                           "reserve never shrinks");
+    group->elements[idx++] = D_ASSERT_TRUE("shrink",
+                                           test_shrink,
+                                           "shrink_to_fit trims capacity");
+    group->elements[idx++] = D_ASSERT_TRUE("clear",
+                                           test_clear,
+                                           "clear keeps capacity");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * ADVANCED AGGREGATOR
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_advanced_all
+  Runs all advanced scenario tests.
+  Tests the following:
+  - iteration macros
+  - copy / slice / merge
+  - sort / reverse
+  - capacity management
+*/
+struct d_test_object*
+d_tests_array_stack_advanced_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    group = d_test_object_new_interior("Advanced Array Stack Operations", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = d_tests_array_stack_foreach();
+    group->elements[idx++] = d_tests_array_stack_copy_merge();
+    group->elements[idx++] = d_tests_array_stack_sort();
+    group->elements[idx++] = d_tests_array_stack_capacity();
+
+    return group;
+}
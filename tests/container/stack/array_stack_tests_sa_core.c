@@ -0,0 +1,595 @@
+/******************************************************************************
+* djinterp [test]                                  array_stack_tests_sa_core.c
+*
+*   Core operation tests for array_stack module.
+*   Tests creation, push/pop/peek, indexed access, insertion and removal.
+*
+*
+* path:      \test\container\stack\array_stack_tests_sa_core.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\array_stack_tests_sa.h"
+
+
+/******************************************************************************
+ * HELPER FUNCTIONS
+ *****************************************************************************/
+
+/*
+d_test_array_stack_int_compare
+  Three-way comparison of two int pointers.
+
+Parameter(s):
+  _a: pointer to the first int
+  _b: pointer to the second int
+Return:
+  Negative, zero or positive as *_a is less than, equal to or greater than
+  *_b.
+*/
+int
+d_test_array_stack_int_compare
+(
+    const void* _a,
+    const void* _b
+)
+{
+    int a = *(const int*)_a;
+    int b = *(const int*)_b;
+
+    return (a > b) - (a < b);
+}
+
+
+/******************************************************************************
+ * CREATION TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_new
+  Tests the d_array_stack creation functions.
+  Tests the following:
+  - new stack is empty with no storage
+  - new_with_capacity reserves storage up front
+  - new_from_arr treats the array as top-first
+  - new_from_args treats the arguments as top-first
+  - new_fill stores the same pointer in every slot
+*/
+struct d_test_object*
+d_tests_array_stack_new
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* empty;
+    struct d_array_stack* sized;
+    struct d_array_stack* from_arr;
+    struct d_array_stack* from_args;
+    struct d_array_stack* filled;
+    int                   vals[3] = { 1, 2, 3 };
+    const void*           arr[3];
+    bool                  test_empty;
+    bool                  test_capacity;
+    bool                  test_from_arr;
+    bool                  test_from_args;
+    bool                  test_fill;
+    size_t                idx;
+
+    arr[0] = &vals[0];
+    arr[1] = &vals[1];
+    arr[2] = &vals[2];
+
+    // test 1: empty
+    empty = d_array_stack_new();
+    test_empty = ( (empty != NULL)                 &&
+                   (empty->count == 0)             &&
+                   (empty->capacity == 0)          &&
+                   (empty->values == NULL)         &&
+                   (d_array_stack_is_empty(empty)) &&
+                   (d_array_stack_is_empty(NULL)) );
+
+    // test 2: reserved capacity
+    sized = d_array_stack_new_with_capacity(40);
+    test_capacity = ( (sized != NULL)          &&
+                      (sized->count == 0)      &&
+                      (sized->capacity >= 40) );
+
+    // test 3: array order is top-first
+    from_arr = d_array_stack_new_from_arr(arr, 3);
+    test_from_arr = ( (from_arr != NULL)                           &&
+                      (from_arr->count == 3)                       &&
+                      (d_array_stack_peek(from_arr) == &vals[0])   &&
+                      (d_array_stack_get(from_arr, 2) == &vals[2]) &&
+                      (d_array_stack_new_from_arr(NULL, 1) == NULL) );
+
+    // test 4: argument order is top-first
+    from_args = d_array_stack_new_from_args(3, &vals[0], &vals[1], &vals[2]);
+    test_from_args = ( (from_args != NULL)                           &&
+                       (from_args->count == 3)                       &&
+                       (d_array_stack_peek(from_args) == &vals[0])   &&
+                       (d_array_stack_get(from_args, -1) == &vals[2]) );
+
+    // test 5: fill
+    filled = d_array_stack_new_fill(D_TEST_ARRAY_STACK_SMALL_SIZE, &vals[1]);
+    test_fill = ( (filled != NULL)                                      &&
+                  (filled->count == D_TEST_ARRAY_STACK_SMALL_SIZE)      &&
+                  (d_array_stack_get(filled, 0) == &vals[1])            &&
+                  (d_array_stack_get(filled, -1) == &vals[1]) );
+
+    // cleanup
+    d_array_stack_free(empty);
+    d_array_stack_free(sized);
+    d_array_stack_free(from_arr);
+    d_array_stack_free(from_args);
+    d_array_stack_free(filled);
+
+    // build result tree
+    group = d_test_object_new_interior("d_array_stack_new", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("empty",
+                                           test_empty,
+                                           "new stack is empty without storage");
+    group->elements[idx++] = D_ASSERT_TRUE("capacity",
+                                           test_capacity,
+                                           "new_with_capacity reserves storage");
+    group->elements[idx++] = D_ASSERT_TRUE("from_arr",
+                                           test_from_arr,
+                                           "new_from_arr is top-first");
+    group->elements[idx++] = D_ASSERT_TRUE("from_args",
+                                           test_from_args,
+                                           "new_from_args is top-first");
+    group->elements[idx++] = D_ASSERT_TRUE("fill",
+                                           test_fill,
+                                           "new_fill repeats the pointer");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * PUSH / POP / PEEK TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_push_pop
+  Tests d_array_stack_push, d_array_stack_pop and d_array_stack_peek.
+  Tests the following:
+  - NULL stack is rejected
+  - pop returns values in LIFO order
+  - pop keeps capacity so later pushes do not reallocate
+  - pop and peek on an empty stack return NULL
+  - push_values and push_args push a top-first block
+*/
+struct d_test_object*
+d_tests_array_stack_push_pop
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* stack;
+    int                   vals[D_TEST_ARRAY_STACK_SMALL_SIZE];
+    const void*           block[2];
+    void**                storage;
+    size_t                capacity;
+    size_t                i;
+    bool                  test_null;
+    bool                  test_lifo;
+    bool                  test_reuse;
+    bool                  test_empty;
+    bool                  test_bulk;
+    size_t                idx;
+
+    for (i = 0; i < D_TEST_ARRAY_STACK_SMALL_SIZE; ++i)
+    {
+        vals[i] = (int)i;
+    }
+
+    // test 1: NULL handling
+    test_null = ( (!d_array_stack_push(NULL, &vals[0])) &&
+                  (d_array_stack_pop(NULL) == NULL)     &&
+                  (d_array_stack_peek(NULL) == NULL) );
+
+    // test 2: LIFO order
+    stack     = d_array_stack_new();
+    test_lifo = (stack != NULL);
+
+    for (i = 0; test_lifo && (i < D_TEST_ARRAY_STACK_SMALL_SIZE); ++i)
+    {
+        test_lifo = ( d_array_stack_push(stack, &vals[i]) &&
+                      (d_array_stack_peek(stack) == &vals[i]) );
+    }
+
+    storage  = (stack) ? stack->values : NULL;
+    capacity = (stack) ? stack->capacity : 0;
+
+    for (i = D_TEST_ARRAY_STACK_SMALL_SIZE; test_lifo && (i > 0); --i)
+    {
+        test_lifo = (d_array_stack_pop(stack) == &vals[i - 1]);
+    }
+
+    // test 3: storage is reused
+    test_reuse = ( test_lifo                                &&
+                   d_array_stack_push(stack, &vals[0])      &&
+                   (stack->values == storage)               &&
+                   (stack->capacity == capacity) );
+
+    // test 4: empty pops
+    if (stack)
+    {
+        d_array_stack_clear(stack);
+    }
+
+    test_empty = ( (stack != NULL)                    &&
+                   (d_array_stack_pop(stack) == NULL) &&
+                   (d_array_stack_peek(stack) == NULL) );
+
+    // test 5: bulk pushes keep the block top-first
+    block[0] = &vals[3];
+    block[1] = &vals[4];
+    test_bulk = ( (stack != NULL)                                   &&
+                  d_array_stack_push(stack, &vals[0])               &&
+                  d_array_stack_push_values(stack, block, 2)        &&
+                  d_array_stack_push_args(stack, 2, &vals[1], &vals[2]) &&
+                  (stack->count == 5)                               &&
+                  (d_array_stack_get(stack, 0) == &vals[1])         &&
+                  (d_array_stack_get(stack, 1) == &vals[2])         &&
+                  (d_array_stack_get(stack, 2) == &vals[3])         &&
+                  (d_array_stack_get(stack, 3) == &vals[4])         &&
+                  (d_array_stack_get(stack, 4) == &vals[0]) );
+
+    // cleanup
+    d_array_stack_free(stack);
+
+    // build result tree
+    group = d_test_object_new_interior("d_array_stack_push_pop", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("null",
+                                           test_null,
+                                           "NULL stack is rejected");
+    group->elements[idx++] = D_ASSERT_TRUE("lifo",
+                                           test_lifo,
+                                           "values pop in LIFO order");
+    group->elements[idx++] = D_ASSERT_TRUE("reuse",
+                                           test_reuse,
+                                           "pop keeps storage for reuse");
+    group->elements[idx++] = D_ASSERT_TRUE("empty",
+                                           test_empty,
+                                           "empty pop/peek return NULL");
+    group->elements[idx++] = D_ASSERT_TRUE("bulk",
+                                           test_bulk,
+                                           "bulk pushes are top-first");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * INDEXED ACCESS TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_get_set
+  Tests d_array_stack_get, d_array_stack_set and d_array_stack_get_slot.
+  Tests the following:
+  - index 0 is the top and -1 the bottom
+  - out-of-range indices return NULL / false
+  - set replaces the value in place
+  - get_slot points at the value's storage
+*/
+struct d_test_object*
+d_tests_array_stack_get_set
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* stack;
+    int                   vals[4] = { 10, 20, 30, 40 };
+    int                   other   = 99;
+    void**                slot;
+    bool                  test_indices;
+    bool                  test_range;
+    bool                  test_set;
+    bool                  test_slot;
+    size_t                idx;
+
+    stack = d_array_stack_new_from_args(3, &vals[0], &vals[1], &vals[2]);
+
+    // test 1: indexing
+    test_indices = ( (stack != NULL)                             &&
+                     (d_array_stack_get(stack, 0) == &vals[0])   &&
+                     (d_array_stack_get(stack, 1) == &vals[1])   &&
+                     (d_array_stack_get(stack, -1) == &vals[2])  &&
+                     (d_array_stack_get(stack, -3) == &vals[0]) );
+
+    // test 2: out of range
+    test_range = ( (d_array_stack_get(stack, 3) == NULL)       &&
+                   (d_array_stack_get(stack, -4) == NULL)      &&
+                   (!d_array_stack_set(stack, 3, &other))      &&
+                   (d_array_stack_get(NULL, 0) == NULL) );
+
+    // test 3: set
+    test_set = ( d_array_stack_set(stack, 1, &other)       &&
+                 (d_array_stack_get(stack, 1) == &other)   &&
+                 (stack->count == 3) );
+
+    // test 4: slot
+    slot = d_array_stack_get_slot(stack, -1);
+    test_slot = ( (slot != NULL)       &&
+                  (*slot == &vals[2])  &&
+                  (slot == &stack->values[0]) );
+
+    if (slot)
+    {
+        *slot     = &vals[3];
+        test_slot = test_slot && (d_array_stack_get(stack, -1) == &vals[3]);
+    }
+
+    // cleanup
+    d_array_stack_free(stack);
+
+    // build result tree
+    group = d_test_object_new_interior("d_array_stack_get_set", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("indices",
+                                           test_indices,
+                                           "0 is the top, -1 the bottom");
+    group->elements[idx++] = D_ASSERT_TRUE("range",
+                                           test_range,
+                                           "out-of-range indices fail");
+    group->elements[idx++] = D_ASSERT_TRUE("set",
+                                           test_set,
+                                           "set replaces in place");
+    group->elements[idx++] = D_ASSERT_TRUE("slot",
+                                           test_slot,
+                                           "get_slot points at storage");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * INSERTION TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_insert_append
+  Tests the insert and append functions.
+  Tests the following:
+  - insert at 0 behaves like push
+  - insert in the middle shifts lower values down
+  - insert at count behaves like append
+  - out-of-range insert index is rejected
+  - insert_stack_range of a stack into itself copies the original range
+*/
+struct d_test_object*
+d_tests_array_stack_insert_append
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* stack;
+    int                   vals[5] = { 0, 1, 2, 3, 4 };
+    bool                  test_top;
+    bool                  test_middle;
+    bool                  test_append;
+    bool                  test_range;
+    bool                  test_self;
+    size_t                idx;
+
+    stack = d_array_stack_new_from_args(2, &vals[1], &vals[3]);
+
+    // test 1: insert at the top
+    test_top = ( (stack != NULL)                           &&
+                 d_array_stack_insert(stack, &vals[0], 0)  &&
+                 (d_array_stack_peek(stack) == &vals[0]) );
+
+    // test 2: insert in the middle (0, 1, 2, 3)
+    test_middle = ( d_array_stack_insert(stack, &vals[2], 2)   &&
+                    (d_array_stack_get(stack, 1) == &vals[1])  &&
+                    (d_array_stack_get(stack, 2) == &vals[2])  &&
+                    (d_array_stack_get(stack, 3) == &vals[3]) );
+
+    // test 3: append (0, 1, 2, 3, 4)
+    test_append = ( d_array_stack_append(stack, &vals[4])        &&
+                    (stack->count == 5)                          &&
+                    (d_array_stack_get(stack, -1) == &vals[4])   &&
+                    (d_array_stack_peek(stack) == &vals[0]) );
+
+    // test 4: bad index
+    test_range = ( (!d_array_stack_insert(stack, &vals[0], 6))  &&
+                   (!d_array_stack_insert(stack, &vals[0], -6)) &&
+                   (stack->count == 5) );
+
+    // test 5: insert (1, 2) from itself at the bottom
+    test_self = ( d_array_stack_insert_stack_range(stack, stack, 1, 2, 5) &&
+                  (stack->count == 7)                                     &&
+                  (d_array_stack_get(stack, 4) == &vals[4])               &&
+                  (d_array_stack_get(stack, 5) == &vals[1])               &&
+                  (d_array_stack_get(stack, 6) == &vals[2]) );
+
+    // cleanup
+    d_array_stack_free(stack);
+
+    // build result tree
+    group = d_test_object_new_interior("d_array_stack_insert_append", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("top",
+                                           test_top,
+                                           "insert at 0 pushes");
+    group->elements[idx++] = D_ASSERT_TRUE("middle",
+                                           test_middle,
+                                           "insert shifts lower values");
+    group->elements[idx++] = D_ASSERT_TRUE("append",
+                                           test_append,
+                                           "append adds at the bottom");
+    group->elements[idx++] = D_ASSERT_TRUE("range",
+                                           test_range,
+                                           "bad insert index is rejected");
+    group->elements[idx++] = D_ASSERT_TRUE("self",
+                                           test_self,
+                                           "self insert copies the range");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * REMOVAL TESTS
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_remove
+  Tests d_array_stack_remove_at, d_array_stack_remove_first_match and the
+  search functions.
+  Tests the following:
+  - remove_at returns the value and closes the gap
+  - find returns the top-first index, -1 if absent
+  - comparator matches by content
+  - remove_first_match removes the topmost match only
+*/
+struct d_test_object*
+d_tests_array_stack_remove
+(
+    void
+)
+{
+    struct d_test_object* group;
+    struct d_array_stack* stack;
+    int                   vals[4] = { 5, 6, 7, 5 };
+    int                   key     = 7;
+    void*                 removed;
+    bool                  test_remove_at;
+    bool                  test_find;
+    bool                  test_comparator;
+    bool                  test_first_match;
+    size_t                idx;
+
+    stack = d_array_stack_new_from_args(4, &vals[0], &vals[1], &vals[2], &vals[3]);
+
+    // test 1: remove the second value
+    test_remove_at = ( (stack != NULL)                              &&
+                       (d_array_stack_remove_at(stack, 1) == &vals[1]) &&
+                       (stack->count == 3)                          &&
+                       (d_array_stack_get(stack, 0) == &vals[0])    &&
+                       (d_array_stack_get(stack, 1) == &vals[2])    &&
+                       (d_array_stack_remove_at(stack, 3) == NULL) );
+
+    // test 2: pointer search
+    test_find = ( (d_array_stack_find(stack, &vals[2], NULL) == 1)  &&
+                  (d_array_stack_find(stack, &vals[1], NULL) == -1) &&
+                  (d_array_stack_find_slot(stack, &vals[3], NULL) == &stack->values[0]) );
+
+    // test 3: content search
+    test_comparator = ( d_array_stack_contains(stack,
+                                               &key,
+                                               d_test_array_stack_int_compare) &&
+                        (!d_array_stack_contains(stack, &key, NULL)) );
+
+    // test 4: remove the topmost 5 (vals[0]) but keep vals[3]
+    key     = 5;
+    removed = NULL;
+    test_first_match = ( d_array_stack_remove_first_match(stack,
+                                                          &key,
+                                                          d_test_array_stack_int_compare,
+                                                          &removed) &&
+                         (removed == &vals[0])                      &&
+                         (stack->count == 2)                        &&
+                         (d_array_stack_get(stack, -1) == &vals[3]) );
+
+    // cleanup
+    d_array_stack_free(stack);
+
+    // build result tree
+    group = d_test_object_new_interior("d_array_stack_remove", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("remove_at",
+                                           test_remove_at,
+                                           "remove_at closes the gap");
+    group->elements[idx++] = D_ASSERT_TRUE("find",
+                                           test_find,
+                                           "find returns top-first index");
+    group->elements[idx++] = D_ASSERT_TRUE("comparator",
+                                           test_comparator,
+                                           "comparator matches by content");
+    group->elements[idx++] = D_ASSERT_TRUE("first_match",
+                                           test_first_match,
+                                           "only the topmost match is removed");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * CORE AGGREGATOR
+ *****************************************************************************/
+
+/*
+d_tests_array_stack_core_all
+  Runs all core operation tests.
+  Tests the following:
+  - d_array_stack_new
+  - push / pop / peek
+  - get / set / get_slot
+  - insert / append
+  - remove / find
+*/
+struct d_test_object*
+d_tests_array_stack_core_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    group = d_test_object_new_interior("Core Array Stack Operations", 5);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = d_tests_array_stack_new();
+    group->elements[idx++] = d_tests_array_stack_push_pop();
+    group->elements[idx++] = d_tests_array_stack_get_set();
+    group->elements[idx++] = d_tests_array_stack_insert_append();
+    group->elements[idx++] = d_tests_array_stack_remove();
+
+    return group;
+}
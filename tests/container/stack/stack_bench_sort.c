@@ -0,0 +1,341 @@
+/******************************************************************************
+* djinterp [test]                                          stack_bench_sort.c
+*
+*   Benchmark for d_stack_sort. Compares the natural-run merge sort against
+* the insertion sort it replaced (kept here as bench_insertion_sort) on
+* random, sorted, reverse sorted and few-distinct-key stacks, and checks
+* that both produce the same node order (i.e. the merge sort is stable).
+*   Two figures are reported per input:
+*   - ms/sort
+*   - comparator calls/sort
+*   The insertion sort is skipped above D_BENCH_STACK_SORT_OLD_MAX entries,
+* where it takes seconds.
+*   Not part of the standalone test run; build it on its own, e.g.
+*     cc -O2 stack_bench_sort.c stack.c stack_common.c linked_node.c
+*        linked_node_pool.c -o bench
+*
+* path:      \tests\container\stack\stack_bench_sort.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include "..\..\..\inc\container\stack\stack.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+#define D_BENCH_STACK_SORT_OLD_MAX  20000
+
+
+struct bench_item
+{
+    size_t key;
+    size_t seq;
+};
+
+enum bench_shape
+{
+    BENCH_SHAPE_RANDOM,
+    BENCH_SHAPE_SORTED,
+    BENCH_SHAPE_REVERSED,
+    BENCH_SHAPE_FEW_KEYS
+};
+
+static size_t g_compares;
+
+static int
+bench_compare
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct bench_item* a = (const struct bench_item*)_a;
+    const struct bench_item* b = (const struct bench_item*)_b;
+
+    g_compares++;
+
+    return (a->key < b->key) ? -1 : (a->key > b->key) ? 1 : 0;
+}
+
+// bench_insertion_sort
+//   the previous d_stack_sort, verbatim apart from the name.
+static void
+bench_insertion_sort
+(
+    struct d_stack* _stack,
+    fn_comparator   _comparator
+)
+{
+    struct d_linked_node* sorted;
+    struct d_linked_node* cur;
+    struct d_linked_node* next;
+    struct d_linked_node* insert_prev;
+
+    sorted = NULL;
+    cur    = _stack->top;
+
+    while (cur)
+    {
+        next      = cur->next;
+        cur->next = NULL;
+
+        if ( (!sorted) ||
+             (_comparator(cur->value, sorted->value) < 0) )
+        {
+            cur->next = sorted;
+            sorted    = cur;
+            cur       = next;
+
+            continue;
+        }
+
+        insert_prev = sorted;
+
+        while ( (insert_prev->next) &&
+                (!(_comparator(cur->value, insert_prev->next->value) < 0)) )
+        {
+            insert_prev = insert_prev->next;
+        }
+
+        cur->next         = insert_prev->next;
+        insert_prev->next = cur;
+
+        cur = next;
+    }
+
+    _stack->top = sorted;
+}
+
+static double
+bench_seconds
+(
+    void
+)
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static uint64_t
+bench_rand
+(
+    uint64_t* _state
+)
+{
+    *_state ^= *_state << 13;
+    *_state ^= *_state >> 7;
+    *_state ^= *_state << 17;
+
+    return *_state;
+}
+
+// bench_build
+//   fills a stack so that, read from the top, keys follow `_shape`.
+static struct d_stack*
+bench_build
+(
+    struct bench_item* _items,
+    size_t             _count,
+    enum bench_shape   _shape
+)
+{
+    struct d_stack* stack;
+    uint64_t        state;
+    size_t          i;
+
+    stack = d_stack_new();
+
+    if (!stack)
+    {
+        return NULL;
+    }
+
+    state = 0x9E3779B97F4A7C15ULL;
+
+    for (i = 0; i < _count; ++i)
+    {
+        switch (_shape)
+        {
+            case BENCH_SHAPE_SORTED:
+                _items[i].key = i;
+                break;
+
+            case BENCH_SHAPE_REVERSED:
+                _items[i].key = _count - i;
+                break;
+
+            case BENCH_SHAPE_FEW_KEYS:
+                _items[i].key = (size_t)(bench_rand(&state) % 16);
+                break;
+
+            case BENCH_SHAPE_RANDOM:
+            default:
+                _items[i].key = (size_t)bench_rand(&state);
+                break;
+        }
+
+        _items[i].seq = i;
+    }
+
+    // push in reverse so items[0] ends up on top
+    for (i = _count; i > 0; --i)
+    {
+        if (!d_stack_push(stack, &_items[i - 1]))
+        {
+            d_stack_free(stack);
+
+            return NULL;
+        }
+    }
+
+    return stack;
+}
+
+// bench_time_sort
+//   sorts a fresh stack with either implementation; returns seconds taken.
+static double
+bench_time_sort
+(
+    struct d_stack* _stack,
+    bool            _old
+)
+{
+    double t0;
+
+    g_compares = 0;
+    t0         = bench_seconds();
+
+    if (_old)
+    {
+        bench_insertion_sort(_stack, bench_compare);
+    }
+    else
+    {
+        d_stack_sort(_stack, bench_compare);
+    }
+
+    return bench_seconds() - t0;
+}
+
+static void
+bench_run
+(
+    const char*      _label,
+    enum bench_shape _shape,
+    size_t           _count
+)
+{
+    struct bench_item*    items;
+    struct d_stack*       stacks[2];
+    struct d_linked_node* a;
+    struct d_linked_node* b;
+    double                elapsed[2];
+    size_t                compares[2];
+    bool                  run_old;
+    bool                  same;
+    int                   mode;
+
+    items   = malloc(_count * sizeof(*items));
+    run_old = (_count <= D_BENCH_STACK_SORT_OLD_MAX);
+
+    if (!items)
+    {
+        return;
+    }
+
+    stacks[0] = NULL;
+    stacks[1] = NULL;
+
+    for (mode = 0; mode < 2; ++mode)
+    {
+        if ( (mode == 0) &&
+             (!run_old) )
+        {
+            continue;
+        }
+
+        stacks[mode] = bench_build(items, _count, _shape);
+
+        if (!stacks[mode])
+        {
+            break;
+        }
+
+        elapsed[mode]  = bench_time_sort(stacks[mode], (mode == 0));
+        compares[mode] = g_compares;
+    }
+
+    if (stacks[1])
+    {
+        if (run_old && stacks[0])
+        {
+            same = true;
+
+            for (a = stacks[0]->top, b = stacks[1]->top;
+                 a && b;
+                 a = a->next, b = b->next)
+            {
+                if (a->value != b->value)
+                {
+                    same = false;
+
+                    break;
+                }
+            }
+
+            printf("  %-9s %7zu  insertion: %10.3f ms %12zu cmp\n",
+                   _label,
+                   _count,
+                   elapsed[0] * 1e3,
+                   compares[0]);
+
+            if (!same)
+            {
+                printf("  %-9s %7zu  MISMATCH: merge sort order differs\n",
+                       _label,
+                       _count);
+            }
+        }
+
+        printf("  %-9s %7zu  merge    : %10.3f ms %12zu cmp\n",
+               _label,
+               _count,
+               elapsed[1] * 1e3,
+               compares[1]);
+    }
+
+    d_stack_free(stacks[0]);
+    d_stack_free(stacks[1]);
+    free(items);
+}
+
+int
+main
+(
+    void
+)
+{
+    static const size_t sizes[] = { 1000, 20000, 100000, 1000000 };
+    size_t              i;
+
+    printf("d_stack_sort benchmark (insertion sort up to %d entries)\n",
+           D_BENCH_STACK_SORT_OLD_MAX);
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        bench_run("random", BENCH_SHAPE_RANDOM, sizes[i]);
+        bench_run("sorted", BENCH_SHAPE_SORTED, sizes[i]);
+        bench_run("reversed", BENCH_SHAPE_REVERSED, sizes[i]);
+        bench_run("few keys", BENCH_SHAPE_FEW_KEYS, sizes[i]);
+    }
+
+    return 0;
+}
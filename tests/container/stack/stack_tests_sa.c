@@ -0,0 +1,48 @@
+/******************************************************************************
+* djinterp [test]                                             stack_tests_sa.c
+*
+*   Master test runner for stack module.
+*   Coordinates execution of all test categories.
+*
+*
+* path:      \test\container\stack\stack_tests_sa.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\stack_tests_sa.h"
+
+
+/******************************************************************************
+ * MASTER TEST RUNNER
+ *****************************************************************************/
+
+/*
+d_tests_stack_run_all
+  Master test runner for all stack tests.
+  Tests the following:
+  - Sorting (tiny stacks, stability, natural runs)
+*/
+struct d_test_object*
+d_tests_stack_run_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    // create master test group
+    group = d_test_object_new_interior("stack Module Tests", 1);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    // add all test categories
+    idx = 0;
+    group->elements[idx++] = d_tests_stack_sort_all();
+
+    return group;
+}
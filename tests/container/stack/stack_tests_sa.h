@@ -0,0 +1,73 @@
+/******************************************************************************
+* djinterp [test]                                             stack_tests_sa.h
+*
+*   Unit tests for the stack module (linked-node LIFO stack).
+*   Tests cover d_stack_sort: ordering, stability and the natural-run merge
+* on sorted, descending, alternating and tiny inputs.
+*
+*
+* path:      \test\container\stack\stack_tests_sa.h
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#ifndef DJINTERP_STACK_TESTS_STANDALONE_
+#define DJINTERP_STACK_TESTS_STANDALONE_ 1
+
+#include "..\..\..\inc\test\test_standalone.h"
+#include "..\..\..\inc\container\stack\stack.h"
+
+
+/******************************************************************************
+ * TEST CONFIGURATION
+ *****************************************************************************/
+
+// D_TEST_STACK_SORT_SIZE
+//   constant: number of entries in the larger sort inputs.
+#define D_TEST_STACK_SORT_SIZE    256
+
+
+/******************************************************************************
+ * TEST UTILITY FUNCTIONS
+ *****************************************************************************/
+
+// d_test_stack_entry
+//   struct: a sort key plus its position in the unsorted stack, so tests can
+// check that equal keys keep their order.
+struct d_test_stack_entry
+{
+    int    key;
+    size_t seq;
+};
+
+// d_test_stack_entry_compare
+//   function: compares two d_test_stack_entry pointers by key only, counting
+// each call in d_test_stack_compare_calls.
+int d_test_stack_entry_compare(const void* _a, const void* _b);
+
+// d_test_stack_compare_calls
+//   variable: comparator calls since it was last reset.
+extern size_t d_test_stack_compare_calls;
+
+
+/******************************************************************************
+ * SORT TESTS
+ *****************************************************************************/
+
+struct d_test_object* d_tests_stack_sort_small(void);
+struct d_test_object* d_tests_stack_sort_stable(void);
+struct d_test_object* d_tests_stack_sort_runs(void);
+
+// sort tests aggregator
+struct d_test_object* d_tests_stack_sort_all(void);
+
+
+/******************************************************************************
+ * MASTER TEST RUNNER
+ *****************************************************************************/
+
+// master test runner for all stack tests
+struct d_test_object* d_tests_stack_run_all(void);
+
+
+#endif  // DJINTERP_STACK_TESTS_STANDALONE_
@@ -0,0 +1,514 @@
+/******************************************************************************
+* djinterp [test]                                        stack_tests_sa_sort.c
+*
+*   Sorting tests for stack module.
+*   Tests d_stack_sort on tiny stacks, on equal keys and on sorted,
+* descending and alternating natural runs.
+*
+*
+* path:      \test\container\stack\stack_tests_sa_sort.c
+* link:      TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.10.16
+******************************************************************************/
+
+#include ".\stack_tests_sa.h"
+
+
+/******************************************************************************
+ * TEST UTILITY FUNCTIONS
+ *****************************************************************************/
+
+size_t d_test_stack_compare_calls = 0;
+
+/*
+d_test_stack_entry_compare
+  Compares two d_test_stack_entry values by key, ignoring `seq`, and counts
+the call.
+*/
+int
+d_test_stack_entry_compare
+(
+    const void* _a,
+    const void* _b
+)
+{
+    const struct d_test_stack_entry* a;
+    const struct d_test_stack_entry* b;
+
+    a = (const struct d_test_stack_entry*)_a;
+    b = (const struct d_test_stack_entry*)_b;
+
+    ++d_test_stack_compare_calls;
+
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+/*
+d_test_stack_from_keys
+  Builds a stack whose top-to-bottom keys are `_keys`, numbering each entry's
+`seq` by its position. Returns NULL on allocation failure.
+*/
+static struct d_stack*
+d_test_stack_from_keys
+(
+    struct d_test_stack_entry* _entries,
+    const int*                 _keys,
+    size_t                     _count
+)
+{
+    struct d_stack* stack;
+    size_t          i;
+
+    stack = d_stack_new();
+
+    if (!stack)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < _count; ++i)
+    {
+        _entries[i].key = _keys[i];
+        _entries[i].seq = i;
+
+        if (!d_stack_append(stack, &_entries[i]))
+        {
+            d_stack_free(stack);
+
+            return NULL;
+        }
+    }
+
+    return stack;
+}
+
+/*
+d_test_stack_is_sorted
+  Returns true if `_stack` holds `_count` entries with non-decreasing keys
+from the top, and equal keys still in `seq` order.
+*/
+static bool
+d_test_stack_is_sorted
+(
+    const struct d_stack* _stack,
+    size_t                _count
+)
+{
+    const struct d_linked_node*      node;
+    const struct d_test_stack_entry* prev;
+    const struct d_test_stack_entry* curr;
+    size_t                           seen;
+
+    if ( (!_stack) || (_stack->count != _count) )
+    {
+        return false;
+    }
+
+    prev = NULL;
+    seen = 0;
+
+    for (node = _stack->top; node; node = node->next)
+    {
+        curr = (const struct d_test_stack_entry*)node->value;
+
+        if ( (prev) &&
+             ( (prev->key > curr->key) ||
+               ( (prev->key == curr->key) && (prev->seq > curr->seq) ) ) )
+        {
+            return false;
+        }
+
+        prev = curr;
+        ++seen;
+    }
+
+    return (seen == _count);
+}
+
+
+/******************************************************************************
+ * SORT TESTS
+ *****************************************************************************/
+
+/*
+d_tests_stack_sort_small
+  Tests d_stack_sort on degenerate and tiny inputs.
+  Tests the following:
+  - NULL stacks and NULL comparators are ignored
+  - an empty stack stays empty without calling the comparator
+  - a one-element stack is untouched without calling the comparator
+  - two-element stacks in order, reversed and equal sort in one comparison
+*/
+struct d_test_object*
+d_tests_stack_sort_small
+(
+    void
+)
+{
+    struct d_test_object*     group;
+    struct d_stack*           stack;
+    struct d_test_stack_entry entries[2];
+    const int                 ordered[2]  = { 1, 2 };
+    const int                 reversed[2] = { 2, 1 };
+    const int                 equal[2]    = { 7, 7 };
+    bool                      test_null;
+    bool                      test_empty;
+    bool                      test_one;
+    bool                      test_ordered;
+    bool                      test_reversed;
+    bool                      test_equal;
+    size_t                    idx;
+
+    // test 1: NULL arguments
+    d_test_stack_compare_calls = 0;
+    stack = d_test_stack_from_keys(entries, ordered, 2);
+
+    d_stack_sort(NULL, d_test_stack_entry_compare);
+    d_stack_sort(stack, NULL);
+
+    test_null = ( (stack != NULL)                        &&
+                  (d_stack_get(stack, 0) == &entries[0]) &&
+                  (d_stack_get(stack, 1) == &entries[1]) &&
+                  (d_test_stack_compare_calls == 0) );
+
+    d_stack_free(stack);
+
+    // test 2: empty stack
+    d_test_stack_compare_calls = 0;
+    stack = d_stack_new();
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_empty = ( (stack != NULL)       &&
+                   (stack->count == 0)   &&
+                   (stack->top == NULL)  &&
+                   (d_test_stack_compare_calls == 0) );
+
+    d_stack_free(stack);
+
+    // test 3: one element
+    d_test_stack_compare_calls = 0;
+    stack = d_test_stack_from_keys(entries, ordered, 1);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_one = ( (d_test_stack_is_sorted(stack, 1))      &&
+                 (d_stack_get(stack, 0) == &entries[0]) &&
+                 (d_test_stack_compare_calls == 0) );
+
+    d_stack_free(stack);
+
+    // test 4: two elements already in order
+    d_test_stack_compare_calls = 0;
+    stack = d_test_stack_from_keys(entries, ordered, 2);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_ordered = ( (d_test_stack_is_sorted(stack, 2))      &&
+                     (d_stack_get(stack, 0) == &entries[0]) &&
+                     (d_test_stack_compare_calls == 1) );
+
+    d_stack_free(stack);
+
+    // test 5: two elements reversed
+    d_test_stack_compare_calls = 0;
+    stack = d_test_stack_from_keys(entries, reversed, 2);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_reversed = ( (d_test_stack_is_sorted(stack, 2))      &&
+                      (d_stack_get(stack, 0) == &entries[1]) &&
+                      (d_stack_get(stack, 1) == &entries[0]) &&
+                      (d_test_stack_compare_calls == 1) );
+
+    d_stack_free(stack);
+
+    // test 6: two equal elements keep their order
+    d_test_stack_compare_calls = 0;
+    stack = d_test_stack_from_keys(entries, equal, 2);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_equal = ( (d_test_stack_is_sorted(stack, 2))      &&
+                   (d_stack_get(stack, 0) == &entries[0]) &&
+                   (d_stack_get(stack, 1) == &entries[1]) &&
+                   (d_test_stack_compare_calls == 1) );
+
+    d_stack_free(stack);
+
+    // build result tree
+    group = d_test_object_new_interior("d_stack_sort (small)", 6);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("null",
+                                           test_null,
+                                           "NULL stack or comparator is a no-op");
+    group->elements[idx++] = D_ASSERT_TRUE("empty",
+                                           test_empty,
+                                           "empty stack sorts without comparing");
+    group->elements[idx++] = D_ASSERT_TRUE("one",
+                                           test_one,
+                                           "one element sorts without comparing");
+    group->elements[idx++] = D_ASSERT_TRUE("two_ordered",
+                                           test_ordered,
+                                           "ordered pair is kept in one comparison");
+    group->elements[idx++] = D_ASSERT_TRUE("two_reversed",
+                                           test_reversed,
+                                           "reversed pair is swapped in one comparison");
+    group->elements[idx++] = D_ASSERT_TRUE("two_equal",
+                                           test_equal,
+                                           "equal pair keeps its order");
+
+    return group;
+}
+
+/*
+d_tests_stack_sort_stable
+  Tests that d_stack_sort keeps equal keys in their original order.
+  Tests the following:
+  - many entries over a few distinct keys keep their relative order
+  - a non-increasing run with duplicates is not reversed as a whole
+  - an all-equal stack is left in place in n - 1 comparisons
+*/
+struct d_test_object*
+d_tests_stack_sort_stable
+(
+    void
+)
+{
+    struct d_test_object*     group;
+    struct d_stack*           stack;
+    struct d_test_stack_entry entries[D_TEST_STACK_SORT_SIZE];
+    int                       keys[D_TEST_STACK_SORT_SIZE];
+    size_t                    i;
+    bool                      test_few_keys;
+    bool                      test_descending_dups;
+    bool                      test_all_equal;
+    size_t                    idx;
+
+    // test 1: scrambled keys drawn from {0, 1, 2, 3}
+    for (i = 0; i < D_TEST_STACK_SORT_SIZE; ++i)
+    {
+        keys[i] = (int)((i * 7u + (i >> 3)) % 4u);
+    }
+
+    stack = d_test_stack_from_keys(entries, keys, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_few_keys = d_test_stack_is_sorted(stack, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_free(stack);
+
+    // test 2: 9 9 8 8 7 7 ... must not be flipped into 7 7 8 8 with the
+    // duplicates swapped
+    for (i = 0; i < D_TEST_STACK_SORT_SIZE; ++i)
+    {
+        keys[i] = (int)((D_TEST_STACK_SORT_SIZE - i) / 2);
+    }
+
+    stack = d_test_stack_from_keys(entries, keys, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_descending_dups = d_test_stack_is_sorted(stack,
+                                                  D_TEST_STACK_SORT_SIZE);
+
+    d_stack_free(stack);
+
+    // test 3: every key equal is a single non-descending run
+    for (i = 0; i < D_TEST_STACK_SORT_SIZE; ++i)
+    {
+        keys[i] = 5;
+    }
+
+    d_test_stack_compare_calls = 0;
+    stack = d_test_stack_from_keys(entries, keys, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_all_equal = ( (d_test_stack_is_sorted(stack, D_TEST_STACK_SORT_SIZE)) &&
+                       (d_test_stack_compare_calls ==
+                            D_TEST_STACK_SORT_SIZE - 1) );
+
+    d_stack_free(stack);
+
+    // build result tree
+    group = d_test_object_new_interior("d_stack_sort (stability)", 3);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("few_keys",
+                                           test_few_keys,
+                                           "equal keys keep their relative order");
+    group->elements[idx++] = D_ASSERT_TRUE("descending_dups",
+                                           test_descending_dups,
+                                           "descending run with duplicates stays stable");
+    group->elements[idx++] = D_ASSERT_TRUE("all_equal",
+                                           test_all_equal,
+                                           "all-equal stack is one run of n - 1 comparisons");
+
+    return group;
+}
+
+/*
+d_tests_stack_sort_runs
+  Tests d_stack_sort on inputs made of natural runs.
+  Tests the following:
+  - an already sorted stack is kept in n - 1 comparisons
+  - a strictly descending stack is reversed in n - 1 comparisons
+  - alternating low/high keys (runs of two) sort correctly
+  - a sawtooth of ascending and descending runs sorts stably
+*/
+struct d_test_object*
+d_tests_stack_sort_runs
+(
+    void
+)
+{
+    struct d_test_object*     group;
+    struct d_stack*           stack;
+    struct d_test_stack_entry entries[D_TEST_STACK_SORT_SIZE];
+    int                       keys[D_TEST_STACK_SORT_SIZE];
+    size_t                    i;
+    bool                      test_sorted;
+    bool                      test_descending;
+    bool                      test_alternating;
+    bool                      test_sawtooth;
+    size_t                    idx;
+
+    // test 1: already sorted
+    for (i = 0; i < D_TEST_STACK_SORT_SIZE; ++i)
+    {
+        keys[i] = (int)i;
+    }
+
+    d_test_stack_compare_calls = 0;
+    stack = d_test_stack_from_keys(entries, keys, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_sorted = ( (d_test_stack_is_sorted(stack, D_TEST_STACK_SORT_SIZE)) &&
+                    (d_stack_get(stack, 0) == &entries[0])                   &&
+                    (d_test_stack_compare_calls ==
+                         D_TEST_STACK_SORT_SIZE - 1) );
+
+    d_stack_free(stack);
+
+    // test 2: strictly descending
+    for (i = 0; i < D_TEST_STACK_SORT_SIZE; ++i)
+    {
+        keys[i] = (int)(D_TEST_STACK_SORT_SIZE - i);
+    }
+
+    d_test_stack_compare_calls = 0;
+    stack = d_test_stack_from_keys(entries, keys, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_descending = ( (d_test_stack_is_sorted(stack,
+                                                D_TEST_STACK_SORT_SIZE)) &&
+                        (d_stack_get(stack, 0) ==
+                             &entries[D_TEST_STACK_SORT_SIZE - 1])       &&
+                        (d_test_stack_compare_calls ==
+                             D_TEST_STACK_SORT_SIZE - 1) );
+
+    d_stack_free(stack);
+
+    // test 3: 0 255 1 254 2 253 ...
+    for (i = 0; i < D_TEST_STACK_SORT_SIZE; ++i)
+    {
+        keys[i] = (i % 2 == 0) ? (int)(i / 2)
+                               : (int)(D_TEST_STACK_SORT_SIZE - 1 - i / 2);
+    }
+
+    stack = d_test_stack_from_keys(entries, keys, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_alternating = d_test_stack_is_sorted(stack, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_free(stack);
+
+    // test 4: runs of 16 alternating between rising and falling, with keys
+    // repeating across runs
+    for (i = 0; i < D_TEST_STACK_SORT_SIZE; ++i)
+    {
+        keys[i] = ((i / 16) % 2 == 0) ? (int)(i % 16)
+                                      : (int)(15 - i % 16);
+    }
+
+    stack = d_test_stack_from_keys(entries, keys, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_sort(stack, d_test_stack_entry_compare);
+
+    test_sawtooth = d_test_stack_is_sorted(stack, D_TEST_STACK_SORT_SIZE);
+
+    d_stack_free(stack);
+
+    // build result tree
+    group = d_test_object_new_interior("d_stack_sort (runs)", 4);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = D_ASSERT_TRUE("sorted",
+                                           test_sorted,
+                                           "sorted stack costs n - 1 comparisons");
+    group->elements[idx++] = D_ASSERT_TRUE("descending",
+                                           test_descending,
+                                           "descending stack costs n - 1 comparisons");
+    group->elements[idx++] = D_ASSERT_TRUE("alternating",
+                                           test_alternating,
+                                           "alternating keys sort correctly");
+    group->elements[idx++] = D_ASSERT_TRUE("sawtooth",
+                                           test_sawtooth,
+                                           "rising and falling runs sort stably");
+
+    return group;
+}
+
+
+/******************************************************************************
+ * SORT TESTS AGGREGATOR
+ *****************************************************************************/
+
+/*
+d_tests_stack_sort_all
+  Runs all d_stack_sort tests.
+*/
+struct d_test_object*
+d_tests_stack_sort_all
+(
+    void
+)
+{
+    struct d_test_object* group;
+    size_t                idx;
+
+    group = d_test_object_new_interior("Sorting", 3);
+
+    if (!group)
+    {
+        return NULL;
+    }
+
+    idx = 0;
+    group->elements[idx++] = d_tests_stack_sort_small();
+    group->elements[idx++] = d_tests_stack_sort_stable();
+    group->elements[idx++] = d_tests_stack_sort_runs();
+
+    return group;
+}